@@ -12,13 +12,15 @@ from .property import Property, Keyframe, BezierTangent, SpatialTangent
 from .render_queue import RenderQueueItem, OutputModule
 from .marker import Marker
 from .color_profile import ColorProfile
-from .world import World, WorldType
+from .world import AlphaOp, PixelKernels, PixelLayout, ResizeFilter, World, WorldPool, WorldType
 from .footage import Footage, FootageSignature, FootageType, InterpretationStyle
 from .render import (
-    RenderOptions, FrameReceipt, Renderer,
+    RenderOptions, RenderOptionsPool, FrameReceipt, Renderer, FrameWriter, FrameWriteFuture, RenderSequence,
+    RenderCache, CachedFrame, RenderFuture, IncrementalRenderer, Thumbnail, ThumbnailCache,
+    render_frame_async, cancel_async_renders, get_async_render_stats,
     MatteMode, ChannelOrder, FieldRender, RenderQuality
 )
-from .layer_render_options import LayerRenderOptions
+from .layer_render_options import LayerRenderOptions, LayerRenderOptionsPool
 from .sound_data import SoundData, SoundEncoding
 from .three_d import *
 from .types import (
@@ -49,6 +51,9 @@ from . import batch
 from . import cache
 from . import perf
 from . import async_render
+from . import hot_reload
+from . import serialize
+from . import snapshot
 from . import render_queue
 from . import render
 from . import three_d
@@ -385,12 +390,28 @@ __all__ = [
     "World",
     "Footage",
     "RenderOptions",
+    "RenderOptionsPool",
     "FrameReceipt",
     "Renderer",
     "LayerRenderOptions",
+    "LayerRenderOptionsPool",
     "SoundData",
+    "WorldPool",
+    "PixelKernels",
+    "FrameWriter",
+    "FrameWriteFuture",
+    "RenderSequence",
+    "RenderCache",
+    "CachedFrame",
+    "RenderFuture",
+    "IncrementalRenderer",
+    "Thumbnail",
+    "ThumbnailCache",
     # Enum
     "WorldType",
+    "PixelLayout",
+    "AlphaOp",
+    "ResizeFilter",
     "SoundEncoding",
     "FootageSignature",
     "InterpretationStyle",
@@ -421,6 +442,9 @@ __all__ = [
     "check_memory_leak",
     "log_memory_leak_details",
     "batch_operation",
+    "render_frame_async",
+    "cancel_async_renders",
+    "get_async_render_stats",
     # Submodules
     "const",
     "sdk",
@@ -432,6 +456,9 @@ __all__ = [
     "cache",
     "perf",
     "async_render",
+    "hot_reload",
+    "serialize",
+    "snapshot",
     "render_queue",
     "render",
     "three_d",
@@ -134,7 +134,8 @@ class Footage:
         """Get sequence import options.
 
         Returns:
-            Dict with keys: is_sequence, force_alphabetical, start_frame, end_frame
+            Dict with keys: is_sequence, all_in_folder, force_alphabetical,
+            start_frame, end_frame
         """
         ...
 
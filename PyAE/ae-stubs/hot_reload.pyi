@@ -0,0 +1,78 @@
+# ae.hot_reload - Hot Reload API
+# PyAE - Python for After Effects
+
+from typing import Callable, Dict, List, Optional, TypedDict
+
+class ReloadResult(TypedDict):
+    reloaded: List[str]
+    failed: Dict[str, str]
+    skipped: List[str]
+
+def enable(poll_interval_ms: int = 500) -> bool:
+    """
+    スクリプトディレクトリの監視を開始
+
+    変更された .py に対応するモジュールと、それをimportしている
+    ユーザーモジュールをメインスレッドで依存順にリロードします。
+
+    Args:
+        poll_interval_ms: ポーリング間隔（ミリ秒、最小50）
+
+    Returns:
+        監視を開始できた場合True（スクリプトディレクトリがない場合False）
+    """
+    ...
+
+def disable() -> None:
+    """監視を停止"""
+    ...
+
+def is_enabled() -> bool:
+    """監視スレッドが動作中か"""
+    ...
+
+def watch_directories() -> List[str]:
+    """リロード対象となるディレクトリ一覧を取得"""
+    ...
+
+def reload(modules: List[str]) -> ReloadResult:
+    """
+    指定モジュールと、それに依存するユーザーモジュールをリロード
+
+    Args:
+        modules: モジュール名（sys.modulesのキー）
+
+    Returns:
+        reloaded（実行順）、failed（{名前: エラー}）、
+        skipped（失敗したモジュールに依存するためスキップ）
+    """
+    ...
+
+def reload_files(paths: List[str]) -> ReloadResult:
+    """
+    指定ファイルから読み込まれたユーザーモジュールと依存モジュールをリロード
+
+    Args:
+        paths: ソースファイルパス（.py）
+
+    Returns:
+        reload() と同じ形式の結果
+    """
+    ...
+
+def dependency_graph() -> Dict[str, List[str]]:
+    """読み込み済みユーザーモジュールのimportグラフ（モジュール名 -> import先）"""
+    ...
+
+def set_on_reload(callback: Optional[Callable[[ReloadResult], None]]) -> None:
+    """
+    自動リロード完了時のコールバックを設定
+
+    Args:
+        callback: callable(result) またはNone（解除）
+    """
+    ...
+
+def reload_count() -> int:
+    """起動以降にリロードしたモジュールの総数"""
+    ...
@@ -48,6 +48,11 @@ class Layer:
     @quality.setter
     def quality(self, value: LayerQuality) -> None: ...
 
+    @property
+    def quality_string(self) -> str:
+        """レイヤー品質の文字列表記（"Best" / "Draft" / "Wireframe" / "None"）"""
+        ...
+
     @property
     def sampling_quality(self) -> SamplingQuality:
         """サンプリング品質"""
@@ -225,6 +230,20 @@ class Layer:
     @transfer_mode.setter
     def transfer_mode(self, value: TransferMode) -> None: ...
 
+    @property
+    def blend_mode(self) -> int:
+        """ブレンドモード（BlendMode の値）。設定時はフラグとトラックマットを保持"""
+        ...
+    @blend_mode.setter
+    def blend_mode(self, value: int) -> None: ...
+
+    @property
+    def track_matte(self) -> int:
+        """トラックマットモード（TrackMatteMode の値）。設定時はブレンドモードとフラグを保持"""
+        ...
+    @track_matte.setter
+    def track_matte(self, value: int) -> None: ...
+
     def to_world_xform(self, comp_time: float) -> List[List[float]]:
         """
         指定されたコンポジション時間でのレイヤーのワールド変換行列を取得
@@ -318,6 +337,21 @@ class Layer:
         """オブジェクトタイプ（読み取り専用）"""
         ...
 
+    @property
+    def width(self) -> int:
+        """ソースアイテムの幅（ソースがない場合は RuntimeError）"""
+        ...
+
+    @property
+    def height(self) -> int:
+        """ソースアイテムの高さ（ソースがない場合は RuntimeError）"""
+        ...
+
+    @property
+    def solid_color(self) -> Optional[List[float]]:
+        """ソースが平面の場合その色 [r, g, b]（0.0-1.0）、それ以外は None"""
+        ...
+
     @property
     def is_2d(self) -> bool:
         """2Dレイヤーかどうか（読み取り専用）"""
@@ -4,7 +4,7 @@ PyAE Layer Render Options Module
 Provides layer-specific render options for rendering individual layers.
 """
 
-from typing import Tuple
+from typing import Any, Dict, Optional, Tuple, Union
 from .world import WorldType
 from .render import MatteMode
 
@@ -95,6 +95,21 @@ class LayerRenderOptions:
         """Internal: Get raw handle as integer."""
         ...
 
+    @property
+    def pooled(self) -> bool:
+        """True if the options came from LayerRenderOptions.acquire()."""
+        ...
+
+    def reset(self) -> None:
+        """Restore the layer's default values in place.
+
+        Only the fields changed since the options were acquired are set again.
+
+        Raises:
+            RuntimeError: If the options did not come from acquire()
+        """
+        ...
+
     @staticmethod
     def from_layer(layer_handle: int) -> 'LayerRenderOptions':
         """Create render options from a layer.
@@ -141,3 +156,90 @@ class LayerRenderOptions:
             This function can only be called from the UI thread.
         """
         ...
+
+    @staticmethod
+    def acquire(layer: Any, time: Optional[float] = None) -> 'LayerRenderOptions':
+        """Acquire render options for a layer from LayerRenderOptionsPool.
+
+        The options start at the same values as from_layer(). When they are
+        garbage-collected the handle goes back to the pool, and the next
+        acquire() for the same layer resets only the fields that were changed
+        instead of creating a new handle. A render loop can also keep one
+        object and change ``time`` every frame.
+
+        Args:
+            layer: Layer or layer handle (int)
+            time: Render time in seconds (default: the layer's current time)
+
+        Returns:
+            Pooled LayerRenderOptions instance
+
+        Example::
+
+            options = ae.LayerRenderOptions.acquire(layer)
+            for frame in range(num_frames):
+                options.time = frame / fps
+                ...
+        """
+        ...
+
+
+class LayerRenderOptionsPool:
+    """Pool that recycles handles from LayerRenderOptions.acquire().
+
+    Up to max_idle handles are kept per layer together with the layer's
+    default values. When more than max_layers layers are pooled, the least
+    recently acquired layer's handles are disposed. If the composition,
+    its current time or the project bit depth changed since the defaults
+    were taken, acquire() takes them again from a new handle.
+    """
+
+    @staticmethod
+    def stats() -> Dict[str, Union[int, bool]]:
+        """Get pool statistics as a dict.
+
+        Keys: hits, misses, resets (reused handles that needed fields restored),
+        refreshes (defaults taken again after a change), returned, evicted,
+        pooled, live, layers, max_idle, max_layers, enabled
+        """
+        ...
+
+    @staticmethod
+    def reset_stats() -> None:
+        """Reset counters (pooled handles are kept)."""
+        ...
+
+    @staticmethod
+    def max_idle() -> int:
+        """Get the number of handles kept per layer."""
+        ...
+
+    @staticmethod
+    def set_max_idle(max_idle: int) -> None:
+        """Set the number of handles kept per layer; excess handles are disposed."""
+        ...
+
+    @staticmethod
+    def max_layers() -> int:
+        """Get the number of layers kept in the pool."""
+        ...
+
+    @staticmethod
+    def set_max_layers(max_layers: int) -> None:
+        """Set the number of layers kept in the pool; least recently used layers are dropped."""
+        ...
+
+    @staticmethod
+    def enabled() -> bool:
+        """Check whether released handles are pooled."""
+        ...
+
+    @staticmethod
+    def set_enabled(enabled: bool) -> None:
+        """Enable or disable pooling. Disabling disposes all pooled handles."""
+        ...
+
+    @staticmethod
+    def clear() -> None:
+        """Dispose all pooled handles and forget the layer defaults."""
+        ...
@@ -5,8 +5,8 @@ Provides high-level API for frame rendering in After Effects.
 """
 
 from enum import IntEnum
-from typing import Dict, Tuple, Optional
-from .world import World, WorldType
+from typing import Any, Callable, Dict, Generator, Iterator, List, Tuple, Optional, Union
+from .world import AlphaOp, World, WorldType
 
 
 class MatteMode(IntEnum):
@@ -174,6 +174,19 @@ class RenderOptions:
         """Internal: raw handle."""
         ...
 
+    @property
+    def pooled(self) -> bool:
+        """True if the options came from RenderOptions.acquire()."""
+        ...
+
+    def reset(self) -> None:
+        """Restore the item's default values in place.
+
+        Only the fields changed since the options were acquired are set
+        again. Raises RuntimeError if the options did not come from acquire().
+        """
+        ...
+
     @staticmethod
     def from_item(item_handle: int) -> 'RenderOptions':
         """Create render options from an item (composition or footage).
@@ -186,6 +199,95 @@ class RenderOptions:
         """
         ...
 
+    @staticmethod
+    def acquire(item: Any, time: Optional[float] = None) -> 'RenderOptions':
+        """Acquire render options for an item from RenderOptionsPool.
+
+        The options start at the same values as from_item(). When they are
+        garbage-collected the handle goes back to the pool, and the next
+        acquire() for the same item resets only the fields that were
+        changed instead of creating a new handle. A render loop can also
+        keep one object and change time every frame::
+
+            options = ae.RenderOptions.acquire(comp)
+            for frame in range(num_frames):
+                options.time = frame / comp.frame_rate
+                with ae.Renderer.render_frame(options) as receipt:
+                    ...
+
+        Args:
+            item: Item, Comp or item handle (int)
+            time: Render time in seconds (default: the item's current time)
+        """
+        ...
+
+
+class RenderOptionsPool:
+    """Pool that recycles handles from RenderOptions.acquire().
+
+    Up to max_idle handles are kept per item together with the item's
+    default values. When more than max_items items are pooled, the least
+    recently acquired item's handles are disposed. If the item, its
+    current time or the project bit depth changed since the defaults
+    were taken, acquire() takes them again from a new handle.
+
+    Example::
+
+        ae.RenderOptionsPool.set_max_idle(8)
+        print(ae.RenderOptionsPool.stats())
+    """
+
+    @staticmethod
+    def stats() -> Dict[str, Union[int, bool]]:
+        """Get pool statistics as a dict.
+
+        Keys: hits, misses, resets (reused handles that needed fields
+        restored), refreshes (defaults taken again after a change),
+        returned, evicted, pooled, live, items, max_idle, max_items,
+        enabled
+        """
+        ...
+
+    @staticmethod
+    def reset_stats() -> None:
+        """Reset counters (pooled handles are kept)."""
+        ...
+
+    @staticmethod
+    def max_idle() -> int:
+        """Get the number of handles kept per item."""
+        ...
+
+    @staticmethod
+    def set_max_idle(max_idle: int) -> None:
+        """Set the number of handles kept per item; excess handles are disposed."""
+        ...
+
+    @staticmethod
+    def max_items() -> int:
+        """Get the number of items kept in the pool."""
+        ...
+
+    @staticmethod
+    def set_max_items(max_items: int) -> None:
+        """Set the number of items kept in the pool; least recently used items are dropped."""
+        ...
+
+    @staticmethod
+    def enabled() -> bool:
+        """Check whether released handles are pooled."""
+        ...
+
+    @staticmethod
+    def set_enabled(enabled: bool) -> None:
+        """Enable or disable pooling. Disabling disposes all pooled handles."""
+        ...
+
+    @staticmethod
+    def clear() -> None:
+        """Dispose all pooled handles and forget the item defaults."""
+        ...
+
 
 class FrameReceipt:
     """Receipt for a rendered frame.
@@ -205,7 +307,12 @@ class FrameReceipt:
 
     @property
     def world(self) -> World:
-        """Get the rendered world (frame buffer). Read-only."""
+        """Get the rendered world (frame buffer). Read-only.
+
+        The world and its memoryview / as_array() views point at memory
+        owned by AE. checkin() (or leaving the with block) invalidates the
+        world; copy the pixels first if they are needed afterwards.
+        """
         ...
 
     @property
@@ -328,3 +435,795 @@ class Renderer:
             True if existing render is sufficient.
         """
         ...
+
+
+class FrameWriteFuture:
+    """Completion of one FrameWriter.write call."""
+
+    @property
+    def path(self) -> str:
+        """Destination file path"""
+        ...
+
+    @property
+    def bytes_written(self) -> int:
+        """Size of the written file (0 until done or on failure)"""
+        ...
+
+    def done(self) -> bool:
+        """Return True once the file has been written or has failed."""
+        ...
+
+    def wait(self, timeout: Optional[float] = None) -> bool:
+        """Wait for completion.
+
+        Args:
+            timeout: Seconds to wait, or None to wait indefinitely
+
+        Returns:
+            True if the write has completed
+        """
+        ...
+
+    def result(self, timeout: Optional[float] = None) -> str:
+        """Wait for completion and return the written path.
+
+        Raises RuntimeError if the write failed and TimeoutError if it
+        did not finish within timeout seconds.
+        """
+        ...
+
+    def exception(self, timeout: Optional[float] = None) -> Optional[str]:
+        """Wait for completion and return the error message, or None on success."""
+        ...
+
+
+class FrameWriter:
+    """Write frames to image files on worker threads.
+
+    write() copies the pixels into a pooled buffer and returns a
+    FrameWriteFuture right away; encoding and file I/O run off the main
+    thread. When the buffers not yet written would exceed
+    max_in_flight_bytes, write() waits for earlier frames to finish.
+
+    Formats (no compression):
+        png  : RGBA 8 / 16 bit
+        tiff : RGBA 8 / 16 bit integer or 32 bit float
+        exr  : RGBA 32 bit float (scanline)
+        pfm  : RGB 32 bit float (alpha dropped)
+
+    Example:
+        with ae.FrameWriter() as writer:
+            for t in times:
+                options.time = t
+                receipt = ae.Renderer.render_frame(options)
+                writer.write(receipt, f'out/frame_{t:.3f}.png')
+        # leaving the block waits for all files
+    """
+
+    def __init__(self, threads: int = 0, max_in_flight_bytes: int = 256 * 1024 * 1024) -> None:
+        """
+        Args:
+            threads: Worker threads (0 = choose from the CPU, 1-4)
+            max_in_flight_bytes: Limit for captured frames not yet
+                written (default 256 MB); a single larger frame is
+                still accepted when nothing else is pending
+        """
+        ...
+
+    def write(self, source: Union[World, FrameReceipt], path: str,
+              format: Optional[str] = None, bit_depth: int = 0,
+              alpha: AlphaOp = AlphaOp.NONE) -> FrameWriteFuture:
+        """Capture a World or FrameReceipt and write it in the background.
+
+        A FrameReceipt is checked in as soon as its pixels are captured.
+
+        Args:
+            source: World or FrameReceipt
+            path: Destination file path
+            format: 'png', 'tiff', 'exr' or 'pfm' (default: from the
+                path extension)
+            bit_depth: Bits per channel (0 = from the source: png 8 for
+                8 bpc and 16 otherwise, tiff as the source, exr / pfm 32)
+            alpha: AlphaOp applied while capturing (default NONE)
+
+        Returns:
+            FrameWriteFuture
+        """
+        ...
+
+    def flush(self, timeout: Optional[float] = None) -> bool:
+        """Wait until every pending frame has been written.
+
+        Args:
+            timeout: Seconds to wait, or None to wait indefinitely
+
+        Returns:
+            True if nothing is pending
+        """
+        ...
+
+    def close(self) -> None:
+        """Finish pending frames and stop the worker threads.
+        write() raises RuntimeError afterwards."""
+        ...
+
+    @property
+    def closed(self) -> bool: ...
+
+    @property
+    def threads(self) -> int: ...
+
+    @property
+    def max_in_flight_bytes(self) -> int: ...
+
+    def stats(self) -> Dict[str, int]:
+        """Get counters (submitted, written, failed, bytes_written, pending,
+        in_flight_bytes, peak_in_flight_bytes, pooled_buffers)."""
+        ...
+
+    def __enter__(self) -> "FrameWriter": ...
+    def __exit__(self, exc_type, exc_val, exc_tb) -> None: ...
+
+
+class RenderSequence:
+    """Render a time range of an item and hand the frames to consumers.
+
+    Frames are rendered on the main thread with RenderAndCheckoutFrame,
+    copied into pooled buffers and checked in right away. Consumers
+    (add_writer, add_stats) each run on their own worker thread in frame
+    order, overlapping with the rendering of the next frames. At most
+    max_in_flight frames are held; rendering waits when all are in use.
+
+    run() renders everything and returns timings (frames, seconds, fps,
+    render_seconds, ...). Iterating the sequence instead yields
+    (time, World) for each frame while the consumers keep running.
+
+    Example:
+        seq = ae.RenderSequence(comp, start=0.0, end=2.0)
+        seq.add_writer("C:/out/shot_####.png")
+        seq.add_stats()
+        result = seq.run()
+        print(result["fps"], result["stats"][0]["mean"])
+
+        for time, world in ae.RenderSequence(comp, end=1.0):
+            print(time, world.statistics(histogram=False)["mean"])
+    """
+
+    def __init__(
+        self,
+        item: Any,
+        start: Optional[float] = None,
+        end: Optional[float] = None,
+        step: Optional[float] = None,
+        world_type: Optional[WorldType] = None,
+        max_in_flight: int = 4,
+    ) -> None:
+        """
+        Args:
+            item: Comp, CompItem, Item or item handle
+            start: First time in seconds (default 0)
+            end: End time in seconds, exclusive (default: item duration)
+            step: Seconds between frames (default: comp frame duration)
+            world_type: Bit depth to render (default: from the item)
+            max_in_flight: Frames held for the consumers at most (default 4)
+        """
+        ...
+
+    def add_writer(
+        self, pattern: str, format: Optional[str] = None, bit_depth: int = 0
+    ) -> "RenderSequence":
+        """Write every frame to an image file on a worker thread.
+
+        The last run of '#' in the file name is replaced by the frame
+        number (zero padded); without '#', '_####' is added before the
+        extension. Frames are numbered consecutively from the comp frame
+        at start (start / frame_duration), one per rendered frame.
+
+        Args:
+            pattern: Destination path, e.g. 'C:/out/shot_####.exr'
+            format: 'png', 'tiff', 'exr' or 'pfm' (default: from the extension)
+            bit_depth: Bits per channel (0 = from the world type)
+        """
+        ...
+
+    def add_stats(
+        self,
+        bins: int = 256,
+        range: Tuple[float, float] = (0.0, 1.0),
+        histogram: bool = False,
+    ) -> "RenderSequence":
+        """Compute per-channel statistics of every frame on a worker thread.
+
+        The result of run() then has 'stats': one dict per frame with
+        index, frame, time, min, max, mean, std (R, G, B, A) and, if
+        histogram is True, histogram (4 lists of bins counts).
+        """
+        ...
+
+    def run(self, progress: Optional[Callable[[int, int], None]] = None) -> Dict[str, Any]:
+        """Render all frames and wait for the consumers.
+
+        Args:
+            progress: Optional callable(done, total) called after each frame
+
+        Returns:
+            dict: frames, seconds, fps, render_seconds, submit_seconds,
+            wait_seconds, copy_seconds, peak_in_flight, max_in_flight,
+            consumers (name, frames, seconds, error) and stats if added.
+
+        Raises:
+            RuntimeError: If a consumer failed (result is still stored)
+        """
+        ...
+
+    def __iter__(self) -> Iterator[Tuple[float, World]]: ...
+    def __next__(self) -> Tuple[float, World]: ...
+    def __len__(self) -> int: ...
+
+    @property
+    def times(self) -> List[float]:
+        """Times (seconds) of the frames to render"""
+        ...
+
+    @property
+    def rendered(self) -> int:
+        """Number of frames rendered so far"""
+        ...
+
+    @property
+    def frame_duration(self) -> float:
+        """Frame duration used for the first frame number (seconds)"""
+        ...
+
+    @property
+    def max_in_flight(self) -> int: ...
+
+    @property
+    def result(self) -> Optional[Dict[str, Any]]:
+        """Result dict of the finished sequence, or None"""
+        ...
+
+
+class CachedFrame:
+    """Pixels of a frame held by a RenderCache (read-only).
+
+    Supports the buffer protocol without copying: numpy.asarray(frame)
+    gives a (height, width, 4) ARGB array. to_world() copies the
+    pixels into a new World.
+    """
+
+    @property
+    def width(self) -> int: ...
+
+    @property
+    def height(self) -> int: ...
+
+    @property
+    def world_type(self) -> WorldType: ...
+
+    @property
+    def time(self) -> float:
+        """Time of the frame in seconds"""
+        ...
+
+    @property
+    def nbytes(self) -> int:
+        """Size of the pixel data in bytes"""
+        ...
+
+    @property
+    def hit(self) -> bool:
+        """True if the frame came from the cache, False if it was rendered"""
+        ...
+
+    @property
+    def timestamp(self) -> Tuple[int, int, int, int]:
+        """Project timestamp taken before the frame was rendered"""
+        ...
+
+    def to_world(self) -> World:
+        """Copy the pixels into a new World."""
+        ...
+
+    def __buffer__(self, flags: int) -> memoryview: ...
+
+
+class RenderCache:
+    """Frame cache validated with project timestamps.
+
+    Frames are keyed by item, time and render options (world type,
+    downsample factor, region of interest, quality, field, matte mode,
+    channel order, guide layers). Each frame keeps the project
+    timestamp taken before it was rendered; a cached frame is returned
+    only if HasItemChangedSinceTimestamp reports no change, otherwise it
+    is dropped and rendered again.
+
+    Frames are held in memory up to max_memory_bytes (least recently
+    used first out). If directory is given, frames pushed out of memory
+    are written there and read back on demand, up to max_disk_bytes.
+    Timestamps are only valid within one session, so each cache writes
+    into its own new subdirectory of directory and removes only that
+    subdirectory when it is destroyed; other files are left alone.
+
+    Example:
+        cache = ae.RenderCache(max_memory_bytes=512 * 1024 * 1024)
+        world = cache.render(comp, 1.0)     # renders
+        world = cache.render(comp, 1.0)     # memory copy
+        pixels = numpy.asarray(cache.fetch(comp, 1.0))
+    """
+
+    def __init__(
+        self,
+        max_memory_bytes: int = 1 << 30,
+        directory: Optional[str] = None,
+        max_disk_bytes: int = 4 << 30,
+    ) -> None:
+        """
+        Args:
+            max_memory_bytes: Memory budget for cached frames (default 1 GiB)
+            directory: Directory for frames pushed out of memory (default: none)
+            max_disk_bytes: Disk budget in directory (default 4 GiB)
+        """
+        ...
+
+    def fetch(
+        self, item: Any, time: Optional[float] = None, options: Optional[RenderOptions] = None
+    ) -> CachedFrame:
+        """Return the cached frame, rendering it if missing or changed.
+
+        Args:
+            item: Comp, CompItem, Item or item handle
+            time: Time in seconds (default: the time of options)
+            options: RenderOptions for item (default: from the item).
+                     If time is given it is set on options.
+        """
+        ...
+
+    def render(
+        self, item: Any, time: Optional[float] = None, options: Optional[RenderOptions] = None
+    ) -> World:
+        """Like fetch(), but return a new World with a copy of the pixels."""
+        ...
+
+    def lookup(
+        self, item: Any, time: Optional[float] = None, options: Optional[RenderOptions] = None
+    ) -> Optional[CachedFrame]:
+        """Return the cached frame if present and unchanged, without rendering."""
+        ...
+
+    def invalidate(self, item: Any = None) -> int:
+        """Drop the frames of item (all frames if None). Returns the number dropped."""
+        ...
+
+    def clear(self) -> None:
+        """Drop all frames"""
+        ...
+
+    def set_limits(self, max_memory_bytes: int, max_disk_bytes: int = 4 << 30) -> None:
+        """Change the memory and disk budgets and evict frames over them."""
+        ...
+
+    @property
+    def directory(self) -> Optional[str]:
+        """Directory for frames pushed out of memory, or None"""
+        ...
+
+    @property
+    def stats(self) -> Dict[str, Any]:
+        """hits, disk_hits, misses, stale, hit_rate, inserts, evictions,
+        disk_writes, disk_evictions, disk_errors, memory_entries,
+        memory_bytes, disk_entries, disk_bytes, max_memory_bytes, max_disk_bytes"""
+        ...
+
+
+class RenderFuture:
+    """Pending result of render_frame_async().
+
+    The frame is rendered on the main thread from the idle hook, one
+    request per idle call. cancel() aborts a pending request at once and
+    a running one through AE's render cancel callback. Done callbacks
+    run from the idle hook. The future can also be awaited from an
+    asyncio event loop (await future -> FrameReceipt).
+
+    A finished future holds its frame until release() is called or the
+    future is destroyed. In a group, a frame nobody took with result()
+    or await is checked in when the group's next frame is delivered.
+    """
+
+    @property
+    def id(self) -> int: ...
+
+    @property
+    def group(self) -> Optional[str]:
+        """Group name, or None"""
+        ...
+
+    @property
+    def time(self) -> float:
+        """Time of the requested frame in seconds"""
+        ...
+
+    @property
+    def state(self) -> str:
+        """'pending', 'rendering', 'done', 'cancelled' or 'failed'"""
+        ...
+
+    @property
+    def wait_seconds(self) -> float:
+        """Seconds from submission until rendering started"""
+        ...
+
+    @property
+    def render_seconds(self) -> float:
+        """Seconds spent rendering"""
+        ...
+
+    def done(self) -> bool:
+        """Return True once the frame is rendered, cancelled or failed."""
+        ...
+
+    def running(self) -> bool: ...
+    def cancelled(self) -> bool: ...
+
+    def cancel(self) -> bool:
+        """Cancel the request.
+
+        A pending request is cancelled at once. A running render is
+        aborted by AE's cancel callback (any thread may call this).
+
+        Returns:
+            False if the request had already finished
+        """
+        ...
+
+    def result(self, timeout: Optional[float] = None) -> FrameReceipt:
+        """Return the FrameReceipt, waiting for the render.
+
+        On the main thread the queue is rendered right here up to this
+        request. Check in the receipt (or call release()) when done
+        with it.
+
+        Raises:
+            concurrent.futures.CancelledError: If cancelled or superseded
+            RuntimeError: If the render failed or the frame was released
+            TimeoutError: If not finished within timeout seconds
+        """
+        ...
+
+    def release(self) -> bool:
+        """Check in the rendered frame held by this future.
+
+        The receipt returned by result() and its worlds become invalid,
+        and result() raises RuntimeError afterwards. Call from the main
+        thread.
+
+        Returns:
+            False if the future holds no frame (unfinished, failed,
+            cancelled or already released)
+        """
+        ...
+
+    def add_done_callback(self, callback: Callable[["RenderFuture"], None]) -> None:
+        """Call callback(future) from the idle hook once finished
+        (immediately if already delivered)."""
+        ...
+
+    def __await__(self) -> Generator[Any, None, FrameReceipt]: ...
+
+
+def render_frame_async(
+    source: Any,
+    time: Optional[float] = None,
+    group: Optional[str] = None,
+    timeout: Optional[float] = None,
+    callback: Optional[Callable[[RenderFuture], None]] = None,
+) -> RenderFuture:
+    """Queue a frame render and return a RenderFuture right away.
+
+    Frames render on the main thread from the idle hook, in order.
+    A new request with the same group supersedes the group's unfinished
+    ones: pending requests are dropped and a running render is aborted
+    (e.g. group='viewer' while scrubbing).
+
+    Args:
+        source: RenderOptions, or Comp / CompItem / Item / item handle
+        time: Time in seconds (default: the time of the options)
+        group: Supersede unfinished requests of this group (default: none)
+        timeout: Cancel if not finished within this many seconds
+        callback: Optional callable(future) called from the idle hook
+
+    Example:
+        def show(future):
+            if not future.cancelled():
+                with future.result() as receipt:
+                    update_preview(receipt.world)
+
+        ae.render_frame_async(comp, t, group="viewer", callback=show)
+    """
+    ...
+
+
+def cancel_async_renders(group: Optional[str] = None) -> int:
+    """Cancel the unfinished requests of group (all if None).
+
+    Returns:
+        int: Number of requests cancelled
+    """
+    ...
+
+
+def get_async_render_stats() -> Dict[str, int]:
+    """Counters of render_frame_async requests.
+
+    submitted, completed, failed, cancelled, superseded, expired,
+    aborted, pending, rendering. aborted counts renders stopped by the
+    cancel callback; they are also counted as cancelled, superseded or
+    expired.
+    """
+    ...
+
+
+Rect = Tuple[int, int, int, int]
+
+
+class IncrementalRenderer:
+    """Keep a full frame and re-render only the regions that changed.
+
+    The first update() renders the whole frame into a persistent World
+    and records the bounds of every 2D layer. Later updates render only
+    the dirty region - the old and new bounds of the layers passed in,
+    plus any rectangles - using the region of interest, and composite
+    the result into the World with CompositeSuite TransferRect.
+    Changing the time, or marking a 3D layer, re-renders the whole frame.
+
+    Rectangles are (left, top, right, bottom) in frame pixels (after
+    downsampling). Effects that draw outside the layer bounds (glows,
+    shadows) need a larger padding.
+
+    Example:
+        inc = ae.IncrementalRenderer(comp)
+        inc.update()                       # full frame
+        layer.position = (200, 120)
+        info = inc.update(layers=[layer])  # old + new bounds only
+        print(info["saved_pixels"], inc.world.get_pixel(200, 120))
+    """
+
+    def __init__(
+        self,
+        item: Any,
+        options: Optional[RenderOptions] = None,
+        padding: int = 2,
+        max_regions: int = 1,
+    ) -> None:
+        """
+        Args:
+            item: Comp, CompItem, Item or item handle
+            options: RenderOptions to copy (default: from the item)
+            padding: Pixels added around layer bounds (default 2)
+            max_regions: Renders per update at most; the dirty rectangles
+                are merged until they fit (default 1)
+        """
+        ...
+
+    def update(
+        self,
+        layers: Any = None,
+        rect: Optional[Union[Rect, Dict[str, int]]] = None,
+        time: Optional[float] = None,
+    ) -> Dict[str, Any]:
+        """Render the dirty region into the persistent World.
+
+        Args:
+            layers: Layer or list of Layers that changed
+            rect: Extra dirty rectangle, e.g. the area under the cursor
+            time: Time in seconds; a new time re-renders the whole frame
+
+        Returns:
+            dict: full, regions (list of rectangles), rendered_pixels,
+            full_pixels, saved_pixels, seconds
+        """
+        ...
+
+    def mark_layers(self, layers: Any) -> None:
+        """Add the old and new bounds of changed layers to the dirty region.
+
+        Call right after each change so that a layer moved several times
+        between updates still repaints every place it has been.
+        """
+        ...
+
+    def invalidate(self, rect: Optional[Union[Rect, Dict[str, int]]] = None) -> None:
+        """Add a rectangle (or the whole frame if None) to the dirty region"""
+        ...
+
+    def reset_stats(self) -> None: ...
+
+    @property
+    def world(self) -> Optional[World]:
+        """The persistent full-frame World (None before the first update)"""
+        ...
+
+    @property
+    def time(self) -> float:
+        """Time of the persistent frame in seconds"""
+        ...
+
+    @property
+    def frame_size(self) -> Optional[Tuple[int, int]]:
+        """(width, height) of the frame, or None before the first update"""
+        ...
+
+    @property
+    def padding(self) -> int: ...
+
+    @property
+    def max_regions(self) -> int: ...
+
+    @property
+    def stats(self) -> Dict[str, Any]:
+        """updates, full_renders, region_renders, rendered_pixels,
+        full_pixels, saved_pixels, saved_ratio, transfers, copies, seconds"""
+        ...
+
+
+class Thumbnail:
+    """Small 8-bit RGBA image of a project item (read-only).
+
+    Supports the buffer protocol without copying: numpy.asarray(thumb)
+    gives a (height, width, 4) uint8 RGBA array, and to_bytes() can be
+    passed to QImage(..., QImage.Format_RGBA8888).
+    """
+
+    @property
+    def width(self) -> int: ...
+
+    @property
+    def height(self) -> int: ...
+
+    @property
+    def item_id(self) -> int: ...
+
+    @property
+    def stale(self) -> bool:
+        """True if the item changed since the thumbnail was made
+        (a new one is being generated)"""
+        ...
+
+    @property
+    def nbytes(self) -> int: ...
+
+    @property
+    def timestamp(self) -> Tuple[int, int, int, int]:
+        """Project timestamp the thumbnail was validated against"""
+        ...
+
+    def to_bytes(self) -> bytes:
+        """Return the RGBA pixels as bytes (rows packed, 4 bytes per pixel)"""
+        ...
+
+    def to_world(self) -> World:
+        """Copy the pixels into a new 8-bit World"""
+        ...
+
+
+class ThumbnailCache:
+    """Thumbnails of project items, generated on idle and kept on disk.
+
+    get() returns a thumbnail immediately if one is cached and queues
+    items without one. Queued items are rendered at 8 bpc with a
+    downsample factor, shrunk to fit size x size and stored compressed
+    on disk, spending at most budget_ms per idle call so the UI stays
+    responsive.
+
+    A thumbnail is reused while the item is unchanged: within a session
+    this is checked with project timestamps, across sessions by the
+    modification time of the saved project file. A thumbnail of a
+    changed item is returned with stale=True while it is regenerated.
+
+    Example:
+        cache = ae.ThumbnailCache(size=96)
+        thumb = cache.get(comp)          # None until generated
+        cache.request(proj.items, lambda item_id, thumb: update(item_id, thumb))
+    """
+
+    def __init__(
+        self,
+        size: int = 160,
+        directory: Optional[str] = None,
+        max_memory_bytes: int = 64 * 1024 * 1024,
+        budget_ms: float = 10.0,
+        time: float = 0.0,
+    ) -> None:
+        """
+        Args:
+            size: Longest side of a thumbnail in pixels (default 160)
+            directory: Cache directory (default: PyAE/thumbnails in the temp
+                directory, "" keeps thumbnails in memory only). Each saved
+                project gets its own subdirectory.
+            max_memory_bytes: Memory budget for thumbnails (default 64 MiB)
+            budget_ms: Time spent generating per idle call (default 10 ms)
+            time: Time of the frame shown, in seconds (default 0.0)
+        """
+        ...
+
+    def get(self, item: Any, wait: bool = False) -> Optional[Thumbnail]:
+        """Return the thumbnail of item, queueing it if missing or changed.
+
+        Args:
+            item: Comp, CompItem, Item or item handle
+            wait: Generate now instead of on idle
+
+        Returns:
+            Thumbnail or None: None if nothing is cached yet
+        """
+        ...
+
+    def request(
+        self,
+        items: Any,
+        callback: Optional[Callable[[int, Optional[Thumbnail]], None]] = None,
+    ) -> int:
+        """Queue thumbnails of items.
+
+        callback(item_id, thumbnail) is called once per item: immediately
+        for items with a valid thumbnail, otherwise on idle after it is
+        generated (thumbnail is None if the item cannot be rendered).
+
+        Returns:
+            int: Number of items newly queued
+        """
+        ...
+
+    def process(self, budget_ms: Optional[float] = None) -> int:
+        """Generate queued thumbnails now, for up to budget_ms
+        (default: all of them).
+
+        Returns:
+            int: Number of queued items processed
+        """
+        ...
+
+    def invalidate(self, item: Any = None) -> int:
+        """Drop the thumbnail of item (all thumbnails if None).
+
+        Returns:
+            int: Number of thumbnails dropped
+        """
+        ...
+
+    def clear(self) -> None:
+        """Cancel queued items and drop all thumbnails"""
+        ...
+
+    @property
+    def pending(self) -> int:
+        """Number of items waiting to be generated"""
+        ...
+
+    @property
+    def size(self) -> int: ...
+
+    @property
+    def time(self) -> float: ...
+
+    @property
+    def budget_ms(self) -> float:
+        """Time spent generating per idle call in milliseconds"""
+        ...
+
+    @budget_ms.setter
+    def budget_ms(self, value: float) -> None: ...
+
+    @property
+    def directory(self) -> Optional[str]:
+        """Directory of the current project's thumbnails, or None if in memory only"""
+        ...
+
+    @property
+    def stats(self) -> Dict[str, Any]:
+        """hits, disk_hits, misses, stale, adopted, generated, failures,
+        generate_seconds, pending, evictions, disk_writes, disk_errors,
+        memory_entries, memory_bytes, disk_entries, disk_bytes,
+        compression_ratio, max_memory_bytes"""
+        ...
@@ -1,7 +1,8 @@
 # ae.render_monitor - Render Queue Monitor API
 # PyAE - Python for After Effects
 
-from typing import Optional, Callable, List, Tuple
+from array import array
+from typing import Any, Callable, Dict, List, Optional, Tuple
 
 # Finished status constants
 STATUS_UNKNOWN: int
@@ -114,7 +115,8 @@ def set_on_item_updated(callback: Optional[Callable[[int, int, int], None]]) ->
         callback: (session_id: int, item_id: int, frame_id: int) を受け取る関数。クリアするにはNone。
 
     Note:
-        レンダリング中に頻繁に呼ばれる可能性があります。
+        フレーム更新はアイテムごとにまとめられ、毎秒 max_update_rate 回まで
+        通知されます（configure_events を参照）。frame_id は最新のフレームです。
     """
     ...
 
@@ -144,6 +146,199 @@ def set_on_report_log(
     """
     ...
 
+# Batched delivery
+def set_on_events(callback: Optional[Callable[[List[Dict[str, Any]]], None]]) -> None:
+    """
+    レンダーイベントをまとめてリストで受け取るコールバックを設定
+
+    Args:
+        callback: (events: list[dict]) を受け取る関数。クリアするにはNone。
+
+    各イベントは type ("job_started", "job_ended", "item_started",
+    "item_updated", "item_ended", "report_log"), session_id, item_id,
+    count, time と、種類に応じて frame_id / status / is_error, message を持つ。
+    count は item_updated にまとめたフレーム更新の数。
+    個別のコールバックより先に呼ばれる。
+    """
+    ...
+
+def configure_events(
+    max_update_rate: Optional[float] = None, capacity: Optional[int] = None
+) -> None:
+    """
+    レンダーイベントのバッファと通知の設定
+
+    Args:
+        max_update_rate: アイテムごとの item_updated の毎秒の上限（既定 30）。
+            0 で取り出しごとに最新フレームを通知。
+        capacity: ネイティブバッファのイベント数（2の累乗に切り上げ、既定 4096）。
+            リスナー登録中は変更できない（RuntimeError）。
+
+    バッファに入らないイベントは捨てられ、get_event_stats() の dropped に数えられる。
+    """
+    ...
+
+def get_event_stats() -> Dict[str, Any]:
+    """
+    イベントバッファの統計を取得
+
+    Returns:
+        received, dropped, coalesced, delivered, batches, pending, held,
+        capacity, max_update_rate を持つ dict
+    """
+    ...
+
+def flush_events() -> int:
+    """
+    バッファ内のイベント（保留中のフレーム更新を含む）を今すぐ通知
+
+    Returns:
+        通知したイベント数
+    """
+    ...
+
+# Render statistics
+def start_collecting(
+    memory_interval: float = 1.0,
+    max_frames: int = 4194304,
+    clear: bool = True,
+    report_path: Optional[str] = None,
+) -> bool:
+    """
+    レンダー統計の記録を開始（必要ならリスナーを登録）
+
+    すべてのイベントをまとめる前にネイティブで記録するので、
+    フレームごとの時間は max_update_rate に関係なく正確。
+
+    Args:
+        memory_interval: フレームのレンダー中にプロセスメモリを測る間隔（秒、既定 1.0）。
+            ジョブ・アイテムの開始と終了でも測る。0 で測らない。
+        max_frames: 残すフレーム記録の上限（1件 24 バイト）。超えた分も
+            アイテムの要約には数える。
+        clear: それまでの記録を捨てて時刻を0に戻す。
+        report_path: 指定するとジョブ終了ごとにレポートを書き出す
+            （.csv ならアイテムの表、それ以外は JSON）。
+
+    Returns:
+        リスナーが登録されていれば True
+    """
+    ...
+
+def stop_collecting() -> None:
+    """レンダー統計の記録を停止（記録は残る）"""
+    ...
+
+def is_collecting() -> bool:
+    """レンダー統計を記録中か確認"""
+    ...
+
+def clear_stats() -> None:
+    """記録したレンダー統計を捨てて時刻を0に戻す"""
+    ...
+
+def get_collection_info() -> Dict[str, Any]:
+    """
+    統計コレクターの状態を取得
+
+    Returns:
+        collecting, jobs, items, frames, memory_samples, dropped_frames,
+        events, bytes, report_path を持つ dict
+    """
+    ...
+
+def get_job_stats() -> Dict[str, array]:
+    """
+    ジョブごとの統計を列ごとに取得
+
+    Returns:
+        session_id, start, end（実行中は NaN）, items, frames の array.array。
+        時刻は記録開始からの秒。
+    """
+    ...
+
+def get_item_stats() -> Dict[str, array]:
+    """
+    アイテムごとのレンダー統計を列ごとに取得
+
+    Returns:
+        session_id, item_id, status（レンダー中は -1）, start, end, render_time,
+        frames, timed_frames, frame_time_total, frame_time_mean, frame_time_min,
+        frame_time_max, frame_time_p50, frame_time_p95, log_messages, log_errors
+        の array.array。時間を測れたフレームがなければフレーム時間は NaN。
+    """
+    ...
+
+def get_frame_stats(item_id: Optional[int] = None) -> Dict[str, array]:
+    """
+    フレームごとの記録を列ごとに取得
+
+    Returns:
+        session_id, item_id, frame_id, time, duration（不明なら NaN）の array.array
+    """
+    ...
+
+def get_slowest_frames(count: int = 10, item_id: Optional[int] = None) -> Dict[str, array]:
+    """最も遅いフレームを遅い順に取得（列は get_frame_stats と同じ）"""
+    ...
+
+def get_frame_histogram(
+    bins: int = 20,
+    range: Optional[Tuple[float, float]] = None,
+    item_id: Optional[int] = None,
+) -> Tuple[array, array]:
+    """
+    フレーム時間のヒストグラム
+
+    Args:
+        bins: ビンの数
+        range: (min, max) 秒（既定は 0 から最も遅いフレームまで）。範囲外は数えない。
+        item_id: このアイテムのフレームだけ
+
+    Returns:
+        numpy.histogram と同じ (counts, edges)。edges は bins + 1 個。
+    """
+    ...
+
+def get_memory_stats() -> Dict[str, array]:
+    """
+    プロセスメモリのスナップショットを列ごとに取得
+
+    Returns:
+        time, session_id, item_id（アイテムのレンダー中でなければ 0）,
+        working_set, private_bytes（バイト）の array.array
+    """
+    ...
+
+def get_stats_report(
+    format: str = "json", table: str = "items", indent: Optional[int] = None
+) -> str:
+    """
+    レンダー統計のレポートを作成
+
+    Args:
+        format: "json"（ジョブ・アイテム・フレーム・メモリすべて）または "csv"（表1つ）
+        table: CSV の表（"jobs", "items", "frames", "memory"）
+        indent: JSON のインデント（既定はコンパクト）
+    """
+    ...
+
+def export_stats(
+    path: str,
+    format: Optional[str] = None,
+    table: str = "items",
+    indent: Optional[int] = None,
+) -> None:
+    """
+    レンダー統計のレポートをファイルに書き出す
+
+    Args:
+        path: 出力先
+        format: "json" または "csv"（既定は拡張子から。.csv なら CSV）
+        table: CSV の表（"jobs", "items", "frames", "memory"）
+        indent: JSON のインデント（既定はコンパクト）
+    """
+    ...
+
 __all__ = [
     "STATUS_UNKNOWN",
     "STATUS_SUCCEEDED",
@@ -166,4 +361,21 @@ __all__ = [
     "set_on_item_updated",
     "set_on_item_ended",
     "set_on_report_log",
+    "set_on_events",
+    "configure_events",
+    "get_event_stats",
+    "flush_events",
+    "start_collecting",
+    "stop_collecting",
+    "is_collecting",
+    "clear_stats",
+    "get_collection_info",
+    "get_job_stats",
+    "get_item_stats",
+    "get_frame_stats",
+    "get_slowest_frames",
+    "get_frame_histogram",
+    "get_memory_stats",
+    "get_stats_report",
+    "export_stats",
 ]
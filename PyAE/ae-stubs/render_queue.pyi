@@ -1,7 +1,7 @@
 # ae.render_queue - RenderQueue API
 # PyAE - Python for After Effects
 
-from typing import Optional, List, Union
+from typing import Any, Dict, Iterable, Optional, List, Sequence, Union
 from .item import Comp, CompItem
 from .types import RenderStatus, EmbedOptions
 
@@ -104,12 +104,35 @@ def add_comp(comp: Union[Comp, CompItem], path: str = "") -> Optional[RenderQueu
     """
     ...
 
-def render_settings_templates() -> List[str]:
-    """レンダー設定テンプレート名リスト (現在は空リスト)"""
+def add_comps(
+    entries: Iterable[Union[Comp, CompItem, Sequence[Any], Dict[str, Any]]],
+) -> List[Dict[str, Any]]:
+    """
+    複数のコンポジションをまとめてレンダーキューに追加
+    Args:
+        entries: コンポ、(comp, render_template, output_module_template, path) の
+                 タプル（後ろは省略可）、または同じキーを持つ dict のリスト。
+                 None の設定は既定のまま
+    Returns:
+        エントリごとの {"item": RenderQueueItem または None, "error": None またはメッセージ}。
+        失敗したエントリは追加されず、ほかのエントリは続けて追加される
+    Note:
+        1つのアンドゥグループで追加し、テンプレートは ExtendScript 1回でまとめて適用する
+    """
+    ...
+
+def render_settings_templates(refresh: bool = False) -> List[str]:
+    """
+    レンダー設定テンプレート名リスト
+    Args:
+        refresh: キャッシュを読み直す（テンプレートを編集した後など）
+    Note:
+        テンプレート名はレンダーキューアイテムから取得するため、キューが空の間は空リスト
+    """
     ...
 
-def output_module_templates() -> List[str]:
-    """出力モジュールテンプレート名リスト (現在は空リスト)"""
+def output_module_templates(refresh: bool = False) -> List[str]:
+    """出力モジュールテンプレート名リスト（render_settings_templates と同様にキャッシュ）"""
     ...
 
 __all__ = [
@@ -119,6 +142,7 @@ __all__ = [
     "num_items",
     "item",
     "add_comp",
+    "add_comps",
     "render_settings_templates",
     "output_module_templates",
 ]
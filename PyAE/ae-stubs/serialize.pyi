@@ -0,0 +1,173 @@
+# ae.serialize - Native JSON / Snapshot Serializer
+# PyAE - Python for After Effects
+
+from typing import Any, Callable, Dict, Optional, Tuple, Union
+
+from .comp import Comp
+from .item import CompItem, Item
+from .layer import Layer
+
+def project_to_json(path: Optional[str] = None, indent: Optional[int] = None) -> Optional[str]:
+    """
+    現在のプロジェクトをJSONにシリアライズ（project_to_dict と同じスキーマ）
+
+    Pythonオブジェクトを経由せず、SDKから直接JSONを書き出します。
+
+    Args:
+        path: 出力ファイルパス（Noneの場合はJSON文字列を返す）
+        indent: インデント幅（Noneでコンパクト出力）
+
+    Returns:
+        pathがNoneの場合はJSON文字列、それ以外はNone
+    """
+    ...
+
+def comp_to_json(comp: Union[Comp, CompItem], path: Optional[str] = None,
+                 indent: Optional[int] = None) -> Optional[str]:
+    """
+    コンポジションをJSONにシリアライズ（comp_to_dict と同じスキーマ）
+
+    Args:
+        comp: Comp または CompItem
+        path: 出力ファイルパス（Noneの場合はJSON文字列を返す）
+        indent: インデント幅（Noneでコンパクト出力）
+
+    Returns:
+        pathがNoneの場合はJSON文字列、それ以外はNone
+    """
+    ...
+
+def layer_to_json(layer: Layer, path: Optional[str] = None,
+                  indent: Optional[int] = None) -> Optional[str]:
+    """
+    レイヤーをJSONにシリアライズ（layer_to_dict と同じスキーマ）
+
+    Args:
+        layer: レイヤー
+        path: 出力ファイルパス（Noneの場合はJSON文字列を返す）
+        indent: インデント幅（Noneでコンパクト出力）
+
+    Returns:
+        pathがNoneの場合はJSON文字列、それ以外はNone
+    """
+    ...
+
+def project_to_snapshot(path: Optional[str] = None) -> Optional[bytes]:
+    """
+    現在のプロジェクトをバイナリスナップショットにシリアライズ（ae.snapshot 形式）
+
+    Args:
+        path: 出力ファイルパス（Noneの場合はbytesを返す）
+
+    Returns:
+        pathがNoneの場合はスナップショットのbytes、それ以外はNone
+    """
+    ...
+
+def comp_to_snapshot(comp: Union[Comp, CompItem], path: Optional[str] = None) -> Optional[bytes]:
+    """
+    コンポジションをバイナリスナップショットにシリアライズ
+
+    Args:
+        comp: Comp または CompItem
+        path: 出力ファイルパス（Noneの場合はbytesを返す）
+
+    Returns:
+        pathがNoneの場合はスナップショットのbytes、それ以外はNone
+    """
+    ...
+
+def layer_to_snapshot(layer: Layer, path: Optional[str] = None) -> Optional[bytes]:
+    """
+    レイヤーをバイナリスナップショットにシリアライズ
+
+    Args:
+        layer: レイヤー
+        path: 出力ファイルパス（Noneの場合はbytesを返す）
+
+    Returns:
+        pathがNoneの場合はスナップショットのbytes、それ以外はNone
+    """
+    ...
+
+def project_from_dict(data: Dict[str, Any],
+                      progress: Optional[Callable[[str, int, int], None]] = None) -> Dict[int, Item]:
+    """
+    project_to_dict 形式の辞書から現在のプロジェクトにアイテムを一括作成
+
+    フォルダ・コンポ・ファイルフッテージ・レイヤー・プロパティ・エフェクト・
+    キーフレームを1つのアンドゥグループで作成します。キーフレームは
+    プロパティごとに AEGP_StartAddKeyframes のバッチで追加されます。
+
+    Args:
+        data: プロジェクト辞書（project_to_dict と同じスキーマ）
+        progress: 進捗コールバック (phase, done, total)。コンポ・フッテージ・
+            レイヤーを1つ作るたびにインポート中に同期的に呼ばれます。
+            コールバックが例外を送出するとインポートは中断されます
+
+    Returns:
+        JSON のアイテムID → 作成したアイテムの辞書
+    """
+    ...
+
+def diff(base: Dict[str, Any], target: Dict[str, Any], prune: bool = False) -> Dict[str, Any]:
+    """
+    2つの project_to_dict 形式の辞書の差分パッチを生成
+
+    アイテムはID（無ければ種類と名前が一意なもの）、レイヤーは
+    (名前, 種類, 出現順)、プロパティはマッチ名のパスで対応付けます。
+    キーフレームはキー単位の追加・削除として表されます。
+    既存アイテムは base 側のIDで参照されるため、base を取得した
+    プロジェクトに適用してください。
+
+    Args:
+        base: 現在の状態（project_to_dict スキーマ）
+        target: 目標の状態（project_to_dict スキーマ）
+        prune: base にしか無いアイテム・レイヤーも削除する
+
+    Returns:
+        apply_patch() に渡すパッチ {"version", "id_map", "ops"}
+    """
+    ...
+
+def diff_live(target: Dict[str, Any],
+              base: Optional[Dict[str, Any]] = None,
+              since: Optional[Tuple[int, int, int, int]] = None,
+              prune: bool = False) -> Dict[str, Any]:
+    """
+    現在のプロジェクトから target への差分パッチを生成
+
+    base と since を指定すると、since 以降に変更の無いコンポ・フッテージ
+    （Renderer.has_item_changed_since_timestamp で判定）は再走査せず
+    base の内容を再利用します（名前とフォルダのみ更新）。そのため
+    レンダリングに影響しない変更（ラベル・コメント等）は検出されない
+    場合があります。
+
+    Args:
+        target: 目標の状態（project_to_dict スキーマ）
+        base: 以前に取得したこのプロジェクトの project_to_dict
+        since: base 取得時の Renderer.get_current_timestamp()
+        prune: target に無いアイテム・レイヤーも削除する
+
+    Returns:
+        apply_patch() に渡すパッチ
+
+    Raises:
+        ValueError: base を指定せずに since を指定した場合
+    """
+    ...
+
+def apply_patch(patch: Dict[str, Any]) -> Dict[str, int]:
+    """
+    diff() / diff_live() のパッチを現在のプロジェクトに適用
+
+    すべての操作を1つのアンドゥグループで実行します。失敗した操作
+    （存在しなくなったプロパティ等）はログに記録され skipped に数えられます。
+
+    Args:
+        patch: パッチ辞書
+
+    Returns:
+        件数の辞書 (ops, skipped, items, layers, properties, keyframes, effects)
+    """
+    ...
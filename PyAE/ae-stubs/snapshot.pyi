@@ -0,0 +1,154 @@
+# ae.snapshot - Binary Project Snapshots
+# PyAE - Python for After Effects
+
+from typing import Any, Dict, List, Optional, Sequence, Union
+
+SnapshotPath = Union[None, str, Sequence[Union[str, int]]]
+
+def dumps(data: Any) -> bytes:
+    """
+    dict（ae_serialize スキーマ）をスナップショットのbytesに変換
+
+    Args:
+        data: JSON互換の値（dict, list, str, int, float, bool, None）
+
+    Returns:
+        スナップショットのbytes
+    """
+    ...
+
+def dump(data: Any, path: str) -> None:
+    """
+    dict（ae_serialize スキーマ）をスナップショットファイルに書き出す
+
+    Args:
+        data: JSON互換の値
+        path: 出力ファイルパス
+    """
+    ...
+
+def loads(data: bytes) -> Any:
+    """
+    スナップショットのbytesをPythonオブジェクトに復元
+
+    Args:
+        data: スナップショットのbytes
+
+    Returns:
+        復元した値（project/comp/layer スナップショットは dict）
+    """
+    ...
+
+def load(path: str) -> Any:
+    """
+    スナップショットファイルをPythonオブジェクトに復元
+
+    Args:
+        path: スナップショットファイルパス
+
+    Returns:
+        復元した値（project/comp/layer スナップショットは dict）
+    """
+    ...
+
+class Snapshot:
+    """
+    ae.snapshot.open() で開いたメモリマップ済みスナップショット
+
+    要求された値だけをデコードします。パスは "/" 区切りの文字列
+    （"items/0/comp_data/layers"）か、キーとインデックスのリスト
+    （["items", 0, "name"]）で指定します。close() までファイルはマップされたままです。
+    """
+
+    @property
+    def version(self) -> int:
+        """フォーマットバージョン"""
+        ...
+
+    @property
+    def size(self) -> int:
+        """ファイルサイズ（バイト）"""
+        ...
+
+    @property
+    def string_count(self) -> int:
+        """文字列テーブルの文字列数"""
+        ...
+
+    @property
+    def closed(self) -> bool:
+        """close() 済みかどうか"""
+        ...
+
+    def get(self, path: SnapshotPath = None, default: Any = None) -> Any:
+        """
+        パスの値をデコードして返す
+
+        Args:
+            path: 値へのパス（Noneでドキュメント全体）
+            default: パスが存在しない場合の戻り値
+
+        Returns:
+            デコードした値、または default
+        """
+        ...
+
+    def keys(self, path: SnapshotPath = None) -> List[str]:
+        """
+        パスのオブジェクトのキー一覧（値はデコードしない）
+
+        Args:
+            path: オブジェクトへのパス（Noneでルート）
+
+        Returns:
+            キーのリスト
+
+        Raises:
+            KeyError: パスが存在しない場合
+        """
+        ...
+
+    def count(self, path: SnapshotPath = None) -> int:
+        """
+        パスのコンテナの要素数（スカラーは0）
+
+        Args:
+            path: オブジェクトまたはリストへのパス（Noneでルート）
+
+        Returns:
+            要素数
+
+        Raises:
+            KeyError: パスが存在しない場合
+        """
+        ...
+
+    def list_items(self) -> List[Dict[str, Any]]:
+        """
+        プロジェクトアイテムの概要一覧（id, name, type, parent_folder_id）
+
+        comp_data / footage_data は読み飛ばします。
+
+        Returns:
+            dictのリスト（project スナップショット以外は空）
+        """
+        ...
+
+    def close(self) -> None:
+        """ファイルのマップを解除"""
+        ...
+
+    def __enter__(self) -> "Snapshot": ...
+    def __exit__(self, *args: Any) -> None: ...
+
+def open(path: str) -> Snapshot:
+    """
+    スナップショットファイルを遅延読み込み（メモリマップ）で開く
+
+    Args:
+        path: スナップショットファイルパス
+
+    Returns:
+        Snapshot
+    """
+    ...
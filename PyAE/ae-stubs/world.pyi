@@ -5,7 +5,10 @@ Provides access to After Effects frame buffers for image data manipulation.
 """
 
 from enum import IntEnum
-from typing import Tuple
+from typing import TYPE_CHECKING, Any, Dict, List, Optional, Tuple, Union
+
+if TYPE_CHECKING:
+    import numpy
 
 
 class WorldType(IntEnum):
@@ -23,6 +26,49 @@ class WorldType(IntEnum):
     BIT32 = 3
 
 
+class PixelLayout(IntEnum):
+    """Channel layout for World.read_pixels / write_pixels.
+
+    Attributes:
+        ARGB: Interleaved A, R, G, B (native World order)
+        RGBA: Interleaved R, G, B, A
+        BGRA: Interleaved B, G, R, A
+        PLANAR: Separate R, G, B, A planes, shape (4, height, width)
+    """
+    ARGB = 0
+    RGBA = 1
+    BGRA = 2
+    PLANAR = 3
+
+
+class AlphaOp(IntEnum):
+    """Alpha handling applied while converting pixels.
+
+    Attributes:
+        NONE: Copy color channels as-is
+        PREMULTIPLY: RGB *= A
+        UNPREMULTIPLY: RGB /= A (RGB = 0 where A == 0)
+    """
+    NONE = 0
+    PREMULTIPLY = 1
+    UNPREMULTIPLY = 2
+
+
+class ResizeFilter(IntEnum):
+    """Filter for World.resize / resize_into / read_resized.
+
+    Attributes:
+        BOX: Average of the source pixels whose centers fall in the
+            target pixel (fastest; exact for integer factors; nearest
+            neighbour when enlarging)
+        BILINEAR: 2x2 linear interpolation (enlarging, mild reduction)
+        AREA: Average weighted by covered area (best for arbitrary reduction)
+    """
+    BOX = 0
+    BILINEAR = 1
+    AREA = 2
+
+
 class World:
     """Frame buffer for image data.
 
@@ -45,6 +91,13 @@ class World:
 
         # Apply blur
         world.fast_blur(5.0)
+
+        # Zero-copy view (NumPy), shape (height, width, 4) ARGB
+        pixels = world.as_array()
+        pixels[..., 0] = 255  # opaque alpha
+
+    World implements the buffer protocol, so memoryview(world) is a
+    (height, width, 4) view of the pixels without copying.
     """
 
     @property
@@ -77,6 +130,20 @@ class World:
         """Get bytes per row (row stride)."""
         ...
 
+    @property
+    def bytes_per_pixel(self) -> int:
+        """Get bytes per pixel (4, 8 or 16)."""
+        ...
+
+    def refresh(self) -> None:
+        """Re-query type, size, row bytes and base address.
+
+        These are cached on first use since they do not change during
+        the world's lifetime; call this only if the underlying handle
+        was modified outside PyAE.
+        """
+        ...
+
     def get_pixels(self) -> bytes:
         """Get all pixel data as bytes.
 
@@ -91,13 +158,343 @@ class World:
         """
         ...
 
-    def set_pixels(self, data: bytes) -> None:
-        """Set all pixel data from bytes.
+    def set_pixels(self, data: Union[bytes, bytearray, memoryview, "numpy.ndarray"]) -> None:
+        """Set all pixel data from a buffer.
 
+        Accepts bytes, bytearray, memoryview or a C-contiguous NumPy array;
+        the data is copied once directly into the world.
         Data size must match row_bytes * height.
 
         Args:
-            data: Raw pixel data as bytes
+            data: Raw pixel data (any C-contiguous buffer)
+        """
+        ...
+
+    def as_array(self) -> "numpy.ndarray":
+        """Get a zero-copy NumPy view of the pixels.
+
+        Shape is (height, width, 4) in ARGB channel order. dtype is
+        uint8 (BIT8), uint16 (BIT16, 0-32768) or float32 (BIT32).
+        Row stride follows row_bytes. Writes go directly to the world.
+        The array keeps this World alive. Worlds not owned by PyAE
+        (e.g. FrameReceipt.world) give a read-only array, and it must not
+        be used after the receipt is checked in; copy it with
+        numpy.array() to keep the pixels.
+
+        Returns:
+            numpy.ndarray view of the pixel memory
+
+        Raises:
+            ImportError: NumPy is not installed
+        """
+        ...
+
+    def __buffer__(self, flags: int) -> memoryview: ...
+
+    def read_pixels(self,
+                    out: Optional[Union[bytearray, memoryview, "numpy.ndarray"]] = None,
+                    layout: PixelLayout = PixelLayout.RGBA,
+                    depth: WorldType = WorldType.BIT32,
+                    alpha: AlphaOp = AlphaOp.NONE) -> Union[memoryview, bytearray, "numpy.ndarray"]:
+        """Convert the pixels into another layout and depth.
+
+        Values are normalized between depths (uint16 uses the AE
+        0-32768 range). Conversion uses AVX2 / SSE4.1 kernels when
+        the CPU supports them and runs without the GIL.
+
+        Args:
+            out: Writable C-contiguous buffer of exactly
+                width * height * 4 channels (e.g. a NumPy array), or None
+            layout: PixelLayout of the result (default RGBA)
+            depth: WorldType of the result channels (default BIT32)
+            alpha: AlphaOp applied while converting (default NONE)
+
+        Returns:
+            out, or a new memoryview shaped (height, width, 4)
+            ((4, height, width) for PLANAR)
+        """
+        ...
+
+    def write_pixels(self,
+                     data: Union[bytes, bytearray, memoryview, "numpy.ndarray"],
+                     layout: PixelLayout = PixelLayout.RGBA,
+                     alpha: AlphaOp = AlphaOp.NONE) -> None:
+        """Convert a pixel buffer into the world.
+
+        The source depth follows the buffer format: uint8, uint16
+        (0-32768) or float32. The buffer must be C-contiguous and hold
+        width * height * 4 channels.
+
+        Args:
+            data: Source buffer (bytes, bytearray, memoryview, NumPy array)
+            layout: PixelLayout of data (default RGBA)
+            alpha: AlphaOp applied while converting (default NONE)
+        """
+        ...
+
+    def read_region(self, x: int, y: int, width: int, height: int,
+                    out: Optional[Union[bytearray, memoryview, "numpy.ndarray"]] = None,
+                    layout: PixelLayout = PixelLayout.RGBA,
+                    depth: WorldType = WorldType.BIT32,
+                    alpha: AlphaOp = AlphaOp.NONE) -> Union[memoryview, bytearray, "numpy.ndarray"]:
+        """Convert a rectangle of pixels (see read_pixels).
+
+        The rectangle must lie inside the world.
+
+        Args:
+            x, y: Top-left corner
+            width, height: Region size
+            out: Writable C-contiguous buffer of exactly
+                width * height * 4 channels, or None
+            layout: PixelLayout of the result (default RGBA)
+            depth: WorldType of the result channels (default BIT32)
+            alpha: AlphaOp applied while converting (default NONE)
+
+        Returns:
+            out, or a new memoryview shaped (height, width, 4)
+            ((4, height, width) for PLANAR)
+        """
+        ...
+
+    def write_region(self, x: int, y: int, width: int, height: int,
+                     data: Union[bytes, bytearray, memoryview, "numpy.ndarray"],
+                     layout: PixelLayout = PixelLayout.RGBA,
+                     alpha: AlphaOp = AlphaOp.NONE) -> None:
+        """Convert a pixel buffer into a rectangle (see write_pixels).
+
+        The rectangle must lie inside the world and data must hold
+        width * height * 4 channels.
+        """
+        ...
+
+    def fill(self, color: Tuple[float, float, float, float]) -> None:
+        """Fill the whole world with a color.
+
+        Args:
+            color: (R, G, B, A) normalized to 0.0-1.0
+        """
+        ...
+
+    def fill_rect(self, x: int, y: int, width: int, height: int,
+                  color: Tuple[float, float, float, float]) -> None:
+        """Fill a rectangle with a color (clipped to the world).
+
+        Args:
+            x, y: Top-left corner
+            width, height: Rectangle size
+            color: (R, G, B, A) normalized to 0.0-1.0
+        """
+        ...
+
+    def copy_region(self, src: 'World', src_x: int, src_y: int, width: int, height: int,
+                    dst_x: int = 0, dst_y: int = 0) -> None:
+        """Copy a rectangle from another world into this one.
+
+        Worlds may differ in bit depth (values are normalized). src may
+        be this world; overlapping regions are handled.
+
+        Args:
+            src: Source World
+            src_x, src_y: Top-left corner in src
+            width, height: Region size (must fit in both worlds)
+            dst_x, dst_y: Top-left corner in this world (default 0, 0)
+        """
+        ...
+
+    def draw_line(self, x0: int, y0: int, x1: int, y1: int,
+                  color: Tuple[float, float, float, float], thickness: int = 1) -> None:
+        """Draw a line between two pixels (clipped to the world).
+
+        Args:
+            x0, y0: Start pixel
+            x1, y1: End pixel
+            color: (R, G, B, A) normalized to 0.0-1.0
+            thickness: Line width in pixels (default 1)
+        """
+        ...
+
+    def draw_rect(self, x: int, y: int, width: int, height: int,
+                  color: Tuple[float, float, float, float], thickness: int = 1) -> None:
+        """Draw a rectangle outline (clipped to the world).
+
+        Args:
+            x, y: Top-left corner
+            width, height: Outer size
+            color: (R, G, B, A) normalized to 0.0-1.0
+            thickness: Border width inside the rectangle (default 1)
+        """
+        ...
+
+    def fill_circle(self, cx: float, cy: float, radius: float,
+                    color: Tuple[float, float, float, float]) -> None:
+        """Fill a circle (pixels whose centers lie inside; clipped).
+
+        Args:
+            cx, cy: Center in pixel coordinates
+            radius: Radius in pixels
+            color: (R, G, B, A) normalized to 0.0-1.0
+        """
+        ...
+
+    def statistics(self, bins: int = 256,
+                   range: Tuple[float, float] = (0.0, 1.0),
+                   histogram: bool = True,
+                   region: Optional[Tuple[int, int, int, int]] = None) -> Dict[str, Any]:
+        """Compute per-channel statistics (R, G, B, A) in one native pass.
+
+        Values are normalized (8/16 bpc to 0.0-1.0; float as stored).
+        Moments ignore NaN; a channel with no finite samples reports NaN.
+        Large images are split across threads by rows.
+
+        Args:
+            bins: Histogram bins over range (1-65536, default 256)
+            range: (min, max) of the histogram (default (0.0, 1.0));
+                values outside are counted in below / above
+            histogram: Build the histogram (default True)
+            region: (x, y, width, height) inside the world, or None
+
+        Returns:
+            dict with pixels, bins, range, min, max, mean, std, nan,
+            below, above (4-tuples per channel) and histogram
+            (4 lists of counts, or None)
+        """
+        ...
+
+    def compare(self, other: Union["World", bytes, bytearray, memoryview, "numpy.ndarray"],
+                layout: PixelLayout = PixelLayout.RGBA,
+                tolerance: float = 0.0,
+                early_exit: bool = False,
+                ssim: bool = True,
+                ssim_tile: int = 8,
+                diff: Optional["World"] = None) -> Dict[str, Any]:
+        """Compare this world with another World or a pixel buffer.
+
+        Both images are normalized (8/16 bpc to 0.0-1.0) so any bit
+        depths can be compared. The comparison is vectorized and split
+        across threads. NaN equals NaN; NaN against a number is an
+        infinite error.
+
+        Args:
+            other: World, or a C-contiguous buffer (uint8 / uint16
+                0-32768 / float32) of width * height * 4 channels
+            layout: PixelLayout of a buffer (default RGBA)
+            tolerance: Largest channel difference still counted as
+                identical (default 0.0)
+            early_exit: Stop at the first differing pixel (default False);
+                the metrics then cover only the rows compared
+            ssim: Compute tiled SSIM (default True)
+            ssim_tile: SSIM tile size in pixels (1-256, default 8)
+            diff: World of the same size that receives |a - b| per
+                channel with opaque alpha, or None
+
+        Returns:
+            dict with identical, complete, pixels, differing_pixels,
+            max_abs, mean_abs, mse, ssim_channels (R, G, B, A tuples),
+            and max_error, mean_error, psnr (dB), ssim over RGB
+        """
+        ...
+
+    def resize(self, width: int, height: int,
+               filter: ResizeFilter = ResizeFilter.AREA,
+               type: Optional[WorldType] = None) -> "World":
+        """Return a resized copy of the world.
+
+        The new world comes from WorldPool. Rows are decoded, filtered
+        with SIMD kernels and split across threads without the GIL.
+
+        Args:
+            width, height: Target size (1-30000)
+            filter: ResizeFilter (default AREA)
+            type: WorldType of the result, or None for this world's type
+
+        Returns:
+            New World
+        """
+        ...
+
+    def resize_into(self, dst: "World", filter: ResizeFilter = ResizeFilter.AREA) -> None:
+        """Resize the world into another World (e.g. a reused thumbnail).
+
+        The target size is dst's size; bit depths may differ.
+
+        Args:
+            dst: Destination World (not this world)
+            filter: ResizeFilter (default AREA)
+        """
+        ...
+
+    def read_resized(self, width: int, height: int,
+                     out: Optional[Any] = None,
+                     filter: ResizeFilter = ResizeFilter.AREA,
+                     layout: PixelLayout = PixelLayout.RGBA,
+                     depth: WorldType = WorldType.BIT8,
+                     alpha: AlphaOp = AlphaOp.NONE) -> Any:
+        """Resize the world into a pixel buffer (see read_pixels).
+
+        Defaults to 8-bit RGBA, ready for UI toolkits.
+
+        Args:
+            width, height: Target size
+            out: Writable C-contiguous buffer of exactly
+                width * height * 4 channels, or None
+            filter: ResizeFilter (default AREA)
+            layout: PixelLayout of the result (default RGBA)
+            depth: WorldType of the result channels (default BIT8)
+            alpha: AlphaOp applied after resizing (default NONE)
+
+        Returns:
+            out, or a new memoryview shaped (height, width, 4)
+            ((4, height, width) for PLANAR)
+        """
+        ...
+
+    def apply_kernel(self, name: str,
+                     other: Optional["World"] = None,
+                     region: Optional[Tuple[int, int, int, int]] = None,
+                     tile_size: int = 64,
+                     **params: Any) -> Dict[str, int]:
+        """Run a registered native kernel over the world in place.
+
+        The image is split into square tiles that run on worker
+        threads; each tile is decoded to float RGBA, processed and
+        written back. Python is not called per tile and the GIL is
+        released while the kernel runs. See PixelKernels.names().
+
+        Args:
+            name: Kernel name (e.g. 'gain_gamma', 'blend')
+            other: Second input World of the same size (2-input
+                kernels such as 'blend'; may be this world)
+            region: (x, y, width, height) inside the world, or None
+            tile_size: Tile edge in pixels (8-1024, default 64)
+            **params: Kernel parameters (numbers, sequences of
+                numbers or strings)
+
+        Returns:
+            dict with tiles and threads
+
+        Example:
+            world.apply_kernel('gain_gamma', gain=1.2, gamma=2.2)
+            world.apply_kernel('blend', other=overlay, mode='screen', opacity=0.5)
+        """
+        ...
+
+    @staticmethod
+    def simd_level() -> str:
+        """Get the instruction set used by pixel conversion
+        ('avx2', 'sse4.1' or 'scalar')."""
+        ...
+
+    @staticmethod
+    def set_simd_level(level: str) -> str:
+        """Force the pixel conversion instruction set (for testing and
+        benchmarks). Levels the CPU lacks fall back to the best
+        supported one.
+
+        Args:
+            level: 'avx2', 'sse4.1' or 'scalar'
+
+        Returns:
+            The level in effect
         """
         ...
 
@@ -142,15 +539,100 @@ class World:
         ...
 
     @staticmethod
-    def create(type: WorldType, width: int, height: int) -> 'World':
+    def create(type: WorldType, width: int, height: int, clear: bool = True) -> 'World':
         """Create a new world with specified dimensions.
 
+        Worlds of the same type and size are recycled through
+        WorldPool; a disposed world returns to the pool.
+
         Args:
             type: WorldType (BIT8, BIT16, or BIT32)
             width: Width in pixels (1-30000)
             height: Height in pixels (1-30000)
+            clear: Zero the pixels of a recycled world (default True).
+                Pass False for scratch worlds that are fully overwritten
 
         Returns:
             New World instance
         """
         ...
+
+
+class PixelKernels:
+    """Registry of native pixel kernels run by World.apply_kernel.
+
+    Built-in kernels: gain_gamma, threshold, channel_shuffle, lut, blend.
+
+    Example::
+
+        for name in ae.PixelKernels.names():
+            print(ae.PixelKernels.info(name)['description'])
+    """
+
+    @staticmethod
+    def names() -> List[str]:
+        """Get the registered kernel names (sorted)"""
+        ...
+
+    @staticmethod
+    def info(name: str) -> Dict[str, Union[str, int]]:
+        """Get a dict with name, inputs (1 or 2) and description
+        (including the parameters) of a kernel"""
+        ...
+
+
+class WorldPool:
+    """Pool that recycles worlds created by World.create.
+
+    Worlds are kept per (type, width, height). When the pooled total
+    exceeds max_bytes, the least recently returned worlds are disposed.
+
+    Example::
+
+        ae.WorldPool.set_max_bytes(512 * 1024 * 1024)
+        for frame in range(1000):
+            scratch = ae.World.create(ae.WorldType.BIT8, 1920, 1080, clear=False)
+            ...
+        print(ae.WorldPool.stats())
+    """
+
+    @staticmethod
+    def stats() -> Dict[str, Union[int, bool]]:
+        """Get pool statistics as a dict.
+
+        Keys: hits, misses, returned, evicted, pooled_worlds,
+        pooled_bytes, live_worlds, live_bytes, peak_bytes
+        (peak of live + pooled bytes), max_bytes, enabled
+        """
+        ...
+
+    @staticmethod
+    def reset_stats() -> None:
+        """Reset counters and peak_bytes (pooled worlds are kept)."""
+        ...
+
+    @staticmethod
+    def max_bytes() -> int:
+        """Get the pooled byte limit."""
+        ...
+
+    @staticmethod
+    def set_max_bytes(max_bytes: int) -> None:
+        """Set the pooled byte limit; excess worlds are disposed (LRU)."""
+        ...
+
+    @staticmethod
+    def enabled() -> bool:
+        """Check whether disposed worlds are pooled."""
+        ...
+
+    @staticmethod
+    def set_enabled(enabled: bool) -> None:
+        """Enable or disable pooling. Disabling disposes all pooled worlds."""
+        ...
+
+    @staticmethod
+    def trim(max_bytes: int = 0) -> None:
+        """Dispose least recently used worlds until the pool holds at
+        most max_bytes (default 0: empty the pool)."""
+        ...
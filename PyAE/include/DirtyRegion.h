@@ -0,0 +1,89 @@
+// DirtyRegion.h
+// PyAE - Python for After Effects
+// 差分レンダー用の更新領域の集計
+//
+// 変更されたレイヤーの範囲（前回の位置と今回の位置の両方）やカーソル周りの
+// 矩形を集め、レンダーする少数の矩形にまとめる。座標はフレームの画素で、
+// すべてフレームの範囲に切り詰める。SDK に依存しない。
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace PyAE {
+
+// 半開区間の矩形 [left, right) x [top, bottom)
+struct PixelRect {
+    int left = 0;
+    int top = 0;
+    int right = 0;
+    int bottom = 0;
+
+    bool IsEmpty() const { return right <= left || bottom <= top; }
+    int Width() const { return IsEmpty() ? 0 : right - left; }
+    int Height() const { return IsEmpty() ? 0 : bottom - top; }
+    int64_t Area() const { return static_cast<int64_t>(Width()) * Height(); }
+    bool Contains(const PixelRect& other) const;
+
+    bool operator==(const PixelRect& other) const {
+        return left == other.left && top == other.top &&
+               right == other.right && bottom == other.bottom;
+    }
+    bool operator!=(const PixelRect& other) const { return !(*this == other); }
+
+    // 空の矩形は無視する
+    static PixelRect Union(const PixelRect& a, const PixelRect& b);
+    static PixelRect Intersect(const PixelRect& a, const PixelRect& b);
+
+    // 点を囲む最小の画素矩形（小数は外側へ丸める）。NaN / 無限大を含めば空
+    static PixelRect Bounds(const double* xs, const double* ys, int count);
+};
+
+class DirtyRegion {
+public:
+    DirtyRegion(int width, int height);
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    PixelRect GetFrame() const { return PixelRect{0, 0, m_width, m_height}; }
+
+    // フレームの大きさを変える。レイヤーの記録を消してフレーム全体を更新領域にする
+    void Resize(int width, int height);
+
+    // rect を padding 画素広げて更新領域に加える
+    void Add(const PixelRect& rect, int padding = 0);
+    void AddAll();
+
+    // レイヤーの今回の範囲を記録し、前回の範囲とあわせて更新領域に加える
+    // （動いたレイヤーは元の位置も描き直す必要がある）
+    void UpdateLayer(uint64_t id, const PixelRect& bounds, int padding = 0);
+
+    // 更新領域は変えずに、レイヤーの範囲だけを記録する（全体をレンダーしたとき）
+    void TrackLayer(uint64_t id, const PixelRect& bounds);
+
+    // 記録した範囲を更新領域に加えて忘れる（削除されたレイヤー）
+    void RemoveLayer(uint64_t id, int padding = 0);
+
+    bool HasLayer(uint64_t id) const { return m_layers.count(id) != 0; }
+    void ClearLayers() { m_layers.clear(); }
+
+    bool IsEmpty() const { return m_rects.empty(); }
+
+    // 更新領域を maxRects 個以下の矩形にまとめて取り出し、空にする。
+    // 重なる矩形や、まとめても面積が増えない矩形は常にまとめ、それでも
+    // 多ければ面積の増え方が最も小さい組から順にまとめる
+    std::vector<PixelRect> Take(size_t maxRects = 1);
+
+private:
+    PixelRect Clip(const PixelRect& rect, int padding) const;
+
+    int m_width;
+    int m_height;
+    std::vector<PixelRect> m_rects;
+    std::unordered_map<uint64_t, PixelRect> m_layers;
+};
+
+} // namespace PyAE
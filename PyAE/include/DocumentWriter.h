@@ -0,0 +1,38 @@
+// DocumentWriter.h
+// PyAE - Python for After Effects
+// 構造化ドキュメント出力インターフェース
+//
+// ProjectSerializer の出力先を抽象化する。JsonWriter（テキスト）と
+// SnapshotWriter（バイナリスナップショット）が実装する。
+// 呼び出し規約は JSON と同じ（オブジェクト内では Key の直後に値を1つ書く）。
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace PyAE {
+
+class DocumentWriter {
+public:
+    virtual ~DocumentWriter() = default;
+
+    // 構造
+    virtual void BeginObject() = 0;
+    virtual void EndObject() = 0;
+    virtual void BeginArray() = 0;
+    virtual void EndArray() = 0;
+    virtual void Key(std::string_view key) = 0;
+
+    // 値
+    virtual void String(std::string_view value) = 0;
+    virtual void Bool(bool value) = 0;
+    virtual void Null() = 0;
+    virtual void Int(int64_t value) = 0;
+    virtual void Number(double value) = 0;
+
+    // バイト列（JSON では小文字16進文字列として表現される）
+    virtual void HexString(std::string_view bytes) = 0;
+};
+
+} // namespace PyAE
@@ -0,0 +1,164 @@
+// FrameCache.h
+// PyAE - Python for After Effects
+// レンダー結果のフレームキャッシュ（メモリ + ディスク）
+//
+// キーはアイテム・時刻・レンダー設定（ダウンサンプル、ROI、ワールドの種類、
+// 品質など）で、その 64bit ハッシュがエントリーのアドレス（ディスクでは
+// ファイル名）になる。各エントリーはレンダー直前の AEGP タイムスタンプを
+// 持ち、参照時に呼び出し側の検証関数（AEGP_HasItemChangedSinceTimestamp）で
+// 古くなっていないか確かめる。
+//
+// メモリ上のエントリーはバイト数の上限で LRU から追い出し、ディスクの
+// ディレクトリが指定されていればそこへ退避する（ディスク側もバイト数の
+// 上限で LRU）。タイムスタンプはセッションをまたいで比べられないため、
+// インスタンスごとにディレクトリの下へ専用のサブディレクトリを作り、
+// 破棄するときにそれだけを消す。ファイルの読み書きはロックの外で行う。
+// AE の API は呼ばない。
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "PixelConvert.h"
+#include "WinSync.h"
+
+namespace PyAE {
+
+class FrameCache {
+public:
+    // キャッシュのキー（ディスクのヘッダーにもそのまま書く）
+    struct Key {
+        uint64_t item = 0;          // AEGP_ItemH
+        int64_t time = 0;           // マイクロ秒
+        int32_t worldType = 0;
+        int32_t quality = 0;
+        int32_t downsampleX = 1;
+        int32_t downsampleY = 1;
+        int32_t roi[4] = {0, 0, 0, 0};  // left, top, right, bottom
+        int32_t field = 0;
+        int32_t matteMode = 0;
+        int32_t channelOrder = 0;
+        int32_t guideLayers = 0;
+
+        bool operator==(const Key& other) const;
+        bool operator!=(const Key& other) const { return !(*this == other); }
+    };
+
+    using Stamp = std::array<int32_t, 4>;   // AEGP_TimeStamp
+
+    // 1フレーム分の画素（詰めて保持する。読み取り専用で共有する）
+    struct Entry {
+        Key key;
+        Stamp stamp = {0, 0, 0, 0};
+        PixelConvert::ImageView view;   // pixels を指す
+        std::vector<uint8_t> pixels;
+    };
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+    struct Stats {
+        uint64_t hits = 0;          // メモリで見つかった数
+        uint64_t diskHits = 0;      // ディスクから読み戻した数
+        uint64_t misses = 0;
+        uint64_t stale = 0;         // 見つかったが検証で古いと分かった数
+        uint64_t inserts = 0;
+        uint64_t evictions = 0;     // メモリから追い出した数
+        uint64_t diskWrites = 0;
+        uint64_t diskEvictions = 0;
+        uint64_t diskErrors = 0;    // 読み書きに失敗した数（失敗はミス扱い）
+        size_t memoryEntries = 0;
+        uint64_t memoryBytes = 0;
+        size_t diskEntries = 0;
+        uint64_t diskBytes = 0;
+        uint64_t maxMemoryBytes = 0;
+        uint64_t maxDiskBytes = 0;
+    };
+
+    // 見つかったエントリーがまだ有効なら true を返す（ロックの外で呼ぶ）
+    using Validator = std::function<bool(const Entry& entry)>;
+
+    // directory が空ならディスクには退避しない
+    FrameCache(uint64_t maxMemoryBytes, const std::string& directory, uint64_t maxDiskBytes);
+    ~FrameCache();
+
+    FrameCache(const FrameCache&) = delete;
+    FrameCache& operator=(const FrameCache&) = delete;
+
+    // キーのハッシュ（FNV-1a）。ディスクのファイル名にも使う
+    static uint64_t Hash(const Key& key);
+
+    // メモリ、次にディスクを探す。ディスクで見つかればメモリへ戻す。
+    // validate が false を返したエントリーは捨ててミスにする
+    EntryPtr Find(const Key& key, const Validator& validate = Validator());
+
+    // src を詰めてコピーし、同じキーのエントリーを置き換える。
+    // 1エントリーでメモリの上限を超える場合は保持しない（nullptr）
+    EntryPtr Insert(const Key& key, const Stamp& stamp, const PixelConvert::ImageView& src);
+
+    // item のエントリーをすべて捨てる（item == 0 なら全部）。捨てた数を返す
+    size_t Invalidate(uint64_t item);
+    void Clear();
+
+    // 上限を変え、超えた分をすぐ追い出す
+    void SetLimits(uint64_t maxMemoryBytes, uint64_t maxDiskBytes);
+
+    const std::string& GetDirectory() const { return m_directory; }
+    // このインスタンスのファイルを置くサブディレクトリ（ディスクを使わなければ空）
+    const std::string& GetSessionDirectory() const { return m_sessionDirectory; }
+    Stats GetStats() const;
+
+private:
+    struct DiskEntry {
+        Key key;
+        uint64_t bytes = 0;
+        uint64_t id = 0;        // ファイル名の通し番号（書き直すたびに変わる）
+        EntryPtr writing;       // 書き込みが終わるまで保持する画素
+    };
+
+    // ロックの外で書き込むエントリー
+    struct Spill {
+        uint64_t hash = 0;
+        uint64_t id = 0;
+        EntryPtr entry;
+    };
+
+    using MemoryList = std::list<EntryPtr>;
+    using DiskList = std::list<uint64_t>;   // ハッシュ（先頭が最近使ったもの）
+
+    static uint64_t EntryBytes(const Entry& entry);
+    std::string FilePath(uint64_t hash, uint64_t id) const;
+
+    // ファイルの読み書き（ロックの外で呼ぶ）。失敗したら nullptr / false
+    static EntryPtr ReadFile(const std::string& path, const Key& key);
+    static bool WriteFile(const std::string& path, const Entry& entry);
+    void WriteSpills(const std::vector<Spill>& spills);
+
+    // 以下は m_mutex を保持した状態で呼ぶ。書き込むエントリーは spills に積む
+    void EraseMemoryLocked(uint64_t hash);
+    void EraseDiskLocked(uint64_t hash);
+    void TrimMemoryLocked(std::vector<Spill>& spills);
+    void TrimDiskLocked();
+    void SpillLocked(const EntryPtr& entry, std::vector<Spill>& spills);
+
+    mutable WinMutex m_mutex;
+    std::string m_directory;
+    std::string m_sessionDirectory;
+    uint64_t m_maxMemoryBytes;
+    uint64_t m_maxDiskBytes;
+    uint64_t m_nextFileId = 0;
+
+    MemoryList m_memory;
+    std::unordered_map<uint64_t, MemoryList::iterator> m_memoryIndex;
+    DiskList m_disk;
+    std::unordered_map<uint64_t, std::pair<DiskEntry, DiskList::iterator>> m_diskIndex;
+    Stats m_stats;
+};
+
+} // namespace PyAE
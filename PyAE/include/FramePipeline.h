@@ -0,0 +1,155 @@
+// FramePipeline.h
+// PyAE - Python for After Effects
+// レンダー結果のフレーム列をワーカースレッドのコンシューマーへ渡す
+//
+// Submit はフレームを詰めたバッファへコピーした時点で戻り、登録された
+// コンシューマー（ファイル書き出し・統計など）がそれぞれ専用のスレッドで
+// フレーム順に処理する。全コンシューマーが処理し終えていないフレーム
+// （in-flight）が上限に達している間、Submit は待つ。バッファは使い回す。
+// AE の API は呼ばない。
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ImageEncoder.h"
+#include "ImageStats.h"
+#include "PixelConvert.h"
+#include "TaskQueue.h"
+
+namespace PyAE {
+
+class FramePipeline {
+public:
+    // 取り込んだ1フレーム。全コンシューマーで共有する（読み取り専用）
+    struct Frame {
+        int index = 0;          // Submit した順の番号（0 始まり）
+        int64_t number = 0;     // フレーム番号（ファイル名などに使う）
+        double time = 0.0;      // 秒
+        PixelConvert::ImageView view;   // pixels を指す（行間の余白なし）
+        std::vector<uint8_t> pixels;
+    };
+
+    class Consumer {
+    public:
+        virtual ~Consumer() = default;
+
+        virtual std::string GetName() const = 0;
+
+        // 専用のワーカースレッドからフレーム順に呼ばれる。例外を投げると
+        // そのコンシューマーのエラーとして記録し、以降のフレームは渡さない
+        virtual void Consume(const Frame& frame) = 0;
+
+        // Close で全フレームを渡し終えた後に同じスレッドから呼ばれる
+        virtual void Finish() {}
+    };
+
+    struct ConsumerStats {
+        std::string name;
+        uint64_t frames = 0;        // 処理したフレーム数
+        double seconds = 0.0;       // Consume / Finish に掛かった時間
+        std::string error;          // 失敗していなければ空
+    };
+
+    struct Stats {
+        uint64_t submitted = 0;
+        size_t inFlight = 0;        // コンシューマーの処理待ち・処理中のフレーム数
+        size_t peakInFlight = 0;
+        double waitSeconds = 0.0;   // Submit が in-flight の空きを待った時間
+        double copySeconds = 0.0;   // Submit がフレームをコピーした時間
+        std::vector<ConsumerStats> consumers;
+    };
+
+    // maxInFlight: 同時に保持するフレーム数の上限（1 以上）
+    FramePipeline(std::vector<std::shared_ptr<Consumer>> consumers, int maxInFlight);
+    ~FramePipeline();
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    // src を詰めてコピーし、全コンシューマーへ渡す。戻った時点で src は不要。
+    // コンシューマーがなければ何もしない。Close 後は std::runtime_error
+    void Submit(int64_t number, double time, const PixelConvert::ImageView& src);
+
+    // 渡したフレームをすべて処理し終えるまで待ち、各コンシューマーの
+    // Finish を呼んでからスレッドを止める（2回目以降は何もしない）
+    void Close();
+    bool IsClosed() const;
+
+    Stats GetStats() const;
+    int GetMaxInFlight() const { return m_maxInFlight; }
+
+private:
+    struct Slot {
+        Frame frame;
+        size_t refs = 0;        // このフレームを処理していないコンシューマー数
+    };
+
+    struct Worker {
+        std::shared_ptr<Consumer> consumer;
+        std::deque<Slot*> queue;
+        std::thread thread;
+        ConsumerStats stats;
+        bool failed = false;
+    };
+
+    void WorkerLoop(Worker& worker);
+
+    // m_cs を保持した状態で呼ぶ
+    void ReleaseLocked(Slot* slot);
+
+    mutable TaskQueueCS m_cs;           // キュー・スロット・統計を保護（待機にも使う）
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::unique_ptr<Slot>> m_slots;     // 確保済みのスロット（最大 maxInFlight）
+    std::vector<Slot*> m_freeSlots;
+    int m_maxInFlight;
+    int m_nextIndex = 0;
+    bool m_closing = false;
+    bool m_closed = false;
+    Stats m_stats;
+};
+
+namespace FrameConsumers {
+
+// pattern 中の連続した '#' をフレーム番号（桁数まで 0 埋め）に置き換える。
+// '#' がなければ拡張子の前に "_####" を付ける
+std::string FramePath(const std::string& pattern, int64_t number);
+
+// 各フレームを FramePath(pattern, number) に書き出す。エンコードと書き込みは
+// FrameWriter のワーカーで並行して行い、失敗は後のフレームか Finish で
+// エラーになる
+std::shared_ptr<FramePipeline::Consumer> MakeFileWriter(const std::string& pattern,
+                                                       ImageEncoder::Format format,
+                                                       int bitDepth);
+
+// 各フレームの ImageStats を集める
+class StatsCollector : public FramePipeline::Consumer {
+public:
+    explicit StatsCollector(const ImageStats::Options& options) : m_options(options) {}
+
+    std::string GetName() const override { return "stats"; }
+    void Consume(const FramePipeline::Frame& frame) override;
+
+    // Close の後に読む。(フレーム, 統計) をフレーム順に
+    struct Entry {
+        int index = 0;
+        int64_t number = 0;
+        double time = 0.0;
+        ImageStats::Result result;
+    };
+    const std::vector<Entry>& GetResults() const { return m_results; }
+
+private:
+    ImageStats::Options m_options;
+    std::vector<Entry> m_results;
+};
+
+} // namespace FrameConsumers
+} // namespace PyAE
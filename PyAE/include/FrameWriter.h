@@ -0,0 +1,113 @@
+// FrameWriter.h
+// PyAE - Python for After Effects
+// フレームのファイル書き出し（ワーカースレッド）
+//
+// Write は画素をプール済みのバッファへ取り込んだ時点で戻り、エンコードと
+// ファイル書き込みはワーカースレッドが行う。取り込み済みで書き出しが
+// 終わっていないバッファの合計（in-flight）が上限を超える間、Write は待つ。
+// AE の API は呼ばない。
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ImageEncoder.h"
+#include "PixelConvert.h"
+#include "TaskQueue.h"
+
+namespace PyAE {
+
+class FrameWriter {
+public:
+    struct Stats {
+        uint64_t submitted = 0;         // Write の回数
+        uint64_t written = 0;           // 書き出しに成功した数
+        uint64_t failed = 0;            // 失敗した数
+        uint64_t bytesWritten = 0;      // 書き出したファイルの合計サイズ
+        size_t pending = 0;             // 未完了の数（待機中 + 書き出し中）
+        size_t inFlightBytes = 0;       // 未完了のバッファの合計
+        size_t peakInFlightBytes = 0;
+        size_t pooledBuffers = 0;       // 再利用待ちのバッファ数
+    };
+
+    // 書き出し1件の完了状態
+    class Job {
+    public:
+        const std::string& GetPath() const { return m_path; }
+        bool IsDone() const;
+
+        // timeoutMs < 0 なら完了まで待つ。完了していれば true
+        bool Wait(int timeoutMs) const;
+
+        // 完了後のみ有効。成功なら空
+        std::string GetError() const;
+        uint64_t GetBytesWritten() const;
+
+    private:
+        friend class FrameWriter;
+        explicit Job(std::string path) : m_path(std::move(path)) {}
+        void Complete(std::string error, uint64_t bytesWritten);
+
+        std::string m_path;
+        mutable TaskQueueCS m_cs;
+        bool m_done = false;
+        std::string m_error;
+        uint64_t m_bytesWritten = 0;
+    };
+
+    // threads <= 0 ならハードウェアスレッド数から決める（1 - 4）
+    FrameWriter(int threads, size_t maxInFlightBytes);
+    ~FrameWriter();
+
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+
+    // src をバッファに取り込み（alpha を適用）、書き出しを予約する。
+    // 戻った時点で src は不要。Close 後は std::runtime_error
+    std::shared_ptr<Job> Write(const PixelConvert::ImageView& src, const std::string& path,
+                               ImageEncoder::Format format, int bitDepth,
+                               PixelConvert::AlphaOp alpha = PixelConvert::AlphaOp::None);
+
+    // 未完了がなくなるまで待つ（timeoutMs < 0 で無制限）。終わっていれば true
+    bool Flush(int timeoutMs);
+
+    // 予約済みの書き出しを終えてからワーカーを止める（2回目以降は何もしない）
+    void Close();
+    bool IsClosed() const;
+
+    Stats GetStats() const;
+    int GetThreadCount() const { return static_cast<int>(m_threads.size()); }
+    size_t GetMaxInFlightBytes() const { return m_maxInFlightBytes; }
+
+private:
+    struct Task {
+        std::shared_ptr<Job> job;
+        std::vector<uint8_t> buffer;
+        PixelConvert::ImageView view;
+        ImageEncoder::Format format = ImageEncoder::Format::PNG;
+        int bitDepth = 8;
+    };
+
+    void WorkerLoop();
+    void Run(Task& task);
+
+    // m_cs を保持した状態で呼ぶ
+    std::vector<uint8_t> TakeBufferLocked(size_t bytes);
+
+    mutable TaskQueueCS m_cs;           // キュー・バッファ・統計を保護（待機にも使う）
+    std::deque<Task> m_queue;
+    std::vector<std::vector<uint8_t>> m_freeBuffers;
+    std::vector<std::thread> m_threads;
+    size_t m_maxInFlightBytes;
+    size_t m_pooledBytes = 0;
+    bool m_closing = false;
+    Stats m_stats;
+};
+
+} // namespace PyAE
@@ -80,6 +80,8 @@ public:
     // 状態
     bool IsInitialized() const { return m_initialized.load(); }
     size_t GetPendingTaskCount() const { return m_taskQueue.Size(); }
+    // これまでのアイドル呼び出しの回数（同じアイドル呼び出しの中かどうかの判定用）
+    uint64_t GetIdleCallCount() const { return m_totalIdleCalls.load(); }
 
 private:
     IdleHandler() = default;
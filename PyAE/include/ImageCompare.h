@@ -0,0 +1,49 @@
+// ImageCompare.h
+// PyAE - Python for After Effects
+// 2枚の画像の比較（絶対誤差・PSNR・タイル SSIM・差分画像）
+//
+// レンダー結果とゴールデン画像の回帰テスト用。どちらの画像も
+// PixelConvert で float RGBA（正規化値）にデコードしてから比較するので、
+// ビット深度・並びが異なる画像どうしでも比較できる。
+// タイルの行単位でスレッドに分割する。SDK に依存しない。
+
+#pragma once
+
+#include <cstdint>
+
+#include "PixelConvert.h"
+
+namespace PyAE {
+namespace ImageCompare {
+
+struct Options {
+    float tolerance = 0.0f;     // これを超えるチャンネル差がある画素を「異なる」とみなす
+    bool earlyExit = false;     // 異なる画素が見つかった時点で打ち切る
+    bool ssim = true;           // タイル SSIM を計算する
+    int ssimTile = 8;           // SSIM のタイル一辺（画素）
+};
+
+struct Result {
+    bool identical = true;      // tolerance を超える差が無い
+    bool complete = true;       // false: earlyExit で打ち切った（以下の値は途中まで）
+    uint64_t pixels = 0;        // 比較した画素数
+    uint64_t differingPixels = 0;
+    // チャンネル別 (R, G, B, A)。NaN どうしは等しく、片方だけの NaN は差が無限大
+    double maxAbs[4] = {};
+    double meanAbs[4] = {};
+    double mse[4] = {};
+    double ssim[4] = {1.0, 1.0, 1.0, 1.0};  // タイル SSIM の平均（Options::ssim が false なら 1）
+};
+
+// a と b（同じサイズ）を比較する。diff が data を持つ場合は
+// チャンネルごとの |a - b|（アルファは 1）を書き込む（同じサイズ）。
+// サイズ不一致・不正なオプションは std::invalid_argument
+Result Compare(const PixelConvert::ImageView& a, const PixelConvert::ImageView& b,
+               const Options& options = Options(),
+               const PixelConvert::ImageView& diff = PixelConvert::ImageView());
+
+// RGB の MSE 平均から求めた PSNR（dB、ピークは 1.0）。同一なら +inf
+double Psnr(const Result& result);
+
+} // namespace ImageCompare
+} // namespace PyAE
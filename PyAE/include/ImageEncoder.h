@@ -0,0 +1,50 @@
+// ImageEncoder.h
+// PyAE - Python for After Effects
+// 画像ファイルのエンコード（PNG / TIFF / EXR / PFM）
+//
+// 外部ライブラリに依存しない最小限のエンコーダ。行ごとに float RGBA へ
+// デコードしてから出力形式のサンプルに変換し、ストリームへ順に書き出す
+// （ファイル全体をメモリに作らない）。圧縮は行わない:
+//   PNG  : RGBA 8/16bit、deflate は無圧縮ブロック
+//   TIFF : RGBA 8/16bit 整数 / 32bit float、無圧縮・1ストリップ
+//   EXR  : RGBA 32bit float、無圧縮スキャンライン
+//   PFM  : RGB 32bit float（アルファは書き出さない）
+
+#pragma once
+
+#include <ostream>
+#include <string>
+
+#include "PixelConvert.h"
+
+namespace PyAE {
+namespace ImageEncoder {
+
+enum class Format {
+    PNG,
+    TIFF,
+    EXR,
+    PFM
+};
+
+// 拡張子（.png / .tif / .tiff / .exr / .pfm、大文字小文字は区別しない）から判定する。
+// 不明な拡張子は std::invalid_argument
+Format FormatFromPath(const std::string& path);
+
+// "png" / "tiff" / "exr" / "pfm"（"tif" も可）。不明な名前は std::invalid_argument
+Format FormatFromName(const std::string& name);
+
+const char* FormatName(Format format);
+
+// 入力の深度に合わせた既定のビット深度
+int DefaultBitDepth(Format format, PixelConvert::Depth depth);
+
+// 形式が対応していないビット深度は std::invalid_argument
+void CheckBitDepth(Format format, int bitDepth);
+
+// src を format / bitDepth で out に書き出す。
+// 書き込みに失敗した場合は std::runtime_error
+void Write(const PixelConvert::ImageView& src, Format format, int bitDepth, std::ostream& out);
+
+} // namespace ImageEncoder
+} // namespace PyAE
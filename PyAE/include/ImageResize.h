@@ -0,0 +1,32 @@
+// ImageResize.h
+// PyAE - Python for After Effects
+// 画像の縮小・拡大（サムネイル・プロキシ用）
+//
+// 縦横に分離したフィルタで処理する。各行は PixelConvert で float RGBA に
+// デコードしてから横方向に縮め、縦方向の重み付き和を SIMD で足し込み、
+// 出力先の形式にエンコードする。任意の深度・並びの間で変換でき、
+// 出力行単位でスレッドに分割する。SDK に依存しない。
+
+#pragma once
+
+#include "PixelConvert.h"
+
+namespace PyAE {
+namespace ImageResize {
+
+enum class Filter {
+    Box,        // 出力画素に中心が入る入力画素の単純平均（整数倍の縮小で最速）
+    Bilinear,   // 2x2 の線形補間（拡大・軽い縮小向け）
+    Area        // 出力画素が覆う面積で重み付けした平均（任意倍率の縮小で最も正確）
+};
+
+const char* FilterName(Filter filter);
+
+// src を dst の大きさに変換して書き込む。src と dst は別のメモリであること。
+// 値は正規化して扱うので深度・並びは異なってよい（float の範囲外は保持）。
+// 空の画像・同じメモリは std::invalid_argument
+void Resize(const PixelConvert::ImageView& src, const PixelConvert::ImageView& dst,
+            Filter filter);
+
+} // namespace ImageResize
+} // namespace PyAE
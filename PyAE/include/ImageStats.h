@@ -0,0 +1,48 @@
+// ImageStats.h
+// PyAE - Python for After Effects
+// 画像のチャンネル別統計（ヒストグラム・モーメント・NaN / 範囲外の数）
+//
+// レンダー結果の自動チェック（黒フレーム・白飛び・アルファ抜けなど）用。
+// 行単位でスレッドに分割し、各行は PixelConvert で float RGBA に
+// デコードしてから SIMD で集計する。SDK に依存しない。
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "PixelConvert.h"
+
+namespace PyAE {
+namespace ImageStats {
+
+struct Options {
+    int bins = 256;             // ヒストグラムのビン数（1 - 65536）
+    float rangeMin = 0.0f;      // ヒストグラムの範囲（正規化値）。
+    float rangeMax = 1.0f;      // これを外れた値は below / above に数える
+    bool histogram = true;      // false ならヒストグラムを作らない
+};
+
+struct ChannelStats {
+    // min / max / mean / stddev は NaN を除いた値。すべて NaN なら NaN
+    double min = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    double stddev = 0.0;        // 母標準偏差
+    uint64_t nanCount = 0;
+    uint64_t belowCount = 0;    // rangeMin 未満
+    uint64_t aboveCount = 0;    // rangeMax 超過
+    std::vector<uint64_t> histogram;    // [rangeMin, rangeMax] を bins 等分
+};
+
+struct Result {
+    uint64_t pixels = 0;
+    ChannelStats channels[4];   // R, G, B, A
+};
+
+// image 全体の統計を計算する。
+// 空の画像・不正な bins / 範囲は std::invalid_argument
+Result Compute(const PixelConvert::ImageView& image, const Options& options = Options());
+
+} // namespace ImageStats
+} // namespace PyAE
@@ -0,0 +1,218 @@
+// JsonWriter.h
+// PyAE - Python for After Effects
+// ストリーミングJSONライター
+//
+// 中間オブジェクトを作らずに JSON を文字列バッファへ直接書き出す。
+// シンクを指定した場合はバッファが閾値を超えるたびに書き出す。
+// 出力は json.dumps(..., ensure_ascii=False) 互換（UTF-8 そのまま、
+// 浮動小数は最短往復表現、NaN/Infinity は Python と同じ表記）。
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ostream>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include "DocumentWriter.h"
+
+namespace PyAE {
+
+class JsonWriter : public DocumentWriter {
+public:
+    // indent < 0: コンパクト出力（改行なし）
+    explicit JsonWriter(int indent = -1, std::ostream* sink = nullptr)
+        : m_indent(indent)
+        , m_sink(sink)
+    {
+        m_buffer.reserve(sink ? kFlushThreshold * 2 : 4096);
+    }
+
+    ~JsonWriter() override {
+        try { Flush(); } catch (...) {}
+    }
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    // ==========================================
+    // 構造
+    // ==========================================
+    void BeginObject() override { BeginValue(); m_buffer += '{'; m_stack.push_back({true, true}); }
+    void EndObject() override { EndContainer('}', true); }
+    void BeginArray() override { BeginValue(); m_buffer += '['; m_stack.push_back({false, true}); }
+    void EndArray() override { EndContainer(']', false); }
+
+    void Key(std::string_view key) override {
+        if (m_stack.empty() || !m_stack.back().isObject || m_afterKey) {
+            throw std::logic_error("JsonWriter: key outside of object");
+        }
+        Separator();
+        AppendEscaped(key);
+        m_buffer += m_indent >= 0 ? ": " : ":";
+        m_afterKey = true;
+    }
+
+    // ==========================================
+    // 値
+    // ==========================================
+    void String(std::string_view value) override { BeginValue(); AppendEscaped(value); EndValue(); }
+    void Bool(bool value) override { BeginValue(); m_buffer += value ? "true" : "false"; EndValue(); }
+    void Null() override { BeginValue(); m_buffer += "null"; EndValue(); }
+
+    void Int(int64_t value) override {
+        BeginValue();
+        char buf[24];
+        auto res = std::to_chars(buf, buf + sizeof(buf), value);
+        m_buffer.append(buf, res.ptr);
+        EndValue();
+    }
+
+    // Python の float repr と同じく整数値でも ".0" を付ける
+    void Number(double value) override {
+        BeginValue();
+        if (std::isnan(value)) {
+            m_buffer += "NaN";
+        } else if (std::isinf(value)) {
+            m_buffer += value > 0 ? "Infinity" : "-Infinity";
+        } else {
+            char buf[32];
+            auto res = std::to_chars(buf, buf + sizeof(buf), value);
+            std::string_view text(buf, static_cast<size_t>(res.ptr - buf));
+            m_buffer += text;
+            if (text.find_first_of(".e") == std::string_view::npos) {
+                m_buffer += ".0";
+            }
+        }
+        EndValue();
+    }
+
+    // バイト列を小文字16進文字列として出力（bytes.hex() 相当）
+    void HexString(std::string_view bytes) override {
+        static const char kDigits[] = "0123456789abcdef";
+        BeginValue();
+        m_buffer += '"';
+        for (unsigned char c : bytes) {
+            m_buffer += kDigits[c >> 4];
+            m_buffer += kDigits[c & 0x0F];
+        }
+        m_buffer += '"';
+        EndValue();
+    }
+
+    // ==========================================
+    // 出力
+    // ==========================================
+    void Flush() {
+        if (m_sink && !m_buffer.empty()) {
+            m_sink->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+            m_buffer.clear();
+        }
+    }
+
+    // シンクなしの場合の出力結果
+    std::string TakeString() { return std::move(m_buffer); }
+
+    bool IsComplete() const { return m_stack.empty() && m_hasRoot; }
+
+private:
+    struct Frame {
+        bool isObject;
+        bool empty;
+    };
+
+    static constexpr size_t kFlushThreshold = 64 * 1024;
+
+    void NewLine() {
+        m_buffer += '\n';
+        m_buffer.append(m_stack.size() * static_cast<size_t>(m_indent), ' ');
+    }
+
+    void Separator() {
+        Frame& frame = m_stack.back();
+        if (!frame.empty) {
+            m_buffer += ',';
+        }
+        frame.empty = false;
+        if (m_indent >= 0) {
+            NewLine();
+        }
+    }
+
+    void BeginValue() {
+        if (m_afterKey) {
+            m_afterKey = false;
+            return;
+        }
+        if (m_stack.empty()) {
+            if (m_hasRoot) {
+                throw std::logic_error("JsonWriter: multiple root values");
+            }
+            m_hasRoot = true;
+            return;
+        }
+        if (m_stack.back().isObject) {
+            throw std::logic_error("JsonWriter: value without key");
+        }
+        Separator();
+    }
+
+    void EndValue() {
+        if (m_sink && m_buffer.size() >= kFlushThreshold) {
+            Flush();
+        }
+    }
+
+    void EndContainer(char close, bool isObject) {
+        if (m_stack.empty() || m_stack.back().isObject != isObject || m_afterKey) {
+            throw std::logic_error("JsonWriter: unbalanced container");
+        }
+        bool empty = m_stack.back().empty;
+        m_stack.pop_back();
+        if (!empty && m_indent >= 0) {
+            NewLine();
+        }
+        m_buffer += close;
+        EndValue();
+    }
+
+    void AppendEscaped(std::string_view text) {
+        static const char kDigits[] = "0123456789abcdef";
+        m_buffer += '"';
+        for (char ch : text) {
+            unsigned char c = static_cast<unsigned char>(ch);
+            switch (c) {
+                case '"':  m_buffer += "\\\""; break;
+                case '\\': m_buffer += "\\\\"; break;
+                case '\n': m_buffer += "\\n"; break;
+                case '\r': m_buffer += "\\r"; break;
+                case '\t': m_buffer += "\\t"; break;
+                case '\b': m_buffer += "\\b"; break;
+                case '\f': m_buffer += "\\f"; break;
+                default:
+                    if (c < 0x20) {
+                        m_buffer += "\\u00";
+                        m_buffer += kDigits[c >> 4];
+                        m_buffer += kDigits[c & 0x0F];
+                    } else {
+                        m_buffer += ch;
+                    }
+                    break;
+            }
+        }
+        m_buffer += '"';
+    }
+
+    int m_indent;
+    std::ostream* m_sink;
+    std::string m_buffer;
+    std::vector<Frame> m_stack;
+    bool m_afterKey = false;
+    bool m_hasRoot = false;
+};
+
+} // namespace PyAE
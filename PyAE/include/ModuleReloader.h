@@ -0,0 +1,103 @@
+// ModuleReloader.h
+// PyAE - Python for After Effects
+// ユーザーモジュールの依存関係を考慮したホットリロード
+//
+// ScriptRunnerのスクリプトディレクトリ配下の .py を監視スレッドでポーリングし、
+// 変更を検出したらIdleHandler経由でメインスレッドに適用する。
+// 変更されたモジュールとそれをimportしているモジュールだけを
+// 依存順（依存先が先）に importlib.reload する。
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <filesystem>
+#include "WinSync.h"
+
+namespace PyAE {
+
+// リロード結果
+struct ReloadResult {
+    std::vector<std::string> reloaded;                          // リロード成功（実行順）
+    std::vector<std::pair<std::string, std::string>> failed;    // (モジュール名, エラー)
+    std::vector<std::string> skipped;                           // 依存先の失敗によりスキップ
+};
+
+class ModuleReloader {
+public:
+    static ModuleReloader& Instance() {
+        static ModuleReloader instance;
+        return instance;
+    }
+
+    // 終了（監視停止・コールバック解放）
+    void Shutdown();
+
+    // 監視制御
+    // 監視対象は Start() 時点の ScriptRunner::GetScriptDirectories()
+    bool Start(std::chrono::milliseconds pollInterval = std::chrono::milliseconds(500));
+    void Stop();
+    bool IsWatching() const { return m_running.load(); }
+    std::chrono::milliseconds GetPollInterval() const { return m_pollInterval; }
+    std::vector<std::filesystem::path> GetWatchDirectories() const;
+
+    // 変更ファイルに対応するモジュールと依存モジュールをリロード
+    // メインスレッドから呼ぶこと（内部でGILを取得）
+    ReloadResult ReloadChangedFiles(const std::vector<std::filesystem::path>& changedFiles);
+
+    // 指定モジュールと依存モジュールをリロード
+    ReloadResult ReloadModules(const std::vector<std::string>& moduleNames);
+
+    // ユーザーモジュールの依存グラフ（モジュール名 -> importしているユーザーモジュール）
+    // GIL保持中に呼ぶこと
+    std::map<std::string, std::set<std::string>> BuildDependencyGraph(
+        const std::vector<std::filesystem::path>& dirs) const;
+
+    // リロード完了コールバック（メインスレッドで呼ばれる）
+    using ReloadCallback = std::function<void(const ReloadResult&)>;
+    void SetReloadCallback(ReloadCallback callback);
+    void ClearReloadCallback();
+
+    // 統計
+    uint64_t GetReloadCount() const { return m_reloadCount.load(); }
+
+private:
+    ModuleReloader() = default;
+    ~ModuleReloader() = default;
+
+    ModuleReloader(const ModuleReloader&) = delete;
+    ModuleReloader& operator=(const ModuleReloader&) = delete;
+
+    using FileTimes = std::map<std::filesystem::path, std::filesystem::file_time_type>;
+
+    // 監視スレッド
+    void WatchLoop();
+    static FileTimes ScanFiles(const std::vector<std::filesystem::path>& dirs);
+
+    // IdleHandlerから呼ばれる（メインスレッド）
+    void ApplyPendingChanges();
+
+    // 依存グラフからリロード順を決定して実行（GIL保持中）
+    ReloadResult ReloadAffected(const std::set<std::string>& changedModules,
+                                const std::vector<std::filesystem::path>& dirs);
+
+    std::thread m_watchThread;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_applyScheduled{false};
+    std::atomic<uint64_t> m_reloadCount{0};
+    std::chrono::milliseconds m_pollInterval{500};
+
+    // m_watchDirs / m_pendingFiles / m_callback を保護
+    mutable WinMutex m_mutex;
+    std::vector<std::filesystem::path> m_watchDirs;
+    std::set<std::filesystem::path> m_pendingFiles;
+    ReloadCallback m_callback;
+};
+
+} // namespace PyAE
@@ -0,0 +1,91 @@
+// ParallelFor.h
+// PyAE - Python for After Effects
+// 行単位などの単純なデータ並列処理
+//
+// AE の API を呼ばない純粋な計算（ピクセル変換・統計など）専用。
+// 処理が小さい場合は呼び出しスレッドだけで実行する。
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace PyAE {
+
+// 使用するスレッド数の上限
+inline int ParallelThreadCount()
+{
+    unsigned int hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<int>((std::min)(hw, 64u));
+}
+
+// ParallelForTasks が使うタスク数（タスクごとの結果を用意する場合に使う）
+inline int ParallelTaskCount(int count, int minChunk)
+{
+    if (count <= 0) {
+        return 0;
+    }
+    int tasks = (std::max)(1, (std::min)(ParallelThreadCount(), count / (std::max)(1, minChunk)));
+    int perTask = (count + tasks - 1) / tasks;
+    return (count + perTask - 1) / perTask;
+}
+
+// [0, count) を連続した範囲に分割し fn(task, begin, end) を並列に呼ぶ。
+// task は 0 .. ParallelTaskCount(count, minChunk) - 1。
+// minChunk: 1タスクあたりの最小件数（これ未満に分割しない）
+// fn が投げた例外は最初の1つを呼び出し側で再送出する
+template <typename Fn>
+void ParallelForTasks(int count, int minChunk, Fn&& fn)
+{
+    int tasks = ParallelTaskCount(count, minChunk);
+    if (tasks <= 0) {
+        return;
+    }
+    if (tasks == 1) {
+        fn(0, 0, count);
+        return;
+    }
+
+    // 最初に失敗したタスクだけが error を書く（読むのは join 後）
+    std::exception_ptr error;
+    std::atomic<bool> failed{false};
+    auto run = [&](int task, int begin, int end) {
+        try {
+            fn(task, begin, end);
+        } catch (...) {
+            if (!failed.exchange(true)) {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    int perTask = (count + tasks - 1) / tasks;
+    std::vector<std::thread> threads;
+    threads.reserve(static_cast<size_t>(tasks - 1));
+    for (int task = 1; task < tasks; ++task) {
+        int begin = task * perTask;
+        threads.emplace_back(run, task, begin, (std::min)(count, begin + perTask));
+    }
+    run(0, 0, (std::min)(count, perTask));
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// [0, count) を連続した範囲に分割し fn(begin, end) を並列に呼ぶ
+template <typename Fn>
+void ParallelFor(int count, int minChunk, Fn&& fn)
+{
+    ParallelForTasks(count, minChunk, [&fn](int, int begin, int end) {
+        fn(begin, end);
+    });
+}
+
+} // namespace PyAE
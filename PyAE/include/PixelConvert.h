@@ -0,0 +1,90 @@
+// PixelConvert.h
+// PyAE - Python for After Effects
+// ピクセル形式変換カーネル
+//
+// AE の World（ARGB、8bit / 16bit(0-32768) / float）と、外部ライブラリが扱う
+// RGBA / BGRA / プレーナー形式の相互変換を行う。行ごとに float RGBA へ
+// デコード → アルファ処理 → エンコードの順で処理し、AVX2 / SSE4.1 の
+// ベクトル化カーネルを実行時に選択する（非対応CPUではスカラー実装）。
+// SDK に依存しないため、任意のメモリ間で使用できる。
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PyAE {
+namespace PixelConvert {
+
+// チャンネルの型と値域
+enum class Depth {
+    U8,     // 0-255
+    U16,    // 0-32768（AE の 16bpc）
+    F32     // 0.0-1.0（範囲外も保持）
+};
+
+// チャンネルの並び
+enum class Layout {
+    ARGB,   // AE の World
+    RGBA,
+    BGRA,
+    Planar  // R, G, B, A の4プレーン（各プレーンは planeBytes 間隔）
+};
+
+enum class AlphaOp {
+    None,
+    Premultiply,    // RGB *= A
+    Unpremultiply   // RGB /= A（A == 0 の画素は RGB = 0）
+};
+
+// 使用する命令セット
+enum class Isa {
+    Scalar,
+    SSE41,
+    AVX2
+};
+
+// 変換元・変換先の画像
+struct ImageView {
+    void* data = nullptr;
+    int width = 0;
+    int height = 0;
+    ptrdiff_t rowBytes = 0;     // 行間隔（バイト）
+    ptrdiff_t planeBytes = 0;   // Planar のみ: プレーン間隔（バイト）
+    Depth depth = Depth::F32;
+    Layout layout = Layout::RGBA;
+};
+
+// 1チャンネルのバイト数
+size_t ChannelBytes(Depth depth);
+
+// src を dst へ変換する（大きい画像は行単位で並列処理）。
+// 同じメモリで同一形式ならその場で処理し、それ以外でメモリが重なる場合は
+// src を一時バッファに退避してから変換する。サイズ不一致は std::invalid_argument
+void Convert(const ImageView& src, const ImageView& dst, AlphaOp alpha = AlphaOp::None);
+
+// 1画素を dst の形式で out に書き出す（Planar は R, G, B, A の値を順に詰める）。
+// out は 16 バイト以上
+void EncodePixel(const float rgba[4], Depth depth, Layout layout, uint8_t* out);
+
+// dst 全体を RGBA 色（正規化値）で塗りつぶす
+void Fill(const ImageView& dst, const float rgba[4]);
+
+// image の y 行目を float RGBA（正規化値）として out に読み出す。
+// out は width * 4 要素。float の範囲外・NaN はそのまま
+void DecodeRowRGBA(const ImageView& image, int y, float* out);
+
+// float RGBA（正規化値）の1行を image の y 行目に書き込む（クランプ・丸めあり）
+void EncodeRowRGBA(const ImageView& image, int y, const float* in);
+
+// 実行時に選択された命令セット
+Isa GetIsa();
+
+// 命令セットを強制する（CPUが対応していない場合は対応する最上位まで下げる）。
+// ベンチマーク・テスト用
+void SetIsa(Isa isa);
+
+const char* IsaName(Isa isa);
+
+} // namespace PixelConvert
+} // namespace PyAE
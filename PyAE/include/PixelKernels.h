@@ -0,0 +1,101 @@
+// PixelKernels.h
+// PyAE - Python for After Effects
+// タイル分割で並列に実行するピクセルカーネルとその登録表
+//
+// 画像をキャッシュに収まる正方形のタイルに分け、タイルごとに float RGBA へ
+// デコード → カーネル適用 → 書き戻しをワーカースレッドで行う。
+// カーネルは名前で登録し、パラメータ（数値列または文字列）を検証して
+// 準備した Prepared を全タイルで共有する。Python は呼び出し時に一度だけ
+// 関わり、タイルごとに GIL を取らない。SDK に依存しない。
+//
+// 組み込みカーネル: gain_gamma, threshold, channel_shuffle, lut, blend
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "PixelConvert.h"
+#include "WinSync.h"
+
+namespace PyAE {
+namespace PixelKernels {
+
+// パラメータ1つ。数値（スカラーは要素1つ）か文字列
+struct Param {
+    std::vector<float> values;
+    std::string text;
+    bool isText = false;
+};
+
+using Params = std::map<std::string, Param>;
+
+// パラメータを検証済みのカーネル。Process は複数スレッドから同時に呼ばれる
+class Prepared {
+public:
+    virtual ~Prepared() = default;
+
+    // px: count 画素の float RGBA（その場で書き換える）。
+    // other: 2入力カーネルの第2入力の同じ位置の画素（1入力なら nullptr）
+    virtual void Process(float* px, const float* other, size_t count) const = 0;
+};
+
+struct KernelInfo {
+    std::string name;
+    int inputs = 1;             // 1: 画像のみ、2: 第2入力（同じサイズ）を取る
+    std::string description;    // パラメータの説明を含む
+};
+
+// パラメータから Prepared を作る。不正なパラメータは std::invalid_argument
+using Factory = std::function<std::unique_ptr<Prepared>(const Params&)>;
+
+class Registry {
+public:
+    static Registry& Get() {
+        static Registry instance;
+        return instance;
+    }
+
+    // 同じ名前の登録は置き換える
+    void Register(const KernelInfo& info, Factory factory);
+
+    std::vector<KernelInfo> List() const;
+
+    // 未登録の名前は std::invalid_argument
+    KernelInfo GetInfo(const std::string& name) const;
+    std::unique_ptr<Prepared> Prepare(const std::string& name, const Params& params) const;
+
+private:
+    Registry();
+    ~Registry() = default;
+
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    struct Entry {
+        KernelInfo info;
+        Factory factory;
+    };
+
+    mutable WinMutex m_mutex;
+    std::map<std::string, Entry> m_kernels;
+};
+
+struct RunStats {
+    int tiles = 0;      // 処理したタイル数
+    int tasks = 0;      // 使ったスレッド数
+};
+
+constexpr int kDefaultTileSize = 64;    // float RGBA で 64KB
+
+// image の各タイルに kernel を適用する（その場で書き換える）。
+// other: 2入力カーネルの第2入力（image と同じサイズ、同じメモリも可）。
+// tileSize: タイルの一辺（8 - 1024）
+RunStats Run(const Prepared& kernel, const PixelConvert::ImageView& image,
+             const PixelConvert::ImageView* other, int tileSize = kDefaultTileSize);
+
+} // namespace PixelKernels
+} // namespace PyAE
@@ -0,0 +1,113 @@
+// ProjectDiff.h
+// PyAE - Python for After Effects
+// プロジェクト差分・パッチエンジン
+//
+// project_to_dict スキーマの2つのスナップショット（または現在のプロジェクトと
+// ターゲット）をアイテム・レイヤー・プロパティ・キーフレーム単位で比較し、
+// 最小限の操作列（パッチ）を生成・適用する。
+//
+// パッチ形式:
+//   {"version": 1, "id_map": [[new_id, base_id], ...], "ops": [{"op": ...}, ...]}
+//   - 既存アイテムは base 側の ID（= 適用先プロジェクトのアイテムID）で参照する
+//   - 追加データ内の source_item_id / parent_folder_id は new 側の ID で、
+//     id_map を通して既存アイテムへ解決される
+//   - レイヤーは "layer"（base 側のインデックス）で参照し、追加レイヤーと
+//     並び順・ペアレントは new 側のインデックスで表す
+//   - base にしか無いアイテム・レイヤーの削除は prune=true の場合のみ生成する
+// メインスレッドから GIL を保持した状態で呼ぶこと。
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <tuple>
+
+#include "PluginState.h"
+#include "ProjectImporter.h"
+
+namespace py = pybind11;
+
+namespace PyAE {
+
+class ProjectDiff {
+public:
+    // base → target の差分パッチを生成する
+    static py::dict Diff(const py::dict& base, const py::dict& target, bool prune);
+
+    // 現在のプロジェクトを project_to_dict 形式で取得する。
+    // since（AEGP_GetCurrentTimestamp の値）を指定すると、その時点から
+    // 変更の無いアイテムは previous の comp_data / footage_data を再利用する
+    static py::dict CaptureProject(AEGP_ProjectH projectH,
+                                   const py::dict& previous,
+                                   const std::optional<std::tuple<int, int, int, int>>& since);
+};
+
+class PatchApplier {
+public:
+    explicit PatchApplier(AEGP_ProjectH projectH);
+
+    PatchApplier(const PatchApplier&) = delete;
+    PatchApplier& operator=(const PatchApplier&) = delete;
+
+    // パッチ全体を1つのアンドゥグループで適用する
+    void Apply(const py::dict& patch);
+
+    // 適用統計
+    struct Stats {
+        size_t ops = 0;
+        size_t skipped = 0;
+        size_t items = 0;
+        size_t layers = 0;
+        size_t properties = 0;
+        size_t keyframes = 0;
+        size_t effects = 0;
+    };
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    // コンポごとの適用状態（最初に触れた時点のレイヤー並びを保持する）
+    struct CompState {
+        AEGP_CompH compH = nullptr;
+        std::map<int, AEGP_LayerH> baseLayers;   // base 側インデックス → レイヤー
+        std::map<int, AEGP_LayerH> addedLayers;  // new 側インデックス → 追加レイヤー
+        std::map<int, AEGP_LayerH> order;        // new 側インデックス → レイヤー（order_layers 後）
+        std::set<AEGP_LayerH> relock;            // 適用後にロックし直すレイヤー
+        bool ordered = false;
+    };
+
+    void ApplyOp(const py::dict& op);
+
+    void AddItems(const py::dict& op);
+    void SetItem(const py::dict& op);
+    void RemoveItem(const py::dict& op);
+
+    void RemoveLayer(const py::dict& op);
+    void SetLayer(const py::dict& op);
+    void AddLayer(const py::dict& op);
+    void OrderLayers(const py::dict& op);
+    void SetParent(const py::dict& op);
+
+    void SetProperty(const py::dict& op);
+    void ApplyKeyframes(const py::dict& op);
+    void SetEffect(const py::dict& op);
+    void SetEffectParam(const py::dict& op);
+    void ReplaceEffects(const py::dict& op);
+
+    AEGP_ItemH ResolveBaseItem(A_long id) const;
+    CompState* GetCompState(A_long id);
+    AEGP_LayerH GetBaseLayer(const py::dict& op, CompState** stateOut = nullptr);
+    AEGP_LayerH GetNewLayer(CompState& state, int index) const;
+    void Unlock(CompState& state, AEGP_LayerH layerH);
+    void FinishComps();
+
+    AEGP_ProjectH m_projectH;
+    ProjectImporter m_importer;
+    std::map<A_long, AEGP_ItemH> m_baseItems;
+    std::map<A_long, CompState> m_comps;
+    Stats m_stats;
+};
+
+} // namespace PyAE
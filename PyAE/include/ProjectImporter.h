@@ -0,0 +1,102 @@
+// ProjectImporter.h
+// PyAE - Python for After Effects
+// ネイティブ プロジェクトインポーター
+//
+// ae_serialize.project_from_dict と同じスキーマ（ProjectSerializer の出力）から
+// フォルダ・コンポ・フッテージ・レイヤー・プロパティ・エフェクト・キーフレームを
+// 一括作成する。全体を1つのアンドゥグループにまとめ、キーフレームは
+// AEGP_StartAddKeyframes のバッチで追加する。アイテムIDとエフェクトの
+// マッチ名の対応表はインポートごとに1回だけ構築する。
+// メインスレッドから GIL を保持した状態で呼ぶこと。
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PluginState.h"
+
+namespace py = pybind11;
+
+namespace PyAE {
+
+class PyComp;
+class PyLayer;
+
+class ProjectImporter {
+public:
+    // 進捗通知 (phase, done, total)。done/total はインポート全体の単位数
+    using ProgressCallback = std::function<void(const std::string&, size_t, size_t)>;
+
+    explicit ProjectImporter(AEGP_ProjectH projectH);
+
+    ProjectImporter(const ProjectImporter&) = delete;
+    ProjectImporter& operator=(const ProjectImporter&) = delete;
+
+    void SetProgressCallback(ProgressCallback callback) { m_progress = std::move(callback); }
+
+    // project_from_dict 相当 {"version": 1, "items": [...]}
+    void ImportProject(const py::dict& data);
+
+    // JSON ID → 作成したアイテム
+    const std::map<A_long, AEGP_ItemH>& GetItems() const { return m_items; }
+
+    // インポート統計
+    struct Stats {
+        size_t items = 0;
+        size_t layers = 0;
+        size_t properties = 0;
+        size_t keyframes = 0;
+        size_t effects = 0;
+    };
+    const Stats& GetStats() const { return m_stats; }
+
+    // 既存アイテムを JSON ID に対応付ける（ProjectDiff のパッチ適用で、
+    // 追加データ内の source_item_id / parent_folder_id を既存アイテムへ解決する）
+    void RegisterItem(A_long id, AEGP_ItemH itemH) { m_items[id] = itemH; }
+
+    // 以下は ProjectDiff から個別に呼ばれる復元処理
+    AEGP_LayerH CreateLayer(PyComp& comp, const py::dict& data);
+    void ApplyLayerSettings(PyLayer& layer, const py::dict& data);
+    void RestoreEffect(AEGP_LayerH layerH, const py::dict& data);
+
+    void RestoreChildren(AEGP_StreamRefH parentH, const py::dict& children);
+    void RestoreProperty(AEGP_StreamRefH streamH, const py::dict& data);
+    void RestorePropertyValue(AEGP_StreamRefH streamH, const py::dict& data, bool isEffectParam);
+    void AddKeyframes(AEGP_StreamRefH streamH, AEGP_StreamType type, const py::list& keyframes);
+
+private:
+    void CreateFolders(const std::vector<py::dict>& folders);
+    void CreateComp(const py::dict& item);
+    void CreateFootage(const py::dict& item);
+    void RestoreCompLayers(AEGP_CompH compH, const py::list& layers);
+
+    void RestoreTextAnimators(AEGP_StreamRefH rootH, const py::list& animators);
+    void RestoreShapePath(AEGP_StreamRefH streamH, const py::dict& data);
+
+    AEGP_ItemH ResolveFolder(A_long id) const;
+    AEGP_InstalledEffectKey FindInstalledEffect(const std::string& matchName);
+    void Report(const char* phase);
+
+    AEGP_ProjectH m_projectH;
+    AEGP_ItemH m_rootFolderH = nullptr;
+
+    std::map<A_long, AEGP_ItemH> m_items;
+    // ソリッドのフッテージは再作成しないため、レイヤー作成時にサイズだけ参照する
+    std::map<A_long, std::pair<A_long, A_long>> m_solidSizes;
+    // インストール済みエフェクト（初回参照時に一括構築）
+    std::map<std::string, AEGP_InstalledEffectKey> m_effectKeys;
+    bool m_effectKeysLoaded = false;
+
+    ProgressCallback m_progress;
+    size_t m_done = 0;
+    size_t m_total = 0;
+    Stats m_stats;
+};
+
+} // namespace PyAE
@@ -0,0 +1,76 @@
+// ProjectSerializer.h
+// PyAE - Python for After Effects
+// ネイティブ プロジェクトシリアライザ
+//
+// ae_serialize (export_scene.py) と同じスキーマの JSON を、
+// Pythonオブジェクトを経由せず SuiteCache から直接 DocumentWriter
+// （JsonWriter / SnapshotWriter）に書き出す。
+// アイテム・コンポ・レイヤー・プロパティツリー・キーフレーム・マスク・
+// エフェクト・フッテージを走査する。メインスレッドから呼ぶこと。
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "PluginState.h"
+#include "DocumentWriter.h"
+
+namespace PyAE {
+
+class ProjectSerializer {
+public:
+    explicit ProjectSerializer(DocumentWriter& writer) : m_writer(writer) {}
+
+    ProjectSerializer(const ProjectSerializer&) = delete;
+    ProjectSerializer& operator=(const ProjectSerializer&) = delete;
+
+    // project_to_dict 相当 {"version": 1, "items": [...]}
+    void WriteProject(AEGP_ProjectH projectH);
+
+    // items[] の1要素（includeData=false なら comp_data / footage_data を省く）
+    void WriteItem(AEGP_ItemH itemH, bool includeData = true);
+
+    // comp_to_dict 相当（comp_data）
+    void WriteComp(AEGP_CompH compH);
+
+    // layer_to_dict 相当
+    void WriteLayer(AEGP_LayerH layerH);
+
+    // footage_data 相当
+    void WriteFootage(AEGP_ItemH itemH);
+
+    // property_to_dict 相当（グループは再帰）
+    void WriteProperty(AEGP_StreamRefH streamH);
+
+    // effect_to_dict 相当
+    void WriteEffect(AEGP_EffectRefH effectH);
+
+    // 書き出し統計
+    struct Stats {
+        size_t items = 0;
+        size_t layers = 0;
+        size_t properties = 0;
+        size_t keyframes = 0;
+    };
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    void WriteLayerOptions(AEGP_StreamRefH rootH, const char* groupMatchName, const char* key);
+    void WriteTextLayerData(AEGP_LayerH layerH, AEGP_StreamRefH rootH, int layerIndex);
+    void WriteTextAnimator(AEGP_StreamRefH animatorH);
+    void WriteAnimatorProperties(AEGP_StreamRefH groupH, bool skipDefaults);
+    void WritePropertyKeyframes(AEGP_StreamRefH streamH);
+    void WriteValueKeyframes(AEGP_StreamRefH streamH);
+
+    // threeDPerChar はSDKから取得できないため、コンポごとに1回だけ
+    // ExtendScript で問い合わせてキャッシュする（0ベースのレイヤーインデックス）
+    const std::set<int>& GetThreeDPerCharLayers(AEGP_CompH compH);
+
+    DocumentWriter& m_writer;
+    Stats m_stats;
+    std::map<A_long, std::set<int>> m_threeDPerChar;
+};
+
+} // namespace PyAE
@@ -0,0 +1,324 @@
+// ProjectSnapshot.h
+// PyAE - Python for After Effects
+// バイナリ プロジェクトスナップショット
+//
+// ae_serialize の dict スキーマと往復互換なバイナリ形式。
+//   - 文字列（キー・マッチネーム・補間種別など）は文字列テーブルに集約して ID で参照
+//   - bdata 等の16進文字列は生バイト列として BLOB 領域に格納（同一内容は共有）
+//   - キーフレーム配列は列指向（time / bdata / in / out の各列）で格納
+//   - コンテナはバイト長を持つため、不要な部分木は読まずに読み飛ばせる
+// SnapshotReader はファイルをメモリマップし、必要なノードだけを参照する。
+//
+// レイアウト（リトルエンディアン、各セクションは8バイト境界）:
+//   Header (64 bytes)
+//   Strings: uint64 offsets[stringCount + 1], UTF-8 bytes
+//   Tree:    ルート値（下記タグ付きエンコーディング）
+//   Blob:    バイト列
+//
+// 値のエンコーディング:
+//   Null / False / True : tag
+//   Int                 : tag, int64
+//   Double              : tag, float64
+//   String              : tag, uint32 stringId
+//   Bytes               : tag, uint64 blobOffset, uint32 length
+//   Array               : tag, uint32 count, uint64 bodySize, value * count
+//   Object              : tag, uint32 count, uint64 bodySize, (uint32 keyId, value) * count
+//   KeyframeTable       : tag, uint32 count, uint64 bodySize, padding(8境界),
+//                         float64 time[n], uint64 bdataOffset[n], uint32 bdataLength[n],
+//                         uint32 inInterpolation[n], uint32 outInterpolation[n]
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "DocumentWriter.h"
+#include "WinSync.h"
+
+namespace PyAE {
+
+namespace Snapshot {
+
+constexpr char kMagic[8] = {'P', 'Y', 'A', 'E', 'S', 'N', 'A', 'P'};
+constexpr uint32_t kVersion = 1;
+
+enum class Tag : uint8_t {
+    Null = 0,
+    False = 1,
+    True = 2,
+    Int = 3,
+    Double = 4,
+    String = 5,
+    Bytes = 6,
+    Array = 7,
+    Object = 8,
+    KeyframeTable = 9,
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t stringCount;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t treeOffset;
+    uint64_t treeSize;
+    uint64_t blobOffset;
+    uint64_t blobSize;
+};
+static_assert(sizeof(Header) == 64, "Snapshot header must be 64 bytes");
+
+// コンテナ値のヘッダー長（tag + count + bodySize）
+constexpr size_t kContainerHeaderSize = 1 + 4 + 8;
+
+// 列指向で格納するキーフレーム配列のキーと各行のキー（この順序で復元される）
+constexpr std::string_view kKeyframesKey = "keyframes";
+constexpr std::string_view kKeyframeFields[4] = {
+    "time", "bdata", "in_interpolation", "out_interpolation"
+};
+
+} // namespace Snapshot
+
+// =============================================================
+// SnapshotWriter
+// =============================================================
+
+// DocumentWriter 実装。ProjectSerializer から直接、あるいは
+// Python の dict から変換してスナップショットを構築する。
+class SnapshotWriter : public DocumentWriter {
+public:
+    SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    void BeginObject() override;
+    void EndObject() override;
+    void BeginArray() override;
+    void EndArray() override;
+    void Key(std::string_view key) override;
+
+    void String(std::string_view value) override;
+    void Bool(bool value) override;
+    void Null() override;
+    void Int(int64_t value) override;
+    void Number(double value) override;
+    void HexString(std::string_view bytes) override;
+
+    // 完成したスナップショットのバイト列を返す（ルート値の書き込み後に1回だけ呼ぶ）
+    std::string Finish();
+
+    bool IsComplete() const { return m_stack.empty() && m_hasRoot && !m_capturing; }
+    size_t GetStringCount() const { return m_stringOffsets.size() - 1; }
+
+private:
+    // キーフレーム配列の取り込み用イベント
+    enum class EventType : uint8_t {
+        BeginObject, EndObject, BeginArray, EndArray, Key,
+        String, Bool, Null, Int, Number, Bytes
+    };
+    struct Event {
+        EventType type;
+        std::string text;
+        double number = 0.0;
+        int64_t integer = 0;
+    };
+
+    struct Frame {
+        size_t headerPos;
+        uint32_t count;
+        bool isObject;
+    };
+
+    uint32_t Intern(std::string_view text);
+    uint64_t StoreBlob(std::string_view bytes);
+
+    void BeginValue();
+    void BeginContainer(Snapshot::Tag tag);
+    void EndContainer(bool isObject);
+
+    void Record(Event event);
+    void FinishCapture();
+    bool WriteKeyframeTable();
+    void Replay();
+
+    template <typename T>
+    void Put(const T& value) {
+        m_tree.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    void PutTag(Snapshot::Tag tag) { m_tree += static_cast<char>(tag); }
+
+    std::string m_tree;
+    std::string m_blob;
+    std::string m_stringData;
+    std::vector<uint64_t> m_stringOffsets;
+    std::unordered_map<std::string, uint32_t> m_stringIds;
+    std::unordered_map<std::string, uint64_t> m_blobOffsets;
+
+    std::vector<Frame> m_stack;
+    bool m_afterKey = false;
+    bool m_hasRoot = false;
+    bool m_lastKeyIsKeyframes = false;
+
+    // "keyframes" 配列を取り込み中
+    bool m_capturing = false;
+    int m_captureDepth = 0;
+    std::vector<Event> m_events;
+};
+
+// =============================================================
+// SnapshotReader
+// =============================================================
+
+class SnapshotReader;
+
+// ツリー内の1つの値への軽量な参照（コピー可能、リーダーより長生きさせないこと）
+class SnapshotNode {
+public:
+    SnapshotNode() = default;
+
+    bool IsValid() const { return m_reader != nullptr; }
+    Snapshot::Tag GetTag() const;
+
+    bool IsContainer() const;
+
+    // コンテナの要素数（それ以外は0）
+    uint32_t Size() const;
+
+    // Object のメンバー検索（見つからなければ無効ノード）
+    SnapshotNode Get(std::string_view key) const;
+
+    // Array の要素
+    SnapshotNode At(uint32_t index) const;
+
+    // Object のメンバー走査 fn(std::string_view key, SnapshotNode value)
+    template <typename Fn>
+    void ForEachMember(Fn&& fn) const;
+
+    // Array の要素走査 fn(SnapshotNode value)
+    template <typename Fn>
+    void ForEachElement(Fn&& fn) const;
+
+    bool AsBool() const;
+    int64_t AsInt() const;
+    double AsDouble() const;
+    std::string_view AsString() const;
+    std::string_view AsBytes() const;
+
+    // KeyframeTable の列アクセス
+    double KeyframeTime(uint32_t index) const;
+    std::string_view KeyframeBdata(uint32_t index) const;
+    std::string_view KeyframeInInterpolation(uint32_t index) const;
+    std::string_view KeyframeOutInterpolation(uint32_t index) const;
+
+private:
+    friend class SnapshotReader;
+
+    SnapshotNode(const SnapshotReader* reader, size_t offset)
+        : m_reader(reader), m_offset(offset) {}
+
+    void Expect(Snapshot::Tag tag) const;
+    size_t BodyOffset() const { return m_offset + Snapshot::kContainerHeaderSize; }
+    size_t KeyframeColumnsOffset() const;
+
+    const SnapshotReader* m_reader = nullptr;
+    size_t m_offset = 0;
+};
+
+class SnapshotReader {
+public:
+    // ファイルをメモリマップして開く（Windows 以外では全体を読み込む）
+    static std::shared_ptr<SnapshotReader> OpenFile(const std::string& utf8Path);
+
+    // メモリ上のバイト列から開く
+    static std::shared_ptr<SnapshotReader> FromBytes(std::string bytes);
+
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    uint32_t GetVersion() const { return m_header.version; }
+    uint32_t GetStringCount() const { return m_header.stringCount; }
+    size_t GetSize() const { return m_size; }
+
+    SnapshotNode Root() const { return SnapshotNode(this, 0); }
+
+    std::string_view GetString(uint32_t id) const;
+    std::string_view GetBlob(uint64_t offset, uint32_t length) const;
+
+    // 文字列 ID の逆引き（初回呼び出し時に索引を構築）
+    bool FindString(std::string_view text, uint32_t& id) const;
+
+    // ツリー領域からの読み出し（範囲外は例外）
+    template <typename T>
+    T Read(size_t offset) const;
+
+    // offset の値の直後の位置
+    size_t SkipValue(size_t offset) const;
+
+private:
+    SnapshotReader() = default;
+
+    void Initialize();
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    Snapshot::Header m_header{};
+    const uint8_t* m_tree = nullptr;
+
+    std::string m_owned;
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+
+    // 文字列の逆引き表（最初の FindString で作る）
+    mutable WinMutex m_indexMutex;
+    mutable bool m_indexBuilt = false;
+    mutable std::unordered_map<std::string_view, uint32_t> m_stringIndex;
+};
+
+// =============================================================
+// Template implementations
+// =============================================================
+
+template <typename T>
+T SnapshotReader::Read(size_t offset) const {
+    if (offset > m_header.treeSize || m_header.treeSize - offset < sizeof(T)) {
+        throw std::runtime_error("Snapshot: corrupt tree (read out of range)");
+    }
+    T value;
+    std::memcpy(&value, m_tree + offset, sizeof(T));
+    return value;
+}
+
+template <typename Fn>
+void SnapshotNode::ForEachMember(Fn&& fn) const {
+    Expect(Snapshot::Tag::Object);
+    uint32_t count = Size();
+    size_t pos = BodyOffset();
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t keyId = m_reader->Read<uint32_t>(pos);
+        SnapshotNode value(m_reader, pos + 4);
+        fn(m_reader->GetString(keyId), value);
+        pos = m_reader->SkipValue(pos + 4);
+    }
+}
+
+template <typename Fn>
+void SnapshotNode::ForEachElement(Fn&& fn) const {
+    Expect(Snapshot::Tag::Array);
+    uint32_t count = Size();
+    size_t pos = BodyOffset();
+    for (uint32_t i = 0; i < count; ++i) {
+        fn(SnapshotNode(m_reader, pos));
+        pos = m_reader->SkipValue(pos);
+    }
+}
+
+} // namespace PyAE
@@ -14,6 +14,7 @@
 #include <string>
 #include <tuple>
 #include <memory>
+#include <optional>
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -59,6 +60,18 @@ enum class InterpretationStyle {
     NO_DIALOG_GUESS = 2      // Guess without dialog
 };
 
+// =============================================================
+// FootageSequenceOptions - シーケンスインポートオプション
+// sequence_options の辞書と ProjectSerializer で共有する
+// =============================================================
+struct FootageSequenceOptions {
+    bool isSequence = false;         // メインファイルが複数（連番）
+    bool allInFolder = false;
+    bool forceAlphabetical = false;
+    int startFrame = 0;
+    int endFrame = 0;
+};
+
 // =============================================================
 // PyFootage - フッテージクラス（統合版）
 //
@@ -120,6 +133,7 @@ public:
 
     // Get sequence import options
     py::dict GetSequenceOptions() const;
+    std::optional<FootageSequenceOptions> GetSequenceOptionsInfo() const;
 
     // =============================================================
     // Pre-Project Properties (only when is_in_project == false)
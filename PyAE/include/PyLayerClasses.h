@@ -9,6 +9,9 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <optional>
+#include <string>
+#include <vector>
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -149,6 +152,7 @@ public:
     // ==========================================
     int GetQuality() const;
     void SetQuality(int quality);
+    std::string GetQualityString() const;
     int GetSamplingQuality() const;
     void SetSamplingQuality(int sampling_quality);
     int GetLabel() const;
@@ -221,6 +225,13 @@ public:
     int GetObjectType() const;
     bool Is2D() const;
 
+    // ==========================================
+    // ソースアイテム寸法・平面色（実装: PyLayer_Core.cpp）
+    // ==========================================
+    int GetWidth() const;
+    int GetHeight() const;
+    std::optional<std::vector<double>> GetSolidColor() const;
+
     // ==========================================
     // トラックマット（実装: PyLayer_Matte.cpp）
     // ==========================================
@@ -245,6 +256,10 @@ public:
     void SetOpacity(double value);
     py::dict GetTransferMode() const;
     void SetTransferMode(const py::dict& transfer_mode);
+    int GetBlendMode() const;
+    void SetBlendMode(int mode);
+    int GetTrackMatteMode() const;
+    void SetTrackMatteMode(int mode);
     py::list ToWorldXform(double comp_time) const;
 
     // ==========================================
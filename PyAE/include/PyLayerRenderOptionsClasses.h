@@ -96,6 +96,16 @@ public:
     AEGP_LayerRenderOptionsH Release();
     bool IsOwned() const;
 
+    // =============================================================
+    // Pooling (LayerRenderOptionsPool)
+    // =============================================================
+
+    bool IsPooled() const;
+    // 変更した項目を記録する（OptionsField）。返却・Reset で既定値に戻す
+    void MarkModified(uint32_t fields);
+    // 変更した項目をレイヤーの既定値に戻す（プールから取得したものだけ）
+    void Reset();
+
     // =============================================================
     // Static factory methods
     // =============================================================
@@ -109,9 +119,16 @@ public:
     // Create layer render options from downstream of an effect
     static std::shared_ptr<PyLayerRenderOptions> FromDownstreamOfEffect(uintptr_t effectH);
 
+    // Acquire layer render options for a layer from LayerRenderOptionsPool
+    // (returned to the pool when disposed)
+    static std::shared_ptr<PyLayerRenderOptions> Acquire(uintptr_t layerH);
+
 private:
     AEGP_LayerRenderOptionsH m_optionsH;
     bool m_owned;
+    bool m_pooled = false;
+    LayerRenderOptionsPool::Key m_poolKey;
+    uint32_t m_modified = 0;
 
     void Dispose();
 };
@@ -0,0 +1,123 @@
+// PyObjectWriter.h
+// PyAE - Python for After Effects
+// Pythonオブジェクト出力 DocumentWriter
+//
+// ProjectSerializer の出力を JSON 文字列を経由せず dict / list に直接組み立てる。
+// 値の型は json.loads(project_to_json()) の結果と同じになる
+// （Number は float、バイト列は小文字16進文字列）。GIL を保持して使うこと。
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DocumentWriter.h"
+
+namespace py = pybind11;
+
+namespace PyAE {
+
+class PyObjectWriter : public DocumentWriter {
+public:
+    PyObjectWriter() = default;
+
+    PyObjectWriter(const PyObjectWriter&) = delete;
+    PyObjectWriter& operator=(const PyObjectWriter&) = delete;
+
+    // ==========================================
+    // 構造
+    // ==========================================
+    void BeginObject() override {
+        py::dict obj;
+        Put(obj);
+        m_stack.push_back({obj, true});
+    }
+    void EndObject() override { EndContainer(true); }
+
+    void BeginArray() override {
+        py::list arr;
+        Put(arr);
+        m_stack.push_back({arr, false});
+    }
+    void EndArray() override { EndContainer(false); }
+
+    void Key(std::string_view key) override {
+        if (m_stack.empty() || !m_stack.back().isObject || m_hasKey) {
+            throw std::logic_error("PyObjectWriter: key outside of object");
+        }
+        m_key = py::str(key.data(), key.size());
+        m_hasKey = true;
+    }
+
+    // ==========================================
+    // 値
+    // ==========================================
+    void String(std::string_view value) override { Put(py::str(value.data(), value.size())); }
+    void Bool(bool value) override { Put(py::bool_(value)); }
+    void Null() override { Put(py::none()); }
+    void Int(int64_t value) override { Put(py::int_(value)); }
+    void Number(double value) override { Put(py::float_(value)); }
+
+    void HexString(std::string_view bytes) override {
+        static const char kHex[] = "0123456789abcdef";
+        std::string hex;
+        hex.reserve(bytes.size() * 2);
+        for (unsigned char c : bytes) {
+            hex += kHex[c >> 4];
+            hex += kHex[c & 0x0F];
+        }
+        Put(py::str(hex));
+    }
+
+    // 書き出し完了後のルート値（未完了なら例外）
+    py::object GetResult() const {
+        if (!m_stack.empty() || !m_root) {
+            throw std::logic_error("PyObjectWriter: document is incomplete");
+        }
+        return m_root;
+    }
+
+private:
+    struct Frame {
+        py::object container;
+        bool isObject;
+    };
+
+    void Put(py::object value) {
+        if (m_stack.empty()) {
+            if (m_root) {
+                throw std::logic_error("PyObjectWriter: multiple root values");
+            }
+            m_root = std::move(value);
+            return;
+        }
+        Frame& top = m_stack.back();
+        if (top.isObject) {
+            if (!m_hasKey) {
+                throw std::logic_error("PyObjectWriter: value without key");
+            }
+            PyDict_SetItem(top.container.ptr(), m_key.ptr(), value.ptr());
+            m_hasKey = false;
+        } else {
+            PyList_Append(top.container.ptr(), value.ptr());
+        }
+    }
+
+    void EndContainer(bool isObject) {
+        if (m_stack.empty() || m_stack.back().isObject != isObject || m_hasKey) {
+            throw std::logic_error("PyObjectWriter: unbalanced container");
+        }
+        m_stack.pop_back();
+    }
+
+    std::vector<Frame> m_stack;
+    py::object m_root;
+    py::object m_key;
+    bool m_hasKey = false;
+};
+
+} // namespace PyAE
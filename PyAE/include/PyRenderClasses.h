@@ -8,9 +8,11 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <functional>
 #include <tuple>
 #include <memory>
 #include <string>
+#include <vector>
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -22,6 +24,7 @@
 
 #include "AE_GeneralPlug.h"
 #include "PyWorldClasses.h"
+#include "RenderOptionsPool.h"
 
 namespace py = pybind11;
 
@@ -146,6 +149,16 @@ public:
     AEGP_RenderOptionsH Release();
     bool IsOwned() const;
 
+    // =============================================================
+    // Pooling (RenderOptionsPool)
+    // =============================================================
+
+    bool IsPooled() const;
+    // 変更した項目を記録する（OptionsField）。返却・Reset で既定値に戻す
+    void MarkModified(uint32_t fields);
+    // 変更した項目をアイテムの既定値に戻す（プールから取得したものだけ）
+    void Reset();
+
     // =============================================================
     // Static factory method
     // =============================================================
@@ -153,9 +166,16 @@ public:
     // Create render options from an item
     static std::shared_ptr<PyRenderOptions> FromItem(uintptr_t itemH);
 
+    // Acquire render options for an item from RenderOptionsPool
+    // (returned to the pool when disposed)
+    static std::shared_ptr<PyRenderOptions> Acquire(uintptr_t itemH);
+
 private:
     AEGP_RenderOptionsH m_optionsH;
     bool m_owned;
+    bool m_pooled = false;
+    RenderOptionsPool::Key m_poolKey;
+    uint32_t m_modified = 0;
 
     void Dispose();
 };
@@ -194,8 +214,9 @@ public:
     // =============================================================
 
     // Get the rendered world (frame buffer)
-    // Note: The returned world is READ-ONLY and owned by the receipt
-    std::shared_ptr<PyWorld> GetWorld() const;
+    // Note: The returned world is READ-ONLY and owned by the receipt.
+    // Checkin invalidates every world returned here
+    std::shared_ptr<PyWorld> GetWorld();
 
     // Get the rendered region
     py::dict GetRenderedRegion() const;
@@ -227,6 +248,9 @@ public:
 private:
     AEGP_FrameReceiptH m_receiptH;
     bool m_checkedIn;
+
+    // GetWorld で渡したワールド（チェックイン時に無効化する）
+    std::vector<std::weak_ptr<PyWorld>> m_worlds;
 };
 
 // =============================================================
@@ -234,10 +258,19 @@ private:
 // =============================================================
 class PyRenderer {
 public:
+    // Item / CompItem / Comp / item handle (int) -> AEGP_ItemH
+    static AEGP_ItemH ResolveItem(const py::object& item);
+
     // Render a frame using RenderOptions
     static std::shared_ptr<PyFrameReceipt> RenderFrame(
         const std::shared_ptr<PyRenderOptions>& options);
 
+    // Render a frame; AE polls shouldCancel during the render and aborts
+    // when it returns true (then nullptr is returned)
+    static std::shared_ptr<PyFrameReceipt> RenderFrame(
+        const std::shared_ptr<PyRenderOptions>& options,
+        const std::function<bool()>& shouldCancel);
+
     // Render a layer frame using LayerRenderOptions (handle as uintptr_t)
     static std::shared_ptr<PyFrameReceipt> RenderLayerFrame(uintptr_t layerOptionsH);
 
@@ -21,6 +21,9 @@
 
 #include "AE_GeneralPlug.h"
 
+#include "ImageResize.h"
+#include "PixelConvert.h"
+
 namespace py = pybind11;
 
 namespace PyAE {
@@ -35,6 +38,19 @@ enum class WorldType {
     BIT32 = 3    // AEGP_WorldType_32 - 32bpc (float)
 };
 
+// =============================================================
+// WorldDesc - ワールドの不変情報
+// ワールドの生存中は変化しないため、最初の参照時に一度だけ取得する
+// =============================================================
+struct WorldDesc {
+    WorldType type = WorldType::NONE;
+    int width = 0;
+    int height = 0;
+    int rowBytes = 0;
+    int bytesPerPixel = 0;   // 4 / 8 / 16
+    void* baseAddr = nullptr;
+};
+
 // =============================================================
 // PyWorld - フレームバッファクラス
 // AEGP_WorldHのラッパー
@@ -65,6 +81,16 @@ public:
     // Check if world is valid
     bool IsValid() const;
 
+    // Cached descriptor (queried from WorldSuite when the handle is attached)
+    const WorldDesc& GetDesc() const;
+
+    // Re-query the descriptor (e.g. after the handle's pixels were reallocated)
+    void Refresh();
+
+    // Drop a handle owned elsewhere (e.g. by a frame receipt that was
+    // checked in). The world becomes invalid and refuses buffer exports
+    void Invalidate();
+
     // =============================================================
     // Properties (read-only)
     // =============================================================
@@ -95,9 +121,90 @@ public:
     // For 32bpc: 16 bytes per pixel (ARGB, float each)
     py::bytes GetPixels() const;
 
-    // Set all pixel data from bytes
+    // Set all pixel data from any contiguous buffer (bytes, bytearray,
+    // memoryview, NumPy array). Copied once directly into the world.
     // Data size must match GetRowBytes() * GetHeight()
-    void SetPixels(const py::bytes& data);
+    void SetPixels(const py::buffer& data);
+
+    // Describe the pixel memory as a (height, width, 4) ARGB buffer without copying.
+    // Row stride is GetRowBytes(); channel format is uint8 / uint16 / float32.
+    // The pointer is valid only while the world handle is alive. Worlds that
+    // do not own their handle (frame receipts) are exported read-only.
+    py::buffer_info GetBufferInfo() const;
+
+    // Describe the world as an ARGB image for PixelConvert
+    PixelConvert::ImageView GetImageView() const;
+
+    // Convert the pixels into another layout / depth.
+    // out: writable C-contiguous buffer of the exact size, or None to allocate
+    // (returned as a memoryview shaped (h, w, 4), or (4, h, w) for PLANAR)
+    py::object ReadPixels(py::object out, PixelConvert::Layout layout,
+                          WorldType depth, PixelConvert::AlphaOp alpha) const;
+
+    // Convert a C-contiguous buffer (uint8 / uint16 0-32768 / float32) into the world
+    void WritePixels(const py::buffer& data, PixelConvert::Layout layout,
+                     PixelConvert::AlphaOp alpha);
+
+    // =============================================================
+    // Region operations
+    // One native call per region; large regions run multithreaded
+    // without the GIL. Colors are (R, G, B, A) normalized to 0.0-1.0.
+    // =============================================================
+
+    // ReadPixels / WritePixels restricted to a rectangle (must lie inside the world)
+    py::object ReadRegion(int x, int y, int width, int height, py::object out,
+                          PixelConvert::Layout layout, WorldType depth,
+                          PixelConvert::AlphaOp alpha) const;
+    void WriteRegion(int x, int y, int width, int height, const py::buffer& data,
+                     PixelConvert::Layout layout, PixelConvert::AlphaOp alpha);
+
+    // Fill a rectangle (clipped to the world) / the whole world
+    void FillRect(int x, int y, int width, int height,
+                  const std::tuple<float, float, float, float>& color);
+    void Fill(const std::tuple<float, float, float, float>& color);
+
+    // Copy a rectangle from src (any bit depth; may be this world, overlap allowed)
+    void CopyRegion(const PyWorld& src, int srcX, int srcY, int width, int height,
+                    int dstX, int dstY);
+
+    // Primitives (clipped to the world)
+    void DrawLine(int x0, int y0, int x1, int y1,
+                  const std::tuple<float, float, float, float>& color, int thickness = 1);
+    void DrawRect(int x, int y, int width, int height,
+                  const std::tuple<float, float, float, float>& color, int thickness = 1);
+    void FillCircle(float cx, float cy, float radius,
+                    const std::tuple<float, float, float, float>& color);
+
+    // Per-channel statistics (R, G, B, A) of the world or a region
+    // (x, y, width, height) inside it; runs multithreaded without the GIL.
+    // Returns a dict: pixels, bins, range, min, max, mean, std, nan, below,
+    // above (4-tuples) and histogram (4 lists of bins counts, or None)
+    py::dict Statistics(int bins, const std::tuple<float, float>& range,
+                        bool histogram, py::object region) const;
+
+    // Compare with another World or a C-contiguous pixel buffer of the same
+    // size (layout as in WritePixels); runs multithreaded without the GIL.
+    // diff: optional World of the same size that receives |a - b| per channel.
+    // Returns a dict of the ImageCompare::Result fields plus psnr
+    py::dict Compare(py::object other, PixelConvert::Layout layout, float tolerance,
+                     bool earlyExit, bool ssim, int ssimTile, py::object diff) const;
+
+    // Resize the whole world (any bit depth; runs multithreaded without the GIL).
+    // Resize returns a new world from WorldPool (type None keeps this type),
+    // ResizeInto fills dst (its size is the target size; dst must be another world),
+    // ReadResized converts into a buffer as in ReadPixels (default 8-bit RGBA)
+    std::shared_ptr<PyWorld> Resize(int width, int height, ImageResize::Filter filter,
+                                    py::object type) const;
+    void ResizeInto(const PyWorld& dst, ImageResize::Filter filter) const;
+    py::object ReadResized(int width, int height, py::object out, ImageResize::Filter filter,
+                           PixelConvert::Layout layout, WorldType depth,
+                           PixelConvert::AlphaOp alpha) const;
+
+    // Run a registered PixelKernels kernel in place over the world or a region
+    // (x, y, width, height); other is the second input of 2-input kernels.
+    // kwargs are the kernel parameters. Returns a dict: tiles, threads
+    py::dict ApplyKernel(const std::string& name, py::object other, py::object region,
+                         int tileSize, const py::kwargs& kwargs);
 
     // Get single pixel value at (x, y)
     // Returns tuple (R, G, B, A) normalized to 0.0-1.0
@@ -135,12 +242,20 @@ public:
     // =============================================================
 
     // Create a new world with specified dimensions
-    static std::shared_ptr<PyWorld> Create(WorldType type, int width, int height);
+    // Worlds are taken from WorldPool; clear zeroes a recycled world
+    static std::shared_ptr<PyWorld> Create(WorldType type, int width, int height, bool clear = true);
 
 private:
     AEGP_WorldH m_worldH;
     bool m_owned;
 
+    // Descriptor cache (filled by the constructor and Refresh, cleared
+    // when the handle is released or invalidated)
+    WorldDesc m_desc;
+
+    // Query type, size, row bytes and base address from WorldSuite
+    static WorldDesc QueryDesc(AEGP_WorldH worldH);
+
     // Internal dispose helper
     void Dispose();
 
@@ -0,0 +1,150 @@
+// RenderEventQueue.h
+// PyAE - Python for After Effects
+// レンダーキュー監視イベントのロックフリーな受け渡しキュー
+//
+// AE のレンダー通知（RQM コールバック）は小さなレコードを固定長の
+// リングバッファに積むだけにし、Python への通知はアイドル処理側で
+// まとめて行う。リングは複数の生産者・1つの消費者で、生産側は
+// ロックも待ちもしない。満杯のときは捨てて数える。
+//
+// 取り出し時に同じアイテムのフレーム更新（ItemUpdated）を1件にまとめ、
+// アイテムごとに通知頻度を制限する。間引いた更新は保留し、後の取り出しか
+// そのアイテムの他のイベントの直前に最新の1件を渡す。SDK に依存しない。
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "WinSync.h"
+
+namespace PyAE {
+namespace RenderEvents {
+
+enum class Type : uint8_t {
+    JobStarted,
+    JobEnded,
+    ItemStarted,
+    ItemUpdated,
+    ItemEnded,
+    ReportLog
+};
+
+// "job_started" など（Python に渡す名前）
+const char* TypeName(Type type);
+
+struct Event {
+    Type type = Type::JobStarted;
+    uint64_t session = 0;
+    uint64_t item = 0;
+    uint64_t value = 0;     // ItemUpdated: フレームID、ItemEnded: 終了状態、ReportLog: エラーなら1
+    uint32_t merged = 1;    // まとめたイベント数（ItemUpdated 以外は1）
+    double time = 0.0;      // 受け取った時刻（Now() の秒）
+    std::string message;    // ReportLog のみ
+};
+
+struct Stats {
+    uint64_t received = 0;      // リングに積んだイベント数
+    uint64_t dropped = 0;       // リングが一杯で捨てたイベント数
+    uint64_t coalesced = 0;     // 他の更新にまとめた ItemUpdated の数
+    uint64_t delivered = 0;     // 取り出して渡したイベント数
+    uint64_t batches = 0;       // 空でなかった取り出しの回数
+    size_t pending = 0;         // リング内のイベント数
+    size_t held = 0;            // 頻度制限で保留中の更新数
+    size_t capacity = 0;
+    double maxUpdateRate = 0.0;
+};
+
+constexpr size_t kDefaultCapacity = 4096;
+constexpr double kDefaultMaxUpdateRate = 30.0;
+
+class Queue {
+public:
+    explicit Queue(size_t capacity = kDefaultCapacity);
+    ~Queue();
+
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+
+    // 単調増加の時刻（秒）
+    static double Now();
+
+    // 空のキューに最初のイベントが積まれたときに（積んだスレッドで）呼ぶ。
+    // 取り出し側へ知らせるだけの軽い処理にすること
+    void SetWakeup(std::function<void()> wakeup);
+
+    // 任意のスレッドから呼べる。ロックを取らず、満杯なら捨てて false。
+    // ItemUpdated は容量の 3/4 までしか積まず、残りを開始・終了・ログに残す
+    bool Push(Type type, uint64_t session, uint64_t item, uint64_t value = 0);
+    bool PushLog(uint64_t session, uint64_t item, bool isError, std::string message);
+
+    // 積まれたイベントを順に取り出す（同時に呼べるのは1スレッド）。
+    // ItemUpdated はアイテムごとに1件にまとめ、前回渡してから
+    // 1 / maxUpdateRate 秒経っていなければ保留する。
+    // flushHeld: 保留中の更新も頻度に関係なく渡す。
+    // 保留が残った場合、新しいイベントが積まれなくても NextHeldDue() の
+    // 時刻以降にもう一度呼ぶこと（起こす通知は来ない）
+    std::vector<Event> Drain(double now, bool flushHeld = false);
+
+    // 保留中の更新を渡せる最も早い時刻（Now() の秒）。保留が無ければ 0
+    double NextHeldDue() const;
+
+    // 毎秒の ItemUpdated の上限（アイテムごと）。0 で制限しない
+    void SetMaxUpdateRate(double rate);
+    double GetMaxUpdateRate() const;
+
+    // 容量を変えて中身を捨てる（2 の累乗に切り上げ、16 - 1M）。
+    // Push と同時に呼んではならない
+    void Reset(size_t capacity);
+
+    Stats GetStats() const;
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        Type type = Type::JobStarted;
+        uint64_t session = 0;
+        uint64_t item = 0;
+        uint64_t value = 0;
+        double time = 0.0;
+        std::string* message = nullptr;     // ReportLog のみ（取り出し側が解放）
+    };
+
+    using ItemKey = std::pair<uint64_t, uint64_t>;
+
+    bool PushSlot(Type type, uint64_t session, uint64_t item, uint64_t value,
+                  std::unique_ptr<std::string>& message);
+    void Allocate(size_t capacity);
+    void Release();
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask = 0;
+    size_t m_updateLimit = 0;
+
+    alignas(64) std::atomic<size_t> m_tail{0};
+    alignas(64) std::atomic<size_t> m_head{0};
+    std::atomic<bool> m_wakePending{false};
+    std::function<void()> m_wakeup;
+
+    std::atomic<uint64_t> m_received{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_coalesced{0};
+    std::atomic<uint64_t> m_delivered{0};
+    std::atomic<uint64_t> m_batches{0};
+    std::atomic<double> m_maxUpdateRate{kDefaultMaxUpdateRate};
+
+    // 取り出し側の状態（m_drainMutex で保護）
+    mutable WinMutex m_drainMutex;
+    std::map<ItemKey, Event> m_held;            // 頻度制限で保留中の更新
+    std::map<ItemKey, double> m_lastUpdate;     // アイテムごとに最後に渡した時刻
+    double m_heldDue = 0.0;                     // 保留分を渡せる最も早い時刻
+};
+
+} // namespace RenderEvents
+} // namespace PyAE
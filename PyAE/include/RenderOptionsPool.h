@@ -0,0 +1,215 @@
+// RenderOptionsPool.h
+// PyAE - Python for After Effects
+// レンダーオプション / レイヤーレンダーオプションの再利用プール
+//
+// AEGP_NewFromItem / AEGP_NewFromLayer で作ったハンドルをアイテム（レイヤー）
+// ごとに保持し、同じアイテムの次の取得で再利用する。返却時に取得後に
+// 変更した項目を記録しておき、再利用時にその項目だけ最初に作ったハンドルの
+// 値（アイテムの既定値）へ戻す。フレームごとに時刻だけ変えるループなら
+// 定常状態では作成も破棄も起きない。
+// 既定値はプロジェクトのタイムスタンプ・ビット深度・アイテムの現在時間と
+// 一緒に保持し、取得時にこれらが変わっていれば新しく作ったハンドルから取り直す。
+// 保持するアイテム数が上限を超えた場合は最も長く使われていないアイテムの
+// ハンドルから破棄する（LRU）。
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "AE_GeneralPlug.h"
+
+#include "WinSync.h"
+
+namespace PyAE {
+
+// 取得後に変更した項目（PyRenderOptions / PyLayerRenderOptions が記録する）
+namespace OptionsField {
+enum : uint32_t {
+    Time             = 1u << 0,
+    TimeStep         = 1u << 1,
+    WorldType        = 1u << 2,
+    FieldRender      = 1u << 3,
+    Downsample       = 1u << 4,
+    RegionOfInterest = 1u << 5,
+    MatteMode        = 1u << 6,
+    ChannelOrder     = 1u << 7,
+    GuideLayers      = 1u << 8,
+    Quality          = 1u << 9,
+    All              = 0xFFFFFFFFu  // ハンドルが外へ渡された（何を変えたかわからない）
+};
+} // namespace OptionsField
+
+// アイテムから作った直後の値
+struct RenderOptionsDefaults {
+    A_Time time = {0, 1};
+    A_Time timeStep = {0, 1};
+    AEGP_WorldType worldType = AEGP_WorldType_NONE;
+    PF_Field field = PF_Field_FRAME;
+    A_short downsampleX = 1;
+    A_short downsampleY = 1;
+    A_LRect roi = {0, 0, 0, 0};
+    AEGP_MatteMode matteMode = AEGP_MatteMode_STRAIGHT;
+    AEGP_ChannelOrder channelOrder = AEGP_ChannelOrder_ARGB;
+    A_Boolean guideLayers = FALSE;
+    AEGP_ItemQuality quality = AEGP_ItemQuality_BEST;
+};
+
+struct LayerRenderOptionsDefaults {
+    A_Time time = {0, 1};
+    A_Time timeStep = {0, 1};
+    AEGP_WorldType worldType = AEGP_WorldType_NONE;
+    A_short downsampleX = 1;
+    A_short downsampleY = 1;
+    AEGP_MatteMode matteMode = AEGP_MatteMode_STRAIGHT;
+};
+
+// 既定値を取った時点の状態（アイテムの設定・プロジェクトのビット深度・現在時間）
+struct OptionsDefaultsStamp {
+    AEGP_TimeStamp timestamp = {};
+    AEGP_ProjBitDepth bitDepth = 0;
+    A_Time currentTime = {0, 1};
+};
+
+// ハンドルの種類ごとの操作（RenderOptionsPool.cpp で定義）
+struct RenderOptionsTraits {
+    using Owner = AEGP_ItemH;
+    using Handle = AEGP_RenderOptionsH;
+    using Defaults = RenderOptionsDefaults;
+
+    static const char* Name();
+    static uint64_t OwnerId(Owner owner);   // アイテムID（ハンドルの再利用を見分ける）
+    static Handle New(Owner owner);
+    static void Dispose(Handle handle);
+    static Defaults Capture(Handle handle);
+    static void Reset(Handle handle, const Defaults& defaults, uint32_t fields);
+    static OptionsDefaultsStamp Stamp(Owner owner);
+    // stamp の後に既定値が変わりうる変更があったか（確かめられなければ true）
+    static bool Changed(Owner owner, const OptionsDefaultsStamp& stamp);
+};
+
+struct LayerRenderOptionsTraits {
+    using Owner = AEGP_LayerH;
+    using Handle = AEGP_LayerRenderOptionsH;
+    using Defaults = LayerRenderOptionsDefaults;
+
+    static const char* Name();
+    static uint64_t OwnerId(Owner owner);   // レイヤーID
+    static Handle New(Owner owner);
+    static void Dispose(Handle handle);
+    static Defaults Capture(Handle handle);
+    static void Reset(Handle handle, const Defaults& defaults, uint32_t fields);
+    static OptionsDefaultsStamp Stamp(Owner owner);     // レイヤーのコンポジション
+    static bool Changed(Owner owner, const OptionsDefaultsStamp& stamp);
+};
+
+template <typename Traits>
+class OptionsPool {
+public:
+    using Owner = typename Traits::Owner;
+    using Handle = typename Traits::Handle;
+    using Defaults = typename Traits::Defaults;
+
+    // 返却先（ハンドルの値とアイテムID）
+    struct Key {
+        uint64_t owner = 0;
+        uint64_t id = 0;
+        bool operator<(const Key& other) const {
+            return owner != other.owner ? owner < other.owner : id < other.id;
+        }
+    };
+
+    struct Stats {
+        uint64_t hits = 0;          // プールから再利用した回数
+        uint64_t misses = 0;        // 新しく作った回数
+        uint64_t resets = 0;        // 再利用時に既定値へ戻した回数
+        uint64_t refreshes = 0;     // アイテム・プロジェクトの変更で既定値を取り直した回数
+        uint64_t returned = 0;      // プールに戻した回数
+        uint64_t evicted = 0;       // 上限・Clear で破棄した回数
+        size_t pooled = 0;          // プール内のハンドル数
+        size_t live = 0;            // 貸し出し中のハンドル数
+        size_t owners = 0;          // 既定値を保持しているアイテム数
+    };
+
+    static OptionsPool& Instance();
+
+    // owner の既定値のハンドルを取得する（プールに無ければ新規作成）。
+    // key は Release / Reset に渡す
+    Handle Acquire(Owner owner, Key* key);
+
+    // ハンドルを返却する。modified: 取得後に変更した項目（OptionsField）。
+    // 無効時・終了処理中・上限超過・アイテムが追い出された後は破棄する
+    void Release(const Key& key, Handle handle, uint32_t modified);
+
+    // 貸し出し中のハンドルの modified の項目を既定値に戻す
+    void Reset(const Key& key, Handle handle, uint32_t modified);
+
+    // 貸し出し中のハンドルの所有権が外へ移った（返却されない）
+    void Abandon();
+
+    // アイテムごとに保持するハンドル数の上限
+    void SetMaxIdle(size_t maxIdle);
+    size_t GetMaxIdle() const;
+
+    // 既定値とハンドルを保持するアイテム数の上限（LRU）
+    void SetMaxOwners(size_t maxOwners);
+    size_t GetMaxOwners() const;
+
+    // 無効にするとプール内のハンドルを破棄し、以後は返却時に即破棄する
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+
+    // プール内のハンドルと既定値をすべて破棄する
+    void Clear();
+
+    Stats GetStats() const;
+    void ResetStats();
+
+    // プール内のハンドルをすべて破棄する（プラグイン終了時）
+    void Shutdown();
+
+private:
+    OptionsPool() = default;
+    ~OptionsPool() = default;
+
+    OptionsPool(const OptionsPool&) = delete;
+    OptionsPool& operator=(const OptionsPool&) = delete;
+
+    struct Idle {
+        Handle handle;
+        uint32_t modified;
+    };
+
+    struct Entry {
+        Defaults defaults;
+        OptionsDefaultsStamp stamp;
+        std::vector<Idle> idle;
+        uint64_t lastUse = 0;
+    };
+
+    // 既定値を取った後に owner が変わっていれば新しいハンドルから取り直し、
+    // そのハンドルを fresh に返す（ロックの外で呼ぶ）
+    bool RefreshDefaults(Owner owner, const Key& key, Handle* fresh);
+
+    // m_mutex を保持した状態で呼ぶ。keep 以外の古いアイテムから maxOwners 以下にする
+    void EvictLocked(size_t maxOwners, const Key* keep, std::vector<Handle>& disposed);
+    void TrimIdleLocked(size_t maxIdle, std::vector<Handle>& disposed);
+
+    mutable WinMutex m_mutex;
+    std::map<Key, Entry> m_entries;
+    size_t m_maxIdle = 4;
+    size_t m_maxOwners = 64;
+    bool m_enabled = true;
+    uint64_t m_tick = 0;
+    Stats m_stats;
+};
+
+using RenderOptionsPool = OptionsPool<RenderOptionsTraits>;
+using LayerRenderOptionsPool = OptionsPool<LayerRenderOptionsTraits>;
+
+extern template class OptionsPool<RenderOptionsTraits>;
+extern template class OptionsPool<LayerRenderOptionsTraits>;
+
+} // namespace PyAE
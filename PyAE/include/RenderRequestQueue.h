@@ -0,0 +1,153 @@
+// RenderRequestQueue.h
+// PyAE - Python for After Effects
+// 非同期レンダー要求の待ち行列と取り消し
+//
+// AEGP のレンダー呼び出しはメインスレッドでしか使えないため、要求は
+// ここに積んでアイドル処理で1件ずつ描画する。要求は取り消しトークンを
+// 持ち、描画中は AE のキャンセル関数がそれを見て中断する。
+// グループを指定すると、同じグループの未完了の要求は新しい要求で
+// 置き換えられる（スクラブ中の古いフレームを描かない）。
+// 完了・取り消しになった要求はまとめて取り出し、メインスレッドで通知する。
+// AE の API は呼ばない。
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "TaskQueue.h"
+
+namespace PyAE {
+
+class RenderRequestQueue {
+public:
+    enum class State {
+        Pending,        // 描画待ち
+        Rendering,      // 描画中
+        Done,
+        Cancelled,      // 取り消し・置き換え・期限切れ
+        Failed
+    };
+
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t completed = 0;
+        uint64_t failed = 0;
+        uint64_t cancelled = 0;     // cancel() で取り消した数
+        uint64_t superseded = 0;    // 同じグループの新しい要求で置き換えた数
+        uint64_t expired = 0;       // 期限を過ぎた数
+        uint64_t aborted = 0;       // 描画中に中断した数（上の内訳と重複する）
+        size_t pending = 0;
+        size_t rendering = 0;
+    };
+
+    // 1件の要求。描画する内容は派生クラスが持つ
+    class Request {
+    public:
+        virtual ~Request() = default;
+
+        uint64_t GetId() const { return m_id; }
+        const std::string& GetGroup() const { return m_group; }
+
+        // 取り消しを求められたか、期限を過ぎたら true（どのスレッドからも呼べる）。
+        // 描画中は AE のキャンセル関数からこれを見る
+        bool ShouldStop() const;
+        bool IsCancelRequested() const { return m_cancelRequested.load(std::memory_order_acquire); }
+
+    protected:
+        // group: 空でなければ同じグループの古い要求を置き換える。
+        // timeoutSeconds: 積んでからの期限（0 以下で無制限）
+        Request(std::string group, double timeoutSeconds);
+
+    private:
+        friend class RenderRequestQueue;
+
+        uint64_t m_id = 0;
+        std::string m_group;
+        std::chrono::steady_clock::time_point m_submitted;
+        std::chrono::steady_clock::time_point m_deadline;
+        bool m_hasDeadline = false;
+        std::atomic<bool> m_cancelRequested{false};
+
+        // 以下は RenderRequestQueue の m_cs で保護
+        State m_state = State::Pending;
+        std::string m_error;
+        uint64_t Stats::*m_cancelReason = nullptr;  // 中断を求めた理由（統計の項目）
+        std::chrono::steady_clock::time_point m_started;
+        double m_waitSeconds = 0.0;     // 積んでから描画を始めるまで
+        double m_renderSeconds = 0.0;
+    };
+    using RequestPtr = std::shared_ptr<Request>;
+
+    RenderRequestQueue() = default;
+
+    RenderRequestQueue(const RenderRequestQueue&) = delete;
+    RenderRequestQueue& operator=(const RenderRequestQueue&) = delete;
+
+    // 処理すべきもの（描画待ち・通知待ち）ができたときに呼ぶ。
+    // 次の EndPump までは呼び直さない。軽い処理にすること
+    void SetWakeup(std::function<void()> wakeup);
+
+    // 積む。同じグループの未完了の要求は置き換える（描画中なら中断を求める）
+    void Submit(const RequestPtr& request);
+
+    // 取り消す。描画待ちならすぐ Cancelled に、描画中なら中断を求める。
+    // 既に終わっていれば false
+    bool Cancel(const RequestPtr& request);
+
+    // group の未完了の要求をすべて取り消す（空ならすべて）。取り消した数を返す
+    size_t CancelGroup(const std::string& group);
+
+    // 次に描画する要求を Rendering にして返す（なければ nullptr）。
+    // 期限を過ぎた要求は飛ばして Cancelled にする
+    RequestPtr Next();
+
+    // Next で取り出した要求を終える。描画中に中断を求められていたら
+    // aborted として Cancelled にする（state は Done / Failed を渡す）
+    void Finish(const RequestPtr& request, State state, const std::string& error = std::string());
+
+    // 終わった要求（Done / Cancelled / Failed）を終わった順に取り出す
+    std::vector<RequestPtr> TakeFinished();
+
+    // 1回分の処理を終えたときに呼ぶ。まだ処理すべきものがあれば wakeup を呼ぶ
+    void EndPump();
+
+    // 終わるまで待つ（timeoutMs < 0 で無制限）。終わっていれば true
+    bool Wait(const RequestPtr& request, int timeoutMs) const;
+
+    State GetState(const RequestPtr& request) const;
+    std::string GetError(const RequestPtr& request) const;
+    double GetWaitSeconds(const RequestPtr& request) const;
+    double GetRenderSeconds(const RequestPtr& request) const;
+
+    Stats GetStats() const;
+
+    static const char* StateName(State state);
+
+private:
+    static bool IsFinished(State state);
+
+    // m_cs を保持した状態で呼ぶ。wakeup を呼ぶ必要があれば true
+    bool FinishLocked(const RequestPtr& request, State state, std::string error);
+    bool CancelLocked(const RequestPtr& request, uint64_t Stats::*counter, bool& wake);
+    bool ScheduleLocked();
+
+    void Wake();
+
+    mutable TaskQueueCS m_cs;
+    std::deque<RequestPtr> m_pending;
+    std::vector<RequestPtr> m_rendering;
+    std::vector<RequestPtr> m_finished;
+    uint64_t m_nextId = 1;
+    bool m_scheduled = false;
+    Stats m_stats;
+    std::function<void()> m_wakeup;
+};
+
+} // namespace PyAE
@@ -0,0 +1,170 @@
+// RenderStats.h
+// PyAE - Python for After Effects
+// レンダージョブの統計収集（ジョブ・アイテム・フレームごとの時間とメモリ）
+//
+// RQM コールバックのイベントを受け取った時点で（まとめたり間引いたり
+// する前に）記録する。フレームは固定長の小さなレコードを1つの配列に
+// 積むだけにし、平均・分位点・ヒストグラムなどは問い合わせ時に計算する。
+// アイテムごとの件数・合計・最小・最大は常に更新するので、フレームの
+// 上限を超えて記録を捨てた後も要約は正しい。SDK に依存しない。
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "RenderEventQueue.h"
+#include "WinSync.h"
+
+namespace PyAE {
+namespace RenderStats {
+
+// 時刻はすべて収集開始からの秒
+struct JobRecord {
+    uint64_t session = 0;
+    double start = 0.0;
+    double end = -1.0;          // 終了前は -1
+    uint32_t items = 0;
+    uint32_t frames = 0;
+};
+
+struct ItemRecord {
+    uint64_t session = 0;
+    uint64_t item = 0;
+    double start = 0.0;
+    double end = -1.0;          // 終了前は -1
+    double lastFrame = 0.0;     // 直前のフレーム（なければ開始）の時刻
+    double frameTimeTotal = 0.0;
+    float frameTimeMin = 0.0f;
+    float frameTimeMax = 0.0f;
+    uint32_t job = 0;           // JobRecord のインデックス
+    uint32_t frames = 0;        // 時間を測れたフレーム数は timedFrames
+    uint32_t timedFrames = 0;
+    uint32_t logErrors = 0;
+    uint32_t logMessages = 0;
+    int32_t status = -1;        // 終了状態（終了前は -1）
+};
+
+// 24 バイト。duration は直前のフレーム（最初はアイテム開始）からの秒。
+// 収集を途中から始めて開始を見ていないアイテムの最初のフレームは NaN
+struct FrameRecord {
+    double time = 0.0;
+    uint64_t frameId = 0;
+    float duration = 0.0f;
+    uint32_t item = 0;          // ItemRecord のインデックス
+};
+
+struct MemorySample {
+    uint64_t workingSet = 0;
+    uint64_t privateBytes = 0;
+};
+
+struct MemoryRecord {
+    double time = 0.0;
+    MemorySample sample;
+    uint32_t item = UINT32_MAX; // 記録時にレンダー中だったアイテム（なければ UINT32_MAX）
+};
+
+// 問い合わせ時に計算するアイテムの要約
+struct ItemSummary {
+    ItemRecord record;
+    double renderTime = 0.0;    // 開始から終了（終了前は最後のイベント）まで
+    double mean = 0.0;          // 以下は時間を測れたフレームの秒（なければ NaN）
+    double p50 = 0.0;
+    double p95 = 0.0;
+};
+
+struct Histogram {
+    std::vector<double> edges;      // bins + 1
+    std::vector<uint64_t> counts;   // bins
+};
+
+struct Counters {
+    size_t jobs = 0;
+    size_t items = 0;
+    size_t frames = 0;              // 記録しているフレーム数
+    size_t memorySamples = 0;
+    uint64_t droppedFrames = 0;     // 上限を超えて捨てたフレーム数
+    uint64_t events = 0;
+    size_t bytes = 0;               // 記録の使用メモリ（概算）
+};
+
+enum class Table { Jobs, Items, Frames, Memory };
+
+constexpr size_t kDefaultMaxFrames = size_t(1) << 22;
+constexpr double kDefaultMemoryInterval = 1.0;
+
+class Collector {
+public:
+    using MemorySampler = std::function<MemorySample()>;
+
+    Collector() = default;
+
+    Collector(const Collector&) = delete;
+    Collector& operator=(const Collector&) = delete;
+
+    // メモリの測り方と間隔（秒）。ジョブ・アイテムの開始と終了、および
+    // フレームの記録時に前回から interval 経っていれば測る。
+    // interval <= 0 または sampler なしで測らない
+    void SetMemorySampler(MemorySampler sampler, double interval);
+    void SetMaxFrames(size_t maxFrames);
+
+    // 記録を捨てて時刻の原点を now にする
+    void Clear(double now);
+
+    // イベントを1件記録する（任意のスレッドから呼べる）。
+    // value は RenderEvents::Event と同じ（フレームID、終了状態、エラーなら1）
+    void Record(RenderEvents::Type type, uint64_t session, uint64_t item,
+                uint64_t value, double now);
+
+    // 問い合わせ（記録のコピーを返す）。item が0以外ならそのアイテムだけ
+    std::vector<JobRecord> GetJobs() const;
+    std::vector<ItemSummary> GetItems() const;
+    std::vector<FrameRecord> GetFrames(uint64_t item = 0) const;
+    std::vector<MemoryRecord> GetMemory() const;
+    std::vector<FrameRecord> GetSlowestFrames(size_t count, uint64_t item = 0) const;
+    // フレーム時間のヒストグラム。lo >= hi なら 0 から最大値まで
+    Histogram GetHistogram(size_t bins, double lo, double hi, uint64_t item = 0) const;
+    // アイテムのインデックス順の (session, item)。FrameRecord::item などを引く
+    std::vector<std::pair<uint64_t, uint64_t>> GetItemKeys() const;
+    Counters GetCounters() const;
+
+    // レポート。CSV は表1つ、JSON はすべて（フレームとメモリは列ごとの配列）
+    std::string ToCsv(Table table) const;
+    std::string ToJson(int indent = -1) const;
+
+private:
+    using ItemKey = std::pair<uint64_t, uint64_t>;
+
+    uint32_t FindJob(uint64_t session, double time);
+    uint32_t FindItem(uint64_t session, uint64_t item, double time, bool* created);
+    void SampleMemory(double time, uint32_t item, bool force);
+    // durations: そのアイテムの記録中のフレーム時間（並べ替える）
+    ItemSummary Summarize(uint32_t index, std::vector<float>& durations) const;
+    std::vector<ItemSummary> SummarizeAll() const;
+
+    mutable WinMutex m_mutex;
+    double m_origin = 0.0;
+    double m_lastTime = 0.0;    // 最後のイベントの時刻
+    size_t m_maxFrames = kDefaultMaxFrames;
+    uint64_t m_droppedFrames = 0;
+    uint64_t m_events = 0;
+
+    std::vector<JobRecord> m_jobs;
+    std::vector<ItemRecord> m_items;
+    std::vector<FrameRecord> m_frames;
+    std::vector<MemoryRecord> m_memory;
+    std::map<uint64_t, uint32_t> m_jobIndex;
+    std::map<ItemKey, uint32_t> m_itemIndex;
+
+    MemorySampler m_sampler;
+    double m_memoryInterval = kDefaultMemoryInterval;
+    double m_lastMemory = -1.0;
+};
+
+} // namespace RenderStats
+} // namespace PyAE
@@ -0,0 +1,126 @@
+// ThumbnailStore.h
+// PyAE - Python for After Effects
+// プロジェクトアイテムのサムネイルのキャッシュ（メモリ + 圧縮したディスク）
+//
+// サムネイルは 8bit RGBA の小さな画像で、キーはアイテム ID。各サムネイルは
+// 生成直前の AEGP タイムスタンプと、生成したセッションの ID、そのときの
+// プロジェクトファイルの更新時刻（未保存の変更があれば 0）を持つ。
+// 有効かどうかは呼び出し側が判断する（同じセッションならタイムスタンプで、
+// 前のセッションならプロジェクトファイルが生成時から変わっていないかで）。
+//
+// ディスクには1アイテム1ファイルで、行の差分（先頭行は左、以降は上の画素
+// との差）を LZ77 で圧縮して書く。メモリ上のサムネイルはバイト数の上限で
+// LRU から追い出すが、ディスクのファイルは消えるまで残す。
+// AE の API は呼ばない。
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "PixelConvert.h"
+#include "WinSync.h"
+
+namespace PyAE {
+
+class ThumbnailStore {
+public:
+    using Stamp = std::array<int32_t, 4>;   // AEGP_TimeStamp
+
+    struct Thumbnail {
+        uint32_t itemId = 0;
+        Stamp stamp = {0, 0, 0, 0};
+        uint64_t session = 0;       // 生成（または検証）したセッション
+        int64_t projectTime = 0;    // そのときのプロジェクトファイルの更新時刻（未保存なら 0）
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> pixels;    // RGBA 8bit、行間の余白なし
+
+        PixelConvert::ImageView View() const;
+    };
+    using ThumbnailPtr = std::shared_ptr<const Thumbnail>;
+
+    struct Stats {
+        uint64_t hits = 0;          // メモリで見つかった数
+        uint64_t diskHits = 0;      // ディスクから読み戻した数
+        uint64_t misses = 0;
+        uint64_t inserts = 0;
+        uint64_t evictions = 0;     // メモリから追い出した数
+        uint64_t diskWrites = 0;
+        uint64_t diskErrors = 0;    // 読み書きに失敗した数（読めないファイルは消す）
+        size_t memoryEntries = 0;
+        uint64_t memoryBytes = 0;
+        size_t diskEntries = 0;
+        uint64_t diskBytes = 0;     // 圧縮後のファイルサイズの合計
+        uint64_t rawBytes = 0;      // ディスクのサムネイルの圧縮前の画素数 x 4
+        uint64_t maxMemoryBytes = 0;
+    };
+
+    // directory が空ならディスクには書かない。既存のファイルは消さずに使う
+    ThumbnailStore(uint64_t maxMemoryBytes, const std::string& directory);
+
+    ThumbnailStore(const ThumbnailStore&) = delete;
+    ThumbnailStore& operator=(const ThumbnailStore&) = delete;
+
+    // メモリ、次にディスクを探す（ディスクで見つかればメモリへ載せる）。
+    // 有効かどうかは確かめない
+    ThumbnailPtr Find(uint32_t itemId);
+
+    // 同じアイテムのサムネイルを置き換え、ディスクにも書く
+    ThumbnailPtr Insert(Thumbnail thumbnail);
+
+    // 画素は変えずに stamp / session / projectTime を書き換える（ディスクはヘッダーだけ）
+    ThumbnailPtr Restamp(const ThumbnailPtr& thumbnail, const Stamp& stamp,
+                         uint64_t session, int64_t projectTime);
+
+    // itemId のサムネイルをメモリとディスクから消す
+    bool Erase(uint32_t itemId);
+    size_t Clear();
+
+    void SetMaxMemoryBytes(uint64_t maxMemoryBytes);
+
+    const std::string& GetDirectory() const { return m_directory; }
+    Stats GetStats() const;
+
+    // RGBA 8bit の画素（行間の余白なし）の圧縮・展開。
+    // Decompress は壊れたデータなら false
+    static std::vector<uint8_t> Compress(const uint8_t* pixels, int width, int height);
+    static bool Decompress(const uint8_t* data, size_t size, int width, int height,
+                           std::vector<uint8_t>& pixels);
+
+private:
+    struct DiskEntry {
+        uint64_t bytes = 0;         // ファイルサイズ
+        uint64_t rawBytes = 0;
+    };
+
+    using MemoryList = std::list<ThumbnailPtr>;
+
+    static uint64_t EntryBytes(const Thumbnail& thumbnail);
+    std::string FilePath(uint32_t itemId) const;
+
+    // 以下は m_mutex を保持した状態で呼ぶ
+    void PutMemoryLocked(const ThumbnailPtr& thumbnail);
+    void EraseMemoryLocked(uint32_t itemId);
+    void TrimMemoryLocked();
+    bool WriteLocked(const Thumbnail& thumbnail);
+    bool WriteHeaderLocked(const Thumbnail& thumbnail);
+    ThumbnailPtr LoadLocked(uint32_t itemId);
+
+    mutable WinMutex m_mutex;
+    std::string m_directory;
+    uint64_t m_maxMemoryBytes;
+
+    MemoryList m_memory;    // 先頭が最近使ったもの
+    std::unordered_map<uint32_t, MemoryList::iterator> m_memoryIndex;
+    std::unordered_map<uint32_t, DiskEntry> m_disk;
+    Stats m_stats;
+};
+
+} // namespace PyAE
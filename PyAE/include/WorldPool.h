@@ -0,0 +1,100 @@
+// WorldPool.h
+// PyAE - Python for After Effects
+// AEGP World の再利用プール
+//
+// World.create で確保したワールドを (type, width, height) ごとに保持し、
+// 同じ形状の次の確保で再利用する。プール内の合計バイト数が上限を
+// 超えた場合は最も長く使われていないものから破棄する（LRU）。
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "AE_GeneralPlug.h"
+
+#include "WinSync.h"
+
+namespace PyAE {
+
+class WorldPool {
+public:
+    struct Stats {
+        uint64_t hits = 0;          // プールから再利用した回数
+        uint64_t misses = 0;        // AEGP_New した回数
+        uint64_t returned = 0;      // プールに戻した回数
+        uint64_t evicted = 0;       // 上限・Trim で破棄した回数
+        size_t pooledWorlds = 0;    // プール内のワールド数
+        size_t pooledBytes = 0;     // プール内の合計バイト数
+        size_t liveWorlds = 0;      // 貸し出し中のワールド数
+        size_t liveBytes = 0;       // 貸し出し中の合計バイト数
+        size_t peakBytes = 0;       // liveBytes + pooledBytes の最大値
+    };
+
+    static WorldPool& Instance() {
+        static WorldPool instance;
+        return instance;
+    }
+
+    // ワールドを取得する（プールに無ければ AEGP_New）。
+    // clear: 再利用したワールドをゼロで埋める（新規確保は常にゼロ）
+    AEGP_WorldH Acquire(AEGP_WorldType type, int width, int height, bool clear = true);
+
+    // ワールドを返却する。無効時・終了処理中・上限超過時は破棄する
+    void Release(AEGP_WorldH worldH);
+
+    // プール内の合計バイト数を maxBytes 以下まで LRU で破棄する
+    void Trim(size_t maxBytes);
+
+    // 上限（バイト）。下げた場合は即座に Trim する
+    void SetMaxBytes(size_t maxBytes);
+    size_t GetMaxBytes() const;
+
+    // 無効にするとプール内のワールドを破棄し、以後は返却時に即破棄する
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+
+    Stats GetStats() const;
+    void ResetStats();
+
+    // プール内のワールドをすべて破棄する（プラグイン終了時）
+    void Shutdown();
+
+private:
+    WorldPool() = default;
+    ~WorldPool() = default;
+
+    WorldPool(const WorldPool&) = delete;
+    WorldPool& operator=(const WorldPool&) = delete;
+
+    using Key = std::tuple<int, int, int>;  // (type, width, height)
+
+    struct Entry {
+        AEGP_WorldH worldH;
+        Key key;
+        size_t bytes;
+    };
+
+    using LruList = std::list<Entry>;
+
+    // m_mutex を保持した状態で呼ぶ
+    void TrimLocked(size_t maxBytes, std::vector<AEGP_WorldH>& disposed);
+
+    static void Dispose(AEGP_WorldH worldH);
+    static size_t WorldBytes(AEGP_WorldH worldH, int height);
+    static void ClearWorld(AEGP_WorldH worldH, AEGP_WorldType type, int height);
+
+    mutable WinMutex m_mutex;
+    LruList m_lru;                                  // 先頭が最近返却されたもの
+    std::map<Key, std::vector<LruList::iterator>> m_free;
+    std::map<AEGP_WorldH, size_t> m_live;           // 貸し出し中のワールドとサイズ
+    size_t m_maxBytes = 256u * 1024u * 1024u;
+    bool m_enabled = true;
+    Stats m_stats;
+};
+
+} // namespace PyAE
@@ -6,6 +6,7 @@
 # It wraps existing export_scene.py and import_scene.py functionality.
 
 import ae
+import json
 import struct
 
 # Import existing export functions
@@ -59,6 +60,15 @@ class SerializationContext:
         return id
 
 
+# =============================================================================
+# Native Serializer
+# =============================================================================
+
+def _native_serializer():
+    """Return ae.serialize if the native C++ serializer is available."""
+    return getattr(ae, "serialize", None)
+
+
 # =============================================================================
 # Project Serialization
 # =============================================================================
@@ -79,6 +89,10 @@ def project_to_dict(project=None):
     if not project:
         raise RuntimeError("No project open")
 
+    native = _native_serializer()
+    if native is not None:
+        return json.loads(native.project_to_json())
+
     data = {"version": 1, "items": []}
 
     for item in project.items:
@@ -106,15 +120,20 @@ def project_to_dict(project=None):
     return data
 
 
-def project_from_dict(data, context=None):
+def project_from_dict(data, context=None, progress=None):
     """
     Import project from dictionary into current project.
 
     This creates new items in the current project based on the data.
+    When the native importer is available and the context has no
+    pre-registered items, the whole import runs in C++ (one undo group,
+    batched keyframes).
 
     Args:
         data: Project dictionary (from project_to_dict())
         context: SerializationContext (optional, created if None)
+        progress: Callable(phase, done, total) (optional, native import only;
+                  called after each comp, footage item and layer)
 
     Returns:
         SerializationContext: Context with ID mappings
@@ -126,6 +145,15 @@ def project_from_dict(data, context=None):
     if not context.project:
         raise RuntimeError("No project open")
 
+    native = _native_serializer()
+    if native is not None and len(context.id_to_item) <= 1:
+        try:
+            for json_id, item in native.project_from_dict(data, progress).items():
+                context.register(json_id, item)
+        finally:
+            ae.refresh()
+        return context
+
     items = data.get("items", [])
 
     ae.begin_undo_group("Import from dictionary")
@@ -150,22 +178,42 @@ def project_from_dict(data, context=None):
     return context
 
 
-def project_update_from_dict(project, data, context=None):
+def project_update_from_dict(project, data, context=None, base=None, since=None):
     """
     Update existing project from dictionary.
 
     This updates existing items in the project based on matching IDs or names.
+    When the native diff engine is available, the project is compared with
+    data and only the differences are applied (items and layers missing from
+    the project are created; nothing is removed).
 
     Args:
         project: Project object to update
         data: Project dictionary
         context: SerializationContext (optional)
+        base: Earlier project_to_dict() of this project (optional, native only)
+        since: Renderer.get_current_timestamp() taken when base was captured.
+               Comps unchanged since then reuse base instead of being re-read.
+
+    Returns:
+        dict: Patch statistics from ae.serialize.apply_patch (native only)
     """
     if context is None:
         context = SerializationContext()
 
     context.project = project
 
+    native = _native_serializer()
+    if native is not None and hasattr(native, "apply_patch"):
+        try:
+            patch = native.diff_live(data, base, since)
+            stats = native.apply_patch(patch)
+        finally:
+            ae.refresh()
+        for item in project.items:
+            context.register(item.id, item)
+        return stats
+
     # Build ID mapping from existing items
     for item in project.items:
         context.register(item.id, item)
@@ -188,6 +236,42 @@ def project_update_from_dict(project, data, context=None):
         ae.refresh()
 
 
+# =============================================================================
+# Binary Snapshot
+# =============================================================================
+
+def project_to_snapshot(path, project=None):
+    """
+    Export project to a binary snapshot file (ae.snapshot format).
+
+    The snapshot holds the same data as project_to_dict() in a compact,
+    memory-mappable form. Use ae.snapshot.open() to inspect it lazily.
+
+    Args:
+        path: Output file path
+        project: Project object (optional, uses current project if None)
+    """
+    native = _native_serializer()
+    if native is not None and project is None:
+        native.project_to_snapshot(path)
+    else:
+        ae.snapshot.dump(project_to_dict(project), path)
+
+
+def project_from_snapshot(path, context=None):
+    """
+    Import project from a binary snapshot file into current project.
+
+    Args:
+        path: Snapshot file path (from project_to_snapshot())
+        context: SerializationContext (optional, created if None)
+
+    Returns:
+        SerializationContext: Context with ID mappings
+    """
+    return project_from_dict(ae.snapshot.load(path), context)
+
+
 # =============================================================================
 # Comp Serialization
 # =============================================================================
@@ -202,6 +286,9 @@ def comp_to_dict(comp):
     Returns:
         dict: Composition data including layers
     """
+    native = _native_serializer()
+    if native is not None:
+        return json.loads(native.comp_to_json(comp))
     return _export_comp(comp)
 
 
@@ -335,6 +422,9 @@ def layer_to_dict(layer, comp=None):
     Returns:
         dict: Layer data including properties and effects
     """
+    native = _native_serializer()
+    if native is not None:
+        return json.loads(native.layer_to_json(layer))
     return _export_layer(layer, comp)
 
 
@@ -390,6 +480,11 @@ def layer_from_dict(comp, data, context=None):
         source_item = context.resolve(source_item_id) if source_item_id else None
         if source_item:
             layer = comp.add_layer(source_item, duration)
+        elif "solid_color" in data:
+            # Recreate a missing solid source from the layer's own data
+            width = data.get("width", comp.width)
+            height = data.get("height", comp.height)
+            layer = comp.add_solid(layer_name, width, height, data["solid_color"], duration)
         else:
             # Fallback to null layer
             layer = comp.add_null(layer_name, duration)
@@ -0,0 +1,69 @@
+# benchmark_snapshot.py
+# 現在のプロジェクトで JSON とバイナリスナップショットの
+# 書き出し・読み込み速度とサイズを比較するスクリプト
+
+import json
+import os
+import tempfile
+import time
+
+import ae
+
+
+def _measure(func, repeat):
+    """func を repeat 回実行し、平均秒数と最後の戻り値を返す"""
+    result = None
+    start = time.perf_counter()
+    for _ in range(repeat):
+        result = func()
+    return (time.perf_counter() - start) / repeat, result
+
+
+def benchmark_snapshot(repeat=3):
+    """プロジェクト全体を JSON / スナップショットで書き出して比較"""
+    print("=" * 80)
+    print("スナップショット ベンチマーク")
+    print("=" * 80)
+
+    tmp_dir = tempfile.mkdtemp()
+    json_path = os.path.join(tmp_dir, "project.json")
+    snap_path = os.path.join(tmp_dir, "project.aesnap")
+
+    try:
+        json_export, _ = _measure(
+            lambda: ae.serialize.project_to_json(json_path), repeat)
+        snap_export, _ = _measure(
+            lambda: ae.serialize.project_to_snapshot(snap_path), repeat)
+
+        def load_json():
+            with open(json_path, "r", encoding="utf-8") as f:
+                return json.load(f)
+
+        json_import, json_data = _measure(load_json, repeat)
+        snap_import, snap_data = _measure(lambda: ae.snapshot.load(snap_path), repeat)
+
+        def list_items():
+            with ae.snapshot.open(snap_path) as snap:
+                return snap.list_items()
+
+        lazy_items, items = _measure(list_items, repeat)
+
+        json_size = os.path.getsize(json_path)
+        snap_size = os.path.getsize(snap_path)
+
+        print(f"\nアイテム数: {len(items)}")
+        print(f"{'':12}{'サイズ(bytes)':>16}{'書き出し(ms)':>16}{'読み込み(ms)':>16}")
+        print(f"{'JSON':12}{json_size:>16}{json_export * 1000:>16.2f}{json_import * 1000:>16.2f}")
+        print(f"{'Snapshot':12}{snap_size:>16}{snap_export * 1000:>16.2f}{snap_import * 1000:>16.2f}")
+        print(f"\nサイズ比: {snap_size / max(json_size, 1):.2%}")
+        print(f"アイテム一覧のみ (open + list_items): {lazy_items * 1000:.2f} ms")
+        print(f"内容一致: {json_data == snap_data}")
+    finally:
+        for path in (json_path, snap_path):
+            if os.path.exists(path):
+                os.remove(path)
+        os.rmdir(tmp_dir)
+
+
+if __name__ == "__main__":
+    benchmark_snapshot()
@@ -0,0 +1,70 @@
+# benchmark_world_pool.py
+# フレームごとに作業用 World を確保・破棄するループで、
+# WorldPool の有無によるフレームあたりの確保コストとピークメモリを比較するスクリプト
+
+import time
+
+import ae
+
+FRAMES = 1000
+WIDTH = 1920
+HEIGHT = 1080
+SCRATCH_PER_FRAME = 2
+
+
+def _run(pooled, world_type, clear):
+    """FRAMES フレーム分のループを実行し、(確保ms/フレーム, 総ms/フレーム, 統計) を返す"""
+    ae.WorldPool.set_enabled(pooled)
+    ae.WorldPool.trim()
+    ae.WorldPool.reset_stats()
+    peak_ae_bytes = ae.get_memory_stats().total_size
+
+    alloc_time = 0.0
+    start = time.perf_counter()
+    for frame in range(FRAMES):
+        t0 = time.perf_counter()
+        scratch = [ae.World.create(world_type, WIDTH, HEIGHT, clear=clear)
+                   for _ in range(SCRATCH_PER_FRAME)]
+        alloc_time += time.perf_counter() - t0
+
+        # 1フレーム分の処理の代わり
+        scratch[0].fill((frame / FRAMES, 0.0, 0.0, 1.0))
+        scratch[1].copy_region(scratch[0], 0, 0, WIDTH, HEIGHT)
+        del scratch
+
+        if frame % 100 == 0:
+            peak_ae_bytes = max(peak_ae_bytes, ae.get_memory_stats().total_size)
+
+    total = time.perf_counter() - start
+    stats = ae.WorldPool.stats()
+    stats["peak_ae_bytes"] = peak_ae_bytes
+    return alloc_time * 1000 / FRAMES, total * 1000 / FRAMES, stats
+
+
+def benchmark_world_pool():
+    """プール無効 / 有効（clear あり・なし）で同じループを比較"""
+    print("=" * 80)
+    print(f"WorldPool ベンチマーク: {FRAMES} フレーム, {WIDTH}x{HEIGHT}, "
+          f"フレームあたり {SCRATCH_PER_FRAME} 枚")
+    print("=" * 80)
+
+    saved_enabled = ae.WorldPool.enabled()
+    try:
+        for world_type in (ae.WorldType.BIT8, ae.WorldType.BIT32):
+            print(f"\n{world_type}")
+            print(f"{'':20}{'確保(ms/f)':>12}{'合計(ms/f)':>12}{'AEGP_New':>10}"
+                  f"{'再利用':>8}{'ピーク(MB)':>12}{'AEメモリ(MB)':>14}")
+            for label, pooled, clear in (("プールなし", False, True),
+                                         ("プール", True, True),
+                                         ("プール clear=False", True, False)):
+                alloc_ms, total_ms, stats = _run(pooled, world_type, clear)
+                print(f"{label:20}{alloc_ms:>12.3f}{total_ms:>12.3f}{stats['misses']:>10}"
+                      f"{stats['hits']:>8}{stats['peak_bytes'] / 2**20:>12.1f}"
+                      f"{stats['peak_ae_bytes'] / 2**20:>14.1f}")
+    finally:
+        ae.WorldPool.set_enabled(saved_enabled)
+        ae.WorldPool.trim()
+
+
+if __name__ == "__main__":
+    benchmark_world_pool()
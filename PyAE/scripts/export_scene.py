@@ -223,7 +223,8 @@ def _export_text_animator(animator):
                             try:
                                 if prop.can_have_expression and prop.has_expression:
                                     prop_data["expression"] = prop.expression
-                                    prop_data["expression_enabled"] = prop.expression_enabled
+                                    # has_expression は有効なエクスプレッションのみ True
+                                    prop_data["expression_enabled"] = True
                             except:
                                 pass
                             animator_data["properties"][prop.name] = prop_data
@@ -619,7 +620,8 @@ def export_layer(layer, comp=None):
                                 debug_log(f"  can_have_expression: True")
                                 if source_text_prop.has_expression:
                                     layer_data["source_text_expression"] = source_text_prop.expression
-                                    layer_data["source_text_expression_enabled"] = source_text_prop.expression_enabled
+                                    # has_expression は有効なエクスプレッションのみ True
+                                    layer_data["source_text_expression_enabled"] = True
                                     debug_log(f"  source_text_expression: {source_text_prop.expression[:50]}...")
                             else:
                                 debug_log(f"  can_have_expression: False")
@@ -673,6 +675,14 @@ def export_layer(layer, comp=None):
         except (AttributeError, RuntimeError) as e:
             debug_log(f"  AVレイヤー幅・高さ取得失敗: {e}")
 
+        # ソースが平面なら色も保存（インポート側で平面を再作成するため）
+        try:
+            solid_color = layer.solid_color
+            if solid_color is not None:
+                layer_data["solid_color"] = solid_color
+        except (AttributeError, RuntimeError) as e:
+            debug_log(f"  平面色取得失敗: {e}")
+
     # Dynamic Stream を使ってプロパティを動的に取得
     try:
         root = layer.properties
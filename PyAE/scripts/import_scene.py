@@ -535,11 +535,14 @@ class SceneImporter:
                     # ソースが見つからない場合、JSONからフッテージ情報を取得
                     footage_info = self._get_footage_info(source_item_id)
                     if footage_info and footage_info.get("footage_data", {}).get("footage_type") == "Solid":
-                        # Solidの場合、色情報も取得（将来的な拡張のため）
+                        # Solidの場合、レイヤー側に保存された色を使う
                         width = footage_info.get("footage_data", {}).get("width", comp.width)
                         height = footage_info.get("footage_data", {}).get("height", comp.height)
+                        color = layer_data.get("solid_color", [0.0, 0.0, 0.0])
+                        if len(color) < 3:
+                            color = [0.0, 0.0, 0.0]
                         # 注: このSolidレイヤーも_restore_layer()で親フォルダが修正される
-                        return comp.add_solid(layer_name, width, height, (0.0, 0.0, 0.0), duration)
+                        return comp.add_solid(layer_name, width, height, color, duration)
 
                     log_warning(f"      ソースなし: {layer_name} (id: {source_item_id})")
                     return None
@@ -770,10 +773,10 @@ class SceneImporter:
             sorted_layers_data = sorted(layers_data, key=lambda x: x.get("index", 999))
 
             for i, layer_data in enumerate(sorted_layers_data):
-                if layer_data.get("has_track_matte") and "track_matte_type" in layer_data:
+                if layer_data.get("track_matte"):
                     try:
-                        track_matte_type = layer_data["track_matte_type"]
-                        layers[i].track_matte_type = track_matte_type
+                        track_matte_type = layer_data["track_matte"]
+                        layers[i].track_matte = track_matte_type
                         debug_log(f"      Set track matte for layer {i} ({layer_data.get('name')}) to type {track_matte_type}")
                     except Exception as e:
                         debug_log(f"      Failed to set track matte for layer {i}: {e}")
@@ -2,6 +2,8 @@
 PyAE - Composition Browser Panel
 
 プロジェクト内のコンポジション一覧を表示し、選択・操作できるパネル
+サムネイルは ae.ThumbnailCache がアイドル処理で作り、ディスクに保存したものは
+次回以降すぐに表示される
 
 使い方:
     import ae
@@ -14,7 +16,8 @@ try:
         QListWidget, QPushButton, QLabel,
         QListWidgetItem, QFrame, QSplitter
     )
-    from PySide6.QtCore import Qt
+    from PySide6.QtCore import Qt, QSize
+    from PySide6.QtGui import QIcon, QImage, QPixmap
 except ImportError:
     print("Error: PySide6 is not installed.")
     print("Install with: pip install PySide6")
@@ -23,11 +26,15 @@ except ImportError:
 import ae
 
 
+THUMBNAIL_SIZE = 64
+
+
 class CompBrowserPanel(QWidget):
     """コンポジションブラウザパネル"""
 
     def __init__(self):
         super().__init__()
+        self.thumbnails = ae.ThumbnailCache(size=THUMBNAIL_SIZE)
         self.init_ui()
         self.refresh_compositions()
 
@@ -55,6 +62,7 @@ class CompBrowserPanel(QWidget):
 
         # コンポジションリスト
         self.comp_list = QListWidget()
+        self.comp_list.setIconSize(QSize(THUMBNAIL_SIZE, THUMBNAIL_SIZE))
         self.comp_list.setStyleSheet("""
             QListWidget {
                 background-color: #2d2d2d;
@@ -144,12 +152,34 @@ class CompBrowserPanel(QWidget):
                 item.setData(Qt.UserRole, comp)
                 self.comp_list.addItem(item)
 
+                # 保存済みのサムネイルはすぐ表示し、ないものや古いものは後から差し替える
+                thumb = self.thumbnails.get(comp)
+                if thumb is not None:
+                    item.setIcon(self._thumbnail_icon(thumb))
+                if thumb is None or thumb.stale:
+                    self.thumbnails.request(
+                        [comp], lambda item_id, thumb, item=item: self.on_thumbnail_ready(item, thumb))
+
             self.status_label.setText(f"Found {len(comps)} compositions")
 
         except Exception as e:
             self.status_label.setText(f"Error: {str(e)}")
             ae.log_error(f"CompBrowser error: {e}")
 
+    def _thumbnail_icon(self, thumb):
+        data = thumb.to_bytes()     # QPixmap へ変換し終えるまで保持する
+        image = QImage(data, thumb.width, thumb.height, thumb.width * 4, QImage.Format_RGBA8888)
+        return QIcon(QPixmap.fromImage(image))
+
+    def on_thumbnail_ready(self, item, thumb):
+        """サムネイルができたとき（アイドル処理から呼ばれる）"""
+        if thumb is None:
+            return
+        try:
+            item.setIcon(self._thumbnail_icon(thumb))
+        except RuntimeError:
+            pass    # Refresh でリストから消えた
+
     def on_selection_changed(self):
         """選択変更時"""
         item = self.comp_list.currentItem()
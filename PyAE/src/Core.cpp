@@ -28,9 +28,12 @@
 #include "PanelHandler.h"
 #include "PySidePanelHandler.h"
 #include "ScriptRunner.h"
+#include "ModuleReloader.h"
 #include "Logger.h"
 #include "ErrorHandling.h"
 #include "PySideLoader.h"
+#include "WorldPool.h"
+#include "RenderOptionsPool.h"
 
 #ifdef PYAE_ENABLE_REPL
 #include "REPLServer.h"
@@ -296,6 +299,7 @@ static void PluginShutdown() {
 
     PyAE::PySidePanelHandler::Instance().Shutdown();
     PyAE::PanelHandler::Instance().Shutdown();
+    PyAE::ModuleReloader::Instance().Shutdown();
     PyAE::ScriptRunner::Instance().Shutdown();
     PyAE::MenuHandler::Instance().Shutdown();
     PyAE::IdleHandler::Instance().Shutdown();
@@ -304,6 +308,12 @@ static void PluginShutdown() {
     PyAE::PySideLoader::Instance().UnloadPlugin();
 
     PyAE::PythonHost::Instance().Shutdown();
+
+    // Python 側の World がすべて返却された後でプールを破棄する
+    PyAE::WorldPool::Instance().Shutdown();
+    PyAE::RenderOptionsPool::Instance().Shutdown();
+    PyAE::LayerRenderOptionsPool::Instance().Shutdown();
+
     PyAE::PluginState::Instance().Shutdown();
 
     PYAE_LOG_INFO("Core", "PyAE Core shutdown complete");
@@ -0,0 +1,202 @@
+// DirtyRegion.cpp
+// PyAE - Python for After Effects
+// 差分レンダー用の更新領域の集計
+
+#include "DirtyRegion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace PyAE {
+
+// =============================================================
+// PixelRect
+// =============================================================
+
+bool PixelRect::Contains(const PixelRect& other) const
+{
+    if (other.IsEmpty()) {
+        return true;
+    }
+    return !IsEmpty() && left <= other.left && top <= other.top &&
+           right >= other.right && bottom >= other.bottom;
+}
+
+PixelRect PixelRect::Union(const PixelRect& a, const PixelRect& b)
+{
+    if (a.IsEmpty()) {
+        return b.IsEmpty() ? PixelRect() : b;
+    }
+    if (b.IsEmpty()) {
+        return a;
+    }
+    return PixelRect{(std::min)(a.left, b.left), (std::min)(a.top, b.top),
+                     (std::max)(a.right, b.right), (std::max)(a.bottom, b.bottom)};
+}
+
+PixelRect PixelRect::Intersect(const PixelRect& a, const PixelRect& b)
+{
+    PixelRect r{(std::max)(a.left, b.left), (std::max)(a.top, b.top),
+                (std::min)(a.right, b.right), (std::min)(a.bottom, b.bottom)};
+    return r.IsEmpty() ? PixelRect() : r;
+}
+
+PixelRect PixelRect::Bounds(const double* xs, const double* ys, int count)
+{
+    if (count <= 0) {
+        return PixelRect();
+    }
+    double minX = std::numeric_limits<double>::infinity();
+    double minY = minX;
+    double maxX = -minX;
+    double maxY = -minX;
+    for (int i = 0; i < count; ++i) {
+        if (!std::isfinite(xs[i]) || !std::isfinite(ys[i])) {
+            return PixelRect();
+        }
+        minX = (std::min)(minX, xs[i]);
+        minY = (std::min)(minY, ys[i]);
+        maxX = (std::max)(maxX, xs[i]);
+        maxY = (std::max)(maxY, ys[i]);
+    }
+
+    // int に収まらない範囲はフレームの外なので、切り詰めても結果は変わらない
+    const double limit = static_cast<double>((std::numeric_limits<int>::max)() / 2);
+    auto clamp = [limit](double v) { return (std::max)(-limit, (std::min)(limit, v)); };
+    return PixelRect{static_cast<int>(std::floor(clamp(minX))), static_cast<int>(std::floor(clamp(minY))),
+                     static_cast<int>(std::ceil(clamp(maxX))), static_cast<int>(std::ceil(clamp(maxY)))};
+}
+
+// =============================================================
+// DirtyRegion
+// =============================================================
+
+DirtyRegion::DirtyRegion(int width, int height)
+    : m_width(0)
+    , m_height(0)
+{
+    Resize(width, height);
+}
+
+void DirtyRegion::Resize(int width, int height)
+{
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Frame size must be positive");
+    }
+    m_width = width;
+    m_height = height;
+    m_layers.clear();
+    AddAll();
+}
+
+PixelRect DirtyRegion::Clip(const PixelRect& rect, int padding) const
+{
+    if (rect.IsEmpty()) {
+        return PixelRect();
+    }
+    padding = (std::max)(padding, 0);
+    auto grow = [](int v, int d) {
+        int64_t r = static_cast<int64_t>(v) + d;
+        r = (std::max)(r, static_cast<int64_t>((std::numeric_limits<int>::min)()));
+        r = (std::min)(r, static_cast<int64_t>((std::numeric_limits<int>::max)()));
+        return static_cast<int>(r);
+    };
+    PixelRect padded{grow(rect.left, -padding), grow(rect.top, -padding),
+                     grow(rect.right, padding), grow(rect.bottom, padding)};
+    return PixelRect::Intersect(padded, GetFrame());
+}
+
+void DirtyRegion::Add(const PixelRect& rect, int padding)
+{
+    PixelRect clipped = Clip(rect, padding);
+    if (clipped.IsEmpty()) {
+        return;
+    }
+    for (const auto& existing : m_rects) {
+        if (existing.Contains(clipped)) {
+            return;
+        }
+    }
+    m_rects.push_back(clipped);
+}
+
+void DirtyRegion::AddAll()
+{
+    m_rects.assign(1, GetFrame());
+}
+
+void DirtyRegion::UpdateLayer(uint64_t id, const PixelRect& bounds, int padding)
+{
+    auto it = m_layers.find(id);
+    if (it != m_layers.end()) {
+        Add(it->second, padding);
+        it->second = bounds;
+    } else {
+        m_layers.emplace(id, bounds);
+    }
+    Add(bounds, padding);
+}
+
+void DirtyRegion::TrackLayer(uint64_t id, const PixelRect& bounds)
+{
+    m_layers[id] = bounds;
+}
+
+void DirtyRegion::RemoveLayer(uint64_t id, int padding)
+{
+    auto it = m_layers.find(id);
+    if (it == m_layers.end()) {
+        return;
+    }
+    Add(it->second, padding);
+    m_layers.erase(it);
+}
+
+std::vector<PixelRect> DirtyRegion::Take(size_t maxRects)
+{
+    std::vector<PixelRect> rects;
+    rects.swap(m_rects);
+    maxRects = (std::max)(maxRects, static_cast<size_t>(1));
+
+    // まとめても面積が増えない組（重なりがあれば描く画素はむしろ減る）を先にまとめる
+    bool merged = true;
+    while (merged && rects.size() > 1) {
+        merged = false;
+        for (size_t i = 0; i < rects.size() && !merged; ++i) {
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                PixelRect u = PixelRect::Union(rects[i], rects[j]);
+                if (u.Area() <= rects[i].Area() + rects[j].Area()) {
+                    rects[i] = u;
+                    rects.erase(rects.begin() + static_cast<std::ptrdiff_t>(j));
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // 数を減らす: 面積の増え方が最も小さい組をまとめる
+    while (rects.size() > maxRects) {
+        size_t bestI = 0;
+        size_t bestJ = 1;
+        int64_t bestCost = (std::numeric_limits<int64_t>::max)();
+        for (size_t i = 0; i < rects.size(); ++i) {
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                int64_t cost = PixelRect::Union(rects[i], rects[j]).Area() -
+                               rects[i].Area() - rects[j].Area();
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestI = i;
+                    bestJ = j;
+                }
+            }
+        }
+        rects[bestI] = PixelRect::Union(rects[bestI], rects[bestJ]);
+        rects.erase(rects.begin() + static_cast<std::ptrdiff_t>(bestJ));
+    }
+    return rects;
+}
+
+} // namespace PyAE
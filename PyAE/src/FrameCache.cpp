@@ -0,0 +1,497 @@
+// FrameCache.cpp
+// PyAE - Python for After Effects
+// レンダー結果のフレームキャッシュ（メモリ + ディスク）
+
+#include "FrameCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_set>
+
+#include "StringUtils.h"
+
+namespace PyAE {
+
+namespace {
+
+// ハッシュ・比較・ファイルのヘッダーはキーのバイト列をそのまま使う
+static_assert(sizeof(FrameCache::Key) == 64, "FrameCache::Key must not contain padding");
+
+constexpr char kMagic[8] = {'P', 'Y', 'A', 'E', 'F', 'C', '0', '1'};
+constexpr const char* kExtension = ".pyaefc";
+
+struct FileHeader {
+    char magic[8];
+    FrameCache::Key key;
+    int32_t stamp[4];
+    int32_t width;
+    int32_t height;
+    uint32_t depth;
+    uint32_t layout;
+    uint64_t pixelBytes;
+};
+
+std::filesystem::path ToPath(const std::string& utf8)
+{
+    return std::filesystem::path(StringUtils::Utf8ToWide(utf8));
+}
+
+// src を行間の余白なしでコピーし、entry.view をそこへ向ける
+void PackInto(FrameCache::Entry& entry, const PixelConvert::ImageView& src)
+{
+    const bool planar = src.layout == PixelConvert::Layout::Planar;
+    const int planes = planar ? 4 : 1;
+    const size_t rowCopy = static_cast<size_t>(src.width) * (planar ? 1 : 4) *
+        PixelConvert::ChannelBytes(src.depth);
+    const size_t planeCopy = rowCopy * static_cast<size_t>(src.height);
+
+    entry.pixels.resize(planeCopy * static_cast<size_t>(planes));
+    for (int p = 0; p < planes; ++p) {
+        const uint8_t* in = static_cast<const uint8_t*>(src.data) + p * src.planeBytes;
+        uint8_t* out = entry.pixels.data() + p * planeCopy;
+        for (int y = 0; y < src.height; ++y) {
+            std::memcpy(out + static_cast<size_t>(y) * rowCopy, in + y * src.rowBytes, rowCopy);
+        }
+    }
+
+    entry.view = src;
+    entry.view.data = entry.pixels.data();
+    entry.view.rowBytes = static_cast<ptrdiff_t>(rowCopy);
+    entry.view.planeBytes = planar ? static_cast<ptrdiff_t>(planeCopy) : 0;
+}
+
+} // namespace
+
+bool FrameCache::Key::operator==(const Key& other) const
+{
+    return std::memcmp(this, &other, sizeof(Key)) == 0;
+}
+
+FrameCache::FrameCache(uint64_t maxMemoryBytes, const std::string& directory, uint64_t maxDiskBytes)
+    : m_directory(directory), m_maxMemoryBytes(maxMemoryBytes), m_maxDiskBytes(maxDiskBytes)
+{
+    if (m_directory.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::path dir = ToPath(m_directory);
+    std::filesystem::create_directories(dir, ec);
+    if (!std::filesystem::is_directory(dir, ec)) {
+        throw std::runtime_error("Cannot create cache directory: " + m_directory);
+    }
+
+    // 前のセッションのファイルはタイムスタンプで検証できないので、
+    // インスタンスごとの新しいサブディレクトリにだけ書く（他のファイルには触れない）
+    std::random_device random;
+    for (int attempt = 0; attempt < 16; ++attempt) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "pyaefc-%08x%08x",
+                      static_cast<unsigned>(random()), static_cast<unsigned>(random()));
+        std::string path = m_directory;
+        if (path.back() != '/' && path.back() != '\\') {
+            path += '/';
+        }
+        path += name;
+        if (std::filesystem::create_directory(ToPath(path), ec)) {
+            m_sessionDirectory = path;
+            return;
+        }
+    }
+    throw std::runtime_error("Cannot create cache directory in: " + m_directory);
+}
+
+FrameCache::~FrameCache()
+{
+    if (!m_sessionDirectory.empty()) {
+        std::error_code ec;
+        std::filesystem::remove_all(ToPath(m_sessionDirectory), ec);
+    }
+}
+
+uint64_t FrameCache::Hash(const Key& key)
+{
+    uint64_t hash = 14695981039346656037ull;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&key);
+    for (size_t i = 0; i < sizeof(Key); ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t FrameCache::EntryBytes(const Entry& entry)
+{
+    return static_cast<uint64_t>(entry.pixels.size()) + sizeof(Entry);
+}
+
+std::string FrameCache::FilePath(uint64_t hash, uint64_t id) const
+{
+    // 書き直すたびに名前を変え、ロックの外で読み書き中のファイルと重ならないようにする
+    char name[48];
+    std::snprintf(name, sizeof(name), "%016llx-%llx", static_cast<unsigned long long>(hash),
+                  static_cast<unsigned long long>(id));
+    return m_sessionDirectory + '/' + name + kExtension;
+}
+
+FrameCache::EntryPtr FrameCache::Find(const Key& key, const Validator& validate)
+{
+    const uint64_t hash = Hash(key);
+    EntryPtr entry;
+    bool fromDisk = false;
+    uint64_t fileId = 0;
+    {
+        WinLockGuard lock(m_mutex);
+        auto it = m_memoryIndex.find(hash);
+        if (it != m_memoryIndex.end() && (*it->second)->key == key) {
+            m_memory.splice(m_memory.begin(), m_memory, it->second);
+            entry = *it->second;
+        } else {
+            auto disk = m_diskIndex.find(hash);
+            if (disk != m_diskIndex.end() && disk->second.first.key == key) {
+                m_disk.splice(m_disk.begin(), m_disk, disk->second.second);
+                // 書き込み中ならまだ手元にある画素を返す
+                entry = disk->second.first.writing;
+                fileId = entry ? 0 : disk->second.first.id;
+                fromDisk = true;
+            }
+        }
+        if (!entry && fileId == 0) {
+            m_stats.misses++;
+            return nullptr;
+        }
+    }
+
+    if (!entry) {
+        // 読み込みはロックの外で行う
+        entry = ReadFile(FilePath(hash, fileId), key);
+
+        std::vector<Spill> spills;
+        {
+            WinLockGuard lock(m_mutex);
+            auto disk = m_diskIndex.find(hash);
+            const bool current = disk != m_diskIndex.end() && disk->second.first.id == fileId;
+            if (!entry) {
+                m_stats.diskErrors++;
+                m_stats.misses++;
+                if (current) {
+                    EraseDiskLocked(hash);
+                }
+                return nullptr;
+            }
+            // 読んでいる間に同じキーが入れ直されていなければメモリへ戻す
+            if (current && m_memoryIndex.find(hash) == m_memoryIndex.end() &&
+                EntryBytes(*entry) <= m_maxMemoryBytes) {
+                m_memory.push_front(entry);
+                m_memoryIndex[hash] = m_memory.begin();
+                m_stats.memoryBytes += EntryBytes(*entry);
+                TrimMemoryLocked(spills);
+            }
+        }
+        WriteSpills(spills);
+    }
+
+    // 検証は AE の API を呼ぶのでロックの外で行う
+    if (validate && !validate(*entry)) {
+        WinLockGuard lock(m_mutex);
+        m_stats.stale++;
+        m_stats.misses++;
+        // 検証中に置き換えられていなければ捨てる
+        auto it = m_memoryIndex.find(hash);
+        if (it == m_memoryIndex.end() || *it->second == entry) {
+            EraseMemoryLocked(hash);
+            EraseDiskLocked(hash);
+        }
+        return nullptr;
+    }
+
+    WinLockGuard lock(m_mutex);
+    if (fromDisk) {
+        m_stats.diskHits++;
+    } else {
+        m_stats.hits++;
+    }
+    return entry;
+}
+
+FrameCache::EntryPtr FrameCache::Insert(const Key& key, const Stamp& stamp,
+                                        const PixelConvert::ImageView& src)
+{
+    if (!src.data || src.width <= 0 || src.height <= 0) {
+        throw std::invalid_argument("Cannot cache an empty frame");
+    }
+
+    // コピーはロックの外で行う
+    auto entry = std::make_shared<Entry>();
+    entry->key = key;
+    entry->stamp = stamp;
+    PackInto(*entry, src);
+    EntryPtr shared = entry;
+
+    const uint64_t hash = Hash(key);
+    std::vector<Spill> spills;
+    EntryPtr result;
+    {
+        WinLockGuard lock(m_mutex);
+        m_stats.inserts++;
+        EraseMemoryLocked(hash);
+        EraseDiskLocked(hash);
+        if (EntryBytes(*shared) > m_maxMemoryBytes) {
+            // メモリに置けない大きさならディスクにだけ置く
+            SpillLocked(shared, spills);
+        } else {
+            m_memory.push_front(shared);
+            m_memoryIndex[hash] = m_memory.begin();
+            m_stats.memoryBytes += EntryBytes(*shared);
+            TrimMemoryLocked(spills);
+            result = shared;
+        }
+    }
+    WriteSpills(spills);
+    return result;
+}
+
+size_t FrameCache::Invalidate(uint64_t item)
+{
+    WinLockGuard lock(m_mutex);
+    std::unordered_set<uint64_t> hashes;
+    for (const auto& pair : m_memoryIndex) {
+        if (item == 0 || (*pair.second)->key.item == item) {
+            hashes.insert(pair.first);
+        }
+    }
+    for (const auto& pair : m_diskIndex) {
+        if (item == 0 || pair.second.first.key.item == item) {
+            hashes.insert(pair.first);
+        }
+    }
+    for (uint64_t hash : hashes) {
+        EraseMemoryLocked(hash);
+        EraseDiskLocked(hash);
+    }
+    return hashes.size();
+}
+
+void FrameCache::Clear()
+{
+    Invalidate(0);
+}
+
+void FrameCache::SetLimits(uint64_t maxMemoryBytes, uint64_t maxDiskBytes)
+{
+    std::vector<Spill> spills;
+    {
+        WinLockGuard lock(m_mutex);
+        m_maxMemoryBytes = maxMemoryBytes;
+        m_maxDiskBytes = maxDiskBytes;
+        TrimMemoryLocked(spills);
+        TrimDiskLocked();
+    }
+    WriteSpills(spills);
+}
+
+FrameCache::Stats FrameCache::GetStats() const
+{
+    WinLockGuard lock(m_mutex);
+    Stats stats = m_stats;
+    stats.memoryEntries = m_memory.size();
+    stats.diskEntries = m_disk.size();
+    stats.maxMemoryBytes = m_maxMemoryBytes;
+    stats.maxDiskBytes = m_maxDiskBytes;
+    return stats;
+}
+
+void FrameCache::EraseMemoryLocked(uint64_t hash)
+{
+    auto it = m_memoryIndex.find(hash);
+    if (it == m_memoryIndex.end()) {
+        return;
+    }
+    m_stats.memoryBytes -= EntryBytes(**it->second);
+    m_memory.erase(it->second);
+    m_memoryIndex.erase(it);
+}
+
+void FrameCache::EraseDiskLocked(uint64_t hash)
+{
+    auto it = m_diskIndex.find(hash);
+    if (it == m_diskIndex.end()) {
+        return;
+    }
+    // 書き込み中のファイルは書き終えた側が消す
+    if (!it->second.first.writing) {
+        std::error_code ec;
+        std::filesystem::remove(ToPath(FilePath(hash, it->second.first.id)), ec);
+    }
+    m_stats.diskBytes -= it->second.first.bytes;
+    m_disk.erase(it->second.second);
+    m_diskIndex.erase(it);
+}
+
+void FrameCache::TrimMemoryLocked(std::vector<Spill>& spills)
+{
+    while (m_stats.memoryBytes > m_maxMemoryBytes && !m_memory.empty()) {
+        EntryPtr victim = m_memory.back();
+        SpillLocked(victim, spills);
+        EraseMemoryLocked(Hash(victim->key));
+        m_stats.evictions++;
+    }
+}
+
+void FrameCache::TrimDiskLocked()
+{
+    while (m_stats.diskBytes > m_maxDiskBytes && !m_disk.empty()) {
+        EraseDiskLocked(m_disk.back());
+        m_stats.diskEvictions++;
+    }
+}
+
+void FrameCache::SpillLocked(const EntryPtr& entry, std::vector<Spill>& spills)
+{
+    if (m_sessionDirectory.empty()) {
+        return;
+    }
+    const uint64_t hash = Hash(entry->key);
+    auto existing = m_diskIndex.find(hash);
+    if (existing != m_diskIndex.end()) {
+        if (existing->second.first.key == entry->key) {
+            // ディスクから読み戻したエントリーは書き直さない
+            m_disk.splice(m_disk.begin(), m_disk, existing->second.second);
+            return;
+        }
+        EraseDiskLocked(hash);
+    }
+
+    const uint64_t bytes = sizeof(FileHeader) + entry->pixels.size();
+    if (bytes > m_maxDiskBytes) {
+        return;
+    }
+
+    // 容量だけ先に確保し、ファイルはロックの外で書く（WriteSpills）
+    m_disk.push_front(hash);
+    DiskEntry diskEntry;
+    diskEntry.key = entry->key;
+    diskEntry.bytes = bytes;
+    diskEntry.id = ++m_nextFileId;
+    diskEntry.writing = entry;
+    m_diskIndex[hash] = std::make_pair(diskEntry, m_disk.begin());
+    m_stats.diskBytes += bytes;
+    spills.push_back(Spill{hash, diskEntry.id, entry});
+    TrimDiskLocked();
+}
+
+void FrameCache::WriteSpills(const std::vector<Spill>& spills)
+{
+    for (const Spill& spill : spills) {
+        const std::string path = FilePath(spill.hash, spill.id);
+        {
+            // 書く前に追い出されていれば書かない
+            WinLockGuard lock(m_mutex);
+            auto disk = m_diskIndex.find(spill.hash);
+            if (disk == m_diskIndex.end() || disk->second.first.id != spill.id) {
+                continue;
+            }
+        }
+
+        const bool written = WriteFile(path, *spill.entry);
+
+        bool stale = false;
+        {
+            WinLockGuard lock(m_mutex);
+            auto disk = m_diskIndex.find(spill.hash);
+            if (disk != m_diskIndex.end() && disk->second.first.id == spill.id) {
+                disk->second.first.writing.reset();
+                if (written) {
+                    m_stats.diskWrites++;
+                } else {
+                    m_stats.diskErrors++;
+                    EraseDiskLocked(spill.hash);
+                }
+            } else {
+                // 書いている間に追い出された・置き換えられた
+                stale = written;
+            }
+        }
+        if (stale) {
+            std::error_code ec;
+            std::filesystem::remove(ToPath(path), ec);
+        }
+    }
+}
+
+bool FrameCache::WriteFile(const std::string& path, const Entry& entry)
+{
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.key = entry.key;
+    for (int i = 0; i < 4; ++i) {
+        header.stamp[i] = entry.stamp[i];
+    }
+    header.width = entry.view.width;
+    header.height = entry.view.height;
+    header.depth = static_cast<uint32_t>(entry.view.depth);
+    header.layout = static_cast<uint32_t>(entry.view.layout);
+    header.pixelBytes = entry.pixels.size();
+
+    std::ofstream file(ToPath(path), std::ios::binary | std::ios::trunc);
+    if (file) {
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(entry.pixels.data()),
+                   static_cast<std::streamsize>(entry.pixels.size()));
+        file.close();
+    }
+    if (!file) {
+        std::error_code ec;
+        std::filesystem::remove(ToPath(path), ec);
+        return false;
+    }
+    return true;
+}
+
+FrameCache::EntryPtr FrameCache::ReadFile(const std::string& path, const Key& key)
+{
+    std::ifstream file(ToPath(path), std::ios::binary);
+    FileHeader header{};
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return nullptr;
+    }
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.key != key ||
+        header.width <= 0 || header.height <= 0 ||
+        header.depth > static_cast<uint32_t>(PixelConvert::Depth::F32) ||
+        header.layout > static_cast<uint32_t>(PixelConvert::Layout::Planar)) {
+        return nullptr;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->key = key;
+    for (int i = 0; i < 4; ++i) {
+        entry->stamp[i] = header.stamp[i];
+    }
+    entry->view.width = header.width;
+    entry->view.height = header.height;
+    entry->view.depth = static_cast<PixelConvert::Depth>(header.depth);
+    entry->view.layout = static_cast<PixelConvert::Layout>(header.layout);
+
+    const bool planar = entry->view.layout == PixelConvert::Layout::Planar;
+    const uint64_t rowBytes = static_cast<uint64_t>(header.width) * (planar ? 1 : 4) *
+        PixelConvert::ChannelBytes(entry->view.depth);
+    if (header.pixelBytes != rowBytes * static_cast<uint64_t>(header.height) * (planar ? 4 : 1)) {
+        return nullptr;
+    }
+    entry->pixels.resize(static_cast<size_t>(header.pixelBytes));
+    if (!file.read(reinterpret_cast<char*>(entry->pixels.data()),
+                   static_cast<std::streamsize>(header.pixelBytes))) {
+        return nullptr;
+    }
+    entry->view.data = entry->pixels.data();
+    entry->view.rowBytes = static_cast<ptrdiff_t>(rowBytes);
+    entry->view.planeBytes = planar ? static_cast<ptrdiff_t>(rowBytes * header.height) : 0;
+    return entry;
+}
+
+} // namespace PyAE
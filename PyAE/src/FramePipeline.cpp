@@ -0,0 +1,387 @@
+// FramePipeline.cpp
+// PyAE - Python for After Effects
+// レンダー結果のフレーム列をワーカースレッドのコンシューマーへ渡す
+
+#include "FramePipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+
+#include "FrameWriter.h"
+
+namespace PyAE {
+
+namespace {
+
+double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+FramePipeline::FramePipeline(std::vector<std::shared_ptr<Consumer>> consumers, int maxInFlight)
+    : m_maxInFlight(maxInFlight)
+{
+    if (maxInFlight < 1) {
+        throw std::invalid_argument("max_in_flight must be at least 1");
+    }
+    for (auto& consumer : consumers) {
+        if (!consumer) {
+            throw std::invalid_argument("Consumer is null");
+        }
+        auto worker = std::make_unique<Worker>();
+        worker->stats.name = consumer->GetName();
+        worker->consumer = std::move(consumer);
+        m_workers.push_back(std::move(worker));
+    }
+    m_stats.consumers.resize(m_workers.size());
+    for (auto& worker : m_workers) {
+        Worker* w = worker.get();
+        w->thread = std::thread([this, w]() { WorkerLoop(*w); });
+    }
+}
+
+FramePipeline::~FramePipeline()
+{
+    Close();
+}
+
+void FramePipeline::Submit(int64_t number, double time, const PixelConvert::ImageView& src)
+{
+    if (!src.data || src.width <= 0 || src.height <= 0) {
+        throw std::invalid_argument("Cannot submit an empty frame");
+    }
+
+    Slot* slot = nullptr;
+    {
+        TaskQueueLock lock(m_cs);
+        if (m_closing) {
+            throw std::runtime_error("FramePipeline is closed");
+        }
+        int index = m_nextIndex++;
+        m_stats.submitted++;
+        if (m_workers.empty()) {
+            return;
+        }
+
+        auto waitStart = std::chrono::steady_clock::now();
+        while (!m_closing && m_freeSlots.empty() &&
+               m_slots.size() >= static_cast<size_t>(m_maxInFlight)) {
+            m_cs.wait();
+        }
+        m_stats.waitSeconds += SecondsSince(waitStart);
+        if (m_closing) {
+            throw std::runtime_error("FramePipeline is closed");
+        }
+
+        if (m_freeSlots.empty()) {
+            m_slots.push_back(std::make_unique<Slot>());
+            slot = m_slots.back().get();
+        } else {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        slot->frame.index = index;
+        m_stats.inFlight++;
+        m_stats.peakInFlight = (std::max)(m_stats.peakInFlight, m_stats.inFlight);
+    }
+
+    // コピー（バッファの確保）が例外で抜けたらスロットと in-flight を戻す
+    struct SlotGuard {
+        FramePipeline* pipeline;
+        Slot* slot;
+        ~SlotGuard()
+        {
+            if (!slot) {
+                return;
+            }
+            {
+                TaskQueueLock lock(pipeline->m_cs);
+                pipeline->m_freeSlots.push_back(slot);
+                pipeline->m_stats.inFlight--;
+            }
+            pipeline->m_cs.notify_all();
+        }
+    } guard{this, slot};
+
+    // コピーはロックの外で行う（スロットはまだどのワーカーにも渡していない）
+    auto copyStart = std::chrono::steady_clock::now();
+    Frame& frame = slot->frame;
+    frame.number = number;
+    frame.time = time;
+    frame.view = src;
+    frame.view.rowBytes = static_cast<ptrdiff_t>(src.width) * 4 *
+        static_cast<ptrdiff_t>(PixelConvert::ChannelBytes(src.depth));
+    frame.view.planeBytes = 0;
+    if (src.layout == PixelConvert::Layout::Planar) {
+        frame.view.planeBytes = frame.view.rowBytes / 4 * src.height;
+        frame.view.rowBytes /= 4;
+    }
+    const size_t rowCopy = static_cast<size_t>(frame.view.rowBytes);
+    const int planes = src.layout == PixelConvert::Layout::Planar ? 4 : 1;
+    const size_t bytes = rowCopy * static_cast<size_t>(src.height) * static_cast<size_t>(planes);
+    if (frame.pixels.size() != bytes) {
+        frame.pixels.resize(bytes);
+    }
+    for (int p = 0; p < planes; ++p) {
+        const uint8_t* in = static_cast<const uint8_t*>(src.data) + p * src.planeBytes;
+        uint8_t* out = frame.pixels.data() + p * frame.view.planeBytes;
+        for (int y = 0; y < src.height; ++y) {
+            std::memcpy(out + static_cast<size_t>(y) * rowCopy, in + y * src.rowBytes, rowCopy);
+        }
+    }
+    frame.view.data = frame.pixels.data();
+    double copySeconds = SecondsSince(copyStart);
+
+    {
+        TaskQueueLock lock(m_cs);
+        m_stats.copySeconds += copySeconds;
+        slot->refs = m_workers.size();
+        for (auto& worker : m_workers) {
+            worker->queue.push_back(slot);
+        }
+        guard.slot = nullptr;
+    }
+    m_cs.notify_all();
+}
+
+void FramePipeline::Close()
+{
+    {
+        TaskQueueLock lock(m_cs);
+        if (m_closing) {
+            return;
+        }
+        m_closing = true;
+    }
+    m_cs.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    TaskQueueLock lock(m_cs);
+    m_closed = true;
+}
+
+bool FramePipeline::IsClosed() const
+{
+    TaskQueueLock lock(m_cs);
+    return m_closed;
+}
+
+FramePipeline::Stats FramePipeline::GetStats() const
+{
+    TaskQueueLock lock(m_cs);
+    Stats stats = m_stats;
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        stats.consumers[i] = m_workers[i]->stats;
+    }
+    return stats;
+}
+
+void FramePipeline::WorkerLoop(Worker& worker)
+{
+    for (;;) {
+        Slot* slot = nullptr;
+        bool skip = false;
+        {
+            TaskQueueLock lock(m_cs);
+            while (worker.queue.empty() && !m_closing) {
+                m_cs.wait();
+            }
+            // 終了時も渡し済みのフレームは処理する
+            if (worker.queue.empty()) {
+                break;
+            }
+            slot = worker.queue.front();
+            worker.queue.pop_front();
+            skip = worker.failed;
+        }
+
+        std::string error;
+        auto start = std::chrono::steady_clock::now();
+        if (!skip) {
+            try {
+                worker.consumer->Consume(slot->frame);
+            } catch (const std::exception& e) {
+                error = e.what();
+                if (error.empty()) {
+                    error = "Consumer failed";
+                }
+            }
+        }
+        double seconds = SecondsSince(start);
+
+        {
+            TaskQueueLock lock(m_cs);
+            if (!skip) {
+                worker.stats.seconds += seconds;
+                if (error.empty()) {
+                    worker.stats.frames++;
+                } else {
+                    worker.failed = true;
+                    worker.stats.error = std::move(error);
+                }
+            }
+            ReleaseLocked(slot);
+        }
+        m_cs.notify_all();
+    }
+
+    bool failed = false;
+    {
+        TaskQueueLock lock(m_cs);
+        failed = worker.failed;
+    }
+    if (failed) {
+        return;
+    }
+
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        worker.consumer->Finish();
+    } catch (const std::exception& e) {
+        error = e.what();
+        if (error.empty()) {
+            error = "Consumer failed";
+        }
+    }
+    double seconds = SecondsSince(start);
+
+    TaskQueueLock lock(m_cs);
+    worker.stats.seconds += seconds;
+    if (!error.empty()) {
+        worker.failed = true;
+        worker.stats.error = std::move(error);
+    }
+}
+
+void FramePipeline::ReleaseLocked(Slot* slot)
+{
+    if (--slot->refs == 0) {
+        m_freeSlots.push_back(slot);
+        m_stats.inFlight--;
+    }
+}
+
+// =============================================================
+// FrameConsumers
+// =============================================================
+
+namespace FrameConsumers {
+
+std::string FramePath(const std::string& pattern, int64_t number)
+{
+    std::string digits = std::to_string(number < 0 ? -number : number);
+
+    // ファイル名の最後の '#' の並びを置き換える（ディレクトリ名の '#' は残す）
+    size_t sep = pattern.find_last_of("/\\");
+    size_t nameStart = sep == std::string::npos ? 0 : sep + 1;
+    size_t end = pattern.rfind('#');
+    if (end == std::string::npos || end < nameStart) {
+        size_t dot = pattern.rfind('.');
+        if (dot == std::string::npos || dot < nameStart) {
+            dot = pattern.size();
+        }
+        return FramePath(pattern.substr(0, dot) + "_####" + pattern.substr(dot), number);
+    }
+    size_t begin = end;
+    while (begin > 0 && pattern[begin - 1] == '#') {
+        --begin;
+    }
+    size_t width = end - begin + 1;
+    if (digits.size() < width) {
+        digits.insert(0, width - digits.size(), '0');
+    }
+    if (number < 0) {
+        digits.insert(0, 1, '-');
+    }
+    return pattern.substr(0, begin) + digits + pattern.substr(end + 1);
+}
+
+namespace {
+
+// FrameWriter が取り込んで書き出し待ちにできるバッファの合計
+constexpr size_t kWriterInFlightBytes = 256u * 1024u * 1024u;
+
+// エンコードとファイル書き込みは FrameWriter のワーカーに任せる
+class FileWriter : public FramePipeline::Consumer {
+public:
+    FileWriter(std::string pattern, ImageEncoder::Format format, int bitDepth)
+        : m_pattern(std::move(pattern)), m_format(format), m_bitDepth(bitDepth),
+          m_writer(0, kWriterInFlightBytes)
+    {
+        ImageEncoder::CheckBitDepth(format, bitDepth);
+    }
+
+    std::string GetName() const override
+    {
+        return std::string("file:") + ImageEncoder::FormatName(m_format);
+    }
+
+    void Consume(const FramePipeline::Frame& frame) override
+    {
+        // 書き出し済みのフレームの失敗はここで報告する（以降のフレームは来ない）
+        CheckJobs(false);
+        m_jobs.push_back(m_writer.Write(frame.view, FramePath(m_pattern, frame.number),
+                                        m_format, m_bitDepth));
+    }
+
+    void Finish() override
+    {
+        m_writer.Flush(-1);
+        CheckJobs(true);
+        m_writer.Close();
+    }
+
+private:
+    // 先頭から完了した書き出しを調べ、失敗していれば例外にする
+    void CheckJobs(bool all)
+    {
+        while (!m_jobs.empty() && (all || m_jobs.front()->IsDone())) {
+            std::shared_ptr<FrameWriter::Job> job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            job->Wait(-1);
+            std::string error = job->GetError();
+            if (!error.empty()) {
+                throw std::runtime_error(error);
+            }
+        }
+    }
+
+    std::string m_pattern;
+    ImageEncoder::Format m_format;
+    int m_bitDepth;
+    std::deque<std::shared_ptr<FrameWriter::Job>> m_jobs;
+    FrameWriter m_writer;   // 最初に破棄する（予約済みの書き出しを終えてから止める）
+};
+
+} // namespace
+
+std::shared_ptr<FramePipeline::Consumer> MakeFileWriter(const std::string& pattern,
+                                                       ImageEncoder::Format format,
+                                                       int bitDepth)
+{
+    return std::make_shared<FileWriter>(pattern, format, bitDepth);
+}
+
+void StatsCollector::Consume(const FramePipeline::Frame& frame)
+{
+    Entry entry;
+    entry.index = frame.index;
+    entry.number = frame.number;
+    entry.time = frame.time;
+    entry.result = ImageStats::Compute(frame.view, m_options);
+    m_results.push_back(std::move(entry));
+}
+
+} // namespace FrameConsumers
+} // namespace PyAE
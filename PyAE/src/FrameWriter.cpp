@@ -0,0 +1,301 @@
+// FrameWriter.cpp
+// PyAE - Python for After Effects
+// フレームのファイル書き出し（ワーカースレッド）
+
+#include "FrameWriter.h"
+#include "StringUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace PyAE {
+
+// =============================================================
+// FrameWriter::Job
+// =============================================================
+
+bool FrameWriter::Job::IsDone() const
+{
+    TaskQueueLock lock(m_cs);
+    return m_done;
+}
+
+bool FrameWriter::Job::Wait(int timeoutMs) const
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds((std::max)(timeoutMs, 0));
+    TaskQueueLock lock(m_cs);
+    while (!m_done) {
+        if (timeoutMs < 0) {
+            m_cs.wait();
+            continue;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        m_cs.wait_for(static_cast<DWORD>(remaining.count() + 1));
+    }
+    return true;
+}
+
+std::string FrameWriter::Job::GetError() const
+{
+    TaskQueueLock lock(m_cs);
+    return m_error;
+}
+
+uint64_t FrameWriter::Job::GetBytesWritten() const
+{
+    TaskQueueLock lock(m_cs);
+    return m_bytesWritten;
+}
+
+void FrameWriter::Job::Complete(std::string error, uint64_t bytesWritten)
+{
+    {
+        TaskQueueLock lock(m_cs);
+        m_done = true;
+        m_error = std::move(error);
+        m_bytesWritten = bytesWritten;
+    }
+    m_cs.notify_all();
+}
+
+// =============================================================
+// FrameWriter
+// =============================================================
+
+FrameWriter::FrameWriter(int threads, size_t maxInFlightBytes)
+    : m_maxInFlightBytes(maxInFlightBytes)
+{
+    if (threads <= 0) {
+        // エンコードはファイル書き込み待ちが多いので少数で足りる
+        unsigned int hw = std::thread::hardware_concurrency();
+        threads = static_cast<int>((std::min)((std::max)(hw / 2, 1u), 4u));
+    }
+    m_threads.reserve(static_cast<size_t>(threads));
+    for (int i = 0; i < threads; ++i) {
+        m_threads.emplace_back(&FrameWriter::WorkerLoop, this);
+    }
+}
+
+FrameWriter::~FrameWriter()
+{
+    Close();
+}
+
+std::shared_ptr<FrameWriter::Job> FrameWriter::Write(const PixelConvert::ImageView& src,
+                                                     const std::string& path,
+                                                     ImageEncoder::Format format, int bitDepth,
+                                                     PixelConvert::AlphaOp alpha)
+{
+    if (!src.data || src.width <= 0 || src.height <= 0) {
+        throw std::invalid_argument("Cannot write an empty image");
+    }
+    ImageEncoder::CheckBitDepth(format, bitDepth);
+
+    // 元の深度のまま RGBA に詰めて取り込む（変換はワーカー側）
+    Task task;
+    task.format = format;
+    task.bitDepth = bitDepth;
+    task.view.width = src.width;
+    task.view.height = src.height;
+    task.view.depth = src.depth;
+    task.view.layout = PixelConvert::Layout::RGBA;
+    task.view.rowBytes = static_cast<ptrdiff_t>(src.width) * 4 *
+        static_cast<ptrdiff_t>(PixelConvert::ChannelBytes(src.depth));
+    const size_t bytes = static_cast<size_t>(task.view.rowBytes) * static_cast<size_t>(src.height);
+
+    {
+        TaskQueueLock lock(m_cs);
+        // 上限を超える1枚だけは、他に未完了が無ければ受け付ける
+        while (!m_closing && m_stats.inFlightBytes > 0 &&
+               m_stats.inFlightBytes + bytes > m_maxInFlightBytes) {
+            m_cs.wait();
+        }
+        if (m_closing) {
+            throw std::runtime_error("FrameWriter is closed");
+        }
+        task.buffer = TakeBufferLocked(bytes);
+        m_stats.inFlightBytes += bytes;
+        m_stats.peakInFlightBytes = (std::max)(m_stats.peakInFlightBytes, m_stats.inFlightBytes);
+        m_stats.pending++;
+        m_stats.submitted++;
+    }
+
+    // 取り込みに失敗した・その間に Close された場合は予約を取り消す
+    auto cancel = [this, bytes]() {
+        {
+            TaskQueueLock lock(m_cs);
+            m_stats.inFlightBytes -= bytes;
+            m_stats.pending--;
+            m_stats.submitted--;
+        }
+        m_cs.notify_all();
+    };
+
+    task.view.data = task.buffer.data();
+    try {
+        PixelConvert::Convert(src, task.view, alpha);
+    } catch (...) {
+        cancel();
+        throw;
+    }
+
+    task.job.reset(new Job(path));
+    std::shared_ptr<Job> job = task.job;
+    bool queued = false;
+    {
+        TaskQueueLock lock(m_cs);
+        if (!m_closing) {
+            m_queue.push_back(std::move(task));
+            queued = true;
+        }
+    }
+    if (!queued) {
+        cancel();
+        throw std::runtime_error("FrameWriter is closed");
+    }
+    m_cs.notify_all();
+    return job;
+}
+
+bool FrameWriter::Flush(int timeoutMs)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds((std::max)(timeoutMs, 0));
+    TaskQueueLock lock(m_cs);
+    while (m_stats.pending > 0) {
+        if (timeoutMs < 0) {
+            m_cs.wait();
+            continue;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        m_cs.wait_for(static_cast<DWORD>(remaining.count() + 1));
+    }
+    return true;
+}
+
+void FrameWriter::Close()
+{
+    {
+        TaskQueueLock lock(m_cs);
+        m_closing = true;
+    }
+    m_cs.notify_all();
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    TaskQueueLock lock(m_cs);
+    m_freeBuffers.clear();
+    m_pooledBytes = 0;
+}
+
+bool FrameWriter::IsClosed() const
+{
+    TaskQueueLock lock(m_cs);
+    return m_closing;
+}
+
+FrameWriter::Stats FrameWriter::GetStats() const
+{
+    TaskQueueLock lock(m_cs);
+    Stats stats = m_stats;
+    stats.pooledBuffers = m_freeBuffers.size();
+    return stats;
+}
+
+void FrameWriter::WorkerLoop()
+{
+    for (;;) {
+        Task task;
+        {
+            TaskQueueLock lock(m_cs);
+            while (m_queue.empty() && !m_closing) {
+                m_cs.wait();
+            }
+            // 終了時も予約済みのものは書き出す
+            if (m_queue.empty()) {
+                return;
+            }
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        Run(task);
+    }
+}
+
+void FrameWriter::Run(Task& task)
+{
+    std::string error;
+    uint64_t bytesWritten = 0;
+    try {
+        std::ofstream file(std::filesystem::path(StringUtils::Utf8ToWide(task.job->GetPath())),
+                           std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Failed to open file for writing: " + task.job->GetPath());
+        }
+        ImageEncoder::Write(task.view, task.format, task.bitDepth, file);
+        bytesWritten = static_cast<uint64_t>(file.tellp());
+        file.close();
+        if (!file) {
+            throw std::runtime_error("Failed to write file: " + task.job->GetPath());
+        }
+    } catch (const std::exception& e) {
+        error = e.what();
+        if (error.empty()) {
+            error = "Failed to write file: " + task.job->GetPath();
+        }
+    }
+
+    {
+        TaskQueueLock lock(m_cs);
+        m_stats.inFlightBytes -= task.buffer.size();
+        m_stats.pending--;
+        if (error.empty()) {
+            m_stats.written++;
+            m_stats.bytesWritten += bytesWritten;
+        } else {
+            m_stats.failed++;
+        }
+        // 次の Write で使い回す（プールも in-flight と同じ上限まで）
+        if (!m_closing && m_pooledBytes + task.buffer.capacity() <= m_maxInFlightBytes) {
+            m_pooledBytes += task.buffer.capacity();
+            m_freeBuffers.push_back(std::move(task.buffer));
+        }
+    }
+    m_cs.notify_all();
+    task.job->Complete(std::move(error), bytesWritten);
+}
+
+std::vector<uint8_t> FrameWriter::TakeBufferLocked(size_t bytes)
+{
+    // 足りる中で最小のものを使う
+    auto best = m_freeBuffers.end();
+    for (auto it = m_freeBuffers.begin(); it != m_freeBuffers.end(); ++it) {
+        if (it->capacity() >= bytes && (best == m_freeBuffers.end() || it->capacity() < best->capacity())) {
+            best = it;
+        }
+    }
+
+    std::vector<uint8_t> buffer;
+    if (best != m_freeBuffers.end()) {
+        buffer = std::move(*best);
+        m_pooledBytes -= buffer.capacity();
+        m_freeBuffers.erase(best);
+    }
+    buffer.resize(bytes);
+    return buffer;
+}
+
+} // namespace PyAE
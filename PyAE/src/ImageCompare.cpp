@@ -0,0 +1,339 @@
+// ImageCompare.cpp
+// PyAE - Python for After Effects
+// 2枚の画像の比較
+//
+// SSIM のタイルの行を1単位としてスレッドに分割する。各行は両方の画像を
+// float RGBA にデコードし、ImageStats と同じく1画素（4チャンネル）を
+// SSE の1レジスタとして差分・二乗誤差・タイルごとの和を集計する。
+// タイル内の1行分の和は float で取り、行末で double に足し込む。
+
+#include "ImageCompare.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define PYAE_COMPARE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace PyAE {
+namespace ImageCompare {
+
+namespace {
+
+// SSIM の定数（値域 1.0）
+constexpr double kC1 = 0.01 * 0.01;
+constexpr double kC2 = 0.03 * 0.03;
+
+// 1タイルの和（チャンネルごと）
+struct TileSums {
+    double a[4];
+    double b[4];
+    double aa[4];
+    double bb[4];
+    double ab[4];
+};
+
+// 1タスク分の途中結果
+struct Partial {
+    float maxAbs[4] = {};
+    double sumAbs[4] = {};
+    double sumSq[4] = {};
+    double ssimSum[4] = {};
+    uint64_t tiles = 0;
+    uint64_t pixels = 0;
+    uint64_t differing = 0;
+};
+
+// |a - b|。NaN どうしは 0、片方だけの NaN は +inf
+inline float AbsDiff(float a, float b) {
+    bool nanA = std::isnan(a);
+    bool nanB = std::isnan(b);
+    if (nanA || nanB) {
+        return nanA && nanB ? 0.0f : std::numeric_limits<float>::infinity();
+    }
+    return std::fabs(a - b);
+}
+
+// SSIM の和には NaN を 0 として入れる
+inline float Finite(float v) {
+    return std::isnan(v) ? 0.0f : v;
+}
+
+// 1行を比較する。diff が null でなければ差分（アルファは 1）を書く。
+// 戻り値: tolerance を超えた画素数
+uint64_t CompareRowScalar(const float* a, const float* b, float* diff, int width,
+                          int tile, float tolerance, TileSums* sums, Partial& p) {
+    uint64_t differing = 0;
+    for (int x = 0; x < width; ++x) {
+        bool exceeds = false;
+        TileSums* t = sums ? &sums[x / tile] : nullptr;
+        for (int c = 0; c < 4; ++c) {
+            float va = a[x * 4 + c];
+            float vb = b[x * 4 + c];
+            float d = AbsDiff(va, vb);
+            exceeds |= d > tolerance;
+            p.maxAbs[c] = (std::max)(p.maxAbs[c], d);
+            p.sumAbs[c] += d;
+            p.sumSq[c] += static_cast<double>(d) * d;
+            if (diff) {
+                diff[x * 4 + c] = c == 3 ? 1.0f : d;
+            }
+            if (t) {
+                double fa = Finite(va);
+                double fb = Finite(vb);
+                t->a[c] += fa;
+                t->b[c] += fb;
+                t->aa[c] += fa * fa;
+                t->bb[c] += fb * fb;
+                t->ab[c] += fa * fb;
+            }
+        }
+        differing += exceeds ? 1 : 0;
+    }
+    return differing;
+}
+
+#ifdef PYAE_COMPARE_SSE2
+
+inline void AddFloats(double* dst, __m128 v) {
+    double lanes[4];
+    _mm_storeu_pd(lanes, _mm_cvtps_pd(v));
+    _mm_storeu_pd(lanes + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    for (int c = 0; c < 4; ++c) {
+        dst[c] += lanes[c];
+    }
+}
+
+uint64_t CompareRowSSE2(const float* a, const float* b, float* diff, int width,
+                        int tile, float tolerance, TileSums* sums, Partial& p) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128 tol = _mm_set1_ps(tolerance);
+    const __m128 rgbMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    const __m128 alphaOne = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+    __m128 vmax = _mm_loadu_ps(p.maxAbs);
+    __m128d absRG = _mm_setzero_pd();
+    __m128d absBA = _mm_setzero_pd();
+    __m128d sqRG = _mm_setzero_pd();
+    __m128d sqBA = _mm_setzero_pd();
+    uint64_t differing = 0;
+
+    // tile 画素ごとに区切り、区間内の SSIM の和は float で取る
+    const int span = sums ? tile : width;
+    for (int x0 = 0; x0 < width; x0 += span) {
+        const int x1 = (std::min)(width, x0 + span);
+        __m128 sa = _mm_setzero_ps();
+        __m128 sb = _mm_setzero_ps();
+        __m128 saa = _mm_setzero_ps();
+        __m128 sbb = _mm_setzero_ps();
+        __m128 sab = _mm_setzero_ps();
+
+        for (int x = x0; x < x1; ++x) {
+            __m128 va = _mm_loadu_ps(a + x * 4);
+            __m128 vb = _mm_loadu_ps(b + x * 4);
+            __m128 nanA = _mm_cmpunord_ps(va, va);
+            __m128 nanB = _mm_cmpunord_ps(vb, vb);
+
+            __m128 d = _mm_and_ps(_mm_sub_ps(va, vb), absMask);
+            d = _mm_andnot_ps(_mm_and_ps(nanA, nanB), d);
+            __m128 nanD = _mm_cmpunord_ps(d, d);
+            d = _mm_or_ps(_mm_and_ps(nanD, inf), _mm_andnot_ps(nanD, d));
+
+            vmax = _mm_max_ps(d, vmax);
+            __m128d dRG = _mm_cvtps_pd(d);
+            __m128d dBA = _mm_cvtps_pd(_mm_movehl_ps(d, d));
+            absRG = _mm_add_pd(absRG, dRG);
+            absBA = _mm_add_pd(absBA, dBA);
+            sqRG = _mm_add_pd(sqRG, _mm_mul_pd(dRG, dRG));
+            sqBA = _mm_add_pd(sqBA, _mm_mul_pd(dBA, dBA));
+            differing += _mm_movemask_ps(_mm_cmpgt_ps(d, tol)) ? 1 : 0;
+
+            if (diff) {
+                _mm_storeu_ps(diff + x * 4, _mm_or_ps(_mm_and_ps(d, rgbMask), alphaOne));
+            }
+            if (sums) {
+                __m128 fa = _mm_andnot_ps(nanA, va);
+                __m128 fb = _mm_andnot_ps(nanB, vb);
+                sa = _mm_add_ps(sa, fa);
+                sb = _mm_add_ps(sb, fb);
+                saa = _mm_add_ps(saa, _mm_mul_ps(fa, fa));
+                sbb = _mm_add_ps(sbb, _mm_mul_ps(fb, fb));
+                sab = _mm_add_ps(sab, _mm_mul_ps(fa, fb));
+            }
+        }
+
+        if (sums) {
+            TileSums& t = sums[x0 / tile];
+            AddFloats(t.a, sa);
+            AddFloats(t.b, sb);
+            AddFloats(t.aa, saa);
+            AddFloats(t.bb, sbb);
+            AddFloats(t.ab, sab);
+        }
+    }
+
+    _mm_storeu_ps(p.maxAbs, vmax);
+    double lanes[4];
+    _mm_storeu_pd(lanes, absRG);
+    _mm_storeu_pd(lanes + 2, absBA);
+    for (int c = 0; c < 4; ++c) {
+        p.sumAbs[c] += lanes[c];
+    }
+    _mm_storeu_pd(lanes, sqRG);
+    _mm_storeu_pd(lanes + 2, sqBA);
+    for (int c = 0; c < 4; ++c) {
+        p.sumSq[c] += lanes[c];
+    }
+    return differing;
+}
+
+#endif // PYAE_COMPARE_SSE2
+
+uint64_t CompareRow(const float* a, const float* b, float* diff, int width,
+                    int tile, float tolerance, TileSums* sums, Partial& p) {
+#ifdef PYAE_COMPARE_SSE2
+    return CompareRowSSE2(a, b, diff, width, tile, tolerance, sums, p);
+#else
+    return CompareRowScalar(a, b, diff, width, tile, tolerance, sums, p);
+#endif
+}
+
+// 1タイルの SSIM を p に足す
+void AddTileSsim(const TileSums& t, double n, Partial& p) {
+    for (int c = 0; c < 4; ++c) {
+        double ma = t.a[c] / n;
+        double mb = t.b[c] / n;
+        double va = (std::max)(0.0, t.aa[c] / n - ma * ma);
+        double vb = (std::max)(0.0, t.bb[c] / n - mb * mb);
+        double cov = t.ab[c] / n - ma * mb;
+        p.ssimSum[c] += ((2.0 * ma * mb + kC1) * (2.0 * cov + kC2)) /
+                        ((ma * ma + mb * mb + kC1) * (va + vb + kC2));
+    }
+    p.tiles++;
+}
+
+// 1タスクあたり最低この画素数になるよう分割する
+int MinParallelRows(int width) {
+    constexpr int kMinPixelsPerTask = 1 << 16;
+    return (std::max)(1, kMinPixelsPerTask / (std::max)(1, width));
+}
+
+} // namespace
+
+Result Compare(const PixelConvert::ImageView& a, const PixelConvert::ImageView& b,
+               const Options& options, const PixelConvert::ImageView& diff) {
+    if (!a.data || !b.data || a.width <= 0 || a.height <= 0) {
+        throw std::invalid_argument("Cannot compare empty images");
+    }
+    if (a.width != b.width || a.height != b.height) {
+        throw std::invalid_argument("Images to compare differ in size");
+    }
+    const bool writeDiff = diff.data != nullptr;
+    if (writeDiff && (diff.width != a.width || diff.height != a.height)) {
+        throw std::invalid_argument("Diff image size does not match the compared images");
+    }
+    if (options.ssim && (options.ssimTile < 1 || options.ssimTile > 256)) {
+        throw std::invalid_argument("ssim_tile must be between 1 and 256");
+    }
+    if (!(options.tolerance >= 0.0f)) {
+        throw std::invalid_argument("tolerance must be non-negative");
+    }
+
+    const int width = a.width;
+    const int height = a.height;
+    const int tile = options.ssim ? options.ssimTile : 1;
+    const int tileCols = (width + tile - 1) / tile;
+    const int tileRows = (height + tile - 1) / tile;
+    const int minChunk = (std::max)(1, MinParallelRows(width) / tile);
+
+    std::vector<Partial> partials(static_cast<size_t>((std::max)(1, ParallelTaskCount(tileRows, minChunk))));
+    std::atomic<bool> stop{false};
+
+    ParallelForTasks(tileRows, minChunk, [&](int task, int begin, int end) {
+        Partial& partial = partials[static_cast<size_t>(task)];
+        std::vector<float> rowA(static_cast<size_t>(width) * 4);
+        std::vector<float> rowB(static_cast<size_t>(width) * 4);
+        std::vector<float> rowDiff(writeDiff ? static_cast<size_t>(width) * 4 : 0);
+        std::vector<TileSums> sums(options.ssim ? static_cast<size_t>(tileCols) : 0);
+
+        for (int tileRow = begin; tileRow < end; ++tileRow) {
+            const int y0 = tileRow * tile;
+            const int y1 = (std::min)(height, y0 + tile);
+            std::fill(sums.begin(), sums.end(), TileSums{});
+
+            for (int y = y0; y < y1; ++y) {
+                if (stop.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                PixelConvert::DecodeRowRGBA(a, y, rowA.data());
+                PixelConvert::DecodeRowRGBA(b, y, rowB.data());
+                uint64_t differing = CompareRow(rowA.data(), rowB.data(),
+                                                writeDiff ? rowDiff.data() : nullptr, width, tile,
+                                                options.tolerance, sums.empty() ? nullptr : sums.data(),
+                                                partial);
+                if (writeDiff) {
+                    PixelConvert::EncodeRowRGBA(diff, y, rowDiff.data());
+                }
+                partial.pixels += static_cast<uint64_t>(width);
+                partial.differing += differing;
+                if (differing && options.earlyExit) {
+                    stop.store(true, std::memory_order_relaxed);
+                }
+            }
+
+            for (int tx = 0; tx < static_cast<int>(sums.size()); ++tx) {
+                int tileWidth = (std::min)(width, (tx + 1) * tile) - tx * tile;
+                AddTileSsim(sums[static_cast<size_t>(tx)], static_cast<double>(tileWidth) * (y1 - y0), partial);
+            }
+        }
+    });
+
+    Result result;
+    double sumAbs[4] = {};
+    double sumSq[4] = {};
+    double ssimSum[4] = {};
+    uint64_t tiles = 0;
+    for (const Partial& partial : partials) {
+        result.pixels += partial.pixels;
+        result.differingPixels += partial.differing;
+        tiles += partial.tiles;
+        for (int c = 0; c < 4; ++c) {
+            result.maxAbs[c] = (std::max)(result.maxAbs[c], static_cast<double>(partial.maxAbs[c]));
+            sumAbs[c] += partial.sumAbs[c];
+            sumSq[c] += partial.sumSq[c];
+            ssimSum[c] += partial.ssimSum[c];
+        }
+    }
+
+    result.identical = result.differingPixels == 0;
+    result.complete = result.pixels == static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+    for (int c = 0; c < 4; ++c) {
+        if (result.pixels > 0) {
+            result.meanAbs[c] = sumAbs[c] / static_cast<double>(result.pixels);
+            result.mse[c] = sumSq[c] / static_cast<double>(result.pixels);
+        }
+        if (options.ssim && tiles > 0) {
+            result.ssim[c] = ssimSum[c] / static_cast<double>(tiles);
+        }
+    }
+    return result;
+}
+
+double Psnr(const Result& result) {
+    double mse = (result.mse[0] + result.mse[1] + result.mse[2]) / 3.0;
+    if (mse <= 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return 10.0 * std::log10(1.0 / mse);
+}
+
+} // namespace ImageCompare
+} // namespace PyAE
@@ -0,0 +1,511 @@
+// ImageEncoder.cpp
+// PyAE - Python for After Effects
+// 画像ファイルのエンコード
+//
+// 各形式のヘッダを書いた後、1行ずつ float RGBA にデコードしてから
+// サンプルに変換して書き出す。8bit は PixelConvert のエンコードカーネルを
+// そのまま使い、16bit / float はここで変換する。
+
+#include "ImageEncoder.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace PyAE {
+namespace ImageEncoder {
+
+namespace {
+
+// =============================================================
+// Byte helpers
+// =============================================================
+
+void PutBE32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v >> 24));
+    out.push_back(static_cast<uint8_t>(v >> 16));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+void PutLE16(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void PutLE32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+    }
+}
+
+void PutLE64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+    }
+}
+
+void PutFloat(std::vector<uint8_t>& out, float v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    PutLE32(out, bits);
+}
+
+void PutString(std::vector<uint8_t>& out, const char* s) {
+    out.insert(out.end(), s, s + std::strlen(s) + 1);
+}
+
+void WriteBytes(std::ostream& out, const uint8_t* data, size_t size) {
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!out) {
+        throw std::runtime_error("Failed to write image data");
+    }
+}
+
+void WriteBytes(std::ostream& out, const std::vector<uint8_t>& data) {
+    WriteBytes(out, data.data(), data.size());
+}
+
+// =============================================================
+// Sample conversion
+// =============================================================
+
+inline float Clamp01(float v) {
+    // NaN は 0
+    return v > 0.0f ? (v < 1.0f ? v : 1.0f) : 0.0f;
+}
+
+// 1行分の float RGBA を各形式のサンプルに変換する
+class RowConverter {
+public:
+    RowConverter(const PixelConvert::ImageView& src)
+        : m_src(src), m_rgba(static_cast<size_t>(src.width) * 4) {}
+
+    const float* Decode(int y) {
+        PixelConvert::DecodeRowRGBA(m_src, y, m_rgba.data());
+        return m_rgba.data();
+    }
+
+    // RGBA 8bit（SIMD のエンコードカーネル経由）
+    void ToU8(int y, uint8_t* out) {
+        PixelConvert::ImageView row;
+        row.data = out;
+        row.width = m_src.width;
+        row.height = 1;
+        row.rowBytes = static_cast<ptrdiff_t>(m_src.width) * 4;
+        row.depth = PixelConvert::Depth::U8;
+        row.layout = PixelConvert::Layout::RGBA;
+        PixelConvert::EncodeRowRGBA(row, 0, Decode(y));
+    }
+
+    // RGBA 16bit（0-65535）
+    void ToU16(int y, uint8_t* out, bool bigEndian) {
+        const float* px = Decode(y);
+        for (size_t i = 0; i < m_rgba.size(); ++i) {
+            uint16_t v = static_cast<uint16_t>(std::lrint(Clamp01(px[i]) * 65535.0f));
+            out[i * 2 + (bigEndian ? 0 : 1)] = static_cast<uint8_t>(v >> 8);
+            out[i * 2 + (bigEndian ? 1 : 0)] = static_cast<uint8_t>(v);
+        }
+    }
+
+private:
+    const PixelConvert::ImageView& m_src;
+    std::vector<float> m_rgba;
+};
+
+// =============================================================
+// PNG
+// =============================================================
+
+uint32_t Crc32(uint32_t crc, const uint8_t* data, size_t size) {
+    static const auto table = [] {
+        std::vector<uint32_t> t(256);
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[n] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+class Adler32 {
+public:
+    void Update(const uint8_t* data, size_t size) {
+        // 5552 バイトごとに剰余を取れば 32bit で溢れない
+        while (size > 0) {
+            size_t n = (std::min)(size, static_cast<size_t>(5552));
+            for (size_t i = 0; i < n; ++i) {
+                m_a += data[i];
+                m_b += m_a;
+            }
+            m_a %= 65521;
+            m_b %= 65521;
+            data += n;
+            size -= n;
+        }
+    }
+    uint32_t Value() const { return (m_b << 16) | m_a; }
+
+private:
+    uint32_t m_a = 1;
+    uint32_t m_b = 0;
+};
+
+void WritePngChunk(std::ostream& out, const char type[4], const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> head;
+    PutBE32(head, static_cast<uint32_t>(data.size()));
+    head.insert(head.end(), type, type + 4);
+    uint32_t crc = Crc32(0, head.data() + 4, 4);
+    crc = Crc32(crc, data.data(), data.size());
+    std::vector<uint8_t> tail;
+    PutBE32(tail, crc);
+    WriteBytes(out, head);
+    WriteBytes(out, data);
+    WriteBytes(out, tail);
+}
+
+// 無圧縮 deflate ブロックを1つずつ IDAT チャンクとして書き出す
+class PngDataWriter {
+public:
+    explicit PngDataWriter(std::ostream& out) : m_out(out) {
+        // zlib ヘッダ（deflate、32K ウィンドウ、圧縮レベル最小）
+        m_block.push_back(0x78);
+        m_block.push_back(0x01);
+    }
+
+    void Append(const uint8_t* data, size_t size) {
+        m_adler.Update(data, size);
+        while (size > 0) {
+            size_t n = (std::min)(size, kMaxBlock - m_pending.size());
+            m_pending.insert(m_pending.end(), data, data + n);
+            data += n;
+            size -= n;
+            if (m_pending.size() == kMaxBlock) {
+                FlushBlock(false);
+            }
+        }
+    }
+
+    void Finish() {
+        FlushBlock(true);
+    }
+
+private:
+    static constexpr size_t kMaxBlock = 65535;
+
+    void FlushBlock(bool final) {
+        uint16_t len = static_cast<uint16_t>(m_pending.size());
+        m_block.push_back(final ? 1 : 0);   // BFINAL, BTYPE=00（無圧縮）
+        PutLE16(m_block, len);
+        PutLE16(m_block, static_cast<uint16_t>(~len));
+        m_block.insert(m_block.end(), m_pending.begin(), m_pending.end());
+        if (final) {
+            PutBE32(m_block, m_adler.Value());
+        }
+        WritePngChunk(m_out, "IDAT", m_block);
+        m_block.clear();
+        m_pending.clear();
+    }
+
+    std::ostream& m_out;
+    std::vector<uint8_t> m_block;
+    std::vector<uint8_t> m_pending;
+    Adler32 m_adler;
+};
+
+void WritePng(const PixelConvert::ImageView& src, int bitDepth, std::ostream& out) {
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    WriteBytes(out, signature, sizeof(signature));
+
+    std::vector<uint8_t> ihdr;
+    PutBE32(ihdr, static_cast<uint32_t>(src.width));
+    PutBE32(ihdr, static_cast<uint32_t>(src.height));
+    ihdr.push_back(static_cast<uint8_t>(bitDepth));
+    ihdr.push_back(6);  // RGBA
+    ihdr.push_back(0);  // deflate
+    ihdr.push_back(0);  // フィルタ方式
+    ihdr.push_back(0);  // インターレースなし
+    WritePngChunk(out, "IHDR", ihdr);
+
+    RowConverter converter(src);
+    PngDataWriter data(out);
+    std::vector<uint8_t> row(1 + static_cast<size_t>(src.width) * 4 * (bitDepth / 8));
+    row[0] = 0;     // フィルタなし
+    for (int y = 0; y < src.height; ++y) {
+        if (bitDepth == 8) {
+            converter.ToU8(y, row.data() + 1);
+        } else {
+            converter.ToU16(y, row.data() + 1, true);
+        }
+        data.Append(row.data(), row.size());
+    }
+    data.Finish();
+
+    WritePngChunk(out, "IEND", {});
+}
+
+// =============================================================
+// TIFF
+// =============================================================
+
+void PutIfdEntry(std::vector<uint8_t>& out, uint16_t tag, uint16_t type, uint32_t count, uint32_t value) {
+    PutLE16(out, tag);
+    PutLE16(out, type);
+    PutLE32(out, count);
+    if (type == 3 && count == 1) {
+        PutLE16(out, value);    // SHORT は左詰め
+        PutLE16(out, 0);
+    } else {
+        PutLE32(out, value);
+    }
+}
+
+void WriteTiff(const PixelConvert::ImageView& src, int bitDepth, std::ostream& out) {
+    constexpr uint16_t kShort = 3;
+    constexpr uint16_t kLong = 4;
+    constexpr uint32_t kEntries = 12;
+    constexpr uint32_t kIfdOffset = 8;
+    constexpr uint32_t kBitsOffset = kIfdOffset + 2 + kEntries * 12 + 4;
+    constexpr uint32_t kFormatOffset = kBitsOffset + 8;
+    constexpr uint32_t kDataOffset = kFormatOffset + 8;
+
+    const uint64_t rowBytes = static_cast<uint64_t>(src.width) * 4 * (bitDepth / 8);
+    const uint64_t dataBytes = rowBytes * static_cast<uint64_t>(src.height);
+    if (kDataOffset + dataBytes > 0xFFFFFFFFull) {
+        throw std::runtime_error("Image is too large for TIFF");
+    }
+    const uint32_t sampleFormat = bitDepth == 32 ? 3 : 1;   // IEEE float / 符号なし整数
+
+    std::vector<uint8_t> header = {'I', 'I', 42, 0};
+    PutLE32(header, kIfdOffset);
+    PutLE16(header, kEntries);
+    PutIfdEntry(header, 256, kLong, 1, static_cast<uint32_t>(src.width));   // ImageWidth
+    PutIfdEntry(header, 257, kLong, 1, static_cast<uint32_t>(src.height));  // ImageLength
+    PutIfdEntry(header, 258, kShort, 4, kBitsOffset);                       // BitsPerSample
+    PutIfdEntry(header, 259, kShort, 1, 1);                                 // Compression: なし
+    PutIfdEntry(header, 262, kShort, 1, 2);                                 // Photometric: RGB
+    PutIfdEntry(header, 273, kLong, 1, kDataOffset);                        // StripOffsets
+    PutIfdEntry(header, 277, kShort, 1, 4);                                 // SamplesPerPixel
+    PutIfdEntry(header, 278, kLong, 1, static_cast<uint32_t>(src.height));  // RowsPerStrip
+    PutIfdEntry(header, 279, kLong, 1, static_cast<uint32_t>(dataBytes));   // StripByteCounts
+    PutIfdEntry(header, 284, kShort, 1, 1);                                 // PlanarConfig: chunky
+    PutIfdEntry(header, 338, kShort, 1, 2);                                 // ExtraSamples: unassociated alpha
+    PutIfdEntry(header, 339, kShort, 4, kFormatOffset);                     // SampleFormat
+    PutLE32(header, 0);                                                     // 次の IFD なし
+    for (int c = 0; c < 4; ++c) {
+        PutLE16(header, static_cast<uint32_t>(bitDepth));
+    }
+    for (int c = 0; c < 4; ++c) {
+        PutLE16(header, sampleFormat);
+    }
+    WriteBytes(out, header);
+
+    RowConverter converter(src);
+    std::vector<uint8_t> row(static_cast<size_t>(rowBytes));
+    for (int y = 0; y < src.height; ++y) {
+        if (bitDepth == 8) {
+            converter.ToU8(y, row.data());
+        } else if (bitDepth == 16) {
+            converter.ToU16(y, row.data(), false);
+        } else {
+            std::memcpy(row.data(), converter.Decode(y), row.size());
+        }
+        WriteBytes(out, row);
+    }
+}
+
+// =============================================================
+// OpenEXR（無圧縮スキャンライン、FLOAT の A / B / G / R）
+// =============================================================
+
+void PutExrAttribute(std::vector<uint8_t>& out, const char* name, const char* type,
+                     const std::vector<uint8_t>& value) {
+    PutString(out, name);
+    PutString(out, type);
+    PutLE32(out, static_cast<uint32_t>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+void WriteExr(const PixelConvert::ImageView& src, std::ostream& out) {
+    std::vector<uint8_t> header = {0x76, 0x2F, 0x31, 0x01};    // マジック
+    PutLE32(header, 2);                                         // バージョン 2、シングルパート
+
+    // チャンネルは名前順に並べる
+    std::vector<uint8_t> channels;
+    for (const char* name : {"A", "B", "G", "R"}) {
+        PutString(channels, name);
+        PutLE32(channels, 2);   // FLOAT
+        PutLE32(channels, 0);   // pLinear + 予約
+        PutLE32(channels, 1);   // xSampling
+        PutLE32(channels, 1);   // ySampling
+    }
+    channels.push_back(0);
+    PutExrAttribute(header, "channels", "chlist", channels);
+    PutExrAttribute(header, "compression", "compression", {0});
+
+    std::vector<uint8_t> window;
+    PutLE32(window, 0);
+    PutLE32(window, 0);
+    PutLE32(window, static_cast<uint32_t>(src.width - 1));
+    PutLE32(window, static_cast<uint32_t>(src.height - 1));
+    PutExrAttribute(header, "dataWindow", "box2i", window);
+    PutExrAttribute(header, "displayWindow", "box2i", window);
+    PutExrAttribute(header, "lineOrder", "lineOrder", {0});     // INCREASING_Y
+
+    std::vector<uint8_t> one;
+    PutFloat(one, 1.0f);
+    PutExrAttribute(header, "pixelAspectRatio", "float", one);
+    std::vector<uint8_t> center;
+    PutFloat(center, 0.0f);
+    PutFloat(center, 0.0f);
+    PutExrAttribute(header, "screenWindowCenter", "v2f", center);
+    PutExrAttribute(header, "screenWindowWidth", "float", one);
+    header.push_back(0);    // ヘッダ終端
+
+    // 行オフセット表（1ブロック = 1行）
+    const uint64_t planeBytes = static_cast<uint64_t>(src.width) * 4;
+    const uint64_t blockBytes = 8 + planeBytes * 4;
+    const uint64_t firstBlock = header.size() + static_cast<uint64_t>(src.height) * 8;
+    for (int y = 0; y < src.height; ++y) {
+        PutLE64(header, firstBlock + static_cast<uint64_t>(y) * blockBytes);
+    }
+    WriteBytes(out, header);
+
+    RowConverter converter(src);
+    std::vector<uint8_t> block;
+    block.reserve(static_cast<size_t>(blockBytes));
+    for (int y = 0; y < src.height; ++y) {
+        const float* px = converter.Decode(y);
+        block.clear();
+        PutLE32(block, static_cast<uint32_t>(y));
+        PutLE32(block, static_cast<uint32_t>(planeBytes * 4));
+        for (int c : {3, 2, 1, 0}) {
+            for (int x = 0; x < src.width; ++x) {
+                PutFloat(block, px[x * 4 + c]);
+            }
+        }
+        WriteBytes(out, block);
+    }
+}
+
+// =============================================================
+// PFM（RGB float、下の行から）
+// =============================================================
+
+void WritePfm(const PixelConvert::ImageView& src, std::ostream& out) {
+    // 負のスケールはリトルエンディアン
+    std::string header = "PF\n" + std::to_string(src.width) + " " +
+                         std::to_string(src.height) + "\n-1.0\n";
+    WriteBytes(out, reinterpret_cast<const uint8_t*>(header.data()), header.size());
+
+    RowConverter converter(src);
+    std::vector<uint8_t> row;
+    row.reserve(static_cast<size_t>(src.width) * 12);
+    for (int y = src.height - 1; y >= 0; --y) {
+        const float* px = converter.Decode(y);
+        row.clear();
+        for (int x = 0; x < src.width; ++x) {
+            PutFloat(row, px[x * 4 + 0]);
+            PutFloat(row, px[x * 4 + 1]);
+            PutFloat(row, px[x * 4 + 2]);
+        }
+        WriteBytes(out, row);
+    }
+}
+
+std::string ToLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+} // namespace
+
+Format FormatFromName(const std::string& name) {
+    std::string lower = ToLower(name);
+    if (lower == "png") return Format::PNG;
+    if (lower == "tif" || lower == "tiff") return Format::TIFF;
+    if (lower == "exr") return Format::EXR;
+    if (lower == "pfm") return Format::PFM;
+    throw std::invalid_argument("Unknown image format: " + name);
+}
+
+Format FormatFromPath(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    size_t slash = path.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        throw std::invalid_argument("Cannot determine image format from path: " + path);
+    }
+    try {
+        return FormatFromName(path.substr(dot + 1));
+    } catch (const std::invalid_argument&) {
+        throw std::invalid_argument("Unsupported image file extension: " + path);
+    }
+}
+
+const char* FormatName(Format format) {
+    switch (format) {
+        case Format::PNG: return "png";
+        case Format::TIFF: return "tiff";
+        case Format::EXR: return "exr";
+        default: return "pfm";
+    }
+}
+
+int DefaultBitDepth(Format format, PixelConvert::Depth depth) {
+    switch (format) {
+        case Format::PNG:
+            return depth == PixelConvert::Depth::U8 ? 8 : 16;
+        case Format::TIFF:
+            return depth == PixelConvert::Depth::U8 ? 8 : depth == PixelConvert::Depth::U16 ? 16 : 32;
+        default:
+            return 32;
+    }
+}
+
+void CheckBitDepth(Format format, int bitDepth) {
+    bool ok = false;
+    switch (format) {
+        case Format::PNG: ok = bitDepth == 8 || bitDepth == 16; break;
+        case Format::TIFF: ok = bitDepth == 8 || bitDepth == 16 || bitDepth == 32; break;
+        default: ok = bitDepth == 32; break;
+    }
+    if (!ok) {
+        throw std::invalid_argument(std::string("Unsupported bit depth for ") + FormatName(format) +
+                                    ": " + std::to_string(bitDepth));
+    }
+}
+
+void Write(const PixelConvert::ImageView& src, Format format, int bitDepth, std::ostream& out) {
+    if (!src.data || src.width <= 0 || src.height <= 0) {
+        throw std::invalid_argument("Cannot encode an empty image");
+    }
+    CheckBitDepth(format, bitDepth);
+
+    switch (format) {
+        case Format::PNG: WritePng(src, bitDepth, out); break;
+        case Format::TIFF: WriteTiff(src, bitDepth, out); break;
+        case Format::EXR: WriteExr(src, out); break;
+        case Format::PFM: WritePfm(src, out); break;
+    }
+    out.flush();
+    if (!out) {
+        throw std::runtime_error("Failed to write image data");
+    }
+}
+
+} // namespace ImageEncoder
+} // namespace PyAE
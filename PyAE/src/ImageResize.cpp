@@ -0,0 +1,259 @@
+// ImageResize.cpp
+// PyAE - Python for After Effects
+// 画像の縮小・拡大
+//
+// 出力の各列・各行について、寄与する入力の範囲（連続）と重みを先に表にする。
+// 入力行は float RGBA にデコードして横方向の表で出力幅に縮め、リングに
+// 保持する（縦方向で隣の出力行と共有する行を再計算しないため）。
+// float RGBA の1画素が SSE の1レジスタに収まるので、横方向は画素ごと、
+// 縦方向は4要素ずつ積和する。
+
+#include "ImageResize.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define PYAE_RESIZE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace PyAE {
+namespace ImageResize {
+
+namespace {
+
+// 1軸分の重みの表。出力 i には入力 [first[i], first[i] + count[i]) が
+// weights[offset[i] ...] の重みで寄与する（重みの和は 1）
+struct Axis {
+    std::vector<int> first;
+    std::vector<int> count;
+    std::vector<int> offset;
+    std::vector<float> weights;
+    int maxCount = 0;
+    bool identity = true;
+};
+
+// 重みの小さい端の入力は捨てる（面積の丸め誤差で生じる）
+constexpr double kMinWeight = 1e-6;
+
+Axis BuildAxis(int srcLen, int dstLen, Filter filter) {
+    Axis axis;
+    axis.first.resize(static_cast<size_t>(dstLen));
+    axis.count.resize(static_cast<size_t>(dstLen));
+    axis.offset.resize(static_cast<size_t>(dstLen));
+
+    const double scale = static_cast<double>(srcLen) / dstLen;
+    std::vector<double> raw;
+    for (int i = 0; i < dstLen; ++i) {
+        int first = 0;
+        raw.clear();
+
+        switch (filter) {
+            case Filter::Box: {
+                // 中心 (j + 0.5) が [i * scale, (i + 1) * scale) に入る入力
+                int begin = static_cast<int>(std::ceil(i * scale - 0.5));
+                int end = static_cast<int>(std::ceil((i + 1) * scale - 0.5));
+                begin = (std::max)(0, (std::min)(begin, srcLen - 1));
+                end = (std::min)(end, srcLen);
+                if (end <= begin) {
+                    // 拡大時は最も近い入力（最近傍）
+                    begin = (std::min)(static_cast<int>((i + 0.5) * scale), srcLen - 1);
+                    end = begin + 1;
+                }
+                first = begin;
+                raw.assign(static_cast<size_t>(end - begin), 1.0);
+                break;
+            }
+            case Filter::Bilinear: {
+                double u = (i + 0.5) * scale - 0.5;
+                int j0 = static_cast<int>(std::floor(u));
+                double f = u - j0;
+                int a = (std::max)(0, (std::min)(j0, srcLen - 1));
+                int b = (std::max)(0, (std::min)(j0 + 1, srcLen - 1));
+                first = a;
+                if (a == b) {
+                    raw.push_back(1.0);
+                } else {
+                    raw.push_back(1.0 - f);
+                    raw.push_back(f);
+                }
+                break;
+            }
+            case Filter::Area: {
+                // [i * scale, (i + 1) * scale) と入力画素 [j, j + 1) の重なり
+                double lo = i * scale;
+                double hi = (i + 1) * scale;
+                int begin = static_cast<int>(std::floor(lo));
+                int end = (std::min)(static_cast<int>(std::ceil(hi)), srcLen);
+                first = begin;
+                for (int j = begin; j < end; ++j) {
+                    raw.push_back((std::min)(hi, j + 1.0) - (std::max)(lo, static_cast<double>(j)));
+                }
+                break;
+            }
+        }
+
+        // 両端の小さい重みを落としてから正規化する
+        size_t head = 0;
+        size_t tail = raw.size();
+        while (tail - head > 1 && raw[head] < kMinWeight) {
+            ++head;
+        }
+        while (tail - head > 1 && raw[tail - 1] < kMinWeight) {
+            --tail;
+        }
+        double sum = 0.0;
+        for (size_t k = head; k < tail; ++k) {
+            sum += raw[k];
+        }
+
+        axis.first[static_cast<size_t>(i)] = first + static_cast<int>(head);
+        axis.count[static_cast<size_t>(i)] = static_cast<int>(tail - head);
+        axis.offset[static_cast<size_t>(i)] = static_cast<int>(axis.weights.size());
+        for (size_t k = head; k < tail; ++k) {
+            axis.weights.push_back(static_cast<float>(raw[k] / sum));
+        }
+        axis.maxCount = (std::max)(axis.maxCount, static_cast<int>(tail - head));
+        if (tail - head != 1 || axis.first[static_cast<size_t>(i)] != i) {
+            axis.identity = false;
+        }
+    }
+    if (srcLen != dstLen) {
+        axis.identity = false;
+    }
+    return axis;
+}
+
+// 1行を横方向に縮める（in: 入力幅 * 4、out: 出力幅 * 4）
+void ResampleRow(const float* in, const Axis& axis, float* out) {
+    const int width = static_cast<int>(axis.first.size());
+    for (int x = 0; x < width; ++x) {
+        const float* src = in + static_cast<size_t>(axis.first[static_cast<size_t>(x)]) * 4;
+        const float* w = axis.weights.data() + axis.offset[static_cast<size_t>(x)];
+        const int count = axis.count[static_cast<size_t>(x)];
+#ifdef PYAE_RESIZE_SSE2
+        __m128 acc = _mm_mul_ps(_mm_set1_ps(w[0]), _mm_loadu_ps(src));
+        for (int k = 1; k < count; ++k) {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w[k]), _mm_loadu_ps(src + k * 4)));
+        }
+        _mm_storeu_ps(out + static_cast<size_t>(x) * 4, acc);
+#else
+        float acc[4] = {};
+        for (int k = 0; k < count; ++k) {
+            for (int c = 0; c < 4; ++c) {
+                acc[c] += w[k] * src[k * 4 + c];
+            }
+        }
+        std::copy(acc, acc + 4, out + static_cast<size_t>(x) * 4);
+#endif
+    }
+}
+
+// acc = w * row（first）/ acc += w * row。n は 4 の倍数
+void WeightRow(const float* row, float w, float* acc, size_t n, bool first) {
+#ifdef PYAE_RESIZE_SSE2
+    const __m128 vw = _mm_set1_ps(w);
+    if (first) {
+        for (size_t i = 0; i < n; i += 4) {
+            _mm_storeu_ps(acc + i, _mm_mul_ps(vw, _mm_loadu_ps(row + i)));
+        }
+    } else {
+        for (size_t i = 0; i < n; i += 4) {
+            _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i),
+                                              _mm_mul_ps(vw, _mm_loadu_ps(row + i))));
+        }
+    }
+#else
+    if (first) {
+        for (size_t i = 0; i < n; ++i) {
+            acc[i] = w * row[i];
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            acc[i] += w * row[i];
+        }
+    }
+#endif
+}
+
+// 1タスクあたり最低この入力画素数を処理するよう出力行を分割する
+int MinParallelRows(int srcWidth, int rowTaps) {
+    constexpr int kMinPixelsPerTask = 1 << 16;
+    return (std::max)(1, kMinPixelsPerTask / (std::max)(1, srcWidth * (std::max)(1, rowTaps)));
+}
+
+} // namespace
+
+const char* FilterName(Filter filter) {
+    switch (filter) {
+        case Filter::Box: return "box";
+        case Filter::Bilinear: return "bilinear";
+        case Filter::Area: return "area";
+    }
+    return "unknown";
+}
+
+void Resize(const PixelConvert::ImageView& src, const PixelConvert::ImageView& dst,
+            Filter filter) {
+    if (!src.data || src.width <= 0 || src.height <= 0 ||
+        !dst.data || dst.width <= 0 || dst.height <= 0) {
+        throw std::invalid_argument("Cannot resize an empty image");
+    }
+    if (src.data == dst.data) {
+        throw std::invalid_argument("Cannot resize an image in place");
+    }
+
+    const Axis columns = BuildAxis(src.width, dst.width, filter);
+    const Axis rows = BuildAxis(src.height, dst.height, filter);
+    const size_t srcFloats = static_cast<size_t>(src.width) * 4;
+    const size_t dstFloats = static_cast<size_t>(dst.width) * 4;
+
+    // 縦方向で同時に必要な入力行は maxCount 行以内で、出力行の順に単調に
+    // 進むので、入力行番号 % ringSize のリングで保持できる
+    const int ringSize = rows.maxCount;
+    const int minRows = MinParallelRows(src.width, rows.maxCount);
+
+    ParallelForTasks(dst.height, minRows, [&](int, int begin, int end) {
+        std::vector<float> decoded(columns.identity ? 0 : srcFloats);
+        std::vector<float> ring(static_cast<size_t>(ringSize) * dstFloats);
+        std::vector<int> ringRow(static_cast<size_t>(ringSize), -1);
+        std::vector<float> acc(dstFloats);
+
+        auto sourceRow = [&](int sy) -> const float* {
+            size_t slot = static_cast<size_t>(sy % ringSize);
+            float* row = ring.data() + slot * dstFloats;
+            if (ringRow[slot] != sy) {
+                if (columns.identity) {
+                    PixelConvert::DecodeRowRGBA(src, sy, row);
+                } else {
+                    PixelConvert::DecodeRowRGBA(src, sy, decoded.data());
+                    ResampleRow(decoded.data(), columns, row);
+                }
+                ringRow[slot] = sy;
+            }
+            return row;
+        };
+
+        for (int y = begin; y < end; ++y) {
+            const int first = rows.first[static_cast<size_t>(y)];
+            const int count = rows.count[static_cast<size_t>(y)];
+            const float* w = rows.weights.data() + rows.offset[static_cast<size_t>(y)];
+            if (count == 1) {
+                // 重み 1 の1行はそのまま書き出す
+                PixelConvert::EncodeRowRGBA(dst, y, sourceRow(first));
+                continue;
+            }
+            for (int k = 0; k < count; ++k) {
+                WeightRow(sourceRow(first + k), w[k], acc.data(), dstFloats, k == 0);
+            }
+            PixelConvert::EncodeRowRGBA(dst, y, acc.data());
+        }
+    });
+}
+
+} // namespace ImageResize
+} // namespace PyAE
@@ -0,0 +1,268 @@
+// ImageStats.cpp
+// PyAE - Python for After Effects
+// 画像のチャンネル別統計
+//
+// float RGBA の1画素がちょうど SSE の1レジスタ（4チャンネル）に収まるので、
+// 画素ごとに4チャンネルを同時に集計する。カウンタは行ごとに 32bit の
+// レーンで数え、行末で 64bit に足し込む。ヒストグラムはタスクごとに持ち、
+// 最後にまとめる（ロック不要）。
+
+#include "ImageStats.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define PYAE_STATS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace PyAE {
+namespace ImageStats {
+
+namespace {
+
+// 1タスク分の途中結果
+struct Partial {
+    float min[4];
+    float max[4];
+    double sum[4] = {};
+    double sumSq[4] = {};
+    uint64_t nan[4] = {};
+    uint64_t below[4] = {};
+    uint64_t above[4] = {};
+    std::vector<uint32_t> histogram;    // チャンネルごとに bins 個
+
+    Partial() {
+        std::fill(min, min + 4, std::numeric_limits<float>::infinity());
+        std::fill(max, max + 4, -std::numeric_limits<float>::infinity());
+    }
+};
+
+struct Binning {
+    float lo;
+    float hi;
+    float scale;    // bins / (hi - lo)
+    int bins;
+    bool enabled;
+};
+
+// ヒストグラムのビン。v は [lo, hi] の範囲内
+inline int BinOf(float v, const Binning& b) {
+    int bin = static_cast<int>((v - b.lo) * b.scale);
+    return (std::min)((std::max)(bin, 0), b.bins - 1);
+}
+
+void AccumulateScalar(const float* px, int width, const Binning& b, Partial& p) {
+    for (int x = 0; x < width; ++x) {
+        for (int c = 0; c < 4; ++c) {
+            float v = px[x * 4 + c];
+            if (std::isnan(v)) {
+                p.nan[c]++;
+                continue;
+            }
+            p.min[c] = (std::min)(p.min[c], v);
+            p.max[c] = (std::max)(p.max[c], v);
+            p.sum[c] += v;
+            p.sumSq[c] += static_cast<double>(v) * v;
+            if (v < b.lo) {
+                p.below[c]++;
+            } else if (v > b.hi) {
+                p.above[c]++;
+            } else if (b.enabled) {
+                p.histogram[static_cast<size_t>(c) * b.bins + BinOf(v, b)]++;
+            }
+        }
+    }
+}
+
+#ifdef PYAE_STATS_SSE2
+
+inline void StoreCounts(__m128i counts, uint64_t* out) {
+    alignas(16) int32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), counts);
+    for (int c = 0; c < 4; ++c) {
+        out[c] += static_cast<uint32_t>(lanes[c]);
+    }
+}
+
+void AccumulateSSE2(const float* px, int width, const Binning& b, Partial& p) {
+    const __m128 lo = _mm_set1_ps(b.lo);
+    const __m128 hi = _mm_set1_ps(b.hi);
+    const __m128 scale = _mm_set1_ps(b.scale);
+    const __m128i lastBin = _mm_set1_epi32(b.bins - 1);
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128 vmin = _mm_loadu_ps(p.min);
+    __m128 vmax = _mm_loadu_ps(p.max);
+    __m128d sumRG = _mm_setzero_pd();
+    __m128d sumBA = _mm_setzero_pd();
+    __m128d sqRG = _mm_setzero_pd();
+    __m128d sqBA = _mm_setzero_pd();
+    __m128i nan = zero;
+    __m128i below = zero;
+    __m128i above = zero;
+
+    alignas(16) int32_t bin[4];
+    for (int x = 0; x < width; ++x) {
+        __m128 v = _mm_loadu_ps(px + x * 4);
+        __m128 ord = _mm_cmpord_ps(v, v);
+
+        // 比較が NaN で偽になることを利用して NaN を除外する
+        // （min_ps / max_ps はどちらかが NaN なら第2引数を返す）
+        vmin = _mm_min_ps(v, vmin);
+        vmax = _mm_max_ps(v, vmax);
+        __m128 lt = _mm_cmplt_ps(v, lo);
+        __m128 gt = _mm_cmpgt_ps(v, hi);
+        nan = _mm_sub_epi32(nan, _mm_castps_si128(_mm_cmpunord_ps(v, v)));
+        below = _mm_sub_epi32(below, _mm_castps_si128(lt));
+        above = _mm_sub_epi32(above, _mm_castps_si128(gt));
+
+        __m128 valid = _mm_and_ps(v, ord);
+        __m128d rg = _mm_cvtps_pd(valid);
+        __m128d ba = _mm_cvtps_pd(_mm_movehl_ps(valid, valid));
+        sumRG = _mm_add_pd(sumRG, rg);
+        sumBA = _mm_add_pd(sumBA, ba);
+        sqRG = _mm_add_pd(sqRG, _mm_mul_pd(rg, rg));
+        sqBA = _mm_add_pd(sqBA, _mm_mul_pd(ba, ba));
+
+        if (b.enabled) {
+            int inRange = _mm_movemask_ps(_mm_andnot_ps(_mm_or_ps(lt, gt), ord));
+            if (inRange) {
+                __m128i idx = _mm_cvttps_epi32(_mm_mul_ps(_mm_sub_ps(valid, lo), scale));
+                // SSE2 に整数の min / max は無いので比較と選択で [0, bins-1] に収める
+                idx = _mm_andnot_si128(_mm_cmplt_epi32(idx, zero), idx);
+                __m128i over = _mm_cmpgt_epi32(idx, lastBin);
+                idx = _mm_or_si128(_mm_and_si128(over, lastBin), _mm_andnot_si128(over, idx));
+                _mm_store_si128(reinterpret_cast<__m128i*>(bin), idx);
+                for (int c = 0; c < 4; ++c) {
+                    if (inRange & (1 << c)) {
+                        p.histogram[static_cast<size_t>(c) * b.bins + bin[c]]++;
+                    }
+                }
+            }
+        }
+    }
+
+    _mm_storeu_ps(p.min, vmin);
+    _mm_storeu_ps(p.max, vmax);
+    double sums[4];
+    double squares[4];
+    _mm_storeu_pd(sums, sumRG);
+    _mm_storeu_pd(sums + 2, sumBA);
+    _mm_storeu_pd(squares, sqRG);
+    _mm_storeu_pd(squares + 2, sqBA);
+    for (int c = 0; c < 4; ++c) {
+        p.sum[c] += sums[c];
+        p.sumSq[c] += squares[c];
+    }
+    StoreCounts(nan, p.nan);
+    StoreCounts(below, p.below);
+    StoreCounts(above, p.above);
+}
+
+#endif // PYAE_STATS_SSE2
+
+void AccumulateRow(const float* px, int width, const Binning& b, Partial& p) {
+#ifdef PYAE_STATS_SSE2
+    AccumulateSSE2(px, width, b, p);
+#else
+    AccumulateScalar(px, width, b, p);
+#endif
+}
+
+// 1タスクあたり最低この画素数になるよう行を分割する
+int MinParallelRows(int width) {
+    constexpr int kMinPixelsPerTask = 1 << 16;
+    return (std::max)(1, kMinPixelsPerTask / (std::max)(1, width));
+}
+
+} // namespace
+
+Result Compute(const PixelConvert::ImageView& image, const Options& options) {
+    if (!image.data || image.width <= 0 || image.height <= 0) {
+        throw std::invalid_argument("Cannot compute statistics of an empty image");
+    }
+    if (options.bins < 1 || options.bins > 65536) {
+        throw std::invalid_argument("bins must be between 1 and 65536");
+    }
+    if (!(options.rangeMin < options.rangeMax) ||
+        !std::isfinite(options.rangeMin) || !std::isfinite(options.rangeMax)) {
+        throw std::invalid_argument("Histogram range must be finite and min < max");
+    }
+
+    Binning binning;
+    binning.lo = options.rangeMin;
+    binning.hi = options.rangeMax;
+    binning.bins = options.bins;
+    binning.scale = static_cast<float>(options.bins / (static_cast<double>(options.rangeMax) - options.rangeMin));
+    binning.enabled = options.histogram;
+
+    const int width = image.width;
+    const int minRows = MinParallelRows(width);
+    std::vector<Partial> partials(static_cast<size_t>((std::max)(1, ParallelTaskCount(image.height, minRows))));
+
+    ParallelForTasks(image.height, minRows, [&](int task, int begin, int end) {
+        Partial& partial = partials[static_cast<size_t>(task)];
+        if (binning.enabled) {
+            partial.histogram.assign(static_cast<size_t>(binning.bins) * 4, 0);
+        }
+
+        thread_local std::vector<float> buffer;
+        if (buffer.size() < static_cast<size_t>(width) * 4) {
+            buffer.resize(static_cast<size_t>(width) * 4);
+        }
+        for (int y = begin; y < end; ++y) {
+            PixelConvert::DecodeRowRGBA(image, y, buffer.data());
+            AccumulateRow(buffer.data(), width, binning, partial);
+        }
+    });
+
+    Result result;
+    result.pixels = static_cast<uint64_t>(width) * static_cast<uint64_t>(image.height);
+    for (int c = 0; c < 4; ++c) {
+        ChannelStats& stats = result.channels[c];
+        float min = std::numeric_limits<float>::infinity();
+        float max = -std::numeric_limits<float>::infinity();
+        double sum = 0.0;
+        double sumSq = 0.0;
+        if (binning.enabled) {
+            stats.histogram.assign(static_cast<size_t>(binning.bins), 0);
+        }
+
+        for (const Partial& partial : partials) {
+            min = (std::min)(min, partial.min[c]);
+            max = (std::max)(max, partial.max[c]);
+            sum += partial.sum[c];
+            sumSq += partial.sumSq[c];
+            stats.nanCount += partial.nan[c];
+            stats.belowCount += partial.below[c];
+            stats.aboveCount += partial.above[c];
+            if (!partial.histogram.empty()) {
+                const uint32_t* bins = partial.histogram.data() + static_cast<size_t>(c) * binning.bins;
+                for (int i = 0; i < binning.bins; ++i) {
+                    stats.histogram[static_cast<size_t>(i)] += bins[i];
+                }
+            }
+        }
+
+        uint64_t count = result.pixels - stats.nanCount;
+        if (count == 0) {
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            stats.min = stats.max = stats.mean = stats.stddev = nan;
+            continue;
+        }
+        stats.min = min;
+        stats.max = max;
+        stats.mean = sum / static_cast<double>(count);
+        double variance = sumSq / static_cast<double>(count) - stats.mean * stats.mean;
+        stats.stddev = std::sqrt((std::max)(variance, 0.0));
+    }
+    return result;
+}
+
+} // namespace ImageStats
+} // namespace PyAE
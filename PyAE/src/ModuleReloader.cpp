@@ -0,0 +1,583 @@
+// ModuleReloader.cpp
+// PyAE - Python for After Effects
+// ユーザーモジュールのホットリロード実装
+
+#include "ModuleReloader.h"
+#include "PythonHost.h"
+#include "ScriptRunner.h"
+#include "IdleHandler.h"
+#include "StringUtils.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <deque>
+#include <cwctype>
+
+namespace fs = std::filesystem;
+
+namespace PyAE {
+
+// ===============================================
+// 定数定義
+// ===============================================
+
+// ポーリング間隔の下限
+static constexpr std::chrono::milliseconds MIN_POLL_INTERVAL{50};
+
+// Stop() の応答性のためのスリープ単位
+static constexpr std::chrono::milliseconds WATCH_SLEEP_SLICE{50};
+
+// ===============================================
+// パスユーティリティ
+// ===============================================
+
+namespace {
+
+// 比較用にパスを正規化（Windowsでは大文字小文字を区別しない）
+std::wstring NormalizePathKey(const fs::path& path) {
+    std::error_code ec;
+    fs::path canonical = fs::weakly_canonical(path, ec);
+    if (ec) {
+        canonical = path.lexically_normal();
+    }
+    std::wstring key = canonical.make_preferred().wstring();
+#ifdef _WIN32
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+#endif
+    return key;
+}
+
+bool IsUnderDirectory(const std::wstring& fileKey, const std::wstring& dirKey) {
+    if (dirKey.empty() || fileKey.size() <= dirKey.size()) {
+        return false;
+    }
+    if (fileKey.compare(0, dirKey.size(), dirKey) != 0) {
+        return false;
+    }
+    wchar_t last = dirKey.back();
+    if (last == fs::path::preferred_separator) {
+        return true;
+    }
+    return fileKey[dirKey.size()] == fs::path::preferred_separator;
+}
+
+// sys.modules からスクリプトディレクトリ配下のモジュールを収集
+// 戻り値: モジュール名 -> 正規化済みファイルパス
+std::map<std::string, std::wstring> CollectUserModules(const std::vector<fs::path>& dirs) {
+    std::vector<std::wstring> dirKeys;
+    dirKeys.reserve(dirs.size());
+    for (const auto& dir : dirs) {
+        dirKeys.push_back(NormalizePathKey(dir));
+    }
+
+    std::map<std::string, std::wstring> result;
+    py::dict modules = py::module_::import("sys").attr("modules").attr("copy")();
+
+    for (auto item : modules) {
+        if (!py::isinstance<py::str>(item.first)) {
+            continue;
+        }
+        std::string name = item.first.cast<std::string>();
+        if (name == "__main__") {
+            continue;
+        }
+
+        py::object file = py::getattr(item.second, "__file__", py::none());
+        if (!py::isinstance<py::str>(file)) {
+            continue;
+        }
+
+        std::wstring fileKey = NormalizePathKey(
+            fs::path(StringUtils::Utf8ToWide(file.cast<std::string>())));
+        for (const auto& dirKey : dirKeys) {
+            if (IsUnderDirectory(fileKey, dirKey)) {
+                result.emplace(std::move(name), std::move(fileKey));
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+// 相対importを絶対モジュール名に解決
+std::string ResolveImportFrom(const std::string& package, const std::string& module, int level) {
+    if (level <= 0) {
+        return module;
+    }
+
+    std::string base = package;
+    for (int i = 1; i < level; ++i) {
+        size_t pos = base.rfind('.');
+        if (pos == std::string::npos) {
+            return module;  // パッケージ外への相対import（解決不能）
+        }
+        base.erase(pos);
+    }
+    if (module.empty()) {
+        return base;
+    }
+    return base.empty() ? module : base + "." + module;
+}
+
+// ソースのimport文から依存モジュール名を抽出（ast解析）
+void CollectSourceImports(py::handle module, const std::string& fileUtf8,
+                          std::set<std::string>& out) {
+    py::module_ ast = py::module_::import("ast");
+    py::object importType = ast.attr("Import");
+    py::object importFromType = ast.attr("ImportFrom");
+
+    // tokenize.open はPEP 263のエンコーディング宣言を解釈する
+    py::object f = py::module_::import("tokenize").attr("open")(fileUtf8);
+    std::string source;
+    try {
+        source = f.attr("read")().cast<std::string>();
+    } catch (...) {
+        f.attr("close")();
+        throw;
+    }
+    f.attr("close")();
+
+    py::object tree = ast.attr("parse")(source, fileUtf8);
+
+    py::object packageObj = py::getattr(module, "__package__", py::none());
+    std::string package = py::isinstance<py::str>(packageObj) ? packageObj.cast<std::string>() : "";
+
+    for (py::handle node : ast.attr("walk")(tree)) {
+        if (py::isinstance(node, importType)) {
+            for (py::handle alias : node.attr("names")) {
+                out.insert(alias.attr("name").cast<std::string>());
+            }
+        } else if (py::isinstance(node, importFromType)) {
+            py::object moduleObj = node.attr("module");
+            std::string base = ResolveImportFrom(
+                package,
+                moduleObj.is_none() ? "" : moduleObj.cast<std::string>(),
+                node.attr("level").cast<int>());
+            if (base.empty()) {
+                continue;
+            }
+            out.insert(base);
+            // from pkg import submodule の場合に備えて候補も追加（後でユーザーモジュールで絞り込む）
+            for (py::handle alias : node.attr("names")) {
+                out.insert(base + "." + alias.attr("name").cast<std::string>());
+            }
+        }
+    }
+}
+
+// モジュール名前空間の参照から依存モジュール名を抽出
+// （import済みモジュールオブジェクト、および from x import Class/func の定義元）
+void CollectNamespaceReferences(py::handle module, std::set<std::string>& out) {
+    py::dict ns = module.attr("__dict__");
+    for (auto item : ns) {
+        PyObject* value = item.second.ptr();
+        py::object owner;
+        if (PyModule_Check(value)) {
+            owner = py::getattr(item.second, "__name__", py::none());
+        } else if (PyType_Check(value) || PyFunction_Check(value)) {
+            owner = py::getattr(item.second, "__module__", py::none());
+        }
+        if (owner && py::isinstance<py::str>(owner)) {
+            out.insert(owner.cast<std::string>());
+        }
+    }
+}
+
+} // anonymous namespace
+
+// ===============================================
+// ModuleReloader実装
+// ===============================================
+
+void ModuleReloader::Shutdown() {
+    Stop();
+    ClearReloadCallback();
+
+    WinLockGuard lock(m_mutex);
+    m_pendingFiles.clear();
+    m_watchDirs.clear();
+}
+
+bool ModuleReloader::Start(std::chrono::milliseconds pollInterval) {
+    if (m_running.load()) {
+        PYAE_LOG_WARNING("ModuleReloader", "Already watching");
+        return true;
+    }
+
+    const auto& scriptDirs = ScriptRunner::Instance().GetScriptDirectories();
+    if (scriptDirs.empty()) {
+        PYAE_LOG_WARNING("ModuleReloader", "No script directories to watch");
+        return false;
+    }
+
+    {
+        WinLockGuard lock(m_mutex);
+        m_watchDirs = scriptDirs;
+    }
+    m_pollInterval = (std::max)(pollInterval, MIN_POLL_INTERVAL);
+
+    m_running.store(true);
+    m_watchThread = std::thread(&ModuleReloader::WatchLoop, this);
+
+    PYAE_LOG_INFO("ModuleReloader", "Hot reload watching " + std::to_string(scriptDirs.size()) +
+                  " directories (interval=" + std::to_string(m_pollInterval.count()) + "ms)");
+    return true;
+}
+
+void ModuleReloader::Stop() {
+    if (!m_running.exchange(false)) {
+        return;
+    }
+
+    if (m_watchThread.joinable()) {
+        m_watchThread.join();
+    }
+
+    PYAE_LOG_INFO("ModuleReloader", "Hot reload stopped");
+}
+
+std::vector<fs::path> ModuleReloader::GetWatchDirectories() const {
+    {
+        WinLockGuard lock(m_mutex);
+        if (!m_watchDirs.empty()) {
+            return m_watchDirs;
+        }
+    }
+    // 未監視時はScriptRunnerの現在の設定を使う（メインスレッド）
+    return ScriptRunner::Instance().GetScriptDirectories();
+}
+
+void ModuleReloader::SetReloadCallback(ReloadCallback callback) {
+    WinLockGuard lock(m_mutex);
+    m_callback = std::move(callback);
+}
+
+void ModuleReloader::ClearReloadCallback() {
+    ReloadCallback old;
+    {
+        WinLockGuard lock(m_mutex);
+        old.swap(m_callback);
+    }
+    // Pythonコールバックの破棄はロック外で行う
+}
+
+// ===============================================
+// 監視スレッド
+// ===============================================
+
+ModuleReloader::FileTimes ModuleReloader::ScanFiles(const std::vector<fs::path>& dirs) {
+    FileTimes result;
+
+    for (const auto& dir : dirs) {
+        std::error_code ec;
+        fs::recursive_directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec);
+        if (ec) {
+            continue;
+        }
+
+        for (fs::recursive_directory_iterator end; it != end; it.increment(ec)) {
+            if (ec) {
+                break;
+            }
+
+            const fs::path& path = it->path();
+            if (it->is_directory(ec)) {
+                auto name = path.filename().native();
+                if (!name.empty() && (name[0] == '.' || path.filename() == "__pycache__")) {
+                    it.disable_recursion_pending();
+                }
+                continue;
+            }
+
+            if (path.extension() != ".py") {
+                continue;
+            }
+
+            auto mtime = it->last_write_time(ec);
+            if (!ec) {
+                result.emplace(path, mtime);
+            }
+        }
+    }
+    return result;
+}
+
+void ModuleReloader::WatchLoop() {
+    std::vector<fs::path> dirs;
+    {
+        WinLockGuard lock(m_mutex);
+        dirs = m_watchDirs;
+    }
+
+    FileTimes previous = ScanFiles(dirs);
+
+    while (m_running.load()) {
+        // Stop() に素早く応答できるよう細切れにスリープ
+        auto deadline = std::chrono::steady_clock::now() + m_pollInterval;
+        while (m_running.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(WATCH_SLEEP_SLICE);
+        }
+        if (!m_running.load()) {
+            break;
+        }
+
+        FileTimes current = ScanFiles(dirs);
+
+        std::vector<fs::path> changed;
+        for (const auto& [path, mtime] : current) {
+            auto found = previous.find(path);
+            if (found == previous.end() || found->second != mtime) {
+                changed.push_back(path);
+            }
+        }
+        previous = std::move(current);
+
+        if (changed.empty()) {
+            continue;
+        }
+
+        {
+            WinLockGuard lock(m_mutex);
+            m_pendingFiles.insert(changed.begin(), changed.end());
+        }
+
+        // 適用はメインスレッドのアイドル処理で1回にまとめる
+        if (!m_applyScheduled.exchange(true)) {
+            IdleHandler::Instance().EnqueueTask(
+                [this]() { ApplyPendingChanges(); },
+                TaskPriority::Normal, "ModuleReloader::ApplyPendingChanges");
+        }
+    }
+}
+
+// ===============================================
+// リロード処理（メインスレッド）
+// ===============================================
+
+void ModuleReloader::ApplyPendingChanges() {
+    m_applyScheduled.store(false);
+
+    std::vector<fs::path> files;
+    {
+        WinLockGuard lock(m_mutex);
+        files.assign(m_pendingFiles.begin(), m_pendingFiles.end());
+        m_pendingFiles.clear();
+    }
+
+    auto& host = PythonHost::Instance();
+    if (files.empty() || !host.IsInitialized() || host.IsShuttingDown()) {
+        return;
+    }
+
+    ReloadResult result = ReloadChangedFiles(files);
+    if (result.reloaded.empty() && result.failed.empty() && result.skipped.empty()) {
+        return;  // 未importのファイルのみ変更された
+    }
+
+    ReloadCallback callback;
+    {
+        WinLockGuard lock(m_mutex);
+        callback = m_callback;
+    }
+    if (!callback) {
+        return;
+    }
+
+    try {
+        ScopedGIL gil;
+        callback(result);
+    } catch (const py::error_already_set& e) {
+        PYAE_LOG_ERROR("ModuleReloader", std::string("Reload callback failed: ") + e.what());
+    } catch (const std::exception& e) {
+        PYAE_LOG_ERROR("ModuleReloader", std::string("Reload callback failed: ") + e.what());
+    }
+}
+
+std::map<std::string, std::set<std::string>> ModuleReloader::BuildDependencyGraph(
+    const std::vector<fs::path>& dirs) const
+{
+    auto userModules = CollectUserModules(dirs);
+    py::dict modules = py::module_::import("sys").attr("modules");
+
+    std::map<std::string, std::set<std::string>> graph;
+    for (const auto& [name, fileKey] : userModules) {
+        auto& deps = graph[name];
+        if (!modules.contains(name)) {
+            continue;
+        }
+        py::object module = modules[py::str(name)];
+
+        std::set<std::string> candidates;
+        try {
+            CollectNamespaceReferences(module, candidates);
+            py::object file = py::getattr(module, "__file__", py::none());
+            if (py::isinstance<py::str>(file)) {
+                CollectSourceImports(module, file.cast<std::string>(), candidates);
+            }
+        } catch (const py::error_already_set& e) {
+            // 構文エラー中のファイル等。名前空間参照だけで続行
+            PYAE_LOG_DEBUG("ModuleReloader", "Import scan failed for " + name + ": " + e.what());
+        }
+
+        for (const auto& dep : candidates) {
+            if (dep == name || !userModules.count(dep)) {
+                continue;
+            }
+            // 親パッケージへの辺は相対importの副産物なので除外（親->子の辺で循環するため）
+            bool isAncestor = dep.size() < name.size() &&
+                              name.compare(0, dep.size(), dep) == 0 &&
+                              name[dep.size()] == '.';
+            if (!isAncestor) {
+                deps.insert(dep);
+            }
+        }
+    }
+    return graph;
+}
+
+ReloadResult ModuleReloader::ReloadChangedFiles(const std::vector<fs::path>& changedFiles) {
+    ScopedGIL gil;
+
+    auto dirs = GetWatchDirectories();
+
+    std::set<std::wstring> changedKeys;
+    for (const auto& file : changedFiles) {
+        changedKeys.insert(NormalizePathKey(file));
+    }
+
+    std::set<std::string> changedModules;
+    for (const auto& [name, fileKey] : CollectUserModules(dirs)) {
+        if (changedKeys.count(fileKey)) {
+            changedModules.insert(name);
+        }
+    }
+
+    if (changedModules.empty()) {
+        return {};
+    }
+    return ReloadAffected(changedModules, dirs);
+}
+
+ReloadResult ModuleReloader::ReloadModules(const std::vector<std::string>& moduleNames) {
+    ScopedGIL gil;
+    return ReloadAffected(std::set<std::string>(moduleNames.begin(), moduleNames.end()),
+                          GetWatchDirectories());
+}
+
+ReloadResult ModuleReloader::ReloadAffected(const std::set<std::string>& changedModules,
+                                            const std::vector<fs::path>& dirs)
+{
+    ReloadResult result;
+
+    auto graph = BuildDependencyGraph(dirs);
+
+    // 逆依存（被import側 -> import側）をたどって影響範囲を求める
+    std::map<std::string, std::vector<std::string>> dependents;
+    for (const auto& [name, deps] : graph) {
+        for (const auto& dep : deps) {
+            dependents[dep].push_back(name);
+        }
+    }
+
+    std::set<std::string> affected;
+    std::deque<std::string> queue;
+    for (const auto& name : changedModules) {
+        if (graph.count(name) && affected.insert(name).second) {
+            queue.push_back(name);
+        } else if (!graph.count(name)) {
+            PYAE_LOG_WARNING("ModuleReloader", "Not a loaded user module: " + name);
+        }
+    }
+    while (!queue.empty()) {
+        std::string current = std::move(queue.front());
+        queue.pop_front();
+        for (const auto& dependent : dependents[current]) {
+            if (affected.insert(dependent).second) {
+                queue.push_back(dependent);
+            }
+        }
+    }
+
+    // トポロジカルソート（依存先が先、同順位は名前順で決定的に）
+    std::map<std::string, int> inDegree;
+    for (const auto& name : affected) {
+        int count = 0;
+        for (const auto& dep : graph[name]) {
+            if (affected.count(dep)) {
+                ++count;
+            }
+        }
+        inDegree[name] = count;
+    }
+
+    std::set<std::string> ready;
+    for (const auto& [name, count] : inDegree) {
+        if (count == 0) {
+            ready.insert(name);
+        }
+    }
+
+    std::vector<std::string> order;
+    order.reserve(affected.size());
+    while (!ready.empty()) {
+        std::string name = *ready.begin();
+        ready.erase(ready.begin());
+        order.push_back(name);
+        for (const auto& dependent : dependents[name]) {
+            auto found = inDegree.find(dependent);
+            if (found != inDegree.end() && --found->second == 0) {
+                ready.insert(dependent);
+            }
+        }
+    }
+
+    // 循環importは順序を決められないため名前順で末尾に追加
+    if (order.size() < affected.size()) {
+        for (const auto& [name, count] : inDegree) {
+            if (count > 0) {
+                order.push_back(name);
+            }
+        }
+        PYAE_LOG_WARNING("ModuleReloader", "Import cycle detected; reloading cycle members in name order");
+    }
+
+    // リロード実行
+    py::module_ importlib = py::module_::import("importlib");
+    importlib.attr("invalidate_caches")();
+    py::dict modules = py::module_::import("sys").attr("modules");
+
+    std::set<std::string> broken;
+    for (const auto& name : order) {
+        bool blocked = false;
+        for (const auto& dep : graph[name]) {
+            if (broken.count(dep)) {
+                blocked = true;
+                break;
+            }
+        }
+        if (blocked || !modules.contains(name)) {
+            result.skipped.push_back(name);
+            broken.insert(name);
+            continue;
+        }
+
+        try {
+            importlib.attr("reload")(modules[py::str(name)]);
+            result.reloaded.push_back(name);
+        } catch (const py::error_already_set& e) {
+            result.failed.emplace_back(name, e.what());
+            broken.insert(name);
+            PYAE_LOG_ERROR("ModuleReloader", "Failed to reload " + name + ": " + e.what());
+        }
+    }
+
+    m_reloadCount.fetch_add(result.reloaded.size());
+
+    PYAE_LOG_INFO("ModuleReloader", "Reloaded " + std::to_string(result.reloaded.size()) +
+                  " modules (failed=" + std::to_string(result.failed.size()) +
+                  ", skipped=" + std::to_string(result.skipped.size()) + ")");
+    return result;
+}
+
+} // namespace PyAE
@@ -0,0 +1,876 @@
+// PixelConvert.cpp
+// PyAE - Python for After Effects
+// ピクセル形式変換カーネル
+//
+// 各行を float RGBA の作業バッファに展開し、アルファ処理の後で変換先の
+// 形式に書き出す。同じ型どうしの並べ替えは float を経由せずバイト単位で
+// 入れ替える。SIMD カーネルはブロック単位で処理した画素数を返し、
+// 端数はスカラー実装が処理する（丸め・クランプの結果はどの実装でも同じ）。
+
+#include "PixelConvert.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define PYAE_PIXEL_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC / Clang では命令セットごとに関数単位で有効化する（MSVC は不要）
+#if defined(PYAE_PIXEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PYAE_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define PYAE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PYAE_TARGET_SSE41
+#define PYAE_TARGET_AVX2
+#endif
+
+namespace PyAE {
+namespace PixelConvert {
+
+namespace {
+
+// =============================================================
+// Layout / depth helpers
+// =============================================================
+
+// レイアウト内の R, G, B, A（channel = 0..3）の位置
+constexpr int SlotOf(Layout layout, int channel) {
+    switch (layout) {
+        case Layout::ARGB: return (channel + 1) & 3;
+        case Layout::BGRA: return channel == 3 ? 3 : 2 - channel;
+        default: return channel;
+    }
+}
+
+// レイアウトの slot 位置にある RGBA のチャンネル
+constexpr int ChannelAt(Layout layout, int slot) {
+    switch (layout) {
+        case Layout::ARGB: return (slot + 3) & 3;
+        case Layout::BGRA: return slot == 3 ? 3 : 2 - slot;
+        default: return slot;
+    }
+}
+
+constexpr float kToFloat8 = 1.0f / 255.0f;
+constexpr float kToFloat16 = 1.0f / 32768.0f;
+
+struct Row {
+    uint8_t* data;
+    ptrdiff_t planeBytes;
+    Depth depth;
+    Layout layout;
+};
+
+// 変換先の値域にクランプして最近接偶数に丸める（SIMD の cvtps と同じ）
+inline float Clamp(float v, float hi) {
+    v = v < hi ? v : hi;  // NaN は hi
+    return v > 0.0f ? v : 0.0f;
+}
+
+// =============================================================
+// Scalar
+// =============================================================
+
+template <typename T>
+void DecodeScalarT(const Row& src, int x0, int width, float scale, float* out) {
+    if (src.layout == Layout::Planar) {
+        for (int c = 0; c < 4; ++c) {
+            const T* plane = reinterpret_cast<const T*>(src.data + c * src.planeBytes);
+            for (int x = x0; x < width; ++x) {
+                out[x * 4 + c] = static_cast<float>(plane[x]) * scale;
+            }
+        }
+        return;
+    }
+    const T* p = reinterpret_cast<const T*>(src.data);
+    const int slot[4] = {SlotOf(src.layout, 0), SlotOf(src.layout, 1),
+                         SlotOf(src.layout, 2), SlotOf(src.layout, 3)};
+    for (int x = x0; x < width; ++x) {
+        for (int c = 0; c < 4; ++c) {
+            out[x * 4 + c] = static_cast<float>(p[x * 4 + slot[c]]) * scale;
+        }
+    }
+}
+
+void DecodeScalar(const Row& src, int x0, int width, float* out) {
+    switch (src.depth) {
+        case Depth::U8: DecodeScalarT<uint8_t>(src, x0, width, kToFloat8, out); break;
+        case Depth::U16: DecodeScalarT<uint16_t>(src, x0, width, kToFloat16, out); break;
+        case Depth::F32: DecodeScalarT<float>(src, x0, width, 1.0f, out); break;
+    }
+}
+
+template <typename T>
+T FromFloat(float v, Depth depth) {
+    switch (depth) {
+        case Depth::U8: return static_cast<T>(std::lrint(Clamp(v * 255.0f, 255.0f)));
+        case Depth::U16: return static_cast<T>(std::lrint(Clamp(v * 32768.0f, 32768.0f)));
+        default: return static_cast<T>(v);
+    }
+}
+
+template <typename T>
+void EncodeScalarT(const float* in, int x0, int width, const Row& dst) {
+    if (dst.layout == Layout::Planar) {
+        for (int c = 0; c < 4; ++c) {
+            T* plane = reinterpret_cast<T*>(dst.data + c * dst.planeBytes);
+            for (int x = x0; x < width; ++x) {
+                plane[x] = FromFloat<T>(in[x * 4 + c], dst.depth);
+            }
+        }
+        return;
+    }
+    T* p = reinterpret_cast<T*>(dst.data);
+    const int slot[4] = {SlotOf(dst.layout, 0), SlotOf(dst.layout, 1),
+                         SlotOf(dst.layout, 2), SlotOf(dst.layout, 3)};
+    for (int x = x0; x < width; ++x) {
+        for (int c = 0; c < 4; ++c) {
+            p[x * 4 + slot[c]] = FromFloat<T>(in[x * 4 + c], dst.depth);
+        }
+    }
+}
+
+void EncodeScalar(const float* in, int x0, int width, const Row& dst) {
+    switch (dst.depth) {
+        case Depth::U8: EncodeScalarT<uint8_t>(in, x0, width, dst); break;
+        case Depth::U16: EncodeScalarT<uint16_t>(in, x0, width, dst); break;
+        case Depth::F32: EncodeScalarT<float>(in, x0, width, dst); break;
+    }
+}
+
+void AlphaScalar(float* px, int x0, int width, AlphaOp op) {
+    for (int x = x0; x < width; ++x) {
+        float* p = px + x * 4;
+        float a = p[3];
+        if (op == AlphaOp::Premultiply) {
+            p[0] *= a;
+            p[1] *= a;
+            p[2] *= a;
+        } else if (a > 0.0f) {
+            p[0] /= a;
+            p[1] /= a;
+            p[2] /= a;
+        } else {
+            p[0] = p[1] = p[2] = 0.0f;
+        }
+    }
+}
+
+template <typename T>
+void SwizzleScalarT(const Row& src, int x0, int width, const Row& dst) {
+    const T* s = reinterpret_cast<const T*>(src.data);
+    T* d = reinterpret_cast<T*>(dst.data);
+    int from[4];
+    for (int slot = 0; slot < 4; ++slot) {
+        from[slot] = SlotOf(src.layout, ChannelAt(dst.layout, slot));
+    }
+    for (int x = x0; x < width; ++x) {
+        for (int slot = 0; slot < 4; ++slot) {
+            d[x * 4 + slot] = s[x * 4 + from[slot]];
+        }
+    }
+}
+
+void SwizzleScalar(const Row& src, int x0, int width, const Row& dst) {
+    switch (src.depth) {
+        case Depth::U8: SwizzleScalarT<uint8_t>(src, x0, width, dst); break;
+        case Depth::U16: SwizzleScalarT<uint16_t>(src, x0, width, dst); break;
+        case Depth::F32: SwizzleScalarT<float>(src, x0, width, dst); break;
+    }
+}
+
+#ifdef PYAE_PIXEL_X86
+
+// =============================================================
+// Shuffle masks
+// =============================================================
+
+// 16バイト内の各画素について、to の slot に from の対応チャンネルを置く pshufb マスク
+// （from / to のどちらかが RGBA の場合はデコード / エンコード用になる）
+struct ShuffleMask {
+    alignas(16) uint8_t bytes[16];
+};
+
+ShuffleMask MakeMask(Layout from, Layout to, size_t elemSize) {
+    ShuffleMask mask;
+    const size_t pixelBytes = elemSize * 4;
+    for (size_t i = 0; i < 16; ++i) {
+        size_t pixel = i / pixelBytes;
+        size_t slot = (i % pixelBytes) / elemSize;
+        size_t byte = i % elemSize;
+        size_t fromSlot = static_cast<size_t>(SlotOf(from, ChannelAt(to, static_cast<int>(slot))));
+        mask.bytes[i] = static_cast<uint8_t>(pixel * pixelBytes + fromSlot * elemSize + byte);
+    }
+    return mask;
+}
+
+// =============================================================
+// SSE4.1
+// =============================================================
+
+PYAE_TARGET_SSE41
+inline __m128 ToFloatSSE(__m128i v, __m128 scale) {
+    return _mm_mul_ps(_mm_cvtepi32_ps(v), scale);
+}
+
+PYAE_TARGET_SSE41
+inline __m128i ToIntSSE(__m128 v, __m128 scale, __m128 hi) {
+    __m128 s = _mm_mul_ps(v, scale);
+    s = _mm_max_ps(_mm_min_ps(s, hi), _mm_setzero_ps());
+    return _mm_cvtps_epi32(s);
+}
+
+// プレーナー 4画素分を1チャンネル読み込む
+PYAE_TARGET_SSE41
+inline __m128 LoadPlaneSSE(const uint8_t* plane, int x, Depth depth) {
+    switch (depth) {
+        case Depth::U8: {
+            int32_t raw;
+            std::memcpy(&raw, plane + x, 4);
+            return ToFloatSSE(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(raw)), _mm_set1_ps(kToFloat8));
+        }
+        case Depth::U16:
+            return ToFloatSSE(
+                _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(plane + x * 2))),
+                _mm_set1_ps(kToFloat16));
+        default:
+            return _mm_loadu_ps(reinterpret_cast<const float*>(plane) + x);
+    }
+}
+
+PYAE_TARGET_SSE41
+inline void StorePlaneSSE(uint8_t* plane, int x, Depth depth, __m128 v) {
+    switch (depth) {
+        case Depth::U8: {
+            __m128i i = ToIntSSE(v, _mm_set1_ps(255.0f), _mm_set1_ps(255.0f));
+            i = _mm_packus_epi16(_mm_packs_epi32(i, i), _mm_setzero_si128());
+            int32_t raw = _mm_cvtsi128_si32(i);
+            std::memcpy(plane + x, &raw, 4);
+            break;
+        }
+        case Depth::U16: {
+            __m128i i = ToIntSSE(v, _mm_set1_ps(32768.0f), _mm_set1_ps(32768.0f));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(plane + x * 2), _mm_packus_epi32(i, i));
+            break;
+        }
+        default:
+            _mm_storeu_ps(reinterpret_cast<float*>(plane) + x, v);
+            break;
+    }
+}
+
+PYAE_TARGET_SSE41
+int DecodePlanarSSE41(const Row& src, int width, float* out) {
+    const uint8_t* planes[4] = {src.data, src.data + src.planeBytes,
+                                src.data + 2 * src.planeBytes, src.data + 3 * src.planeBytes};
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        __m128 r = LoadPlaneSSE(planes[0], x, src.depth);
+        __m128 g = LoadPlaneSSE(planes[1], x, src.depth);
+        __m128 b = LoadPlaneSSE(planes[2], x, src.depth);
+        __m128 a = LoadPlaneSSE(planes[3], x, src.depth);
+        _MM_TRANSPOSE4_PS(r, g, b, a);
+        _mm_storeu_ps(out + x * 4, r);
+        _mm_storeu_ps(out + x * 4 + 4, g);
+        _mm_storeu_ps(out + x * 4 + 8, b);
+        _mm_storeu_ps(out + x * 4 + 12, a);
+    }
+    return x;
+}
+
+PYAE_TARGET_SSE41
+int EncodePlanarSSE41(const float* in, int width, const Row& dst) {
+    uint8_t* planes[4] = {dst.data, dst.data + dst.planeBytes,
+                          dst.data + 2 * dst.planeBytes, dst.data + 3 * dst.planeBytes};
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        __m128 p0 = _mm_loadu_ps(in + x * 4);
+        __m128 p1 = _mm_loadu_ps(in + x * 4 + 4);
+        __m128 p2 = _mm_loadu_ps(in + x * 4 + 8);
+        __m128 p3 = _mm_loadu_ps(in + x * 4 + 12);
+        _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+        StorePlaneSSE(planes[0], x, dst.depth, p0);
+        StorePlaneSSE(planes[1], x, dst.depth, p1);
+        StorePlaneSSE(planes[2], x, dst.depth, p2);
+        StorePlaneSSE(planes[3], x, dst.depth, p3);
+    }
+    return x;
+}
+
+PYAE_TARGET_SSE41
+int DecodeSSE41(const Row& src, int width, float* out) {
+    if (src.layout == Layout::Planar) {
+        return DecodePlanarSSE41(src, width, out);
+    }
+
+    int x = 0;
+    switch (src.depth) {
+        case Depth::U8: {
+            const __m128i mask = _mm_load_si128(
+                reinterpret_cast<const __m128i*>(MakeMask(src.layout, Layout::RGBA, 1).bytes));
+            const __m128 scale = _mm_set1_ps(kToFloat8);
+            for (; x + 4 <= width; x += 4) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.data + x * 4));
+                v = _mm_shuffle_epi8(v, mask);
+                _mm_storeu_ps(out + x * 4, ToFloatSSE(_mm_cvtepu8_epi32(v), scale));
+                _mm_storeu_ps(out + x * 4 + 4, ToFloatSSE(_mm_cvtepu8_epi32(_mm_srli_si128(v, 4)), scale));
+                _mm_storeu_ps(out + x * 4 + 8, ToFloatSSE(_mm_cvtepu8_epi32(_mm_srli_si128(v, 8)), scale));
+                _mm_storeu_ps(out + x * 4 + 12, ToFloatSSE(_mm_cvtepu8_epi32(_mm_srli_si128(v, 12)), scale));
+            }
+            break;
+        }
+        case Depth::U16: {
+            const __m128i mask = _mm_load_si128(
+                reinterpret_cast<const __m128i*>(MakeMask(src.layout, Layout::RGBA, 2).bytes));
+            const __m128 scale = _mm_set1_ps(kToFloat16);
+            for (; x + 2 <= width; x += 2) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.data + x * 8));
+                v = _mm_shuffle_epi8(v, mask);
+                _mm_storeu_ps(out + x * 4, ToFloatSSE(_mm_cvtepu16_epi32(v), scale));
+                _mm_storeu_ps(out + x * 4 + 4, ToFloatSSE(_mm_cvtepu16_epi32(_mm_srli_si128(v, 8)), scale));
+            }
+            break;
+        }
+        case Depth::F32: {
+            const __m128i mask = _mm_load_si128(
+                reinterpret_cast<const __m128i*>(MakeMask(src.layout, Layout::RGBA, 4).bytes));
+            for (; x < width; ++x) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.data + x * 16));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), _mm_shuffle_epi8(v, mask));
+            }
+            break;
+        }
+    }
+    return x;
+}
+
+PYAE_TARGET_SSE41
+int EncodeSSE41(const float* in, int width, const Row& dst) {
+    if (dst.layout == Layout::Planar) {
+        return EncodePlanarSSE41(in, width, dst);
+    }
+
+    int x = 0;
+    switch (dst.depth) {
+        case Depth::U8: {
+            const __m128i mask = _mm_load_si128(
+                reinterpret_cast<const __m128i*>(MakeMask(Layout::RGBA, dst.layout, 1).bytes));
+            const __m128 scale = _mm_set1_ps(255.0f);
+            for (; x + 4 <= width; x += 4) {
+                __m128i i0 = ToIntSSE(_mm_loadu_ps(in + x * 4), scale, scale);
+                __m128i i1 = ToIntSSE(_mm_loadu_ps(in + x * 4 + 4), scale, scale);
+                __m128i i2 = ToIntSSE(_mm_loadu_ps(in + x * 4 + 8), scale, scale);
+                __m128i i3 = ToIntSSE(_mm_loadu_ps(in + x * 4 + 12), scale, scale);
+                __m128i v = _mm_packus_epi16(_mm_packs_epi32(i0, i1), _mm_packs_epi32(i2, i3));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data + x * 4), _mm_shuffle_epi8(v, mask));
+            }
+            break;
+        }
+        case Depth::U16: {
+            const __m128i mask = _mm_load_si128(
+                reinterpret_cast<const __m128i*>(MakeMask(Layout::RGBA, dst.layout, 2).bytes));
+            const __m128 scale = _mm_set1_ps(32768.0f);
+            for (; x + 2 <= width; x += 2) {
+                __m128i i0 = ToIntSSE(_mm_loadu_ps(in + x * 4), scale, scale);
+                __m128i i1 = ToIntSSE(_mm_loadu_ps(in + x * 4 + 4), scale, scale);
+                __m128i v = _mm_packus_epi32(i0, i1);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data + x * 8), _mm_shuffle_epi8(v, mask));
+            }
+            break;
+        }
+        case Depth::F32: {
+            const __m128i mask = _mm_load_si128(
+                reinterpret_cast<const __m128i*>(MakeMask(Layout::RGBA, dst.layout, 4).bytes));
+            for (; x < width; ++x) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x * 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data + x * 16), _mm_shuffle_epi8(v, mask));
+            }
+            break;
+        }
+    }
+    return x;
+}
+
+PYAE_TARGET_SSE41
+int AlphaSSE41(float* px, int width, AlphaOp op) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    int x = 0;
+    for (; x < width; ++x) {
+        __m128 v = _mm_loadu_ps(px + x * 4);
+        __m128 a = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128 m = _mm_blend_ps(a, one, 0x8);
+        if (op == AlphaOp::Premultiply) {
+            v = _mm_mul_ps(v, m);
+        } else {
+            __m128 d = _mm_and_ps(_mm_div_ps(v, m), _mm_cmpgt_ps(a, zero));
+            v = _mm_blend_ps(d, v, 0x8);
+        }
+        _mm_storeu_ps(px + x * 4, v);
+    }
+    return x;
+}
+
+PYAE_TARGET_SSE41
+int SwizzleSSE41(const Row& src, int width, const Row& dst, size_t elemSize) {
+    const __m128i mask = _mm_load_si128(
+        reinterpret_cast<const __m128i*>(MakeMask(src.layout, dst.layout, elemSize).bytes));
+    const int step = static_cast<int>(16 / (elemSize * 4));
+    const size_t pixelBytes = elemSize * 4;
+    int x = 0;
+    for (; x + step <= width; x += step) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.data + x * pixelBytes));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data + x * pixelBytes), _mm_shuffle_epi8(v, mask));
+    }
+    return x;
+}
+
+// =============================================================
+// AVX2（インターリーブ形式。プレーナーは SSE4.1 の転置を使う）
+// =============================================================
+
+PYAE_TARGET_AVX2
+inline __m256i LoadMask256(const ShuffleMask& mask) {
+    return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(mask.bytes)));
+}
+
+PYAE_TARGET_AVX2
+inline __m256 ToFloatAVX(__m256i v, __m256 scale) {
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale);
+}
+
+PYAE_TARGET_AVX2
+inline __m256i ToIntAVX(__m256 v, __m256 scale) {
+    __m256 s = _mm256_mul_ps(v, scale);
+    s = _mm256_max_ps(_mm256_min_ps(s, scale), _mm256_setzero_ps());
+    return _mm256_cvtps_epi32(s);
+}
+
+PYAE_TARGET_AVX2
+int DecodeAVX2(const Row& src, int width, float* out) {
+    if (src.layout == Layout::Planar) {
+        return DecodePlanarSSE41(src, width, out);
+    }
+
+    int x = 0;
+    switch (src.depth) {
+        case Depth::U8: {
+            const __m256i mask = LoadMask256(MakeMask(src.layout, Layout::RGBA, 1));
+            const __m256 scale = _mm256_set1_ps(kToFloat8);
+            for (; x + 8 <= width; x += 8) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src.data + x * 4));
+                v = _mm256_shuffle_epi8(v, mask);
+                __m128i lo = _mm256_castsi256_si128(v);
+                __m128i hi = _mm256_extracti128_si256(v, 1);
+                _mm256_storeu_ps(out + x * 4, ToFloatAVX(_mm256_cvtepu8_epi32(lo), scale));
+                _mm256_storeu_ps(out + x * 4 + 8, ToFloatAVX(_mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)), scale));
+                _mm256_storeu_ps(out + x * 4 + 16, ToFloatAVX(_mm256_cvtepu8_epi32(hi), scale));
+                _mm256_storeu_ps(out + x * 4 + 24, ToFloatAVX(_mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)), scale));
+            }
+            break;
+        }
+        case Depth::U16: {
+            const __m256i mask = LoadMask256(MakeMask(src.layout, Layout::RGBA, 2));
+            const __m256 scale = _mm256_set1_ps(kToFloat16);
+            for (; x + 4 <= width; x += 4) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src.data + x * 8));
+                v = _mm256_shuffle_epi8(v, mask);
+                _mm256_storeu_ps(out + x * 4, ToFloatAVX(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(v)), scale));
+                _mm256_storeu_ps(out + x * 4 + 8,
+                                 ToFloatAVX(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1)), scale));
+            }
+            break;
+        }
+        case Depth::F32: {
+            const __m256i mask = LoadMask256(MakeMask(src.layout, Layout::RGBA, 4));
+            for (; x + 2 <= width; x += 2) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src.data + x * 16));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x * 4), _mm256_shuffle_epi8(v, mask));
+            }
+            break;
+        }
+    }
+    return x;
+}
+
+PYAE_TARGET_AVX2
+int EncodeAVX2(const float* in, int width, const Row& dst) {
+    if (dst.layout == Layout::Planar) {
+        return EncodePlanarSSE41(in, width, dst);
+    }
+
+    int x = 0;
+    switch (dst.depth) {
+        case Depth::U8: {
+            const __m256i mask = LoadMask256(MakeMask(Layout::RGBA, dst.layout, 1));
+            const __m256 scale = _mm256_set1_ps(255.0f);
+            // pack はレーン単位のため、画素の順序を戻す
+            const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+            for (; x + 8 <= width; x += 8) {
+                __m256i i0 = ToIntAVX(_mm256_loadu_ps(in + x * 4), scale);
+                __m256i i1 = ToIntAVX(_mm256_loadu_ps(in + x * 4 + 8), scale);
+                __m256i i2 = ToIntAVX(_mm256_loadu_ps(in + x * 4 + 16), scale);
+                __m256i i3 = ToIntAVX(_mm256_loadu_ps(in + x * 4 + 24), scale);
+                __m256i v = _mm256_packus_epi16(_mm256_packs_epi32(i0, i1), _mm256_packs_epi32(i2, i3));
+                v = _mm256_permutevar8x32_epi32(v, order);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst.data + x * 4), _mm256_shuffle_epi8(v, mask));
+            }
+            break;
+        }
+        case Depth::U16: {
+            const __m256i mask = LoadMask256(MakeMask(Layout::RGBA, dst.layout, 2));
+            const __m256 scale = _mm256_set1_ps(32768.0f);
+            for (; x + 4 <= width; x += 4) {
+                __m256i i0 = ToIntAVX(_mm256_loadu_ps(in + x * 4), scale);
+                __m256i i1 = ToIntAVX(_mm256_loadu_ps(in + x * 4 + 8), scale);
+                __m256i v = _mm256_permute4x64_epi64(_mm256_packus_epi32(i0, i1), _MM_SHUFFLE(3, 1, 2, 0));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst.data + x * 8), _mm256_shuffle_epi8(v, mask));
+            }
+            break;
+        }
+        case Depth::F32: {
+            const __m256i mask = LoadMask256(MakeMask(Layout::RGBA, dst.layout, 4));
+            for (; x + 2 <= width; x += 2) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + x * 4));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst.data + x * 16), _mm256_shuffle_epi8(v, mask));
+            }
+            break;
+        }
+    }
+    return x;
+}
+
+PYAE_TARGET_AVX2
+int AlphaAVX2(float* px, int width, AlphaOp op) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    int x = 0;
+    for (; x + 2 <= width; x += 2) {
+        __m256 v = _mm256_loadu_ps(px + x * 4);
+        __m256 a = _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3));
+        __m256 m = _mm256_blend_ps(a, one, 0x88);
+        if (op == AlphaOp::Premultiply) {
+            v = _mm256_mul_ps(v, m);
+        } else {
+            __m256 d = _mm256_and_ps(_mm256_div_ps(v, m), _mm256_cmp_ps(a, zero, _CMP_GT_OQ));
+            v = _mm256_blend_ps(d, v, 0x88);
+        }
+        _mm256_storeu_ps(px + x * 4, v);
+    }
+    return x;
+}
+
+PYAE_TARGET_AVX2
+int SwizzleAVX2(const Row& src, int width, const Row& dst, size_t elemSize) {
+    const __m256i mask = LoadMask256(MakeMask(src.layout, dst.layout, elemSize));
+    const int step = static_cast<int>(32 / (elemSize * 4));
+    const size_t pixelBytes = elemSize * 4;
+    int x = 0;
+    for (; x + step <= width; x += step) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src.data + x * pixelBytes));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst.data + x * pixelBytes), _mm256_shuffle_epi8(v, mask));
+    }
+    return x;
+}
+
+// =============================================================
+// CPU detection
+// =============================================================
+
+Isa DetectIsa() {
+    bool sse41 = false;
+    bool avx2 = false;
+#ifdef _MSC_VER
+    int info[4] = {0};
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    sse41 = (info[2] & (1 << 19)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    // OS が YMM レジスタを保存する場合のみ AVX2 を使う
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    sse41 = __builtin_cpu_supports("sse4.1");
+    avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2 && sse41) return Isa::AVX2;
+    if (sse41) return Isa::SSE41;
+    return Isa::Scalar;
+}
+
+#else
+
+Isa DetectIsa() {
+    return Isa::Scalar;
+}
+
+#endif // PYAE_PIXEL_X86
+
+Isa SupportedIsa() {
+    static const Isa supported = DetectIsa();
+    return supported;
+}
+
+std::atomic<int> g_isa{-1};
+
+// =============================================================
+// Row dispatch
+// =============================================================
+
+void DecodeRow(Isa isa, const Row& src, int width, float* out) {
+    int done = 0;
+#ifdef PYAE_PIXEL_X86
+    if (isa == Isa::AVX2) done = DecodeAVX2(src, width, out);
+    else if (isa == Isa::SSE41) done = DecodeSSE41(src, width, out);
+#endif
+    DecodeScalar(src, done, width, out);
+}
+
+void EncodeRow(Isa isa, const float* in, int width, const Row& dst) {
+    int done = 0;
+#ifdef PYAE_PIXEL_X86
+    if (isa == Isa::AVX2) done = EncodeAVX2(in, width, dst);
+    else if (isa == Isa::SSE41) done = EncodeSSE41(in, width, dst);
+#endif
+    EncodeScalar(in, done, width, dst);
+}
+
+void AlphaRow(Isa isa, float* px, int width, AlphaOp op) {
+    int done = 0;
+#ifdef PYAE_PIXEL_X86
+    if (isa == Isa::AVX2) done = AlphaAVX2(px, width, op);
+    else if (isa == Isa::SSE41) done = AlphaSSE41(px, width, op);
+#endif
+    AlphaScalar(px, done, width, op);
+}
+
+void SwizzleRow(Isa isa, const Row& src, int width, const Row& dst) {
+    int done = 0;
+#ifdef PYAE_PIXEL_X86
+    size_t elemSize = ChannelBytes(src.depth);
+    if (isa == Isa::AVX2) done = SwizzleAVX2(src, width, dst, elemSize);
+    else if (isa == Isa::SSE41) done = SwizzleSSE41(src, width, dst, elemSize);
+#endif
+    SwizzleScalar(src, done, width, dst);
+}
+
+// 1スレッドあたり最低この画素数になるよう行を分割する
+int MinParallelRows(int width) {
+    constexpr int kMinPixelsPerTask = 1 << 16;
+    return std::max(1, kMinPixelsPerTask / std::max(1, width));
+}
+
+void Validate(const ImageView& image, const char* what) {
+    if (!image.data || image.width <= 0 || image.height <= 0) {
+        throw std::invalid_argument(std::string(what) + ": empty image");
+    }
+    ptrdiff_t minRow = static_cast<ptrdiff_t>(image.width) *
+        static_cast<ptrdiff_t>(ChannelBytes(image.depth)) * (image.layout == Layout::Planar ? 1 : 4);
+    if (image.rowBytes < minRow) {
+        throw std::invalid_argument(std::string(what) + ": row stride is smaller than a row");
+    }
+    if (image.layout == Layout::Planar &&
+        image.planeBytes < image.rowBytes * static_cast<ptrdiff_t>(image.height)) {
+        throw std::invalid_argument(std::string(what) + ": plane stride is smaller than a plane");
+    }
+}
+
+// image が参照するメモリ範囲 [begin, end)
+std::pair<uintptr_t, uintptr_t> ByteRange(const ImageView& image) {
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(image.data);
+    const bool planar = image.layout == Layout::Planar;
+    const ptrdiff_t rowUsed = static_cast<ptrdiff_t>(image.width) *
+        static_cast<ptrdiff_t>(ChannelBytes(image.depth)) * (planar ? 1 : 4);
+    const ptrdiff_t last = (planar ? 3 * image.planeBytes : 0) +
+        static_cast<ptrdiff_t>(image.height - 1) * image.rowBytes + rowUsed;
+    return {begin, begin + static_cast<uintptr_t>(last)};
+}
+
+bool Overlaps(const ImageView& a, const ImageView& b) {
+    auto ra = ByteRange(a);
+    auto rb = ByteRange(b);
+    return ra.first < rb.second && rb.first < ra.second;
+}
+
+// image と同じ形式で詰めたコピー（変換先と重なる変換元の退避用）
+ImageView StageCopy(const ImageView& image, std::vector<uint8_t>& storage) {
+    const bool planar = image.layout == Layout::Planar;
+    const size_t rowCopy = static_cast<size_t>(image.width) * ChannelBytes(image.depth) *
+        (planar ? 1 : 4);
+    const int planes = planar ? 4 : 1;
+    storage.resize(rowCopy * static_cast<size_t>(image.height) * planes);
+
+    ImageView staged = image;
+    staged.data = storage.data();
+    staged.rowBytes = static_cast<ptrdiff_t>(rowCopy);
+    staged.planeBytes = planar ? staged.rowBytes * image.height : 0;
+    for (int c = 0; c < planes; ++c) {
+        for (int y = 0; y < image.height; ++y) {
+            std::memcpy(storage.data() + c * staged.planeBytes + y * staged.rowBytes,
+                        static_cast<const uint8_t*>(image.data) + c * image.planeBytes + y * image.rowBytes,
+                        rowCopy);
+        }
+    }
+    return staged;
+}
+
+} // namespace
+
+// =============================================================
+// Public API
+// =============================================================
+
+size_t ChannelBytes(Depth depth) {
+    switch (depth) {
+        case Depth::U8: return 1;
+        case Depth::U16: return 2;
+        default: return 4;
+    }
+}
+
+Isa GetIsa() {
+    int isa = g_isa.load(std::memory_order_relaxed);
+    return isa < 0 ? SupportedIsa() : static_cast<Isa>(isa);
+}
+
+void SetIsa(Isa isa) {
+    g_isa.store(static_cast<int>(std::min(isa, SupportedIsa())), std::memory_order_relaxed);
+}
+
+const char* IsaName(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2: return "avx2";
+        case Isa::SSE41: return "sse4.1";
+        default: return "scalar";
+    }
+}
+
+void Convert(const ImageView& src, const ImageView& dst, AlphaOp alpha) {
+    Validate(src, "source");
+    Validate(dst, "destination");
+    if (src.width != dst.width || src.height != dst.height) {
+        throw std::invalid_argument("Source and destination sizes differ");
+    }
+
+    const bool sameFormat = src.depth == dst.depth && src.layout == dst.layout;
+    const bool inPlace = src.data == dst.data && sameFormat &&
+        src.rowBytes == dst.rowBytes && src.planeBytes == dst.planeBytes;
+    if (inPlace) {
+        // 同一形式の同じメモリは行ごとにその場で処理できる（アルファ処理用）
+        if (alpha == AlphaOp::None) {
+            return;
+        }
+    } else if (Overlaps(src, dst)) {
+        // 重なるメモリは並列に読み書きすると未処理の行を上書きするので、変換元を退避する
+        std::vector<uint8_t> storage;
+        Convert(StageCopy(src, storage), dst, alpha);
+        return;
+    }
+
+    const Isa isa = GetIsa();
+    const int width = src.width;
+    const bool interleaved = src.layout != Layout::Planar && dst.layout != Layout::Planar;
+    const size_t rowCopyBytes = static_cast<size_t>(width) * ChannelBytes(src.depth) *
+                                (src.layout == Layout::Planar ? 1 : 4);
+
+    ParallelFor(src.height, MinParallelRows(width), [&](int begin, int end) {
+        thread_local std::vector<float> buffer;
+        if (buffer.size() < static_cast<size_t>(width) * 4) {
+            buffer.resize(static_cast<size_t>(width) * 4);
+        }
+
+        for (int y = begin; y < end; ++y) {
+            Row srcRow{static_cast<uint8_t*>(src.data) + y * src.rowBytes, src.planeBytes, src.depth, src.layout};
+            Row dstRow{static_cast<uint8_t*>(dst.data) + y * dst.rowBytes, dst.planeBytes, dst.depth, dst.layout};
+
+            if (alpha == AlphaOp::None && sameFormat) {
+                // 同じ形式は行（プレーナーはプレーンごと）のコピー
+                for (int c = 0; c < (src.layout == Layout::Planar ? 4 : 1); ++c) {
+                    std::memcpy(dstRow.data + c * dst.planeBytes, srcRow.data + c * src.planeBytes, rowCopyBytes);
+                }
+            } else if (alpha == AlphaOp::None && interleaved && src.depth == dst.depth) {
+                // 同じ型の並べ替えは値を変換しない
+                SwizzleRow(isa, srcRow, width, dstRow);
+            } else {
+                DecodeRow(isa, srcRow, width, buffer.data());
+                if (alpha != AlphaOp::None) {
+                    AlphaRow(isa, buffer.data(), width, alpha);
+                }
+                EncodeRow(isa, buffer.data(), width, dstRow);
+            }
+        }
+    });
+}
+
+void EncodePixel(const float rgba[4], Depth depth, Layout layout, uint8_t* out) {
+    // プレーナーは R, G, B, A の値を順に詰める
+    Row row{out, static_cast<ptrdiff_t>(ChannelBytes(depth)), depth,
+            layout == Layout::Planar ? Layout::Planar : layout};
+    EncodeScalar(rgba, 0, 1, row);
+}
+
+void Fill(const ImageView& dst, const float rgba[4]) {
+    Validate(dst, "destination");
+
+    uint8_t pixel[16];
+    EncodePixel(rgba, dst.depth, dst.layout, pixel);
+
+    const bool planar = dst.layout == Layout::Planar;
+    const size_t channelBytes = ChannelBytes(dst.depth);
+    const size_t patternBytes = planar ? channelBytes : channelBytes * 4;
+    const size_t rowFillBytes = patternBytes * static_cast<size_t>(dst.width);
+
+    ParallelFor(dst.height, MinParallelRows(dst.width), [&](int begin, int end) {
+        for (int c = 0; c < (planar ? 4 : 1); ++c) {
+            const uint8_t* pattern = pixel + c * channelBytes;
+            uint8_t* plane = static_cast<uint8_t*>(dst.data) + c * dst.planeBytes;
+            // 範囲の先頭行を倍々に埋め、残りの行はそのコピー
+            uint8_t* first = plane + begin * dst.rowBytes;
+            std::memcpy(first, pattern, patternBytes);
+            for (size_t filled = patternBytes; filled < rowFillBytes;) {
+                size_t chunk = std::min(filled, rowFillBytes - filled);
+                std::memcpy(first + filled, first, chunk);
+                filled += chunk;
+            }
+            for (int y = begin + 1; y < end; ++y) {
+                std::memcpy(plane + y * dst.rowBytes, first, rowFillBytes);
+            }
+        }
+    });
+}
+
+void DecodeRowRGBA(const ImageView& image, int y, float* out) {
+    if (y < 0 || y >= image.height) {
+        throw std::invalid_argument("Row out of range");
+    }
+    Row row{static_cast<uint8_t*>(image.data) + y * image.rowBytes, image.planeBytes, image.depth, image.layout};
+    DecodeRow(GetIsa(), row, image.width, out);
+}
+
+void EncodeRowRGBA(const ImageView& image, int y, const float* in) {
+    if (y < 0 || y >= image.height) {
+        throw std::invalid_argument("Row out of range");
+    }
+    Row row{static_cast<uint8_t*>(image.data) + y * image.rowBytes, image.planeBytes, image.depth, image.layout};
+    EncodeRow(GetIsa(), in, image.width, row);
+}
+
+} // namespace PixelConvert
+} // namespace PyAE
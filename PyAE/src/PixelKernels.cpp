@@ -0,0 +1,579 @@
+// PixelKernels.cpp
+// PyAE - Python for After Effects
+// タイル分割で並列に実行するピクセルカーネルとその登録表
+//
+// タイルは行優先の番号で連続した範囲ごとにスレッドへ割り当てる。
+// 各スレッドはタイル1枚分（第2入力があればその分も）の float バッファを
+// 使い回す。float RGBA の1画素が SSE の1レジスタに収まるので、
+// 画素単位で済むカーネルは画素ごとにベクトル演算する。
+
+#include "PixelKernels.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define PYAE_KERNELS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace PyAE {
+namespace PixelKernels {
+
+namespace {
+
+// =============================================================
+// パラメータの取り出し
+// =============================================================
+
+// 知らない名前のパラメータは綴り間違いとして扱う
+void CheckNames(const std::string& kernel, const Params& params,
+                std::initializer_list<const char*> allowed) {
+    for (const auto& [name, param] : params) {
+        bool known = false;
+        for (const char* candidate : allowed) {
+            if (name == candidate) {
+                known = true;
+                break;
+            }
+        }
+        if (!known) {
+            throw std::invalid_argument("Unknown parameter for " + kernel + ": " + name);
+        }
+    }
+}
+
+const Param* FindParam(const Params& params, const char* name) {
+    auto it = params.find(name);
+    return it == params.end() ? nullptr : &it->second;
+}
+
+const std::vector<float>& Numbers(const Param& param, const char* name) {
+    if (param.isText) {
+        throw std::invalid_argument(std::string("Parameter ") + name + " must be numeric");
+    }
+    return param.values;
+}
+
+float Scalar(const Params& params, const char* name, float fallback) {
+    const Param* param = FindParam(params, name);
+    if (!param) {
+        return fallback;
+    }
+    const std::vector<float>& values = Numbers(*param, name);
+    if (values.size() != 1) {
+        throw std::invalid_argument(std::string("Parameter ") + name + " must be a number");
+    }
+    return values[0];
+}
+
+// スカラーは RGB に、4要素は R, G, B, A に使う
+void Channels(const Params& params, const char* name, const float fallback[4], float out[4]) {
+    std::copy(fallback, fallback + 4, out);
+    const Param* param = FindParam(params, name);
+    if (!param) {
+        return;
+    }
+    const std::vector<float>& values = Numbers(*param, name);
+    if (values.size() == 1) {
+        std::fill(out, out + 3, values[0]);
+    } else if (values.size() == 4) {
+        std::copy(values.begin(), values.end(), out);
+    } else {
+        throw std::invalid_argument(std::string("Parameter ") + name +
+                                    " must be a number or an (R, G, B, A) tuple");
+    }
+}
+
+std::string Text(const Params& params, const char* name, const char* fallback) {
+    const Param* param = FindParam(params, name);
+    if (!param) {
+        return fallback;
+    }
+    if (!param->isText) {
+        throw std::invalid_argument(std::string("Parameter ") + name + " must be a string");
+    }
+    return param->text;
+}
+
+// =============================================================
+// gain_gamma: v = (v * gain + offset) ^ (1 / gamma)
+// =============================================================
+
+class GainGamma : public Prepared {
+public:
+    explicit GainGamma(const Params& params) {
+        CheckNames("gain_gamma", params, {"gain", "gamma", "offset"});
+        const float ones[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        const float zeros[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float gamma[4];
+        Channels(params, "gain", ones, m_gain);
+        Channels(params, "offset", zeros, m_offset);
+        Channels(params, "gamma", ones, gamma);
+        for (int c = 0; c < 4; ++c) {
+            if (!(gamma[c] > 0.0f)) {
+                throw std::invalid_argument("gamma must be positive");
+            }
+            m_exponent[c] = 1.0f / gamma[c];
+            m_hasGamma = m_hasGamma || gamma[c] != 1.0f;
+        }
+    }
+
+    void Process(float* px, const float*, size_t count) const override {
+#ifdef PYAE_KERNELS_SSE2
+        const __m128 gain = _mm_loadu_ps(m_gain);
+        const __m128 offset = _mm_loadu_ps(m_offset);
+        for (size_t i = 0; i < count; ++i) {
+            _mm_storeu_ps(px + i * 4, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(px + i * 4), gain), offset));
+        }
+#else
+        for (size_t i = 0; i < count; ++i) {
+            for (int c = 0; c < 4; ++c) {
+                px[i * 4 + c] = px[i * 4 + c] * m_gain[c] + m_offset[c];
+            }
+        }
+#endif
+        if (!m_hasGamma) {
+            return;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            for (int c = 0; c < 4; ++c) {
+                float& v = px[i * 4 + c];
+                if (m_exponent[c] != 1.0f && v > 0.0f) {
+                    v = std::pow(v, m_exponent[c]);
+                }
+            }
+        }
+    }
+
+private:
+    float m_gain[4];
+    float m_offset[4];
+    float m_exponent[4];
+    bool m_hasGamma = false;
+};
+
+// =============================================================
+// threshold: RGB = (source >= level) ? high : low（アルファはそのまま）
+// =============================================================
+
+class Threshold : public Prepared {
+public:
+    explicit Threshold(const Params& params) {
+        CheckNames("threshold", params, {"level", "low", "high", "channel"});
+        m_level = Scalar(params, "level", 0.5f);
+        m_low = Scalar(params, "low", 0.0f);
+        m_high = Scalar(params, "high", 1.0f);
+
+        std::string channel = Text(params, "channel", "luma");
+        if (channel == "luma") {
+            // Rec.709
+            m_weights[0] = 0.2126f;
+            m_weights[1] = 0.7152f;
+            m_weights[2] = 0.0722f;
+        } else if (channel.size() == 1 && std::strchr("rgba", channel[0])) {
+            m_weights[std::strchr("rgba", channel[0]) - "rgba"] = 1.0f;
+        } else {
+            throw std::invalid_argument("channel must be 'luma', 'r', 'g', 'b' or 'a'");
+        }
+    }
+
+    void Process(float* px, const float*, size_t count) const override {
+        for (size_t i = 0; i < count; ++i) {
+            float* p = px + i * 4;
+            float v = p[0] * m_weights[0] + p[1] * m_weights[1] +
+                      p[2] * m_weights[2] + p[3] * m_weights[3];
+            float out = v >= m_level ? m_high : m_low;
+            p[0] = p[1] = p[2] = out;
+        }
+    }
+
+private:
+    float m_level;
+    float m_low;
+    float m_high;
+    float m_weights[4] = {};
+};
+
+// =============================================================
+// channel_shuffle: 出力の各チャンネルに入力の R, G, B, A または 0 / 1 を入れる
+// =============================================================
+
+class ChannelShuffle : public Prepared {
+public:
+    explicit ChannelShuffle(const Params& params) {
+        CheckNames("channel_shuffle", params, {"order"});
+        const Param* order = FindParam(params, "order");
+        if (!order) {
+            throw std::invalid_argument("channel_shuffle requires order");
+        }
+        if (order->isText) {
+            // 例: "bgra", "rgb1", "aaa1"
+            static const char kNames[] = "rgba01";
+            if (order->text.size() != 4) {
+                throw std::invalid_argument("order must have 4 characters from 'rgba01'");
+            }
+            for (int c = 0; c < 4; ++c) {
+                const char* found = std::strchr(kNames, order->text[static_cast<size_t>(c)]);
+                if (!found || order->text[static_cast<size_t>(c)] == '\0') {
+                    throw std::invalid_argument("order must have 4 characters from 'rgba01'");
+                }
+                m_source[c] = static_cast<int>(found - kNames);
+            }
+        } else {
+            if (order->values.size() != 4) {
+                throw std::invalid_argument("order must have 4 entries");
+            }
+            for (int c = 0; c < 4; ++c) {
+                float v = order->values[static_cast<size_t>(c)];
+                if (v != std::floor(v) || v < 0.0f || v > 5.0f) {
+                    throw std::invalid_argument("order entries must be 0-3 (R, G, B, A), 4 (zero) or 5 (one)");
+                }
+                m_source[c] = static_cast<int>(v);
+            }
+        }
+    }
+
+    void Process(float* px, const float*, size_t count) const override {
+        for (size_t i = 0; i < count; ++i) {
+            float* p = px + i * 4;
+            const float in[6] = {p[0], p[1], p[2], p[3], 0.0f, 1.0f};
+            for (int c = 0; c < 4; ++c) {
+                p[c] = in[m_source[c]];
+            }
+        }
+    }
+
+private:
+    int m_source[4];
+};
+
+// =============================================================
+// lut: 1D ルックアップ（domain の範囲を等間隔に、間は線形補間、範囲外は端の値）
+// =============================================================
+
+class Lut : public Prepared {
+public:
+    explicit Lut(const Params& params) {
+        CheckNames("lut", params, {"lut", "lut_r", "lut_g", "lut_b", "lut_a", "domain"});
+        const Param* shared = FindParam(params, "lut");
+        const char* names[4] = {"lut_r", "lut_g", "lut_b", "lut_a"};
+        bool any = false;
+        for (int c = 0; c < 4; ++c) {
+            const Param* param = FindParam(params, names[c]);
+            // 共通の lut は RGB のみ。アルファは lut_a を指定した場合だけ変える
+            if (!param && c < 3) {
+                param = shared;
+            }
+            if (!param) {
+                continue;
+            }
+            m_tables[c] = Numbers(*param, names[c]);
+            if (m_tables[c].size() < 2) {
+                throw std::invalid_argument("A LUT needs at least 2 entries");
+            }
+            any = true;
+        }
+        if (!any) {
+            throw std::invalid_argument("lut requires lut or lut_r / lut_g / lut_b / lut_a");
+        }
+
+        m_lo = 0.0f;
+        float hi = 1.0f;
+        if (const Param* domain = FindParam(params, "domain")) {
+            const std::vector<float>& values = Numbers(*domain, "domain");
+            if (values.size() != 2 || !(values[0] < values[1])) {
+                throw std::invalid_argument("domain must be (min, max) with min < max");
+            }
+            m_lo = values[0];
+            hi = values[1];
+        }
+        m_scale = 1.0f / (hi - m_lo);
+    }
+
+    void Process(float* px, const float*, size_t count) const override {
+        for (int c = 0; c < 4; ++c) {
+            const std::vector<float>& table = m_tables[c];
+            if (table.empty()) {
+                continue;
+            }
+            const float last = static_cast<float>(table.size() - 1);
+            for (size_t i = 0; i < count; ++i) {
+                float& v = px[i * 4 + c];
+                if (std::isnan(v)) {
+                    continue;
+                }
+                float pos = (std::min)((std::max)((v - m_lo) * m_scale, 0.0f), 1.0f) * last;
+                size_t index = (std::min)(static_cast<size_t>(pos), table.size() - 2);
+                float t = pos - static_cast<float>(index);
+                v = table[index] + (table[index + 1] - table[index]) * t;
+            }
+        }
+    }
+
+private:
+    std::vector<float> m_tables[4];
+    float m_lo;
+    float m_scale;
+};
+
+// =============================================================
+// blend: 第2入力（premultiplied）を画像に合成する
+// =============================================================
+
+enum class BlendMode {
+    Normal,     // over: out = src * o + dst * (1 - srcA * o)
+    Mix,        // out = dst + (src - dst) * o（アルファも）
+    Add,        // 以下は RGB のみ: out = dst + (f(dst, src) - dst) * o
+    Multiply,
+    Screen,
+    Difference
+};
+
+class Blend : public Prepared {
+public:
+    explicit Blend(const Params& params) {
+        CheckNames("blend", params, {"mode", "opacity"});
+        std::string mode = Text(params, "mode", "normal");
+        if (mode == "normal") {
+            m_mode = BlendMode::Normal;
+        } else if (mode == "mix") {
+            m_mode = BlendMode::Mix;
+        } else if (mode == "add") {
+            m_mode = BlendMode::Add;
+        } else if (mode == "multiply") {
+            m_mode = BlendMode::Multiply;
+        } else if (mode == "screen") {
+            m_mode = BlendMode::Screen;
+        } else if (mode == "difference") {
+            m_mode = BlendMode::Difference;
+        } else {
+            throw std::invalid_argument("Unknown blend mode: " + mode);
+        }
+        m_opacity = Scalar(params, "opacity", 1.0f);
+    }
+
+    void Process(float* px, const float* other, size_t count) const override {
+#ifdef PYAE_KERNELS_SSE2
+        const __m128 opacity = _mm_set1_ps(m_opacity);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 rgbMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        for (size_t i = 0; i < count; ++i) {
+            __m128 dst = _mm_loadu_ps(px + i * 4);
+            __m128 src = _mm_loadu_ps(other + i * 4);
+            __m128 out;
+            if (m_mode == BlendMode::Normal) {
+                __m128 s = _mm_mul_ps(src, opacity);
+                __m128 sa = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3));
+                out = _mm_add_ps(s, _mm_mul_ps(dst, _mm_sub_ps(one, sa)));
+            } else if (m_mode == BlendMode::Mix) {
+                out = _mm_add_ps(dst, _mm_mul_ps(_mm_sub_ps(src, dst), opacity));
+            } else {
+                __m128 f;
+                switch (m_mode) {
+                    case BlendMode::Add: f = _mm_add_ps(dst, src); break;
+                    case BlendMode::Multiply: f = _mm_mul_ps(dst, src); break;
+                    case BlendMode::Screen: f = _mm_sub_ps(_mm_add_ps(dst, src), _mm_mul_ps(dst, src)); break;
+                    default: f = _mm_and_ps(_mm_sub_ps(dst, src), absMask); break;
+                }
+                __m128 mixed = _mm_add_ps(dst, _mm_mul_ps(_mm_sub_ps(f, dst), opacity));
+                out = _mm_or_ps(_mm_and_ps(rgbMask, mixed), _mm_andnot_ps(rgbMask, dst));
+            }
+            _mm_storeu_ps(px + i * 4, out);
+        }
+#else
+        for (size_t i = 0; i < count; ++i) {
+            float* d = px + i * 4;
+            const float* s = other + i * 4;
+            if (m_mode == BlendMode::Normal) {
+                float sa = s[3] * m_opacity;
+                for (int c = 0; c < 4; ++c) {
+                    d[c] = s[c] * m_opacity + d[c] * (1.0f - sa);
+                }
+                continue;
+            }
+            int channels = m_mode == BlendMode::Mix ? 4 : 3;
+            for (int c = 0; c < channels; ++c) {
+                float f;
+                switch (m_mode) {
+                    case BlendMode::Mix: f = s[c]; break;
+                    case BlendMode::Add: f = d[c] + s[c]; break;
+                    case BlendMode::Multiply: f = d[c] * s[c]; break;
+                    case BlendMode::Screen: f = d[c] + s[c] - d[c] * s[c]; break;
+                    default: f = std::fabs(d[c] - s[c]); break;
+                }
+                d[c] = d[c] + (f - d[c]) * m_opacity;
+            }
+        }
+#endif
+    }
+
+private:
+    BlendMode m_mode;
+    float m_opacity;
+};
+
+template <typename T>
+Factory MakeFactory() {
+    return [](const Params& params) -> std::unique_ptr<Prepared> {
+        return std::unique_ptr<Prepared>(new T(params));
+    };
+}
+
+// タイル内の部分画像
+PixelConvert::ImageView TileView(const PixelConvert::ImageView& image, int x, int y, int width, int height) {
+    PixelConvert::ImageView tile = image;
+    tile.data = static_cast<uint8_t*>(image.data) + y * image.rowBytes +
+        static_cast<ptrdiff_t>(x) * (image.layout == PixelConvert::Layout::Planar ? 1 : 4) *
+        static_cast<ptrdiff_t>(PixelConvert::ChannelBytes(image.depth));
+    tile.width = width;
+    tile.height = height;
+    return tile;
+}
+
+} // namespace
+
+// =============================================================
+// Registry
+// =============================================================
+
+Registry::Registry() {
+    Register({"gain_gamma", 1,
+              "v = (v * gain + offset) ^ (1 / gamma) per channel.\n"
+              "gain, offset, gamma: number (RGB) or (R, G, B, A); defaults 1, 0, 1"},
+             MakeFactory<GainGamma>());
+    Register({"threshold", 1,
+              "RGB = high where the source value >= level, else low; alpha unchanged.\n"
+              "level (0.5), low (0.0), high (1.0),\n"
+              "channel: 'luma' (Rec.709, default), 'r', 'g', 'b' or 'a'"},
+             MakeFactory<Threshold>());
+    Register({"channel_shuffle", 1,
+              "Rearrange channels.\n"
+              "order: 4 characters from 'rgba01' (e.g. 'bgra', 'rgb1') or\n"
+              "4 indices 0-3 (R, G, B, A), 4 (zero), 5 (one)"},
+             MakeFactory<ChannelShuffle>());
+    Register({"lut", 1,
+              "1D lookup with linear interpolation, clamped to the ends.\n"
+              "lut: table for RGB; lut_r, lut_g, lut_b, lut_a: per channel\n"
+              "(alpha only changes with lut_a); domain: (min, max) input\n"
+              "range covered by the table (default (0.0, 1.0))"},
+             MakeFactory<Lut>());
+    Register({"blend", 2,
+              "Blend a second image (premultiplied) onto this one.\n"
+              "mode: 'normal' (over, default), 'mix', 'add', 'multiply',\n"
+              "'screen' or 'difference' (RGB only for the last four);\n"
+              "opacity (1.0)"},
+             MakeFactory<Blend>());
+}
+
+void Registry::Register(const KernelInfo& info, Factory factory) {
+    if (info.name.empty() || !factory) {
+        throw std::invalid_argument("A kernel needs a name and a factory");
+    }
+    if (info.inputs != 1 && info.inputs != 2) {
+        throw std::invalid_argument("A kernel takes 1 or 2 inputs");
+    }
+    WinLockGuard lock(m_mutex);
+    m_kernels[info.name] = Entry{info, std::move(factory)};
+}
+
+std::vector<KernelInfo> Registry::List() const {
+    WinLockGuard lock(m_mutex);
+    std::vector<KernelInfo> result;
+    result.reserve(m_kernels.size());
+    for (const auto& [name, entry] : m_kernels) {
+        result.push_back(entry.info);
+    }
+    return result;
+}
+
+KernelInfo Registry::GetInfo(const std::string& name) const {
+    WinLockGuard lock(m_mutex);
+    auto it = m_kernels.find(name);
+    if (it == m_kernels.end()) {
+        throw std::invalid_argument("Unknown kernel: " + name);
+    }
+    return it->second.info;
+}
+
+std::unique_ptr<Prepared> Registry::Prepare(const std::string& name, const Params& params) const {
+    Factory factory;
+    {
+        WinLockGuard lock(m_mutex);
+        auto it = m_kernels.find(name);
+        if (it == m_kernels.end()) {
+            throw std::invalid_argument("Unknown kernel: " + name);
+        }
+        factory = it->second.factory;
+    }
+    return factory(params);
+}
+
+// =============================================================
+// Run
+// =============================================================
+
+RunStats Run(const Prepared& kernel, const PixelConvert::ImageView& image,
+             const PixelConvert::ImageView* other, int tileSize) {
+    if (!image.data || image.width <= 0 || image.height <= 0) {
+        throw std::invalid_argument("Cannot run a kernel on an empty image");
+    }
+    if (tileSize < 8 || tileSize > 1024) {
+        throw std::invalid_argument("tile_size must be between 8 and 1024");
+    }
+    if (other && (other->width != image.width || other->height != image.height)) {
+        throw std::invalid_argument("The second input must have the same size");
+    }
+
+    const int tilesX = (image.width + tileSize - 1) / tileSize;
+    const int tilesY = (image.height + tileSize - 1) / tileSize;
+    const int tiles = tilesX * tilesY;
+    // 1タスクあたり最低 64K 画素
+    const int minTiles = (std::max)(1, (1 << 16) / (tileSize * tileSize));
+    const size_t tileFloats = static_cast<size_t>(tileSize) * static_cast<size_t>(tileSize) * 4;
+
+    RunStats stats;
+    stats.tiles = tiles;
+    stats.tasks = ParallelTaskCount(tiles, minTiles);
+
+    ParallelForTasks(tiles, minTiles, [&](int, int begin, int end) {
+        std::vector<float> pixels(tileFloats);
+        std::vector<float> second(other ? tileFloats : 0);
+
+        for (int t = begin; t < end; ++t) {
+            const int x = (t % tilesX) * tileSize;
+            const int y = (t / tilesX) * tileSize;
+            const int width = (std::min)(tileSize, image.width - x);
+            const int height = (std::min)(tileSize, image.height - y);
+            const size_t rowFloats = static_cast<size_t>(width) * 4;
+
+            // 第2入力は image と同じメモリでもよいよう、書き戻す前にすべて読む
+            PixelConvert::ImageView tile = TileView(image, x, y, width, height);
+            for (int row = 0; row < height; ++row) {
+                PixelConvert::DecodeRowRGBA(tile, row, pixels.data() + row * rowFloats);
+            }
+            if (other) {
+                PixelConvert::ImageView otherTile = TileView(*other, x, y, width, height);
+                for (int row = 0; row < height; ++row) {
+                    PixelConvert::DecodeRowRGBA(otherTile, row, second.data() + row * rowFloats);
+                }
+            }
+
+            kernel.Process(pixels.data(), other ? second.data() : nullptr,
+                           static_cast<size_t>(width) * static_cast<size_t>(height));
+
+            for (int row = 0; row < height; ++row) {
+                PixelConvert::EncodeRowRGBA(tile, row, pixels.data() + row * rowFloats);
+            }
+        }
+    });
+    return stats;
+}
+
+} // namespace PixelKernels
+} // namespace PyAE
@@ -0,0 +1,647 @@
+// ProjectSnapshot.cpp
+// PyAE - Python for After Effects
+// バイナリ プロジェクトスナップショットの読み書き
+
+#include "ProjectSnapshot.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#include "StringUtils.h"
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace PyAE {
+
+using Snapshot::Tag;
+
+namespace {
+
+constexpr size_t Align8(size_t value) {
+    return (value + 7) & ~static_cast<size_t>(7);
+}
+
+// 範囲チェック付きの区間判定（オーバーフロー安全）
+bool InRange(uint64_t offset, uint64_t length, uint64_t total) {
+    return offset <= total && length <= total - offset;
+}
+
+} // namespace
+
+// =============================================================
+// SnapshotWriter
+// =============================================================
+
+SnapshotWriter::SnapshotWriter() {
+    m_stringOffsets.push_back(0);
+    m_tree.reserve(64 * 1024);
+}
+
+uint32_t SnapshotWriter::Intern(std::string_view text) {
+    std::string key(text);
+    auto it = m_stringIds.find(key);
+    if (it != m_stringIds.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(m_stringOffsets.size() - 1);
+    m_stringData.append(text);
+    m_stringOffsets.push_back(m_stringData.size());
+    m_stringIds.emplace(std::move(key), id);
+    return id;
+}
+
+uint64_t SnapshotWriter::StoreBlob(std::string_view bytes) {
+    if (bytes.empty()) {
+        return 0;
+    }
+    std::string key(bytes);
+    auto it = m_blobOffsets.find(key);
+    if (it != m_blobOffsets.end()) {
+        return it->second;
+    }
+    uint64_t offset = m_blob.size();
+    m_blob.append(bytes);
+    m_blobOffsets.emplace(std::move(key), offset);
+    return offset;
+}
+
+void SnapshotWriter::BeginValue() {
+    if (m_afterKey) {
+        m_afterKey = false;
+        return;
+    }
+    if (m_stack.empty()) {
+        if (m_hasRoot) {
+            throw std::logic_error("SnapshotWriter: multiple root values");
+        }
+        m_hasRoot = true;
+        return;
+    }
+    if (m_stack.back().isObject) {
+        throw std::logic_error("SnapshotWriter: value without key");
+    }
+    ++m_stack.back().count;
+}
+
+void SnapshotWriter::BeginContainer(Tag tag) {
+    size_t headerPos = m_tree.size();
+    PutTag(tag);
+    Put<uint32_t>(0);
+    Put<uint64_t>(0);
+    m_stack.push_back({headerPos, 0, tag == Tag::Object});
+}
+
+void SnapshotWriter::EndContainer(bool isObject) {
+    if (m_stack.empty() || m_stack.back().isObject != isObject || m_afterKey) {
+        throw std::logic_error("SnapshotWriter: unbalanced container");
+    }
+    Frame frame = m_stack.back();
+    m_stack.pop_back();
+
+    uint64_t bodySize = m_tree.size() - (frame.headerPos + Snapshot::kContainerHeaderSize);
+    std::memcpy(&m_tree[frame.headerPos + 1], &frame.count, sizeof(uint32_t));
+    std::memcpy(&m_tree[frame.headerPos + 5], &bodySize, sizeof(uint64_t));
+}
+
+void SnapshotWriter::BeginObject() {
+    if (m_capturing) { Record({EventType::BeginObject, std::string(), 0.0, 0}); return; }
+    BeginValue();
+    BeginContainer(Tag::Object);
+}
+
+void SnapshotWriter::EndObject() {
+    if (m_capturing) { Record({EventType::EndObject, std::string(), 0.0, 0}); return; }
+    EndContainer(true);
+}
+
+void SnapshotWriter::BeginArray() {
+    if (m_capturing) { Record({EventType::BeginArray, std::string(), 0.0, 0}); return; }
+    bool keyframes = m_afterKey && m_lastKeyIsKeyframes;
+    BeginValue();
+    if (keyframes) {
+        // 配列の終わりまで取り込み、列指向で書けるか判定する
+        m_capturing = true;
+        m_captureDepth = 0;
+        m_events.clear();
+        return;
+    }
+    BeginContainer(Tag::Array);
+}
+
+void SnapshotWriter::EndArray() {
+    if (m_capturing) { Record({EventType::EndArray, std::string(), 0.0, 0}); return; }
+    EndContainer(false);
+}
+
+void SnapshotWriter::Key(std::string_view key) {
+    if (m_capturing) { Record({EventType::Key, std::string(key), 0.0, 0}); return; }
+    if (m_stack.empty() || !m_stack.back().isObject || m_afterKey) {
+        throw std::logic_error("SnapshotWriter: key outside of object");
+    }
+    Put<uint32_t>(Intern(key));
+    ++m_stack.back().count;
+    m_afterKey = true;
+    m_lastKeyIsKeyframes = (key == Snapshot::kKeyframesKey);
+}
+
+void SnapshotWriter::String(std::string_view value) {
+    if (m_capturing) { Record({EventType::String, std::string(value), 0.0, 0}); return; }
+    BeginValue();
+    PutTag(Tag::String);
+    Put<uint32_t>(Intern(value));
+}
+
+void SnapshotWriter::Bool(bool value) {
+    if (m_capturing) { Record({EventType::Bool, std::string(), 0.0, value ? 1 : 0}); return; }
+    BeginValue();
+    PutTag(value ? Tag::True : Tag::False);
+}
+
+void SnapshotWriter::Null() {
+    if (m_capturing) { Record({EventType::Null, std::string(), 0.0, 0}); return; }
+    BeginValue();
+    PutTag(Tag::Null);
+}
+
+void SnapshotWriter::Int(int64_t value) {
+    if (m_capturing) { Record({EventType::Int, std::string(), 0.0, value}); return; }
+    BeginValue();
+    PutTag(Tag::Int);
+    Put<int64_t>(value);
+}
+
+void SnapshotWriter::Number(double value) {
+    if (m_capturing) { Record({EventType::Number, std::string(), value, 0}); return; }
+    BeginValue();
+    PutTag(Tag::Double);
+    Put<double>(value);
+}
+
+void SnapshotWriter::HexString(std::string_view bytes) {
+    if (m_capturing) { Record({EventType::Bytes, std::string(bytes), 0.0, 0}); return; }
+    if (bytes.size() > UINT32_MAX) {
+        throw std::length_error("SnapshotWriter: byte value too large");
+    }
+    BeginValue();
+    PutTag(Tag::Bytes);
+    Put<uint64_t>(StoreBlob(bytes));
+    Put<uint32_t>(static_cast<uint32_t>(bytes.size()));
+}
+
+// -------------------------------------------------------------
+// キーフレーム配列の列指向化
+// -------------------------------------------------------------
+
+void SnapshotWriter::Record(Event event) {
+    switch (event.type) {
+        case EventType::BeginObject:
+        case EventType::BeginArray:
+            ++m_captureDepth;
+            break;
+        case EventType::EndObject:
+        case EventType::EndArray:
+            if (m_captureDepth == 0) {
+                if (event.type != EventType::EndArray) {
+                    throw std::logic_error("SnapshotWriter: unbalanced container");
+                }
+                FinishCapture();
+                return;
+            }
+            --m_captureDepth;
+            break;
+        default:
+            break;
+    }
+    m_events.push_back(std::move(event));
+}
+
+void SnapshotWriter::FinishCapture() {
+    m_capturing = false;
+    if (!WriteKeyframeTable()) {
+        Replay();
+    }
+    m_events.clear();
+}
+
+bool SnapshotWriter::WriteKeyframeTable() {
+    // 各行が {time: float, bdata: bytes, in_interpolation: str, out_interpolation: str}
+    // の順で並んでいる場合のみ列指向にする
+    static constexpr size_t kEventsPerRow = 10;
+    static constexpr EventType kValueTypes[4] = {
+        EventType::Number, EventType::Bytes, EventType::String, EventType::String
+    };
+
+    if (m_events.size() % kEventsPerRow != 0) {
+        return false;
+    }
+    size_t rows = m_events.size() / kEventsPerRow;
+    if (rows > UINT32_MAX) {
+        return false;
+    }
+    for (size_t r = 0; r < rows; ++r) {
+        const Event* row = &m_events[r * kEventsPerRow];
+        if (row[0].type != EventType::BeginObject || row[9].type != EventType::EndObject) {
+            return false;
+        }
+        for (size_t f = 0; f < 4; ++f) {
+            const Event& key = row[1 + f * 2];
+            if (key.type != EventType::Key || key.text != Snapshot::kKeyframeFields[f] ||
+                row[2 + f * 2].type != kValueTypes[f] ||
+                (f == 1 && row[4].text.size() > UINT32_MAX)) {
+                return false;
+            }
+        }
+    }
+
+    uint32_t count = static_cast<uint32_t>(rows);
+    PutTag(Tag::KeyframeTable);
+    Put<uint32_t>(count);
+    size_t sizePos = m_tree.size();
+    Put<uint64_t>(0);
+    size_t bodyStart = m_tree.size();
+
+    // ツリー領域はファイル内で8バイト境界に置かれるため、相対位置で揃えれば十分
+    m_tree.append(Align8(m_tree.size()) - m_tree.size(), '\0');
+
+    for (uint32_t i = 0; i < count; ++i) {
+        Put<double>(m_events[i * kEventsPerRow + 2].number);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        Put<uint64_t>(StoreBlob(m_events[i * kEventsPerRow + 4].text));
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        Put<uint32_t>(static_cast<uint32_t>(m_events[i * kEventsPerRow + 4].text.size()));
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        Put<uint32_t>(Intern(m_events[i * kEventsPerRow + 6].text));
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        Put<uint32_t>(Intern(m_events[i * kEventsPerRow + 8].text));
+    }
+
+    uint64_t bodySize = m_tree.size() - bodyStart;
+    std::memcpy(&m_tree[sizePos], &bodySize, sizeof(uint64_t));
+    return true;
+}
+
+void SnapshotWriter::Replay() {
+    // 汎用配列として書き直す（BeginValue は取り込み開始時に済んでいる）
+    std::vector<Event> events = std::move(m_events);
+    m_events.clear();
+
+    BeginContainer(Tag::Array);
+    for (const Event& e : events) {
+        switch (e.type) {
+            case EventType::BeginObject: BeginObject(); break;
+            case EventType::EndObject:   EndObject(); break;
+            case EventType::BeginArray:  BeginArray(); break;
+            case EventType::EndArray:    EndArray(); break;
+            case EventType::Key:         Key(e.text); break;
+            case EventType::String:      String(e.text); break;
+            case EventType::Bool:        Bool(e.integer != 0); break;
+            case EventType::Null:        Null(); break;
+            case EventType::Int:         Int(e.integer); break;
+            case EventType::Number:      Number(e.number); break;
+            case EventType::Bytes:       HexString(e.text); break;
+        }
+    }
+    EndContainer(false);
+}
+
+// -------------------------------------------------------------
+// 出力
+// -------------------------------------------------------------
+
+std::string SnapshotWriter::Finish() {
+    if (!IsComplete()) {
+        throw std::logic_error("SnapshotWriter: incomplete document");
+    }
+
+    Snapshot::Header header{};
+    std::memcpy(header.magic, Snapshot::kMagic, sizeof(header.magic));
+    header.version = Snapshot::kVersion;
+    header.stringCount = static_cast<uint32_t>(m_stringOffsets.size() - 1);
+
+    size_t offsetsSize = m_stringOffsets.size() * sizeof(uint64_t);
+    header.stringsOffset = sizeof(Snapshot::Header);
+    header.stringsSize = offsetsSize + m_stringData.size();
+    header.treeOffset = Align8(header.stringsOffset + header.stringsSize);
+    header.treeSize = m_tree.size();
+    header.blobOffset = Align8(header.treeOffset + header.treeSize);
+    header.blobSize = m_blob.size();
+
+    std::string out(static_cast<size_t>(header.blobOffset + header.blobSize), '\0');
+    std::memcpy(&out[0], &header, sizeof(header));
+    std::memcpy(&out[header.stringsOffset], m_stringOffsets.data(), offsetsSize);
+    if (!m_stringData.empty()) {
+        std::memcpy(&out[header.stringsOffset + offsetsSize], m_stringData.data(), m_stringData.size());
+    }
+    std::memcpy(&out[header.treeOffset], m_tree.data(), m_tree.size());
+    if (!m_blob.empty()) {
+        std::memcpy(&out[header.blobOffset], m_blob.data(), m_blob.size());
+    }
+    return out;
+}
+
+// =============================================================
+// SnapshotReader
+// =============================================================
+
+std::shared_ptr<SnapshotReader> SnapshotReader::OpenFile(const std::string& utf8Path) {
+    std::shared_ptr<SnapshotReader> reader(new SnapshotReader());
+
+#ifdef _WIN32
+    std::wstring widePath = StringUtils::Utf8ToWide(utf8Path);
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open snapshot: " + utf8Path);
+    }
+    reader->m_fileHandle = file;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) ||
+        static_cast<uint64_t>(fileSize.QuadPart) < sizeof(Snapshot::Header)) {
+        throw std::runtime_error("Invalid snapshot file: " + utf8Path);
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        throw std::runtime_error("Failed to map snapshot: " + utf8Path);
+    }
+    reader->m_mappingHandle = mapping;
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        throw std::runtime_error("Failed to map snapshot: " + utf8Path);
+    }
+    reader->m_data = static_cast<const uint8_t*>(view);
+    reader->m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    std::ifstream file(utf8Path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open snapshot: " + utf8Path);
+    }
+    reader->m_owned.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    reader->m_data = reinterpret_cast<const uint8_t*>(reader->m_owned.data());
+    reader->m_size = reader->m_owned.size();
+#endif
+
+    reader->Initialize();
+    return reader;
+}
+
+std::shared_ptr<SnapshotReader> SnapshotReader::FromBytes(std::string bytes) {
+    std::shared_ptr<SnapshotReader> reader(new SnapshotReader());
+    reader->m_owned = std::move(bytes);
+    reader->m_data = reinterpret_cast<const uint8_t*>(reader->m_owned.data());
+    reader->m_size = reader->m_owned.size();
+    reader->Initialize();
+    return reader;
+}
+
+SnapshotReader::~SnapshotReader() {
+#ifdef _WIN32
+    if (m_mappingHandle && m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    }
+    if (m_fileHandle) {
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    }
+#endif
+}
+
+void SnapshotReader::Initialize() {
+    if (m_size < sizeof(Snapshot::Header)) {
+        throw std::runtime_error("Snapshot: data too small");
+    }
+    std::memcpy(&m_header, m_data, sizeof(m_header));
+
+    if (std::memcmp(m_header.magic, Snapshot::kMagic, sizeof(m_header.magic)) != 0) {
+        throw std::runtime_error("Snapshot: invalid magic");
+    }
+    if (m_header.version != Snapshot::kVersion) {
+        throw std::runtime_error("Snapshot: unsupported version " + std::to_string(m_header.version));
+    }
+
+    uint64_t offsetsSize = (static_cast<uint64_t>(m_header.stringCount) + 1) * sizeof(uint64_t);
+    if (!InRange(m_header.stringsOffset, m_header.stringsSize, m_size) ||
+        m_header.stringsSize < offsetsSize ||
+        !InRange(m_header.treeOffset, m_header.treeSize, m_size) ||
+        !InRange(m_header.blobOffset, m_header.blobSize, m_size) ||
+        m_header.treeSize == 0) {
+        throw std::runtime_error("Snapshot: corrupt section table");
+    }
+    m_tree = m_data + m_header.treeOffset;
+}
+
+std::string_view SnapshotReader::GetString(uint32_t id) const {
+    if (id >= m_header.stringCount) {
+        throw std::runtime_error("Snapshot: string id out of range");
+    }
+    const uint8_t* base = m_data + m_header.stringsOffset;
+    uint64_t offsetsSize = (static_cast<uint64_t>(m_header.stringCount) + 1) * sizeof(uint64_t);
+    uint64_t dataSize = m_header.stringsSize - offsetsSize;
+
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    std::memcpy(&begin, base + id * sizeof(uint64_t), sizeof(uint64_t));
+    std::memcpy(&end, base + (id + 1) * sizeof(uint64_t), sizeof(uint64_t));
+    if (begin > end || end > dataSize) {
+        throw std::runtime_error("Snapshot: corrupt string table");
+    }
+    return std::string_view(reinterpret_cast<const char*>(base + offsetsSize + begin),
+                            static_cast<size_t>(end - begin));
+}
+
+std::string_view SnapshotReader::GetBlob(uint64_t offset, uint32_t length) const {
+    if (!InRange(offset, length, m_header.blobSize)) {
+        throw std::runtime_error("Snapshot: blob reference out of range");
+    }
+    return std::string_view(reinterpret_cast<const char*>(m_data + m_header.blobOffset + offset), length);
+}
+
+bool SnapshotReader::FindString(std::string_view text, uint32_t& id) const {
+    {
+        WinLockGuard lock(m_indexMutex);
+        if (!m_indexBuilt) {
+            m_stringIndex.reserve(m_header.stringCount);
+            for (uint32_t i = 0; i < m_header.stringCount; ++i) {
+                m_stringIndex.emplace(GetString(i), i);
+            }
+            m_indexBuilt = true;
+        }
+    }
+    // 作成後は変更しないのでロックの外で引ける
+    auto it = m_stringIndex.find(text);
+    if (it == m_stringIndex.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+size_t SnapshotReader::SkipValue(size_t offset) const {
+    switch (static_cast<Tag>(Read<uint8_t>(offset))) {
+        case Tag::Null:
+        case Tag::False:
+        case Tag::True:
+            return offset + 1;
+        case Tag::Int:
+        case Tag::Double:
+            return offset + 1 + 8;
+        case Tag::String:
+            return offset + 1 + 4;
+        case Tag::Bytes:
+            return offset + 1 + 8 + 4;
+        case Tag::Array:
+        case Tag::Object:
+        case Tag::KeyframeTable: {
+            uint64_t bodySize = Read<uint64_t>(offset + 5);
+            size_t body = offset + Snapshot::kContainerHeaderSize;
+            if (!InRange(body, bodySize, m_header.treeSize)) {
+                throw std::runtime_error("Snapshot: corrupt container size");
+            }
+            return body + static_cast<size_t>(bodySize);
+        }
+    }
+    throw std::runtime_error("Snapshot: unknown value tag");
+}
+
+// =============================================================
+// SnapshotNode
+// =============================================================
+
+Tag SnapshotNode::GetTag() const {
+    if (!m_reader) {
+        throw std::runtime_error("Snapshot: invalid node");
+    }
+    return static_cast<Tag>(m_reader->Read<uint8_t>(m_offset));
+}
+
+bool SnapshotNode::IsContainer() const {
+    Tag tag = GetTag();
+    return tag == Tag::Array || tag == Tag::Object || tag == Tag::KeyframeTable;
+}
+
+void SnapshotNode::Expect(Tag tag) const {
+    if (GetTag() != tag) {
+        throw std::runtime_error("Snapshot: unexpected value type");
+    }
+}
+
+uint32_t SnapshotNode::Size() const {
+    return IsContainer() ? m_reader->Read<uint32_t>(m_offset + 1) : 0;
+}
+
+SnapshotNode SnapshotNode::Get(std::string_view key) const {
+    Expect(Tag::Object);
+    uint32_t keyId = 0;
+    if (!m_reader->FindString(key, keyId)) {
+        return {};
+    }
+    uint32_t count = Size();
+    size_t pos = BodyOffset();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (m_reader->Read<uint32_t>(pos) == keyId) {
+            return SnapshotNode(m_reader, pos + 4);
+        }
+        pos = m_reader->SkipValue(pos + 4);
+    }
+    return {};
+}
+
+SnapshotNode SnapshotNode::At(uint32_t index) const {
+    Expect(Tag::Array);
+    if (index >= Size()) {
+        throw std::out_of_range("Snapshot: array index out of range");
+    }
+    size_t pos = BodyOffset();
+    for (uint32_t i = 0; i < index; ++i) {
+        pos = m_reader->SkipValue(pos);
+    }
+    return SnapshotNode(m_reader, pos);
+}
+
+bool SnapshotNode::AsBool() const {
+    Tag tag = GetTag();
+    if (tag != Tag::True && tag != Tag::False) {
+        throw std::runtime_error("Snapshot: unexpected value type");
+    }
+    return tag == Tag::True;
+}
+
+int64_t SnapshotNode::AsInt() const {
+    Expect(Tag::Int);
+    return m_reader->Read<int64_t>(m_offset + 1);
+}
+
+double SnapshotNode::AsDouble() const {
+    if (GetTag() == Tag::Int) {
+        return static_cast<double>(AsInt());
+    }
+    Expect(Tag::Double);
+    return m_reader->Read<double>(m_offset + 1);
+}
+
+std::string_view SnapshotNode::AsString() const {
+    Expect(Tag::String);
+    return m_reader->GetString(m_reader->Read<uint32_t>(m_offset + 1));
+}
+
+std::string_view SnapshotNode::AsBytes() const {
+    Expect(Tag::Bytes);
+    return m_reader->GetBlob(m_reader->Read<uint64_t>(m_offset + 1),
+                             m_reader->Read<uint32_t>(m_offset + 9));
+}
+
+size_t SnapshotNode::KeyframeColumnsOffset() const {
+    Expect(Tag::KeyframeTable);
+    return Align8(BodyOffset());
+}
+
+double SnapshotNode::KeyframeTime(uint32_t index) const {
+    size_t columns = KeyframeColumnsOffset();
+    if (index >= Size()) {
+        throw std::out_of_range("Snapshot: keyframe index out of range");
+    }
+    return m_reader->Read<double>(columns + index * 8);
+}
+
+std::string_view SnapshotNode::KeyframeBdata(uint32_t index) const {
+    size_t columns = KeyframeColumnsOffset();
+    size_t count = Size();
+    if (index >= count) {
+        throw std::out_of_range("Snapshot: keyframe index out of range");
+    }
+    uint64_t offset = m_reader->Read<uint64_t>(columns + count * 8 + index * 8);
+    uint32_t length = m_reader->Read<uint32_t>(columns + count * 16 + index * 4);
+    return m_reader->GetBlob(offset, length);
+}
+
+std::string_view SnapshotNode::KeyframeInInterpolation(uint32_t index) const {
+    size_t columns = KeyframeColumnsOffset();
+    size_t count = Size();
+    if (index >= count) {
+        throw std::out_of_range("Snapshot: keyframe index out of range");
+    }
+    return m_reader->GetString(m_reader->Read<uint32_t>(columns + count * 20 + index * 4));
+}
+
+std::string_view SnapshotNode::KeyframeOutInterpolation(uint32_t index) const {
+    size_t columns = KeyframeColumnsOffset();
+    size_t count = Size();
+    if (index >= count) {
+        throw std::out_of_range("Snapshot: keyframe index out of range");
+    }
+    return m_reader->GetString(m_reader->Read<uint32_t>(columns + count * 24 + index * 4));
+}
+
+} // namespace PyAE
@@ -49,8 +49,17 @@ void init_color_profile(py::module_& m); // Color profile and OCIO settings
 void init_world(py::module_& m);         // World (frame buffer) API
 void init_footage(py::module_& m);       // Footage API
 void init_render(py::module_& m);        // Render API
+void init_frame_writer(py::module_& m);  // Background frame file writer
+void init_render_sequence(py::module_& m); // Frame range render pipeline
+void init_render_cache(py::module_& m);    // Timestamp-validated frame cache
+void init_render_future(py::module_& m);   // Cancellable async frame renders
+void init_incremental_render(py::module_& m); // Dirty-region incremental renders
+void init_thumbnail_cache(py::module_& m); // Item thumbnails generated on idle
 void init_layer_render_options(py::module_& m); // Layer render options API
 void init_sound_data(py::module_& m);    // Sound data API
+void init_hot_reload(py::module_& m);    // Hot reload of user modules
+void init_serialize(py::module_& m);     // Native JSON / snapshot serializer
+void init_snapshot(py::module_& m);      // Binary project snapshots
 }
 
 namespace PyAE {
@@ -567,6 +576,12 @@ PYBIND11_EMBEDDED_MODULE(ae, m) {
     PyAE::init_world(m);
     PyAE::init_footage(m);
     PyAE::init_render(m);
+    PyAE::init_frame_writer(m);
+    PyAE::init_render_sequence(m);
+    PyAE::init_render_cache(m);
+    PyAE::init_render_future(m);
+    PyAE::init_incremental_render(m);
+    PyAE::init_thumbnail_cache(m);
     PyAE::init_layer_render_options(m);
     PyAE::init_sound_data(m);
     // High-level APIs (new)
@@ -574,6 +589,9 @@ PYBIND11_EMBEDDED_MODULE(ae, m) {
     init_menu(m);
     init_render_monitor(m);
     init_async_render(m);
+    PyAE::init_hot_reload(m);
+    PyAE::init_serialize(m);
+    PyAE::init_snapshot(m);
 
     // メモリ診断API
     py::class_<PyAE::MemoryDiagnostics::MemStats>(m, "MemStats")
@@ -0,0 +1,1336 @@
+// ProjectDiff.cpp
+// PyAE - Python for After Effects
+// プロジェクト差分・パッチエンジン
+//
+// 差分は project_to_dict スキーマ上で行い、パッチの適用は ProjectImporter の
+// 復元処理（レイヤー作成・プロパティ・エフェクト・キーフレーム）を再利用する。
+//
+// 対応付けのルール:
+//   - アイテム: ID が一致し種類が同じもの、無ければ (種類, 名前) が一意なもの
+//   - レイヤー: (名前, 種類, 同名の出現順)。ソース・テキスト構造が変わった
+//     レイヤーは削除 + 追加として扱う
+//   - プロパティ: (マッチ名, 同名の出現順) のパス
+
+#include "ProjectDiff.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ScopedHandles.h"
+#include "StringUtils.h"
+#include "AETypeUtils.h"
+#include "Logger.h"
+#include "PyObjectWriter.h"
+#include "ProjectSerializer.h"
+#include "PyCompClasses.h"
+#include "PyLayerClasses.h"
+#include "PyPropertyCore.h"
+#include "PyRenderClasses.h"
+
+namespace PyAE {
+
+namespace {
+
+// =============================================================
+// Helpers
+// =============================================================
+
+template <typename T>
+T GetValue(const py::dict& d, const char* key, T fallback) {
+    if (!d.contains(key)) return fallback;
+    py::object value = d[key];
+    if (value.is_none()) return fallback;
+    try {
+        return value.cast<T>();
+    } catch (const py::cast_error&) {
+        return fallback;
+    }
+}
+
+py::dict GetDict(const py::dict& d, const char* key) {
+    if (d.contains(key)) {
+        py::object value = d[key];
+        if (py::isinstance<py::dict>(value)) return value.cast<py::dict>();
+    }
+    return py::dict();
+}
+
+py::list GetList(const py::dict& d, const char* key) {
+    if (d.contains(key)) {
+        py::object value = d[key];
+        if (py::isinstance<py::list>(value)) return value.cast<py::list>();
+    }
+    return py::list();
+}
+
+std::vector<py::dict> Dicts(const py::list& list) {
+    std::vector<py::dict> out;
+    out.reserve(py::len(list));
+    for (auto handle : list) {
+        if (py::isinstance<py::dict>(handle)) out.push_back(handle.cast<py::dict>());
+    }
+    return out;
+}
+
+py::object Get(const py::dict& d, const char* key) {
+    return d.contains(key) ? py::object(d[key]) : py::object(py::none());
+}
+
+// キーの有無も含めて同じ値か
+bool SameValue(const py::dict& a, const py::dict& b, const char* key) {
+    bool hasA = a.contains(key);
+    bool hasB = b.contains(key);
+    if (hasA != hasB) return false;
+    return !hasA || py::object(a[key]).equal(py::object(b[key]));
+}
+
+// パスに1段追加した新しいリスト
+py::list Extend(const py::list& path, const std::string& matchName, int occurrence) {
+    py::list out;
+    for (auto step : path) out.append(step);
+    out.append(py::make_tuple(matchName, occurrence));
+    return out;
+}
+
+// 指定キーを除いた浅いコピー
+py::dict Without(const py::dict& d, std::initializer_list<const char*> keys) {
+    py::dict out;
+    for (auto item : d) {
+        std::string key = py::str(item.first);
+        if (std::none_of(keys.begin(), keys.end(), [&](const char* k) { return key == k; })) {
+            out[item.first] = item.second;
+        }
+    }
+    return out;
+}
+
+// 値を持つキーを除いたコピー（キーフレーム差分では静的値はキーで上書きされる）
+py::dict WithoutValues(const py::dict& d) {
+    return Without(d, {"keyframes", "num_keys", "value", "_value", "bdata"});
+}
+
+template <typename F>
+void TryApply(const char* what, F&& f) {
+    try {
+        f();
+    } catch (const std::exception& e) {
+        PYAE_LOG_DEBUG("ProjectDiff", std::string(what) + ": " + e.what());
+    }
+}
+
+py::dict MakeOp(const char* name) {
+    py::dict op;
+    op["op"] = name;
+    return op;
+}
+
+// (マッチ名, 同名の出現順) のリストとして子を列挙する
+std::vector<std::pair<std::pair<std::string, int>, py::dict>> KeyedChildren(const py::dict& children) {
+    std::vector<std::pair<std::pair<std::string, int>, py::dict>> out;
+    std::map<std::string, int> seen;
+    for (auto entry : children) {
+        if (!py::isinstance<py::dict>(entry.second)) continue;
+        py::dict data = entry.second.cast<py::dict>();
+        std::string matchName = GetValue<std::string>(data, "match_name", "");
+        if (matchName.empty()) continue;
+        int occurrence = seen[matchName]++;
+        out.push_back({{matchName, occurrence}, data});
+    }
+    return out;
+}
+
+// (種類, 名前) の照合キー（アイテム・レイヤー共通）
+std::string TypeNameKey(const py::dict& d) {
+    return GetValue<std::string>(d, "type", "") + "\x1f" + GetValue<std::string>(d, "name", "");
+}
+
+// set_layer の対象（ApplyLayerSettings と locked）
+const char* const kLayerFields[] = {
+    "active", "in_point", "out_point", "start_time", "solo", "shy",
+    "collapse_transformation", "label", "comment", "is_3d", "is_adjustment", "locked",
+};
+
+// set_item の comp 設定
+const char* const kCompFields[] = {
+    "width", "height", "duration", "frame_rate", "pixel_aspect",
+    "background_color", "work_area_start", "work_area_duration",
+};
+
+// =============================================================
+// Diff
+// =============================================================
+
+class Differ {
+public:
+    Differ(const py::dict& base, const py::dict& target, bool prune)
+        : m_prune(prune)
+    {
+        m_base = Dicts(GetList(base, "items"));
+        m_target = Dicts(GetList(target, "items"));
+        for (const auto& item : m_base) {
+            m_baseIds.insert(GetValue<A_long>(item, "id", 0));
+        }
+        for (const auto& item : m_target) {
+            m_targetById[GetValue<A_long>(item, "id", 0)] = item;
+        }
+    }
+
+    py::dict Run() {
+        MatchItems();
+
+        py::list idMap;
+        for (const auto& [targetId, baseId] : m_targetToBase) {
+            idMap.append(py::make_tuple(targetId, baseId));
+        }
+
+        // 追加アイテム（フォルダ・コンポ・フッテージ・レイヤーを一括作成）
+        py::list added;
+        for (size_t i = 0; i < m_target.size(); ++i) {
+            if (m_match[i] < 0) added.append(m_target[i]);
+        }
+        if (py::len(added) > 0) {
+            py::dict op = MakeOp("add_items");
+            op["items"] = added;
+            m_ops.append(op);
+        }
+
+        for (size_t i = 0; i < m_target.size(); ++i) {
+            if (m_match[i] >= 0) {
+                DiffItem(m_base[static_cast<size_t>(m_match[i])], m_target[i]);
+            }
+        }
+
+        // 削除はフォルダを最後に（フォルダの削除は中身も削除するため）
+        if (m_prune) {
+            for (int pass = 0; pass < 2; ++pass) {
+                for (size_t i = 0; i < m_base.size(); ++i) {
+                    if (m_baseUsed.count(i)) continue;
+                    bool folder = GetValue<std::string>(m_base[i], "type", "") == "Folder";
+                    if (folder != (pass == 1)) continue;
+                    py::dict op = MakeOp("remove_item");
+                    op["id"] = GetValue<A_long>(m_base[i], "id", 0);
+                    m_ops.append(op);
+                }
+            }
+        }
+
+        py::dict patch;
+        patch["version"] = 1;
+        patch["id_map"] = idMap;
+        patch["ops"] = m_ops;
+        return patch;
+    }
+
+private:
+    void MatchItems() {
+        std::map<A_long, size_t> baseById;
+        std::map<std::string, std::vector<size_t>> baseByKey;
+        for (size_t i = 0; i < m_base.size(); ++i) {
+            baseById[GetValue<A_long>(m_base[i], "id", 0)] = i;
+            baseByKey[TypeNameKey(m_base[i])].push_back(i);
+        }
+
+        m_match.assign(m_target.size(), -1);
+
+        // 1. ID と種類が一致
+        for (size_t i = 0; i < m_target.size(); ++i) {
+            auto it = baseById.find(GetValue<A_long>(m_target[i], "id", 0));
+            if (it == baseById.end() || m_baseUsed.count(it->second)) continue;
+            if (!SameValue(m_base[it->second], m_target[i], "type")) continue;
+            Match(i, it->second);
+        }
+
+        // 2. (種類, 名前) が base 側で一意
+        for (size_t i = 0; i < m_target.size(); ++i) {
+            if (m_match[i] >= 0) continue;
+            auto it = baseByKey.find(TypeNameKey(m_target[i]));
+            if (it == baseByKey.end() || it->second.size() != 1) continue;
+            if (m_baseUsed.count(it->second.front())) continue;
+            Match(i, it->second.front());
+        }
+    }
+
+    void Match(size_t targetIndex, size_t baseIndex) {
+        m_match[targetIndex] = static_cast<long>(baseIndex);
+        m_baseUsed.insert(baseIndex);
+        m_targetToBase[GetValue<A_long>(m_target[targetIndex], "id", 0)] =
+            GetValue<A_long>(m_base[baseIndex], "id", 0);
+    }
+
+    // target 側のIDを base 側に変換（未対応は nullopt）
+    std::optional<A_long> ToBaseId(const py::dict& d, const char* key) const {
+        if (!d.contains(key) || d[key].is_none()) return std::nullopt;
+        auto it = m_targetToBase.find(GetValue<A_long>(d, key, 0));
+        if (it == m_targetToBase.end()) return std::nullopt;
+        return it->second;
+    }
+
+    // 親フォルダが変わったか（項目に無いID = ルートは同一視する）
+    bool ParentChanged(const py::dict& base, const py::dict& target) const {
+        A_long baseParent = GetValue<A_long>(base, "parent_folder_id", 0);
+        bool baseRoot = m_baseIds.find(baseParent) == m_baseIds.end();
+        A_long targetParent = GetValue<A_long>(target, "parent_folder_id", 0);
+        bool targetRoot = m_targetById.find(targetParent) == m_targetById.end();
+        if (baseRoot || targetRoot) return baseRoot != targetRoot;
+        auto mapped = ToBaseId(target, "parent_folder_id");
+        return !mapped || *mapped != baseParent;
+    }
+
+    void DiffItem(const py::dict& base, const py::dict& target) {
+        A_long id = GetValue<A_long>(base, "id", 0);
+        std::string type = GetValue<std::string>(target, "type", "");
+
+        py::dict op = MakeOp("set_item");
+        op["id"] = id;
+        bool changed = false;
+
+        if (!SameValue(base, target, "name")) {
+            op["name"] = Get(target, "name");
+            changed = true;
+        }
+        if (ParentChanged(base, target)) {
+            op["parent_folder_id"] = Get(target, "parent_folder_id");
+            changed = true;
+        }
+
+        if (type == "Comp") {
+            py::dict baseComp = GetDict(base, "comp_data");
+            py::dict targetComp = GetDict(target, "comp_data");
+            py::dict settings;
+            for (const char* key : kCompFields) {
+                if (targetComp.contains(key) && !SameValue(baseComp, targetComp, key)) {
+                    settings[key] = targetComp[key];
+                }
+            }
+            if (py::len(settings) > 0) {
+                op["comp"] = settings;
+                changed = true;
+            }
+            if (changed) m_ops.append(op);
+            DiffLayers(id, Dicts(GetList(baseComp, "layers")), Dicts(GetList(targetComp, "layers")));
+            return;
+        }
+
+        if (type == "Footage") {
+            py::dict baseFootage = GetDict(base, "footage_data");
+            py::dict targetFootage = GetDict(target, "footage_data");
+            if (GetValue<std::string>(targetFootage, "footage_type", "") == "File" &&
+                targetFootage.contains("file_path") && !SameValue(baseFootage, targetFootage, "file_path")) {
+                op["file_path"] = targetFootage["file_path"];
+                changed = true;
+            }
+        }
+
+        if (changed) m_ops.append(op);
+    }
+
+    // ---------------------------------------------------------
+    // Layers
+    // ---------------------------------------------------------
+
+    // 同じレイヤーとして更新できるか（ソース・テキスト構造が同じ）
+    bool LayerCompatible(const py::dict& base, const py::dict& target) const {
+        if (!SameValue(base, target, "is_null") || !SameValue(base, target, "source_text") ||
+            !SameValue(base, target, "text_animators")) {
+            return false;
+        }
+        bool baseHasSource = base.contains("source_item_id");
+        bool targetHasSource = target.contains("source_item_id");
+        if (baseHasSource != targetHasSource) return false;
+        if (!targetHasSource) return true;
+        auto mapped = ToBaseId(target, "source_item_id");
+        return mapped && *mapped == GetValue<A_long>(base, "source_item_id", 0);
+    }
+
+    // 追加するソリッドレイヤーには元のソリッドのサイズを持たせる
+    py::dict WithSolidSize(const py::dict& layer) const {
+        if (GetValue<std::string>(layer, "type", "") != "solid") return layer;
+        auto it = m_targetById.find(GetValue<A_long>(layer, "source_item_id", 0));
+        if (it == m_targetById.end()) return layer;
+        py::dict footage = GetDict(it->second, "footage_data");
+        if (!footage.contains("width") || !footage.contains("height")) return layer;
+        py::dict copy = layer.attr("copy")().cast<py::dict>();
+        copy["width"] = footage["width"];
+        copy["height"] = footage["height"];
+        return copy;
+    }
+
+    void DiffLayers(A_long compId, std::vector<py::dict> base, std::vector<py::dict> target) {
+        auto byIndex = [](const py::dict& a, const py::dict& b) {
+            return GetValue<int>(a, "index", 0) < GetValue<int>(b, "index", 0);
+        };
+        std::stable_sort(base.begin(), base.end(), byIndex);
+        std::stable_sort(target.begin(), target.end(), byIndex);
+
+        // (種類, 名前, 出現順) で対応付け
+        std::map<std::string, std::vector<size_t>> baseByKey;
+        for (size_t i = 0; i < base.size(); ++i) {
+            baseByKey[TypeNameKey(base[i])].push_back(i);
+        }
+        std::map<std::string, size_t> seen;
+        std::vector<long> match(target.size(), -1);
+        std::set<size_t> replaced;
+        std::set<size_t> used;
+        for (size_t i = 0; i < target.size(); ++i) {
+            std::string key = TypeNameKey(target[i]);
+            size_t occurrence = seen[key]++;
+            auto it = baseByKey.find(key);
+            if (it == baseByKey.end() || occurrence >= it->second.size()) continue;
+            size_t b = it->second[occurrence];
+            used.insert(b);
+            if (LayerCompatible(base[b], target[i])) {
+                match[i] = static_cast<long>(b);
+            } else {
+                replaced.insert(b);
+            }
+        }
+
+        auto layerOp = [&](const char* name, int layerIndex) {
+            py::dict op = MakeOp(name);
+            op["comp"] = compId;
+            op["layer"] = layerIndex;
+            return op;
+        };
+
+        // 削除（置き換えは常に、消えたレイヤーは prune 時のみ）
+        bool structural = false;
+        for (size_t b = 0; b < base.size(); ++b) {
+            if (replaced.count(b) || (m_prune && !used.count(b))) {
+                m_ops.append(layerOp("remove_layer", GetValue<int>(base[b], "index", 0)));
+                structural = true;
+            }
+        }
+
+        // 既存レイヤーの更新
+        for (size_t i = 0; i < target.size(); ++i) {
+            if (match[i] < 0) continue;
+            const py::dict& b = base[static_cast<size_t>(match[i])];
+            const py::dict& t = target[i];
+            int baseIndex = GetValue<int>(b, "index", 0);
+
+            py::dict changes;
+            for (const char* key : kLayerFields) {
+                if (!t.contains(key) && std::string(key) != "comment") continue;
+                if (!SameValue(b, t, key)) {
+                    changes[key] = t.contains(key) ? py::object(t[key]) : py::object(py::str(""));
+                }
+            }
+            if (py::len(changes) > 0) {
+                py::dict op = layerOp("set_layer", baseIndex);
+                op["changes"] = changes;
+                m_ops.append(op);
+            }
+
+            DiffChildren(compId, baseIndex, py::list(), GetDict(b, "properties"), GetDict(t, "properties"));
+            DiffEffects(compId, baseIndex, Dicts(GetList(b, "effects")), Dicts(GetList(t, "effects")));
+        }
+
+        // 追加
+        for (size_t i = 0; i < target.size(); ++i) {
+            if (match[i] >= 0) continue;
+            py::dict op = MakeOp("add_layer");
+            op["comp"] = compId;
+            op["index"] = GetValue<int>(target[i], "index", 0);
+            op["data"] = WithSolidSize(target[i]);
+            m_ops.append(op);
+            structural = true;
+        }
+
+        // 並び順（new 側インデックス → base 側インデックス、追加分は None）
+        std::map<int, long> slotBase;
+        bool reordered = false;
+        py::list order;
+        for (size_t i = 0; i < target.size(); ++i) {
+            int newIndex = GetValue<int>(target[i], "index", 0);
+            long b = match[i] >= 0 ? GetValue<int>(base[static_cast<size_t>(match[i])], "index", 0) : -1;
+            slotBase[newIndex] = b;
+            reordered = reordered || b != newIndex;
+            order.append(py::make_tuple(newIndex, b >= 0 ? py::object(py::int_(b)) : py::object(py::none())));
+        }
+        if (structural || reordered) {
+            py::dict op = MakeOp("order_layers");
+            op["comp"] = compId;
+            op["order"] = order;
+            m_ops.append(op);
+        }
+
+        // ペアレント（new 側インデックスで指定）
+        for (size_t i = 0; i < target.size(); ++i) {
+            const py::dict& t = target[i];
+            bool hasParent = t.contains("parent_index") && !t["parent_index"].is_none();
+            int parent = GetValue<int>(t, "parent_index", -1);
+
+            bool changed;
+            if (match[i] < 0) {
+                changed = hasParent;
+            } else {
+                const py::dict& b = base[static_cast<size_t>(match[i])];
+                bool baseHasParent = b.contains("parent_index") && !b["parent_index"].is_none();
+                if (hasParent != baseHasParent) {
+                    changed = true;
+                } else if (!hasParent) {
+                    changed = false;
+                } else {
+                    auto slot = slotBase.find(parent);
+                    changed = slot == slotBase.end() || slot->second != GetValue<int>(b, "parent_index", -1);
+                }
+            }
+            if (!changed) continue;
+
+            py::dict op = MakeOp("set_parent");
+            op["comp"] = compId;
+            op["layer"] = GetValue<int>(t, "index", 0);
+            op["parent"] = hasParent ? py::object(py::int_(parent)) : py::object(py::none());
+            m_ops.append(op);
+        }
+    }
+
+    // ---------------------------------------------------------
+    // Properties
+    // ---------------------------------------------------------
+
+    py::dict PropertyOp(const char* name, A_long compId, int layerIndex, const py::list& path) {
+        py::dict op = MakeOp(name);
+        op["comp"] = compId;
+        op["layer"] = layerIndex;
+        op["path"] = path;
+        return op;
+    }
+
+    void DiffChildren(A_long compId, int layerIndex, const py::list& path,
+                      const py::dict& base, const py::dict& target) {
+        std::map<std::pair<std::string, int>, py::dict> baseByKey;
+        for (auto& [key, data] : KeyedChildren(base)) {
+            baseByKey.emplace(key, data);
+        }
+
+        for (auto& [key, data] : KeyedChildren(target)) {
+            py::list childPath = Extend(path, key.first, key.second);
+
+            auto it = baseByKey.find(key);
+            if (it == baseByKey.end()) {
+                py::dict op = PropertyOp("set_property", compId, layerIndex, childPath);
+                op["data"] = data;
+                m_ops.append(op);
+                continue;
+            }
+            const py::dict& old = it->second;
+            if (old.equal(data)) continue;
+
+            bool group = GetValue<std::string>(data, "type", "") == "group";
+            if (group && GetValue<std::string>(old, "type", "") == "group") {
+                if (!SameValue(old, data, "enabled")) {
+                    py::dict groupData = Without(data, {"children"});
+                    groupData["children"] = py::dict();
+                    py::dict op = PropertyOp("set_property", compId, layerIndex, childPath);
+                    op["data"] = groupData;
+                    m_ops.append(op);
+                }
+                DiffChildren(compId, layerIndex, childPath, GetDict(old, "children"), GetDict(data, "children"));
+            } else {
+                DiffLeaf(compId, layerIndex, childPath, old, data);
+            }
+        }
+    }
+
+    void DiffLeaf(A_long compId, int layerIndex, const py::list& path,
+                  const py::dict& base, const py::dict& target) {
+        py::list baseKeys = GetList(base, "keyframes");
+        py::list targetKeys = GetList(target, "keyframes");
+
+        // キーフレームだけが変わった場合はキー単位の差分にする
+        // （シェイプパスは頂点の設定でキーが作られるため全体を置き換える）
+        bool keyOnly = py::len(baseKeys) > 0 && py::len(targetKeys) > 0 &&
+                       GetValue<std::string>(target, "match_name", "") != "ADBE Vector Shape - Group" &&
+                       WithoutValues(base).equal(WithoutValues(target));
+        if (!keyOnly) {
+            py::dict op = PropertyOp("set_property", compId, layerIndex, path);
+            op["data"] = target;
+            m_ops.append(op);
+            return;
+        }
+
+        std::map<double, py::dict> baseByTime;
+        for (const auto& kf : Dicts(baseKeys)) {
+            baseByTime.emplace(GetValue<double>(kf, "time", 0.0), kf);
+        }
+
+        py::list add;
+        std::set<double> kept;
+        for (const auto& kf : Dicts(targetKeys)) {
+            double time = GetValue<double>(kf, "time", 0.0);
+            auto it = baseByTime.find(time);
+            if (it != baseByTime.end() && it->second.equal(kf)) {
+                kept.insert(time);
+            } else {
+                add.append(kf);
+            }
+        }
+        py::list remove;
+        for (const auto& [time, kf] : baseByTime) {
+            if (!kept.count(time)) remove.append(time);
+        }
+        if (py::len(add) == 0 && py::len(remove) == 0) return;
+
+        py::dict op = PropertyOp("keyframes", compId, layerIndex, path);
+        op["remove"] = remove;
+        op["add"] = add;
+        m_ops.append(op);
+    }
+
+    // ---------------------------------------------------------
+    // Effects
+    // ---------------------------------------------------------
+
+    void DiffEffects(A_long compId, int layerIndex,
+                     const std::vector<py::dict>& base, const std::vector<py::dict>& target) {
+        bool sameStack = base.size() == target.size() &&
+            std::equal(base.begin(), base.end(), target.begin(),
+                       [](const py::dict& a, const py::dict& b) { return SameValue(a, b, "match_name"); });
+
+        if (!sameStack) {
+            py::dict op = MakeOp("replace_effects");
+            op["comp"] = compId;
+            op["layer"] = layerIndex;
+            py::list effects;
+            for (const auto& effect : target) effects.append(effect);
+            op["effects"] = effects;
+            m_ops.append(op);
+            return;
+        }
+
+        for (size_t e = 0; e < target.size(); ++e) {
+            const py::dict& b = base[e];
+            const py::dict& t = target[e];
+            if (b.equal(t)) continue;
+
+            py::dict changes;
+            for (const char* key : {"enabled", "stream_name"}) {
+                if (t.contains(key) && !SameValue(b, t, key)) changes[key] = t[key];
+            }
+            if (py::len(changes) > 0) {
+                py::dict op = MakeOp("set_effect");
+                op["comp"] = compId;
+                op["layer"] = layerIndex;
+                op["effect"] = static_cast<int>(e);
+                op["changes"] = changes;
+                m_ops.append(op);
+            }
+
+            std::map<int, py::dict> baseParams;
+            for (const auto& param : Dicts(GetList(b, "params"))) {
+                baseParams.emplace(GetValue<int>(param, "index", -1), param);
+            }
+            for (const auto& param : Dicts(GetList(t, "params"))) {
+                auto it = baseParams.find(GetValue<int>(param, "index", -1));
+                if (it == baseParams.end() || it->second.equal(param)) continue;
+                py::dict op = MakeOp("set_effect_param");
+                op["comp"] = compId;
+                op["layer"] = layerIndex;
+                op["effect"] = static_cast<int>(e);
+                op["data"] = param;
+                m_ops.append(op);
+            }
+        }
+    }
+
+    bool m_prune;
+    std::vector<py::dict> m_base;
+    std::vector<py::dict> m_target;
+    std::set<A_long> m_baseIds;
+    std::map<A_long, py::dict> m_targetById;
+    std::vector<long> m_match;
+    std::set<size_t> m_baseUsed;
+    std::map<A_long, A_long> m_targetToBase;
+    py::list m_ops;
+};
+
+// =============================================================
+// Stream navigation
+// =============================================================
+
+std::string GetStreamMatchName(AEGP_StreamRefH streamH) {
+    char matchName[AEGP_MAX_STREAM_MATCH_NAME_SIZE + 1];
+    matchName[AEGP_MAX_STREAM_MATCH_NAME_SIZE] = '\0';
+    if (PluginState::Instance().GetSuites().dynamicStreamSuite->AEGP_GetMatchName(
+            streamH, matchName) != A_Err_NONE) {
+        return {};
+    }
+    return matchName;
+}
+
+// (マッチ名, 出現順) の子を取得。create=true ならインデックスグループに追加する
+ScopedStreamRef FindChild(AEGP_StreamRefH parentH, const std::string& matchName, int occurrence, bool create) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_StreamGroupingType grouping = AEGP_StreamGroupingType_NONE;
+    suites.dynamicStreamSuite->AEGP_GetStreamGroupingType(parentH, &grouping);
+
+    AEGP_StreamRefH childH = nullptr;
+    if (grouping == AEGP_StreamGroupingType_NAMED_GROUP) {
+        if (suites.dynamicStreamSuite->AEGP_GetNewStreamRefByMatchname(
+                state.GetPluginID(), parentH, matchName.c_str(), &childH) != A_Err_NONE) {
+            childH = nullptr;
+        }
+        return ScopedStreamRef(suites.streamSuite, childH);
+    }
+    if (grouping != AEGP_StreamGroupingType_INDEXED_GROUP) {
+        return ScopedStreamRef();
+    }
+
+    A_long count = 0;
+    suites.dynamicStreamSuite->AEGP_GetNumStreamsInGroup(parentH, &count);
+    for (A_long i = 0; i < count; ++i) {
+        AEGP_StreamRefH candidateH = nullptr;
+        if (suites.dynamicStreamSuite->AEGP_GetNewStreamRefByIndex(
+                state.GetPluginID(), parentH, i, &candidateH) != A_Err_NONE) {
+            continue;
+        }
+        ScopedStreamRef candidate(suites.streamSuite, candidateH);
+        if (GetStreamMatchName(candidateH) == matchName && occurrence-- == 0) {
+            return candidate;
+        }
+    }
+
+    A_Boolean canAdd = FALSE;
+    if (create &&
+        suites.dynamicStreamSuite->AEGP_CanAddStream(parentH, matchName.c_str(), &canAdd) == A_Err_NONE &&
+        canAdd &&
+        suites.dynamicStreamSuite->AEGP_AddStream(
+            state.GetPluginID(), parentH, matchName.c_str(), &childH) != A_Err_NONE) {
+        childH = nullptr;
+    }
+    return ScopedStreamRef(suites.streamSuite, childH);
+}
+
+// レイヤーのルートストリームからパスを辿る（末尾のみ作成を許可）
+ScopedStreamRef ResolvePath(AEGP_LayerH layerH, const py::list& path, bool createLast) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_StreamRefH rootH = nullptr;
+    if (suites.dynamicStreamSuite->AEGP_GetNewStreamRefForLayer(
+            state.GetPluginID(), layerH, &rootH) != A_Err_NONE) {
+        return ScopedStreamRef();
+    }
+    ScopedStreamRef current(suites.streamSuite, rootH);
+
+    size_t depth = py::len(path);
+    for (size_t i = 0; i < depth && current; ++i) {
+        py::sequence step = path[i].cast<py::sequence>();
+        if (py::len(step) < 2) return ScopedStreamRef();
+        current = FindChild(current.Get(), step[0].cast<std::string>(), step[1].cast<int>(),
+                            createLast && i + 1 == depth);
+    }
+    return current;
+}
+
+// 静的値・キーフレームを復元する前に既存のキーとエクスプレッションを消す
+void ClearStream(AEGP_StreamRefH streamH, const py::dict& data) {
+    PyProperty prop(streamH, false);
+    if (GetValue<std::string>(data, "expression", "").empty()) {
+        TryApply("clear expression", [&] {
+            if (prop.HasExpression()) prop.SetExpression("");
+        });
+    }
+    TryApply("clear keyframes", [&] {
+        for (int i = prop.GetNumKeyframes() - 1; i >= 0; --i) {
+            prop.RemoveKeyframe(i);
+        }
+    });
+}
+
+AEGP_StreamType GetStreamType(AEGP_StreamRefH streamH) {
+    AEGP_StreamType type = AEGP_StreamType_NO_DATA;
+    if (PluginState::Instance().GetSuites().streamSuite->AEGP_GetStreamType(streamH, &type) != A_Err_NONE) {
+        return AEGP_StreamType_NO_DATA;
+    }
+    return type;
+}
+
+} // namespace
+
+// =============================================================
+// ProjectDiff
+// =============================================================
+
+py::dict ProjectDiff::Diff(const py::dict& base, const py::dict& target, bool prune) {
+    return Differ(base, target, prune).Run();
+}
+
+py::dict ProjectDiff::CaptureProject(AEGP_ProjectH projectH,
+                                     const py::dict& previous,
+                                     const std::optional<std::tuple<int, int, int, int>>& since) {
+    const auto& suites = PluginState::Instance().GetSuites();
+    if (!suites.itemSuite || !projectH) {
+        throw std::runtime_error("No project open");
+    }
+
+    std::map<A_long, py::dict> previousById;
+    if (since) {
+        for (const auto& item : Dicts(GetList(previous, "items"))) {
+            previousById.emplace(GetValue<A_long>(item, "id", 0), item);
+        }
+    }
+
+    PyObjectWriter writer;
+    ProjectSerializer serializer(writer);
+    std::vector<std::pair<size_t, py::dict>> reused;
+
+    writer.BeginObject();
+    writer.Key("version");
+    writer.Int(1);
+    writer.Key("items");
+    writer.BeginArray();
+
+    size_t position = 0;
+    AEGP_ItemH itemH = nullptr;
+    A_Err err = suites.itemSuite->AEGP_GetFirstProjItem(projectH, &itemH);
+    while (err == A_Err_NONE && itemH) {
+        // since 以降レンダリング結果に影響する変更が無ければ、前回の内容を使う
+        bool reuse = false;
+        A_long id = 0;
+        AEGP_ItemType type = AEGP_ItemType_NONE;
+        suites.itemSuite->AEGP_GetItemID(itemH, &id);
+        suites.itemSuite->AEGP_GetItemType(itemH, &type);
+        auto prev = previousById.find(id);
+        if (prev != previousById.end() && type != AEGP_ItemType_FOLDER) {
+            A_Time duration = {0, 1};
+            suites.itemSuite->AEGP_GetItemDuration(itemH, &duration);
+            try {
+                reuse = !PyRenderer::HasItemChangedSinceTimestamp(
+                    reinterpret_cast<uintptr_t>(itemH), 0.0, AETypeUtils::TimeToSeconds(duration), *since);
+            } catch (const std::exception&) {
+                reuse = false;
+            }
+        }
+
+        serializer.WriteItem(itemH, !reuse);
+        if (reuse) reused.emplace_back(position, prev->second);
+        ++position;
+
+        AEGP_ItemH nextH = nullptr;
+        err = suites.itemSuite->AEGP_GetNextProjItem(projectH, itemH, &nextH);
+        itemH = nextH;
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+
+    py::dict result = writer.GetResult().cast<py::dict>();
+    py::list items = GetList(result, "items");
+    for (const auto& [index, prev] : reused) {
+        py::dict item = items[index].cast<py::dict>();
+        if (!SameValue(item, prev, "type")) continue;
+        for (const char* key : {"comp_data", "footage_data"}) {
+            if (prev.contains(key)) item[key] = prev[key];
+        }
+    }
+    return result;
+}
+
+// =============================================================
+// PatchApplier
+// =============================================================
+
+PatchApplier::PatchApplier(AEGP_ProjectH projectH)
+    : m_projectH(projectH)
+    , m_importer(projectH)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+
+    AEGP_ItemH itemH = nullptr;
+    A_Err err = suites.itemSuite->AEGP_GetFirstProjItem(m_projectH, &itemH);
+    while (err == A_Err_NONE && itemH) {
+        A_long id = 0;
+        if (suites.itemSuite->AEGP_GetItemID(itemH, &id) == A_Err_NONE) {
+            m_baseItems[id] = itemH;
+        }
+        AEGP_ItemH nextH = nullptr;
+        err = suites.itemSuite->AEGP_GetNextProjItem(m_projectH, itemH, &nextH);
+        itemH = nextH;
+    }
+}
+
+void PatchApplier::Apply(const py::dict& patch) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    // 追加データ内の new 側IDを既存アイテムへ解決できるようにする
+    for (auto handle : GetList(patch, "id_map")) {
+        py::sequence pair = handle.cast<py::sequence>();
+        if (py::len(pair) < 2) continue;
+        AEGP_ItemH itemH = ResolveBaseItem(pair[1].cast<A_long>());
+        if (itemH) m_importer.RegisterItem(pair[0].cast<A_long>(), itemH);
+    }
+
+    ScopedUndoGroup undo(suites.utilitySuite, state.GetPluginID(), "Apply project patch");
+
+    for (const auto& op : Dicts(GetList(patch, "ops"))) {
+        try {
+            ApplyOp(op);
+            ++m_stats.ops;
+        } catch (const std::exception& e) {
+            ++m_stats.skipped;
+            PYAE_LOG_WARNING("ProjectDiff", "Patch op '" + GetValue<std::string>(op, "op", "") +
+                             "' failed: " + e.what());
+        }
+    }
+
+    FinishComps();
+
+    const auto& imported = m_importer.GetStats();
+    m_stats.items += imported.items;
+    m_stats.layers += imported.layers;
+    m_stats.properties += imported.properties;
+    m_stats.keyframes += imported.keyframes;
+    m_stats.effects += imported.effects;
+
+    PYAE_LOG_INFO("ProjectDiff", "Applied ops=" + std::to_string(m_stats.ops) +
+                  ", skipped=" + std::to_string(m_stats.skipped) +
+                  ", layers=" + std::to_string(m_stats.layers) +
+                  ", properties=" + std::to_string(m_stats.properties) +
+                  ", keyframes=" + std::to_string(m_stats.keyframes));
+}
+
+void PatchApplier::ApplyOp(const py::dict& op) {
+    std::string name = GetValue<std::string>(op, "op", "");
+    if (name == "add_items") AddItems(op);
+    else if (name == "set_item") SetItem(op);
+    else if (name == "remove_item") RemoveItem(op);
+    else if (name == "remove_layer") RemoveLayer(op);
+    else if (name == "set_layer") SetLayer(op);
+    else if (name == "add_layer") AddLayer(op);
+    else if (name == "order_layers") OrderLayers(op);
+    else if (name == "set_parent") SetParent(op);
+    else if (name == "set_property") SetProperty(op);
+    else if (name == "keyframes") ApplyKeyframes(op);
+    else if (name == "set_effect") SetEffect(op);
+    else if (name == "set_effect_param") SetEffectParam(op);
+    else if (name == "replace_effects") ReplaceEffects(op);
+    else throw std::runtime_error("Unknown patch op: " + name);
+}
+
+AEGP_ItemH PatchApplier::ResolveBaseItem(A_long id) const {
+    auto it = m_baseItems.find(id);
+    return it != m_baseItems.end() ? it->second : nullptr;
+}
+
+// ---------------------------------------------------------
+// Items
+// ---------------------------------------------------------
+
+void PatchApplier::AddItems(const py::dict& op) {
+    py::dict data;
+    data["version"] = 1;
+    data["items"] = GetList(op, "items");
+    m_importer.ImportProject(data);
+}
+
+void PatchApplier::SetItem(const py::dict& op) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_ItemH itemH = ResolveBaseItem(GetValue<A_long>(op, "id", 0));
+    if (!itemH) throw std::runtime_error("Item not found");
+
+    if (op.contains("name")) {
+        std::wstring wname = StringUtils::Utf8ToWide(GetValue<std::string>(op, "name", ""));
+        A_Err err = suites.itemSuite->AEGP_SetItemName(
+            itemH, reinterpret_cast<const A_UTF16Char*>(wname.c_str()));
+        if (err != A_Err_NONE) throw std::runtime_error("Failed to set item name");
+    }
+
+    if (op.contains("parent_folder_id")) {
+        const auto& items = m_importer.GetItems();
+        auto it = items.find(GetValue<A_long>(op, "parent_folder_id", 0));
+        AEGP_ItemH parentH = nullptr;
+        if (it != items.end()) {
+            parentH = it->second;
+        } else {
+            suites.projSuite->AEGP_GetProjectRootFolder(m_projectH, &parentH);
+        }
+        if (parentH) suites.itemSuite->AEGP_SetItemParentFolder(itemH, parentH);
+    }
+
+    py::dict settings = GetDict(op, "comp");
+    if (py::len(settings) > 0) {
+        AEGP_CompH compH = nullptr;
+        if (suites.compSuite->AEGP_GetCompFromItem(itemH, &compH) != A_Err_NONE || !compH) {
+            throw std::runtime_error("Item is not a composition");
+        }
+        PyComp comp(compH);
+        if (settings.contains("width") || settings.contains("height")) {
+            TryApply("dimensions", [&] {
+                comp.SetDimensions(GetValue<int>(settings, "width", comp.GetWidth()),
+                                   GetValue<int>(settings, "height", comp.GetHeight()));
+            });
+        }
+        if (settings.contains("frame_rate")) {
+            TryApply("frame_rate", [&] { comp.SetFrameRate(GetValue<double>(settings, "frame_rate", 30.0)); });
+        }
+        if (settings.contains("duration")) {
+            TryApply("duration", [&] { comp.SetDuration(GetValue<double>(settings, "duration", 10.0)); });
+        }
+        if (settings.contains("pixel_aspect")) {
+            TryApply("pixel_aspect", [&] { comp.SetPixelAspect(GetValue<double>(settings, "pixel_aspect", 1.0)); });
+        }
+        py::list bg = GetList(settings, "background_color");
+        if (py::len(bg) >= 3) {
+            TryApply("bg_color", [&] { comp.SetBgColor(py::make_tuple(bg[0], bg[1], bg[2])); });
+        }
+        if (settings.contains("work_area_start")) {
+            TryApply("work_area_start", [&] {
+                comp.SetWorkAreaStart(GetValue<double>(settings, "work_area_start", 0.0));
+            });
+        }
+        if (settings.contains("work_area_duration")) {
+            TryApply("work_area_duration", [&] {
+                comp.SetWorkAreaDuration(GetValue<double>(settings, "work_area_duration", 0.0));
+            });
+        }
+    }
+
+    if (op.contains("file_path") && suites.footageSuite) {
+        std::wstring wpath = StringUtils::Utf8ToWide(GetValue<std::string>(op, "file_path", ""));
+        AEGP_FootageH footageH = nullptr;
+        A_Err err = suites.footageSuite->AEGP_NewFootage(
+            state.GetPluginID(), reinterpret_cast<const A_UTF16Char*>(wpath.c_str()),
+            nullptr, nullptr, AEGP_InterpretationStyle_NO_DIALOG_GUESS, nullptr, &footageH);
+        if (err != A_Err_NONE || !footageH) throw std::runtime_error("Failed to load footage");
+        err = suites.footageSuite->AEGP_ReplaceItemMainFootage(footageH, itemH);
+        if (err != A_Err_NONE) {
+            suites.footageSuite->AEGP_DisposeFootage(footageH);
+            throw std::runtime_error("Failed to replace footage");
+        }
+    }
+
+    ++m_stats.items;
+}
+
+void PatchApplier::RemoveItem(const py::dict& op) {
+    const auto& suites = PluginState::Instance().GetSuites();
+
+    A_long id = GetValue<A_long>(op, "id", 0);
+    AEGP_ItemH itemH = ResolveBaseItem(id);
+    if (!itemH) return;  // 親フォルダと一緒に削除済み
+
+    m_comps.erase(id);
+    A_Err err = suites.itemSuite->AEGP_DeleteItem(itemH);
+    if (err != A_Err_NONE) throw std::runtime_error("Failed to delete item");
+    m_baseItems.erase(id);
+    ++m_stats.items;
+}
+
+// ---------------------------------------------------------
+// Layers
+// ---------------------------------------------------------
+
+PatchApplier::CompState* PatchApplier::GetCompState(A_long id) {
+    auto found = m_comps.find(id);
+    if (found != m_comps.end()) return &found->second;
+
+    const auto& suites = PluginState::Instance().GetSuites();
+    AEGP_ItemH itemH = ResolveBaseItem(id);
+    AEGP_CompH compH = nullptr;
+    if (!itemH || suites.compSuite->AEGP_GetCompFromItem(itemH, &compH) != A_Err_NONE || !compH) {
+        throw std::runtime_error("Composition not found");
+    }
+
+    // レイヤーの追加・削除でインデックスがずれるため、最初に触れた時点の並びを保持する
+    CompState& state = m_comps[id];
+    state.compH = compH;
+    A_long numLayers = 0;
+    suites.layerSuite->AEGP_GetCompNumLayers(compH, &numLayers);
+    for (A_long i = 0; i < numLayers; ++i) {
+        AEGP_LayerH layerH = nullptr;
+        if (suites.layerSuite->AEGP_GetCompLayerByIndex(compH, i, &layerH) == A_Err_NONE && layerH) {
+            state.baseLayers[static_cast<int>(i)] = layerH;
+        }
+    }
+    return &state;
+}
+
+AEGP_LayerH PatchApplier::GetBaseLayer(const py::dict& op, CompState** stateOut) {
+    CompState* state = GetCompState(GetValue<A_long>(op, "comp", 0));
+    auto it = state->baseLayers.find(GetValue<int>(op, "layer", -1));
+    if (it == state->baseLayers.end()) throw std::runtime_error("Layer not found");
+    Unlock(*state, it->second);
+    if (stateOut) *stateOut = state;
+    return it->second;
+}
+
+AEGP_LayerH PatchApplier::GetNewLayer(CompState& state, int index) const {
+    const auto& source = state.ordered ? state.order : state.baseLayers;
+    auto it = source.find(index);
+    if (it != source.end()) return it->second;
+    auto added = state.addedLayers.find(index);
+    return added != state.addedLayers.end() ? added->second : nullptr;
+}
+
+void PatchApplier::Unlock(CompState& state, AEGP_LayerH layerH) {
+    if (state.relock.count(layerH)) return;
+    PyLayer layer(layerH);
+    bool locked = false;
+    TryApply("locked", [&] { locked = layer.GetLocked(); });
+    if (locked) {
+        layer.SetLocked(false);
+        state.relock.insert(layerH);
+    }
+}
+
+void PatchApplier::RemoveLayer(const py::dict& op) {
+    CompState* state = nullptr;
+    AEGP_LayerH layerH = GetBaseLayer(op, &state);
+    state->relock.erase(layerH);
+    state->baseLayers.erase(GetValue<int>(op, "layer", -1));
+    PyLayer(layerH).Delete();
+    ++m_stats.layers;
+}
+
+void PatchApplier::SetLayer(const py::dict& op) {
+    CompState* state = nullptr;
+    AEGP_LayerH layerH = GetBaseLayer(op, &state);
+    PyLayer layer(layerH);
+    py::dict changes = GetDict(op, "changes");
+
+    // ApplyLayerSettings は true への変更のみ扱うため false はここで戻す
+    if (changes.contains("is_3d") && !GetValue<bool>(changes, "is_3d", false)) {
+        TryApply("is_3d", [&] { layer.Set3DLayer(false); });
+    }
+    if (changes.contains("is_adjustment") && !GetValue<bool>(changes, "is_adjustment", false)) {
+        TryApply("is_adjustment", [&] { layer.SetAdjustmentLayer(false); });
+    }
+    m_importer.ApplyLayerSettings(layer, changes);
+
+    if (changes.contains("locked")) {
+        if (GetValue<bool>(changes, "locked", false)) {
+            state->relock.insert(layerH);
+        } else {
+            state->relock.erase(layerH);
+        }
+    }
+    ++m_stats.layers;
+}
+
+void PatchApplier::AddLayer(const py::dict& op) {
+    CompState* state = GetCompState(GetValue<A_long>(op, "comp", 0));
+    py::dict data = GetDict(op, "data");
+
+    PyComp comp(state->compH);
+    AEGP_LayerH layerH = m_importer.CreateLayer(comp, data);
+    if (!layerH) throw std::runtime_error("Failed to create layer");
+
+    state->addedLayers[GetValue<int>(op, "index", 0)] = layerH;
+    if (GetValue<bool>(data, "locked", false)) {
+        state->relock.insert(layerH);
+    }
+    ++m_stats.layers;
+}
+
+void PatchApplier::OrderLayers(const py::dict& op) {
+    CompState* state = GetCompState(GetValue<A_long>(op, "comp", 0));
+
+    // 上から順に目標位置へ移動する（パッチに含まれない既存レイヤーは下に残る）
+    std::map<int, AEGP_LayerH> order;
+    int position = 0;
+    for (auto handle : GetList(op, "order")) {
+        py::sequence slot = handle.cast<py::sequence>();
+        if (py::len(slot) < 2) continue;
+        int newIndex = slot[0].cast<int>();
+
+        AEGP_LayerH layerH = nullptr;
+        if (slot[1].is_none()) {
+            auto it = state->addedLayers.find(newIndex);
+            if (it != state->addedLayers.end()) layerH = it->second;
+        } else {
+            auto it = state->baseLayers.find(slot[1].cast<int>());
+            if (it != state->baseLayers.end()) layerH = it->second;
+        }
+        if (!layerH) continue;
+
+        PyLayer layer(layerH);
+        if (layer.GetIndex() != position) {
+            Unlock(*state, layerH);
+            layer.SetIndex(position);
+        }
+        order[newIndex] = layerH;
+        ++position;
+    }
+
+    state->order = std::move(order);
+    state->ordered = true;
+}
+
+void PatchApplier::SetParent(const py::dict& op) {
+    const auto& suites = PluginState::Instance().GetSuites();
+    CompState* state = GetCompState(GetValue<A_long>(op, "comp", 0));
+
+    AEGP_LayerH layerH = GetNewLayer(*state, GetValue<int>(op, "layer", -1));
+    if (!layerH) throw std::runtime_error("Layer not found");
+
+    AEGP_LayerH parentH = nullptr;
+    if (op.contains("parent") && !op["parent"].is_none()) {
+        parentH = GetNewLayer(*state, GetValue<int>(op, "parent", -1));
+        if (!parentH) throw std::runtime_error("Parent layer not found");
+    }
+
+    Unlock(*state, layerH);
+    A_Err err = suites.layerSuite->AEGP_SetLayerParent(layerH, parentH);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("Failed to set parent (error code: " + std::to_string(err) + ")");
+    }
+}
+
+void PatchApplier::FinishComps() {
+    // ロックはすべての編集の後
+    for (auto& [id, state] : m_comps) {
+        for (AEGP_LayerH layerH : state.relock) {
+            TryApply("relock", [&] { PyLayer(layerH).SetLocked(true); });
+        }
+    }
+    m_comps.clear();
+}
+
+// ---------------------------------------------------------
+// Properties / Effects
+// ---------------------------------------------------------
+
+void PatchApplier::SetProperty(const py::dict& op) {
+    AEGP_LayerH layerH = GetBaseLayer(op);
+    py::dict data = GetDict(op, "data");
+
+    ScopedStreamRef stream = ResolvePath(layerH, GetList(op, "path"), true);
+    if (!stream) throw std::runtime_error("Property not found");
+
+    if (GetValue<std::string>(data, "type", "property") != "group") {
+        ClearStream(stream.Get(), data);
+    }
+    m_importer.RestoreProperty(stream.Get(), data);
+    ++m_stats.properties;
+}
+
+void PatchApplier::ApplyKeyframes(const py::dict& op) {
+    AEGP_LayerH layerH = GetBaseLayer(op);
+
+    ScopedStreamRef stream = ResolvePath(layerH, GetList(op, "path"), false);
+    if (!stream) throw std::runtime_error("Property not found");
+
+    std::vector<double> remove;
+    for (auto handle : GetList(op, "remove")) {
+        remove.push_back(handle.cast<double>());
+    }
+
+    // 後ろから削除（インデックスがずれないように）
+    PyProperty prop(stream.Get(), false);
+    if (!remove.empty()) {
+        for (int i = prop.GetNumKeyframes() - 1; i >= 0; --i) {
+            double time = prop.GetKeyframeTime(i);
+            if (std::any_of(remove.begin(), remove.end(),
+                            [&](double t) { return std::abs(t - time) <= 1e-4; })) {
+                prop.RemoveKeyframe(i);
+                ++m_stats.keyframes;
+            }
+        }
+    }
+
+    m_importer.AddKeyframes(stream.Get(), GetStreamType(stream.Get()), GetList(op, "add"));
+    ++m_stats.properties;
+}
+
+void PatchApplier::SetEffect(const py::dict& op) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    AEGP_LayerH layerH = GetBaseLayer(op);
+
+    AEGP_EffectRefH effectH = nullptr;
+    if (suites.effectSuite->AEGP_GetLayerEffectByIndex(
+            state.GetPluginID(), layerH, GetValue<A_long>(op, "effect", -1), &effectH) != A_Err_NONE ||
+        !effectH) {
+        throw std::runtime_error("Effect not found");
+    }
+
+    py::dict changes = GetDict(op, "changes");
+    try {
+        if (changes.contains("enabled")) {
+            bool enabled = GetValue<bool>(changes, "enabled", true);
+            suites.effectSuite->AEGP_SetEffectFlags(
+                effectH, AEGP_EffectFlags_ACTIVE, enabled ? AEGP_EffectFlags_ACTIVE : AEGP_EffectFlags_NONE);
+        }
+        if (changes.contains("stream_name")) {
+            // エフェクト名はパラメータ1の親ストリームの名前
+            AEGP_StreamRefH paramH = nullptr;
+            if (suites.streamSuite->AEGP_GetNewEffectStreamByIndex(
+                    state.GetPluginID(), effectH, 1, &paramH) == A_Err_NONE && paramH) {
+                ScopedStreamRef param(suites.streamSuite, paramH);
+                AEGP_StreamRefH effectStreamH = nullptr;
+                if (suites.dynamicStreamSuite->AEGP_GetNewParentStreamRef(
+                        state.GetPluginID(), paramH, &effectStreamH) == A_Err_NONE && effectStreamH) {
+                    ScopedStreamRef effectStream(suites.streamSuite, effectStreamH);
+                    PyProperty(effectStreamH, false).SetName(GetValue<std::string>(changes, "stream_name", ""));
+                }
+            }
+        }
+    } catch (...) {
+        suites.effectSuite->AEGP_DisposeEffect(effectH);
+        throw;
+    }
+    suites.effectSuite->AEGP_DisposeEffect(effectH);
+    ++m_stats.effects;
+}
+
+void PatchApplier::SetEffectParam(const py::dict& op) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    AEGP_LayerH layerH = GetBaseLayer(op);
+
+    AEGP_EffectRefH effectH = nullptr;
+    if (suites.effectSuite->AEGP_GetLayerEffectByIndex(
+            state.GetPluginID(), layerH, GetValue<A_long>(op, "effect", -1), &effectH) != A_Err_NONE ||
+        !effectH) {
+        throw std::runtime_error("Effect not found");
+    }
+
+    py::dict data = GetDict(op, "data");
+    AEGP_StreamRefH paramH = nullptr;
+    A_Err err = suites.streamSuite->AEGP_GetNewEffectStreamByIndex(
+        state.GetPluginID(), effectH, GetValue<A_long>(data, "index", -1) + 1, &paramH);
+    suites.effectSuite->AEGP_DisposeEffect(effectH);
+    if (err != A_Err_NONE || !paramH) throw std::runtime_error("Effect parameter not found");
+
+    ScopedStreamRef param(suites.streamSuite, paramH);
+    ClearStream(paramH, data);
+    m_importer.RestorePropertyValue(paramH, data, true);
+    ++m_stats.properties;
+}
+
+void PatchApplier::ReplaceEffects(const py::dict& op) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    AEGP_LayerH layerH = GetBaseLayer(op);
+
+    A_long numEffects = 0;
+    suites.effectSuite->AEGP_GetLayerNumEffects(layerH, &numEffects);
+    for (A_long i = numEffects - 1; i >= 0; --i) {
+        AEGP_EffectRefH effectH = nullptr;
+        if (suites.effectSuite->AEGP_GetLayerEffectByIndex(
+                state.GetPluginID(), layerH, i, &effectH) != A_Err_NONE || !effectH) {
+            continue;
+        }
+        // 削除に成功したハンドルは無効になる（PyEffect::Delete と同じ扱い）
+        if (suites.effectSuite->AEGP_DeleteLayerEffect(effectH) != A_Err_NONE) {
+            suites.effectSuite->AEGP_DisposeEffect(effectH);
+            throw std::runtime_error("Failed to delete effect");
+        }
+    }
+
+    for (const auto& effect : Dicts(GetList(op, "effects"))) {
+        m_importer.RestoreEffect(layerH, effect);
+    }
+}
+
+} // namespace PyAE
@@ -0,0 +1,1045 @@
+// ProjectImporter.cpp
+// PyAE - Python for After Effects
+// ネイティブ プロジェクトインポーター
+//
+// 復元ルールは scripts/ae_serialize.py の project_from_dict / layer_from_dict と同じ。
+// レイヤー作成・属性設定は既存の PyComp / PyLayer / PyProperty を再利用し、
+// ストリーム値とキーフレームは bdata からSDKへ直接書き込む。
+
+#include "ProjectImporter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+#include <optional>
+
+#include "ScopedHandles.h"
+#include "StringUtils.h"
+#include "AETypeUtils.h"
+#include "Logger.h"
+#include "PyCompClasses.h"
+#include "PyLayerClasses.h"
+#include "PyPropertyCore.h"
+
+namespace PyAE {
+
+namespace {
+
+// =============================================================
+// Helpers
+// =============================================================
+
+// dict[key] を T として取得（無い・None・型違いは fallback）
+template <typename T>
+T GetValue(const py::dict& d, const char* key, T fallback) {
+    if (!d.contains(key)) return fallback;
+    py::object value = d[key];
+    if (value.is_none()) return fallback;
+    try {
+        return value.cast<T>();
+    } catch (const py::cast_error&) {
+        return fallback;
+    }
+}
+
+py::dict GetDict(const py::dict& d, const char* key) {
+    if (d.contains(key)) {
+        py::object value = d[key];
+        if (py::isinstance<py::dict>(value)) return value.cast<py::dict>();
+    }
+    return py::dict();
+}
+
+py::list GetList(const py::dict& d, const char* key) {
+    if (d.contains(key)) {
+        py::object value = d[key];
+        if (py::isinstance<py::list>(value)) return value.cast<py::list>();
+    }
+    return py::list();
+}
+
+// 例外をログに残して続行する（Python側の try/except: pass 相当）
+template <typename F>
+void TryApply(const char* what, F&& f) {
+    try {
+        f();
+    } catch (const std::exception& e) {
+        PYAE_LOG_DEBUG("Importer", std::string(what) + ": " + e.what());
+    }
+}
+
+int HexNibble(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// bdata（hex文字列、ae.snapshot 経由なら bytes）をバイト列に戻す
+std::string DecodeBdata(const py::handle& obj) {
+    if (py::isinstance<py::bytes>(obj)) {
+        return obj.cast<std::string>();
+    }
+    if (!py::isinstance<py::str>(obj)) return {};
+
+    std::string hex = obj.cast<std::string>();
+    if (hex.size() % 2 != 0) return {};
+
+    std::string out(hex.size() / 2, '\0');
+    for (size_t i = 0; i < out.size(); ++i) {
+        int hi = HexNibble(hex[i * 2]);
+        int lo = HexNibble(hex[i * 2 + 1]);
+        if (hi < 0 || lo < 0) return {};
+        out[i] = static_cast<char>((hi << 4) | lo);
+    }
+    return out;
+}
+
+double ReadDoubleBE(const unsigned char* p) {
+    union { double d; uint64_t u; } conv;
+    conv.u = 0;
+    for (int i = 0; i < 8; ++i) {
+        conv.u = (conv.u << 8) | p[i];
+    }
+    return conv.d;
+}
+
+// import_scene.bdata_to_value 相当（8バイトごとのビッグエンディアン double）
+std::vector<double> BdataToDoubles(const std::string& bytes) {
+    std::vector<double> values(bytes.size() / 8);
+    const auto* p = reinterpret_cast<const unsigned char*>(bytes.data());
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = ReadDoubleBE(p + i * 8);
+    }
+    return values;
+}
+
+// 可読値（数値 / 数値の配列）を double 列に変換
+std::vector<double> ReadableToDoubles(const py::handle& obj) {
+    std::vector<double> values;
+    if (py::isinstance<py::bool_>(obj)) return values;
+    if (py::isinstance<py::float_>(obj) || py::isinstance<py::int_>(obj)) {
+        values.push_back(obj.cast<double>());
+    } else if (py::isinstance<py::list>(obj) || py::isinstance<py::tuple>(obj)) {
+        for (auto v : obj.cast<py::sequence>()) {
+            if (!(py::isinstance<py::float_>(v) || py::isinstance<py::int_>(v))) return {};
+            values.push_back(v.cast<double>());
+        }
+    }
+    return values;
+}
+
+// 値の優先順位は _restore_property_value と同じ（_value → bdata）。
+// テキストアニメーターは可読形式の "value" のみを持つ
+std::vector<double> GetNumericValue(const py::dict& data, const char* readableKey) {
+    if (data.contains(readableKey)) {
+        auto values = ReadableToDoubles(data[readableKey]);
+        if (!values.empty()) return values;
+    }
+    if (data.contains("bdata")) {
+        return BdataToDoubles(DecodeBdata(data["bdata"]));
+    }
+    return {};
+}
+
+// 数値ストリームの値を組み立てる（非対応タイプ・要素不足は false）
+bool FillStreamValue(AEGP_StreamRefH streamH, AEGP_StreamType type,
+                     const std::vector<double>& v, AEGP_StreamValue2& out) {
+    out = {};
+    out.streamH = streamH;
+    switch (type) {
+        case AEGP_StreamType_OneD:
+            if (v.empty()) return false;
+            out.val.one_d = v[0];
+            return true;
+        case AEGP_StreamType_TwoD:
+        case AEGP_StreamType_TwoD_SPATIAL:
+            if (v.size() < 2) return false;
+            out.val.two_d.x = v[0];
+            out.val.two_d.y = v[1];
+            return true;
+        case AEGP_StreamType_ThreeD:
+        case AEGP_StreamType_ThreeD_SPATIAL:
+            // 2要素なら Z=0 で補完（PythonToStreamValue と同じ）
+            if (v.size() < 2) return false;
+            out.val.three_d.x = v[0];
+            out.val.three_d.y = v[1];
+            out.val.three_d.z = v.size() > 2 ? v[2] : 0.0;
+            return true;
+        case AEGP_StreamType_COLOR:
+            if (v.size() < 3) return false;
+            out.val.color.redF = v[0];
+            out.val.color.greenF = v[1];
+            out.val.color.blueF = v[2];
+            out.val.color.alphaF = v.size() > 3 ? v[3] : 1.0;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// import_scene.bdata_to_path_vertices 相当
+py::list BdataToPathVertices(const std::string& bytes) {
+    py::list vertices;
+    if (bytes.size() < 4) return vertices;
+
+    const auto* p = reinterpret_cast<const unsigned char*>(bytes.data());
+    uint32_t numSegs = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+                       (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    if (bytes.size() < 4 + size_t(numSegs) * 48) return vertices;
+
+    for (uint32_t i = 0; i < numSegs; ++i) {
+        const unsigned char* v = p + 4 + size_t(i) * 48;
+        py::dict vertex;
+        vertex["x"] = ReadDoubleBE(v);
+        vertex["y"] = ReadDoubleBE(v + 8);
+        vertex["tan_in_x"] = ReadDoubleBE(v + 16);
+        vertex["tan_in_y"] = ReadDoubleBE(v + 24);
+        vertex["tan_out_x"] = ReadDoubleBE(v + 32);
+        vertex["tan_out_y"] = ReadDoubleBE(v + 40);
+        vertices.append(vertex);
+    }
+    return vertices;
+}
+
+AEGP_StreamType GetStreamType(AEGP_StreamRefH streamH) {
+    AEGP_StreamType type = AEGP_StreamType_NO_DATA;
+    if (PluginState::Instance().GetSuites().streamSuite->AEGP_GetStreamType(streamH, &type) != A_Err_NONE) {
+        return AEGP_StreamType_NO_DATA;
+    }
+    return type;
+}
+
+std::string GetStreamMatchName(AEGP_StreamRefH streamH) {
+    char matchName[AEGP_MAX_STREAM_MATCH_NAME_SIZE + 1];
+    matchName[AEGP_MAX_STREAM_MATCH_NAME_SIZE] = '\0';
+    if (PluginState::Instance().GetSuites().dynamicStreamSuite->AEGP_GetMatchName(
+            streamH, matchName) != A_Err_NONE) {
+        return {};
+    }
+    return matchName;
+}
+
+ScopedStreamRef GetChildByMatchName(AEGP_StreamRefH parentH, const char* matchName) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_StreamRefH childH = nullptr;
+    if (parentH && suites.dynamicStreamSuite->AEGP_GetNewStreamRefByMatchname(
+            state.GetPluginID(), parentH, matchName, &childH) != A_Err_NONE) {
+        childH = nullptr;
+    }
+    return ScopedStreamRef(suites.streamSuite, childH);
+}
+
+ScopedStreamRef AddChildStream(AEGP_StreamRefH parentH, const std::string& matchName) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    A_Boolean canAdd = FALSE;
+    AEGP_StreamRefH childH = nullptr;
+    if (suites.dynamicStreamSuite->AEGP_CanAddStream(parentH, matchName.c_str(), &canAdd) == A_Err_NONE &&
+        canAdd &&
+        suites.dynamicStreamSuite->AEGP_AddStream(
+            state.GetPluginID(), parentH, matchName.c_str(), &childH) != A_Err_NONE) {
+        childH = nullptr;
+    }
+    return ScopedStreamRef(suites.streamSuite, childH);
+}
+
+std::string ToLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+// 種類別のアイテム（作成フェーズ順に処理する）
+struct ItemLists {
+    std::vector<py::dict> folders;
+    std::vector<py::dict> comps;
+    std::vector<py::dict> footages;
+};
+
+} // namespace
+
+// =============================================================
+// Project
+// =============================================================
+
+ProjectImporter::ProjectImporter(AEGP_ProjectH projectH)
+    : m_projectH(projectH)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+    if (!m_projectH || !suites.projSuite || !suites.itemSuite || !suites.compSuite ||
+        !suites.streamSuite || !suites.dynamicStreamSuite || !suites.keyframeSuite) {
+        throw std::runtime_error("Required suites not available");
+    }
+    if (suites.projSuite->AEGP_GetProjectRootFolder(m_projectH, &m_rootFolderH) != A_Err_NONE) {
+        throw std::runtime_error("Failed to get root folder");
+    }
+}
+
+void ProjectImporter::ImportProject(const py::dict& data) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    ItemLists lists;
+    size_t numLayers = 0;
+    for (auto handle : GetList(data, "items")) {
+        if (!py::isinstance<py::dict>(handle)) continue;
+        py::dict item = handle.cast<py::dict>();
+        std::string type = GetValue<std::string>(item, "type", "");
+        if (type == "Folder") {
+            lists.folders.push_back(item);
+        } else if (type == "Comp") {
+            lists.comps.push_back(item);
+            numLayers += py::len(GetList(GetDict(item, "comp_data"), "layers"));
+        } else if (type == "Footage") {
+            lists.footages.push_back(item);
+        }
+    }
+
+    m_done = 0;
+    m_total = lists.folders.size() + lists.comps.size() + lists.footages.size() + numLayers;
+
+    // 全工程を1つのアンドゥ操作にまとめる
+    ScopedUndoGroup undo(suites.utilitySuite, state.GetPluginID(), "Import from dictionary");
+
+    // Phase 1: フォルダ
+    CreateFolders(lists.folders);
+
+    // Phase 2: コンポジション（レイヤーはソースが揃ってから）
+    for (const auto& item : lists.comps) {
+        CreateComp(item);
+        Report("comps");
+    }
+
+    // Phase 3: フッテージ
+    for (const auto& item : lists.footages) {
+        CreateFootage(item);
+        Report("footage");
+    }
+
+    // Phase 4: レイヤー（プリコンプも含め全ソースが揃った後）
+    for (const auto& item : lists.comps) {
+        auto it = m_items.find(GetValue<A_long>(item, "id", 0));
+        if (it == m_items.end()) continue;
+
+        AEGP_CompH compH = nullptr;
+        if (suites.compSuite->AEGP_GetCompFromItem(it->second, &compH) != A_Err_NONE || !compH) {
+            continue;
+        }
+        RestoreCompLayers(compH, GetList(GetDict(item, "comp_data"), "layers"));
+    }
+
+    PYAE_LOG_INFO("Importer", "Imported items=" + std::to_string(m_stats.items) +
+                  ", layers=" + std::to_string(m_stats.layers) +
+                  ", properties=" + std::to_string(m_stats.properties) +
+                  ", keyframes=" + std::to_string(m_stats.keyframes) +
+                  ", effects=" + std::to_string(m_stats.effects));
+}
+
+void ProjectImporter::Report(const char* phase) {
+    ++m_done;
+    if (m_progress) {
+        m_progress(phase, m_done, m_total);
+    }
+}
+
+AEGP_ItemH ProjectImporter::ResolveFolder(A_long id) const {
+    auto it = m_items.find(id);
+    return it != m_items.end() ? it->second : m_rootFolderH;
+}
+
+void ProjectImporter::CreateFolders(const std::vector<py::dict>& folders) {
+    const auto& suites = PluginState::Instance().GetSuites();
+
+    std::map<A_long, const py::dict*> pending;
+    for (const auto& folder : folders) {
+        pending[GetValue<A_long>(folder, "id", -1)] = &folder;
+    }
+
+    // 親が作成済み（またはデータ外 = ルート）のものから順に作成する
+    bool progressed = true;
+    while (!pending.empty() && progressed) {
+        progressed = false;
+        for (auto it = pending.begin(); it != pending.end();) {
+            const py::dict& folder = *it->second;
+            A_long parentId = GetValue<A_long>(folder, "parent_folder_id", 0);
+            if (parentId != it->first && pending.count(parentId)) {
+                ++it;
+                continue;
+            }
+
+            std::wstring wname = StringUtils::Utf8ToWide(GetValue<std::string>(folder, "name", "Folder"));
+            AEGP_ItemH folderH = nullptr;
+            A_Err err = suites.itemSuite->AEGP_CreateNewFolder(
+                reinterpret_cast<const A_UTF16Char*>(wname.c_str()), ResolveFolder(parentId), &folderH);
+            if (err == A_Err_NONE && folderH) {
+                m_items[it->first] = folderH;
+                ++m_stats.items;
+            } else {
+                PYAE_LOG_WARNING("Importer", "Failed to create folder (error code: " + std::to_string(err) + ")");
+            }
+
+            it = pending.erase(it);
+            progressed = true;
+            Report("folders");
+        }
+    }
+}
+
+void ProjectImporter::CreateComp(const py::dict& item) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    py::dict compData = GetDict(item, "comp_data");
+    std::string name = GetValue<std::string>(compData, "name", GetValue<std::string>(item, "name", "Comp"));
+    double duration = GetValue<double>(compData, "duration", 10.0);
+    double frameRate = GetValue<double>(compData, "frame_rate", 30.0);
+
+    A_Ratio pixelAspect = AETypeUtils::DoubleToRatio(GetValue<double>(compData, "pixel_aspect", 1.0));
+    A_Time durationTime = AETypeUtils::SecondsToTimeWithFps(duration, frameRate);
+    A_Ratio frameRateRatio = AETypeUtils::DoubleToRatio(frameRate, 1000);
+    std::wstring wname = StringUtils::Utf8ToWide(name);
+
+    // AEGP_CreateComp の親フォルダ指定は機能しないため、ルートに作成してから移動する
+    AEGP_CompH compH = nullptr;
+    A_Err err = suites.compSuite->AEGP_CreateComp(
+        nullptr,
+        reinterpret_cast<const A_UTF16Char*>(wname.c_str()),
+        GetValue<A_long>(compData, "width", 1920),
+        GetValue<A_long>(compData, "height", 1080),
+        &pixelAspect, &durationTime, &frameRateRatio, &compH);
+    if (err != A_Err_NONE || !compH) {
+        PYAE_LOG_WARNING("Importer", "Failed to create comp '" + name + "'");
+        return;
+    }
+
+    AEGP_ItemH itemH = nullptr;
+    suites.compSuite->AEGP_GetItemFromComp(compH, &itemH);
+    if (!itemH) return;
+
+    AEGP_ItemH parentH = ResolveFolder(GetValue<A_long>(item, "parent_folder_id", 0));
+    if (parentH != m_rootFolderH) {
+        suites.itemSuite->AEGP_SetItemParentFolder(itemH, parentH);
+    }
+
+    // _apply_comp_settings 相当
+    PyComp comp(compH);
+    py::list bg = GetList(compData, "background_color");
+    if (py::len(bg) >= 3) {
+        TryApply("bg_color", [&] { comp.SetBgColor(py::make_tuple(bg[0], bg[1], bg[2])); });
+    }
+    if (compData.contains("work_area_start")) {
+        TryApply("work_area_start", [&] {
+            comp.SetWorkAreaStart(GetValue<double>(compData, "work_area_start", 0.0));
+        });
+    }
+    if (compData.contains("work_area_duration")) {
+        TryApply("work_area_duration", [&] {
+            comp.SetWorkAreaDuration(GetValue<double>(compData, "work_area_duration", duration));
+        });
+    }
+
+    m_items[GetValue<A_long>(item, "id", 0)] = itemH;
+    ++m_stats.items;
+}
+
+void ProjectImporter::CreateFootage(const py::dict& item) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    py::dict footageData = GetDict(item, "footage_data");
+    std::string footageType = GetValue<std::string>(footageData, "footage_type", "");
+    A_long id = GetValue<A_long>(item, "id", 0);
+
+    if (footageType == "Solid") {
+        m_solidSizes[id] = {GetValue<A_long>(footageData, "width", 0),
+                            GetValue<A_long>(footageData, "height", 0)};
+        return;
+    }
+
+    // ファイルフッテージのみ再インポートする（Missing / Placeholder は対象外）
+    std::string path = GetValue<std::string>(footageData, "file_path", "");
+    if (footageType != "File" || path.empty() || !suites.footageSuite) return;
+
+    std::wstring wpath = StringUtils::Utf8ToWide(path);
+    std::error_code ec;
+    if (!std::filesystem::exists(std::filesystem::path(wpath), ec)) return;
+
+    AEGP_FootageH footageH = nullptr;
+    A_Err err = suites.footageSuite->AEGP_NewFootage(
+        state.GetPluginID(), reinterpret_cast<const A_UTF16Char*>(wpath.c_str()),
+        nullptr, nullptr, AEGP_InterpretationStyle_NO_DIALOG_GUESS, nullptr, &footageH);
+    if (err != A_Err_NONE || !footageH) {
+        PYAE_LOG_WARNING("Importer", "Failed to import footage: " + path);
+        return;
+    }
+
+    AEGP_ItemH itemH = nullptr;
+    err = suites.footageSuite->AEGP_AddFootageToProject(
+        footageH, ResolveFolder(GetValue<A_long>(item, "parent_folder_id", 0)), &itemH);
+    if (err != A_Err_NONE || !itemH) {
+        suites.footageSuite->AEGP_DisposeFootage(footageH);
+        PYAE_LOG_WARNING("Importer", "Failed to add footage to project: " + path);
+        return;
+    }
+
+    m_items[id] = itemH;
+    ++m_stats.items;
+}
+
+// =============================================================
+// Layers
+// =============================================================
+
+void ProjectImporter::RestoreCompLayers(AEGP_CompH compH, const py::list& layers) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    std::vector<py::dict> sorted;
+    for (auto handle : layers) {
+        if (py::isinstance<py::dict>(handle)) sorted.push_back(handle.cast<py::dict>());
+    }
+    // AEは新規レイヤーを先頭に追加するため、インデックスの降順で作成する
+    std::stable_sort(sorted.begin(), sorted.end(), [](const py::dict& a, const py::dict& b) {
+        return GetValue<int>(a, "index", 0) > GetValue<int>(b, "index", 0);
+    });
+
+    PyComp comp(compH);
+    std::map<int, AEGP_LayerH> created;  // 書き出し時のインデックス → レイヤー
+    std::vector<std::pair<AEGP_LayerH, py::dict>> lockLater;
+
+    for (const auto& data : sorted) {
+        AEGP_LayerH layerH = nullptr;
+        try {
+            layerH = CreateLayer(comp, data);
+        } catch (const std::exception& e) {
+            PYAE_LOG_WARNING("Importer", "Failed to create layer '" +
+                             GetValue<std::string>(data, "name", "") + "': " + e.what());
+        }
+        Report("layers");
+        if (!layerH) continue;
+
+        created[GetValue<int>(data, "index", 0)] = layerH;
+        ++m_stats.layers;
+        if (GetValue<bool>(data, "locked", false)) {
+            lockLater.emplace_back(layerH, data);
+        }
+    }
+
+    // _restore_layer_hierarchy 相当（全レイヤー作成後）
+    for (const auto& data : sorted) {
+        if (!data.contains("parent_index") || data["parent_index"].is_none()) continue;
+        auto child = created.find(GetValue<int>(data, "index", 0));
+        auto parent = created.find(GetValue<int>(data, "parent_index", -1));
+        if (child == created.end() || parent == created.end()) continue;
+        A_Err err = suites.layerSuite->AEGP_SetLayerParent(child->second, parent->second);
+        if (err != A_Err_NONE) {
+            PYAE_LOG_DEBUG("Importer", "Failed to set parent (error code: " + std::to_string(err) + ")");
+        }
+    }
+
+    // ロックはプロパティ・ペアレント復元の後（ロック中は編集できないため）
+    for (const auto& [layerH, data] : lockLater) {
+        PyLayer layer(layerH);
+        TryApply("locked", [&] { layer.SetLocked(true); });
+    }
+}
+
+AEGP_LayerH ProjectImporter::CreateLayer(PyComp& comp, const py::dict& data) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    std::string type = ToLower(GetValue<std::string>(data, "type", ""));
+    std::string name = GetValue<std::string>(data, "name", "Layer");
+    double duration = GetValue<double>(data, "out_point", comp.GetDuration()) -
+                      GetValue<double>(data, "in_point", 0.0);
+    if (duration <= 0.0) duration = -1.0;  // コンポの長さ
+
+    int compWidth = comp.GetWidth();
+    int compHeight = comp.GetHeight();
+    A_long sourceId = GetValue<A_long>(data, "source_item_id", 0);
+
+    auto layer = [&]() -> std::optional<PyLayer> {
+        if (GetValue<bool>(data, "is_null", false) || type == "null") {
+            return comp.AddNull(name, duration);
+        }
+        if (type == "solid") {
+            // 元のソリッドのサイズ（無ければコンポサイズ）
+            auto size = m_solidSizes.find(sourceId);
+            int width = GetValue<int>(data, "width",
+                size != m_solidSizes.end() && size->second.first > 0 ? size->second.first : compWidth);
+            int height = GetValue<int>(data, "height",
+                size != m_solidSizes.end() && size->second.second > 0 ? size->second.second : compHeight);
+            py::list color = GetList(data, "solid_color");
+            double r = py::len(color) >= 3 ? color[0].cast<double>() : 0.0;
+            double g = py::len(color) >= 3 ? color[1].cast<double>() : 0.0;
+            double b = py::len(color) >= 3 ? color[2].cast<double>() : 0.0;
+            return comp.AddSolid(name, width, height, r, g, b, duration);
+        }
+        if (type == "text") {
+            PyLayer text = comp.AddText(GetValue<std::string>(data, "source_text", ""));
+            text.SetName(name);
+            return text;
+        }
+        if (type == "shape") {
+            PyLayer shape = comp.AddShape();
+            shape.SetName(name);
+            return shape;
+        }
+        if (type == "camera") {
+            return comp.AddCamera(name, compWidth / 2.0, compHeight / 2.0);
+        }
+        if (type == "light") {
+            return comp.AddLight(name, compWidth / 2.0, compHeight / 2.0);
+        }
+        if (type == "adjustment") {
+            PyLayer adjustment = comp.AddSolid(name, compWidth, compHeight, 1.0, 1.0, 1.0, duration);
+            adjustment.SetAdjustmentLayer(true);
+            return adjustment;
+        }
+        if (type == "av") {
+            auto source = m_items.find(sourceId);
+            if (sourceId != 0 && source != m_items.end()) {
+                return comp.AddLayer(source->second, duration);
+            }
+            return comp.AddNull(name, duration);
+        }
+        return std::nullopt;
+    }();
+
+    if (!layer) return nullptr;
+
+    ApplyLayerSettings(*layer, data);
+
+    AEGP_LayerH layerH = layer->GetHandle();
+    AEGP_StreamRefH rootStreamH = nullptr;
+    if (suites.dynamicStreamSuite->AEGP_GetNewStreamRefForLayer(
+            state.GetPluginID(), layerH, &rootStreamH) != A_Err_NONE) {
+        rootStreamH = nullptr;
+    }
+    ScopedStreamRef root(suites.streamSuite, rootStreamH);
+
+    if (root) {
+        RestoreChildren(root.Get(), GetDict(data, "properties"));
+    }
+
+    for (auto handle : GetList(data, "effects")) {
+        if (py::isinstance<py::dict>(handle)) {
+            RestoreEffect(layerH, handle.cast<py::dict>());
+        }
+    }
+
+    // マスクは既存マスクへの上書きのみ（新規レイヤーには無いため復元対象外）
+    if (root && type == "text") {
+        RestoreTextAnimators(root.Get(), GetList(data, "text_animators"));
+    }
+
+    return layerH;
+}
+
+void ProjectImporter::ApplyLayerSettings(PyLayer& layer, const py::dict& data) {
+    if (data.contains("name")) {
+        TryApply("name", [&] { layer.SetName(GetValue<std::string>(data, "name", "")); });
+    }
+    if (data.contains("active")) {
+        TryApply("active", [&] { layer.SetEnabled(GetValue<bool>(data, "active", true)); });
+    }
+    if (data.contains("in_point")) {
+        TryApply("in_point", [&] { layer.SetInPoint(GetValue<double>(data, "in_point", 0.0)); });
+    }
+    if (data.contains("out_point")) {
+        TryApply("out_point", [&] { layer.SetOutPoint(GetValue<double>(data, "out_point", 0.0)); });
+    }
+    if (data.contains("start_time")) {
+        TryApply("start_time", [&] { layer.SetStartTime(GetValue<double>(data, "start_time", 0.0)); });
+    }
+
+    if (GetValue<bool>(data, "is_3d", false)) {
+        TryApply("is_3d", [&] { layer.Set3DLayer(true); });
+    }
+    if (GetValue<bool>(data, "is_adjustment", false)) {
+        TryApply("is_adjustment", [&] { layer.SetAdjustmentLayer(true); });
+    }
+
+    if (data.contains("solo")) {
+        TryApply("solo", [&] { layer.SetSolo(GetValue<bool>(data, "solo", false)); });
+    }
+    if (data.contains("shy")) {
+        TryApply("shy", [&] { layer.SetShy(GetValue<bool>(data, "shy", false)); });
+    }
+    if (data.contains("collapse_transformation")) {
+        TryApply("collapse_transformation", [&] {
+            layer.SetCollapseTransformation(GetValue<bool>(data, "collapse_transformation", false));
+        });
+    }
+    if (data.contains("label")) {
+        TryApply("label", [&] { layer.SetLabel(GetValue<int>(data, "label", 0)); });
+    }
+    if (data.contains("comment")) {
+        TryApply("comment", [&] { layer.SetComment(GetValue<std::string>(data, "comment", "")); });
+    }
+}
+
+void ProjectImporter::RestoreTextAnimators(AEGP_StreamRefH rootH, const py::list& animators) {
+    if (py::len(animators) == 0) return;
+
+    ScopedStreamRef textProps = GetChildByMatchName(rootH, "ADBE Text Properties");
+    ScopedStreamRef group = textProps ? GetChildByMatchName(textProps.Get(), "ADBE Text Animators")
+                                      : ScopedStreamRef();
+    if (!group) return;
+
+    for (auto handle : animators) {
+        if (!py::isinstance<py::dict>(handle)) continue;
+        py::dict data = handle.cast<py::dict>();
+
+        ScopedStreamRef animator = AddChildStream(group.Get(), "ADBE Text Animator");
+        if (!animator) continue;
+
+        std::string name = GetValue<std::string>(data, "name", "");
+        if (!name.empty()) {
+            TryApply("animator name", [&] { PyProperty(animator.Get(), false).SetName(name); });
+        }
+
+        ScopedStreamRef selectors = GetChildByMatchName(animator.Get(), "ADBE Text Selectors");
+        for (auto selHandle : GetList(data, "selectors")) {
+            if (!selectors || !py::isinstance<py::dict>(selHandle)) continue;
+            py::dict selData = selHandle.cast<py::dict>();
+            ScopedStreamRef selector = AddChildStream(
+                selectors.Get(), GetValue<std::string>(selData, "match_name", "ADBE Text Selector"));
+            if (selector) {
+                RestoreChildren(selector.Get(), GetDict(selData, "properties"));
+            }
+        }
+
+        ScopedStreamRef props = GetChildByMatchName(animator.Get(), "ADBE Text Animator Properties");
+        if (props) {
+            RestoreChildren(props.Get(), GetDict(data, "properties"));
+        }
+    }
+}
+
+// =============================================================
+// Property tree
+// =============================================================
+
+void ProjectImporter::RestoreChildren(AEGP_StreamRefH parentH, const py::dict& children) {
+    if (py::len(children) == 0) return;
+
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_StreamGroupingType grouping = AEGP_StreamGroupingType_NONE;
+    suites.dynamicStreamSuite->AEGP_GetStreamGroupingType(parentH, &grouping);
+    bool indexed = grouping == AEGP_StreamGroupingType_INDEXED_GROUP;
+
+    // インデックスグループは同じマッチ名の子が複数あり得るため、既存の子の
+    // マッチ名を1回だけ列挙し、データ上の出現順に n 番目の子へ対応付ける
+    std::vector<std::string> existing;
+    if (indexed) {
+        A_long count = 0;
+        suites.dynamicStreamSuite->AEGP_GetNumStreamsInGroup(parentH, &count);
+        for (A_long i = 0; i < count; ++i) {
+            AEGP_StreamRefH childH = nullptr;
+            if (suites.dynamicStreamSuite->AEGP_GetNewStreamRefByIndex(
+                    state.GetPluginID(), parentH, i, &childH) != A_Err_NONE) {
+                childH = nullptr;
+            }
+            ScopedStreamRef child(suites.streamSuite, childH);
+            existing.push_back(child ? GetStreamMatchName(child.Get()) : std::string());
+        }
+    }
+    std::map<std::string, int> seen;
+
+    for (auto entry : children) {
+        if (!py::isinstance<py::dict>(entry.second)) continue;
+        py::dict data = entry.second.cast<py::dict>();
+        std::string matchName = GetValue<std::string>(data, "match_name", "");
+        if (matchName.empty()) continue;
+
+        ScopedStreamRef child;
+        if (indexed) {
+            int occurrence = seen[matchName]++;
+            for (size_t i = 0; i < existing.size(); ++i) {
+                if (existing[i] == matchName && occurrence-- == 0) {
+                    AEGP_StreamRefH childH = nullptr;
+                    if (suites.dynamicStreamSuite->AEGP_GetNewStreamRefByIndex(
+                            state.GetPluginID(), parentH, static_cast<A_long>(i), &childH) != A_Err_NONE) {
+                        childH = nullptr;
+                    }
+                    child = ScopedStreamRef(suites.streamSuite, childH);
+                    break;
+                }
+            }
+            if (!child) {
+                child = AddChildStream(parentH, matchName);
+            }
+        } else if (grouping == AEGP_StreamGroupingType_NAMED_GROUP) {
+            child = GetChildByMatchName(parentH, matchName.c_str());
+        }
+
+        if (child) {
+            RestoreProperty(child.Get(), data);
+        }
+    }
+}
+
+void ProjectImporter::RestoreProperty(AEGP_StreamRefH streamH, const py::dict& data) {
+    ++m_stats.properties;
+
+    if (GetValue<std::string>(data, "type", "property") == "group") {
+        if (data.contains("enabled")) {
+            TryApply("group enabled", [&] {
+                PyProperty(streamH, false).SetDynamicStreamFlag(
+                    AEGP_DynStreamFlag_ACTIVE_EYEBALL, true, GetValue<bool>(data, "enabled", true));
+            });
+        }
+        RestoreChildren(streamH, GetDict(data, "children"));
+    } else {
+        RestorePropertyValue(streamH, data, false);
+    }
+}
+
+void ProjectImporter::RestorePropertyValue(AEGP_StreamRefH streamH, const py::dict& data, bool isEffectParam) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    PyProperty prop(streamH, false);
+
+    std::string expression = GetValue<std::string>(data, "expression", "");
+    if (!expression.empty()) {
+        TryApply("expression", [&] { prop.SetExpression(expression); });
+    }
+
+    if (GetValue<std::string>(data, "match_name", "") == "ADBE Vector Shape - Group") {
+        RestoreShapePath(streamH, data);
+        return;
+    }
+
+    AEGP_StreamType type = GetStreamType(streamH);
+    py::list keyframes = GetList(data, "keyframes");
+    bool canKey = py::len(keyframes) > 0 && prop.CanHaveKeyframes();
+
+    // キーフレームがあれば静的値はキーで上書きされるため省略する
+    if (!canKey && (isEffectParam || prop.CanSetValue())) {
+        AEGP_StreamValue2 value;
+        if (FillStreamValue(streamH, type, GetNumericValue(data, "_value"), value) ||
+            FillStreamValue(streamH, type, GetNumericValue(data, "value"), value)) {
+            A_Err err = suites.streamSuite->AEGP_SetStreamValue(state.GetPluginID(), streamH, &value);
+            if (err != A_Err_NONE) {
+                PYAE_LOG_DEBUG("Importer", "Failed to set value (error code: " + std::to_string(err) + ")");
+            }
+        }
+    }
+
+    if (canKey) {
+        AddKeyframes(streamH, type, keyframes);
+    }
+}
+
+void ProjectImporter::RestoreShapePath(AEGP_StreamRefH streamH, const py::dict& data) {
+    PyProperty prop(streamH, false);
+
+    if (data.contains("bdata")) {
+        py::list vertices = BdataToPathVertices(DecodeBdata(data["bdata"]));
+        if (py::len(vertices) > 0) {
+            TryApply("shape path", [&] { prop.SetShapePathVertices(vertices, 0.0); });
+        }
+    }
+
+    // パスのキーフレームは頂点の設定で作られる（バッチ追加の対象外）
+    for (auto handle : GetList(data, "keyframes")) {
+        if (!py::isinstance<py::dict>(handle)) continue;
+        py::dict kf = handle.cast<py::dict>();
+        if (!kf.contains("bdata")) continue;
+        py::list vertices = BdataToPathVertices(DecodeBdata(kf["bdata"]));
+        if (py::len(vertices) > 0) {
+            TryApply("shape path keyframe", [&] {
+                prop.SetShapePathVertices(vertices, GetValue<double>(kf, "time", 0.0));
+            });
+            ++m_stats.keyframes;
+        }
+    }
+}
+
+void ProjectImporter::AddKeyframes(AEGP_StreamRefH streamH, AEGP_StreamType type,
+                                   const py::list& keyframes) {
+    const auto& suites = PluginState::Instance().GetSuites();
+
+    struct Row {
+        double time;
+        AEGP_StreamValue2 value;
+        std::string inInterp;
+        std::string outInterp;
+    };
+    std::vector<Row> rows;
+    rows.reserve(py::len(keyframes));
+
+    for (auto handle : keyframes) {
+        if (!py::isinstance<py::dict>(handle)) continue;
+        py::dict kf = handle.cast<py::dict>();
+
+        Row row;
+        row.time = GetValue<double>(kf, "time", 0.0);
+        std::vector<double> values = kf.contains("bdata")
+            ? BdataToDoubles(DecodeBdata(kf["bdata"]))
+            : GetNumericValue(kf, "value");
+        if (!FillStreamValue(streamH, type, values, row.value)) continue;
+        row.inInterp = GetValue<std::string>(kf, "in_interpolation", "");
+        row.outInterp = GetValue<std::string>(kf, "out_interpolation", "");
+        rows.push_back(std::move(row));
+    }
+    if (rows.empty()) return;
+
+    // 1ストリーム分のキーを1回のバッチで追加する
+    AEGP_AddKeyframesInfoH akH = nullptr;
+    A_Err err = suites.keyframeSuite->AEGP_StartAddKeyframes(streamH, &akH);
+    if (err != A_Err_NONE || !akH) {
+        PYAE_LOG_DEBUG("Importer", "AEGP_StartAddKeyframes failed (error code: " + std::to_string(err) + ")");
+        return;
+    }
+    for (auto& row : rows) {
+        A_Time time = AETypeUtils::SecondsToTime(row.time);
+        A_long keyIndex = 0;
+        err = suites.keyframeSuite->AEGP_AddKeyframes(akH, AEGP_LTimeMode_CompTime, &time, &keyIndex);
+        if (err == A_Err_NONE) {
+            err = suites.keyframeSuite->AEGP_SetAddKeyframe(akH, keyIndex, &row.value);
+        }
+        if (err != A_Err_NONE) break;
+    }
+    A_Err endErr = suites.keyframeSuite->AEGP_EndAddKeyframes(err == A_Err_NONE ? TRUE : FALSE, akH);
+    if (err != A_Err_NONE || endErr != A_Err_NONE) {
+        PYAE_LOG_DEBUG("Importer", "Keyframe batch failed (error code: " +
+                       std::to_string(err != A_Err_NONE ? err : endErr) + ")");
+        return;
+    }
+    m_stats.keyframes += rows.size();
+
+    // 補間はバッチ確定後、キーの時刻で行に対応付けて設定する
+    std::stable_sort(rows.begin(), rows.end(),
+                     [](const Row& a, const Row& b) { return a.time < b.time; });
+    PyProperty prop(streamH, false);
+    int numKeys = prop.GetNumKeyframes();
+    for (int i = 0; i < numKeys; ++i) {
+        double keyTime = 0.0;
+        try {
+            keyTime = prop.GetKeyframeTime(i);
+        } catch (const std::exception&) {
+            continue;
+        }
+        auto it = std::lower_bound(rows.begin(), rows.end(), keyTime - 1e-4,
+                                   [](const Row& row, double t) { return row.time < t; });
+        if (it == rows.end() || std::abs(it->time - keyTime) > 1e-4) continue;
+        if (it->inInterp.empty() || it->outInterp.empty()) continue;
+        TryApply("interpolation", [&] { prop.SetKeyframeInterpolation(i, it->inInterp, it->outInterp); });
+    }
+}
+
+// =============================================================
+// Effects
+// =============================================================
+
+AEGP_InstalledEffectKey ProjectImporter::FindInstalledEffect(const std::string& matchName) {
+    const auto& suites = PluginState::Instance().GetSuites();
+
+    if (!m_effectKeysLoaded) {
+        m_effectKeysLoaded = true;
+
+        A_long numEffects = 0;
+        if (suites.effectSuite->AEGP_GetNumInstalledEffects(&numEffects) == A_Err_NONE) {
+            AEGP_InstalledEffectKey key = AEGP_InstalledEffectKey_NONE;
+            for (A_long i = 0; i < numEffects; ++i) {
+                if (suites.effectSuite->AEGP_GetNextInstalledEffect(key, &key) != A_Err_NONE) break;
+                A_char name[AEGP_MAX_EFFECT_MATCH_NAME_SIZE] = {0};
+                if (suites.effectSuite->AEGP_GetEffectMatchName(key, name) == A_Err_NONE) {
+                    m_effectKeys.emplace(name, key);
+                }
+            }
+        }
+    }
+
+    auto it = m_effectKeys.find(matchName);
+    return it != m_effectKeys.end() ? it->second : AEGP_InstalledEffectKey_NONE;
+}
+
+void ProjectImporter::RestoreEffect(AEGP_LayerH layerH, const py::dict& data) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    if (!suites.effectSuite) return;
+
+    std::string matchName = GetValue<std::string>(data, "match_name", "");
+    if (matchName.empty()) return;
+
+    AEGP_InstalledEffectKey key = FindInstalledEffect(matchName);
+    if (key == AEGP_InstalledEffectKey_NONE) {
+        PYAE_LOG_WARNING("Importer", "Effect not found: " + matchName);
+        return;
+    }
+
+    // AEGP_ApplyEffect はダイアログ表示時などに非ゼロを返してもハンドルは有効
+    AEGP_EffectRefH effectH = nullptr;
+    A_Err err = suites.effectSuite->AEGP_ApplyEffect(state.GetPluginID(), layerH, key, &effectH);
+    if (!effectH) {
+        PYAE_LOG_WARNING("Importer", "Failed to apply effect '" + matchName +
+                         "' (error code: " + std::to_string(err) + ")");
+        return;
+    }
+    ++m_stats.effects;
+
+    try {
+        if (data.contains("enabled")) {
+            bool enabled = GetValue<bool>(data, "enabled", true);
+            suites.effectSuite->AEGP_SetEffectFlags(
+                effectH, AEGP_EffectFlags_ACTIVE, enabled ? AEGP_EffectFlags_ACTIVE : AEGP_EffectFlags_NONE);
+        }
+
+        A_long numStreams = 0;
+        if (suites.streamSuite->AEGP_GetEffectNumParamStreams(effectH, &numStreams) != A_Err_NONE) {
+            numStreams = 0;
+        }
+
+        // stream_name はパラメータ1の親ストリーム（エフェクト自体）の名前
+        std::string streamName = GetValue<std::string>(data, "stream_name", "");
+        if (!streamName.empty() && numStreams >= 2) {
+            AEGP_StreamRefH paramH = nullptr;
+            if (suites.streamSuite->AEGP_GetNewEffectStreamByIndex(
+                    state.GetPluginID(), effectH, 1, &paramH) == A_Err_NONE && paramH) {
+                ScopedStreamRef param(suites.streamSuite, paramH);
+                AEGP_StreamRefH effectStreamH = nullptr;
+                if (suites.dynamicStreamSuite->AEGP_GetNewParentStreamRef(
+                        state.GetPluginID(), paramH, &effectStreamH) == A_Err_NONE && effectStreamH) {
+                    ScopedStreamRef effectStream(suites.streamSuite, effectStreamH);
+                    TryApply("effect name", [&] { PyProperty(effectStreamH, false).SetName(streamName); });
+                }
+            }
+        }
+
+        // params[].index は 0 ベース（SDKのストリーム 0 は入力レイヤー）
+        for (auto handle : GetList(data, "params")) {
+            if (!py::isinstance<py::dict>(handle)) continue;
+            py::dict param = handle.cast<py::dict>();
+            A_long index = GetValue<A_long>(param, "index", -1);
+            if (index < 0 || index + 1 >= numStreams) continue;
+
+            AEGP_StreamRefH paramH = nullptr;
+            if (suites.streamSuite->AEGP_GetNewEffectStreamByIndex(
+                    state.GetPluginID(), effectH, index + 1, &paramH) != A_Err_NONE || !paramH) {
+                continue;
+            }
+            ScopedStreamRef scopedParam(suites.streamSuite, paramH);
+            if (GetStreamType(paramH) == AEGP_StreamType_NO_DATA) continue;
+
+            RestorePropertyValue(paramH, param, true);
+            ++m_stats.properties;
+        }
+    } catch (...) {
+        suites.effectSuite->AEGP_DisposeEffect(effectH);
+        throw;
+    }
+    suites.effectSuite->AEGP_DisposeEffect(effectH);
+}
+
+} // namespace PyAE
@@ -0,0 +1,1222 @@
+// ProjectSerializer.cpp
+// PyAE - Python for After Effects
+// ネイティブ プロジェクトシリアライザ
+//
+// スキーマは scripts/export_scene.py / ae_serialize.py と互換。
+// スカラー値は既存の PyComp / PyLayer / PyFootage / PyProperty の
+// C++ ゲッターを再利用し、ストリーム値・キーフレームはSDKから直接読む。
+
+#include "ProjectSerializer.h"
+
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <sstream>
+
+#include "ScopedHandles.h"
+#include "StringUtils.h"
+#include "AETypeUtils.h"
+#include "Logger.h"
+#include "PyCompClasses.h"
+#include "PyLayerClasses.h"
+#include "PyFootageClasses.h"
+#include "PyPropertyCore.h"
+
+namespace PyAE {
+
+namespace {
+
+// =============================================================
+// Helpers
+// =============================================================
+
+// ゲッターの例外を「値なし」として扱う（Python側の try/except 相当）
+template <typename F>
+auto TryGet(F&& f) -> std::optional<decltype(f())> {
+    try {
+        return f();
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+// IEEE 754 ビッグエンディアン（XMLのbdataと同形式）
+void AppendDoubleBE(std::string& out, double val) {
+    union { double d; uint64_t u; } conv;
+    conv.d = val;
+    for (int i = 0; i < 8; ++i) {
+        out += static_cast<char>((conv.u >> (56 - i * 8)) & 0xFF);
+    }
+}
+
+void AppendInt32BE(std::string& out, A_long val) {
+    for (int i = 0; i < 4; ++i) {
+        out += static_cast<char>((val >> (24 - i * 8)) & 0xFF);
+    }
+}
+
+// bdata のエンコード方式
+// Raw:   PyProperty::GetRawBytes と同じ（プロパティの bdata）
+// Value: value_to_bdata(StreamValueToPython(value)) と同じ（キーフレーム・エフェクト）
+//        ただしマスクはインポート側の bdata_to_path_vertices が読める Raw 形式で出力する
+enum class BdataMode { Raw, Value };
+
+std::string GetTextDocumentBytes(AEGP_TextDocumentH textDocH) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    if (!suites.textDocSuite || !textDocH) return {};
+
+    AEGP_MemHandle textH = nullptr;
+    A_Err err = suites.textDocSuite->AEGP_GetNewText(state.GetPluginID(), textDocH, &textH);
+    if (err != A_Err_NONE || !textH) return {};
+
+    ScopedMemHandle scopedText(state.GetPluginID(), suites.memorySuite, textH);
+    ScopedMemLock lock(suites.memorySuite, textH);
+    const char* ptr = lock.As<char>();
+    if (!ptr) return {};
+
+    A_u_long size = 0;
+    suites.memorySuite->AEGP_GetMemHandleSize(textH, &size);
+    return std::string(ptr, size);
+}
+
+std::string Utf16BytesToUtf8(const std::string& bytes) {
+    std::u16string text(bytes.size() / 2, u'\0');
+    std::memcpy(text.data(), bytes.data(), text.size() * 2);
+    return StringUtils::Utf16ToUtf8(reinterpret_cast<const A_UTF16Char*>(text.c_str()));
+}
+
+std::string EncodeStreamValue(const AEGP_StreamValue2& value, AEGP_StreamType type, BdataMode mode) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    std::string out;
+    switch (type) {
+        case AEGP_StreamType_OneD:
+            AppendDoubleBE(out, value.val.one_d);
+            break;
+        case AEGP_StreamType_TwoD:
+        case AEGP_StreamType_TwoD_SPATIAL:
+            AppendDoubleBE(out, value.val.two_d.x);
+            AppendDoubleBE(out, value.val.two_d.y);
+            break;
+        case AEGP_StreamType_ThreeD:
+        case AEGP_StreamType_ThreeD_SPATIAL:
+            AppendDoubleBE(out, value.val.three_d.x);
+            AppendDoubleBE(out, value.val.three_d.y);
+            AppendDoubleBE(out, value.val.three_d.z);
+            break;
+        case AEGP_StreamType_COLOR:
+            AppendDoubleBE(out, value.val.color.redF);
+            AppendDoubleBE(out, value.val.color.greenF);
+            AppendDoubleBE(out, value.val.color.blueF);
+            AppendDoubleBE(out, value.val.color.alphaF);
+            break;
+        case AEGP_StreamType_ARB: {
+            // ARB は PF_Handle（AEGP_MemHandle ではない）
+            if (!value.val.arbH) break;
+            PF_HandleSuite1* handleSuite = state.GetSuiteHandler().HandleSuite1();
+            PF_Handle pfH = reinterpret_cast<PF_Handle>(value.val.arbH);
+            void* ptr = handleSuite->host_lock_handle(pfH);
+            if (ptr) {
+                A_HandleSize size = handleSuite->host_get_handle_size(pfH);
+                out.assign(static_cast<const char*>(ptr), static_cast<size_t>(size));
+                handleSuite->host_unlock_handle(pfH);
+            }
+            break;
+        }
+        case AEGP_StreamType_TEXT_DOCUMENT:
+            if (mode == BdataMode::Raw) {
+                out = GetTextDocumentBytes(value.val.text_documentH);
+            }
+            break;
+        case AEGP_StreamType_MASK: {
+            if (!suites.maskOutlineSuite || !value.val.mask) break;
+            A_long numSegs = 0;
+            A_Err err = suites.maskOutlineSuite->AEGP_GetMaskOutlineNumSegments(value.val.mask, &numSegs);
+            if (err != A_Err_NONE || numSegs <= 0) break;
+            AppendInt32BE(out, numSegs);
+            for (A_long i = 0; i < numSegs; ++i) {
+                AEGP_MaskVertex vertex;
+                err = suites.maskOutlineSuite->AEGP_GetMaskOutlineVertexInfo(value.val.mask, i, &vertex);
+                if (err != A_Err_NONE) continue;
+                AppendDoubleBE(out, vertex.x);
+                AppendDoubleBE(out, vertex.y);
+                AppendDoubleBE(out, vertex.tan_in_x);
+                AppendDoubleBE(out, vertex.tan_in_y);
+                AppendDoubleBE(out, vertex.tan_out_x);
+                AppendDoubleBE(out, vertex.tan_out_y);
+            }
+            break;
+        }
+        case AEGP_StreamType_LAYER_ID:
+            if (mode == BdataMode::Raw) AppendInt32BE(out, value.val.layer_id);
+            break;
+        case AEGP_StreamType_MASK_ID:
+            if (mode == BdataMode::Raw) AppendInt32BE(out, value.val.mask_id);
+            break;
+        default:
+            break;
+    }
+    return out;
+}
+
+// prop.value 相当の可読値（数値・数値配列・テキスト、それ以外は null）
+void WriteStreamValueJson(DocumentWriter& w, const AEGP_StreamValue2& value, AEGP_StreamType type) {
+    switch (type) {
+        case AEGP_StreamType_OneD:
+            w.Number(value.val.one_d);
+            break;
+        case AEGP_StreamType_TwoD:
+        case AEGP_StreamType_TwoD_SPATIAL:
+            w.BeginArray();
+            w.Number(value.val.two_d.x);
+            w.Number(value.val.two_d.y);
+            w.EndArray();
+            break;
+        case AEGP_StreamType_ThreeD:
+        case AEGP_StreamType_ThreeD_SPATIAL:
+            w.BeginArray();
+            w.Number(value.val.three_d.x);
+            w.Number(value.val.three_d.y);
+            w.Number(value.val.three_d.z);
+            w.EndArray();
+            break;
+        case AEGP_StreamType_COLOR:
+            w.BeginArray();
+            w.Number(value.val.color.redF);
+            w.Number(value.val.color.greenF);
+            w.Number(value.val.color.blueF);
+            w.Number(value.val.color.alphaF);
+            w.EndArray();
+            break;
+        case AEGP_StreamType_TEXT_DOCUMENT:
+            w.String(Utf16BytesToUtf8(GetTextDocumentBytes(value.val.text_documentH)));
+            break;
+        default:
+            w.Null();
+            break;
+    }
+}
+
+AEGP_StreamType GetStreamType(AEGP_StreamRefH streamH) {
+    AEGP_StreamType type = AEGP_StreamType_NO_DATA;
+    if (PluginState::Instance().GetSuites().streamSuite->AEGP_GetStreamType(streamH, &type) != A_Err_NONE) {
+        return AEGP_StreamType_NO_DATA;
+    }
+    return type;
+}
+
+// 時刻0の値を取得（失敗時は nullopt）
+std::optional<ScopedStreamValue> GetValueAtZero(AEGP_StreamRefH streamH) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    A_Time zero = AETypeUtils::SecondsToTime(0.0);
+    AEGP_StreamValue2 value;
+    A_Err err = suites.streamSuite->AEGP_GetNewStreamValue(
+        state.GetPluginID(), streamH, AEGP_LTimeMode_CompTime, &zero, FALSE, &value);
+    if (err != A_Err_NONE) return std::nullopt;
+    return ScopedStreamValue(suites.streamSuite, value);
+}
+
+ScopedStreamRef GetChildStream(AEGP_StreamRefH parentH, A_long index) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_StreamRefH childH = nullptr;
+    A_Err err = suites.dynamicStreamSuite->AEGP_GetNewStreamRefByIndex(
+        state.GetPluginID(), parentH, index, &childH);
+    if (err != A_Err_NONE) childH = nullptr;
+    return ScopedStreamRef(suites.streamSuite, childH);
+}
+
+ScopedStreamRef GetChildStream(AEGP_StreamRefH parentH, const char* matchName) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_StreamGroupingType grouping;
+    AEGP_StreamRefH childH = nullptr;
+    if (parentH &&
+        suites.dynamicStreamSuite->AEGP_GetStreamGroupingType(parentH, &grouping) == A_Err_NONE &&
+        grouping == AEGP_StreamGroupingType_NAMED_GROUP) {
+        A_Err err = suites.dynamicStreamSuite->AEGP_GetNewStreamRefByMatchname(
+            state.GetPluginID(), parentH, matchName, &childH);
+        if (err != A_Err_NONE) childH = nullptr;
+    }
+    return ScopedStreamRef(suites.streamSuite, childH);
+}
+
+A_long GetNumChildren(AEGP_StreamRefH streamH) {
+    A_long count = 0;
+    if (PluginState::Instance().GetSuites().dynamicStreamSuite->AEGP_GetNumStreamsInGroup(
+            streamH, &count) != A_Err_NONE) {
+        return 0;
+    }
+    return count;
+}
+
+// 子プロパティのキー（名前が空ならマッチ名）
+std::string PropertyKey(const PyProperty& prop) {
+    std::string name = prop.GetName();
+    return name.empty() ? prop.GetMatchName() : name;
+}
+
+std::string GetItemName(AEGP_ItemH itemH) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_MemHandle nameH = nullptr;
+    if (suites.itemSuite->AEGP_GetItemName(state.GetPluginID(), itemH, &nameH) != A_Err_NONE || !nameH) {
+        return {};
+    }
+    ScopedMemHandle scopedName(state.GetPluginID(), suites.memorySuite, nameH);
+    ScopedMemLock lock(suites.memorySuite, nameH);
+    A_UTF16Char* namePtr = lock.As<A_UTF16Char>();
+    return namePtr ? StringUtils::Utf16ToUtf8(namePtr) : std::string();
+}
+
+const char* ItemTypeToString(AEGP_ItemType type) {
+    switch (type) {
+        case AEGP_ItemType_COMP:    return "Comp";
+        case AEGP_ItemType_FOLDER:  return "Folder";
+        case AEGP_ItemType_FOOTAGE: return "Footage";
+        default:                    return "None";
+    }
+}
+
+const char* LayerTypeToString(LayerType type) {
+    switch (type) {
+        case LayerType::AV:         return "AV";
+        case LayerType::Camera:     return "Camera";
+        case LayerType::Light:      return "Light";
+        case LayerType::Text:       return "Text";
+        case LayerType::Shape:      return "Shape";
+        case LayerType::Adjustment: return "Adjustment";
+        case LayerType::Null:       return "Null";
+        case LayerType::Solid:      return "Solid";
+        default:                    return "None";
+    }
+}
+
+// export_scene._is_default_animator_value 相当
+bool IsDefaultAnimatorValue(const std::string& matchName, const AEGP_StreamValue2& value,
+                            AEGP_StreamType type) {
+    struct Default { const char* matchName; int dims; double v[3]; };
+    static const Default kDefaults[] = {
+        {"ADBE Text Position 3D",     3, {0.0, 0.0, 0.0}},
+        {"ADBE Text Anchor Point 3D", 3, {0.0, 0.0, 0.0}},
+        {"ADBE Text Scale 3D",        3, {100.0, 100.0, 100.0}},
+        {"ADBE Text Rotation",        1, {0.0}},
+        {"ADBE Text Rotation X",      1, {0.0}},
+        {"ADBE Text Rotation Y",      1, {0.0}},
+        {"ADBE Text Opacity",         1, {100.0}},
+        {"ADBE Text Skew",            1, {0.0}},
+        {"ADBE Text Skew Axis",       1, {0.0}},
+        {"ADBE Text Fill Opacity",    1, {100.0}},
+        {"ADBE Text Stroke Opacity",  1, {100.0}},
+        {"ADBE Text Tracking Amount", 1, {0.0}},
+        {"ADBE Text Line Spacing",    2, {0.0, 0.0}},
+        {"ADBE Text Blur",            2, {0.0, 0.0}},
+    };
+
+    double v[3] = {0.0, 0.0, 0.0};
+    int dims = 0;
+    switch (type) {
+        case AEGP_StreamType_OneD:
+            v[0] = value.val.one_d; dims = 1; break;
+        case AEGP_StreamType_TwoD:
+        case AEGP_StreamType_TwoD_SPATIAL:
+            v[0] = value.val.two_d.x; v[1] = value.val.two_d.y; dims = 2; break;
+        case AEGP_StreamType_ThreeD:
+        case AEGP_StreamType_ThreeD_SPATIAL:
+            v[0] = value.val.three_d.x; v[1] = value.val.three_d.y; v[2] = value.val.three_d.z; dims = 3; break;
+        default:
+            return false;
+    }
+
+    for (const auto& def : kDefaults) {
+        if (matchName != def.matchName) continue;
+        if (def.dims != dims) return false;
+        for (int i = 0; i < dims; ++i) {
+            if (std::abs(v[i] - def.v[i]) >= 0.001) return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+std::string ExecuteExtendScript(const std::string& script) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    if (!suites.utilitySuite || !suites.memorySuite) {
+        throw std::runtime_error("Utility Suite not available");
+    }
+
+    AEGP_MemHandle resultH = nullptr;
+    AEGP_MemHandle errorH = nullptr;
+    A_Err err = suites.utilitySuite->AEGP_ExecuteScript(
+        state.GetPluginID(), script.c_str(), TRUE, &resultH, &errorH);
+
+    ScopedMemHandle scopedResult(state.GetPluginID(), suites.memorySuite, resultH);
+    ScopedMemHandle scopedError(state.GetPluginID(), suites.memorySuite, errorH);
+
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("AEGP_ExecuteScript failed");
+    }
+    if (!resultH) return {};
+
+    ScopedMemLock lock(suites.memorySuite, resultH);
+    const char* ptr = lock.As<char>();
+    return ptr ? std::string(ptr) : std::string();
+}
+
+} // namespace
+
+// =============================================================
+// Project / Item
+// =============================================================
+
+void ProjectSerializer::WriteProject(AEGP_ProjectH projectH) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    if (!suites.itemSuite || !projectH) {
+        throw std::runtime_error("No project open");
+    }
+
+    DocumentWriter& w = m_writer;
+    w.BeginObject();
+    w.Key("version");
+    w.Int(1);
+    w.Key("items");
+    w.BeginArray();
+
+    AEGP_ItemH itemH = nullptr;
+    A_Err err = suites.itemSuite->AEGP_GetFirstProjItem(projectH, &itemH);
+    while (err == A_Err_NONE && itemH) {
+        WriteItem(itemH);
+
+        AEGP_ItemH nextH = nullptr;
+        err = suites.itemSuite->AEGP_GetNextProjItem(projectH, itemH, &nextH);
+        itemH = nextH;
+    }
+
+    w.EndArray();
+    w.EndObject();
+}
+
+void ProjectSerializer::WriteItem(AEGP_ItemH itemH, bool includeData) {
+    const auto& suites = PluginState::Instance().GetSuites();
+    DocumentWriter& w = m_writer;
+
+    AEGP_ItemType type = AEGP_ItemType_NONE;
+    suites.itemSuite->AEGP_GetItemType(itemH, &type);
+    A_long id = 0;
+    suites.itemSuite->AEGP_GetItemID(itemH, &id);
+
+    w.BeginObject();
+    w.Key("name");
+    w.String(GetItemName(itemH));
+    w.Key("type");
+    w.String(ItemTypeToString(type));
+    w.Key("id");
+    w.Int(id);
+
+    // 親フォルダ（フッテージも含め全アイテムで出力）
+    AEGP_ItemH parentH = nullptr;
+    if (suites.itemSuite->AEGP_GetItemParentFolder(itemH, &parentH) == A_Err_NONE && parentH) {
+        A_long parentId = 0;
+        if (suites.itemSuite->AEGP_GetItemID(parentH, &parentId) == A_Err_NONE) {
+            w.Key("parent_folder_id");
+            w.Int(parentId);
+        }
+    }
+
+    if (includeData && type == AEGP_ItemType_COMP) {
+        AEGP_CompH compH = nullptr;
+        if (suites.compSuite->AEGP_GetCompFromItem(itemH, &compH) == A_Err_NONE && compH) {
+            w.Key("comp_data");
+            WriteComp(compH);
+        }
+    } else if (includeData && type == AEGP_ItemType_FOOTAGE) {
+        w.Key("footage_data");
+        WriteFootage(itemH);
+    }
+
+    w.EndObject();
+    ++m_stats.items;
+}
+
+void ProjectSerializer::WriteFootage(AEGP_ItemH itemH) {
+    PyFootage footage(itemH);
+    DocumentWriter& w = m_writer;
+
+    w.BeginObject();
+    w.Key("width");
+    w.Int(TryGet([&] { return footage.GetWidth(); }).value_or(0));
+    w.Key("height");
+    w.Int(TryGet([&] { return footage.GetHeight(); }).value_or(0));
+    w.Key("duration");
+    w.Number(TryGet([&] { return footage.GetDuration(); }).value_or(0.0));
+
+    if (auto type = TryGet([&] { return footage.GetFootageType(); })) {
+        w.Key("footage_type");
+        switch (*type) {
+            case FootageType::Solid:       w.String("Solid"); break;
+            case FootageType::Missing:     w.String("Missing"); break;
+            case FootageType::Placeholder: w.String("Placeholder"); break;
+            default:                       w.String("File"); break;
+        }
+    }
+
+    auto path = TryGet([&] { return footage.GetPath(); });
+    if (path && !path->empty()) {
+        w.Key("file_path");
+        w.String(*path);
+    }
+
+    auto sequence = TryGet([&] { return footage.GetSequenceOptionsInfo(); }).value_or(std::nullopt);
+    if (sequence && sequence->isSequence) {
+        w.Key("sequence_options");
+        w.BeginObject();
+        w.Key("is_sequence");
+        w.Bool(true);
+        w.Key("all_in_folder");
+        w.Bool(sequence->allInFolder);
+        w.Key("force_alphabetical");
+        w.Bool(sequence->forceAlphabetical);
+        w.Key("start_frame");
+        w.Int(sequence->startFrame);
+        w.Key("end_frame");
+        w.Int(sequence->endFrame);
+        w.EndObject();
+    }
+
+    w.EndObject();
+}
+
+// =============================================================
+// Comp
+// =============================================================
+
+void ProjectSerializer::WriteComp(AEGP_CompH compH) {
+    PyComp comp(compH);
+    DocumentWriter& w = m_writer;
+
+    w.BeginObject();
+    w.Key("width");
+    w.Int(comp.GetWidth());
+    w.Key("height");
+    w.Int(comp.GetHeight());
+    w.Key("pixel_aspect");
+    w.Number(TryGet([&] { return comp.GetPixelAspect(); }).value_or(1.0));
+    w.Key("frame_rate");
+    w.Number(comp.GetFrameRate());
+    w.Key("duration");
+    w.Number(comp.GetDuration());
+
+    AEGP_ColorVal bg;
+    if (PluginState::Instance().GetSuites().compSuite->AEGP_GetCompBGColor(compH, &bg) == A_Err_NONE) {
+        w.Key("background_color");
+        w.BeginArray();
+        w.Number(bg.redF);
+        w.Number(bg.greenF);
+        w.Number(bg.blueF);
+        w.EndArray();
+    }
+
+    auto workStart = TryGet([&] { return comp.GetWorkAreaStart(); });
+    auto workDuration = TryGet([&] { return comp.GetWorkAreaDuration(); });
+    if (workStart && workDuration) {
+        w.Key("work_area_start");
+        w.Number(*workStart);
+        w.Key("work_area_duration");
+        w.Number(*workDuration);
+    }
+
+    w.Key("layers");
+    w.BeginArray();
+    for (const auto& layer : comp.GetLayers()) {
+        WriteLayer(layer.GetHandle());
+    }
+    w.EndArray();
+
+    w.EndObject();
+}
+
+const std::set<int>& ProjectSerializer::GetThreeDPerCharLayers(AEGP_CompH compH) {
+    const auto& suites = PluginState::Instance().GetSuites();
+
+    AEGP_ItemH compItemH = nullptr;
+    A_long compId = 0;
+    suites.compSuite->AEGP_GetItemFromComp(compH, &compItemH);
+    if (compItemH) {
+        suites.itemSuite->AEGP_GetItemID(compItemH, &compId);
+    }
+
+    auto it = m_threeDPerChar.find(compId);
+    if (it != m_threeDPerChar.end()) {
+        return it->second;
+    }
+
+    std::set<int>& layers = m_threeDPerChar[compId];
+    if (!compItemH) {
+        return layers;
+    }
+
+    // レイヤーごとではなくコンポ単位で1回だけ問い合わせる
+    std::string script =
+        "(function() {"
+        "  var comp = app.project.itemByID(" + std::to_string(compId) + ");"
+        "  if (!(comp instanceof CompItem)) return '';"
+        "  var result = [];"
+        "  for (var i = 1; i <= comp.numLayers; i++) {"
+        "    var layer = comp.layer(i);"
+        "    if (layer instanceof TextLayer && layer.threeDPerChar) result.push(i - 1);"
+        "  }"
+        "  return result.join(',');"
+        "})();";
+
+    try {
+        std::stringstream ss(ExecuteExtendScript(script));
+        std::string token;
+        while (std::getline(ss, token, ',')) {
+            if (!token.empty()) {
+                layers.insert(std::stoi(token));
+            }
+        }
+    } catch (const std::exception& e) {
+        PYAE_LOG_DEBUG("Serializer", std::string("threeDPerChar query failed: ") + e.what());
+    }
+
+    return layers;
+}
+
+// =============================================================
+// Layer
+// =============================================================
+
+void ProjectSerializer::WriteLayer(AEGP_LayerH layerH) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    PyLayer layer(layerH);
+    DocumentWriter& w = m_writer;
+
+    LayerType layerType = layer.GetLayerType();
+    int index = layer.GetIndex();
+    double inPoint = layer.GetInPoint();
+
+    w.BeginObject();
+    w.Key("name");
+    w.String(layer.GetName());
+    w.Key("index");
+    w.Int(index);
+    w.Key("type");
+    w.String(LayerTypeToString(layerType));
+    w.Key("active");
+    w.Bool(layer.GetEnabled());
+    w.Key("is_null");
+    w.Bool(layer.IsNullLayer());
+    w.Key("is_adjustment");
+    w.Bool(layer.IsAdjustmentLayer());
+    w.Key("is_3d");
+    w.Bool(layer.Is3DLayer());
+    w.Key("time_remapping_enabled");
+    w.Bool(layer.IsTimeRemappingEnabled());
+    w.Key("in_point");
+    w.Number(inPoint);
+    w.Key("out_point");
+    w.Number(layer.GetOutPoint());
+    w.Key("start_time");
+    w.Number(layer.GetStartTime());
+
+    auto writeOptionalBool = [&](const char* key, std::optional<bool> value) {
+        if (value) {
+            w.Key(key);
+            w.Bool(*value);
+        }
+    };
+    writeOptionalBool("solo", TryGet([&] { return layer.GetSolo(); }));
+    writeOptionalBool("locked", TryGet([&] { return layer.GetLocked(); }));
+    writeOptionalBool("shy", TryGet([&] { return layer.GetShy(); }));
+    writeOptionalBool("collapse_transformation", TryGet([&] { return layer.GetCollapseTransformation(); }));
+
+    if (auto blendMode = TryGet([&] { return layer.GetBlendMode(); })) {
+        w.Key("blend_mode");
+        w.Int(*blendMode);
+    }
+    if (auto quality = TryGet([&] { return layer.GetQualityString(); })) {
+        w.Key("quality_string");
+        w.String(*quality);
+    }
+
+    if (auto label = TryGet([&] { return layer.GetLabel(); })) {
+        w.Key("label");
+        w.Int(*label);
+    }
+
+    auto comment = TryGet([&] { return layer.GetComment(); });
+    if (comment && !comment->empty()) {
+        w.Key("comment");
+        w.String(*comment);
+    }
+
+    auto markerComment = TryGet([&] { return layer.GetMarkerComment(inPoint); });
+    if (markerComment && !markerComment->empty()) {
+        w.Key("marker_comment");
+        w.String(*markerComment);
+        w.Key("marker_time");
+        w.Number(inPoint);
+    }
+
+    if (auto trackMatte = TryGet([&] { return layer.GetTrackMatteMode(); })) {
+        w.Key("track_matte");
+        w.Int(*trackMatte);
+    }
+
+    auto sourceId = TryGet([&] { return layer.GetSourceItemID(); });
+    if (sourceId && *sourceId != 0) {
+        w.Key("source_item_id");
+        w.Int(*sourceId);
+    }
+
+    AEGP_LayerH parentH = nullptr;
+    if (suites.layerSuite->AEGP_GetLayerParent(layerH, &parentH) == A_Err_NONE && parentH) {
+        A_long parentIndex = 0;
+        if (suites.layerSuite->AEGP_GetLayerIndex(parentH, &parentIndex) == A_Err_NONE) {
+            w.Key("parent_index");
+            w.Int(parentIndex);
+        }
+    }
+
+    AEGP_StreamRefH rootStreamH = nullptr;
+    if (suites.dynamicStreamSuite->AEGP_GetNewStreamRefForLayer(
+            state.GetPluginID(), layerH, &rootStreamH) != A_Err_NONE) {
+        rootStreamH = nullptr;
+    }
+    ScopedStreamRef root(suites.streamSuite, rootStreamH);
+
+    // レイヤータイプ別の追加情報
+    if (layerType == LayerType::Camera) {
+        WriteLayerOptions(root.Get(), "ADBE Camera Options Group", "camera_options");
+    } else if (layerType == LayerType::Light) {
+        WriteLayerOptions(root.Get(), "ADBE Light Options Group", "light_options");
+    } else if (layerType == LayerType::Text) {
+        WriteTextLayerData(layerH, root.Get(), index);
+    } else if (layerType == LayerType::AV && !layer.IsNullLayer()) {
+        auto width = TryGet([&] { return layer.GetWidth(); });
+        auto height = TryGet([&] { return layer.GetHeight(); });
+        if (width && height) {
+            w.Key("width");
+            w.Int(*width);
+            w.Key("height");
+            w.Int(*height);
+        }
+        if (auto color = TryGet([&] { return layer.GetSolidColor(); }).value_or(std::nullopt)) {
+            w.Key("solid_color");
+            w.BeginArray();
+            for (double c : *color) {
+                w.Number(c);
+            }
+            w.EndArray();
+        }
+    }
+
+    // Dynamic Stream によるプロパティツリー
+    w.Key("properties");
+    w.BeginObject();
+    if (root) {
+        A_long count = GetNumChildren(root.Get());
+        for (A_long i = 0; i < count; ++i) {
+            ScopedStreamRef child = GetChildStream(root.Get(), i);
+            if (!child) continue;
+            w.Key(PropertyKey(PyProperty(child.Get(), false)));
+            WriteProperty(child.Get());
+        }
+    }
+    w.EndObject();
+
+    // エフェクト
+    w.Key("effects");
+    w.BeginArray();
+    A_long numEffects = 0;
+    if (suites.effectSuite &&
+        suites.effectSuite->AEGP_GetLayerNumEffects(layerH, &numEffects) == A_Err_NONE) {
+        for (A_long i = 0; i < numEffects; ++i) {
+            AEGP_EffectRefH effectH = nullptr;
+            if (suites.effectSuite->AEGP_GetLayerEffectByIndex(
+                    state.GetPluginID(), layerH, i, &effectH) != A_Err_NONE || !effectH) {
+                continue;
+            }
+            try {
+                WriteEffect(effectH);
+            } catch (...) {
+                suites.effectSuite->AEGP_DisposeEffect(effectH);
+                throw;
+            }
+            suites.effectSuite->AEGP_DisposeEffect(effectH);
+        }
+    }
+    w.EndArray();
+
+    w.EndObject();
+    ++m_stats.layers;
+}
+
+void ProjectSerializer::WriteLayerOptions(AEGP_StreamRefH rootH, const char* groupMatchName,
+                                          const char* key) {
+    ScopedStreamRef group = GetChildStream(rootH, groupMatchName);
+    if (!group) return;
+
+    DocumentWriter& w = m_writer;
+    w.Key(key);
+    w.BeginObject();
+
+    A_long count = GetNumChildren(group.Get());
+    for (A_long i = 0; i < count; ++i) {
+        ScopedStreamRef child = GetChildStream(group.Get(), i);
+        if (!child) continue;
+        PyProperty prop(child.Get(), false);
+        if (prop.IsGroup()) continue;
+
+        AEGP_StreamType type = GetStreamType(child.Get());
+        auto value = GetValueAtZero(child.Get());
+
+        w.Key(PropertyKey(prop));
+        w.BeginObject();
+        w.Key("match_name");
+        w.String(prop.GetMatchName());
+        w.Key("value");
+        if (value) {
+            WriteStreamValueJson(w, value->Get(), type);
+        } else {
+            w.Null();
+        }
+        w.Key("num_keys");
+        w.Int(prop.GetNumKeyframes());
+        w.EndObject();
+    }
+
+    w.EndObject();
+}
+
+void ProjectSerializer::WriteTextLayerData(AEGP_LayerH layerH, AEGP_StreamRefH rootH, int layerIndex) {
+    const auto& suites = PluginState::Instance().GetSuites();
+    DocumentWriter& w = m_writer;
+
+    w.Key("has_text");
+    w.Bool(true);
+
+    AEGP_CompH compH = nullptr;
+    bool threeDPerChar = false;
+    if (suites.layerSuite->AEGP_GetLayerParentComp(layerH, &compH) == A_Err_NONE && compH) {
+        threeDPerChar = GetThreeDPerCharLayers(compH).count(layerIndex) > 0;
+    }
+    w.Key("threeDPerChar");
+    w.Bool(threeDPerChar);
+
+    ScopedStreamRef textProps = GetChildStream(rootH, "ADBE Text Properties");
+    if (!textProps) return;
+
+    ScopedStreamRef sourceText = GetChildStream(textProps.Get(), "ADBE Text Document");
+    if (sourceText) {
+        auto value = GetValueAtZero(sourceText.Get());
+        if (value && value->Get().val.text_documentH) {
+            w.Key("source_text");
+            w.String(Utf16BytesToUtf8(GetTextDocumentBytes(value->Get().val.text_documentH)));
+        }
+
+        PyProperty sourceTextProp(sourceText.Get(), false);
+        if (sourceTextProp.HasExpression()) {
+            if (auto expression = TryGet([&] { return sourceTextProp.GetExpression(); })) {
+                w.Key("source_text_expression");
+                w.String(*expression);
+                w.Key("source_text_expression_enabled");
+                w.Bool(true);
+            }
+        }
+    }
+
+    ScopedStreamRef animators = GetChildStream(textProps.Get(), "ADBE Text Animators");
+    A_long numAnimators = animators ? GetNumChildren(animators.Get()) : 0;
+    if (numAnimators > 0) {
+        w.Key("text_animators");
+        w.BeginArray();
+        for (A_long i = 0; i < numAnimators; ++i) {
+            ScopedStreamRef animator = GetChildStream(animators.Get(), i);
+            if (animator) {
+                WriteTextAnimator(animator.Get());
+            }
+        }
+        w.EndArray();
+    }
+}
+
+void ProjectSerializer::WriteTextAnimator(AEGP_StreamRefH animatorH) {
+    DocumentWriter& w = m_writer;
+    PyProperty animator(animatorH, false);
+
+    w.BeginObject();
+    w.Key("name");
+    w.String(animator.GetName());
+    w.Key("match_name");
+    w.String(animator.GetMatchName());
+
+    w.Key("selectors");
+    w.BeginArray();
+    ScopedStreamRef selectors = GetChildStream(animatorH, "ADBE Text Selectors");
+    A_long numSelectors = selectors ? GetNumChildren(selectors.Get()) : 0;
+    for (A_long i = 0; i < numSelectors; ++i) {
+        ScopedStreamRef selector = GetChildStream(selectors.Get(), i);
+        if (!selector) continue;
+        PyProperty sel(selector.Get(), false);
+        w.BeginObject();
+        w.Key("name");
+        w.String(sel.GetName());
+        w.Key("match_name");
+        w.String(sel.GetMatchName());
+        w.Key("properties");
+        w.BeginObject();
+        if (sel.IsGroup()) {
+            WriteAnimatorProperties(selector.Get(), false);
+        }
+        w.EndObject();
+        w.EndObject();
+    }
+    w.EndArray();
+
+    w.Key("properties");
+    w.BeginObject();
+    ScopedStreamRef props = GetChildStream(animatorH, "ADBE Text Animator Properties");
+    if (props) {
+        WriteAnimatorProperties(props.Get(), true);
+    }
+    w.EndObject();
+
+    w.EndObject();
+}
+
+void ProjectSerializer::WriteAnimatorProperties(AEGP_StreamRefH groupH, bool skipDefaults) {
+    DocumentWriter& w = m_writer;
+
+    A_long count = GetNumChildren(groupH);
+    for (A_long i = 0; i < count; ++i) {
+        ScopedStreamRef child = GetChildStream(groupH, i);
+        if (!child) continue;
+        PyProperty prop(child.Get(), false);
+        if (prop.IsGroup()) continue;
+
+        AEGP_StreamType type = GetStreamType(child.Get());
+        auto value = GetValueAtZero(child.Get());
+        if (!value) continue;
+
+        std::string matchName = prop.GetMatchName();
+        int numKeys = prop.GetNumKeyframes();
+        if (skipDefaults && numKeys == 0 && IsDefaultAnimatorValue(matchName, value->Get(), type)) {
+            continue;
+        }
+
+        w.Key(prop.GetName());
+        w.BeginObject();
+        w.Key("match_name");
+        w.String(matchName);
+        w.Key("value");
+        WriteStreamValueJson(w, value->Get(), type);
+        w.Key("num_keys");
+        w.Int(numKeys);
+        if (numKeys > 0) {
+            w.Key("keyframes");
+            WriteValueKeyframes(child.Get());
+        }
+        if (skipDefaults && prop.HasExpression()) {
+            w.Key("expression");
+            w.String(prop.GetExpression());
+            w.Key("expression_enabled");
+            w.Bool(true);
+        }
+        w.EndObject();
+    }
+}
+
+// =============================================================
+// Property tree
+// =============================================================
+
+void ProjectSerializer::WriteProperty(AEGP_StreamRefH streamH) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    PyProperty prop(streamH, false);
+    DocumentWriter& w = m_writer;
+
+    w.BeginObject();
+    w.Key("match_name");
+    w.String(prop.GetMatchName());
+
+    if (prop.IsGroup()) {
+        w.Key("type");
+        w.String("group");
+
+        // グループの有効/無効（レイヤースタイルなど）
+        if (auto flags = TryGet([&] { return prop.GetDynamicStreamFlags(); })) {
+            w.Key("enabled");
+            w.Bool((*flags & AEGP_DynStreamFlag_ACTIVE_EYEBALL) != 0);
+            w.Key("hidden");
+            w.Bool((*flags & AEGP_DynStreamFlag_HIDDEN) != 0);
+        }
+
+        w.Key("children");
+        w.BeginObject();
+        A_long count = GetNumChildren(streamH);
+        for (A_long i = 0; i < count; ++i) {
+            ScopedStreamRef child = GetChildStream(streamH, i);
+            if (!child) continue;
+            w.Key(PropertyKey(PyProperty(child.Get(), false)));
+            WriteProperty(child.Get());
+        }
+        w.EndObject();
+    } else {
+        int numKeys = prop.GetNumKeyframes();
+        w.Key("type");
+        w.String("property");
+        w.Key("num_keys");
+        w.Int(numKeys);
+
+        // tdum / tduM / flags
+        AEGP_StreamFlags flags = 0;
+        A_FpLong minVal = 0.0, maxVal = 0.0;
+        if (suites.streamSuite->AEGP_GetStreamProperties(streamH, &flags, &minVal, &maxVal) == A_Err_NONE) {
+            std::string bytes;
+            AppendDoubleBE(bytes, minVal);
+            w.Key("tdum");
+            w.HexString(bytes);
+            bytes.clear();
+            AppendDoubleBE(bytes, maxVal);
+            w.Key("tduM");
+            w.HexString(bytes);
+            w.Key("flags");
+            w.Int(static_cast<int64_t>(flags));
+        }
+
+        AEGP_StreamType type = GetStreamType(streamH);
+        std::optional<ScopedStreamValue> value;
+        if (type != AEGP_StreamType_NO_DATA && prop.IsLeaf()) {
+            value = GetValueAtZero(streamH);
+        }
+        w.Key("bdata");
+        w.HexString(value ? EncodeStreamValue(value->Get(), type, BdataMode::Raw) : std::string());
+        w.Key("_value");
+        if (value) {
+            WriteStreamValueJson(w, value->Get(), type);
+        } else {
+            w.Null();
+        }
+        value.reset();
+
+        if (prop.HasExpression()) {
+            w.Key("expression");
+            w.String(prop.GetExpression());
+            w.Key("expression_enabled");
+            w.Bool(true);
+        }
+
+        if (numKeys > 0 && prop.CanHaveKeyframes()) {
+            w.Key("keyframes");
+            WritePropertyKeyframes(streamH);
+        }
+    }
+
+    w.EndObject();
+    ++m_stats.properties;
+}
+
+void ProjectSerializer::WritePropertyKeyframes(AEGP_StreamRefH streamH) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    PyProperty prop(streamH, false);
+    AEGP_StreamType type = GetStreamType(streamH);
+    int numKeys = prop.GetNumKeyframes();
+    DocumentWriter& w = m_writer;
+
+    w.BeginArray();
+    for (int i = 0; i < numKeys; ++i) {
+        A_Time time;
+        if (suites.keyframeSuite->AEGP_GetKeyframeTime(
+                streamH, i, AEGP_LTimeMode_CompTime, &time) != A_Err_NONE) {
+            continue;
+        }
+
+        std::string bdata;
+        AEGP_StreamValue2 value;
+        if (type != AEGP_StreamType_NO_DATA &&
+            suites.keyframeSuite->AEGP_GetNewKeyframeValue(
+                state.GetPluginID(), streamH, i, &value) == A_Err_NONE) {
+            ScopedStreamValue scopedValue(suites.streamSuite, value);
+            bdata = EncodeStreamValue(scopedValue.Get(), type, BdataMode::Value);
+        }
+
+        auto interp = prop.GetKeyframeInterpolation(i);
+
+        w.BeginObject();
+        w.Key("time");
+        w.Number(time.scale ? AETypeUtils::TimeToSeconds(time) : 0.0);
+        w.Key("bdata");
+        w.HexString(bdata);
+        w.Key("in_interpolation");
+        w.String(interp.first);
+        w.Key("out_interpolation");
+        w.String(interp.second);
+        w.EndObject();
+        ++m_stats.keyframes;
+    }
+    w.EndArray();
+}
+
+// テキストアニメーター用（export_scene._export_keyframes 相当、値は可読形式）
+void ProjectSerializer::WriteValueKeyframes(AEGP_StreamRefH streamH) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    PyProperty prop(streamH, false);
+    AEGP_StreamType type = GetStreamType(streamH);
+    int numKeys = prop.GetNumKeyframes();
+    DocumentWriter& w = m_writer;
+
+    w.BeginArray();
+    for (int i = 0; i < numKeys; ++i) {
+        A_Time time;
+        if (suites.keyframeSuite->AEGP_GetKeyframeTime(
+                streamH, i, AEGP_LTimeMode_CompTime, &time) != A_Err_NONE) {
+            continue;
+        }
+        auto interp = prop.GetKeyframeInterpolation(i);
+
+        w.BeginObject();
+        w.Key("time");
+        w.Number(time.scale ? AETypeUtils::TimeToSeconds(time) : 0.0);
+        w.Key("value");
+        AEGP_StreamValue2 value;
+        if (suites.keyframeSuite->AEGP_GetNewKeyframeValue(
+                state.GetPluginID(), streamH, i, &value) == A_Err_NONE) {
+            ScopedStreamValue scopedValue(suites.streamSuite, value);
+            WriteStreamValueJson(w, scopedValue.Get(), type);
+        } else {
+            w.Null();
+        }
+        w.Key("in_interpolation");
+        w.String(interp.first);
+        w.Key("out_interpolation");
+        w.String(interp.second);
+        w.EndObject();
+        ++m_stats.keyframes;
+    }
+    w.EndArray();
+}
+
+// =============================================================
+// Effect
+// =============================================================
+
+void ProjectSerializer::WriteEffect(AEGP_EffectRefH effectH) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    DocumentWriter& w = m_writer;
+
+    std::string pluginName;
+    std::string matchName;
+    AEGP_InstalledEffectKey effectKey;
+    if (suites.effectSuite->AEGP_GetInstalledKeyFromLayerEffect(effectH, &effectKey) == A_Err_NONE) {
+        A_char name[AEGP_MAX_EFFECT_NAME_SIZE] = {0};
+        if (suites.effectSuite->AEGP_GetEffectName(effectKey, name) == A_Err_NONE) {
+            pluginName = StringUtils::LocalToUtf8(name);
+        }
+        A_char match[AEGP_MAX_EFFECT_MATCH_NAME_SIZE] = {0};
+        if (suites.effectSuite->AEGP_GetEffectMatchName(effectKey, match) == A_Err_NONE) {
+            matchName = StringUtils::LocalToUtf8(match);
+        }
+    }
+
+    AEGP_EffectFlags flags = AEGP_EffectFlags_NONE;
+    bool enabled = suites.effectSuite->AEGP_GetEffectFlags(effectH, &flags) == A_Err_NONE &&
+                   (flags & AEGP_EffectFlags_ACTIVE) != 0;
+
+    // パラメータ数（インデックス0 = 入力レイヤーを含む）
+    A_long numStreams = 0;
+    if (suites.streamSuite->AEGP_GetEffectNumParamStreams(effectH, &numStreams) != A_Err_NONE) {
+        numStreams = 0;
+    }
+
+    // stream_name: パラメータ1の親ストリーム（エフェクト自体）の名前
+    std::string streamName;
+    if (numStreams >= 2) {
+        AEGP_StreamRefH paramH = nullptr;
+        if (suites.streamSuite->AEGP_GetNewEffectStreamByIndex(
+                state.GetPluginID(), effectH, 1, &paramH) == A_Err_NONE && paramH) {
+            ScopedStreamRef param(suites.streamSuite, paramH);
+            AEGP_StreamRefH effectStreamH = nullptr;
+            if (suites.dynamicStreamSuite->AEGP_GetNewParentStreamRef(
+                    state.GetPluginID(), paramH, &effectStreamH) == A_Err_NONE && effectStreamH) {
+                ScopedStreamRef effectStream(suites.streamSuite, effectStreamH);
+                streamName = PyProperty(effectStreamH, false).GetName();
+            }
+        }
+    }
+
+    auto trim = [](const std::string& s) {
+        size_t begin = s.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) return std::string();
+        size_t end = s.find_last_not_of(" \t\r\n");
+        return s.substr(begin, end - begin + 1);
+    };
+
+    w.BeginObject();
+    w.Key("stream_name");
+    // プラグイン名と同じならカスタム名なし（null）
+    if (!streamName.empty() && !pluginName.empty() && trim(streamName) == trim(pluginName)) {
+        w.Null();
+    } else {
+        w.String(streamName);
+    }
+    w.Key("match_name");
+    w.String(matchName);
+    w.Key("enabled");
+    w.Bool(enabled);
+
+    w.Key("params");
+    w.BeginArray();
+    for (A_long i = 1; i < numStreams; ++i) {
+        AEGP_StreamRefH paramH = nullptr;
+        if (suites.streamSuite->AEGP_GetNewEffectStreamByIndex(
+                state.GetPluginID(), effectH, i, &paramH) != A_Err_NONE || !paramH) {
+            continue;
+        }
+        ScopedStreamRef param(suites.streamSuite, paramH);
+
+        AEGP_StreamType type = GetStreamType(paramH);
+        std::string bdata;
+        if (type != AEGP_StreamType_NO_DATA) {
+            if (auto value = GetValueAtZero(paramH)) {
+                bdata = EncodeStreamValue(value->Get(), type, BdataMode::Value);
+            }
+        }
+
+        w.BeginObject();
+        w.Key("name");
+        w.String(PyProperty(paramH, false).GetName());
+        w.Key("index");
+        w.Int(i - 1);
+        w.Key("bdata");
+        w.HexString(bdata);
+        w.Key("keyframes");
+        w.BeginArray();
+        w.EndArray();
+        w.EndObject();
+    }
+    w.EndArray();
+
+    w.EndObject();
+}
+
+} // namespace PyAE
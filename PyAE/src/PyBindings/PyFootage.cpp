@@ -232,13 +232,29 @@ py::dict PyFootage::GetSoundFormat() const
 }
 
 py::dict PyFootage::GetSequenceOptions() const
+{
+    auto options = GetSequenceOptionsInfo();
+    if (!options) {
+        return py::dict();
+    }
+
+    py::dict result;
+    result["is_sequence"] = options->isSequence;
+    result["all_in_folder"] = options->allInFolder;
+    result["force_alphabetical"] = options->forceAlphabetical;
+    result["start_frame"] = options->startFrame;
+    result["end_frame"] = options->endFrame;
+    return result;
+}
+
+std::optional<FootageSequenceOptions> PyFootage::GetSequenceOptionsInfo() const
 {
     AEGP_FootageH footageH = m_footageH;
     if (!footageH && m_itemH) {
         footageH = GetMainFootageFromItem();
     }
     if (!footageH) {
-        return py::dict();
+        return std::nullopt;
     }
 
     auto& state = PluginState::Instance();
@@ -250,14 +266,20 @@ py::dict PyFootage::GetSequenceOptions() const
     AEGP_FileSequenceImportOptions options = {};
     A_Err err = suites.footageSuite->AEGP_GetFootageSequenceImportOptions(footageH, &options);
     if (err != A_Err_NONE) {
-        return py::dict();
+        return std::nullopt;
     }
 
-    py::dict result;
-    result["all_in_folder"] = options.all_in_folderB != 0;
-    result["force_alphabetical"] = options.force_alphabeticalB != 0;
-    result["start_frame"] = options.start_frameL;
-    result["end_frame"] = options.end_frameL;
+    // 静止画・ムービーはメインファイルが1つ。2つ以上なら連番シーケンス
+    A_long num_main_files = 0;
+    A_long files_per_frame = 0;
+    err = suites.footageSuite->AEGP_GetFootageNumFiles(footageH, &num_main_files, &files_per_frame);
+
+    FootageSequenceOptions result;
+    result.isSequence = err == A_Err_NONE && num_main_files > 1;
+    result.allInFolder = options.all_in_folderB != 0;
+    result.forceAlphabetical = options.force_alphabeticalB != 0;
+    result.startFrame = static_cast<int>(options.start_frameL);
+    result.endFrame = static_cast<int>(options.end_frameL);
     return result;
 }
 
@@ -1216,7 +1238,8 @@ void init_footage(py::module_& m)
             "Get sound data format info")
 
         .def_property_readonly("sequence_options", &PyFootage::GetSequenceOptions,
-            "Get sequence import options")
+            "Get sequence import options as dict with keys:\n"
+            "is_sequence, all_in_folder, force_alphabetical, start_frame, end_frame")
 
         // Pre-project properties
         .def_property_readonly("num_files", &PyFootage::GetNumFiles,
@@ -0,0 +1,220 @@
+// PyFrameWriter.cpp
+// PyAE - Python for After Effects
+// フレームのファイル書き出し（FrameWriter）のバインディング
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <optional>
+
+#include "FrameWriter.h"
+#include "PyRenderClasses.h"
+#include "PyWorldClasses.h"
+
+namespace py = pybind11;
+
+namespace PyAE {
+
+namespace {
+
+constexpr size_t kDefaultMaxInFlightBytes = 256u * 1024u * 1024u;
+
+// timeout（秒、None は無制限）をミリ秒に
+int TimeoutMs(const std::optional<double>& timeout)
+{
+    if (!timeout) {
+        return -1;
+    }
+    return static_cast<int>((std::min)((std::max)(*timeout, 0.0) * 1000.0, 2147483647.0));
+}
+
+std::shared_ptr<FrameWriter::Job> WriteFrame(FrameWriter& writer, py::object source,
+                                             const std::string& path,
+                                             const std::optional<std::string>& format,
+                                             int bitDepth, PixelConvert::AlphaOp alpha)
+{
+    std::shared_ptr<PyFrameReceipt> receipt;
+    std::shared_ptr<PyWorld> world;
+    if (py::isinstance<PyFrameReceipt>(source)) {
+        receipt = source.cast<std::shared_ptr<PyFrameReceipt>>();
+        world = receipt->GetWorld();
+    } else {
+        world = source.cast<std::shared_ptr<PyWorld>>();
+    }
+
+    PixelConvert::ImageView view = world->GetImageView();
+    ImageEncoder::Format imageFormat = format ? ImageEncoder::FormatFromName(*format)
+                                              : ImageEncoder::FormatFromPath(path);
+    if (bitDepth <= 0) {
+        bitDepth = ImageEncoder::DefaultBitDepth(imageFormat, view.depth);
+    }
+
+    std::shared_ptr<FrameWriter::Job> job;
+    {
+        py::gil_scoped_release release;
+        job = writer.Write(view, path, imageFormat, bitDepth, alpha);
+    }
+
+    // 画素は取り込み済みなので、レシートはすぐに返す
+    if (receipt) {
+        receipt->Checkin();
+    }
+    return job;
+}
+
+void CloseWriter(FrameWriter& writer)
+{
+    py::gil_scoped_release release;
+    writer.Close();
+}
+
+} // namespace
+
+void init_frame_writer(py::module_& m)
+{
+    py::class_<FrameWriter::Job, std::shared_ptr<FrameWriter::Job>>(m, "FrameWriteFuture",
+        "Completion of one FrameWriter.write call.")
+        .def_property_readonly("path", &FrameWriter::Job::GetPath,
+            "Destination file path")
+        .def_property_readonly("bytes_written", &FrameWriter::Job::GetBytesWritten,
+            "Size of the written file (0 until done or on failure)")
+        .def("done", &FrameWriter::Job::IsDone,
+            "Return True once the file has been written or has failed.")
+        .def("wait", [](const FrameWriter::Job& self, std::optional<double> timeout) {
+            py::gil_scoped_release release;
+            return self.Wait(TimeoutMs(timeout));
+        },
+            "Wait for completion.\n\n"
+            "Args:\n"
+            "    timeout: Seconds to wait, or None to wait indefinitely\n\n"
+            "Returns:\n"
+            "    True if the write has completed",
+            py::arg("timeout") = py::none())
+        .def("result", [](const FrameWriter::Job& self, std::optional<double> timeout) {
+            bool done;
+            {
+                py::gil_scoped_release release;
+                done = self.Wait(TimeoutMs(timeout));
+            }
+            if (!done) {
+                PyErr_SetString(PyExc_TimeoutError, ("Timed out writing " + self.GetPath()).c_str());
+                throw py::error_already_set();
+            }
+            std::string error = self.GetError();
+            if (!error.empty()) {
+                throw std::runtime_error(error);
+            }
+            return self.GetPath();
+        },
+            "Wait for completion and return the written path.\n\n"
+            "Raises RuntimeError if the write failed and TimeoutError if it\n"
+            "did not finish within timeout seconds.",
+            py::arg("timeout") = py::none())
+        .def("exception", [](const FrameWriter::Job& self, std::optional<double> timeout) -> py::object {
+            bool done;
+            {
+                py::gil_scoped_release release;
+                done = self.Wait(TimeoutMs(timeout));
+            }
+            if (!done) {
+                PyErr_SetString(PyExc_TimeoutError, ("Timed out writing " + self.GetPath()).c_str());
+                throw py::error_already_set();
+            }
+            std::string error = self.GetError();
+            return error.empty() ? py::none() : py::str(error);
+        },
+            "Wait for completion and return the error message, or None on success.",
+            py::arg("timeout") = py::none())
+        .def("__repr__", [](const FrameWriter::Job& self) {
+            return "<FrameWriteFuture path='" + self.GetPath() + "' done=" +
+                   (self.IsDone() ? "True" : "False") + ">";
+        });
+
+    py::class_<FrameWriter, std::shared_ptr<FrameWriter>>(m, "FrameWriter",
+        "Write frames to image files on worker threads.\n\n"
+        "write() copies the pixels into a pooled buffer and returns a\n"
+        "FrameWriteFuture right away; encoding and file I/O run off the main\n"
+        "thread. When the buffers not yet written would exceed\n"
+        "max_in_flight_bytes, write() waits for earlier frames to finish.\n\n"
+        "Formats (no compression):\n"
+        "    png  : RGBA 8 / 16 bit\n"
+        "    tiff : RGBA 8 / 16 bit integer or 32 bit float\n"
+        "    exr  : RGBA 32 bit float (scanline)\n"
+        "    pfm  : RGB 32 bit float (alpha dropped)\n\n"
+        "Example:\n"
+        "    with ae.FrameWriter() as writer:\n"
+        "        for t in times:\n"
+        "            options.time = t\n"
+        "            receipt = ae.Renderer.render_frame(options)\n"
+        "            writer.write(receipt, f'out/frame_{t:.3f}.png')\n"
+        "    # leaving the block waits for all files")
+        .def(py::init<int, size_t>(),
+            "Args:\n"
+            "    threads: Worker threads (0 = choose from the CPU, 1-4)\n"
+            "    max_in_flight_bytes: Limit for captured frames not yet\n"
+            "        written (default 256 MB); a single larger frame is\n"
+            "        still accepted when nothing else is pending",
+            py::arg("threads") = 0,
+            py::arg("max_in_flight_bytes") = kDefaultMaxInFlightBytes)
+
+        .def("write", &WriteFrame,
+            "Capture a World or FrameReceipt and write it in the background.\n\n"
+            "A FrameReceipt is checked in as soon as its pixels are captured.\n\n"
+            "Args:\n"
+            "    source: World or FrameReceipt\n"
+            "    path: Destination file path\n"
+            "    format: 'png', 'tiff', 'exr' or 'pfm' (default: from the\n"
+            "        path extension)\n"
+            "    bit_depth: Bits per channel (0 = from the source: png 8 for\n"
+            "        8 bpc and 16 otherwise, tiff as the source, exr / pfm 32)\n"
+            "    alpha: AlphaOp applied while capturing (default NONE)\n\n"
+            "Returns:\n"
+            "    FrameWriteFuture",
+            py::arg("source"), py::arg("path"),
+            py::arg("format") = py::none(),
+            py::arg("bit_depth") = 0,
+            py::arg("alpha") = PixelConvert::AlphaOp::None)
+
+        .def("flush", [](FrameWriter& self, std::optional<double> timeout) {
+            py::gil_scoped_release release;
+            return self.Flush(TimeoutMs(timeout));
+        },
+            "Wait until every pending frame has been written.\n\n"
+            "Args:\n"
+            "    timeout: Seconds to wait, or None to wait indefinitely\n\n"
+            "Returns:\n"
+            "    True if nothing is pending",
+            py::arg("timeout") = py::none())
+
+        .def("close", &CloseWriter,
+            "Finish pending frames and stop the worker threads.\n"
+            "write() raises RuntimeError afterwards.")
+
+        .def_property_readonly("closed", &FrameWriter::IsClosed)
+        .def_property_readonly("threads", &FrameWriter::GetThreadCount)
+        .def_property_readonly("max_in_flight_bytes", &FrameWriter::GetMaxInFlightBytes)
+
+        .def("stats", [](const FrameWriter& self) {
+            FrameWriter::Stats stats = self.GetStats();
+            py::dict d;
+            d["submitted"] = stats.submitted;
+            d["written"] = stats.written;
+            d["failed"] = stats.failed;
+            d["bytes_written"] = stats.bytesWritten;
+            d["pending"] = stats.pending;
+            d["in_flight_bytes"] = stats.inFlightBytes;
+            d["peak_in_flight_bytes"] = stats.peakInFlightBytes;
+            d["pooled_buffers"] = stats.pooledBuffers;
+            return d;
+        },
+            "Get counters (submitted, written, failed, bytes_written, pending,\n"
+            "in_flight_bytes, peak_in_flight_bytes, pooled_buffers).")
+
+        .def("__enter__", [](std::shared_ptr<FrameWriter> self) { return self; })
+        .def("__exit__", [](FrameWriter& self, py::object, py::object, py::object) {
+            CloseWriter(self);
+        });
+}
+
+} // namespace PyAE
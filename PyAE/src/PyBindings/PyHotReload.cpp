@@ -0,0 +1,154 @@
+// PyHotReload.cpp
+// PyAE - Python for After Effects
+// High-level API for dependency-aware hot reload of user script modules
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/functional.h>
+
+#include "ModuleReloader.h"
+#include "StringUtils.h"
+#include "Logger.h"
+
+namespace py = pybind11;
+
+namespace PyAE {
+
+// =============================================================
+// Helpers
+// =============================================================
+
+static py::dict ReloadResultToDict(const ReloadResult& result) {
+    py::dict failed;
+    for (const auto& [name, error] : result.failed) {
+        failed[py::str(name)] = error;
+    }
+
+    py::dict d;
+    d["reloaded"] = result.reloaded;
+    d["failed"] = failed;
+    d["skipped"] = result.skipped;
+    return d;
+}
+
+static std::filesystem::path ToPath(const std::string& utf8) {
+    return std::filesystem::path(StringUtils::Utf8ToWide(utf8));
+}
+
+// =============================================================
+// Module init
+// =============================================================
+
+void init_hot_reload(py::module_& m) {
+    py::module_ hr = m.def_submodule("hot_reload",
+        R"doc(Dependency-aware hot reload of user script modules.
+
+Watches the script directories (ScriptRunner) on a background thread.
+When a .py file changes, the corresponding module and every user module
+that imports it are reloaded with importlib.reload on the AE main thread,
+dependencies first. Modules outside the script directories are never reloaded.
+
+Example:
+    import ae
+
+    def on_reload(result):
+        ae.log_info(f"reloaded: {result['reloaded']}")
+
+    ae.hot_reload.set_on_reload(on_reload)
+    ae.hot_reload.enable(poll_interval_ms=500)
+)doc");
+
+    hr.def("enable", [](int pollIntervalMs) {
+        return ModuleReloader::Instance().Start(std::chrono::milliseconds(pollIntervalMs));
+    }, R"doc(Start watching the script directories for changes.
+
+Args:
+    poll_interval_ms: Polling interval in milliseconds (minimum 50)
+
+Returns:
+    True if watching, False if there is no script directory
+)doc",
+    py::arg("poll_interval_ms") = 500);
+
+    hr.def("disable", []() {
+        py::gil_scoped_release release;
+        ModuleReloader::Instance().Stop();
+    }, "Stop watching the script directories");
+
+    hr.def("is_enabled", []() {
+        return ModuleReloader::Instance().IsWatching();
+    }, "Check whether the watcher thread is running");
+
+    hr.def("watch_directories", []() {
+        std::vector<std::string> dirs;
+        for (const auto& dir : ModuleReloader::Instance().GetWatchDirectories()) {
+            dirs.push_back(StringUtils::WideToUtf8(dir.wstring()));
+        }
+        return dirs;
+    }, "Get the directories whose modules are eligible for hot reload");
+
+    hr.def("reload", [](const std::vector<std::string>& modules) {
+        return ReloadResultToDict(ModuleReloader::Instance().ReloadModules(modules));
+    }, R"doc(Reload the given user modules and every user module that depends on them.
+
+Args:
+    modules: Module names (as in sys.modules)
+
+Returns:
+    dict with 'reloaded' (list, in reload order), 'failed' ({name: error})
+    and 'skipped' (list, dependents of failed modules)
+)doc",
+    py::arg("modules"));
+
+    hr.def("reload_files", [](const std::vector<std::string>& paths) {
+        std::vector<std::filesystem::path> files;
+        files.reserve(paths.size());
+        for (const auto& path : paths) {
+            files.push_back(ToPath(path));
+        }
+        return ReloadResultToDict(ModuleReloader::Instance().ReloadChangedFiles(files));
+    }, R"doc(Reload the user modules loaded from the given files, plus their dependents.
+
+Args:
+    paths: Source file paths (.py)
+
+Returns:
+    dict with 'reloaded', 'failed' and 'skipped' (see reload())
+)doc",
+    py::arg("paths"));
+
+    hr.def("dependency_graph", []() {
+        auto& reloader = ModuleReloader::Instance();
+        py::dict graph;
+        for (const auto& [name, deps] : reloader.BuildDependencyGraph(reloader.GetWatchDirectories())) {
+            graph[py::str(name)] = std::vector<std::string>(deps.begin(), deps.end());
+        }
+        return graph;
+    }, R"doc(Get the import graph of loaded user modules.
+
+Returns:
+    dict mapping module name -> list of user modules it imports
+)doc");
+
+    hr.def("set_on_reload", [](py::object callback) {
+        if (callback.is_none()) {
+            ModuleReloader::Instance().ClearReloadCallback();
+            return;
+        }
+        auto fn = callback.cast<std::function<void(py::dict)>>();
+        ModuleReloader::Instance().SetReloadCallback([fn](const ReloadResult& result) {
+            fn(ReloadResultToDict(result));
+        });
+    }, R"doc(Set a callback invoked after each automatic reload.
+
+Args:
+    callback: callable(result: dict) or None to clear
+)doc",
+    py::arg("callback"));
+
+    hr.def("reload_count", []() {
+        return ModuleReloader::Instance().GetReloadCount();
+    }, "Total number of modules reloaded since startup");
+}
+
+} // namespace PyAE
@@ -0,0 +1,519 @@
+// PyIncrementalRender.cpp
+// PyAE - Python for After Effects
+// 更新領域だけを描き直す差分レンダー（IncrementalRenderer）のバインディング
+//
+// フレーム全体の World を持ち続け、変更されたレイヤーの範囲（前回と今回の
+// 位置）や指定した矩形を DirtyRegion で集める。update() ではその矩形だけを
+// RegionOfInterest に指定してレンダーし、CompositeSuite の TransferRect で
+// 持ち続けている World に書き込む。時刻が変わったときは全体を描き直す。
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "AETypeUtils.h"
+#include "DirtyRegion.h"
+#include "PluginState.h"
+#include "PyLayerClasses.h"
+#include "PyRenderClasses.h"
+#include "PyWorldClasses.h"
+
+namespace py = pybind11;
+
+namespace PyAE {
+
+namespace {
+
+constexpr int kDefaultPadding = 2;
+constexpr int kDefaultMaxRegions = 1;
+
+double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// (left, top, right, bottom) または {"left": ..., ...} を受け取る
+PixelRect ParseRect(const py::object& obj)
+{
+    if (py::isinstance<py::dict>(obj)) {
+        py::dict d = obj.cast<py::dict>();
+        return PixelRect{d["left"].cast<int>(), d["top"].cast<int>(),
+                         d["right"].cast<int>(), d["bottom"].cast<int>()};
+    }
+    auto t = obj.cast<std::tuple<int, int, int, int>>();
+    return PixelRect{std::get<0>(t), std::get<1>(t), std::get<2>(t), std::get<3>(t)};
+}
+
+py::tuple RectTuple(const PixelRect& rect)
+{
+    return py::make_tuple(rect.left, rect.top, rect.right, rect.bottom);
+}
+
+} // namespace
+
+// =============================================================
+// IncrementalRenderer - 更新領域だけを描き直して持ち続ける World に合成する
+// =============================================================
+class IncrementalRenderer {
+public:
+    IncrementalRenderer(py::object item, std::shared_ptr<PyRenderOptions> options,
+                        int padding, int maxRegions)
+        : m_padding(padding)
+        , m_maxRegions(maxRegions)
+    {
+        if (padding < 0) {
+            throw std::invalid_argument("padding must not be negative");
+        }
+        if (maxRegions < 1) {
+            throw std::invalid_argument("max_regions must be at least 1");
+        }
+
+        auto& state = PluginState::Instance();
+        const auto& suites = state.GetSuites();
+        if (!suites.compSuite || !suites.layerSuite) {
+            throw std::runtime_error("Required suites not available");
+        }
+
+        m_itemH = PyRenderer::ResolveItem(item);
+        m_options = options ? options->Duplicate()
+                            : PyRenderOptions::FromItem(reinterpret_cast<uintptr_t>(m_itemH));
+        m_roiOptions = m_options->Duplicate();
+        m_time = m_options->GetTime();
+
+        auto factor = m_options->GetDownsampleFactor();
+        m_downsampleX = (std::max)(1, std::get<0>(factor));
+        m_downsampleY = (std::max)(1, std::get<1>(factor));
+
+        // レイヤーの範囲を使えるのはコンポだけ
+        if (suites.compSuite->AEGP_GetCompFromItem(m_itemH, &m_compH) != A_Err_NONE) {
+            m_compH = nullptr;
+        }
+        if (m_compH && suites.compSuite->AEGP_GetCompFramerate(m_compH, &m_fps) != A_Err_NONE) {
+            m_fps = 30.0;
+        }
+    }
+
+    std::shared_ptr<PyWorld> GetWorld() const { return m_world; }
+    double GetTime() const { return m_time; }
+    int GetPadding() const { return m_padding; }
+    int GetMaxRegions() const { return m_maxRegions; }
+
+    py::object GetFrameSize() const {
+        if (!m_region) {
+            return py::none();
+        }
+        return py::make_tuple(m_region->GetWidth(), m_region->GetHeight());
+    }
+
+    // rect（フレームの画素）を更新領域に加える。None ならフレーム全体
+    void Invalidate(const py::object& rect) {
+        if (!m_region) {
+            return;     // 最初の update() は全体を描く
+        }
+        if (rect.is_none()) {
+            m_region->AddAll();
+        } else {
+            m_region->Add(ParseRect(rect), 0);
+        }
+    }
+
+    // レイヤー（1つまたはリスト）の前回と今回の範囲を更新領域に加える
+    void MarkLayers(const py::object& layers) {
+        if (layers.is_none()) {
+            return;
+        }
+        if (!m_compH) {
+            throw std::invalid_argument("Layers can only be marked on a composition");
+        }
+        if (py::isinstance<PyLayer>(layers)) {
+            MarkLayer(layers.cast<PyLayer&>().GetHandle());
+            return;
+        }
+        for (py::handle layer : layers) {
+            if (!py::isinstance<PyLayer>(layer)) {
+                throw std::invalid_argument("Expected a Layer or a list of Layers");
+            }
+            MarkLayer(layer.cast<PyLayer&>().GetHandle());
+        }
+    }
+
+    py::dict Update(const py::object& layers, const py::object& rect, std::optional<double> time) {
+        auto start = std::chrono::steady_clock::now();
+
+        bool full = !m_world;
+        if (time && std::fabs(*time - m_time) > 1e-9) {
+            m_time = *time;
+            full = true;
+        }
+        if (!full) {
+            MarkLayers(layers);
+            if (!rect.is_none()) {
+                m_region->Add(ParseRect(rect), 0);
+            }
+        }
+
+        std::vector<PixelRect> regions;
+        if (full) {
+            RenderFull();
+            regions.push_back(m_region->GetFrame());
+        } else {
+            regions = m_region->Take(static_cast<size_t>(m_maxRegions));
+            try {
+                for (const auto& region : regions) {
+                    RenderRegion(region);
+                }
+            } catch (...) {
+                // 描けなかった領域を残す（次の update() で描き直す）
+                for (const auto& region : regions) {
+                    m_region->Add(region, 0);
+                }
+                throw;
+            }
+        }
+
+        // 全体を描いたら、その後の変更を追えるよう全レイヤーの範囲を記録し直す
+        if (full) {
+            TrackAllLayers();
+        }
+
+        int64_t fullPixels = m_region->GetFrame().Area();
+        int64_t renderedPixels = 0;
+        py::list regionList;
+        for (const auto& region : regions) {
+            renderedPixels += region.Area();
+            regionList.append(RectTuple(region));
+        }
+        int64_t savedPixels = (std::max)(fullPixels - renderedPixels, static_cast<int64_t>(0));
+        double seconds = SecondsSince(start);
+
+        m_stats.updates++;
+        if (full) {
+            m_stats.fullRenders++;
+        } else {
+            m_stats.regionRenders += regions.size();
+        }
+        m_stats.renderedPixels += renderedPixels;
+        m_stats.fullPixels += fullPixels;
+        m_stats.savedPixels += savedPixels;
+        m_stats.seconds += seconds;
+
+        py::dict result;
+        result["full"] = full;
+        result["regions"] = regionList;
+        result["rendered_pixels"] = renderedPixels;
+        result["full_pixels"] = fullPixels;
+        result["saved_pixels"] = savedPixels;
+        result["seconds"] = seconds;
+        return result;
+    }
+
+    py::dict GetStats() const {
+        py::dict result;
+        result["updates"] = m_stats.updates;
+        result["full_renders"] = m_stats.fullRenders;
+        result["region_renders"] = m_stats.regionRenders;
+        result["rendered_pixels"] = m_stats.renderedPixels;
+        result["full_pixels"] = m_stats.fullPixels;
+        result["saved_pixels"] = m_stats.savedPixels;
+        result["saved_ratio"] = m_stats.fullPixels > 0
+            ? static_cast<double>(m_stats.savedPixels) / static_cast<double>(m_stats.fullPixels)
+            : 0.0;
+        result["transfers"] = m_stats.transfers;
+        result["copies"] = m_stats.copies;
+        result["seconds"] = m_stats.seconds;
+        return result;
+    }
+
+    void ResetStats() { m_stats = Stats(); }
+
+private:
+    struct Stats {
+        uint64_t updates = 0;
+        uint64_t fullRenders = 0;
+        uint64_t regionRenders = 0;
+        int64_t renderedPixels = 0;
+        int64_t fullPixels = 0;
+        int64_t savedPixels = 0;
+        uint64_t transfers = 0;     // TransferRect で合成した数
+        uint64_t copies = 0;        // TransferRect が使えず World 間でコピーした数
+        double seconds = 0.0;
+    };
+
+    std::shared_ptr<PyFrameReceipt> Render(const std::shared_ptr<PyRenderOptions>& options) {
+        options->SetTime(m_time);
+        auto receipt = PyRenderer::RenderFrame(options);
+        if (!receipt || !receipt->IsValid()) {
+            throw std::runtime_error("Render failed");
+        }
+        return receipt;
+    }
+
+    void RenderFull() {
+        auto receipt = Render(m_options);
+        std::shared_ptr<PyWorld> frame = receipt->GetWorld();
+        int width = frame->GetWidth();
+        int height = frame->GetHeight();
+
+        // 大きさ・ビット深度が変わったら持ち続ける World を作り直す
+        if (!m_world || m_world->GetWidth() != width || m_world->GetHeight() != height ||
+            m_world->GetType() != frame->GetType()) {
+            m_world = PyWorld::Create(frame->GetType(), width, height, false);
+            if (m_region) {
+                m_region->Resize(width, height);
+            } else {
+                m_region = std::make_unique<DirtyRegion>(width, height);
+            }
+        } else {
+            m_region->ClearLayers();
+        }
+        m_world->CopyRegion(*frame, 0, 0, width, height, 0, 0);
+        receipt->Checkin();
+        m_region->Take(1);
+    }
+
+    void RenderRegion(const PixelRect& region) {
+        // RegionOfInterest はダウンサンプル前のコンポの座標で指定する
+        m_roiOptions->SetRegionOfInterest(region.left * m_downsampleX, region.top * m_downsampleY,
+                                          region.right * m_downsampleX, region.bottom * m_downsampleY);
+        auto receipt = Render(m_roiOptions);
+        std::shared_ptr<PyWorld> frame = receipt->GetWorld();
+
+        // フレーム全体の大きさで返れば同じ位置を、ROI の大きさなら原点から取る
+        PixelRect source = region;
+        if (frame->GetWidth() != m_region->GetWidth() || frame->GetHeight() != m_region->GetHeight()) {
+            source = PixelRect::Intersect(
+                PixelRect{0, 0, region.Width(), region.Height()},
+                PixelRect{0, 0, frame->GetWidth(), frame->GetHeight()});
+        }
+        if (!source.IsEmpty()) {
+            Composite(*frame, source, region.left, region.top);
+        }
+        receipt->Checkin();
+    }
+
+    // frame の source を持ち続ける World の (dstX, dstY) へ書き込む
+    void Composite(const PyWorld& frame, const PixelRect& source, int dstX, int dstY) {
+        auto& state = PluginState::Instance();
+        const auto& suites = state.GetSuites();
+
+        if (suites.compositeSuite && suites.worldSuite && frame.GetType() == m_world->GetType()) {
+            PF_EffectWorld src;
+            PF_EffectWorld dst;
+            A_Err err = suites.worldSuite->AEGP_FillOutPFEffectWorld(frame.GetHandle(), &src);
+            if (err == A_Err_NONE) {
+                err = suites.worldSuite->AEGP_FillOutPFEffectWorld(m_world->GetHandle(), &dst);
+            }
+            if (err == A_Err_NONE) {
+                PF_CompositeMode mode = {};
+                mode.xfer = PF_Xfer_COPY;
+                mode.opacity = PF_MAX_CHAN8;
+                mode.opacitySu = PF_MAX_CHAN16;
+                mode.rgb_only = FALSE;
+
+                A_Rect rect;
+                rect.left = source.left;
+                rect.top = source.top;
+                rect.right = source.right;
+                rect.bottom = source.bottom;
+
+                err = suites.compositeSuite->AEGP_TransferRect(
+                    PF_Quality_HI, PF_MF_Alpha_PREMUL, PF_Field_FRAME, &rect, &src,
+                    &mode, nullptr, nullptr, dstX, dstY, &dst);
+                if (err == A_Err_NONE) {
+                    m_stats.transfers++;
+                    return;
+                }
+            }
+        }
+
+        // CompositeSuite が使えなければ World 間でコピーする
+        m_world->CopyRegion(frame, source.left, source.top, source.Width(), source.Height(), dstX, dstY);
+        m_stats.copies++;
+    }
+
+    // レイヤーの範囲をフレームの画素で求める。3D レイヤーなど求められなければ false
+    bool LayerBounds(AEGP_LayerH layerH, PixelRect& bounds) const {
+        auto& state = PluginState::Instance();
+        const auto& suites = state.GetSuites();
+
+        // 3D レイヤーの変換はカメラの投影を含むので、画面上の範囲にならない
+        A_Boolean is3D = FALSE;
+        if (suites.layerSuite->AEGP_IsLayer3D(layerH, &is3D) != A_Err_NONE || is3D) {
+            return false;
+        }
+
+        A_Time time = AETypeUtils::SecondsToTimeWithFps(m_time, m_fps);
+        A_FloatRect masked = {0, 0, 0, 0};
+        if (suites.layerSuite->AEGP_GetLayerMaskedBounds(
+                layerH, AEGP_LTimeMode_CompTime, &time, &masked) != A_Err_NONE) {
+            return false;
+        }
+        A_Matrix4 xform;
+        if (suites.layerSuite->AEGP_GetLayerToWorldXform(layerH, &time, &xform) != A_Err_NONE) {
+            return false;
+        }
+
+        // レイヤー座標の四隅をコンポの座標へ移し、ダウンサンプル後の画素にする
+        const double cornersX[4] = {masked.left, masked.right, masked.right, masked.left};
+        const double cornersY[4] = {masked.top, masked.top, masked.bottom, masked.bottom};
+        double xs[4];
+        double ys[4];
+        for (int i = 0; i < 4; ++i) {
+            double x = cornersX[i] * xform.mat[0][0] + cornersY[i] * xform.mat[1][0] + xform.mat[3][0];
+            double y = cornersX[i] * xform.mat[0][1] + cornersY[i] * xform.mat[1][1] + xform.mat[3][1];
+            xs[i] = x / m_downsampleX;
+            ys[i] = y / m_downsampleY;
+        }
+        bounds = PixelRect::Bounds(xs, ys, 4);
+        return true;
+    }
+
+    uint64_t LayerId(AEGP_LayerH layerH) const {
+        auto& state = PluginState::Instance();
+        const auto& suites = state.GetSuites();
+        AEGP_LayerIDVal id = 0;
+        if (suites.layerSuite->AEGP_GetLayerID(layerH, &id) != A_Err_NONE) {
+            throw std::runtime_error("AEGP_GetLayerID failed");
+        }
+        return static_cast<uint64_t>(id);
+    }
+
+    void MarkLayer(AEGP_LayerH layerH) {
+        if (!layerH) {
+            throw std::invalid_argument("Invalid layer");
+        }
+        auto& state = PluginState::Instance();
+        const auto& suites = state.GetSuites();
+        AEGP_CompH parent = nullptr;
+        if (suites.layerSuite->AEGP_GetLayerParentComp(layerH, &parent) != A_Err_NONE || parent != m_compH) {
+            throw std::invalid_argument("Layer does not belong to the rendered composition");
+        }
+        if (!m_region) {
+            return;     // 最初の update() は全体を描く
+        }
+
+        PixelRect bounds;
+        if (!LayerBounds(layerH, bounds)) {
+            m_region->AddAll();
+            return;
+        }
+        m_region->UpdateLayer(LayerId(layerH), bounds, m_padding);
+    }
+
+    void TrackAllLayers() {
+        if (!m_compH) {
+            return;
+        }
+        auto& state = PluginState::Instance();
+        const auto& suites = state.GetSuites();
+        A_long count = 0;
+        if (suites.layerSuite->AEGP_GetCompNumLayers(m_compH, &count) != A_Err_NONE) {
+            return;
+        }
+        for (A_long i = 0; i < count; ++i) {
+            AEGP_LayerH layerH = nullptr;
+            if (suites.layerSuite->AEGP_GetCompLayerByIndex(m_compH, i, &layerH) != A_Err_NONE || !layerH) {
+                continue;
+            }
+            PixelRect bounds;
+            if (LayerBounds(layerH, bounds)) {
+                m_region->TrackLayer(LayerId(layerH), bounds);
+            }
+        }
+    }
+
+    AEGP_ItemH m_itemH = nullptr;
+    AEGP_CompH m_compH = nullptr;
+    A_FpLong m_fps = 30.0;
+    std::shared_ptr<PyRenderOptions> m_options;     // 全体用
+    std::shared_ptr<PyRenderOptions> m_roiOptions;  // 更新領域用（RegionOfInterest を書き換える）
+    int m_downsampleX = 1;
+    int m_downsampleY = 1;
+    int m_padding;
+    int m_maxRegions;
+    double m_time = 0.0;
+
+    std::shared_ptr<PyWorld> m_world;               // 持ち続けるフレーム全体
+    std::unique_ptr<DirtyRegion> m_region;          // 最初の全体レンダーで作る
+    Stats m_stats;
+};
+
+void init_incremental_render(py::module_& m)
+{
+    py::class_<IncrementalRenderer, std::shared_ptr<IncrementalRenderer>>(m, "IncrementalRenderer",
+        "Keep a full frame and re-render only the regions that changed.\n\n"
+        "The first update() renders the whole frame into a persistent World\n"
+        "and records the bounds of every 2D layer. Later updates render only\n"
+        "the dirty region - the old and new bounds of the layers passed in,\n"
+        "plus any rectangles - using the region of interest, and composite\n"
+        "the result into the World with CompositeSuite TransferRect.\n"
+        "Changing the time, or marking a 3D layer, re-renders the whole frame.\n\n"
+        "Rectangles are (left, top, right, bottom) in frame pixels (after\n"
+        "downsampling). Effects that draw outside the layer bounds (glows,\n"
+        "shadows) need a larger padding.\n\n"
+        "Example:\n"
+        "    inc = ae.IncrementalRenderer(comp)\n"
+        "    inc.update()                       # full frame\n"
+        "    layer.position = (200, 120)\n"
+        "    info = inc.update(layers=[layer])  # old + new bounds only\n"
+        "    print(info['saved_pixels'], inc.world.get_pixel(200, 120))")
+        .def(py::init([](py::object item, std::shared_ptr<PyRenderOptions> options,
+                         int padding, int maxRegions) {
+            return std::make_shared<IncrementalRenderer>(item, options, padding, maxRegions);
+        }),
+            "Args:\n"
+            "    item: Comp, CompItem, Item or item handle\n"
+            "    options: RenderOptions to copy (default: from the item)\n"
+            "    padding: Pixels added around layer bounds (default 2)\n"
+            "    max_regions: Renders per update at most; the dirty rectangles\n"
+            "        are merged until they fit (default 1)",
+            py::arg("item"),
+            py::arg("options") = nullptr,
+            py::arg("padding") = kDefaultPadding,
+            py::arg("max_regions") = kDefaultMaxRegions)
+
+        .def("update", &IncrementalRenderer::Update,
+            "Render the dirty region into the persistent World.\n\n"
+            "Args:\n"
+            "    layers: Layer or list of Layers that changed\n"
+            "    rect: Extra dirty rectangle, e.g. the area under the cursor\n"
+            "    time: Time in seconds; a new time re-renders the whole frame\n\n"
+            "Returns:\n"
+            "    dict: full, regions (list of rectangles), rendered_pixels,\n"
+            "    full_pixels, saved_pixels, seconds",
+            py::arg("layers") = py::none(),
+            py::arg("rect") = py::none(),
+            py::arg("time") = py::none())
+        .def("mark_layers", &IncrementalRenderer::MarkLayers,
+            "Add the old and new bounds of changed layers to the dirty region.\n\n"
+            "Call right after each change so that a layer moved several times\n"
+            "between updates still repaints every place it has been.",
+            py::arg("layers"))
+        .def("invalidate", &IncrementalRenderer::Invalidate,
+            "Add a rectangle (or the whole frame if None) to the dirty region",
+            py::arg("rect") = py::none())
+        .def("reset_stats", &IncrementalRenderer::ResetStats)
+
+        .def_property_readonly("world", &IncrementalRenderer::GetWorld,
+            "The persistent full-frame World (None before the first update)")
+        .def_property_readonly("time", &IncrementalRenderer::GetTime,
+            "Time of the persistent frame in seconds")
+        .def_property_readonly("frame_size", &IncrementalRenderer::GetFrameSize,
+            "(width, height) of the frame, or None before the first update")
+        .def_property_readonly("padding", &IncrementalRenderer::GetPadding)
+        .def_property_readonly("max_regions", &IncrementalRenderer::GetMaxRegions)
+        .def_property_readonly("stats", &IncrementalRenderer::GetStats,
+            "dict: updates, full_renders, region_renders, rendered_pixels,\n"
+            "full_pixels, saved_pixels, saved_ratio, transfers, copies, seconds");
+}
+
+} // namespace PyAE
@@ -103,6 +103,8 @@ void init_layer(pybind11::module_& m) {
             [](const PyAE::PyLayer& self) { return static_cast<PyAE::LayerQuality>(self.GetQuality()); },
             [](PyAE::PyLayer& self, int val) { self.SetQuality(val); },
             "Layer quality")
+        .def_property_readonly("quality_string", &PyAE::PyLayer::GetQualityString,
+            "Layer quality as string: 'Best', 'Draft', 'Wireframe' or 'None'")
         .def_property("sampling_quality",
             [](const PyAE::PyLayer& self) { return static_cast<PyAE::SamplingQuality>(self.GetSamplingQuality()); },
             [](PyAE::PyLayer& self, int val) { self.SetSamplingQuality(val); },
@@ -184,6 +186,12 @@ void init_layer(pybind11::module_& m) {
                               "Source item ID (read-only)")
         .def_property_readonly("object_type", &PyAE::PyLayer::GetObjectType,
                               "Object type (read-only)")
+        .def_property_readonly("width", &PyAE::PyLayer::GetWidth,
+                              "Source item width in pixels (RuntimeError if the layer has no source)")
+        .def_property_readonly("height", &PyAE::PyLayer::GetHeight,
+                              "Source item height in pixels (RuntimeError if the layer has no source)")
+        .def_property_readonly("solid_color", &PyAE::PyLayer::GetSolidColor,
+                              "Solid source color as [r, g, b] (0.0-1.0), or None if the source is not a solid")
         .def_property_readonly("is_2d", &PyAE::PyLayer::Is2D,
                               "Check if layer is 2D (read-only)")
         // トラックマット
@@ -211,6 +219,10 @@ void init_layer(pybind11::module_& m) {
                      "Layer opacity (0-100)")
         .def_property("transfer_mode", &PyAE::PyLayer::GetTransferMode, &PyAE::PyLayer::SetTransferMode,
                      "Layer transfer mode as dict with keys: mode, flags, track_matte")
+        .def_property("blend_mode", &PyAE::PyLayer::GetBlendMode, &PyAE::PyLayer::SetBlendMode,
+                     "Blend mode as int (BlendMode value); flags and track matte are kept")
+        .def_property("track_matte", &PyAE::PyLayer::GetTrackMatteMode, &PyAE::PyLayer::SetTrackMatteMode,
+                     "Track matte mode as int (TrackMatteMode value); blend mode and flags are kept")
         .def("to_world_xform", &PyAE::PyLayer::ToWorldXform,
              "Get layer to world transform matrix at specified comp time",
              py::arg("comp_time"))
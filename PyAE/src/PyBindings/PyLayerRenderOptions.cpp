@@ -22,10 +22,12 @@ PyLayerRenderOptions::PyLayerRenderOptions(AEGP_LayerRenderOptionsH optionsH, bo
     : m_optionsH(optionsH), m_owned(owned) {}
 
 PyLayerRenderOptions::PyLayerRenderOptions(PyLayerRenderOptions&& other) noexcept
-    : m_optionsH(other.m_optionsH), m_owned(other.m_owned)
+    : m_optionsH(other.m_optionsH), m_owned(other.m_owned),
+      m_pooled(other.m_pooled), m_poolKey(other.m_poolKey), m_modified(other.m_modified)
 {
     other.m_optionsH = nullptr;
     other.m_owned = false;
+    other.m_pooled = false;
 }
 
 PyLayerRenderOptions& PyLayerRenderOptions::operator=(PyLayerRenderOptions&& other) noexcept
@@ -34,8 +36,12 @@ PyLayerRenderOptions& PyLayerRenderOptions::operator=(PyLayerRenderOptions&& oth
         Dispose();
         m_optionsH = other.m_optionsH;
         m_owned = other.m_owned;
+        m_pooled = other.m_pooled;
+        m_poolKey = other.m_poolKey;
+        m_modified = other.m_modified;
         other.m_optionsH = nullptr;
         other.m_owned = false;
+        other.m_pooled = false;
     }
     return *this;
 }
@@ -47,7 +53,10 @@ PyLayerRenderOptions::~PyLayerRenderOptions()
 
 void PyLayerRenderOptions::Dispose()
 {
-    if (m_optionsH && m_owned) {
+    if (m_optionsH && m_pooled) {
+        // プールから取得したものは変更した項目と一緒に返却する
+        LayerRenderOptionsPool::Instance().Release(m_poolKey, m_optionsH, m_modified);
+    } else if (m_optionsH && m_owned) {
         auto& state = PyAE::PluginState::Instance();
         const auto& suites = state.GetSuites();
         if (suites.layerRenderOptionsSuite) {
@@ -56,6 +65,7 @@ void PyLayerRenderOptions::Dispose()
     }
     m_optionsH = nullptr;
     m_owned = false;
+    m_pooled = false;
 }
 
 bool PyLayerRenderOptions::IsValid() const
@@ -93,6 +103,7 @@ void PyLayerRenderOptions::SetTime(double seconds)
     if (!suites.layerRenderOptionsSuite) throw std::runtime_error("LayerRenderOptions Suite not available");
 
     A_Time time = AETypeUtils::SecondsToTime(seconds);
+    m_modified |= OptionsField::Time;
     A_Err err = suites.layerRenderOptionsSuite->AEGP_SetTime(m_optionsH, time);
     if (err != A_Err_NONE) {
         throw std::runtime_error("AEGP_SetTime failed (error code: " + std::to_string(err) + ")");
@@ -125,6 +136,7 @@ void PyLayerRenderOptions::SetTimeStep(double seconds)
     if (!suites.layerRenderOptionsSuite) throw std::runtime_error("LayerRenderOptions Suite not available");
 
     A_Time timeStep = AETypeUtils::SecondsToTime(seconds);
+    m_modified |= OptionsField::TimeStep;
     A_Err err = suites.layerRenderOptionsSuite->AEGP_SetTimeStep(m_optionsH, timeStep);
     if (err != A_Err_NONE) {
         throw std::runtime_error("AEGP_SetTimeStep failed (error code: " + std::to_string(err) + ")");
@@ -160,6 +172,7 @@ void PyLayerRenderOptions::SetWorldType(WorldType type)
     const auto& suites = state.GetSuites();
     if (!suites.layerRenderOptionsSuite) throw std::runtime_error("LayerRenderOptions Suite not available");
 
+    m_modified |= OptionsField::WorldType;
     A_Err err = suites.layerRenderOptionsSuite->AEGP_SetWorldType(m_optionsH, static_cast<AEGP_WorldType>(type));
     if (err != A_Err_NONE) {
         throw std::runtime_error("AEGP_SetWorldType failed (error code: " + std::to_string(err) + ")");
@@ -193,6 +206,7 @@ void PyLayerRenderOptions::SetDownsampleFactor(int x, int y)
     const auto& suites = state.GetSuites();
     if (!suites.layerRenderOptionsSuite) throw std::runtime_error("LayerRenderOptions Suite not available");
 
+    m_modified |= OptionsField::Downsample;
     A_Err err = suites.layerRenderOptionsSuite->AEGP_SetDownsampleFactor(
         m_optionsH, static_cast<A_short>(x), static_cast<A_short>(y));
     if (err != A_Err_NONE) {
@@ -225,6 +239,7 @@ void PyLayerRenderOptions::SetMatteMode(MatteMode mode)
     const auto& suites = state.GetSuites();
     if (!suites.layerRenderOptionsSuite) throw std::runtime_error("LayerRenderOptions Suite not available");
 
+    m_modified |= OptionsField::MatteMode;
     A_Err err = suites.layerRenderOptionsSuite->AEGP_SetMatteMode(m_optionsH, static_cast<AEGP_MatteMode>(mode));
     if (err != A_Err_NONE) {
         throw std::runtime_error("AEGP_SetMatteMode failed (error code: " + std::to_string(err) + ")");
@@ -263,6 +278,11 @@ AEGP_LayerRenderOptionsH PyLayerRenderOptions::GetHandle() const
 
 AEGP_LayerRenderOptionsH PyLayerRenderOptions::Release()
 {
+    if (m_optionsH && m_pooled) {
+        // 所有権が呼び出し側に移るのでプールには戻らない
+        LayerRenderOptionsPool::Instance().Abandon();
+        m_pooled = false;
+    }
     AEGP_LayerRenderOptionsH h = m_optionsH;
     m_optionsH = nullptr;
     m_owned = false;
@@ -274,6 +294,30 @@ bool PyLayerRenderOptions::IsOwned() const
     return m_owned;
 }
 
+// =============================================================
+// Pooling
+// =============================================================
+
+bool PyLayerRenderOptions::IsPooled() const
+{
+    return m_pooled;
+}
+
+void PyLayerRenderOptions::MarkModified(uint32_t fields)
+{
+    m_modified |= fields;
+}
+
+void PyLayerRenderOptions::Reset()
+{
+    if (!m_optionsH) throw std::runtime_error("Invalid LayerRenderOptions");
+    if (!m_pooled) {
+        throw std::runtime_error("Only layer render options from LayerRenderOptions.acquire() can be reset");
+    }
+    LayerRenderOptionsPool::Instance().Reset(m_poolKey, m_optionsH, m_modified);
+    m_modified = 0;
+}
+
 // =============================================================
 // Static factory methods
 // =============================================================
@@ -338,6 +382,20 @@ std::shared_ptr<PyLayerRenderOptions> PyLayerRenderOptions::FromDownstreamOfEffe
     return std::make_shared<PyLayerRenderOptions>(optionsH, true);
 }
 
+std::shared_ptr<PyLayerRenderOptions> PyLayerRenderOptions::Acquire(uintptr_t layerH_ptr)
+{
+    Validation::RequireNonNull(layerH_ptr, "layerH");
+
+    LayerRenderOptionsPool::Key key;
+    AEGP_LayerRenderOptionsH optionsH = LayerRenderOptionsPool::Instance().Acquire(
+        reinterpret_cast<AEGP_LayerH>(layerH_ptr), &key);
+
+    auto options = std::make_shared<PyLayerRenderOptions>(optionsH, true);
+    options->m_pooled = true;
+    options->m_poolKey = key;
+    return options;
+}
+
 // =============================================================
 // Module init
 // =============================================================
@@ -398,9 +456,25 @@ Example::
 
         // Handle access
         .def_property_readonly("_handle",
-            [](const PyLayerRenderOptions& self) { return reinterpret_cast<uintptr_t>(self.GetHandle()); },
+            [](PyLayerRenderOptions& self) {
+                // SDK から直接変更されうるので、返却時にすべての項目を戻す
+                self.MarkModified(OptionsField::All);
+                return reinterpret_cast<uintptr_t>(self.GetHandle());
+            },
             "Internal: Get raw handle as integer.")
 
+        // Pooling
+        .def_property_readonly("pooled", &PyLayerRenderOptions::IsPooled,
+            "True if the options came from LayerRenderOptions.acquire().")
+        .def("reset", &PyLayerRenderOptions::Reset,
+            R"doc(Restore the layer's default values in place.
+
+Only the fields changed since the options were acquired are set again.
+
+Raises:
+    RuntimeError: If the options did not come from acquire()
+)doc")
+
         // Static factory methods
         .def_static("from_layer", &PyLayerRenderOptions::FromLayer,
             py::arg("layer_handle"),
@@ -442,7 +516,116 @@ Returns:
 
 Warning:
     This function can only be called from the UI thread.
+)doc")
+        .def_static("acquire",
+            [](py::object layer, py::object time) {
+                uintptr_t layerH = 0;
+                if (py::isinstance<py::int_>(layer)) {
+                    layerH = layer.cast<uintptr_t>();
+                } else if (py::hasattr(layer, "_handle")) {
+                    layerH = layer.attr("_handle").cast<uintptr_t>();
+                } else {
+                    throw std::invalid_argument("Expected a Layer or layer handle");
+                }
+                auto options = PyLayerRenderOptions::Acquire(layerH);
+                if (!time.is_none()) {
+                    options->SetTime(time.cast<double>());
+                }
+                return options;
+            },
+            py::arg("layer"), py::arg("time") = py::none(),
+            R"doc(Acquire render options for a layer from LayerRenderOptionsPool.
+
+The options start at the same values as from_layer(). When they are
+garbage-collected the handle goes back to the pool, and the next
+acquire() for the same layer resets only the fields that were changed
+instead of creating a new handle. A render loop can also keep one
+object and change ``time`` every frame.
+
+Args:
+    layer: Layer or layer handle (int)
+    time: Render time in seconds (default: the layer's current time)
+
+Returns:
+    Pooled LayerRenderOptions instance
+
+Example::
+
+    options = ae.LayerRenderOptions.acquire(layer)
+    for frame in range(num_frames):
+        options.time = frame / fps
+        ...
 )doc");
+
+    // LayerRenderOptionsPool (static interface to the process-wide pool)
+    py::class_<LayerRenderOptionsPool, std::unique_ptr<LayerRenderOptionsPool, py::nodelete>>(
+        m, "LayerRenderOptionsPool",
+        R"doc(Pool that recycles handles from LayerRenderOptions.acquire().
+
+Up to max_idle handles are kept per layer together with the layer's
+default values. When more than max_layers layers are pooled, the least
+recently acquired layer's handles are disposed. If the composition,
+its current time or the project bit depth changed since the defaults
+were taken, acquire() takes them again from a new handle.
+)doc")
+
+        .def_static("stats", []() {
+            auto& pool = LayerRenderOptionsPool::Instance();
+            LayerRenderOptionsPool::Stats stats = pool.GetStats();
+            py::dict result;
+            result["hits"] = stats.hits;
+            result["misses"] = stats.misses;
+            result["resets"] = stats.resets;
+            result["refreshes"] = stats.refreshes;
+            result["returned"] = stats.returned;
+            result["evicted"] = stats.evicted;
+            result["pooled"] = stats.pooled;
+            result["live"] = stats.live;
+            result["layers"] = stats.owners;
+            result["max_idle"] = pool.GetMaxIdle();
+            result["max_layers"] = pool.GetMaxOwners();
+            result["enabled"] = pool.IsEnabled();
+            return result;
+        },
+            R"doc(Get pool statistics as a dict.
+
+Keys: hits, misses, resets (reused handles that needed fields restored),
+refreshes (defaults taken again after a change), returned, evicted,
+pooled, live, layers, max_idle, max_layers, enabled
+)doc")
+
+        .def_static("reset_stats", []() { LayerRenderOptionsPool::Instance().ResetStats(); },
+            "Reset counters (pooled handles are kept).")
+
+        .def_static("max_idle", []() { return LayerRenderOptionsPool::Instance().GetMaxIdle(); },
+            "Get the number of handles kept per layer.")
+
+        .def_static("set_max_idle", [](size_t maxIdle) {
+            LayerRenderOptionsPool::Instance().SetMaxIdle(maxIdle);
+        },
+            "Set the number of handles kept per layer; excess handles are disposed.",
+            py::arg("max_idle"))
+
+        .def_static("max_layers", []() { return LayerRenderOptionsPool::Instance().GetMaxOwners(); },
+            "Get the number of layers kept in the pool.")
+
+        .def_static("set_max_layers", [](size_t maxLayers) {
+            LayerRenderOptionsPool::Instance().SetMaxOwners(maxLayers);
+        },
+            "Set the number of layers kept in the pool; least recently used layers are dropped.",
+            py::arg("max_layers"))
+
+        .def_static("enabled", []() { return LayerRenderOptionsPool::Instance().IsEnabled(); },
+            "Check whether released handles are pooled.")
+
+        .def_static("set_enabled", [](bool enabled) {
+            LayerRenderOptionsPool::Instance().SetEnabled(enabled);
+        },
+            "Enable or disable pooling. Disabling disposes all pooled handles.",
+            py::arg("enabled"))
+
+        .def_static("clear", []() { LayerRenderOptionsPool::Instance().Clear(); },
+            "Dispose all pooled handles and forget the layer defaults.");
 }
 
 } // namespace PyAE
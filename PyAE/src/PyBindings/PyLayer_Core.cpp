@@ -181,6 +181,16 @@ void PyLayer::SetQuality(int quality) {
     }
 }
 
+// export_scene の quality_string と同じ表記
+std::string PyLayer::GetQualityString() const {
+    switch (static_cast<LayerQuality>(GetQuality())) {
+        case LayerQuality::Best:      return "Best";
+        case LayerQuality::Draft:     return "Draft";
+        case LayerQuality::Wireframe: return "Wireframe";
+        default:                      return "None";
+    }
+}
+
 int PyLayer::GetSamplingQuality() const {
     if (!m_layerH) return 0;
 
@@ -444,6 +454,84 @@ int PyLayer::GetSourceItemID() const {
     return static_cast<int>(sourceItemID);
 }
 
+// ==========================================
+// ソースアイテム寸法・平面色
+// ==========================================
+int PyLayer::GetWidth() const {
+    if (!m_layerH) return 0;
+
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_ItemH sourceItemH = nullptr;
+    A_Err err = suites.layerSuite->AEGP_GetLayerSourceItem(m_layerH, &sourceItemH);
+    if (err != A_Err_NONE || !sourceItemH) {
+        throw std::runtime_error("Layer has no source item");
+    }
+
+    A_long width = 0, height = 0;
+    err = suites.itemSuite->AEGP_GetItemDimensions(sourceItemH, &width, &height);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("AEGP_GetItemDimensions failed");
+    }
+
+    return static_cast<int>(width);
+}
+
+int PyLayer::GetHeight() const {
+    if (!m_layerH) return 0;
+
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_ItemH sourceItemH = nullptr;
+    A_Err err = suites.layerSuite->AEGP_GetLayerSourceItem(m_layerH, &sourceItemH);
+    if (err != A_Err_NONE || !sourceItemH) {
+        throw std::runtime_error("Layer has no source item");
+    }
+
+    A_long width = 0, height = 0;
+    err = suites.itemSuite->AEGP_GetItemDimensions(sourceItemH, &width, &height);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("AEGP_GetItemDimensions failed");
+    }
+
+    return static_cast<int>(height);
+}
+
+// ソースが平面フッテージのときだけ RGB を返す（それ以外は nullopt）
+std::optional<std::vector<double>> PyLayer::GetSolidColor() const {
+    if (!m_layerH) return std::nullopt;
+
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    if (!suites.footageSuite) return std::nullopt;
+
+    AEGP_ItemH sourceItemH = nullptr;
+    A_Err err = suites.layerSuite->AEGP_GetLayerSourceItem(m_layerH, &sourceItemH);
+    if (err != A_Err_NONE || !sourceItemH) return std::nullopt;
+
+    AEGP_ItemType itemType = AEGP_ItemType_NONE;
+    err = suites.itemSuite->AEGP_GetItemType(sourceItemH, &itemType);
+    if (err != A_Err_NONE || itemType != AEGP_ItemType_FOOTAGE) return std::nullopt;
+
+    AEGP_FootageH footageH = nullptr;
+    err = suites.footageSuite->AEGP_GetMainFootageFromItem(sourceItemH, &footageH);
+    if (err != A_Err_NONE || !footageH) return std::nullopt;
+
+    AEGP_FootageSignature sig = AEGP_FootageSignature_NONE;
+    err = suites.footageSuite->AEGP_GetFootageSignature(footageH, &sig);
+    if (err != A_Err_NONE || sig != AEGP_FootageSignature_SOLID) return std::nullopt;
+
+    AEGP_ColorVal color;
+    err = suites.footageSuite->AEGP_GetSolidFootageColor(sourceItemH, FALSE, &color);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("AEGP_GetSolidFootageColor failed");
+    }
+
+    return std::vector<double>{color.redF, color.greenF, color.blueF};
+}
+
 int PyLayer::GetObjectType() const {
     if (!m_layerH) return 0;
 
@@ -432,6 +432,79 @@ void PyLayer::SetTransferMode(const py::dict& transfer_mode) {
     }
 }
 
+// blend_mode / track_matte は転送モードの一部だけを書き換え、残りは保持する
+int PyLayer::GetBlendMode() const {
+    if (!m_layerH) return 0;
+
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_LayerTransferMode transferMode;
+    A_Err err = suites.layerSuite->AEGP_GetLayerTransferMode(m_layerH, &transferMode);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("AEGP_GetLayerTransferMode failed");
+    }
+
+    return static_cast<int>(transferMode.mode);
+}
+
+void PyLayer::SetBlendMode(int mode) {
+    if (!m_layerH) {
+        throw std::runtime_error("Invalid layer");
+    }
+
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_LayerTransferMode transferMode;
+    A_Err err = suites.layerSuite->AEGP_GetLayerTransferMode(m_layerH, &transferMode);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("AEGP_GetLayerTransferMode failed");
+    }
+
+    transferMode.mode = static_cast<PF_TransferMode>(mode);
+    err = suites.layerSuite->AEGP_SetLayerTransferMode(m_layerH, &transferMode);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("Failed to set layer blend mode");
+    }
+}
+
+int PyLayer::GetTrackMatteMode() const {
+    if (!m_layerH) return 0;
+
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_LayerTransferMode transferMode;
+    A_Err err = suites.layerSuite->AEGP_GetLayerTransferMode(m_layerH, &transferMode);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("AEGP_GetLayerTransferMode failed");
+    }
+
+    return static_cast<int>(transferMode.track_matte);
+}
+
+void PyLayer::SetTrackMatteMode(int mode) {
+    if (!m_layerH) {
+        throw std::runtime_error("Invalid layer");
+    }
+
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_LayerTransferMode transferMode;
+    A_Err err = suites.layerSuite->AEGP_GetLayerTransferMode(m_layerH, &transferMode);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("AEGP_GetLayerTransferMode failed");
+    }
+
+    transferMode.track_matte = static_cast<AEGP_TrackMatte>(mode);
+    err = suites.layerSuite->AEGP_SetLayerTransferMode(m_layerH, &transferMode);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("Failed to set layer track matte");
+    }
+}
+
 // =============================================================
 // Transform Matrix
 // =============================================================
@@ -6,6 +6,9 @@
 
 #include "PyRenderClasses.h"
 #include "PluginState.h"
+#include "PyCompClasses.h"
+
+#include <algorithm>
 
 namespace PyAE {
 
@@ -28,9 +31,13 @@ PyRenderOptions::PyRenderOptions(AEGP_RenderOptionsH optionsH, bool owned)
 PyRenderOptions::PyRenderOptions(PyRenderOptions&& other) noexcept
     : m_optionsH(other.m_optionsH)
     , m_owned(other.m_owned)
+    , m_pooled(other.m_pooled)
+    , m_poolKey(other.m_poolKey)
+    , m_modified(other.m_modified)
 {
     other.m_optionsH = nullptr;
     other.m_owned = false;
+    other.m_pooled = false;
 }
 
 PyRenderOptions& PyRenderOptions::operator=(PyRenderOptions&& other) noexcept
@@ -39,8 +46,12 @@ PyRenderOptions& PyRenderOptions::operator=(PyRenderOptions&& other) noexcept
         Dispose();
         m_optionsH = other.m_optionsH;
         m_owned = other.m_owned;
+        m_pooled = other.m_pooled;
+        m_poolKey = other.m_poolKey;
+        m_modified = other.m_modified;
         other.m_optionsH = nullptr;
         other.m_owned = false;
+        other.m_pooled = false;
     }
     return *this;
 }
@@ -52,7 +63,13 @@ PyRenderOptions::~PyRenderOptions()
 
 void PyRenderOptions::Dispose()
 {
-    if (m_optionsH && m_owned) {
+    if (m_optionsH && m_pooled) {
+        // プールから取得したものは変更した項目と一緒に返却する
+        RenderOptionsPool::Instance().Release(m_poolKey, m_optionsH, m_modified);
+        m_optionsH = nullptr;
+        m_owned = false;
+        m_pooled = false;
+    } else if (m_optionsH && m_owned) {
         auto& state = PluginState::Instance();
         const auto& suites = state.GetSuites();
         if (suites.renderOptionsSuite) {
@@ -106,6 +123,7 @@ void PyRenderOptions::SetTime(double seconds)
     time.scale = 1000000;  // Microsecond precision
     time.value = static_cast<A_long>(seconds * time.scale);
 
+    m_modified |= OptionsField::Time;
     A_Err err = suites.renderOptionsSuite->AEGP_SetTime(m_optionsH, time);
     if (err != A_Err_NONE) {
         throw std::runtime_error("AEGP_SetTime failed");
@@ -149,6 +167,7 @@ void PyRenderOptions::SetTimeStep(double seconds)
     timeStep.scale = 1000000;
     timeStep.value = static_cast<A_long>(seconds * timeStep.scale);
 
+    m_modified |= OptionsField::TimeStep;
     A_Err err = suites.renderOptionsSuite->AEGP_SetTimeStep(m_optionsH, timeStep);
     if (err != A_Err_NONE) {
         throw std::runtime_error("AEGP_SetTimeStep failed");
@@ -188,6 +207,7 @@ void PyRenderOptions::SetWorldType(WorldType type)
         throw std::runtime_error("RenderOptions Suite not available");
     }
 
+    m_modified |= OptionsField::WorldType;
     A_Err err = suites.renderOptionsSuite->AEGP_SetWorldType(
         m_optionsH, static_cast<AEGP_WorldType>(type));
     if (err != A_Err_NONE) {
@@ -228,6 +248,7 @@ void PyRenderOptions::SetFieldRender(FieldRender field)
         throw std::runtime_error("RenderOptions Suite not available");
     }
 
+    m_modified |= OptionsField::FieldRender;
     A_Err err = suites.renderOptionsSuite->AEGP_SetFieldRender(
         m_optionsH, static_cast<PF_Field>(field));
     if (err != A_Err_NONE) {
@@ -271,6 +292,7 @@ void PyRenderOptions::SetDownsampleFactor(int x, int y)
         throw std::runtime_error("RenderOptions Suite not available");
     }
 
+    m_modified |= OptionsField::Downsample;
     A_Err err = suites.renderOptionsSuite->AEGP_SetDownsampleFactor(
         m_optionsH, static_cast<A_short>(x), static_cast<A_short>(y));
     if (err != A_Err_NONE) {
@@ -322,6 +344,7 @@ void PyRenderOptions::SetRegionOfInterest(int left, int top, int right, int bott
     roi.right = right;
     roi.bottom = bottom;
 
+    m_modified |= OptionsField::RegionOfInterest;
     A_Err err = suites.renderOptionsSuite->AEGP_SetRegionOfInterest(m_optionsH, &roi);
     if (err != A_Err_NONE) {
         throw std::runtime_error("AEGP_SetRegionOfInterest failed");
@@ -361,6 +384,7 @@ void PyRenderOptions::SetMatteMode(MatteMode mode)
         throw std::runtime_error("RenderOptions Suite not available");
     }
 
+    m_modified |= OptionsField::MatteMode;
     A_Err err = suites.renderOptionsSuite->AEGP_SetMatteMode(
         m_optionsH, static_cast<AEGP_MatteMode>(mode));
     if (err != A_Err_NONE) {
@@ -401,6 +425,7 @@ void PyRenderOptions::SetChannelOrder(ChannelOrder order)
         throw std::runtime_error("RenderOptions Suite not available");
     }
 
+    m_modified |= OptionsField::ChannelOrder;
     A_Err err = suites.renderOptionsSuite->AEGP_SetChannelOrder(
         m_optionsH, static_cast<AEGP_ChannelOrder>(order));
     if (err != A_Err_NONE) {
@@ -441,6 +466,7 @@ void PyRenderOptions::SetRenderGuideLayers(bool render)
         throw std::runtime_error("RenderOptions Suite not available");
     }
 
+    m_modified |= OptionsField::GuideLayers;
     A_Err err = suites.renderOptionsSuite->AEGP_SetRenderGuideLayers(
         m_optionsH, render ? TRUE : FALSE);
     if (err != A_Err_NONE) {
@@ -481,6 +507,7 @@ void PyRenderOptions::SetRenderQuality(RenderQuality quality)
         throw std::runtime_error("RenderOptions Suite not available");
     }
 
+    m_modified |= OptionsField::Quality;
     A_Err err = suites.renderOptionsSuite->AEGP_SetRenderQuality(
         m_optionsH, static_cast<AEGP_ItemQuality>(quality));
     if (err != A_Err_NONE) {
@@ -517,6 +544,11 @@ AEGP_RenderOptionsH PyRenderOptions::GetHandle() const
 
 AEGP_RenderOptionsH PyRenderOptions::Release()
 {
+    if (m_optionsH && m_pooled) {
+        // 所有権が呼び出し側に移るのでプールには戻らない
+        RenderOptionsPool::Instance().Abandon();
+        m_pooled = false;
+    }
     AEGP_RenderOptionsH h = m_optionsH;
     m_optionsH = nullptr;
     m_owned = false;
@@ -528,6 +560,28 @@ bool PyRenderOptions::IsOwned() const
     return m_owned;
 }
 
+bool PyRenderOptions::IsPooled() const
+{
+    return m_pooled;
+}
+
+void PyRenderOptions::MarkModified(uint32_t fields)
+{
+    m_modified |= fields;
+}
+
+void PyRenderOptions::Reset()
+{
+    if (!m_optionsH) {
+        throw std::runtime_error("Invalid render options");
+    }
+    if (!m_pooled) {
+        throw std::runtime_error("Only render options from RenderOptions.acquire() can be reset");
+    }
+    RenderOptionsPool::Instance().Reset(m_poolKey, m_optionsH, m_modified);
+    m_modified = 0;
+}
+
 std::shared_ptr<PyRenderOptions> PyRenderOptions::FromItem(uintptr_t itemH_ptr)
 {
     if (itemH_ptr == 0) {
@@ -552,6 +606,22 @@ std::shared_ptr<PyRenderOptions> PyRenderOptions::FromItem(uintptr_t itemH_ptr)
     return std::make_shared<PyRenderOptions>(optionsH, true);
 }
 
+std::shared_ptr<PyRenderOptions> PyRenderOptions::Acquire(uintptr_t itemH_ptr)
+{
+    if (itemH_ptr == 0) {
+        throw std::runtime_error("Invalid item handle");
+    }
+
+    RenderOptionsPool::Key key;
+    AEGP_RenderOptionsH optionsH = RenderOptionsPool::Instance().Acquire(
+        reinterpret_cast<AEGP_ItemH>(itemH_ptr), &key);
+
+    auto options = std::make_shared<PyRenderOptions>(optionsH, true);
+    options->m_pooled = true;
+    options->m_poolKey = key;
+    return options;
+}
+
 // =============================================================
 // PyFrameReceipt Implementation
 // =============================================================
@@ -571,6 +641,7 @@ PyFrameReceipt::PyFrameReceipt(AEGP_FrameReceiptH receiptH)
 PyFrameReceipt::PyFrameReceipt(PyFrameReceipt&& other) noexcept
     : m_receiptH(other.m_receiptH)
     , m_checkedIn(other.m_checkedIn)
+    , m_worlds(std::move(other.m_worlds))
 {
     other.m_receiptH = nullptr;
     other.m_checkedIn = true;
@@ -582,6 +653,7 @@ PyFrameReceipt& PyFrameReceipt::operator=(PyFrameReceipt&& other) noexcept
         Checkin();
         m_receiptH = other.m_receiptH;
         m_checkedIn = other.m_checkedIn;
+        m_worlds = std::move(other.m_worlds);
         other.m_receiptH = nullptr;
         other.m_checkedIn = true;
     }
@@ -602,7 +674,7 @@ bool PyFrameReceipt::IsValid() const
     return m_receiptH != nullptr && !m_checkedIn;
 }
 
-std::shared_ptr<PyWorld> PyFrameReceipt::GetWorld() const
+std::shared_ptr<PyWorld> PyFrameReceipt::GetWorld()
 {
     if (!IsValid()) {
         throw std::runtime_error("Invalid or checked-in frame receipt");
@@ -622,7 +694,13 @@ std::shared_ptr<PyWorld> PyFrameReceipt::GetWorld() const
 
     // Note: The world is NOT owned by us - it's owned by the receipt
     // We pass owned=false so that PyWorld won't try to dispose it
-    return std::make_shared<PyWorld>(worldH, false);
+    auto world = std::make_shared<PyWorld>(worldH, false);
+
+    // 破棄済みのものを除いてから記録する（チェックインで無効化する）
+    m_worlds.erase(std::remove_if(m_worlds.begin(), m_worlds.end(),
+        [](const std::weak_ptr<PyWorld>& w) { return w.expired(); }), m_worlds.end());
+    m_worlds.push_back(world);
+    return world;
 }
 
 py::dict PyFrameReceipt::GetRenderedRegion() const
@@ -693,6 +771,14 @@ std::string PyFrameReceipt::GetGuid() const
 
 void PyFrameReceipt::Checkin()
 {
+    // 渡したワールドは AE のメモリを指しているので、チェックイン前に無効化する
+    for (const auto& weak : m_worlds) {
+        if (auto world = weak.lock()) {
+            world->Invalidate();
+        }
+    }
+    m_worlds.clear();
+
     if (m_receiptH && !m_checkedIn) {
         auto& state = PluginState::Instance();
         const auto& suites = state.GetSuites();
@@ -723,8 +809,27 @@ AEGP_FrameReceiptH PyFrameReceipt::GetHandle() const
 // PyRenderer Implementation
 // =============================================================
 
+namespace {
+
+// AEGP_CancelFunc: AE がレンダー中に呼び、TRUE を返すと中断する
+A_Err CheckRenderCancel(void* refcon, A_Boolean* cancelPB)
+{
+    const auto* shouldCancel = static_cast<const std::function<bool()>*>(refcon);
+    *cancelPB = (*shouldCancel)() ? TRUE : FALSE;
+    return A_Err_NONE;
+}
+
+} // namespace
+
 std::shared_ptr<PyFrameReceipt> PyRenderer::RenderFrame(
     const std::shared_ptr<PyRenderOptions>& options)
+{
+    return RenderFrame(options, std::function<bool()>());
+}
+
+std::shared_ptr<PyFrameReceipt> PyRenderer::RenderFrame(
+    const std::shared_ptr<PyRenderOptions>& options,
+    const std::function<bool()>& shouldCancel)
 {
     if (!options || !options->IsValid()) {
         throw std::runtime_error("Invalid render options");
@@ -739,10 +844,18 @@ std::shared_ptr<PyFrameReceipt> PyRenderer::RenderFrame(
     AEGP_FrameReceiptH receiptH = nullptr;
     A_Err err = suites.renderSuite->AEGP_RenderAndCheckoutFrame(
         options->GetHandle(),
-        nullptr,  // cancel_functionP0 - not available from Python
-        nullptr,  // cancel_function_refconP0
+        shouldCancel ? &CheckRenderCancel : nullptr,
+        shouldCancel ? const_cast<std::function<bool()>*>(&shouldCancel) : nullptr,
         &receiptH);
 
+    // 中断した場合はエラーでもレシートがあっても nullptr を返す
+    if (shouldCancel && shouldCancel()) {
+        if (receiptH) {
+            suites.renderSuite->AEGP_CheckinFrame(receiptH);
+        }
+        return nullptr;
+    }
+
     if (err != A_Err_NONE) {
         throw std::runtime_error("AEGP_RenderAndCheckoutFrame failed with error: " + std::to_string(err));
     }
@@ -778,6 +891,26 @@ std::shared_ptr<PyFrameReceipt> PyRenderer::RenderLayerFrame(uintptr_t layerOpti
     return std::make_shared<PyFrameReceipt>(receiptH);
 }
 
+AEGP_ItemH PyRenderer::ResolveItem(const py::object& item)
+{
+    uintptr_t ptr = 0;
+    if (py::isinstance<PyComp>(item)) {
+        ptr = reinterpret_cast<uintptr_t>(item.cast<PyComp&>().GetItemHandle());
+    } else if (py::hasattr(item, "_item_handle")) {
+        ptr = item.attr("_item_handle").cast<uintptr_t>();
+    } else if (py::hasattr(item, "_handle")) {
+        ptr = item.attr("_handle").cast<uintptr_t>();
+    } else if (py::isinstance<py::int_>(item)) {
+        ptr = item.cast<uintptr_t>();
+    } else {
+        throw std::invalid_argument("Expected an Item, Comp or item handle");
+    }
+    if (!ptr) {
+        throw std::runtime_error("Invalid item");
+    }
+    return reinterpret_cast<AEGP_ItemH>(ptr);
+}
+
 std::tuple<int, int, int, int> PyRenderer::GetCurrentTimestamp()
 {
     auto& state = PluginState::Instance();
@@ -975,12 +1108,44 @@ void init_render(py::module_& m)
             "Render quality")
         .def("duplicate", &PyRenderOptions::Duplicate,
             "Create a duplicate of this render options")
-        .def_property_readonly("_handle", [](const PyRenderOptions& self) {
+        .def_property_readonly("_handle", [](PyRenderOptions& self) {
+            // SDK から直接変更されうるので、返却時にすべての項目を戻す
+            self.MarkModified(OptionsField::All);
             return reinterpret_cast<uintptr_t>(self.GetHandle());
         }, "Internal: raw handle")
+        .def_property_readonly("pooled", &PyRenderOptions::IsPooled,
+            "True if the options came from RenderOptions.acquire()")
+        .def("reset", &PyRenderOptions::Reset,
+            "Restore the item's default values in place.\n\n"
+            "Only the fields changed since the options were acquired are set\n"
+            "again. Raises RuntimeError if the options did not come from acquire()")
         .def_static("from_item", &PyRenderOptions::FromItem,
             py::arg("item_handle"),
             "Create render options from an item (composition or footage)")
+        .def_static("acquire",
+            [](const py::object& item, py::object time) {
+                auto options = PyRenderOptions::Acquire(
+                    reinterpret_cast<uintptr_t>(PyRenderer::ResolveItem(item)));
+                if (!time.is_none()) {
+                    options->SetTime(time.cast<double>());
+                }
+                return options;
+            },
+            py::arg("item"), py::arg("time") = py::none(),
+            "Acquire render options for an item from RenderOptionsPool.\n\n"
+            "The options start at the same values as from_item(). When they are\n"
+            "garbage-collected the handle goes back to the pool, and the next\n"
+            "acquire() for the same item resets only the fields that were\n"
+            "changed instead of creating a new handle. A render loop can also\n"
+            "keep one object and change time every frame::\n\n"
+            "    options = ae.RenderOptions.acquire(comp)\n"
+            "    for frame in range(num_frames):\n"
+            "        options.time = frame / comp.frame_rate\n"
+            "        with ae.Renderer.render_frame(options) as receipt:\n"
+            "            ...\n\n"
+            "Args:\n"
+            "    item: Item, Comp or item handle (int)\n"
+            "    time: Render time in seconds (default: the item's current time)")
         .def("__repr__", [](const PyRenderOptions& self) {
             if (!self.IsValid()) {
                 return std::string("<RenderOptions: invalid>");
@@ -988,6 +1153,75 @@ void init_render(py::module_& m)
             return std::string("<RenderOptions: valid>");
         });
 
+    // RenderOptionsPool (static interface to the process-wide pool)
+    py::class_<RenderOptionsPool, std::unique_ptr<RenderOptionsPool, py::nodelete>>(m, "RenderOptionsPool",
+        "Pool that recycles handles from RenderOptions.acquire().\n\n"
+        "Up to max_idle handles are kept per item together with the item's\n"
+        "default values. When more than max_items items are pooled, the least\n"
+        "recently acquired item's handles are disposed. If the item, its\n"
+        "current time or the project bit depth changed since the defaults\n"
+        "were taken, acquire() takes them again from a new handle.\n\n"
+        "Example::\n\n"
+        "    ae.RenderOptionsPool.set_max_idle(8)\n"
+        "    print(ae.RenderOptionsPool.stats())")
+
+        .def_static("stats", []() {
+            auto& pool = RenderOptionsPool::Instance();
+            RenderOptionsPool::Stats stats = pool.GetStats();
+            py::dict result;
+            result["hits"] = stats.hits;
+            result["misses"] = stats.misses;
+            result["resets"] = stats.resets;
+            result["refreshes"] = stats.refreshes;
+            result["returned"] = stats.returned;
+            result["evicted"] = stats.evicted;
+            result["pooled"] = stats.pooled;
+            result["live"] = stats.live;
+            result["items"] = stats.owners;
+            result["max_idle"] = pool.GetMaxIdle();
+            result["max_items"] = pool.GetMaxOwners();
+            result["enabled"] = pool.IsEnabled();
+            return result;
+        },
+            "Get pool statistics as a dict.\n\n"
+            "Keys: hits, misses, resets (reused handles that needed fields\n"
+            "restored), refreshes (defaults taken again after a change),\n"
+            "returned, evicted, pooled, live, items, max_idle, max_items,\n"
+            "enabled")
+
+        .def_static("reset_stats", []() { RenderOptionsPool::Instance().ResetStats(); },
+            "Reset counters (pooled handles are kept)")
+
+        .def_static("max_idle", []() { return RenderOptionsPool::Instance().GetMaxIdle(); },
+            "Get the number of handles kept per item")
+
+        .def_static("set_max_idle", [](size_t maxIdle) {
+            RenderOptionsPool::Instance().SetMaxIdle(maxIdle);
+        },
+            "Set the number of handles kept per item; excess handles are disposed",
+            py::arg("max_idle"))
+
+        .def_static("max_items", []() { return RenderOptionsPool::Instance().GetMaxOwners(); },
+            "Get the number of items kept in the pool")
+
+        .def_static("set_max_items", [](size_t maxItems) {
+            RenderOptionsPool::Instance().SetMaxOwners(maxItems);
+        },
+            "Set the number of items kept in the pool; least recently used items are dropped",
+            py::arg("max_items"))
+
+        .def_static("enabled", []() { return RenderOptionsPool::Instance().IsEnabled(); },
+            "Check whether released handles are pooled")
+
+        .def_static("set_enabled", [](bool enabled) {
+            RenderOptionsPool::Instance().SetEnabled(enabled);
+        },
+            "Enable or disable pooling. Disabling disposes all pooled handles",
+            py::arg("enabled"))
+
+        .def_static("clear", []() { RenderOptionsPool::Instance().Clear(); },
+            "Dispose all pooled handles and forget the item defaults");
+
     // FrameReceipt class
     py::class_<PyFrameReceipt, std::shared_ptr<PyFrameReceipt>>(m, "FrameReceipt",
         "Receipt for a rendered frame.\n\n"
@@ -998,8 +1232,14 @@ void init_render(py::module_& m)
         "    # Frame is automatically checked in after the with block\n")
         .def_property_readonly("valid", &PyFrameReceipt::IsValid,
             "Check if receipt is valid (not checked in)")
-        .def_property_readonly("world", &PyFrameReceipt::GetWorld,
-            "Get the rendered world (frame buffer). Read-only.")
+        // The world keeps the receipt from being collected; checkin() still
+        // invalidates it
+        .def_property_readonly("world",
+            py::cpp_function(&PyFrameReceipt::GetWorld, py::keep_alive<0, 1>()),
+            "Get the rendered world (frame buffer). Read-only.\n\n"
+            "The world and its memoryview / as_array() views point at memory\n"
+            "owned by AE. checkin() (or leaving the with block) invalidates the\n"
+            "world; copy the pixels first if they are needed afterwards.")
         .def_property_readonly("rendered_region", &PyFrameReceipt::GetRenderedRegion,
             "Get the rendered region as dict {left, top, right, bottom}")
         .def_property_readonly("guid", &PyFrameReceipt::GetGuid,
@@ -1026,7 +1266,8 @@ void init_render(py::module_& m)
         "    with ae.Renderer.render_frame(options) as receipt:\n"
         "        world = receipt.world\n"
         "        print(f'Rendered: {world.width}x{world.height}')\n")
-        .def_static("render_frame", &PyRenderer::RenderFrame,
+        .def_static("render_frame",
+            py::overload_cast<const std::shared_ptr<PyRenderOptions>&>(&PyRenderer::RenderFrame),
             py::arg("options"),
             "Render a frame using RenderOptions.\n\n"
             "Returns a FrameReceipt. Use as context manager for automatic cleanup.")
@@ -0,0 +1,369 @@
+// PyRenderCache.cpp
+// PyAE - Python for After Effects
+// レンダー結果のキャッシュ（RenderCache）のバインディング
+//
+// キーはアイテムとレンダー設定（時刻・ダウンサンプル・ROI・ワールドの種類・
+// 品質など）。レンダー直前の AEGP タイムスタンプを一緒に保存し、参照時に
+// AEGP_HasItemChangedSinceTimestamp で変更がないことを確かめてから返す。
+// 変更がなければ AE にレンダーさせず、保持している画素のコピーだけで済む。
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+
+#include "FrameCache.h"
+#include "PyRenderClasses.h"
+#include "PyWorldClasses.h"
+
+namespace py = pybind11;
+
+namespace PyAE {
+
+namespace {
+
+constexpr uint64_t kDefaultMaxMemoryBytes = uint64_t(1) << 30;     // 1 GiB
+constexpr uint64_t kDefaultMaxDiskBytes = uint64_t(4) << 30;       // 4 GiB
+
+WorldType WorldTypeOf(PixelConvert::Depth depth)
+{
+    switch (depth) {
+        case PixelConvert::Depth::U8: return WorldType::BIT8;
+        case PixelConvert::Depth::U16: return WorldType::BIT16;
+        case PixelConvert::Depth::F32: return WorldType::BIT32;
+    }
+    return WorldType::NONE;
+}
+
+FrameCache::Stamp ToStamp(const std::tuple<int, int, int, int>& timestamp)
+{
+    return {std::get<0>(timestamp), std::get<1>(timestamp),
+            std::get<2>(timestamp), std::get<3>(timestamp)};
+}
+
+std::tuple<int, int, int, int> FromStamp(const FrameCache::Stamp& stamp)
+{
+    return std::make_tuple(stamp[0], stamp[1], stamp[2], stamp[3]);
+}
+
+} // namespace
+
+// =============================================================
+// CachedFrame - キャッシュ済みの1フレーム（読み取り専用の画素）
+// =============================================================
+class CachedFrame {
+public:
+    CachedFrame(FrameCache::EntryPtr entry, bool hit) : m_entry(std::move(entry)), m_hit(hit) {}
+
+    int GetWidth() const { return m_entry->view.width; }
+    int GetHeight() const { return m_entry->view.height; }
+    WorldType GetWorldType() const { return WorldTypeOf(m_entry->view.depth); }
+    double GetTime() const { return static_cast<double>(m_entry->key.time) / 1e6; }
+    size_t GetByteCount() const { return m_entry->pixels.size(); }
+    bool IsHit() const { return m_hit; }
+    std::tuple<int, int, int, int> GetTimestamp() const { return FromStamp(m_entry->stamp); }
+
+    // 新しい World にコピーする
+    std::shared_ptr<PyWorld> ToWorld() const
+    {
+        const PixelConvert::ImageView& src = m_entry->view;
+        std::shared_ptr<PyWorld> world = PyWorld::Create(GetWorldType(), src.width, src.height, false);
+        PixelConvert::ImageView dst = world->GetImageView();
+        py::gil_scoped_release release;
+        PixelConvert::Convert(src, dst);
+        return world;
+    }
+
+    // (height, width, 4) の読み取り専用バッファ（ARGB、コピーしない）
+    py::buffer_info GetBufferInfo() const
+    {
+        const PixelConvert::ImageView& view = m_entry->view;
+        const py::ssize_t channelBytes = static_cast<py::ssize_t>(PixelConvert::ChannelBytes(view.depth));
+        std::string format;
+        switch (view.depth) {
+            case PixelConvert::Depth::U8: format = py::format_descriptor<uint8_t>::format(); break;
+            case PixelConvert::Depth::U16: format = py::format_descriptor<uint16_t>::format(); break;
+            case PixelConvert::Depth::F32: format = py::format_descriptor<float>::format(); break;
+        }
+        return py::buffer_info(
+            const_cast<uint8_t*>(m_entry->pixels.data()),
+            channelBytes,
+            format,
+            3,
+            { static_cast<py::ssize_t>(view.height), static_cast<py::ssize_t>(view.width), py::ssize_t(4) },
+            { static_cast<py::ssize_t>(view.rowBytes), channelBytes * 4, channelBytes },
+            true);
+    }
+
+private:
+    FrameCache::EntryPtr m_entry;   // 追い出されても画素は残る
+    bool m_hit;
+};
+
+// =============================================================
+// RenderCache - タイムスタンプで検証するフレームキャッシュ
+// =============================================================
+class RenderCache {
+public:
+    RenderCache(uint64_t maxMemoryBytes, const std::optional<std::string>& directory, uint64_t maxDiskBytes)
+        : m_cache(maxMemoryBytes, directory.value_or(std::string()), maxDiskBytes)
+    {
+    }
+
+    // キャッシュになければレンダーして保存する
+    std::shared_ptr<CachedFrame> Fetch(py::object item, std::optional<double> time,
+                                       std::shared_ptr<PyRenderOptions> options)
+    {
+        AEGP_ItemH itemH = PyRenderer::ResolveItem(item);
+        options = Prepare(itemH, time, options);
+        FrameCache::Key key = MakeKey(itemH, *options);
+
+        if (FrameCache::EntryPtr entry = Find(itemH, key, *options)) {
+            return std::make_shared<CachedFrame>(entry, true);
+        }
+
+        // 描画中の変更も検出できるようにレンダー前のタイムスタンプを使う
+        FrameCache::Stamp stamp = ToStamp(PyRenderer::GetCurrentTimestamp());
+        std::shared_ptr<PyFrameReceipt> receipt = PyRenderer::RenderFrame(options);
+        FrameCache::EntryPtr entry;
+        try {
+            PixelConvert::ImageView view = receipt->GetWorld()->GetImageView();
+            {
+                py::gil_scoped_release release;
+                entry = m_cache.Insert(key, stamp, view);
+            }
+            if (!entry) {
+                // メモリの上限より大きいフレームは保持せずに返す
+                auto single = std::make_shared<FrameCache::Entry>();
+                single->key = key;
+                single->stamp = stamp;
+                single->pixels.resize(static_cast<size_t>(view.width) * view.height * 4 *
+                                      PixelConvert::ChannelBytes(view.depth));
+                single->view = view;
+                single->view.data = single->pixels.data();
+                single->view.rowBytes = static_cast<ptrdiff_t>(view.width) * 4 *
+                    static_cast<ptrdiff_t>(PixelConvert::ChannelBytes(view.depth));
+                PixelConvert::Convert(view, single->view);
+                entry = single;
+            }
+        } catch (...) {
+            receipt->Checkin();
+            throw;
+        }
+        receipt->Checkin();
+        return std::make_shared<CachedFrame>(entry, false);
+    }
+
+    // キャッシュにあって変更されていなければ返す（レンダーしない）
+    std::shared_ptr<CachedFrame> Lookup(py::object item, std::optional<double> time,
+                                        std::shared_ptr<PyRenderOptions> options)
+    {
+        AEGP_ItemH itemH = PyRenderer::ResolveItem(item);
+        options = Prepare(itemH, time, options);
+        FrameCache::EntryPtr entry = Find(itemH, MakeKey(itemH, *options), *options);
+        return entry ? std::make_shared<CachedFrame>(entry, true) : nullptr;
+    }
+
+    size_t Invalidate(py::object item)
+    {
+        if (item.is_none()) {
+            return m_cache.Invalidate(0);
+        }
+        return m_cache.Invalidate(reinterpret_cast<uint64_t>(PyRenderer::ResolveItem(item)));
+    }
+
+    void Clear() { m_cache.Clear(); }
+
+    void SetLimits(uint64_t maxMemoryBytes, uint64_t maxDiskBytes)
+    {
+        m_cache.SetLimits(maxMemoryBytes, maxDiskBytes);
+    }
+
+    py::object GetDirectory() const
+    {
+        const std::string& directory = m_cache.GetDirectory();
+        return directory.empty() ? py::object(py::none()) : py::object(py::str(directory));
+    }
+
+    py::dict GetStats() const
+    {
+        FrameCache::Stats stats = m_cache.GetStats();
+        py::dict result;
+        result["hits"] = stats.hits;
+        result["disk_hits"] = stats.diskHits;
+        result["misses"] = stats.misses;
+        result["stale"] = stats.stale;
+        result["inserts"] = stats.inserts;
+        result["evictions"] = stats.evictions;
+        result["disk_writes"] = stats.diskWrites;
+        result["disk_evictions"] = stats.diskEvictions;
+        result["disk_errors"] = stats.diskErrors;
+        result["memory_entries"] = stats.memoryEntries;
+        result["memory_bytes"] = stats.memoryBytes;
+        result["disk_entries"] = stats.diskEntries;
+        result["disk_bytes"] = stats.diskBytes;
+        result["max_memory_bytes"] = stats.maxMemoryBytes;
+        result["max_disk_bytes"] = stats.maxDiskBytes;
+        uint64_t lookups = stats.hits + stats.diskHits + stats.misses;
+        result["hit_rate"] = lookups > 0
+            ? static_cast<double>(stats.hits + stats.diskHits) / static_cast<double>(lookups) : 0.0;
+        return result;
+    }
+
+private:
+    // options がなければアイテムのものをプールから取得する。time を指定したら options に設定する
+    static std::shared_ptr<PyRenderOptions> Prepare(AEGP_ItemH itemH, std::optional<double> time,
+                                                    std::shared_ptr<PyRenderOptions> options)
+    {
+        if (!options) {
+            options = PyRenderOptions::Acquire(reinterpret_cast<uintptr_t>(itemH));
+        }
+        if (time) {
+            options->SetTime(*time);
+        }
+        return options;
+    }
+
+    static FrameCache::Key MakeKey(AEGP_ItemH itemH, const PyRenderOptions& options)
+    {
+        FrameCache::Key key;
+        key.item = reinterpret_cast<uint64_t>(itemH);
+        key.time = std::llround(options.GetTime() * 1e6);
+        key.worldType = static_cast<int32_t>(options.GetWorldType());
+        key.quality = static_cast<int32_t>(options.GetRenderQuality());
+        auto downsample = options.GetDownsampleFactor();
+        key.downsampleX = std::get<0>(downsample);
+        key.downsampleY = std::get<1>(downsample);
+        py::dict roi = options.GetRegionOfInterest();
+        key.roi[0] = roi["left"].cast<int32_t>();
+        key.roi[1] = roi["top"].cast<int32_t>();
+        key.roi[2] = roi["right"].cast<int32_t>();
+        key.roi[3] = roi["bottom"].cast<int32_t>();
+        key.field = static_cast<int32_t>(options.GetFieldRender());
+        key.matteMode = static_cast<int32_t>(options.GetMatteMode());
+        key.channelOrder = static_cast<int32_t>(options.GetChannelOrder());
+        key.guideLayers = options.GetRenderGuideLayers() ? 1 : 0;
+        return key;
+    }
+
+    FrameCache::EntryPtr Find(AEGP_ItemH itemH, const FrameCache::Key& key,
+                              const PyRenderOptions& options)
+    {
+        const double time = options.GetTime();
+        const double duration = (std::max)(options.GetTimeStep(), 0.0);
+        return m_cache.Find(key, [&](const FrameCache::Entry& entry) {
+            return !PyRenderer::HasItemChangedSinceTimestamp(
+                reinterpret_cast<uintptr_t>(itemH), time, duration, FromStamp(entry.stamp));
+        });
+    }
+
+    FrameCache m_cache;
+};
+
+void init_render_cache(py::module_& m)
+{
+    py::class_<CachedFrame, std::shared_ptr<CachedFrame>>(m, "CachedFrame", py::buffer_protocol(),
+        "Pixels of a frame held by a RenderCache (read-only).\n\n"
+        "Supports the buffer protocol without copying: numpy.asarray(frame)\n"
+        "gives a (height, width, 4) ARGB array. to_world() copies the\n"
+        "pixels into a new World.")
+        .def_buffer([](CachedFrame& self) -> py::buffer_info {
+            return self.GetBufferInfo();
+        })
+        .def_property_readonly("width", &CachedFrame::GetWidth)
+        .def_property_readonly("height", &CachedFrame::GetHeight)
+        .def_property_readonly("world_type", &CachedFrame::GetWorldType)
+        .def_property_readonly("time", &CachedFrame::GetTime,
+            "Time of the frame in seconds")
+        .def_property_readonly("nbytes", &CachedFrame::GetByteCount,
+            "Size of the pixel data in bytes")
+        .def_property_readonly("hit", &CachedFrame::IsHit,
+            "True if the frame came from the cache, False if it was rendered")
+        .def_property_readonly("timestamp", &CachedFrame::GetTimestamp,
+            "Project timestamp taken before the frame was rendered")
+        .def("to_world", &CachedFrame::ToWorld,
+            "Copy the pixels into a new World.\n\n"
+            "Returns:\n"
+            "    World: Owned world of the same size and bit depth");
+
+    py::class_<RenderCache, std::shared_ptr<RenderCache>>(m, "RenderCache",
+        "Frame cache validated with project timestamps.\n\n"
+        "Frames are keyed by item, time and render options (world type,\n"
+        "downsample factor, region of interest, quality, field, matte mode,\n"
+        "channel order, guide layers). Each frame keeps the project\n"
+        "timestamp taken before it was rendered; a cached frame is returned\n"
+        "only if HasItemChangedSinceTimestamp reports no change, otherwise it\n"
+        "is dropped and rendered again.\n\n"
+        "Frames are held in memory up to max_memory_bytes (least recently\n"
+        "used first out). If directory is given, frames pushed out of memory\n"
+        "are written there and read back on demand, up to max_disk_bytes.\n"
+        "Timestamps are only valid within one session, so each cache writes\n"
+        "into its own new subdirectory of directory and removes only that\n"
+        "subdirectory when it is destroyed; other files are left alone.\n\n"
+        "Example:\n"
+        "    cache = ae.RenderCache(max_memory_bytes=512 * 1024 * 1024)\n"
+        "    world = cache.render(comp, 1.0)     # renders\n"
+        "    world = cache.render(comp, 1.0)     # memory copy\n"
+        "    pixels = numpy.asarray(cache.fetch(comp, 1.0))")
+        .def(py::init([](uint64_t maxMemoryBytes, std::optional<std::string> directory,
+                         uint64_t maxDiskBytes) {
+            return std::make_shared<RenderCache>(maxMemoryBytes, directory, maxDiskBytes);
+        }),
+            "Args:\n"
+            "    max_memory_bytes: Memory budget for cached frames (default 1 GiB)\n"
+            "    directory: Directory for frames pushed out of memory (default: none)\n"
+            "    max_disk_bytes: Disk budget in directory (default 4 GiB)",
+            py::arg("max_memory_bytes") = kDefaultMaxMemoryBytes,
+            py::arg("directory") = py::none(),
+            py::arg("max_disk_bytes") = kDefaultMaxDiskBytes)
+
+        .def("fetch", &RenderCache::Fetch,
+            "Return the cached frame, rendering it if missing or changed.\n\n"
+            "Args:\n"
+            "    item: Comp, CompItem, Item or item handle\n"
+            "    time: Time in seconds (default: the time of options)\n"
+            "    options: RenderOptions for item (default: from the item).\n"
+            "             If time is given it is set on options.\n\n"
+            "Returns:\n"
+            "    CachedFrame: Read-only pixels (buffer protocol)",
+            py::arg("item"), py::arg("time") = py::none(), py::arg("options") = py::none())
+
+        .def("render", [](RenderCache& self, py::object item, std::optional<double> time,
+                          std::shared_ptr<PyRenderOptions> options) {
+            return self.Fetch(item, time, options)->ToWorld();
+        },
+            "Like fetch(), but return a new World with a copy of the pixels.",
+            py::arg("item"), py::arg("time") = py::none(), py::arg("options") = py::none())
+
+        .def("lookup", &RenderCache::Lookup,
+            "Return the cached frame if present and unchanged, without rendering.\n\n"
+            "Returns:\n"
+            "    CachedFrame or None",
+            py::arg("item"), py::arg("time") = py::none(), py::arg("options") = py::none())
+
+        .def("invalidate", &RenderCache::Invalidate,
+            "Drop the frames of item (all frames if None).\n\n"
+            "Returns:\n"
+            "    int: Number of frames dropped",
+            py::arg("item") = py::none())
+
+        .def("clear", &RenderCache::Clear, "Drop all frames")
+
+        .def("set_limits", &RenderCache::SetLimits,
+            "Change the memory and disk budgets and evict frames over them.",
+            py::arg("max_memory_bytes"), py::arg("max_disk_bytes") = kDefaultMaxDiskBytes)
+
+        .def_property_readonly("directory", &RenderCache::GetDirectory,
+            "Directory for frames pushed out of memory, or None")
+        .def_property_readonly("stats", &RenderCache::GetStats,
+            "dict: hits, disk_hits, misses, stale, hit_rate, inserts, evictions,\n"
+            "disk_writes, disk_evictions, disk_errors, memory_entries,\n"
+            "memory_bytes, disk_entries, disk_bytes, max_memory_bytes, max_disk_bytes");
+}
+
+} // namespace PyAE
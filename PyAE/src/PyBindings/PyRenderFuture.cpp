@@ -0,0 +1,480 @@
+// PyRenderFuture.cpp
+// PyAE - Python for After Effects
+// 非同期フレームレンダー（render_frame_async / RenderFuture）のバインディング
+//
+// AEGP_RenderAndCheckoutFrame はメインスレッド専用で完了まで戻らないため、
+// 要求は RenderRequestQueue に積んで呼び出し元へすぐ RenderFuture を返す。
+// アイドル処理で1回に1件ずつ描画し、AE のキャンセル関数から要求の
+// 取り消しトークンを見る。完了の通知（コールバック・await）もアイドル処理で行う。
+// 完了した future のレシートは release() か、同じグループの次のフレームの通知
+// （result() / await で受け取られていなければ）でチェックインする。
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "IdleHandler.h"
+#include "Logger.h"
+#include "PythonHost.h"
+#include "RenderRequestQueue.h"
+#include "PyRenderClasses.h"
+
+namespace py = pybind11;
+
+namespace PyAE {
+
+namespace {
+
+std::thread::id g_mainThread;
+
+// timeout（秒、None は無制限）をミリ秒に
+int TimeoutMs(const std::optional<double>& timeout)
+{
+    if (!timeout) {
+        return -1;
+    }
+    return static_cast<int>((std::min)((std::max)(*timeout, 0.0) * 1000.0, 2147483647.0));
+}
+
+[[noreturn]] void RaisePython(PyObject* type, const std::string& message)
+{
+    PyErr_SetString(type, message.c_str());
+    throw py::error_already_set();
+}
+
+} // namespace
+
+// =============================================================
+// RenderFuture - 1件の非同期レンダー要求
+// =============================================================
+class RenderFuture : public RenderRequestQueue::Request {
+public:
+    RenderFuture(std::shared_ptr<PyRenderOptions> options, std::string group, double timeoutSeconds)
+        : RenderRequestQueue::Request(std::move(group), timeoutSeconds)
+        , m_options(std::move(options))
+        , m_time(m_options->GetTime())
+    {
+    }
+
+    const std::shared_ptr<PyRenderOptions>& GetOptions() const { return m_options; }
+    double GetTime() const { return m_time; }
+
+    // 以下はメインスレッドで描画を終えたときのみ書き換える（完了前は読まない）
+    std::shared_ptr<PyFrameReceipt> receipt;
+
+    // GIL を保持して触る
+    std::vector<py::object> callbacks;
+    bool delivered = false;
+    bool consumed = false;          // result() / await でレシートを渡した
+    std::string released;           // レシートをチェックインした理由（空なら保持中）
+
+private:
+    std::shared_ptr<PyRenderOptions> m_options;     // 積んだ時点の複製
+    double m_time;
+};
+
+// =============================================================
+// AsyncFrameRenderer - 要求の待ち行列とアイドル処理
+// =============================================================
+class AsyncFrameRenderer {
+public:
+    static AsyncFrameRenderer& Instance() {
+        static AsyncFrameRenderer instance;
+        return instance;
+    }
+
+    RenderRequestQueue& Queue() { return m_queue; }
+
+    std::shared_ptr<RenderFuture> Submit(const std::shared_ptr<PyRenderOptions>& options,
+                                         const std::string& group, double timeoutSeconds,
+                                         py::object callback)
+    {
+        auto future = std::make_shared<RenderFuture>(options, group, timeoutSeconds);
+        if (!callback.is_none()) {
+            future->callbacks.push_back(std::move(callback));
+        }
+        m_queue.Submit(future);
+        return future;
+    }
+
+    // 描画を1件進め、終わった要求を通知する（アイドル処理から GIL なしで呼ぶ）
+    void Pump() {
+        if (auto request = m_queue.Next()) {
+            RenderOne(std::static_pointer_cast<RenderFuture>(request));
+        }
+        Deliver();
+        m_queue.EndPump();
+    }
+
+    // メインスレッドで future が終わるまで待ち行列を進める（コールバックは呼ばない）
+    void Drive(const std::shared_ptr<RenderFuture>& future) {
+        py::gil_scoped_release release;
+        while (!m_queue.Wait(future, 0)) {
+            auto request = m_queue.Next();
+            if (!request) {
+                break;
+            }
+            RenderOne(std::static_pointer_cast<RenderFuture>(request));
+        }
+    }
+
+    // 保持しているレシートをチェックインする（メインスレッドで GIL を保持して呼ぶ）。
+    // 渡したレシートとそのワールドも無効になる
+    static bool ReleaseReceipt(const std::shared_ptr<RenderFuture>& future, const std::string& reason) {
+        if (!future->receipt) {
+            return false;
+        }
+        std::shared_ptr<PyFrameReceipt> receipt = std::move(future->receipt);
+        future->receipt.reset();
+        future->released = reason;
+        receipt->Checkin();
+        return true;
+    }
+
+    // 終わっていればすぐ、まだならアイドル処理で呼ぶ（GIL を保持して呼ぶ）
+    void AddDoneCallback(const std::shared_ptr<RenderFuture>& future, py::object callback) {
+        if (future->delivered) {
+            Invoke(future, callback);
+            return;
+        }
+        future->callbacks.push_back(std::move(callback));
+    }
+
+private:
+    AsyncFrameRenderer() {
+        m_queue.SetWakeup([]() {
+            IdleHandler::Instance().EnqueueTask([]() {
+                AsyncFrameRenderer::Instance().Pump();
+            }, TaskPriority::Normal, "ae.render_frame_async");
+        });
+    }
+
+    void RenderOne(const std::shared_ptr<RenderFuture>& future) {
+        std::shared_ptr<PyFrameReceipt> receipt;
+        RenderRequestQueue::State state = RenderRequestQueue::State::Done;
+        std::string error;
+        try {
+            receipt = PyRenderer::RenderFrame(future->GetOptions(), [future]() {
+                return future->ShouldStop();
+            });
+            if (!receipt) {
+                state = RenderRequestQueue::State::Failed;
+                error = "Render was aborted";
+            }
+        } catch (const std::exception& e) {
+            state = RenderRequestQueue::State::Failed;
+            error = e.what();
+        }
+
+        // 完了として公開する前にレシートを置く（Finish のロックで公開される）
+        future->receipt = receipt;
+        m_queue.Finish(future, state, error);
+        if (receipt && m_queue.GetState(future) != RenderRequestQueue::State::Done) {
+            // 描画中に取り消された: 誰にも渡さずに返す
+            future->receipt.reset();
+            receipt->Checkin();
+        }
+    }
+
+    void Deliver() {
+        std::vector<RenderRequestQueue::RequestPtr> finished = m_queue.TakeFinished();
+        if (finished.empty()) {
+            return;
+        }
+
+        ScopedGIL gil;
+        for (const auto& request : finished) {
+            auto future = std::static_pointer_cast<RenderFuture>(request);
+            if (!future->GetGroup().empty() &&
+                m_queue.GetState(future) == RenderRequestQueue::State::Done) {
+                // 同じグループの前のフレームは、受け取られていなければここで返す
+                std::weak_ptr<RenderFuture>& last = m_lastDone[future->GetGroup()];
+                if (auto previous = last.lock()) {
+                    if (!previous->consumed) {
+                        ReleaseReceipt(previous, "The frame was replaced by a newer frame of its group");
+                    }
+                }
+                last = future;
+            }
+            std::vector<py::object> callbacks;
+            callbacks.swap(future->callbacks);
+            future->delivered = true;
+            for (const auto& callback : callbacks) {
+                Invoke(future, callback);
+            }
+        }
+    }
+
+    static void Invoke(const std::shared_ptr<RenderFuture>& future, const py::object& callback) {
+        try {
+            callback(future);
+        } catch (const py::error_already_set& e) {
+            PYAE_LOG_ERROR("RenderFuture", std::string("Python callback error: ") + e.what());
+        } catch (const std::exception& e) {
+            PYAE_LOG_ERROR("RenderFuture", std::string("Callback error: ") + e.what());
+        }
+    }
+
+    RenderRequestQueue m_queue;
+    // グループごとに最後に通知した完了済みの要求（Deliver で GIL を保持して触る）
+    std::map<std::string, std::weak_ptr<RenderFuture>> m_lastDone;
+};
+
+namespace {
+
+std::shared_ptr<PyFrameReceipt> Result(const std::shared_ptr<RenderFuture>& future,
+                                       std::optional<double> timeout)
+{
+    auto& renderer = AsyncFrameRenderer::Instance();
+    auto& queue = renderer.Queue();
+
+    // メインスレッドで待つとアイドル処理が回らないので、ここで描画する
+    if (std::this_thread::get_id() == g_mainThread) {
+        renderer.Drive(future);
+    }
+
+    bool done;
+    {
+        py::gil_scoped_release release;
+        done = queue.Wait(future, TimeoutMs(timeout));
+    }
+    if (!done) {
+        RaisePython(PyExc_TimeoutError, "Timed out waiting for the frame");
+    }
+
+    switch (queue.GetState(future)) {
+        case RenderRequestQueue::State::Done:
+            if (!future->receipt) {
+                throw std::runtime_error(future->released);
+            }
+            future->consumed = true;
+            return future->receipt;
+        case RenderRequestQueue::State::Cancelled: {
+            std::string error = queue.GetError(future);
+            py::object cancelledError = py::module_::import("concurrent.futures").attr("CancelledError");
+            RaisePython(cancelledError.ptr(), error.empty() ? "Render was cancelled" : error);
+        }
+        default:
+            throw std::runtime_error(queue.GetError(future));
+    }
+}
+
+// asyncio の Future に結果を移す（イベントループのスレッドで呼ばれる）
+void Settle(py::object asyncFuture, const std::shared_ptr<RenderFuture>& future)
+{
+    if (asyncFuture.attr("done")().cast<bool>()) {
+        return;
+    }
+    auto& queue = AsyncFrameRenderer::Instance().Queue();
+    switch (queue.GetState(future)) {
+        case RenderRequestQueue::State::Done:
+            if (!future->receipt) {
+                py::object error = py::reinterpret_borrow<py::object>(PyExc_RuntimeError)(future->released);
+                asyncFuture.attr("set_exception")(error);
+                break;
+            }
+            future->consumed = true;
+            asyncFuture.attr("set_result")(future->receipt);
+            break;
+        case RenderRequestQueue::State::Cancelled:
+            asyncFuture.attr("cancel")();
+            break;
+        default: {
+            py::object error = py::reinterpret_borrow<py::object>(PyExc_RuntimeError)(queue.GetError(future));
+            asyncFuture.attr("set_exception")(error);
+            break;
+        }
+    }
+}
+
+py::object Await(const std::shared_ptr<RenderFuture>& future)
+{
+    py::object loop = py::module_::import("asyncio").attr("get_running_loop")();
+    py::object asyncFuture = loop.attr("create_future")();
+
+    // asyncio 側で取り消されたらレンダーも取り消す
+    asyncFuture.attr("add_done_callback")(py::cpp_function([future](py::object f) {
+        if (f.attr("cancelled")().cast<bool>()) {
+            AsyncFrameRenderer::Instance().Queue().Cancel(future);
+        }
+    }));
+
+    py::function settle = py::cpp_function(&Settle);
+    AsyncFrameRenderer::Instance().AddDoneCallback(future, py::cpp_function(
+        [loop, asyncFuture, settle](std::shared_ptr<RenderFuture> self) {
+            loop.attr("call_soon_threadsafe")(settle, asyncFuture, self);
+        }));
+    return asyncFuture.attr("__await__")();
+}
+
+std::shared_ptr<RenderFuture> RenderFrameAsync(py::object source, std::optional<double> time,
+                                               std::optional<std::string> group,
+                                               std::optional<double> timeout, py::object callback)
+{
+    // future が専有する options を用意する。呼び出し元の options は変えないよう
+    // 複製し、アイテムならプールから取得する（完了後に返却される）
+    std::shared_ptr<PyRenderOptions> options;
+    if (py::isinstance<PyRenderOptions>(source)) {
+        options = source.cast<std::shared_ptr<PyRenderOptions>>()->Duplicate();
+    } else {
+        options = PyRenderOptions::Acquire(reinterpret_cast<uintptr_t>(PyRenderer::ResolveItem(source)));
+    }
+    if (time) {
+        options->SetTime(*time);
+    }
+    if (!callback.is_none() && !PyCallable_Check(callback.ptr())) {
+        throw std::invalid_argument("callback must be callable");
+    }
+    return AsyncFrameRenderer::Instance().Submit(options, group.value_or(std::string()),
+                                                 timeout.value_or(0.0), callback);
+}
+
+} // namespace
+
+void init_render_future(py::module_& m)
+{
+    g_mainThread = std::this_thread::get_id();
+
+    py::class_<RenderFuture, std::shared_ptr<RenderFuture>>(m, "RenderFuture",
+        "Pending result of render_frame_async().\n\n"
+        "The frame is rendered on the main thread from the idle hook, one\n"
+        "request per idle call. cancel() aborts a pending request at once and\n"
+        "a running one through AE's render cancel callback. Done callbacks\n"
+        "run from the idle hook. The future can also be awaited from an\n"
+        "asyncio event loop (await future -> FrameReceipt).\n\n"
+        "A finished future holds its frame until release() is called or the\n"
+        "future is destroyed. In a group, a frame nobody took with result()\n"
+        "or await is checked in when the group's next frame is delivered.")
+        .def_property_readonly("id", &RenderFuture::GetId)
+        .def_property_readonly("group", [](const RenderFuture& self) -> py::object {
+            return self.GetGroup().empty() ? py::object(py::none()) : py::object(py::str(self.GetGroup()));
+        }, "Group name, or None")
+        .def_property_readonly("time", &RenderFuture::GetTime,
+            "Time of the requested frame in seconds")
+        .def_property_readonly("state", [](std::shared_ptr<RenderFuture> self) {
+            return RenderRequestQueue::StateName(AsyncFrameRenderer::Instance().Queue().GetState(self));
+        }, "'pending', 'rendering', 'done', 'cancelled' or 'failed'")
+        .def_property_readonly("wait_seconds", [](std::shared_ptr<RenderFuture> self) {
+            return AsyncFrameRenderer::Instance().Queue().GetWaitSeconds(self);
+        }, "Seconds from submission until rendering started")
+        .def_property_readonly("render_seconds", [](std::shared_ptr<RenderFuture> self) {
+            return AsyncFrameRenderer::Instance().Queue().GetRenderSeconds(self);
+        }, "Seconds spent rendering")
+        .def("done", [](std::shared_ptr<RenderFuture> self) {
+            auto state = AsyncFrameRenderer::Instance().Queue().GetState(self);
+            return state != RenderRequestQueue::State::Pending &&
+                   state != RenderRequestQueue::State::Rendering;
+        }, "Return True once the frame is rendered, cancelled or failed.")
+        .def("running", [](std::shared_ptr<RenderFuture> self) {
+            return AsyncFrameRenderer::Instance().Queue().GetState(self) ==
+                   RenderRequestQueue::State::Rendering;
+        })
+        .def("cancelled", [](std::shared_ptr<RenderFuture> self) {
+            return AsyncFrameRenderer::Instance().Queue().GetState(self) ==
+                   RenderRequestQueue::State::Cancelled;
+        })
+        .def("cancel", [](std::shared_ptr<RenderFuture> self) {
+            return AsyncFrameRenderer::Instance().Queue().Cancel(self);
+        },
+            "Cancel the request.\n\n"
+            "A pending request is cancelled at once. A running render is\n"
+            "aborted by AE's cancel callback (any thread may call this).\n\n"
+            "Returns:\n"
+            "    False if the request had already finished")
+        .def("result", &Result,
+            "Return the FrameReceipt, waiting for the render.\n\n"
+            "On the main thread the queue is rendered right here up to this\n"
+            "request. Check in the receipt (or call release()) when done\n"
+            "with it.\n\n"
+            "Raises:\n"
+            "    concurrent.futures.CancelledError: If cancelled or superseded\n"
+            "    RuntimeError: If the render failed or the frame was released\n"
+            "    TimeoutError: If not finished within timeout seconds",
+            py::arg("timeout") = py::none())
+        .def("release", [](std::shared_ptr<RenderFuture> self) {
+            if (std::this_thread::get_id() != g_mainThread) {
+                throw std::runtime_error("RenderFuture.release() must be called on the main thread");
+            }
+            return AsyncFrameRenderer::ReleaseReceipt(self, "The frame was released");
+        },
+            "Check in the rendered frame held by this future.\n\n"
+            "The receipt returned by result() and its worlds become invalid,\n"
+            "and result() raises RuntimeError afterwards. Call from the main\n"
+            "thread.\n\n"
+            "Returns:\n"
+            "    False if the future holds no frame (unfinished, failed,\n"
+            "    cancelled or already released)")
+        .def("add_done_callback", [](std::shared_ptr<RenderFuture> self, py::object callback) {
+            AsyncFrameRenderer::Instance().AddDoneCallback(self, callback);
+        },
+            "Call callback(future) from the idle hook once finished\n"
+            "(immediately if already delivered).",
+            py::arg("callback"))
+        .def("__await__", &Await)
+        .def("__repr__", [](std::shared_ptr<RenderFuture> self) {
+            return "<RenderFuture id=" + std::to_string(self->GetId()) + " time=" +
+                   std::to_string(self->GetTime()) + " state='" +
+                   RenderRequestQueue::StateName(AsyncFrameRenderer::Instance().Queue().GetState(self)) + "'>";
+        });
+
+    m.def("render_frame_async", &RenderFrameAsync,
+        "Queue a frame render and return a RenderFuture right away.\n\n"
+        "Frames render on the main thread from the idle hook, in order.\n"
+        "A new request with the same group supersedes the group's unfinished\n"
+        "ones: pending requests are dropped and a running render is aborted\n"
+        "(e.g. group='viewer' while scrubbing).\n\n"
+        "Args:\n"
+        "    source: RenderOptions, or Comp / CompItem / Item / item handle\n"
+        "    time: Time in seconds (default: the time of the options)\n"
+        "    group: Supersede unfinished requests of this group (default: none)\n"
+        "    timeout: Cancel if not finished within this many seconds\n"
+        "    callback: Optional callable(future) called from the idle hook\n\n"
+        "Returns:\n"
+        "    RenderFuture\n\n"
+        "Example:\n"
+        "    def show(future):\n"
+        "        if not future.cancelled():\n"
+        "            with future.result() as receipt:\n"
+        "                update_preview(receipt.world)\n\n"
+        "    ae.render_frame_async(comp, t, group='viewer', callback=show)",
+        py::arg("source"),
+        py::arg("time") = py::none(),
+        py::arg("group") = py::none(),
+        py::arg("timeout") = py::none(),
+        py::arg("callback") = py::none());
+
+    m.def("cancel_async_renders", [](std::optional<std::string> group) {
+        return AsyncFrameRenderer::Instance().Queue().CancelGroup(group.value_or(std::string()));
+    },
+        "Cancel the unfinished requests of group (all if None).\n\n"
+        "Returns:\n"
+        "    int: Number of requests cancelled",
+        py::arg("group") = py::none());
+
+    m.def("get_async_render_stats", []() {
+        RenderRequestQueue::Stats stats = AsyncFrameRenderer::Instance().Queue().GetStats();
+        py::dict result;
+        result["submitted"] = stats.submitted;
+        result["completed"] = stats.completed;
+        result["failed"] = stats.failed;
+        result["cancelled"] = stats.cancelled;
+        result["superseded"] = stats.superseded;
+        result["expired"] = stats.expired;
+        result["aborted"] = stats.aborted;
+        result["pending"] = stats.pending;
+        result["rendering"] = stats.rendering;
+        return result;
+    },
+        "Counters of render_frame_async requests.\n\n"
+        "aborted counts renders stopped by the cancel callback; they are\n"
+        "also counted as cancelled, superseded or expired.");
+}
+
+} // namespace PyAE
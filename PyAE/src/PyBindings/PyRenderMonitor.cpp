@@ -6,20 +6,149 @@
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
 
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <psapi.h>
+#endif
+
 #include "PluginState.h"
+#include "IdleHandler.h"
+#include "PythonHost.h"
+#include "RenderEventQueue.h"
+#include "RenderStats.h"
 #include "ScopedHandles.h"
 #include "StringUtils.h"
 #include "Logger.h"
 
-#include <mutex>
-#include <optional>
-
 namespace py = pybind11;
 
 namespace PyAE {
 
+namespace {
+
+// Working set and private bytes of the AE process
+RenderStats::MemorySample SampleProcessMemory() {
+    RenderStats::MemorySample sample;
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS_EX counters = {};
+    counters.cb = sizeof(counters);
+    if (GetProcessMemoryInfo(GetCurrentProcess(),
+                             reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters),
+                             sizeof(counters))) {
+        sample.workingSet = static_cast<uint64_t>(counters.WorkingSetSize);
+        sample.privateBytes = static_cast<uint64_t>(counters.PrivateUsage);
+    }
+#endif
+    return sample;
+}
+
+// Columnar results are array.array objects: no NumPy needed, and
+// numpy.asarray() / memoryview() use them without copying
+template <typename T>
+py::object MakeArray(const char* typecode, const std::vector<T>& values) {
+    py::object array = py::module_::import("array").attr("array")(typecode);
+    if (!values.empty()) {
+        array.attr("frombytes")(py::bytes(reinterpret_cast<const char*>(values.data()),
+                                          values.size() * sizeof(T)));
+    }
+    return array;
+}
+
+// Frame records as columns (session_id, item_id, frame_id, time, duration)
+py::dict FramesToColumns(const std::vector<RenderStats::FrameRecord>& frames,
+                         const std::vector<std::pair<uint64_t, uint64_t>>& keys) {
+    std::vector<uint64_t> sessions, items, frameIds;
+    std::vector<double> times, durations;
+    sessions.reserve(frames.size());
+    items.reserve(frames.size());
+    frameIds.reserve(frames.size());
+    times.reserve(frames.size());
+    durations.reserve(frames.size());
+    for (const auto& frame : frames) {
+        const auto& key = frame.item < keys.size() ? keys[frame.item] : std::pair<uint64_t, uint64_t>();
+        sessions.push_back(key.first);
+        items.push_back(key.second);
+        frameIds.push_back(frame.frameId);
+        times.push_back(frame.time);
+        durations.push_back(frame.duration);
+    }
+    py::dict d;
+    d["session_id"] = MakeArray("Q", sessions);
+    d["item_id"] = MakeArray("Q", items);
+    d["frame_id"] = MakeArray("Q", frameIds);
+    d["time"] = MakeArray("d", times);
+    d["duration"] = MakeArray("d", durations);
+    return d;
+}
+
+RenderStats::Table ParseStatsTable(const std::string& table) {
+    if (table == "jobs") return RenderStats::Table::Jobs;
+    if (table == "items") return RenderStats::Table::Items;
+    if (table == "frames") return RenderStats::Table::Frames;
+    if (table == "memory") return RenderStats::Table::Memory;
+    throw std::invalid_argument("table must be 'jobs', 'items', 'frames' or 'memory': " + table);
+}
+
+// "json" or "csv"; inferred from the file extension when not given
+std::string ResolveStatsFormat(const std::optional<std::string>& format, const std::string& path) {
+    std::string result = format.value_or("");
+    if (result.empty()) {
+        size_t dot = path.find_last_of('.');
+        std::string ext = dot == std::string::npos ? "" : path.substr(dot + 1);
+        result = (ext == "csv" || ext == "CSV") ? "csv" : "json";
+    }
+    if (result != "json" && result != "csv") {
+        throw std::invalid_argument("format must be 'json' or 'csv': " + result);
+    }
+    return result;
+}
+
+std::string BuildStatsReport(const RenderStats::Collector& stats, const std::string& format,
+                             const std::string& table, int indent) {
+    if (format == "csv") {
+        return stats.ToCsv(ParseStatsTable(table));
+    }
+    return stats.ToJson(indent);
+}
+
+void WriteStatsReport(const RenderStats::Collector& stats, const std::string& path,
+                      const std::string& format, const std::string& table, int indent) {
+    std::string report = BuildStatsReport(stats, format, table, indent);
+    std::ofstream file(std::filesystem::path(StringUtils::Utf8ToWide(path)),
+                       std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Failed to open file for writing: " + path);
+    }
+    file.write(report.data(), static_cast<std::streamsize>(report.size()));
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write file: " + path);
+    }
+}
+
+} // namespace
+
 // =============================================================
 // RenderMonitorListener - Manages Python callbacks
+//
+// AE calls the RQM callbacks from inside the render loop, so they only
+// push a compact record into RenderEvents::Queue (no lock, no GIL).
+// The first record of a batch schedules DeliverPending on the idle hook,
+// which coalesces frame updates per item, applies the update-rate limit
+// and then calls the Python callbacks.
+//
+// While collecting, the callbacks also record every event into
+// RenderStats::Collector before any coalescing, so per-frame times are
+// exact regardless of max_update_rate.
 // =============================================================
 class RenderMonitorListener {
 public:
@@ -30,6 +159,7 @@ public:
     using ItemUpdatedCallback = std::function<void(uint64_t sessionId, uint64_t itemId, uint64_t frameId)>;
     using ItemEndedCallback = std::function<void(uint64_t sessionId, uint64_t itemId, int finishedStatus)>;
     using ReportLogCallback = std::function<void(uint64_t sessionId, uint64_t itemId, bool isError, const std::string& message)>;
+    using EventsCallback = std::function<void(py::list events)>;
 
     static RenderMonitorListener& Instance() {
         static RenderMonitorListener instance;
@@ -67,6 +197,158 @@ public:
         m_onReportLog = std::move(cb);
     }
 
+    void SetEventsCallback(std::optional<EventsCallback> cb) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_onEvents = std::move(cb);
+    }
+
+    RenderEvents::Queue& GetQueue() { return m_queue; }
+    RenderStats::Collector& GetStats() { return m_stats; }
+
+    // Start recording statistics (registers the listener if needed).
+    // reportPath: written after each job ends (empty: no report)
+    bool StartCollecting(double memoryInterval, size_t maxFrames, bool clear,
+                         const std::string& reportPath) {
+        m_stats.SetMemorySampler(&SampleProcessMemory, memoryInterval);
+        m_stats.SetMaxFrames(maxFrames);
+        if (clear) {
+            m_stats.Clear(RenderEvents::Queue::Now());
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_reportPath = reportPath;
+        }
+        m_collecting.store(true);
+        return RegisterListener();
+    }
+
+    void StopCollecting() {
+        m_collecting.store(false);
+    }
+
+    bool IsCollecting() const { return m_collecting.load(); }
+
+    std::string GetReportPath() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_reportPath;
+    }
+
+    // Deliver the queued events to the Python callbacks (main thread).
+    // flushHeld also delivers frame updates held back by the rate limit.
+    // Returns the number of events delivered
+    size_t DeliverPending(bool flushHeld) {
+        std::vector<RenderEvents::Event> batch =
+            m_queue.Drain(RenderEvents::Queue::Now(), flushHeld);
+        if (m_queue.NextHeldDue() > 0.0) {
+            ScheduleHeldDrain();
+        }
+        if (batch.empty()) {
+            return 0;
+        }
+
+        ScopedGIL gil;
+
+        // Python runs without m_mutex so a callback may replace the callbacks
+        std::optional<JobStartedCallback> onJobStarted;
+        std::optional<JobEndedCallback> onJobEnded;
+        std::optional<ItemStartedCallback> onItemStarted;
+        std::optional<ItemUpdatedCallback> onItemUpdated;
+        std::optional<ItemEndedCallback> onItemEnded;
+        std::optional<ReportLogCallback> onReportLog;
+        std::optional<EventsCallback> onEvents;
+        std::string reportPath;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            reportPath = m_reportPath;
+            onJobStarted = m_onJobStarted;
+            onJobEnded = m_onJobEnded;
+            onItemStarted = m_onItemStarted;
+            onItemUpdated = m_onItemUpdated;
+            onItemEnded = m_onItemEnded;
+            onReportLog = m_onReportLog;
+            onEvents = m_onEvents;
+        }
+
+        if (onEvents) {
+            Invoke("Events", [&]() {
+                py::list events;
+                for (const auto& event : batch) {
+                    events.append(EventToDict(event));
+                }
+                (*onEvents)(events);
+            });
+        }
+
+        for (const auto& event : batch) {
+            switch (event.type) {
+                case RenderEvents::Type::JobStarted:
+                    if (onJobStarted) {
+                        Invoke("JobStarted", [&]() { (*onJobStarted)(event.session); });
+                    }
+                    break;
+                case RenderEvents::Type::JobEnded:
+                    if (!reportPath.empty()) {
+                        WriteJobReport(reportPath);
+                    }
+                    if (onJobEnded) {
+                        Invoke("JobEnded", [&]() { (*onJobEnded)(event.session); });
+                    }
+                    break;
+                case RenderEvents::Type::ItemStarted:
+                    if (onItemStarted) {
+                        Invoke("ItemStarted", [&]() { (*onItemStarted)(event.session, event.item); });
+                    }
+                    break;
+                case RenderEvents::Type::ItemUpdated:
+                    if (onItemUpdated) {
+                        Invoke("ItemUpdated", [&]() {
+                            (*onItemUpdated)(event.session, event.item, event.value);
+                        });
+                    }
+                    break;
+                case RenderEvents::Type::ItemEnded:
+                    if (onItemEnded) {
+                        Invoke("ItemEnded", [&]() {
+                            (*onItemEnded)(event.session, event.item, static_cast<int>(event.value));
+                        });
+                    }
+                    break;
+                case RenderEvents::Type::ReportLog:
+                    if (onReportLog) {
+                        Invoke("ReportLog", [&]() {
+                            (*onReportLog)(event.session, event.item, event.value != 0, event.message);
+                        });
+                    }
+                    break;
+            }
+        }
+        return batch.size();
+    }
+
+    static py::dict EventToDict(const RenderEvents::Event& event) {
+        py::dict d;
+        d["type"] = RenderEvents::TypeName(event.type);
+        d["session_id"] = event.session;
+        d["item_id"] = event.item;
+        switch (event.type) {
+            case RenderEvents::Type::ItemUpdated:
+                d["frame_id"] = event.value;
+                break;
+            case RenderEvents::Type::ItemEnded:
+                d["status"] = static_cast<int>(event.value);
+                break;
+            case RenderEvents::Type::ReportLog:
+                d["is_error"] = event.value != 0;
+                d["message"] = event.message;
+                break;
+            default:
+                break;
+        }
+        d["count"] = event.merged;
+        d["time"] = event.time;
+        return d;
+    }
+
     // Register listener with After Effects
     bool RegisterListener() {
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -139,24 +421,71 @@ public:
     }
 
 private:
-    RenderMonitorListener() = default;
+    RenderMonitorListener() {
+        m_stats.Clear(RenderEvents::Queue::Now());
+        m_queue.SetWakeup([]() {
+            IdleHandler::Instance().EnqueueTask([]() {
+                RenderMonitorListener::Instance().DeliverPending(false);
+            }, TaskPriority::Normal, "ae.render_monitor events");
+        });
+    }
+
+    // Frame updates held back by the rate limit get no wakeup of their own,
+    // so drain again once the earliest one is due. Idle tasks cannot be
+    // delayed; the task re-queues itself (low priority) until then
+    void ScheduleHeldDrain() {
+        if (m_heldDrainScheduled.exchange(true)) {
+            return;
+        }
+        IdleHandler::Instance().EnqueueTask([]() {
+            RenderMonitorListener& self = RenderMonitorListener::Instance();
+            self.m_heldDrainScheduled.store(false);
+            double due = self.m_queue.NextHeldDue();
+            if (due <= 0.0) {
+                return;
+            }
+            if (RenderEvents::Queue::Now() < due) {
+                self.ScheduleHeldDrain();
+                return;
+            }
+            self.DeliverPending(false);
+        }, TaskPriority::Low, "ae.render_monitor held updates");
+    }
+
+    template <typename F>
+    static void Invoke(const char* name, F&& call) {
+        try {
+            call();
+        } catch (const py::error_already_set& e) {
+            PYAE_LOG_ERROR("RenderMonitor", std::string("Python callback error (") + name + "): " + e.what());
+        } catch (const std::exception& e) {
+            PYAE_LOG_ERROR("RenderMonitor", std::string("Callback error (") + name + "): " + e.what());
+        }
+    }
+
+    void WriteJobReport(const std::string& path) {
+        try {
+            WriteStatsReport(m_stats, path, ResolveStatsFormat(std::nullopt, path), "items", 2);
+            PYAE_LOG_INFO("RenderMonitor", "Render stats report written: " + path);
+        } catch (const std::exception& e) {
+            PYAE_LOG_ERROR("RenderMonitor", std::string("Failed to write render stats report: ") + e.what());
+        }
+    }
+
+    // Record into the stats collector (render thread, before coalescing)
+    void Collect(RenderEvents::Type type, uint64_t session, uint64_t item, uint64_t value = 0) {
+        if (m_collecting.load(std::memory_order_relaxed)) {
+            m_stats.Record(type, session, item, value, RenderEvents::Queue::Now());
+        }
+    }
 
-    // Static callbacks that bridge to Python
+    // Static callbacks: record the event and return to the render loop
     static A_Err OnRenderJobStarted(AEGP_RQM_BasicData* basicDataP, AEGP_RQM_SessionId jobId) {
         auto* self = reinterpret_cast<RenderMonitorListener*>(basicDataP->aegp_refconPV);
         if (!self) return A_Err_NONE;
 
-        std::lock_guard<std::mutex> lock(self->m_mutex);
-        if (self->m_onJobStarted) {
-            try {
-                py::gil_scoped_acquire gil;
-                (*self->m_onJobStarted)(static_cast<uint64_t>(jobId));
-            } catch (const py::error_already_set& e) {
-                PYAE_LOG_ERROR("RenderMonitor", "Python callback error (JobStarted): " + std::string(e.what()));
-            } catch (const std::exception& e) {
-                PYAE_LOG_ERROR("RenderMonitor", "Callback error (JobStarted): " + std::string(e.what()));
-            }
-        }
+        self->Collect(RenderEvents::Type::JobStarted, static_cast<uint64_t>(jobId), 0);
+        self->m_queue.Push(RenderEvents::Type::JobStarted, static_cast<uint64_t>(jobId), 0);
         return A_Err_NONE;
     }
 
@@ -164,17 +493,8 @@ private:
         auto* self = reinterpret_cast<RenderMonitorListener*>(basicDataP->aegp_refconPV);
         if (!self) return A_Err_NONE;
 
-        std::lock_guard<std::mutex> lock(self->m_mutex);
-        if (self->m_onJobEnded) {
-            try {
-                py::gil_scoped_acquire gil;
-                (*self->m_onJobEnded)(static_cast<uint64_t>(jobId));
-            } catch (const py::error_already_set& e) {
-                PYAE_LOG_ERROR("RenderMonitor", "Python callback error (JobEnded): " + std::string(e.what()));
-            } catch (const std::exception& e) {
-                PYAE_LOG_ERROR("RenderMonitor", "Callback error (JobEnded): " + std::string(e.what()));
-            }
-        }
+        self->Collect(RenderEvents::Type::JobEnded, static_cast<uint64_t>(jobId), 0);
+        self->m_queue.Push(RenderEvents::Type::JobEnded, static_cast<uint64_t>(jobId), 0);
         return A_Err_NONE;
     }
 
@@ -182,17 +502,10 @@ private:
         auto* self = reinterpret_cast<RenderMonitorListener*>(basicDataP->aegp_refconPV);
         if (!self) return A_Err_NONE;
 
-        std::lock_guard<std::mutex> lock(self->m_mutex);
-        if (self->m_onItemStarted) {
-            try {
-                py::gil_scoped_acquire gil;
-                (*self->m_onItemStarted)(static_cast<uint64_t>(jobId), static_cast<uint64_t>(itemId));
-            } catch (const py::error_already_set& e) {
-                PYAE_LOG_ERROR("RenderMonitor", "Python callback error (ItemStarted): " + std::string(e.what()));
-            } catch (const std::exception& e) {
-                PYAE_LOG_ERROR("RenderMonitor", "Callback error (ItemStarted): " + std::string(e.what()));
-            }
-        }
+        self->Collect(RenderEvents::Type::ItemStarted,
+                      static_cast<uint64_t>(jobId), static_cast<uint64_t>(itemId));
+        self->m_queue.Push(RenderEvents::Type::ItemStarted,
+                           static_cast<uint64_t>(jobId), static_cast<uint64_t>(itemId));
         return A_Err_NONE;
     }
 
@@ -201,19 +514,12 @@ private:
         auto* self = reinterpret_cast<RenderMonitorListener*>(basicDataP->aegp_refconPV);
         if (!self) return A_Err_NONE;
 
-        std::lock_guard<std::mutex> lock(self->m_mutex);
-        if (self->m_onItemUpdated) {
-            try {
-                py::gil_scoped_acquire gil;
-                (*self->m_onItemUpdated)(static_cast<uint64_t>(jobId),
-                                         static_cast<uint64_t>(itemId),
-                                         static_cast<uint64_t>(frameId));
-            } catch (const py::error_already_set& e) {
-                PYAE_LOG_ERROR("RenderMonitor", "Python callback error (ItemUpdated): " + std::string(e.what()));
-            } catch (const std::exception& e) {
-                PYAE_LOG_ERROR("RenderMonitor", "Callback error (ItemUpdated): " + std::string(e.what()));
-            }
-        }
+        self->Collect(RenderEvents::Type::ItemUpdated,
+                      static_cast<uint64_t>(jobId), static_cast<uint64_t>(itemId),
+                      static_cast<uint64_t>(frameId));
+        self->m_queue.Push(RenderEvents::Type::ItemUpdated,
+                           static_cast<uint64_t>(jobId), static_cast<uint64_t>(itemId),
+                           static_cast<uint64_t>(frameId));
         return A_Err_NONE;
     }
 
@@ -222,53 +528,41 @@ private:
         auto* self = reinterpret_cast<RenderMonitorListener*>(basicDataP->aegp_refconPV);
         if (!self) return A_Err_NONE;
 
-        std::lock_guard<std::mutex> lock(self->m_mutex);
-        if (self->m_onItemEnded) {
-            try {
-                py::gil_scoped_acquire gil;
-                (*self->m_onItemEnded)(static_cast<uint64_t>(jobId),
-                                       static_cast<uint64_t>(itemId),
-                                       static_cast<int>(fstatus));
-            } catch (const py::error_already_set& e) {
-                PYAE_LOG_ERROR("RenderMonitor", "Python callback error (ItemEnded): " + std::string(e.what()));
-            } catch (const std::exception& e) {
-                PYAE_LOG_ERROR("RenderMonitor", "Callback error (ItemEnded): " + std::string(e.what()));
-            }
-        }
+        self->Collect(RenderEvents::Type::ItemEnded,
+                      static_cast<uint64_t>(jobId), static_cast<uint64_t>(itemId),
+                      static_cast<uint64_t>(fstatus));
+        self->m_queue.Push(RenderEvents::Type::ItemEnded,
+                           static_cast<uint64_t>(jobId), static_cast<uint64_t>(itemId),
+                           static_cast<uint64_t>(fstatus));
         return A_Err_NONE;
     }
 
     static A_Err OnRenderJobItemReportLog(AEGP_RQM_BasicData* basicDataP, AEGP_RQM_SessionId jobId,
                                            AEGP_RQM_ItemId itemId, A_Boolean isError, AEGP_MemHandle logbuf) {
         auto* self = reinterpret_cast<RenderMonitorListener*>(basicDataP->aegp_refconPV);
-        if (!self) return A_Err_NONE;
+        if (!self || !logbuf) return A_Err_NONE;
 
-        std::lock_guard<std::mutex> lock(self->m_mutex);
-        if (self->m_onReportLog && logbuf) {
-            try {
-                // Extract log message from MemHandle
-                auto& state = PluginState::Instance();
-                const auto& suites = state.GetSuites();
-                std::string message;
-
-                if (suites.memorySuite) {
-                    void* ptr = nullptr;
-                    if (suites.memorySuite->AEGP_LockMemHandle(logbuf, &ptr) == A_Err_NONE && ptr) {
-                        message = StringUtils::Utf16ToUtf8(static_cast<A_UTF16Char*>(ptr));
-                        suites.memorySuite->AEGP_UnlockMemHandle(logbuf);
-                    }
-                }
+        self->Collect(RenderEvents::Type::ReportLog, static_cast<uint64_t>(jobId),
+                      static_cast<uint64_t>(itemId), isError ? 1 : 0);
 
-                py::gil_scoped_acquire gil;
-                (*self->m_onReportLog)(static_cast<uint64_t>(jobId),
-                                       static_cast<uint64_t>(itemId),
-                                       isError != FALSE,
-                                       message);
-            } catch (const py::error_already_set& e) {
-                PYAE_LOG_ERROR("RenderMonitor", "Python callback error (ReportLog): " + std::string(e.what()));
-            } catch (const std::exception& e) {
-                PYAE_LOG_ERROR("RenderMonitor", "Callback error (ReportLog): " + std::string(e.what()));
+        try {
+            // The MemHandle is only valid during this call, so copy the text now
+            auto& state = PluginState::Instance();
+            const auto& suites = state.GetSuites();
+            std::string message;
+
+            if (suites.memorySuite) {
+                void* ptr = nullptr;
+                if (suites.memorySuite->AEGP_LockMemHandle(logbuf, &ptr) == A_Err_NONE && ptr) {
+                    message = StringUtils::Utf16ToUtf8(static_cast<A_UTF16Char*>(ptr));
+                    suites.memorySuite->AEGP_UnlockMemHandle(logbuf);
+                }
             }
+
+            self->m_queue.PushLog(static_cast<uint64_t>(jobId), static_cast<uint64_t>(itemId),
+                                  isError != FALSE, std::move(message));
+        } catch (const std::exception& e) {
+            PYAE_LOG_ERROR("RenderMonitor", "Callback error (ReportLog): " + std::string(e.what()));
         }
         return A_Err_NONE;
     }
@@ -277,6 +571,15 @@ private:
     bool m_isRegistered = false;
     AEGP_RQM_FunctionBlock1 m_functionBlock = {};
 
+    // Events recorded by the AE callbacks (lock-free)
+    RenderEvents::Queue m_queue;
+
+    // Render statistics (recorded only while collecting)
+    RenderStats::Collector m_stats;
+    std::atomic<bool> m_collecting{false};
+    std::atomic<bool> m_heldDrainScheduled{false};   // ScheduleHeldDrain task queued
+    std::string m_reportPath;
+
     // Python callbacks
     std::optional<JobStartedCallback> m_onJobStarted;
     std::optional<JobEndedCallback> m_onJobEnded;
@@ -284,6 +587,7 @@ private:
     std::optional<ItemUpdatedCallback> m_onItemUpdated;
     std::optional<ItemEndedCallback> m_onItemEnded;
     std::optional<ReportLogCallback> m_onReportLog;
+    std::optional<EventsCallback> m_onEvents;
 };
 
 // =============================================================
@@ -708,7 +1012,9 @@ Set callback for when a render item frame is updated.
 Args:
     callback: Function taking (session_id: int, item_id: int, frame_id: int). Pass None to clear.
 
-Note: This callback may be called frequently during rendering.
+Note: Frame updates are merged per item and delivered at most
+max_update_rate times per second (see configure_events); frame_id is the
+latest rendered frame.
 )doc", py::arg("callback"));
 
     rm.def("set_on_item_ended", [](std::optional<std::function<void(uint64_t, uint64_t, int)>> callback) {
@@ -742,6 +1048,376 @@ Example:
     ae.render_monitor.set_on_report_log(on_log)
 )doc", py::arg("callback"));
 
+    // Batched delivery
+    rm.def("set_on_events", [](std::optional<std::function<void(py::list)>> callback) {
+        PyAE::RenderMonitorListener::Instance().SetEventsCallback(std::move(callback));
+    }, R"doc(
+Set callback that receives each batch of render events as one list.
+
+Args:
+    callback: Function taking (events: list[dict]). Pass None to clear.
+
+Each event dict has type ("job_started", "job_ended", "item_started",
+"item_updated", "item_ended", "report_log"), session_id, item_id,
+count and time, plus frame_id (item_updated), status (item_ended) or
+is_error and message (report_log). count is the number of frame updates
+merged into an item_updated event; time is a monotonic time in seconds.
+The batch callback runs before the per-event callbacks.
+)doc", py::arg("callback"));
+
+    rm.def("configure_events", [](std::optional<double> maxUpdateRate, std::optional<size_t> capacity) {
+        auto& listener = PyAE::RenderMonitorListener::Instance();
+        if (maxUpdateRate) {
+            if (!(*maxUpdateRate >= 0.0)) {
+                throw std::invalid_argument("max_update_rate must be >= 0");
+            }
+            listener.GetQueue().SetMaxUpdateRate(*maxUpdateRate);
+        }
+        if (capacity) {
+            if (listener.IsRegistered()) {
+                throw std::runtime_error("Cannot change the event capacity while the listener is registered");
+            }
+            listener.GetQueue().Reset(*capacity);
+        }
+    }, R"doc(
+Configure how render events are buffered and delivered.
+
+Args:
+    max_update_rate: Maximum item_updated deliveries per second for each
+        render item (default 30). Faster frame updates are merged and the
+        latest frame is delivered later, always before the item's next
+        event. 0 delivers every batch's latest frame.
+    capacity: Number of events the native buffer holds (rounded up to a
+        power of two, 16 - 1048576; default 4096). Pending events are
+        discarded. Only while the listener is not registered.
+
+Events that do not fit into the buffer are dropped and counted in
+get_event_stats(). Frame updates may use at most 3/4 of the buffer.
+)doc", py::arg("max_update_rate") = py::none(), py::arg("capacity") = py::none());
+
+    rm.def("get_event_stats", []() {
+        PyAE::RenderEvents::Stats stats = PyAE::RenderMonitorListener::Instance().GetQueue().GetStats();
+        py::dict d;
+        d["received"] = stats.received;
+        d["dropped"] = stats.dropped;
+        d["coalesced"] = stats.coalesced;
+        d["delivered"] = stats.delivered;
+        d["batches"] = stats.batches;
+        d["pending"] = stats.pending;
+        d["held"] = stats.held;
+        d["capacity"] = stats.capacity;
+        d["max_update_rate"] = stats.maxUpdateRate;
+        return d;
+    }, R"doc(
+Get render event buffer counters.
+
+Returns:
+    dict: received, dropped, coalesced, delivered, batches (totals since
+    start), pending (events in the buffer), held (frame updates held
+    back by max_update_rate), capacity, max_update_rate.
+)doc");
+
+    rm.def("flush_events", []() {
+        return PyAE::RenderMonitorListener::Instance().DeliverPending(true);
+    }, R"doc(
+Deliver all buffered events now, including held frame updates.
+
+Events are normally delivered from the idle hook. Call this from the
+main thread, e.g. right after a blocking render, to receive them
+immediately.
+
+Returns:
+    int: Number of events delivered.
+)doc");
+
+    // =============================================================
+    // Render statistics
+    // =============================================================
+
+    rm.def("start_collecting", [](double memoryInterval, size_t maxFrames, bool clear,
+                                  std::optional<std::string> reportPath) {
+        if (!(memoryInterval >= 0.0)) {
+            throw std::invalid_argument("memory_interval must be >= 0");
+        }
+        return PyAE::RenderMonitorListener::Instance().StartCollecting(
+            memoryInterval, maxFrames, clear, reportPath.value_or(""));
+    }, R"doc(
+Start recording render statistics.
+
+Every render event is recorded natively as it arrives, before frame
+updates are merged for the callbacks, so per-frame times are exact.
+Registers the listener if needed.
+
+Args:
+    memory_interval: Seconds between process memory snapshots while
+        frames render (default 1.0). Snapshots are also taken when jobs
+        and items start and end. 0 disables snapshots.
+    max_frames: Maximum frame records kept (default 4194304, 24 bytes
+        each). Later frames still count towards the item summaries.
+    clear: Discard earlier records and restart the clock (default True).
+    report_path: When set, a JSON report (or the items table as CSV for
+        a .csv path) is written there after each job ends.
+
+Returns:
+    bool: True if the listener is registered.
+
+Example:
+    ae.render_monitor.start_collecting(report_path="C:/renders/stats.json")
+    ae.render_queue.render()
+    items = ae.render_monitor.get_item_stats()
+    print(max(items["frame_time_p95"]))
+)doc", py::arg("memory_interval") = PyAE::RenderStats::kDefaultMemoryInterval,
+       py::arg("max_frames") = PyAE::RenderStats::kDefaultMaxFrames,
+       py::arg("clear") = true, py::arg("report_path") = py::none());
+
+    rm.def("stop_collecting", []() {
+        PyAE::RenderMonitorListener::Instance().StopCollecting();
+    }, "Stop recording render statistics (the records are kept)");
+
+    rm.def("is_collecting", []() {
+        return PyAE::RenderMonitorListener::Instance().IsCollecting();
+    }, "Check if render statistics are being recorded");
+
+    rm.def("clear_stats", []() {
+        PyAE::RenderMonitorListener::Instance().GetStats().Clear(PyAE::RenderEvents::Queue::Now());
+    }, "Discard the recorded render statistics and restart the clock");
+
+    rm.def("get_collection_info", []() {
+        auto& listener = PyAE::RenderMonitorListener::Instance();
+        PyAE::RenderStats::Counters counters = listener.GetStats().GetCounters();
+        py::dict d;
+        d["collecting"] = listener.IsCollecting();
+        d["jobs"] = counters.jobs;
+        d["items"] = counters.items;
+        d["frames"] = counters.frames;
+        d["memory_samples"] = counters.memorySamples;
+        d["dropped_frames"] = counters.droppedFrames;
+        d["events"] = counters.events;
+        d["bytes"] = counters.bytes;
+        std::string reportPath = listener.GetReportPath();
+        d["report_path"] = reportPath.empty() ? py::object(py::none()) : py::object(py::str(reportPath));
+        return d;
+    }, R"doc(
+Get the state of the render statistics collector.
+
+Returns:
+    dict: collecting, jobs, items, frames, memory_samples,
+    dropped_frames (beyond max_frames), events, bytes (record memory),
+    report_path.
+)doc");
+
+    rm.def("get_job_stats", []() {
+        auto jobs = PyAE::RenderMonitorListener::Instance().GetStats().GetJobs();
+        std::vector<uint64_t> sessions;
+        std::vector<double> starts, ends;
+        std::vector<uint32_t> items, frames;
+        for (const auto& job : jobs) {
+            sessions.push_back(job.session);
+            starts.push_back(job.start);
+            ends.push_back(job.end >= 0.0 ? job.end : std::numeric_limits<double>::quiet_NaN());
+            items.push_back(job.items);
+            frames.push_back(job.frames);
+        }
+        py::dict d;
+        d["session_id"] = PyAE::MakeArray("Q", sessions);
+        d["start"] = PyAE::MakeArray("d", starts);
+        d["end"] = PyAE::MakeArray("d", ends);
+        d["items"] = PyAE::MakeArray("I", items);
+        d["frames"] = PyAE::MakeArray("I", frames);
+        return d;
+    }, R"doc(
+Get per-job statistics as columns.
+
+Returns:
+    dict of array.array: session_id, start, end (NaN while running),
+    items, frames. Times are seconds since collecting started.
+)doc");
+
+    rm.def("get_item_stats", []() {
+        auto summaries = PyAE::RenderMonitorListener::Instance().GetStats().GetItems();
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        std::vector<uint64_t> sessions, itemIds;
+        std::vector<int32_t> statuses;
+        std::vector<double> starts, ends, renderTimes, totals, means, mins, maxs, p50s, p95s;
+        std::vector<uint32_t> frames, timedFrames, logMessages, logErrors;
+        for (const auto& s : summaries) {
+            const auto& rec = s.record;
+            sessions.push_back(rec.session);
+            itemIds.push_back(rec.item);
+            statuses.push_back(rec.status);
+            starts.push_back(rec.start);
+            ends.push_back(rec.end >= 0.0 ? rec.end : nan);
+            renderTimes.push_back(s.renderTime);
+            frames.push_back(rec.frames);
+            timedFrames.push_back(rec.timedFrames);
+            totals.push_back(rec.frameTimeTotal);
+            means.push_back(s.mean);
+            mins.push_back(rec.frameTimeMin);
+            maxs.push_back(rec.frameTimeMax);
+            p50s.push_back(s.p50);
+            p95s.push_back(s.p95);
+            logMessages.push_back(rec.logMessages);
+            logErrors.push_back(rec.logErrors);
+        }
+        py::dict d;
+        d["session_id"] = PyAE::MakeArray("Q", sessions);
+        d["item_id"] = PyAE::MakeArray("Q", itemIds);
+        d["status"] = PyAE::MakeArray("i", statuses);
+        d["start"] = PyAE::MakeArray("d", starts);
+        d["end"] = PyAE::MakeArray("d", ends);
+        d["render_time"] = PyAE::MakeArray("d", renderTimes);
+        d["frames"] = PyAE::MakeArray("I", frames);
+        d["timed_frames"] = PyAE::MakeArray("I", timedFrames);
+        d["frame_time_total"] = PyAE::MakeArray("d", totals);
+        d["frame_time_mean"] = PyAE::MakeArray("d", means);
+        d["frame_time_min"] = PyAE::MakeArray("d", mins);
+        d["frame_time_max"] = PyAE::MakeArray("d", maxs);
+        d["frame_time_p50"] = PyAE::MakeArray("d", p50s);
+        d["frame_time_p95"] = PyAE::MakeArray("d", p95s);
+        d["log_messages"] = PyAE::MakeArray("I", logMessages);
+        d["log_errors"] = PyAE::MakeArray("I", logErrors);
+        return d;
+    }, R"doc(
+Get per-item render statistics as columns.
+
+Returns:
+    dict of array.array: session_id, item_id, status (STATUS_*, -1
+    while rendering), start, end (NaN while rendering), render_time,
+    frames, timed_frames, frame_time_total, frame_time_mean,
+    frame_time_min, frame_time_max, frame_time_p50, frame_time_p95,
+    log_messages, log_errors.
+
+A frame time is the time since the item's previous frame (or its
+start). The first frame of an item whose start was not seen has no
+time; timed_frames counts the frames with one. Frame time statistics
+are NaN for items without timed frames.
+)doc");
+
+    rm.def("get_frame_stats", [](std::optional<uint64_t> itemId) {
+        auto& stats = PyAE::RenderMonitorListener::Instance().GetStats();
+        auto frames = stats.GetFrames(itemId.value_or(0));
+        return PyAE::FramesToColumns(frames, stats.GetItemKeys());
+    }, R"doc(
+Get per-frame records as columns.
+
+Args:
+    item_id: Only this render item's frames (default: all).
+
+Returns:
+    dict of array.array: session_id, item_id, frame_id, time (seconds
+    since collecting started), duration (seconds; NaN when unknown).
+)doc", py::arg("item_id") = py::none());
+
+    rm.def("get_slowest_frames", [](size_t count, std::optional<uint64_t> itemId) {
+        auto& stats = PyAE::RenderMonitorListener::Instance().GetStats();
+        auto frames = stats.GetSlowestFrames(count, itemId.value_or(0));
+        return PyAE::FramesToColumns(frames, stats.GetItemKeys());
+    }, R"doc(
+Get the slowest frames, slowest first.
+
+Args:
+    count: Number of frames (default 10).
+    item_id: Only this render item's frames (default: all).
+
+Returns:
+    dict of array.array with the same columns as get_frame_stats().
+)doc", py::arg("count") = 10, py::arg("item_id") = py::none());
+
+    rm.def("get_frame_histogram", [](size_t bins, std::optional<std::pair<double, double>> range,
+                                     std::optional<uint64_t> itemId) {
+        if (bins < 1) {
+            throw std::invalid_argument("bins must be >= 1");
+        }
+        double lo = 0.0, hi = 0.0;
+        if (range) {
+            lo = range->first;
+            hi = range->second;
+            if (!(lo < hi)) {
+                throw std::invalid_argument("range must be (min, max) with min < max");
+            }
+        }
+        PyAE::RenderStats::Histogram hist =
+            PyAE::RenderMonitorListener::Instance().GetStats().GetHistogram(bins, lo, hi, itemId.value_or(0));
+        return py::make_tuple(PyAE::MakeArray("Q", hist.counts), PyAE::MakeArray("d", hist.edges));
+    }, R"doc(
+Get a histogram of frame times.
+
+Args:
+    bins: Number of bins (default 20).
+    range: (min, max) in seconds (default: 0 to the slowest frame).
+        Frames outside the range are not counted.
+    item_id: Only this render item's frames (default: all).
+
+Returns:
+    tuple: (counts, edges) as array.array, like numpy.histogram;
+    edges has bins + 1 values.
+)doc", py::arg("bins") = 20, py::arg("range") = py::none(), py::arg("item_id") = py::none());
+
+    rm.def("get_memory_stats", []() {
+        auto& stats = PyAE::RenderMonitorListener::Instance().GetStats();
+        auto samples = stats.GetMemory();
+        auto keys = stats.GetItemKeys();
+        std::vector<double> times;
+        std::vector<uint64_t> sessions, itemIds, workingSets, privateBytes;
+        for (const auto& sample : samples) {
+            auto key = sample.item < keys.size() ? keys[sample.item] : std::pair<uint64_t, uint64_t>();
+            times.push_back(sample.time);
+            sessions.push_back(key.first);
+            itemIds.push_back(key.second);
+            workingSets.push_back(sample.sample.workingSet);
+            privateBytes.push_back(sample.sample.privateBytes);
+        }
+        py::dict d;
+        d["time"] = PyAE::MakeArray("d", times);
+        d["session_id"] = PyAE::MakeArray("Q", sessions);
+        d["item_id"] = PyAE::MakeArray("Q", itemIds);
+        d["working_set"] = PyAE::MakeArray("Q", workingSets);
+        d["private_bytes"] = PyAE::MakeArray("Q", privateBytes);
+        return d;
+    }, R"doc(
+Get the process memory snapshots as columns.
+
+Returns:
+    dict of array.array: time, session_id, item_id (0 when no item was
+    rendering), working_set, private_bytes (bytes).
+)doc");
+
+    rm.def("get_stats_report", [](const std::string& format, const std::string& table,
+                                  std::optional<int> indent) {
+        if (format != "json" && format != "csv") {
+            throw std::invalid_argument("format must be 'json' or 'csv': " + format);
+        }
+        return PyAE::BuildStatsReport(PyAE::RenderMonitorListener::Instance().GetStats(),
+                                format, table, indent.value_or(-1));
+    }, R"doc(
+Build a render statistics report.
+
+Args:
+    format: "json" (everything: jobs, items, frames and memory as
+        columns) or "csv" (one table).
+    table: CSV table: "jobs", "items", "frames" or "memory".
+    indent: JSON indent (default: compact).
+
+Returns:
+    str: The report. Unknown values are null in JSON and empty in CSV.
+)doc", py::arg("format") = "json", py::arg("table") = "items", py::arg("indent") = py::none());
+
+    rm.def("export_stats", [](const std::string& path, std::optional<std::string> format,
+                              const std::string& table, std::optional<int> indent) {
+        std::string resolved = PyAE::ResolveStatsFormat(format, path);
+        PyAE::WriteStatsReport(PyAE::RenderMonitorListener::Instance().GetStats(),
+                         path, resolved, table, indent.value_or(-1));
+    }, R"doc(
+Write a render statistics report to a file.
+
+Args:
+    path: Output file path.
+    format: "json" or "csv" (default: from the extension, .csv is CSV).
+    table: CSV table: "jobs", "items", "frames" or "memory".
+    indent: JSON indent (default: compact).
+)doc", py::arg("path"), py::arg("format") = py::none(), py::arg("table") = "items",
+       py::arg("indent") = py::none());
+
     // Documentation
     rm.attr("__doc__") = R"doc(
 Render Queue Monitor API
@@ -770,6 +1446,31 @@ Callback Setters:
     set_on_item_updated(callback) - Called when frame is rendered
     set_on_item_ended(callback) - Called when item render ends
     set_on_report_log(callback) - Called for log messages
+    set_on_events(callback) - Called with each batch of events as a list
+
+Event Delivery:
+    AE's render notifications are recorded into a native buffer and
+    delivered to the callbacks in batches from the idle hook, so Python
+    handlers never run inside the render loop. Frame updates are merged
+    per item and limited to max_update_rate per second.
+
+    configure_events(max_update_rate, capacity) - Delivery settings
+    get_event_stats() - Received / dropped / coalesced / delivered counters
+    flush_events() - Deliver buffered events now
+
+Render Statistics:
+    Every event is recorded natively (before merging) while collecting:
+    per-job, per-item and per-frame times plus process memory snapshots.
+    Queries return columns as array.array.
+
+    start_collecting(memory_interval, max_frames, clear, report_path)
+    stop_collecting() / is_collecting() / clear_stats()
+    get_collection_info() - Record counts and memory use
+    get_job_stats() / get_item_stats() / get_frame_stats(item_id)
+    get_memory_stats() - Process memory snapshots
+    get_slowest_frames(count, item_id)
+    get_frame_histogram(bins, range, item_id)
+    get_stats_report(format, table, indent) / export_stats(path, ...)
 
 Example:
     import ae
@@ -6,6 +6,13 @@
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
@@ -47,6 +54,100 @@ enum class EmbedOptions : int {
 class PyOutputModule;
 class PyRenderQueueItem;
 
+namespace {
+
+// テンプレートの列挙・適用は AEGP にないので ExtendScript で行う
+std::string ExecuteExtendScript(const std::string& script) {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    if (!suites.utilitySuite || !suites.memorySuite) {
+        throw std::runtime_error("Utility Suite not available");
+    }
+
+    AEGP_MemHandle resultH = nullptr;
+    AEGP_MemHandle errorH = nullptr;
+    A_Err err = suites.utilitySuite->AEGP_ExecuteScript(
+        state.GetPluginID(), script.c_str(), TRUE, &resultH, &errorH);
+
+    ScopedMemHandle scopedResult(state.GetPluginID(), suites.memorySuite, resultH);
+    ScopedMemHandle scopedError(state.GetPluginID(), suites.memorySuite, errorH);
+
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("AEGP_ExecuteScript failed");
+    }
+    if (!resultH) return {};
+
+    ScopedMemLock lock(suites.memorySuite, resultH);
+    const char* ptr = lock.As<char>();
+    return ptr ? std::string(ptr) : std::string();
+}
+
+// ExtendScript の文字列リテラル（ASCII 以外は \uXXXX にする）
+std::string JsString(const std::string& utf8) {
+    std::string result = "\"";
+    for (wchar_t c : StringUtils::Utf8ToUtf16(utf8)) {
+        if (c == L'"' || c == L'\\') {
+            result += '\\';
+            result += static_cast<char>(c);
+        } else if (c >= 0x20 && c < 0x7F) {
+            result += static_cast<char>(c);
+        } else {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned int>(c) & 0xFFFF);
+            result += buf;
+        }
+    }
+    return result + "\"";
+}
+
+std::vector<std::string> SplitLines(const std::string& text) {
+    std::vector<std::string> lines;
+    std::stringstream ss(text);
+    std::string line;
+    while (std::getline(ss, line, '\n')) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+bool IsAscii(const std::string& text) {
+    return std::all_of(text.begin(), text.end(), [](char c) {
+        return static_cast<unsigned char>(c) < 0x80;
+    });
+}
+
+// Comp / CompItem / CompRef から AEGP_CompH を取り出す
+AEGP_CompH ResolveCompHandle(const py::object& comp) {
+    AEGP_CompH compH = nullptr;
+
+    // PyCompRef の場合
+    if (py::isinstance<PyCompRef>(comp)) {
+        auto compRef = comp.cast<PyCompRef>();
+        if (!compRef.IsValid()) {
+            throw std::runtime_error("Invalid composition reference");
+        }
+        compH = compRef.GetHandle();
+    }
+    // CompItem (ae.CompItem) の場合
+    // _get_comp_handle_ptr() メソッドで AEGP_CompH を取得
+    else if (py::hasattr(comp, "_get_comp_handle_ptr")) {
+        try {
+            uintptr_t ptr = comp.attr("_get_comp_handle_ptr")().cast<uintptr_t>();
+            compH = reinterpret_cast<AEGP_CompH>(ptr);
+        } catch (const std::exception& e) {
+            throw std::runtime_error(std::string("Failed to get comp handle: ") + e.what());
+        }
+    }
+
+    if (!compH) {
+        throw std::runtime_error("Invalid composition: expected CompItem or CompRef");
+    }
+    return compH;
+}
+
+} // namespace
+
 // =============================================================
 // PyOutputModule - 出力モジュールクラス
 // =============================================================
@@ -530,8 +631,232 @@ public:
         return nullptr;
     }
 
+    // ==========================================
+    // テンプレート（ExtendScript で1回だけ列挙してキャッシュする）
+    // ==========================================
+    // テンプレート名はレンダーキューアイテムからしか取れないので、
+    // キューが空の間は列挙できない（空のリストを返し、キャッシュしない）
+    const std::vector<std::string>& GetRenderSettingsTemplates(bool refresh = false) {
+        LoadTemplates(refresh);
+        return m_renderTemplates;
+    }
+
+    const std::vector<std::string>& GetOutputModuleTemplates(bool refresh = false) {
+        LoadTemplates(refresh);
+        return m_outputTemplates;
+    }
+
+    // ==========================================
+    // 一括追加
+    // ==========================================
+    struct BulkEntry {
+        AEGP_CompH compH = nullptr;
+        std::optional<std::string> renderTemplate;
+        std::optional<std::string> outputTemplate;
+        std::string path;
+        std::string error;      // 空なら成功
+        int index = -1;         // 追加したアイテムの 0 ベースのインデックス
+    };
+
+    // entries をまとめて追加する。1つのアンドゥグループで、テンプレートの
+    // 適用は ExtendScript 1回にまとめる。失敗したエントリのアイテムは消し、
+    // error に理由を入れる（例外にはしない）
+    void AddComps(std::vector<BulkEntry>& entries) {
+        if (entries.empty()) return;
+
+        auto& state = PluginState::Instance();
+        const auto& suites = state.GetSuites();
+
+        if (!suites.renderQueueSuite || !suites.rqItemSuite) {
+            throw std::runtime_error("RenderQueueSuite not available");
+        }
+
+        ScopedUndoGroup undo(suites.utilitySuite, state.GetPluginID(), "Add to Render Queue");
+
+        // 追加中にIdleHandlerが走ると再入/競合の可能性があるため一時停止（全体で1回）
+        struct SuspendIdle {
+            SuspendIdle() { IdleHandler::Instance().SetSuspended(true); }
+            ~SuspendIdle() { IdleHandler::Instance().SetSuspended(false); }
+        } suspend;
+
+        int numItems = GetNumItems();
+        bool needTemplates = std::any_of(entries.begin(), entries.end(), [](const BulkEntry& e) {
+            return e.error.empty() && (e.renderTemplate || e.outputTemplate);
+        });
+        if (needTemplates && numItems > 0) {
+            LoadTemplates(false);
+        }
+
+        for (auto& entry : entries) {
+            if (!entry.error.empty()) continue;
+            if (!CheckTemplates(entry)) continue;
+
+            const std::string addPath = (!entry.path.empty() && IsAscii(entry.path)) ? entry.path : "Comp_Render";
+            A_Err err = suites.renderQueueSuite->AEGP_AddCompToRenderQueue(entry.compH, addPath.c_str());
+            if (err != A_Err_NONE) {
+                entry.error = "Failed to add comp to render queue (error code: " + std::to_string(err) + ")";
+                continue;
+            }
+            entry.index = numItems++;
+
+            // キューが空だった場合は最初のアイテムでテンプレートを列挙し、この分も確かめる
+            if (needTemplates && !m_templatesLoaded) {
+                LoadTemplates(false);
+                CheckTemplates(entry);
+            }
+        }
+
+        ApplyTemplates(entries);
+
+        // テンプレートで出力先が変わるので、パスは最後に設定する
+        for (auto& entry : entries) {
+            if (entry.index < 0 || !entry.error.empty() || entry.path.empty()) continue;
+            try {
+                AEGP_RQItemRefH itemH = nullptr;
+                if (suites.rqItemSuite->AEGP_GetRQItemByIndex(entry.index, &itemH) != A_Err_NONE || !itemH) {
+                    throw std::runtime_error("Failed to get render queue item");
+                }
+                PyOutputModule(0, itemH).SetFilePath(entry.path);
+            } catch (const std::exception& e) {
+                entry.error = e.what();
+            }
+        }
+
+        // 失敗したエントリのアイテムを後ろから消し、残りのインデックスを詰める
+        // （追加した順 = インデックスの順）
+        std::vector<bool> deleted(entries.size(), false);
+        for (size_t i = entries.size(); i-- > 0;) {
+            BulkEntry& entry = entries[i];
+            if (entry.index < 0 || entry.error.empty()) continue;
+            AEGP_RQItemRefH itemH = nullptr;
+            if (suites.rqItemSuite->AEGP_GetRQItemByIndex(entry.index, &itemH) == A_Err_NONE && itemH) {
+                suites.rqItemSuite->AEGP_DeleteRQItem(itemH);
+            }
+            entry.index = -1;
+            deleted[i] = true;
+        }
+        int shift = 0;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (deleted[i]) {
+                shift++;
+            } else if (entries[i].index >= 0) {
+                entries[i].index -= shift;
+            }
+        }
+    }
+
 private:
     PyRenderQueue() = default;
+
+    void LoadTemplates(bool refresh) {
+        if (m_templatesLoaded && !refresh) return;
+
+        int numItems = GetNumItems();
+        if (numItems <= 0) {
+            m_renderTemplates.clear();
+            m_outputTemplates.clear();
+            m_templatesLoaded = false;
+            return;
+        }
+
+        // 2つの一覧を \u0001 で区切って1回で受け取る
+        std::string script =
+            "(function() {"
+            "  var item = app.project.renderQueue.item(" + std::to_string(numItems) + ");"
+            "  return item.templates.join('\\n') + '\\u0001' + item.outputModule(1).templates.join('\\n');"
+            "})();";
+        std::string result;
+        try {
+            result = ExecuteExtendScript(script);
+        } catch (const std::exception& e) {
+            PYAE_LOG_WARNING("RenderQueue", std::string("Template enumeration failed: ") + e.what());
+            return;
+        }
+
+        size_t sep = result.find('\x01');
+        if (sep == std::string::npos) {
+            PYAE_LOG_WARNING("RenderQueue", "Template enumeration returned no result");
+            return;
+        }
+        m_renderTemplates = SplitLines(result.substr(0, sep));
+        m_outputTemplates = SplitLines(result.substr(sep + 1));
+        // ExtendScript は "_HIDDEN X" のような内部テンプレートも返すので除く
+        auto hidden = [](const std::string& name) { return name.empty() || name.rfind("_HIDDEN", 0) == 0; };
+        m_renderTemplates.erase(std::remove_if(m_renderTemplates.begin(), m_renderTemplates.end(), hidden),
+                                m_renderTemplates.end());
+        m_outputTemplates.erase(std::remove_if(m_outputTemplates.begin(), m_outputTemplates.end(), hidden),
+                                m_outputTemplates.end());
+        m_templatesLoaded = true;
+    }
+
+    // キャッシュがあればテンプレート名を確かめる（なければ適用時のエラーで分かる）
+    bool CheckTemplates(BulkEntry& entry) const {
+        if (!m_templatesLoaded) return true;
+        if (entry.renderTemplate &&
+            std::find(m_renderTemplates.begin(), m_renderTemplates.end(), *entry.renderTemplate) == m_renderTemplates.end()) {
+            entry.error = "Unknown render settings template: '" + *entry.renderTemplate + "'";
+            return false;
+        }
+        if (entry.outputTemplate &&
+            std::find(m_outputTemplates.begin(), m_outputTemplates.end(), *entry.outputTemplate) == m_outputTemplates.end()) {
+            entry.error = "Unknown output module template: '" + *entry.outputTemplate + "'";
+            return false;
+        }
+        return true;
+    }
+
+    // 追加したアイテムにテンプレートを ExtendScript 1回で適用する。
+    // 結果は1エントリ1行（空行なら成功）。SplitLines は末尾の空行を返さないので、
+    // 各行を改行で終える
+    void ApplyTemplates(std::vector<BulkEntry>& entries) {
+        std::vector<BulkEntry*> jobs;
+        std::string list;
+        for (auto& entry : entries) {
+            if (entry.index < 0 || !entry.error.empty() || (!entry.renderTemplate && !entry.outputTemplate)) continue;
+            list += jobs.empty() ? "[" : ",[";
+            list += std::to_string(entry.index + 1) + ",";
+            list += (entry.renderTemplate ? JsString(*entry.renderTemplate) : "null") + ",";
+            list += (entry.outputTemplate ? JsString(*entry.outputTemplate) : "null") + "]";
+            jobs.push_back(&entry);
+        }
+        if (jobs.empty()) return;
+
+        std::string script =
+            "(function() {"
+            "  var rq = app.project.renderQueue;"
+            "  var jobs = [" + list + "];"
+            "  var out = [];"
+            "  for (var i = 0; i < jobs.length; i++) {"
+            "    var err = '';"
+            "    try {"
+            "      var item = rq.item(jobs[i][0]);"
+            "      if (jobs[i][1] !== null) item.applyTemplate(jobs[i][1]);"
+            "      if (jobs[i][2] !== null) item.outputModule(1).applyTemplate(jobs[i][2]);"
+            "    } catch (e) { err = String(e).replace(/[\\r\\n]+/g, ' ') || 'error'; }"
+            "    out.push(err);"
+            "  }"
+            "  return out.join('\\n') + '\\n';"
+            "})();";
+
+        std::vector<std::string> results;
+        try {
+            results = SplitLines(ExecuteExtendScript(script));
+        } catch (const std::exception& e) {
+            for (auto* job : jobs) job->error = std::string("Failed to apply templates: ") + e.what();
+            return;
+        }
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            if (i >= results.size()) {
+                jobs[i]->error = "Failed to apply templates: no result";
+            } else if (!results[i].empty()) {
+                jobs[i]->error = results[i];
+            }
+        }
+    }
+
+    bool m_templatesLoaded = false;
+    std::vector<std::string> m_renderTemplates;
+    std::vector<std::string> m_outputTemplates;
 };
 
 } // namespace PyAE
@@ -635,50 +960,109 @@ void init_render_queue(py::module_& m) {
         return PyAE::PyRenderQueue::Instance().GetAllItems();
     }, "Get all render queue items");
 
-    // テンプレート関連（SDKでは直接サポートされていないため、空リストを返す）
-    rq.def("render_settings_templates", []() -> std::vector<std::string> {
-        // NOTE: AEGP SDKではRender Settingsテンプレート名を取得するAPIが提供されていません
-        // ExtendScriptのRenderQueue.templatesに相当する機能はAEGPでは利用不可
-        PYAE_LOG_WARNING("RenderQueue",
-            "render_settings_templates: AEGP SDK does not provide template enumeration API");
-        return {};
-    }, "Get render settings template names (Note: AEGP SDK limitation - returns empty list)");
+    // テンプレート関連（AEGP SDK には列挙 API がないので ExtendScript で取得してキャッシュする）
+    rq.def("render_settings_templates", [](bool refresh) {
+        return PyAE::PyRenderQueue::Instance().GetRenderSettingsTemplates(refresh);
+    }, "Get render settings template names.\n\n"
+       "Names are read once with ExtendScript and cached; pass refresh=True\n"
+       "after editing templates. Templates can only be read from a render\n"
+       "queue item, so the list is empty while the queue is empty.",
+       py::arg("refresh") = false);
 
     rq.def("add_comp", [](py::object comp, const std::string& path) {
-        AEGP_CompH compH = nullptr;
+        AEGP_CompH compH = PyAE::ResolveCompHandle(comp);
+        return PyAE::PyRenderQueue::Instance().AddComp(compH, path);
+    }, "Add composition to render queue",
+       py::arg("comp"),
+       py::arg("path") = "");
 
-        // PyCompRef の場合
-        if (py::isinstance<PyAE::PyCompRef>(comp)) {
-            auto compRef = comp.cast<PyAE::PyCompRef>();
-            if (!compRef.IsValid()) {
-                throw std::runtime_error("Invalid composition reference");
-            }
-            compH = compRef.GetHandle();
-        }
-        // CompItem (ae.CompItem) の場合
-        // _get_comp_handle_ptr() メソッドで AEGP_CompH を取得
-        else if (py::hasattr(comp, "_get_comp_handle_ptr")) {
+    rq.def("output_module_templates", [](bool refresh) {
+        return PyAE::PyRenderQueue::Instance().GetOutputModuleTemplates(refresh);
+    }, "Get output module template names (cached like render_settings_templates)",
+       py::arg("refresh") = false);
+
+    rq.def("add_comps", [](py::iterable entries) {
+        std::vector<PyAE::PyRenderQueue::BulkEntry> bulk;
+        auto optionalString = [](const py::object& value) -> std::optional<std::string> {
+            if (value.is_none()) return std::nullopt;
+            return value.cast<std::string>();
+        };
+
+        // エントリの形の誤りもエントリごとのエラーにする
+        for (py::handle handle : entries) {
+            py::object entry = py::reinterpret_borrow<py::object>(handle);
+            PyAE::PyRenderQueue::BulkEntry item;
             try {
-                uintptr_t ptr = comp.attr("_get_comp_handle_ptr")().cast<uintptr_t>();
-                compH = reinterpret_cast<AEGP_CompH>(ptr);
+                py::object comp = py::none();
+                py::object renderTemplate = py::none();
+                py::object outputTemplate = py::none();
+                py::object path = py::none();
+                if (py::isinstance<py::dict>(entry)) {
+                    py::dict d = entry.cast<py::dict>();
+                    if (!d.contains("comp")) {
+                        throw std::invalid_argument("Entry has no 'comp'");
+                    }
+                    comp = d["comp"];
+                    if (d.contains("render_template")) renderTemplate = d["render_template"];
+                    if (d.contains("output_module_template")) outputTemplate = d["output_module_template"];
+                    if (d.contains("path")) path = d["path"];
+                } else if (py::isinstance<py::tuple>(entry) || py::isinstance<py::list>(entry)) {
+                    py::sequence seq = entry.cast<py::sequence>();
+                    if (seq.size() < 1 || seq.size() > 4) {
+                        throw std::invalid_argument("Entry must be (comp, render_template, output_module_template, path)");
+                    }
+                    comp = seq[0];
+                    if (seq.size() > 1) renderTemplate = seq[1];
+                    if (seq.size() > 2) outputTemplate = seq[2];
+                    if (seq.size() > 3) path = seq[3];
+                } else {
+                    comp = entry;
+                }
+                item.compH = PyAE::ResolveCompHandle(comp);
+                item.renderTemplate = optionalString(renderTemplate);
+                item.outputTemplate = optionalString(outputTemplate);
+                item.path = optionalString(path).value_or(std::string());
+            } catch (const py::cast_error&) {
+                item.error = "Templates and path must be strings or None";
             } catch (const std::exception& e) {
-                throw std::runtime_error(std::string("Failed to get comp handle: ") + e.what());
+                item.error = e.what();
             }
+            bulk.push_back(std::move(item));
         }
 
-        if (!compH) {
-            throw std::runtime_error("Invalid composition: expected CompItem or CompRef");
-        }
+        PyAE::PyRenderQueue& queue = PyAE::PyRenderQueue::Instance();
+        queue.AddComps(bulk);
 
-        return PyAE::PyRenderQueue::Instance().AddComp(compH, path);
-    }, "Add composition to render queue",
-       py::arg("comp"),
-       py::arg("path") = "");
-
-    rq.def("output_module_templates", []() -> std::vector<std::string> {
-        // NOTE: AEGP SDKではOutput Moduleテンプレート名を取得するAPIが提供されていません
-        PYAE_LOG_WARNING("RenderQueue",
-            "output_module_templates: AEGP SDK does not provide template enumeration API");
-        return {};
-    }, "Get output module template names (Note: AEGP SDK limitation - returns empty list)");
+        py::list results;
+        size_t failed = 0;
+        for (const auto& item : bulk) {
+            py::dict result;
+            if (item.error.empty() && item.index >= 0) {
+                result["item"] = queue.GetItem(item.index);
+                result["error"] = py::none();
+            } else {
+                result["item"] = py::none();
+                result["error"] = item.error.empty() ? std::string("Not added") : item.error;
+                failed++;
+            }
+            results.append(result);
+        }
+        if (failed > 0) {
+            PYAE_LOG_WARNING("RenderQueue", "add_comps: " + std::to_string(failed) + " of " +
+                             std::to_string(bulk.size()) + " entries failed");
+        }
+        return results;
+    }, "Add many compositions to the render queue at once.\n\n"
+       "Each entry is a comp, a tuple (comp, render_template,\n"
+       "output_module_template, path) with trailing values optional, or a\n"
+       "dict with the keys comp, render_template, output_module_template\n"
+       "and path. None leaves a setting at its default.\n\n"
+       "All entries are added in one undo group, template names are checked\n"
+       "against the cached template lists and all templates are applied with\n"
+       "a single ExtendScript call. An entry that fails is not added and does\n"
+       "not stop the others.\n\n"
+       "Returns:\n"
+       "    list[dict]: One dict per entry, in order, with 'item'\n"
+       "    (RenderQueueItem or None) and 'error' (None or a message)",
+       py::arg("entries"));
 }
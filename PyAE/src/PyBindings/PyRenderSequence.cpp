@@ -0,0 +1,455 @@
+// PyRenderSequence.cpp
+// PyAE - Python for After Effects
+// フレーム範囲のレンダー（RenderSequence）のバインディング
+//
+// メインスレッドで AEGP_RenderAndCheckoutFrame を順に呼び、各フレームを
+// FramePipeline に取り込んでレシートをすぐ返す。ファイル書き出し・統計は
+// ワーカースレッドで次のフレームのレンダーと並行して進む。
+// Python からはイテレーターとして1フレームずつ World を受け取ることもできる。
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "AETypeUtils.h"
+#include "FramePipeline.h"
+#include "PluginState.h"
+#include "PyRenderClasses.h"
+#include "PyWorldClasses.h"
+
+namespace py = pybind11;
+
+namespace PyAE {
+
+namespace {
+
+constexpr int kDefaultMaxInFlight = 4;
+constexpr size_t kMaxFrames = 1000000;
+
+PixelConvert::Depth DepthOf(WorldType type)
+{
+    switch (type) {
+        case WorldType::BIT8: return PixelConvert::Depth::U8;
+        case WorldType::BIT16: return PixelConvert::Depth::U16;
+        case WorldType::BIT32: return PixelConvert::Depth::F32;
+        default: throw std::runtime_error("Unsupported world type");
+    }
+}
+
+py::tuple Tuple4(const ImageStats::Result& result, double ImageStats::ChannelStats::*field)
+{
+    return py::make_tuple(result.channels[0].*field, result.channels[1].*field,
+                          result.channels[2].*field, result.channels[3].*field);
+}
+
+double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// =============================================================
+// RenderSequence - アイテムの時間範囲をレンダーしてコンシューマーへ渡す
+// =============================================================
+class RenderSequence {
+public:
+    RenderSequence(py::object item, std::optional<double> start, std::optional<double> end,
+                   std::optional<double> step, std::optional<WorldType> worldType, int maxInFlight)
+        : m_maxInFlight(maxInFlight)
+    {
+        if (maxInFlight < 1) {
+            throw std::invalid_argument("max_in_flight must be at least 1");
+        }
+
+        auto& state = PluginState::Instance();
+        const auto& suites = state.GetSuites();
+        if (!suites.itemSuite || !suites.compSuite) {
+            throw std::runtime_error("Required suites not available");
+        }
+
+        AEGP_ItemH itemH = PyRenderer::ResolveItem(item);
+        m_options = PyRenderOptions::FromItem(reinterpret_cast<uintptr_t>(itemH));
+        if (worldType) {
+            m_options->SetWorldType(*worldType);
+        }
+        m_worldType = m_options->GetWorldType();
+
+        // 既定の間隔はコンポのフレーム長（コンポ以外はレンダー設定の time_step）
+        m_frameDuration = 0.0;
+        AEGP_CompH compH = nullptr;
+        if (suites.compSuite->AEGP_GetCompFromItem(itemH, &compH) == A_Err_NONE && compH) {
+            A_Time frameTime = {0, 1};
+            if (suites.compSuite->AEGP_GetCompFrameDuration(compH, &frameTime) == A_Err_NONE &&
+                frameTime.scale != 0) {
+                m_frameDuration = AETypeUtils::TimeToSeconds(frameTime);
+            }
+        }
+        if (m_frameDuration <= 0.0) {
+            m_frameDuration = m_options->GetTimeStep();
+        }
+        if (m_frameDuration <= 0.0) {
+            m_frameDuration = 1.0 / 30.0;
+        }
+
+        double first = start.value_or(0.0);
+        double last = 0.0;
+        if (end) {
+            last = *end;
+        } else {
+            A_Time duration = {0, 1};
+            A_Err err = suites.itemSuite->AEGP_GetItemDuration(itemH, &duration);
+            if (err != A_Err_NONE) {
+                throw std::runtime_error("AEGP_GetItemDuration failed");
+            }
+            last = duration.scale != 0 ? AETypeUtils::TimeToSeconds(duration) : 0.0;
+        }
+        double interval = step.value_or(m_frameDuration);
+        if (!(interval > 0.0)) {
+            throw std::invalid_argument("step must be positive");
+        }
+        // フレーム番号は開始時刻のフレームから順に振る（step がフレーム長と
+        // 違っても番号が重ならない）
+        m_firstNumber = std::llround(first / m_frameDuration);
+        if (!(last > first)) {
+            throw std::invalid_argument("end must be greater than start");
+        }
+
+        // end は含まない（浮動小数の誤差で最後のフレームが増えないよう少し手前で止める）
+        const double limit = last - interval * 1e-6;
+        for (size_t k = 0;; ++k) {
+            double t = first + interval * static_cast<double>(k);
+            if (t >= limit) {
+                break;
+            }
+            if (k >= kMaxFrames) {
+                throw std::invalid_argument("Too many frames in the range");
+            }
+            m_times.push_back(t);
+        }
+    }
+
+    void AddWriter(const std::string& pattern, const std::optional<std::string>& format, int bitDepth)
+    {
+        CheckNotStarted();
+        ImageEncoder::Format imageFormat = format ? ImageEncoder::FormatFromName(*format)
+                                                  : ImageEncoder::FormatFromPath(pattern);
+        if (bitDepth <= 0) {
+            bitDepth = ImageEncoder::DefaultBitDepth(imageFormat, DepthOf(m_worldType));
+        }
+        m_consumers.push_back(FrameConsumers::MakeFileWriter(pattern, imageFormat, bitDepth));
+    }
+
+    void AddStats(int bins, const std::tuple<float, float>& range, bool histogram)
+    {
+        CheckNotStarted();
+        if (m_statsCollector) {
+            throw std::runtime_error("Stats consumer already added");
+        }
+        ImageStats::Options options;
+        options.bins = bins;
+        options.rangeMin = std::get<0>(range);
+        options.rangeMax = std::get<1>(range);
+        options.histogram = histogram;
+        if (bins < 1 || bins > 65536 || !(options.rangeMax > options.rangeMin)) {
+            throw std::invalid_argument("Invalid histogram bins or range");
+        }
+        m_statsCollector = std::make_shared<FrameConsumers::StatsCollector>(options);
+        m_consumers.push_back(m_statsCollector);
+    }
+
+    // 全フレームをレンダーして結果を返す
+    py::dict Run(py::object progress)
+    {
+        if (m_started) {
+            throw std::runtime_error("RenderSequence has already been run");
+        }
+        Begin();
+        const size_t total = m_times.size();
+        while (m_next < total) {
+            RenderNext(false);
+            if (!progress.is_none()) {
+                Guard([&]() { progress(m_next, total); });
+            }
+        }
+        return Finish();
+    }
+
+    // イテレーター: (time, World) を1フレームずつ返す
+    py::tuple Next()
+    {
+        if (!m_started) {
+            Begin();
+        }
+        if (m_next >= m_times.size()) {
+            if (m_result.is_none() && m_pipeline) {
+                Finish();
+            }
+            throw py::stop_iteration();
+        }
+        double time = m_times[m_next];
+        std::shared_ptr<PyWorld> world = RenderNext(true);
+        return py::make_tuple(time, world);
+    }
+
+    const std::vector<double>& GetTimes() const { return m_times; }
+    size_t GetFrameCount() const { return m_times.size(); }
+    size_t GetRenderedCount() const { return m_next; }
+    int GetMaxInFlight() const { return m_maxInFlight; }
+    double GetFrameDuration() const { return m_frameDuration; }
+    py::object GetResult() const { return m_result; }
+
+private:
+    void CheckNotStarted() const
+    {
+        if (m_started) {
+            throw std::runtime_error("Cannot add consumers after rendering has started");
+        }
+    }
+
+    void Begin()
+    {
+        m_started = true;
+        m_startTime = std::chrono::steady_clock::now();
+        m_pipeline = std::make_unique<FramePipeline>(m_consumers, m_maxInFlight);
+    }
+
+    // 失敗したらパイプラインを止めて残りのフレームを打ち切る
+    template <typename F>
+    void Guard(F&& body)
+    {
+        try {
+            body();
+        } catch (...) {
+            m_next = m_times.size();
+            if (m_pipeline) {
+                py::gil_scoped_release release;
+                m_pipeline->Close();
+            }
+            throw;
+        }
+    }
+
+    std::shared_ptr<PyWorld> RenderNext(bool snapshot)
+    {
+        std::shared_ptr<PyWorld> copy;
+        Guard([&]() {
+            const double time = m_times[m_next];
+            m_options->SetTime(time);
+
+            auto renderStart = std::chrono::steady_clock::now();
+            std::shared_ptr<PyFrameReceipt> receipt = PyRenderer::RenderFrame(m_options);
+            m_renderSeconds += SecondsSince(renderStart);
+
+            std::shared_ptr<PyWorld> world = receipt->GetWorld();
+            PixelConvert::ImageView view = world->GetImageView();
+
+            // in-flight が上限なら空くまで待つ（その間 Python の他のスレッドは動ける）
+            auto submitStart = std::chrono::steady_clock::now();
+            {
+                py::gil_scoped_release release;
+                m_pipeline->Submit(m_firstNumber + static_cast<int64_t>(m_next), time, view);
+            }
+            m_submitSeconds += SecondsSince(submitStart);
+
+            if (snapshot) {
+                copy = PyWorld::Create(world->GetType(), view.width, view.height, false);
+                copy->CopyRegion(*world, 0, 0, view.width, view.height, 0, 0);
+            }
+            receipt->Checkin();
+            m_next++;
+        });
+        return copy;
+    }
+
+    py::dict Finish()
+    {
+        {
+            py::gil_scoped_release release;
+            m_pipeline->Close();
+        }
+        const double seconds = SecondsSince(m_startTime);
+        FramePipeline::Stats stats = m_pipeline->GetStats();
+
+        py::dict result;
+        result["frames"] = m_next;
+        result["seconds"] = seconds;
+        result["fps"] = seconds > 0.0 ? static_cast<double>(m_next) / seconds : 0.0;
+        result["render_seconds"] = m_renderSeconds;
+        result["submit_seconds"] = m_submitSeconds;
+        result["wait_seconds"] = stats.waitSeconds;
+        result["copy_seconds"] = stats.copySeconds;
+        result["peak_in_flight"] = stats.peakInFlight;
+        result["max_in_flight"] = m_maxInFlight;
+
+        py::list consumers;
+        std::string failure;
+        for (const auto& consumer : stats.consumers) {
+            py::dict c;
+            c["name"] = consumer.name;
+            c["frames"] = consumer.frames;
+            c["seconds"] = consumer.seconds;
+            c["error"] = consumer.error.empty() ? py::object(py::none()) : py::object(py::str(consumer.error));
+            consumers.append(c);
+            if (!consumer.error.empty() && failure.empty()) {
+                failure = "Consumer '" + consumer.name + "' failed: " + consumer.error;
+            }
+        }
+        result["consumers"] = consumers;
+
+        if (m_statsCollector) {
+            py::list frames;
+            for (const auto& entry : m_statsCollector->GetResults()) {
+                py::dict f;
+                f["index"] = entry.index;
+                f["frame"] = entry.number;
+                f["time"] = entry.time;
+                f["min"] = Tuple4(entry.result, &ImageStats::ChannelStats::min);
+                f["max"] = Tuple4(entry.result, &ImageStats::ChannelStats::max);
+                f["mean"] = Tuple4(entry.result, &ImageStats::ChannelStats::mean);
+                f["std"] = Tuple4(entry.result, &ImageStats::ChannelStats::stddev);
+                if (!entry.result.channels[0].histogram.empty()) {
+                    py::list histogram;
+                    for (const auto& channel : entry.result.channels) {
+                        histogram.append(py::cast(channel.histogram));
+                    }
+                    f["histogram"] = histogram;
+                }
+                frames.append(f);
+            }
+            result["stats"] = frames;
+        }
+
+        m_result = result;
+        if (!failure.empty()) {
+            throw std::runtime_error(failure);
+        }
+        return result;
+    }
+
+    std::shared_ptr<PyRenderOptions> m_options;
+    WorldType m_worldType = WorldType::NONE;
+    double m_frameDuration = 0.0;
+    int64_t m_firstNumber = 0;      // 最初のフレームの番号（以降は連番）
+    std::vector<double> m_times;
+    int m_maxInFlight;
+
+    std::vector<std::shared_ptr<FramePipeline::Consumer>> m_consumers;
+    std::shared_ptr<FrameConsumers::StatsCollector> m_statsCollector;
+    std::unique_ptr<FramePipeline> m_pipeline;
+
+    bool m_started = false;
+    size_t m_next = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+    double m_renderSeconds = 0.0;
+    double m_submitSeconds = 0.0;
+    py::object m_result = py::none();
+};
+
+void init_render_sequence(py::module_& m)
+{
+    py::class_<RenderSequence, std::shared_ptr<RenderSequence>>(m, "RenderSequence",
+        "Render a time range of an item and hand the frames to consumers.\n\n"
+        "Frames are rendered on the main thread with RenderAndCheckoutFrame,\n"
+        "copied into pooled buffers and checked in right away. Consumers\n"
+        "(add_writer, add_stats) each run on their own worker thread in frame\n"
+        "order, overlapping with the rendering of the next frames. At most\n"
+        "max_in_flight frames are held; rendering waits when all are in use.\n\n"
+        "run() renders everything and returns timings (frames, seconds, fps,\n"
+        "render_seconds, ...). Iterating the sequence instead yields\n"
+        "(time, World) for each frame while the consumers keep running.\n\n"
+        "Example:\n"
+        "    seq = ae.RenderSequence(comp, start=0.0, end=2.0)\n"
+        "    seq.add_writer('C:/out/shot_####.png')\n"
+        "    seq.add_stats()\n"
+        "    result = seq.run()\n"
+        "    print(result['fps'], result['stats'][0]['mean'])\n\n"
+        "    for time, world in ae.RenderSequence(comp, end=1.0):\n"
+        "        print(time, world.statistics(histogram=False)['mean'])")
+        .def(py::init([](py::object item, std::optional<double> start, std::optional<double> end,
+                         std::optional<double> step, std::optional<WorldType> worldType,
+                         int maxInFlight) {
+            return std::make_shared<RenderSequence>(item, start, end, step, worldType, maxInFlight);
+        }),
+            "Args:\n"
+            "    item: Comp, CompItem, Item or item handle\n"
+            "    start: First time in seconds (default 0)\n"
+            "    end: End time in seconds, exclusive (default: item duration)\n"
+            "    step: Seconds between frames (default: comp frame duration)\n"
+            "    world_type: Bit depth to render (default: from the item)\n"
+            "    max_in_flight: Frames held for the consumers at most (default 4)",
+            py::arg("item"),
+            py::arg("start") = py::none(),
+            py::arg("end") = py::none(),
+            py::arg("step") = py::none(),
+            py::arg("world_type") = py::none(),
+            py::arg("max_in_flight") = kDefaultMaxInFlight)
+
+        .def("add_writer", [](std::shared_ptr<RenderSequence> self, const std::string& pattern,
+                              std::optional<std::string> format, int bitDepth) {
+            self->AddWriter(pattern, format, bitDepth);
+            return self;
+        },
+            "Write every frame to an image file on a worker thread.\n\n"
+            "The last run of '#' in the file name is replaced by the frame\n"
+            "number (zero padded); without '#', '_####' is added before the\n"
+            "extension. Frames are numbered consecutively from the comp frame\n"
+            "at start (start / frame_duration), one per rendered frame.\n\n"
+            "Args:\n"
+            "    pattern: Destination path, e.g. 'C:/out/shot_####.exr'\n"
+            "    format: 'png', 'tiff', 'exr' or 'pfm' (default: from the extension)\n"
+            "    bit_depth: Bits per channel (0 = from the world type)\n\n"
+            "Returns:\n"
+            "    The sequence (for chaining)",
+            py::arg("pattern"), py::arg("format") = py::none(), py::arg("bit_depth") = 0)
+
+        .def("add_stats", [](std::shared_ptr<RenderSequence> self, int bins,
+                             const std::tuple<float, float>& range, bool histogram) {
+            self->AddStats(bins, range, histogram);
+            return self;
+        },
+            "Compute per-channel statistics of every frame on a worker thread.\n\n"
+            "The result of run() then has 'stats': one dict per frame with\n"
+            "index, frame, time, min, max, mean, std (R, G, B, A) and, if\n"
+            "histogram is True, histogram (4 lists of bins counts).\n\n"
+            "Returns:\n"
+            "    The sequence (for chaining)",
+            py::arg("bins") = 256,
+            py::arg("range") = std::make_tuple(0.0f, 1.0f),
+            py::arg("histogram") = false)
+
+        .def("run", &RenderSequence::Run,
+            "Render all frames and wait for the consumers.\n\n"
+            "Args:\n"
+            "    progress: Optional callable(done, total) called after each frame\n\n"
+            "Returns:\n"
+            "    dict: frames, seconds, fps, render_seconds, submit_seconds,\n"
+            "    wait_seconds, copy_seconds, peak_in_flight, max_in_flight,\n"
+            "    consumers (name, frames, seconds, error) and stats if added.\n\n"
+            "Raises:\n"
+            "    RuntimeError: If a consumer failed (result is still stored)",
+            py::arg("progress") = py::none())
+
+        .def("__iter__", [](std::shared_ptr<RenderSequence> self) { return self; })
+        .def("__next__", &RenderSequence::Next)
+        .def("__len__", &RenderSequence::GetFrameCount)
+
+        .def_property_readonly("times", &RenderSequence::GetTimes,
+            "Times (seconds) of the frames to render")
+        .def_property_readonly("rendered", &RenderSequence::GetRenderedCount,
+            "Number of frames rendered so far")
+        .def_property_readonly("frame_duration", &RenderSequence::GetFrameDuration,
+            "Frame duration used for the first frame number (seconds)")
+        .def_property_readonly("max_in_flight", &RenderSequence::GetMaxInFlight)
+        .def_property_readonly("result", &RenderSequence::GetResult,
+            "Result dict of the finished sequence, or None");
+}
+
+} // namespace PyAE
@@ -0,0 +1,420 @@
+// PySerialize.cpp
+// PyAE - Python for After Effects
+// ネイティブ シリアライザのバインディング (ae.serialize)
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <fstream>
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+#include "PluginState.h"
+#include "ProjectSerializer.h"
+#include "ProjectSnapshot.h"
+#include "ProjectImporter.h"
+#include "ProjectDiff.h"
+#include "JsonWriter.h"
+#include "PyCompClasses.h"
+#include "PyLayerClasses.h"
+#include "PyRefTypes.h"
+#include "StringUtils.h"
+#include "Logger.h"
+
+namespace py = pybind11;
+
+namespace PyAE {
+
+// =============================================================
+// Helpers
+// =============================================================
+
+static void LogStats(const std::string& path, const ProjectSerializer::Stats& stats) {
+    PYAE_LOG_INFO("Serializer", "Wrote " + path + " (items=" + std::to_string(stats.items) +
+                  ", layers=" + std::to_string(stats.layers) +
+                  ", properties=" + std::to_string(stats.properties) +
+                  ", keyframes=" + std::to_string(stats.keyframes) + ")");
+}
+
+// path が None なら JSON 文字列を返し、指定されていればファイルへストリーム出力する
+template <typename WriteFn>
+static py::object SerializeJson(const std::optional<std::string>& path,
+                                std::optional<int> indent,
+                                WriteFn&& write)
+{
+    int indentWidth = indent.value_or(-1);
+
+    if (!path) {
+        JsonWriter writer(indentWidth);
+        ProjectSerializer serializer(writer);
+        write(serializer);
+        return py::str(writer.TakeString());
+    }
+
+    std::ofstream file(std::filesystem::path(StringUtils::Utf8ToWide(*path)),
+                       std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Failed to open file for writing: " + *path);
+    }
+
+    JsonWriter writer(indentWidth, &file);
+    ProjectSerializer serializer(writer);
+    write(serializer);
+    writer.Flush();
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write file: " + *path);
+    }
+
+    LogStats(*path, serializer.GetStats());
+    return py::none();
+}
+
+// path が None ならスナップショットの bytes を返し、指定されていればファイルへ書き出す
+template <typename WriteFn>
+static py::object SerializeSnapshot(const std::optional<std::string>& path, WriteFn&& write)
+{
+    SnapshotWriter writer;
+    ProjectSerializer serializer(writer);
+    write(serializer);
+    std::string bytes = writer.Finish();
+
+    if (!path) {
+        return py::bytes(bytes);
+    }
+
+    std::ofstream file(std::filesystem::path(StringUtils::Utf8ToWide(*path)),
+                       std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Failed to open file for writing: " + *path);
+    }
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write file: " + *path);
+    }
+
+    LogStats(*path, serializer.GetStats());
+    return py::none();
+}
+
+static AEGP_ProjectH GetCurrentProject() {
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    AEGP_ProjectH projectH = nullptr;
+    if (!suites.projSuite ||
+        suites.projSuite->AEGP_GetProjectByIndex(0, &projectH) != A_Err_NONE || !projectH) {
+        throw std::runtime_error("No project open");
+    }
+    return projectH;
+}
+
+static AEGP_CompH ResolveCompHandle(const py::object& comp) {
+    AEGP_CompH compH = nullptr;
+    if (py::isinstance<PyComp>(comp)) {
+        compH = comp.cast<const PyComp&>().GetHandle();
+    } else if (py::hasattr(comp, "_comp_handle")) {
+        // CompItem（project.items の要素）
+        compH = reinterpret_cast<AEGP_CompH>(comp.attr("_comp_handle").cast<uintptr_t>());
+    } else {
+        throw std::invalid_argument("Expected Comp or CompItem");
+    }
+    if (!compH) {
+        throw std::runtime_error("Invalid composition");
+    }
+    return compH;
+}
+
+// =============================================================
+// Module init
+// =============================================================
+
+void init_serialize(py::module_& m) {
+    py::module_ ser = m.def_submodule("serialize",
+        R"doc(Native JSON / snapshot serializer.
+
+Walks the project through the AEGP suites and streams JSON directly to a
+string or file, without building intermediate Python objects. The output
+uses the same schema as ae_serialize (project_to_dict / comp_to_dict /
+layer_to_dict), so json.loads() of the result can be passed to the
+existing *_from_dict functions. The *_to_snapshot variants write the same
+document in the binary ae.snapshot format. project_from_dict rebuilds a
+project from that schema natively, and diff / diff_live / apply_patch
+update an existing project incrementally.
+
+Example:
+    import ae
+
+    ae.serialize.project_to_json("C:/temp/scene.json", indent=2)
+    data = json.loads(ae.serialize.comp_to_json(comp))
+    ae.serialize.project_to_snapshot("C:/temp/scene.aesnap")
+)doc");
+
+    ser.def("project_to_json",
+        [](std::optional<std::string> path, std::optional<int> indent) {
+            AEGP_ProjectH projectH = GetCurrentProject();
+            return SerializeJson(path, indent, [projectH](ProjectSerializer& s) {
+                s.WriteProject(projectH);
+            });
+        },
+        R"doc(Serialize the current project (project_to_dict schema).
+
+Args:
+    path: Output file path. If None, the JSON string is returned.
+    indent: Indent width, or None for compact output
+
+Returns:
+    JSON string if path is None, otherwise None
+)doc",
+        py::arg("path") = py::none(),
+        py::arg("indent") = py::none());
+
+    ser.def("comp_to_json",
+        [](py::object comp, std::optional<std::string> path, std::optional<int> indent) {
+            AEGP_CompH compH = ResolveCompHandle(comp);
+            return SerializeJson(path, indent, [compH](ProjectSerializer& s) {
+                s.WriteComp(compH);
+            });
+        },
+        R"doc(Serialize a composition and its layers (comp_to_dict schema).
+
+Args:
+    comp: Comp or CompItem
+    path: Output file path. If None, the JSON string is returned.
+    indent: Indent width, or None for compact output
+
+Returns:
+    JSON string if path is None, otherwise None
+)doc",
+        py::arg("comp"),
+        py::arg("path") = py::none(),
+        py::arg("indent") = py::none());
+
+    ser.def("layer_to_json",
+        [](const PyLayer& layer, std::optional<std::string> path, std::optional<int> indent) {
+            AEGP_LayerH layerH = layer.GetHandle();
+            if (!layerH) {
+                throw std::runtime_error("Invalid layer");
+            }
+            return SerializeJson(path, indent, [layerH](ProjectSerializer& s) {
+                s.WriteLayer(layerH);
+            });
+        },
+        R"doc(Serialize a layer with its properties and effects (layer_to_dict schema).
+
+Args:
+    layer: Layer
+    path: Output file path. If None, the JSON string is returned.
+    indent: Indent width, or None for compact output
+
+Returns:
+    JSON string if path is None, otherwise None
+)doc",
+        py::arg("layer"),
+        py::arg("path") = py::none(),
+        py::arg("indent") = py::none());
+
+    // ==========================================
+    // Binary snapshot
+    // ==========================================
+
+    ser.def("project_to_snapshot",
+        [](std::optional<std::string> path) {
+            AEGP_ProjectH projectH = GetCurrentProject();
+            return SerializeSnapshot(path, [projectH](ProjectSerializer& s) {
+                s.WriteProject(projectH);
+            });
+        },
+        R"doc(Serialize the current project as a binary snapshot (see ae.snapshot).
+
+Args:
+    path: Output file path. If None, the snapshot bytes are returned.
+
+Returns:
+    bytes if path is None, otherwise None
+)doc",
+        py::arg("path") = py::none());
+
+    ser.def("comp_to_snapshot",
+        [](py::object comp, std::optional<std::string> path) {
+            AEGP_CompH compH = ResolveCompHandle(comp);
+            return SerializeSnapshot(path, [compH](ProjectSerializer& s) {
+                s.WriteComp(compH);
+            });
+        },
+        R"doc(Serialize a composition as a binary snapshot (see ae.snapshot).
+
+Args:
+    comp: Comp or CompItem
+    path: Output file path. If None, the snapshot bytes are returned.
+
+Returns:
+    bytes if path is None, otherwise None
+)doc",
+        py::arg("comp"),
+        py::arg("path") = py::none());
+
+    ser.def("layer_to_snapshot",
+        [](const PyLayer& layer, std::optional<std::string> path) {
+            AEGP_LayerH layerH = layer.GetHandle();
+            if (!layerH) {
+                throw std::runtime_error("Invalid layer");
+            }
+            return SerializeSnapshot(path, [layerH](ProjectSerializer& s) {
+                s.WriteLayer(layerH);
+            });
+        },
+        R"doc(Serialize a layer as a binary snapshot (see ae.snapshot).
+
+Args:
+    layer: Layer
+    path: Output file path. If None, the snapshot bytes are returned.
+
+Returns:
+    bytes if path is None, otherwise None
+)doc",
+        py::arg("layer"),
+        py::arg("path") = py::none());
+
+    // ==========================================
+    // Import
+    // ==========================================
+
+    ser.def("project_from_dict",
+        [](py::dict data, py::object progress) {
+            if (!progress.is_none() && !PyCallable_Check(progress.ptr())) {
+                throw py::type_error("progress must be callable");
+            }
+
+            ProjectImporter importer(GetCurrentProject());
+            if (!progress.is_none()) {
+                // インポートはメインスレッドで同期的に進むので、
+                // 各アイテム・レイヤーの後にその場で呼ぶ（GIL は保持中）
+                importer.SetProgressCallback(
+                    [progress](const std::string& phase, size_t done, size_t total) {
+                        progress(phase, done, total);
+                    });
+            }
+            importer.ImportProject(data);
+
+            py::dict items;
+            for (const auto& [id, itemH] : importer.GetItems()) {
+                items[py::int_(id)] = ResolveItemHandle(itemH);
+            }
+            return items;
+        },
+        R"doc(Import a project_to_dict() structure into the current project.
+
+Creates folders, comps, file footage, layers, properties, effects and
+keyframes in one undo group. Keyframes are added per property with a
+single AEGP_StartAddKeyframes batch.
+
+Args:
+    data: Project dictionary (project_to_dict schema)
+    progress: Optional callable(phase, done, total). It is called
+        synchronously after each comp, footage item and layer is created
+        (phase is "folders", "comps", "footage" or "layers"). An exception
+        raised by the callback stops the import.
+
+Returns:
+    dict mapping JSON item IDs to the created items
+)doc",
+        py::arg("data"),
+        py::arg("progress") = py::none());
+
+    // ==========================================
+    // Diff / Patch
+    // ==========================================
+
+    ser.def("diff",
+        [](py::dict base, py::dict target, bool prune) {
+            return ProjectDiff::Diff(base, target, prune);
+        },
+        R"doc(Compute a patch that turns one project_to_dict() structure into another.
+
+Items are matched by ID (then by unique type and name), layers by
+(name, type, occurrence) and properties by match-name path. Changed
+keyframes are expressed per key. Existing items are referenced by the
+IDs in base, so the patch applies to the project base was taken from.
+
+Args:
+    base: Current state (project_to_dict schema)
+    target: Desired state (project_to_dict schema)
+    prune: Also remove items and layers that only exist in base
+
+Returns:
+    Patch dict {"version", "id_map", "ops"} for apply_patch()
+)doc",
+        py::arg("base"),
+        py::arg("target"),
+        py::arg("prune") = false);
+
+    ser.def("diff_live",
+        [](py::dict target, py::object base, py::object since, bool prune) {
+            std::optional<std::tuple<int, int, int, int>> timestamp;
+            if (!since.is_none()) {
+                if (base.is_none()) {
+                    throw py::value_error("since requires base");
+                }
+                timestamp = since.cast<std::tuple<int, int, int, int>>();
+            }
+            py::dict previous = base.is_none() ? py::dict() : base.cast<py::dict>();
+            py::dict live = ProjectDiff::CaptureProject(GetCurrentProject(), previous, timestamp);
+            return ProjectDiff::Diff(live, target, prune);
+        },
+        R"doc(Compute a patch from the current project to target.
+
+The current project is read natively into the project_to_dict schema.
+When base and since are given, comps and footage that have not changed
+since the timestamp (Renderer.has_item_changed_since_timestamp) reuse
+their data from base instead of being walked again; only their name and
+folder are refreshed. Changes that do not affect rendering (labels,
+comments) may therefore not be seen for those items.
+
+Args:
+    target: Desired state (project_to_dict schema)
+    base: Earlier project_to_dict() of this project (optional)
+    since: Renderer.get_current_timestamp() taken when base was captured
+    prune: Also remove items and layers that are not in target
+
+Returns:
+    Patch dict for apply_patch()
+)doc",
+        py::arg("target"),
+        py::arg("base") = py::none(),
+        py::arg("since") = py::none(),
+        py::arg("prune") = false);
+
+    ser.def("apply_patch",
+        [](py::dict patch) {
+            PatchApplier applier(GetCurrentProject());
+            applier.Apply(patch);
+
+            const auto& stats = applier.GetStats();
+            py::dict result;
+            result["ops"] = stats.ops;
+            result["skipped"] = stats.skipped;
+            result["items"] = stats.items;
+            result["layers"] = stats.layers;
+            result["properties"] = stats.properties;
+            result["keyframes"] = stats.keyframes;
+            result["effects"] = stats.effects;
+            return result;
+        },
+        R"doc(Apply a patch from diff() / diff_live() to the current project.
+
+All operations run in one undo group. Operations that fail (for example
+a property that no longer exists) are logged and counted as skipped.
+
+Args:
+    patch: Patch dict
+
+Returns:
+    dict with counts: ops, skipped, items, layers, properties, keyframes, effects
+)doc",
+        py::arg("patch"));
+}
+
+} // namespace PyAE
@@ -0,0 +1,558 @@
+// PySnapshot.cpp
+// PyAE - Python for After Effects
+// バイナリ プロジェクトスナップショットのバインディング (ae.snapshot)
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+
+#include "ProjectSnapshot.h"
+#include "StringUtils.h"
+
+namespace py = pybind11;
+
+namespace PyAE {
+
+namespace {
+
+// 入れ子の上限（循環参照・異常データ対策）
+constexpr int kMaxDepth = 512;
+
+// =============================================================
+// dict -> snapshot
+// =============================================================
+
+// 16進文字列として保持されるバイト列のキー（export_scene の bdata / tdum / tduM）
+bool IsBytesKey(std::string_view key) {
+    return key == "bdata" || key == "tdum" || key == "tduM";
+}
+
+int HexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// 小文字16進なら true を返して decoded に格納（大文字を含む場合は往復できないので文字列扱い）
+bool DecodeLowerHex(std::string_view text, std::string& decoded) {
+    if (text.size() % 2 != 0) {
+        return false;
+    }
+    decoded.resize(text.size() / 2);
+    for (size_t i = 0; i < decoded.size(); ++i) {
+        int hi = HexDigit(text[i * 2]);
+        int lo = HexDigit(text[i * 2 + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        decoded[i] = static_cast<char>((hi << 4) | lo);
+    }
+    return true;
+}
+
+std::string_view Utf8View(PyObject* str) {
+    Py_ssize_t size = 0;
+    const char* data = PyUnicode_AsUTF8AndSize(str, &size);
+    if (!data) {
+        throw py::error_already_set();
+    }
+    return std::string_view(data, static_cast<size_t>(size));
+}
+
+void EncodeValue(SnapshotWriter& w, py::handle obj, std::string_view key, int depth) {
+    if (depth > kMaxDepth) {
+        throw py::value_error("Snapshot: data is nested too deeply");
+    }
+
+    PyObject* o = obj.ptr();
+    if (o == Py_None) {
+        w.Null();
+    } else if (PyBool_Check(o)) {
+        w.Bool(o == Py_True);
+    } else if (PyLong_Check(o)) {
+        int overflow = 0;
+        long long value = PyLong_AsLongLongAndOverflow(o, &overflow);
+        if (overflow != 0) {
+            throw py::value_error("Snapshot: integer out of 64-bit range");
+        }
+        w.Int(value);
+    } else if (PyFloat_Check(o)) {
+        w.Number(PyFloat_AS_DOUBLE(o));
+    } else if (PyUnicode_Check(o)) {
+        std::string_view text = Utf8View(o);
+        std::string bytes;
+        if (IsBytesKey(key) && DecodeLowerHex(text, bytes)) {
+            w.HexString(bytes);
+        } else {
+            w.String(text);
+        }
+    } else if (PyDict_Check(o)) {
+        w.BeginObject();
+        PyObject* k = nullptr;
+        PyObject* v = nullptr;
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(o, &pos, &k, &v)) {
+            if (!PyUnicode_Check(k)) {
+                throw py::type_error("Snapshot: dict keys must be str");
+            }
+            std::string_view childKey = Utf8View(k);
+            w.Key(childKey);
+            EncodeValue(w, v, childKey, depth + 1);
+        }
+        w.EndObject();
+    } else if (PyList_Check(o) || PyTuple_Check(o)) {
+        w.BeginArray();
+        for (py::handle item : py::reinterpret_borrow<py::sequence>(obj)) {
+            EncodeValue(w, item, {}, depth + 1);
+        }
+        w.EndArray();
+    } else {
+        throw py::type_error("Snapshot: unsupported type '" +
+                             std::string(Py_TYPE(o)->tp_name) + "'");
+    }
+}
+
+std::string EncodeSnapshot(const py::handle& data) {
+    SnapshotWriter writer;
+    EncodeValue(writer, data, {}, 0);
+    return writer.Finish();
+}
+
+// =============================================================
+// snapshot -> dict
+// =============================================================
+
+class Decoder {
+public:
+    py::object Decode(const SnapshotNode& node) {
+        using Snapshot::Tag;
+        switch (node.GetTag()) {
+            case Tag::Null:   return py::none();
+            case Tag::False:  return py::bool_(false);
+            case Tag::True:   return py::bool_(true);
+            case Tag::Int:    return py::int_(node.AsInt());
+            case Tag::Double: return py::float_(node.AsDouble());
+            case Tag::String: return Str(node.AsString());
+            case Tag::Bytes:  return Hex(node.AsBytes());
+            case Tag::Array: {
+                py::list list(node.Size());
+                size_t i = 0;
+                node.ForEachElement([&](const SnapshotNode& child) {
+                    PyList_SET_ITEM(list.ptr(), i++, Decode(child).release().ptr());
+                });
+                return std::move(list);
+            }
+            case Tag::Object: {
+                py::dict dict;
+                node.ForEachMember([&](std::string_view key, const SnapshotNode& child) {
+                    dict[Str(key)] = Decode(child);
+                });
+                return std::move(dict);
+            }
+            case Tag::KeyframeTable: {
+                uint32_t count = node.Size();
+                py::list list(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    PyList_SET_ITEM(list.ptr(), i, DecodeKeyframe(node, i).release().ptr());
+                }
+                return std::move(list);
+            }
+        }
+        throw std::runtime_error("Snapshot: unknown value tag");
+    }
+
+    py::dict DecodeKeyframe(const SnapshotNode& table, uint32_t index) {
+        const auto& fields = Snapshot::kKeyframeFields;
+        py::dict kf;
+        kf[Str(fields[0])] = py::float_(table.KeyframeTime(index));
+        kf[Str(fields[1])] = Hex(table.KeyframeBdata(index));
+        kf[Str(fields[2])] = Str(table.KeyframeInInterpolation(index));
+        kf[Str(fields[3])] = Str(table.KeyframeOutInterpolation(index));
+        return kf;
+    }
+
+private:
+    // 文字列テーブル由来の文字列は同じ py::str を再利用する
+    py::object Str(std::string_view text) {
+        auto it = m_strings.find(text.data());
+        if (it != m_strings.end() && it->second.first == text.size()) {
+            return it->second.second;
+        }
+        py::str value(text.data(), text.size());
+        m_strings[text.data()] = {text.size(), value};
+        return std::move(value);
+    }
+
+    static py::str Hex(std::string_view bytes) {
+        static const char kDigits[] = "0123456789abcdef";
+        std::string text;
+        text.reserve(bytes.size() * 2);
+        for (unsigned char c : bytes) {
+            text += kDigits[c >> 4];
+            text += kDigits[c & 0x0F];
+        }
+        return py::str(text);
+    }
+
+    std::unordered_map<const char*, std::pair<size_t, py::object>> m_strings;
+};
+
+// =============================================================
+// 遅延読み込みスナップショット
+// =============================================================
+
+class PySnapshotFile {
+public:
+    explicit PySnapshotFile(std::shared_ptr<SnapshotReader> reader)
+        : m_reader(std::move(reader)) {}
+
+    const SnapshotReader& Reader() const {
+        if (!m_reader) {
+            throw std::runtime_error("Snapshot is closed");
+        }
+        return *m_reader;
+    }
+
+    void Close() { m_reader.reset(); }
+    bool IsClosed() const { return !m_reader; }
+
+    // path: None / "items/0/comp_data" / ["items", 0, "comp_data"]
+    // キーフレーム表の行以下は Python オブジェクトとして辿る
+    bool Resolve(const py::object& path, SnapshotNode& node, py::object& value) const {
+        node = Reader().Root();
+        value = py::object();
+
+        for (const py::object& segment : SplitPath(path)) {
+            if (value) {
+                try {
+                    py::object next = value[segment];
+                    value = next;
+                } catch (py::error_already_set&) {
+                    return false;
+                }
+                continue;
+            }
+
+            using Snapshot::Tag;
+            Tag tag = node.GetTag();
+            if (tag == Tag::Object) {
+                if (!py::isinstance<py::str>(segment)) {
+                    return false;
+                }
+                node = node.Get(segment.cast<std::string>());
+                if (!node.IsValid()) {
+                    return false;
+                }
+            } else if (tag == Tag::Array || tag == Tag::KeyframeTable) {
+                int64_t index = 0;
+                if (!ToIndex(segment, node.Size(), index)) {
+                    return false;
+                }
+                if (tag == Tag::Array) {
+                    node = node.At(static_cast<uint32_t>(index));
+                } else {
+                    value = Decoder().DecodeKeyframe(node, static_cast<uint32_t>(index));
+                }
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static std::vector<py::object> SplitPath(const py::object& path) {
+        std::vector<py::object> segments;
+        if (path.is_none()) {
+            return segments;
+        }
+        if (py::isinstance<py::str>(path)) {
+            std::string text = path.cast<std::string>();
+            size_t start = 0;
+            while (start <= text.size()) {
+                size_t end = text.find('/', start);
+                if (end == std::string::npos) end = text.size();
+                if (end > start) {
+                    segments.push_back(py::str(text.substr(start, end - start)));
+                }
+                start = end + 1;
+            }
+            return segments;
+        }
+        for (py::handle segment : path) {
+            segments.push_back(py::reinterpret_borrow<py::object>(segment));
+        }
+        return segments;
+    }
+
+    static bool ToIndex(const py::object& segment, uint32_t size, int64_t& index) {
+        if (py::isinstance<py::int_>(segment)) {
+            index = segment.cast<int64_t>();
+        } else if (py::isinstance<py::str>(segment)) {
+            std::string text = segment.cast<std::string>();
+            try {
+                size_t used = 0;
+                index = std::stoll(text, &used);
+                if (used != text.size()) return false;
+            } catch (...) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+        if (index < 0) {
+            index += size;
+        }
+        return index >= 0 && index < static_cast<int64_t>(size);
+    }
+
+    std::shared_ptr<SnapshotReader> m_reader;
+};
+
+void WriteBytesToFile(const std::string& path, const std::string& bytes) {
+    std::ofstream file(std::filesystem::path(StringUtils::Utf8ToWide(path)),
+                       std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Failed to open file for writing: " + path);
+    }
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write file: " + path);
+    }
+}
+
+} // namespace
+
+// =============================================================
+// Module init
+// =============================================================
+
+void init_snapshot(py::module_& m) {
+    py::module_ snap = m.def_submodule("snapshot",
+        R"doc(Binary project snapshots.
+
+A compact, memory-mappable alternative to the JSON produced by ae.serialize.
+Strings (keys, match names, interpolation types) are interned in a string
+table, bdata hex strings are stored as raw bytes, and keyframe lists are
+stored as columns. Containers carry their byte size, so open() can answer
+queries by skipping subtrees instead of parsing the whole file.
+
+The format round-trips the ae_serialize dict schema: load(dump(d)) == d.
+
+Example:
+    import ae
+
+    ae.serialize.project_to_snapshot("C:/temp/scene.aesnap")
+    with ae.snapshot.open("C:/temp/scene.aesnap") as snap:
+        for item in snap.list_items():
+            print(item["id"], item["name"])
+        layers = snap.get("items/0/comp_data/layers")
+)doc");
+
+    snap.def("dumps",
+        [](py::object data) {
+            return py::bytes(EncodeSnapshot(data));
+        },
+        R"doc(Encode a dict (ae_serialize schema) as snapshot bytes.
+
+Args:
+    data: JSON-compatible value (dict, list, str, int, float, bool, None)
+
+Returns:
+    Snapshot bytes
+)doc",
+        py::arg("data"));
+
+    snap.def("dump",
+        [](py::object data, const std::string& path) {
+            WriteBytesToFile(path, EncodeSnapshot(data));
+        },
+        R"doc(Encode a dict (ae_serialize schema) and write it to a snapshot file.
+
+Args:
+    data: JSON-compatible value
+    path: Output file path
+)doc",
+        py::arg("data"),
+        py::arg("path"));
+
+    snap.def("loads",
+        [](py::bytes data) {
+            auto reader = SnapshotReader::FromBytes(std::string(data));
+            return Decoder().Decode(reader->Root());
+        },
+        R"doc(Decode snapshot bytes into Python objects.
+
+Args:
+    data: Snapshot bytes
+
+Returns:
+    Decoded value (dict for project/comp/layer snapshots)
+)doc",
+        py::arg("data"));
+
+    snap.def("load",
+        [](const std::string& path) {
+            auto reader = SnapshotReader::OpenFile(path);
+            return Decoder().Decode(reader->Root());
+        },
+        R"doc(Read a snapshot file into Python objects.
+
+Args:
+    path: Snapshot file path
+
+Returns:
+    Decoded value (dict for project/comp/layer snapshots)
+)doc",
+        py::arg("path"));
+
+    py::class_<PySnapshotFile>(snap, "Snapshot",
+        R"doc(Memory-mapped snapshot opened with ae.snapshot.open().
+
+Only the values that are requested are decoded. Paths are either a
+"/"-separated string ("items/0/comp_data/layers") or a list of keys and
+indices (["items", 0, "name"]). The file stays mapped until close().
+)doc")
+        .def_property_readonly("version",
+            [](const PySnapshotFile& self) { return self.Reader().GetVersion(); },
+            "Snapshot format version")
+        .def_property_readonly("size",
+            [](const PySnapshotFile& self) { return self.Reader().GetSize(); },
+            "File size in bytes")
+        .def_property_readonly("string_count",
+            [](const PySnapshotFile& self) { return self.Reader().GetStringCount(); },
+            "Number of interned strings")
+        .def_property_readonly("closed", &PySnapshotFile::IsClosed,
+            "True after close()")
+        .def("get",
+            [](const PySnapshotFile& self, py::object path, py::object defaultValue) -> py::object {
+                SnapshotNode node;
+                py::object value;
+                if (!self.Resolve(path, node, value)) {
+                    return defaultValue;
+                }
+                return value ? value : Decoder().Decode(node);
+            },
+            R"doc(Decode the value at path.
+
+Args:
+    path: Path to the value (None for the whole document)
+    default: Value returned when the path does not exist
+
+Returns:
+    Decoded value or default
+)doc",
+            py::arg("path") = py::none(),
+            py::arg("default") = py::none())
+        .def("keys",
+            [](const PySnapshotFile& self, py::object path) -> py::list {
+                SnapshotNode node;
+                py::object value;
+                if (!self.Resolve(path, node, value)) {
+                    throw py::key_error(py::str(path).cast<std::string>());
+                }
+                if (value) {
+                    return py::list(value.attr("keys")());
+                }
+                py::list keys;
+                node.ForEachMember([&](std::string_view key, const SnapshotNode&) {
+                    keys.append(py::str(key.data(), key.size()));
+                });
+                return keys;
+            },
+            R"doc(Keys of the object at path, without decoding the values.
+
+Args:
+    path: Path to an object (None for the root)
+
+Returns:
+    List of keys
+)doc",
+            py::arg("path") = py::none())
+        .def("count",
+            [](const PySnapshotFile& self, py::object path) -> size_t {
+                SnapshotNode node;
+                py::object value;
+                if (!self.Resolve(path, node, value)) {
+                    throw py::key_error(py::str(path).cast<std::string>());
+                }
+                return value ? py::len(value) : node.Size();
+            },
+            R"doc(Number of elements of the container at path (0 for scalars).
+
+Args:
+    path: Path to an object or list (None for the root)
+
+Returns:
+    Element count
+)doc",
+            py::arg("path") = py::none())
+        .def("list_items",
+            [](const PySnapshotFile& self) {
+                // project スナップショットのアイテム一覧（comp_data 等は読まない）
+                py::list result;
+                SnapshotNode root = self.Reader().Root();
+                if (root.GetTag() != Snapshot::Tag::Object) {
+                    return result;
+                }
+                SnapshotNode items = root.Get("items");
+                if (!items.IsValid() || items.GetTag() != Snapshot::Tag::Array) {
+                    return result;
+                }
+                Decoder decoder;
+                items.ForEachElement([&](const SnapshotNode& item) {
+                    if (item.GetTag() != Snapshot::Tag::Object) {
+                        return;
+                    }
+                    py::dict summary;
+                    for (const char* key : {"id", "name", "type", "parent_folder_id"}) {
+                        SnapshotNode child = item.Get(key);
+                        if (child.IsValid()) {
+                            summary[key] = decoder.Decode(child);
+                        }
+                    }
+                    result.append(summary);
+                });
+                return result;
+            },
+            R"doc(Summaries of project items ({id, name, type, parent_folder_id}).
+
+Only the summary fields are read; comp_data and footage_data are skipped.
+
+Returns:
+    List of dicts (empty if the snapshot is not a project snapshot)
+)doc")
+        .def("close", &PySnapshotFile::Close, "Unmap the file")
+        .def("__enter__", [](PySnapshotFile& self) -> PySnapshotFile& { return self; },
+            py::return_value_policy::reference)
+        .def("__exit__", [](PySnapshotFile& self, py::object, py::object, py::object) {
+            self.Close();
+        })
+        .def("__repr__", [](const PySnapshotFile& self) {
+            if (self.IsClosed()) {
+                return std::string("<Snapshot (closed)>");
+            }
+            return "<Snapshot version=" + std::to_string(self.Reader().GetVersion()) +
+                   " size=" + std::to_string(self.Reader().GetSize()) + ">";
+        });
+
+    snap.def("open",
+        [](const std::string& path) {
+            return PySnapshotFile(SnapshotReader::OpenFile(path));
+        },
+        R"doc(Open a snapshot file for lazy, memory-mapped access.
+
+Args:
+    path: Snapshot file path
+
+Returns:
+    Snapshot
+)doc",
+        py::arg("path"));
+}
+
+} // namespace PyAE
@@ -0,0 +1,746 @@
+// PyThumbnailCache.cpp
+// PyAE - Python for After Effects
+// プロジェクトアイテムのサムネイルキャッシュ（ThumbnailCache）のバインディング
+//
+// get() はメモリ（なければディスク）にあるサムネイルをすぐ返し、ないものや
+// 古いものはアイドル処理で作る。作るときはダウンサンプルした 8bit で
+// レンダーして縮小し、ThumbnailStore に圧縮して保存する。1回のアイドル
+// 呼び出しで使う時間は budget_ms までに抑える。
+//
+// 有効かどうかの判定:
+//   - 同じセッションで作ったもの: AEGP_HasItemChangedSinceTimestamp
+//   - 前のセッションのもの: AEGP のタイムスタンプはセッションをまたげないので、
+//     記録したプロジェクトファイルの更新時刻が今のファイルと同じで、未保存の
+//     変更もなければ、今のタイムスタンプで取り直して使う
+// それ以外は古いサムネイル（stale）として返しつつ作り直す。
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "IdleHandler.h"
+#include "ImageResize.h"
+#include "Logger.h"
+#include "PluginState.h"
+#include "PythonHost.h"
+#include "PyRenderClasses.h"
+#include "PyWorldClasses.h"
+#include "ScopedHandles.h"
+#include "StringUtils.h"
+#include "ThumbnailStore.h"
+
+namespace py = pybind11;
+
+namespace PyAE {
+
+namespace {
+
+constexpr int kDefaultSize = 160;
+constexpr uint64_t kDefaultMaxMemoryBytes = uint64_t(64) << 20;    // 64 MiB
+constexpr double kDefaultBudgetMs = 10.0;
+
+// このプロセスのセッション ID（0 は使わない）
+uint64_t SessionId()
+{
+    static const uint64_t session = []() {
+        std::random_device device;
+        uint64_t value = (static_cast<uint64_t>(device()) << 32) ^ device() ^
+            static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        return value != 0 ? value : 1;
+    }();
+    return session;
+}
+
+uint64_t Fnv1a(const std::string& text)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+ThumbnailStore::Stamp ToStamp(const std::tuple<int, int, int, int>& timestamp)
+{
+    return {std::get<0>(timestamp), std::get<1>(timestamp),
+            std::get<2>(timestamp), std::get<3>(timestamp)};
+}
+
+std::tuple<int, int, int, int> FromStamp(const ThumbnailStore::Stamp& stamp)
+{
+    return std::make_tuple(stamp[0], stamp[1], stamp[2], stamp[3]);
+}
+
+// 開いているプロジェクトのパス・未保存の変更・ファイルの更新時刻
+struct ProjectState {
+    std::string path;       // 未保存のプロジェクトは空
+    bool dirty = true;
+    int64_t fileTime = 0;   // 読めなければ 0
+
+    // 今の状態をサムネイルに記録する値（未保存の変更があれば 0）
+    int64_t StampTime() const { return dirty ? 0 : fileTime; }
+};
+
+ProjectState GetProjectState()
+{
+    ProjectState result;
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    if (!suites.projSuite || !suites.memorySuite) {
+        return result;
+    }
+
+    AEGP_ProjectH projH = nullptr;
+    if (suites.projSuite->AEGP_GetProjectByIndex(0, &projH) != A_Err_NONE || !projH) {
+        return result;
+    }
+
+    AEGP_MemHandle pathH = nullptr;
+    if (suites.projSuite->AEGP_GetProjectPath(projH, &pathH) == A_Err_NONE && pathH) {
+        ScopedMemHandle scopedPath(state.GetPluginID(), suites.memorySuite, pathH);
+        ScopedMemLock lock(suites.memorySuite, pathH);
+        if (A_UTF16Char* pathPtr = lock.As<A_UTF16Char>()) {
+            result.path = StringUtils::Utf16ToUtf8(pathPtr);
+        }
+    }
+
+    A_Boolean isDirty = TRUE;
+    if (suites.projSuite->AEGP_ProjectIsDirty(projH, &isDirty) == A_Err_NONE) {
+        result.dirty = isDirty != FALSE;
+    }
+
+    if (!result.path.empty()) {
+        std::error_code ec;
+        auto time = std::filesystem::last_write_time(StringUtils::Utf8ToWide(result.path), ec);
+        if (!ec) {
+            result.fileTime = static_cast<int64_t>(time.time_since_epoch().count());
+        }
+    }
+    return result;
+}
+
+uint32_t ItemIdOf(AEGP_ItemH itemH)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+    A_long id = 0;
+    if (!suites.itemSuite || suites.itemSuite->AEGP_GetItemID(itemH, &id) != A_Err_NONE) {
+        throw std::runtime_error("AEGP_GetItemID failed");
+    }
+    return static_cast<uint32_t>(id);
+}
+
+// ID からアイテムを探す（なければ nullptr）
+AEGP_ItemH FindItemById(uint32_t itemId)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+    AEGP_ProjectH projH = nullptr;
+    if (!suites.projSuite || !suites.itemSuite ||
+        suites.projSuite->AEGP_GetProjectByIndex(0, &projH) != A_Err_NONE || !projH) {
+        return nullptr;
+    }
+
+    AEGP_ItemH itemH = nullptr;
+    A_Err err = suites.itemSuite->AEGP_GetFirstProjItem(projH, &itemH);
+    while (err == A_Err_NONE && itemH != nullptr) {
+        A_long id = 0;
+        if (suites.itemSuite->AEGP_GetItemID(itemH, &id) == A_Err_NONE &&
+            static_cast<uint32_t>(id) == itemId) {
+            return itemH;
+        }
+        AEGP_ItemH nextH = nullptr;
+        err = suites.itemSuite->AEGP_GetNextProjItem(projH, itemH, &nextH);
+        itemH = nextH;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// =============================================================
+// ThumbnailImage - 1つのサムネイル（読み取り専用の RGBA 8bit）
+// =============================================================
+class ThumbnailImage {
+public:
+    ThumbnailImage(ThumbnailStore::ThumbnailPtr thumbnail, bool stale)
+        : m_thumbnail(std::move(thumbnail)), m_stale(stale) {}
+
+    int GetWidth() const { return m_thumbnail->width; }
+    int GetHeight() const { return m_thumbnail->height; }
+    uint32_t GetItemId() const { return m_thumbnail->itemId; }
+    bool IsStale() const { return m_stale; }
+    size_t GetByteCount() const { return m_thumbnail->pixels.size(); }
+    std::tuple<int, int, int, int> GetTimestamp() const { return FromStamp(m_thumbnail->stamp); }
+
+    py::bytes ToBytes() const
+    {
+        return py::bytes(reinterpret_cast<const char*>(m_thumbnail->pixels.data()),
+                         m_thumbnail->pixels.size());
+    }
+
+    // 新しい 8bit の World にコピーする
+    std::shared_ptr<PyWorld> ToWorld() const
+    {
+        std::shared_ptr<PyWorld> world = PyWorld::Create(WorldType::BIT8, GetWidth(), GetHeight(), false);
+        PixelConvert::ImageView dst = world->GetImageView();
+        PixelConvert::Convert(m_thumbnail->View(), dst);
+        return world;
+    }
+
+    // (height, width, 4) の読み取り専用バッファ（RGBA、コピーしない）
+    py::buffer_info GetBufferInfo() const
+    {
+        return py::buffer_info(
+            const_cast<uint8_t*>(m_thumbnail->pixels.data()),
+            py::ssize_t(1),
+            py::format_descriptor<uint8_t>::format(),
+            3,
+            { static_cast<py::ssize_t>(GetHeight()), static_cast<py::ssize_t>(GetWidth()), py::ssize_t(4) },
+            { static_cast<py::ssize_t>(GetWidth()) * 4, py::ssize_t(4), py::ssize_t(1) },
+            true);
+    }
+
+private:
+    ThumbnailStore::ThumbnailPtr m_thumbnail;
+    bool m_stale;
+};
+
+// =============================================================
+// ThumbnailCache - アイドル処理でサムネイルを作るキャッシュ
+// =============================================================
+// メインスレッドと Python スレッドから GIL を保持して触る
+// （アイドル処理も GIL を取ってから触る）
+class ThumbnailCache : public std::enable_shared_from_this<ThumbnailCache> {
+public:
+    ThumbnailCache(int size, const std::optional<std::string>& directory, uint64_t maxMemoryBytes,
+                   double budgetMs, double time)
+        : m_size(size), m_directory(directory), m_maxMemoryBytes(maxMemoryBytes), m_time(time)
+    {
+        if (size < 1 || size > 1024) {
+            throw std::invalid_argument("size must be between 1 and 1024");
+        }
+        SetBudgetMs(budgetMs);
+    }
+
+    // あればすぐ返す。ない・古いものはアイドル処理で作る（wait なら今作る）
+    std::shared_ptr<ThumbnailImage> Get(py::object item, bool wait)
+    {
+        AEGP_ItemH itemH = PyRenderer::ResolveItem(item);
+        uint32_t itemId = ItemIdOf(itemH);
+        ThumbnailStore& store = Store();
+
+        bool stale = false;
+        ThumbnailStore::ThumbnailPtr thumbnail = Lookup(store, itemH, itemId, stale);
+        if (thumbnail && !stale) {
+            return std::make_shared<ThumbnailImage>(thumbnail, false);
+        }
+        if (wait) {
+            if (ThumbnailStore::ThumbnailPtr fresh = Generate(store, itemH, itemId)) {
+                Deliver(itemId, fresh);
+                return std::make_shared<ThumbnailImage>(fresh, false);
+            }
+        } else {
+            Enqueue(itemId);
+        }
+        return thumbnail ? std::make_shared<ThumbnailImage>(thumbnail, true) : nullptr;
+    }
+
+    // items のサムネイルを作るよう予約する。有効なものはすぐ callback を呼ぶ
+    size_t Request(py::iterable items, py::object callback)
+    {
+        if (!callback.is_none() && !PyCallable_Check(callback.ptr())) {
+            throw std::invalid_argument("callback must be callable");
+        }
+
+        // 先にすべて解決して、途中で失敗しても何も積まない
+        std::vector<std::pair<AEGP_ItemH, uint32_t>> resolved;
+        for (py::handle item : items) {
+            AEGP_ItemH itemH = PyRenderer::ResolveItem(py::reinterpret_borrow<py::object>(item));
+            resolved.emplace_back(itemH, ItemIdOf(itemH));
+        }
+
+        ThumbnailStore& store = Store();
+        size_t queued = 0;
+        for (const auto& entry : resolved) {
+            bool stale = false;
+            ThumbnailStore::ThumbnailPtr thumbnail = Lookup(store, entry.first, entry.second, stale);
+            if (thumbnail && !stale) {
+                if (!callback.is_none()) {
+                    Invoke(callback, entry.second, thumbnail);
+                }
+                continue;
+            }
+            if (!callback.is_none()) {
+                m_callbacks[entry.second].push_back(callback);
+            }
+            if (Enqueue(entry.second)) {
+                queued++;
+            }
+        }
+        return queued;
+    }
+
+    // 予約済みのサムネイルを作る（アイドル処理を待たない）。作った数を返す
+    size_t Process(std::optional<double> budgetMs)
+    {
+        return Run(budgetMs ? (std::max)(*budgetMs, 0.0) : -1.0);
+    }
+
+    size_t Invalidate(py::object item)
+    {
+        ThumbnailStore& store = Store();
+        if (item.is_none()) {
+            m_failed.clear();
+            return store.Clear();
+        }
+        uint32_t itemId = ItemIdOf(PyRenderer::ResolveItem(item));
+        m_failed.erase(itemId);
+        return store.Erase(itemId) ? 1 : 0;
+    }
+
+    // 予約を取り消してキャッシュを空にする
+    void Clear()
+    {
+        m_pending.clear();
+        m_queued.clear();
+        m_callbacks.clear();
+        m_failed.clear();
+        Store().Clear();
+    }
+
+    size_t GetPendingCount() const { return m_pending.size(); }
+    int GetSize() const { return m_size; }
+    double GetTime() const { return m_time; }
+    double GetBudgetMs() const { return m_budgetMs; }
+
+    void SetBudgetMs(double budgetMs)
+    {
+        if (!(budgetMs > 0.0)) {
+            throw std::invalid_argument("budget_ms must be positive");
+        }
+        m_budgetMs = budgetMs;
+    }
+
+    py::object GetDirectory()
+    {
+        const std::string& directory = Store().GetDirectory();
+        return directory.empty() ? py::object(py::none()) : py::object(py::str(directory));
+    }
+
+    py::dict GetStats()
+    {
+        ThumbnailStore::Stats stats = Store().GetStats();
+        py::dict result;
+        result["hits"] = stats.hits;
+        result["disk_hits"] = stats.diskHits;
+        result["misses"] = stats.misses;
+        result["stale"] = m_staleCount;
+        result["adopted"] = m_adopted;
+        result["generated"] = m_generated;
+        result["failures"] = m_failures;
+        result["generate_seconds"] = m_generateSeconds;
+        result["pending"] = m_pending.size();
+        result["evictions"] = stats.evictions;
+        result["disk_writes"] = stats.diskWrites;
+        result["disk_errors"] = stats.diskErrors;
+        result["memory_entries"] = stats.memoryEntries;
+        result["memory_bytes"] = stats.memoryBytes;
+        result["disk_entries"] = stats.diskEntries;
+        result["disk_bytes"] = stats.diskBytes;
+        result["compression_ratio"] = stats.rawBytes > 0
+            ? static_cast<double>(stats.diskBytes) / static_cast<double>(stats.rawBytes) : 0.0;
+        result["max_memory_bytes"] = stats.maxMemoryBytes;
+        return result;
+    }
+
+private:
+    // 開いているプロジェクト用のストア（プロジェクトが変わったら作り直す）
+    ThumbnailStore& Store()
+    {
+        ProjectState project = GetProjectState();
+        if (m_store && project.path == m_projectPath) {
+            return *m_store;
+        }
+
+        std::string directory;
+        // 未保存のプロジェクトはメモリだけ。サイズと時刻ごとに別のディレクトリにする
+        if (!(m_directory && m_directory->empty()) && !project.path.empty()) {
+            std::filesystem::path base = m_directory
+                ? std::filesystem::path(StringUtils::Utf8ToWide(*m_directory))
+                : std::filesystem::temp_directory_path() / "PyAE" / "thumbnails";
+            char name[48];
+            std::snprintf(name, sizeof(name), "%016llx_%d_%lld",
+                          static_cast<unsigned long long>(Fnv1a(project.path)), m_size,
+                          static_cast<long long>(std::llround(m_time * 1000.0)));
+            directory = StringUtils::WideToUtf8((base / name).wstring());
+        }
+
+        // 別のプロジェクトのアイテム ID は意味がないので予約も捨てる
+        if (m_store) {
+            m_pending.clear();
+            m_queued.clear();
+            m_callbacks.clear();
+            m_failed.clear();
+        }
+        m_store = std::make_unique<ThumbnailStore>(m_maxMemoryBytes, directory);
+        m_projectPath = project.path;
+        return *m_store;
+    }
+
+    // 有効なら stale = false。前のセッションのものは条件を満たせば取り込む
+    ThumbnailStore::ThumbnailPtr Lookup(ThumbnailStore& store, AEGP_ItemH itemH, uint32_t itemId,
+                                        bool& stale)
+    {
+        stale = false;
+        ThumbnailStore::ThumbnailPtr thumbnail = store.Find(itemId);
+        if (!thumbnail) {
+            return nullptr;
+        }
+
+        ProjectState project = GetProjectState();
+        if (thumbnail->session == SessionId()) {
+            if (!PyRenderer::HasItemChangedSinceTimestamp(reinterpret_cast<uintptr_t>(itemH), m_time, 0.0,
+                                                          FromStamp(thumbnail->stamp))) {
+                // 保存された後なら、次のセッションで使えるように更新時刻を記録し直す
+                if (project.StampTime() != 0 && thumbnail->projectTime != project.StampTime()) {
+                    thumbnail = store.Restamp(thumbnail, thumbnail->stamp, SessionId(), project.StampTime());
+                }
+                return thumbnail;
+            }
+        } else if (thumbnail->projectTime != 0 && thumbnail->projectTime == project.StampTime()) {
+            // プロジェクトファイルは作ったときのまま: 今のタイムスタンプで使い続ける
+            m_adopted++;
+            return store.Restamp(thumbnail, ToStamp(PyRenderer::GetCurrentTimestamp()),
+                                 SessionId(), project.StampTime());
+        }
+
+        m_staleCount++;
+        stale = true;
+        return thumbnail;
+    }
+
+    // レンダーして保存する（失敗したら nullptr、作り直しは invalidate まで止める）
+    ThumbnailStore::ThumbnailPtr Generate(ThumbnailStore& store, AEGP_ItemH itemH, uint32_t itemId)
+    {
+        auto start = std::chrono::steady_clock::now();
+        ThumbnailStore::ThumbnailPtr result;
+        try {
+            const auto& suites = PluginState::Instance().GetSuites();
+            A_long width = 0;
+            A_long height = 0;
+            if (!suites.itemSuite ||
+                suites.itemSuite->AEGP_GetItemDimensions(itemH, &width, &height) != A_Err_NONE ||
+                width <= 0 || height <= 0) {
+                throw std::runtime_error("Item has no image");
+            }
+
+            // 描画中の変更も検出できるようにレンダー前のタイムスタンプを使う
+            ThumbnailStore::Stamp stamp = ToStamp(PyRenderer::GetCurrentTimestamp());
+            std::shared_ptr<PyRenderOptions> options = PyRenderOptions::Acquire(reinterpret_cast<uintptr_t>(itemH));
+            int factor = static_cast<int>(std::ceil(
+                static_cast<double>((std::max)(width, height)) / static_cast<double>(m_size)));
+            factor = (std::max)(factor, 1);
+            options->SetWorldType(WorldType::BIT8);
+            options->SetTime(m_time);
+            options->SetDownsampleFactor(factor, factor);
+
+            std::shared_ptr<PyFrameReceipt> receipt = PyRenderer::RenderFrame(options);
+            if (!receipt) {
+                throw std::runtime_error("Render was aborted");
+            }
+            ThumbnailStore::Thumbnail thumbnail;
+            try {
+                PixelConvert::ImageView src = receipt->GetWorld()->GetImageView();
+                double scale = (std::min)({static_cast<double>(m_size) / src.width,
+                                           static_cast<double>(m_size) / src.height, 1.0});
+                thumbnail.width = (std::max)(1, static_cast<int>(std::lround(src.width * scale)));
+                thumbnail.height = (std::max)(1, static_cast<int>(std::lround(src.height * scale)));
+                thumbnail.pixels.resize(static_cast<size_t>(thumbnail.width) * thumbnail.height * 4);
+                ImageResize::Resize(src, thumbnail.View(), ImageResize::Filter::Area);
+            } catch (...) {
+                receipt->Checkin();
+                throw;
+            }
+            receipt->Checkin();
+
+            thumbnail.itemId = itemId;
+            thumbnail.stamp = stamp;
+            thumbnail.session = SessionId();
+            thumbnail.projectTime = GetProjectState().StampTime();
+            result = store.Insert(std::move(thumbnail));
+            m_generated++;
+        } catch (const py::error_already_set& e) {
+            PYAE_LOG_ERROR("ThumbnailCache", std::string("Thumbnail failed: ") + e.what());
+        } catch (const std::exception& e) {
+            PYAE_LOG_ERROR("ThumbnailCache", std::string("Thumbnail failed: ") + e.what());
+        }
+        if (!result) {
+            m_failures++;
+            m_failed.insert(itemId);
+        }
+        m_generateSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    bool Enqueue(uint32_t itemId)
+    {
+        if (m_failed.count(itemId) != 0 || !m_queued.insert(itemId).second) {
+            return false;
+        }
+        m_pending.push_back(itemId);
+        Schedule();
+        return true;
+    }
+
+    void Schedule()
+    {
+        if (m_scheduled) {
+            return;
+        }
+        m_scheduled = true;
+        std::weak_ptr<ThumbnailCache> weak = weak_from_this();
+        IdleHandler::Instance().EnqueueTask([weak]() {
+            // アイドル処理は GIL なしで呼ばれる
+            ScopedGIL gil;
+            if (auto self = weak.lock()) {
+                self->OnIdle();
+            }
+        }, TaskPriority::Low, "ae.ThumbnailCache");
+    }
+
+    void OnIdle()
+    {
+        m_scheduled = false;
+        // 同じアイドル呼び出しで使った時間も budget に含める
+        uint64_t idleCall = IdleHandler::Instance().GetIdleCallCount();
+        if (idleCall != m_idleCall) {
+            m_idleCall = idleCall;
+            m_idleSpentMs = 0.0;
+        }
+        if (m_idleSpentMs < m_budgetMs) {
+            auto start = std::chrono::steady_clock::now();
+            try {
+                Run(m_budgetMs - m_idleSpentMs);
+            } catch (const std::exception& e) {
+                PYAE_LOG_ERROR("ThumbnailCache", std::string("Idle generation failed: ") + e.what());
+                m_pending.clear();
+                m_queued.clear();
+            }
+            m_idleSpentMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        if (!m_pending.empty()) {
+            Schedule();
+        }
+    }
+
+    // budgetMs の間、予約を順に作る（少なくとも1件。負なら全部）
+    size_t Run(double budgetMs)
+    {
+        auto start = std::chrono::steady_clock::now();
+        size_t processed = 0;
+        while (!m_pending.empty()) {
+            if (processed > 0 && budgetMs >= 0.0 &&
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() >= budgetMs) {
+                break;
+            }
+            ThumbnailStore& store = Store();
+            if (m_pending.empty()) {
+                break;      // プロジェクトが変わった
+            }
+            uint32_t itemId = m_pending.front();
+            m_pending.pop_front();
+            m_queued.erase(itemId);
+
+            ThumbnailStore::ThumbnailPtr thumbnail;
+            if (AEGP_ItemH itemH = FindItemById(itemId)) {
+                bool stale = false;
+                thumbnail = Lookup(store, itemH, itemId, stale);
+                if (!thumbnail || stale) {
+                    thumbnail = Generate(store, itemH, itemId);
+                }
+            } else {
+                store.Erase(itemId);
+            }
+            processed++;
+            Deliver(itemId, thumbnail);
+        }
+        return processed;
+    }
+
+    void Deliver(uint32_t itemId, const ThumbnailStore::ThumbnailPtr& thumbnail)
+    {
+        auto it = m_callbacks.find(itemId);
+        if (it == m_callbacks.end()) {
+            return;
+        }
+        std::vector<py::object> callbacks;
+        callbacks.swap(it->second);
+        m_callbacks.erase(it);
+        for (const auto& callback : callbacks) {
+            Invoke(callback, itemId, thumbnail);
+        }
+    }
+
+    static void Invoke(const py::object& callback, uint32_t itemId,
+                       const ThumbnailStore::ThumbnailPtr& thumbnail)
+    {
+        try {
+            if (thumbnail) {
+                callback(itemId, std::make_shared<ThumbnailImage>(thumbnail, false));
+            } else {
+                callback(itemId, py::none());
+            }
+        } catch (const py::error_already_set& e) {
+            PYAE_LOG_ERROR("ThumbnailCache", std::string("Python callback error: ") + e.what());
+        } catch (const std::exception& e) {
+            PYAE_LOG_ERROR("ThumbnailCache", std::string("Callback error: ") + e.what());
+        }
+    }
+
+    int m_size;
+    std::optional<std::string> m_directory;     // None は一時ディレクトリ、"" はメモリだけ
+    uint64_t m_maxMemoryBytes;
+    double m_budgetMs = kDefaultBudgetMs;
+    double m_time;
+
+    std::unique_ptr<ThumbnailStore> m_store;
+    std::string m_projectPath;
+
+    std::deque<uint32_t> m_pending;
+    std::unordered_set<uint32_t> m_queued;
+    std::unordered_set<uint32_t> m_failed;
+    std::unordered_map<uint32_t, std::vector<py::object>> m_callbacks;
+    bool m_scheduled = false;
+    uint64_t m_idleCall = 0;
+    double m_idleSpentMs = 0.0;
+
+    uint64_t m_generated = 0;
+    uint64_t m_failures = 0;
+    uint64_t m_adopted = 0;
+    uint64_t m_staleCount = 0;
+    double m_generateSeconds = 0.0;
+};
+
+void init_thumbnail_cache(py::module_& m)
+{
+    py::class_<ThumbnailImage, std::shared_ptr<ThumbnailImage>>(m, "Thumbnail", py::buffer_protocol(),
+        "Small 8-bit RGBA image of a project item (read-only).\n\n"
+        "Supports the buffer protocol without copying: numpy.asarray(thumb)\n"
+        "gives a (height, width, 4) uint8 RGBA array, and to_bytes() can be\n"
+        "passed to QImage(..., QImage.Format_RGBA8888).")
+        .def_buffer([](ThumbnailImage& self) -> py::buffer_info {
+            return self.GetBufferInfo();
+        })
+        .def_property_readonly("width", &ThumbnailImage::GetWidth)
+        .def_property_readonly("height", &ThumbnailImage::GetHeight)
+        .def_property_readonly("item_id", &ThumbnailImage::GetItemId)
+        .def_property_readonly("stale", &ThumbnailImage::IsStale,
+            "True if the item changed since the thumbnail was made\n"
+            "(a new one is being generated)")
+        .def_property_readonly("nbytes", &ThumbnailImage::GetByteCount)
+        .def_property_readonly("timestamp", &ThumbnailImage::GetTimestamp,
+            "Project timestamp the thumbnail was validated against")
+        .def("to_bytes", &ThumbnailImage::ToBytes,
+            "Return the RGBA pixels as bytes (rows packed, 4 bytes per pixel)")
+        .def("to_world", &ThumbnailImage::ToWorld,
+            "Copy the pixels into a new 8-bit World");
+
+    py::class_<ThumbnailCache, std::shared_ptr<ThumbnailCache>>(m, "ThumbnailCache",
+        "Thumbnails of project items, generated on idle and kept on disk.\n\n"
+        "get() returns a thumbnail immediately if one is cached and queues\n"
+        "items without one. Queued items are rendered at 8 bpc with a\n"
+        "downsample factor, shrunk to fit size x size and stored compressed\n"
+        "on disk, spending at most budget_ms per idle call so the UI stays\n"
+        "responsive.\n\n"
+        "A thumbnail is reused while the item is unchanged: within a session\n"
+        "this is checked with project timestamps, across sessions by the\n"
+        "modification time of the saved project file. A thumbnail of a\n"
+        "changed item is returned with stale=True while it is regenerated.\n\n"
+        "Example:\n"
+        "    cache = ae.ThumbnailCache(size=96)\n"
+        "    thumb = cache.get(comp)          # None until generated\n"
+        "    cache.request(proj.items, lambda item_id, thumb: update(item_id, thumb))")
+        .def(py::init([](int size, std::optional<std::string> directory, uint64_t maxMemoryBytes,
+                         double budgetMs, double time) {
+            return std::make_shared<ThumbnailCache>(size, directory, maxMemoryBytes, budgetMs, time);
+        }),
+            "Args:\n"
+            "    size: Longest side of a thumbnail in pixels (default 160)\n"
+            "    directory: Cache directory (default: PyAE/thumbnails in the temp\n"
+            "               directory, \"\" keeps thumbnails in memory only).\n"
+            "               Each saved project gets its own subdirectory.\n"
+            "    max_memory_bytes: Memory budget for thumbnails (default 64 MiB)\n"
+            "    budget_ms: Time spent generating per idle call (default 10 ms)\n"
+            "    time: Time of the frame shown, in seconds (default 0.0)",
+            py::arg("size") = kDefaultSize,
+            py::arg("directory") = py::none(),
+            py::arg("max_memory_bytes") = kDefaultMaxMemoryBytes,
+            py::arg("budget_ms") = kDefaultBudgetMs,
+            py::arg("time") = 0.0)
+
+        .def("get", &ThumbnailCache::Get,
+            "Return the thumbnail of item, queueing it if missing or changed.\n\n"
+            "Args:\n"
+            "    item: Comp, CompItem, Item or item handle\n"
+            "    wait: Generate now instead of on idle\n\n"
+            "Returns:\n"
+            "    Thumbnail or None: None if nothing is cached yet",
+            py::arg("item"), py::arg("wait") = false)
+
+        .def("request", &ThumbnailCache::Request,
+            "Queue thumbnails of items.\n\n"
+            "callback(item_id, thumbnail) is called once per item: immediately\n"
+            "for items with a valid thumbnail, otherwise on idle after it is\n"
+            "generated (thumbnail is None if the item cannot be rendered).\n\n"
+            "Returns:\n"
+            "    int: Number of items newly queued",
+            py::arg("items"), py::arg("callback") = py::none())
+
+        .def("process", &ThumbnailCache::Process,
+            "Generate queued thumbnails now, for up to budget_ms\n"
+            "(default: all of them).\n\n"
+            "Returns:\n"
+            "    int: Number of queued items processed",
+            py::arg("budget_ms") = py::none())
+
+        .def("invalidate", &ThumbnailCache::Invalidate,
+            "Drop the thumbnail of item (all thumbnails if None).\n\n"
+            "Returns:\n"
+            "    int: Number of thumbnails dropped",
+            py::arg("item") = py::none())
+
+        .def("clear", &ThumbnailCache::Clear,
+            "Cancel queued items and drop all thumbnails")
+
+        .def_property_readonly("pending", &ThumbnailCache::GetPendingCount,
+            "Number of items waiting to be generated")
+        .def_property_readonly("size", &ThumbnailCache::GetSize)
+        .def_property_readonly("time", &ThumbnailCache::GetTime)
+        .def_property("budget_ms", &ThumbnailCache::GetBudgetMs, &ThumbnailCache::SetBudgetMs,
+            "Time spent generating per idle call in milliseconds")
+        .def_property_readonly("directory", &ThumbnailCache::GetDirectory,
+            "Directory of the current project's thumbnails, or None if in memory only")
+        .def_property_readonly("stats", &ThumbnailCache::GetStats,
+            "dict: hits, disk_hits, misses, stale, adopted, generated, failures,\n"
+            "generate_seconds, pending, evictions, disk_writes, disk_errors,\n"
+            "memory_entries, memory_bytes, disk_entries, disk_bytes,\n"
+            "compression_ratio, max_memory_bytes");
+}
+
+} // namespace PyAE
@@ -5,8 +5,22 @@
 // WorldSuite3の高レベルAPI
 
 #include "PyWorldClasses.h"
+#include "ImageCompare.h"
+#include "ImageResize.h"
+#include "ImageStats.h"
+#include "PixelKernels.h"
 #include "PluginState.h"
 #include "ScopedHandles.h"
+#include "WorldPool.h"
+
+#include <pybind11/numpy.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
 
 namespace PyAE {
 
@@ -33,14 +47,28 @@ PyWorld::PyWorld(AEGP_WorldH worldH, bool owned)
     : m_worldH(worldH)
     , m_owned(owned)
 {
+    if (!m_worldH) {
+        return;
+    }
+    try {
+        m_desc = QueryDesc(m_worldH);
+    } catch (...) {
+        // 例外でデストラクタが呼ばれないので、所有するハンドルはここで返す
+        if (m_owned) {
+            WorldPool::Instance().Release(m_worldH);
+        }
+        throw;
+    }
 }
 
 PyWorld::PyWorld(PyWorld&& other) noexcept
     : m_worldH(other.m_worldH)
     , m_owned(other.m_owned)
+    , m_desc(other.m_desc)
 {
     other.m_worldH = nullptr;
     other.m_owned = false;
+    other.m_desc = WorldDesc();
 }
 
 PyWorld& PyWorld::operator=(PyWorld&& other) noexcept
@@ -49,8 +77,10 @@ PyWorld& PyWorld::operator=(PyWorld&& other) noexcept
         Dispose();
         m_worldH = other.m_worldH;
         m_owned = other.m_owned;
+        m_desc = other.m_desc;
         other.m_worldH = nullptr;
         other.m_owned = false;
+        other.m_desc = WorldDesc();
     }
     return *this;
 }
@@ -63,216 +93,980 @@ PyWorld::~PyWorld()
 void PyWorld::Dispose()
 {
     if (m_worldH && m_owned) {
-        auto& state = PluginState::Instance();
-        const auto& suites = state.GetSuites();
-        if (suites.worldSuite) {
-            suites.worldSuite->AEGP_Dispose(m_worldH);
-        }
+        // プールへ返却（上限を超える場合などはプール側で破棄）
+        WorldPool::Instance().Release(m_worldH);
         m_worldH = nullptr;
         m_owned = false;
+        m_desc = WorldDesc();
     }
 }
 
+void PyWorld::Invalidate()
+{
+    if (m_owned) {
+        Dispose();
+        return;
+    }
+    m_worldH = nullptr;
+    m_desc = WorldDesc();
+}
+
 bool PyWorld::IsValid() const
 {
     return m_worldH != nullptr;
 }
 
-WorldType PyWorld::GetType() const
+const WorldDesc& PyWorld::GetDesc() const
 {
     if (!m_worldH) {
         throw std::runtime_error("Invalid world");
     }
+    return m_desc;
+}
 
+WorldDesc PyWorld::QueryDesc(AEGP_WorldH worldH)
+{
     auto& state = PluginState::Instance();
     const auto& suites = state.GetSuites();
     if (!suites.worldSuite) {
         throw std::runtime_error("World Suite not available");
     }
 
+    WorldDesc desc;
+
     AEGP_WorldType type = AEGP_WorldType_NONE;
-    A_Err err = suites.worldSuite->AEGP_GetType(m_worldH, &type);
+    A_Err err = suites.worldSuite->AEGP_GetType(worldH, &type);
     if (err != A_Err_NONE) {
         throw std::runtime_error("AEGP_GetType failed");
     }
+    desc.type = static_cast<WorldType>(type);
 
-    return static_cast<WorldType>(type);
-}
-
-int PyWorld::GetWidth() const
-{
-    if (!m_worldH) {
-        throw std::runtime_error("Invalid world");
+    A_long width = 0;
+    A_long height = 0;
+    err = suites.worldSuite->AEGP_GetSize(worldH, &width, &height);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("AEGP_GetSize failed");
     }
+    desc.width = static_cast<int>(width);
+    desc.height = static_cast<int>(height);
 
-    auto& state = PluginState::Instance();
-    const auto& suites = state.GetSuites();
-    if (!suites.worldSuite) {
-        throw std::runtime_error("World Suite not available");
+    A_u_long rowbytes = 0;
+    err = suites.worldSuite->AEGP_GetRowBytes(worldH, &rowbytes);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("AEGP_GetRowBytes failed");
     }
+    desc.rowBytes = static_cast<int>(rowbytes);
 
-    A_long width = 0;
-    A_long height = 0;
-    A_Err err = suites.worldSuite->AEGP_GetSize(m_worldH, &width, &height);
+    switch (desc.type) {
+        case WorldType::BIT8: {
+            PF_Pixel8* addr8 = nullptr;
+            err = suites.worldSuite->AEGP_GetBaseAddr8(worldH, &addr8);
+            desc.baseAddr = addr8;
+            desc.bytesPerPixel = sizeof(PF_Pixel8);
+            break;
+        }
+        case WorldType::BIT16: {
+            PF_Pixel16* addr16 = nullptr;
+            err = suites.worldSuite->AEGP_GetBaseAddr16(worldH, &addr16);
+            desc.baseAddr = addr16;
+            desc.bytesPerPixel = sizeof(PF_Pixel16);
+            break;
+        }
+        case WorldType::BIT32: {
+            PF_PixelFloat* addr32 = nullptr;
+            err = suites.worldSuite->AEGP_GetBaseAddr32(worldH, &addr32);
+            desc.baseAddr = addr32;
+            desc.bytesPerPixel = sizeof(PF_PixelFloat);
+            break;
+        }
+        default:
+            // 型が無いワールドでもサイズなどは参照できる（画素アクセスは GetBaseAddr で拒否）
+            break;
+    }
     if (err != A_Err_NONE) {
-        throw std::runtime_error("AEGP_GetSize failed");
+        throw std::runtime_error("Failed to get base address");
     }
 
-    return static_cast<int>(width);
+    return desc;
 }
 
-int PyWorld::GetHeight() const
+void PyWorld::Refresh()
 {
     if (!m_worldH) {
         throw std::runtime_error("Invalid world");
     }
+    m_desc = QueryDesc(m_worldH);
+}
 
-    auto& state = PluginState::Instance();
-    const auto& suites = state.GetSuites();
-    if (!suites.worldSuite) {
-        throw std::runtime_error("World Suite not available");
-    }
+WorldType PyWorld::GetType() const
+{
+    return GetDesc().type;
+}
 
-    A_long width = 0;
-    A_long height = 0;
-    A_Err err = suites.worldSuite->AEGP_GetSize(m_worldH, &width, &height);
-    if (err != A_Err_NONE) {
-        throw std::runtime_error("AEGP_GetSize failed");
-    }
+int PyWorld::GetWidth() const
+{
+    return GetDesc().width;
+}
 
-    return static_cast<int>(height);
+int PyWorld::GetHeight() const
+{
+    return GetDesc().height;
 }
 
 std::tuple<int, int> PyWorld::GetSize() const
+{
+    const WorldDesc& desc = GetDesc();
+    return std::make_tuple(desc.width, desc.height);
+}
+
+int PyWorld::GetRowBytes() const
+{
+    return GetDesc().rowBytes;
+}
+
+void* PyWorld::GetBaseAddr() const
+{
+    const WorldDesc& desc = GetDesc();
+    if (!desc.baseAddr) {
+        throw std::runtime_error("Unsupported world type");
+    }
+    return desc.baseAddr;
+}
+
+py::bytes PyWorld::GetPixels() const
 {
     if (!m_worldH) {
         throw std::runtime_error("Invalid world");
     }
 
-    auto& state = PluginState::Instance();
-    const auto& suites = state.GetSuites();
-    if (!suites.worldSuite) {
-        throw std::runtime_error("World Suite not available");
+    void* baseAddr = GetBaseAddr();
+    if (!baseAddr) {
+        throw std::runtime_error("Failed to get base address");
     }
 
-    A_long width = 0;
-    A_long height = 0;
-    A_Err err = suites.worldSuite->AEGP_GetSize(m_worldH, &width, &height);
-    if (err != A_Err_NONE) {
-        throw std::runtime_error("AEGP_GetSize failed");
-    }
+    int rowBytes = GetRowBytes();
+    int height = GetHeight();
+    size_t totalBytes = static_cast<size_t>(rowBytes) * static_cast<size_t>(height);
 
-    return std::make_tuple(static_cast<int>(width), static_cast<int>(height));
+    return py::bytes(static_cast<const char*>(baseAddr), totalBytes);
 }
 
-int PyWorld::GetRowBytes() const
+void PyWorld::SetPixels(const py::buffer& data)
 {
     if (!m_worldH) {
         throw std::runtime_error("Invalid world");
     }
 
-    auto& state = PluginState::Instance();
-    const auto& suites = state.GetSuites();
-    if (!suites.worldSuite) {
-        throw std::runtime_error("World Suite not available");
+    void* baseAddr = GetBaseAddr();
+    if (!baseAddr) {
+        throw std::runtime_error("Failed to get base address");
     }
 
-    A_u_long rowbytes = 0;
-    A_Err err = suites.worldSuite->AEGP_GetRowBytes(m_worldH, &rowbytes);
-    if (err != A_Err_NONE) {
-        throw std::runtime_error("AEGP_GetRowBytes failed");
+    int rowBytes = GetRowBytes();
+    int height = GetHeight();
+    size_t totalBytes = static_cast<size_t>(rowBytes) * static_cast<size_t>(height);
+
+    py::buffer_info info = data.request();
+
+    // Only C-contiguous sources can be copied with a single memcpy
+    py::ssize_t expectedStride = info.itemsize;
+    for (py::ssize_t dim = info.ndim - 1; dim >= 0; --dim) {
+        if (info.shape[dim] > 1 && info.strides[dim] != expectedStride) {
+            throw std::runtime_error("Pixel data must be a C-contiguous buffer");
+        }
+        expectedStride *= info.shape[dim];
+    }
+
+    size_t dataBytes = static_cast<size_t>(info.size) * static_cast<size_t>(info.itemsize);
+    if (dataBytes != totalBytes) {
+        throw std::runtime_error("Data size mismatch. Expected " +
+            std::to_string(totalBytes) + " bytes, got " +
+            std::to_string(dataBytes));
     }
 
-    return static_cast<int>(rowbytes);
+    // Writing the world's own view back is a no-op
+    if (info.ptr != baseAddr) {
+        std::memmove(baseAddr, info.ptr, totalBytes);
+    }
 }
 
-void* PyWorld::GetBaseAddr() const
+py::buffer_info PyWorld::GetBufferInfo() const
 {
     if (!m_worldH) {
         throw std::runtime_error("Invalid world");
     }
 
-    auto& state = PluginState::Instance();
-    const auto& suites = state.GetSuites();
-    if (!suites.worldSuite) {
-        throw std::runtime_error("World Suite not available");
-    }
-
     WorldType type = GetType();
-    void* baseAddr = nullptr;
-    A_Err err = A_Err_NONE;
-
+    py::ssize_t channelBytes = 0;
+    std::string format;
     switch (type) {
-        case WorldType::BIT8: {
-            PF_Pixel8* addr8 = nullptr;
-            err = suites.worldSuite->AEGP_GetBaseAddr8(m_worldH, &addr8);
-            baseAddr = addr8;
+        case WorldType::BIT8:
+            channelBytes = sizeof(PF_Pixel8) / 4;
+            format = py::format_descriptor<uint8_t>::format();
             break;
-        }
-        case WorldType::BIT16: {
-            PF_Pixel16* addr16 = nullptr;
-            err = suites.worldSuite->AEGP_GetBaseAddr16(m_worldH, &addr16);
-            baseAddr = addr16;
+        case WorldType::BIT16:
+            channelBytes = sizeof(PF_Pixel16) / 4;
+            format = py::format_descriptor<uint16_t>::format();
             break;
-        }
-        case WorldType::BIT32: {
-            PF_PixelFloat* addr32 = nullptr;
-            err = suites.worldSuite->AEGP_GetBaseAddr32(m_worldH, &addr32);
-            baseAddr = addr32;
+        case WorldType::BIT32:
+            channelBytes = sizeof(PF_PixelFloat) / 4;
+            format = py::format_descriptor<float>::format();
             break;
-        }
         default:
             throw std::runtime_error("Unsupported world type");
     }
 
-    if (err != A_Err_NONE) {
+    void* baseAddr = GetBaseAddr();
+    if (!baseAddr) {
         throw std::runtime_error("Failed to get base address");
     }
 
-    return baseAddr;
+    auto [width, height] = GetSize();
+    py::ssize_t rowBytes = GetRowBytes();
+
+    // (height, width, channel) in ARGB order; rows honor the world's row stride
+    return py::buffer_info(
+        baseAddr,
+        channelBytes,
+        format,
+        3,
+        { static_cast<py::ssize_t>(height), static_cast<py::ssize_t>(width), py::ssize_t(4) },
+        { rowBytes, channelBytes * 4, channelBytes },
+        !m_owned);  // レシートのワールドは AE のメモリなので書き込ませない
 }
 
-py::bytes PyWorld::GetPixels() const
+// WorldType と PixelConvert のチャンネル型の対応
+static PixelConvert::Depth ToDepth(WorldType type)
+{
+    switch (type) {
+        case WorldType::BIT8: return PixelConvert::Depth::U8;
+        case WorldType::BIT16: return PixelConvert::Depth::U16;
+        case WorldType::BIT32: return PixelConvert::Depth::F32;
+        default: throw std::runtime_error("Unsupported world type");
+    }
+}
+
+// Python バッファの形式文字（バイトオーダー接頭辞を除く）からチャンネル型を決める
+static PixelConvert::Depth DepthFromFormat(const py::buffer_info& info)
+{
+    char code = info.format.empty() ? '\0' : info.format.back();
+    if (code == 'B' && info.itemsize == 1) return PixelConvert::Depth::U8;
+    if (code == 'H' && info.itemsize == 2) return PixelConvert::Depth::U16;
+    if (code == 'f' && info.itemsize == 4) return PixelConvert::Depth::F32;
+    throw std::runtime_error("Pixel data must be uint8, uint16 or float32, got format '" +
+        info.format + "'");
+}
+
+static bool IsCContiguous(const py::buffer_info& info)
+{
+    py::ssize_t expectedStride = info.itemsize;
+    for (py::ssize_t dim = info.ndim - 1; dim >= 0; --dim) {
+        if (info.shape[dim] > 1 && info.strides[dim] != expectedStride) {
+            return false;
+        }
+        expectedStride *= info.shape[dim];
+    }
+    return true;
+}
+
+// 詰めて並べた width x height の画像
+static PixelConvert::ImageView PackedView(void* data, int width, int height,
+                                          PixelConvert::Depth depth, PixelConvert::Layout layout)
+{
+    PixelConvert::ImageView view;
+    view.data = data;
+    view.width = width;
+    view.height = height;
+    view.depth = depth;
+    view.layout = layout;
+    ptrdiff_t channels = layout == PixelConvert::Layout::Planar ? 1 : 4;
+    view.rowBytes = static_cast<ptrdiff_t>(width) * channels *
+        static_cast<ptrdiff_t>(PixelConvert::ChannelBytes(depth));
+    view.planeBytes = layout == PixelConvert::Layout::Planar ? view.rowBytes * height : 0;
+    return view;
+}
+
+PixelConvert::ImageView PyWorld::GetImageView() const
 {
     if (!m_worldH) {
         throw std::runtime_error("Invalid world");
     }
 
-    void* baseAddr = GetBaseAddr();
-    if (!baseAddr) {
-        throw std::runtime_error("Failed to get base address");
+    const WorldDesc& desc = GetDesc();
+    PixelConvert::ImageView view;
+    view.depth = ToDepth(desc.type);
+    view.layout = PixelConvert::Layout::ARGB;
+    view.data = GetBaseAddr();
+    view.width = desc.width;
+    view.height = desc.height;
+    view.rowBytes = desc.rowBytes;
+    return view;
+}
+
+// 画像内の矩形を指す部分ビュー（範囲チェックは呼び出し側）
+static PixelConvert::ImageView SubView(const PixelConvert::ImageView& view,
+                                       int x, int y, int width, int height)
+{
+    PixelConvert::ImageView sub = view;
+    sub.data = static_cast<uint8_t*>(view.data) + static_cast<ptrdiff_t>(y) * view.rowBytes +
+        static_cast<ptrdiff_t>(x) * 4 * static_cast<ptrdiff_t>(PixelConvert::ChannelBytes(view.depth));
+    sub.width = width;
+    sub.height = height;
+    return sub;
+}
+
+static void CheckRegion(const PixelConvert::ImageView& view, int x, int y, int width, int height)
+{
+    if (width <= 0 || height <= 0) {
+        throw std::runtime_error("Region size must be positive");
+    }
+    if (x < 0 || y < 0 || x > view.width - width || y > view.height - height) {
+        throw std::runtime_error("Region out of range");
     }
+}
 
-    int rowBytes = GetRowBytes();
-    int height = GetHeight();
-    size_t totalBytes = static_cast<size_t>(rowBytes) * static_cast<size_t>(height);
+// 矩形を画像内に切り詰める（空になった場合は false）。
+// 右端・下端は int64 で求めるので x + width が int を超えてもよい
+static bool ClipRegion(const PixelConvert::ImageView& view, int64_t x, int64_t y,
+                       int64_t width, int64_t height,
+                       int& outX, int& outY, int& outWidth, int& outHeight)
+{
+    int64_t x0 = (std::max)(int64_t(0), x);
+    int64_t y0 = (std::max)(int64_t(0), y);
+    int64_t x1 = (std::min)(static_cast<int64_t>(view.width), x + width);
+    int64_t y1 = (std::min)(static_cast<int64_t>(view.height), y + height);
+    if (x1 <= x0 || y1 <= y0) {
+        return false;
+    }
+    outX = static_cast<int>(x0);
+    outY = static_cast<int>(y0);
+    outWidth = static_cast<int>(x1 - x0);
+    outHeight = static_cast<int>(y1 - y0);
+    return true;
+}
 
-    return py::bytes(static_cast<const char*>(baseAddr), totalBytes);
+static bool ClipRegion(const PixelConvert::ImageView& view, int& x, int& y, int& width, int& height)
+{
+    return ClipRegion(view, x, y, width, height, x, y, width, height);
 }
 
-void PyWorld::SetPixels(const py::bytes& data)
+// 矩形を切り詰めて塗る（GIL は呼び出し側で解放する）
+static void FillClipped(const PixelConvert::ImageView& view, int64_t x, int64_t y,
+                        int64_t width, int64_t height, const float rgba[4])
 {
-    if (!m_worldH) {
-        throw std::runtime_error("Invalid world");
+    int cx, cy, cw, ch;
+    if (ClipRegion(view, x, y, width, height, cx, cy, cw, ch)) {
+        PixelConvert::Fill(SubView(view, cx, cy, cw, ch), rgba);
     }
+}
 
-    void* baseAddr = GetBaseAddr();
-    if (!baseAddr) {
-        throw std::runtime_error("Failed to get base address");
+static void ColorToArray(const std::tuple<float, float, float, float>& color, float rgba[4])
+{
+    rgba[0] = std::get<0>(color);
+    rgba[1] = std::get<1>(color);
+    rgba[2] = std::get<2>(color);
+    rgba[3] = std::get<3>(color);
+}
+
+// read_* の出力先。out が None なら bytearray を確保し、(height, width, 4)
+// （PLANAR は (4, height, width)）の memoryview を返す
+struct PixelOutput {
+    py::object result;
+    PixelConvert::ImageView view;
+    py::buffer_info info;   // out のバッファは書き込みが終わるまで保持する
+};
+
+static PixelOutput PrepareOutput(py::object out, int width, int height,
+                                 PixelConvert::Depth depth, PixelConvert::Layout layout)
+{
+    size_t totalBytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 4 *
+        PixelConvert::ChannelBytes(depth);
+
+    PixelOutput output;
+    if (!out.is_none()) {
+        py::buffer_info info = out.cast<py::buffer>().request(true);
+        if (!IsCContiguous(info)) {
+            throw std::runtime_error("Output buffer must be C-contiguous");
+        }
+        if (static_cast<size_t>(info.itemsize) != PixelConvert::ChannelBytes(depth) &&
+            info.itemsize != 1) {
+            throw std::runtime_error("Output buffer item size does not match the requested depth");
+        }
+        size_t outBytes = static_cast<size_t>(info.size) * static_cast<size_t>(info.itemsize);
+        if (outBytes != totalBytes) {
+            throw std::runtime_error("Output size mismatch. Expected " +
+                std::to_string(totalBytes) + " bytes, got " +
+                std::to_string(outBytes));
+        }
+        output.result = out;
+        output.view = PackedView(info.ptr, width, height, depth, layout);
+        output.info = std::move(info);
+        return output;
     }
 
-    int rowBytes = GetRowBytes();
-    int height = GetHeight();
-    size_t totalBytes = static_cast<size_t>(rowBytes) * static_cast<size_t>(height);
+    py::object buffer = py::reinterpret_steal<py::object>(
+        PyByteArray_FromStringAndSize(nullptr, static_cast<py::ssize_t>(totalBytes)));
+    if (!buffer) {
+        throw py::error_already_set();
+    }
+    const char* format = depth == PixelConvert::Depth::U8 ? "B"
+        : depth == PixelConvert::Depth::U16 ? "H" : "f";
+    py::tuple shape = layout == PixelConvert::Layout::Planar
+        ? py::make_tuple(4, height, width)
+        : py::make_tuple(height, width, 4);
+    output.result = py::memoryview(buffer).attr("cast")(format, shape);
+    output.view = PackedView(PyByteArray_AS_STRING(buffer.ptr()), width, height, depth, layout);
+    return output;
+}
+
+py::object PyWorld::ReadPixels(py::object out, PixelConvert::Layout layout,
+                               WorldType depth, PixelConvert::AlphaOp alpha) const
+{
+    auto [width, height] = GetSize();
+    return ReadRegion(0, 0, width, height, out, layout, depth, alpha);
+}
+
+void PyWorld::WritePixels(const py::buffer& data, PixelConvert::Layout layout,
+                          PixelConvert::AlphaOp alpha)
+{
+    auto [width, height] = GetSize();
+    WriteRegion(0, 0, width, height, data, layout, alpha);
+}
 
-    std::string dataStr = data;
-    if (dataStr.size() != totalBytes) {
+py::object PyWorld::ReadRegion(int x, int y, int width, int height, py::object out,
+                               PixelConvert::Layout layout, WorldType depth,
+                               PixelConvert::AlphaOp alpha) const
+{
+    PixelConvert::ImageView world = GetImageView();
+    CheckRegion(world, x, y, width, height);
+    PixelConvert::ImageView src = SubView(world, x, y, width, height);
+
+    PixelOutput output = PrepareOutput(out, width, height, ToDepth(depth), layout);
+    {
+        py::gil_scoped_release release;
+        PixelConvert::Convert(src, output.view, alpha);
+    }
+    return output.result;
+}
+
+void PyWorld::WriteRegion(int x, int y, int width, int height, const py::buffer& data,
+                          PixelConvert::Layout layout, PixelConvert::AlphaOp alpha)
+{
+    PixelConvert::ImageView world = GetImageView();
+    CheckRegion(world, x, y, width, height);
+
+    py::buffer_info info = data.request();
+    if (!IsCContiguous(info)) {
+        throw std::runtime_error("Pixel data must be a C-contiguous buffer");
+    }
+    PixelConvert::Depth srcDepth = DepthFromFormat(info);
+    size_t totalBytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 4 *
+        PixelConvert::ChannelBytes(srcDepth);
+    size_t dataBytes = static_cast<size_t>(info.size) * static_cast<size_t>(info.itemsize);
+    if (dataBytes != totalBytes) {
         throw std::runtime_error("Data size mismatch. Expected " +
             std::to_string(totalBytes) + " bytes, got " +
-            std::to_string(dataStr.size()));
+            std::to_string(dataBytes));
     }
 
-    std::memcpy(baseAddr, dataStr.data(), totalBytes);
+    PixelConvert::ImageView src = PackedView(info.ptr, width, height, srcDepth, layout);
+    PixelConvert::ImageView dst = SubView(world, x, y, width, height);
+    py::gil_scoped_release release;
+    PixelConvert::Convert(src, dst, alpha);
+}
+
+void PyWorld::FillRect(int x, int y, int width, int height,
+                       const std::tuple<float, float, float, float>& color)
+{
+    PixelConvert::ImageView world = GetImageView();
+
+    float rgba[4];
+    ColorToArray(color, rgba);
+    py::gil_scoped_release release;
+    FillClipped(world, x, y, width, height, rgba);
+}
+
+void PyWorld::Fill(const std::tuple<float, float, float, float>& color)
+{
+    auto [width, height] = GetSize();
+    FillRect(0, 0, width, height, color);
+}
+
+void PyWorld::CopyRegion(const PyWorld& src, int srcX, int srcY, int width, int height,
+                         int dstX, int dstY)
+{
+    PixelConvert::ImageView srcWorld = src.GetImageView();
+    PixelConvert::ImageView dstWorld = GetImageView();
+    CheckRegion(srcWorld, srcX, srcY, width, height);
+    CheckRegion(dstWorld, dstX, dstY, width, height);
+
+    PixelConvert::ImageView from = SubView(srcWorld, srcX, srcY, width, height);
+    PixelConvert::ImageView to = SubView(dstWorld, dstX, dstY, width, height);
+
+    py::gil_scoped_release release;
+
+    bool overlaps = srcWorld.data == dstWorld.data &&
+        srcX < dstX + width && dstX < srcX + width &&
+        srcY < dstY + height && dstY < srcY + height;
+    if (!overlaps) {
+        // 異なるビット深度間は値を正規化して変換する
+        PixelConvert::Convert(from, to);
+        return;
+    }
+
+    // 同じ World 内で重なる場合は一度退避する
+    std::vector<uint8_t> temp(static_cast<size_t>(width) * static_cast<size_t>(height) * 4 *
+                              PixelConvert::ChannelBytes(from.depth));
+    PixelConvert::ImageView staged = PackedView(temp.data(), width, height,
+                                                from.depth, PixelConvert::Layout::ARGB);
+    PixelConvert::Convert(from, staged);
+    PixelConvert::Convert(staged, to);
+}
+
+// 中心 (cx, cy) の thickness x thickness の正方形を塗る（画像外は切り詰め）
+static void StampSquare(const PixelConvert::ImageView& view, const uint8_t* pixel,
+                        int64_t cx, int64_t cy, int thickness)
+{
+    int x, y, width, height;
+    if (!ClipRegion(view, cx - (thickness - 1) / 2, cy - (thickness - 1) / 2,
+                    thickness, thickness, x, y, width, height)) {
+        return;
+    }
+
+    size_t pixelBytes = 4 * PixelConvert::ChannelBytes(view.depth);
+    for (int row = y; row < y + height; ++row) {
+        uint8_t* dst = static_cast<uint8_t*>(view.data) + static_cast<ptrdiff_t>(row) * view.rowBytes +
+            static_cast<size_t>(x) * pixelBytes;
+        for (int col = 0; col < width; ++col) {
+            std::memcpy(dst + col * pixelBytes, pixel, pixelBytes);
+        }
+    }
+}
+
+// Cohen–Sutherland の領域コード
+enum : int {
+    kClipLeft = 1,
+    kClipRight = 2,
+    kClipTop = 4,
+    kClipBottom = 8
+};
+
+static int OutCode(double x, double y, double xMin, double yMin, double xMax, double yMax)
+{
+    int code = 0;
+    if (x < xMin) code |= kClipLeft;
+    else if (x > xMax) code |= kClipRight;
+    if (y < yMin) code |= kClipTop;
+    else if (y > yMax) code |= kClipBottom;
+    return code;
+}
+
+// 線分を矩形に切り詰める（Cohen–Sutherland）。矩形と交わらなければ false
+static bool ClipSegment(double& x0, double& y0, double& x1, double& y1,
+                        double xMin, double yMin, double xMax, double yMax)
+{
+    int code0 = OutCode(x0, y0, xMin, yMin, xMax, yMax);
+    int code1 = OutCode(x1, y1, xMin, yMin, xMax, yMax);
+    for (;;) {
+        if (!(code0 | code1)) {
+            return true;
+        }
+        if (code0 & code1) {
+            return false;
+        }
+        int code = code0 ? code0 : code1;
+        double x = 0.0;
+        double y = 0.0;
+        if (code & kClipBottom) {
+            x = x0 + (x1 - x0) * (yMax - y0) / (y1 - y0);
+            y = yMax;
+        } else if (code & kClipTop) {
+            x = x0 + (x1 - x0) * (yMin - y0) / (y1 - y0);
+            y = yMin;
+        } else if (code & kClipRight) {
+            y = y0 + (y1 - y0) * (xMax - x0) / (x1 - x0);
+            x = xMax;
+        } else {
+            y = y0 + (y1 - y0) * (xMin - x0) / (x1 - x0);
+            x = xMin;
+        }
+        if (code == code0) {
+            x0 = x;
+            y0 = y;
+            code0 = OutCode(x0, y0, xMin, yMin, xMax, yMax);
+        } else {
+            x1 = x;
+            y1 = y;
+            code1 = OutCode(x1, y1, xMin, yMin, xMax, yMax);
+        }
+    }
+}
+
+void PyWorld::DrawLine(int x0, int y0, int x1, int y1,
+                       const std::tuple<float, float, float, float>& color, int thickness)
+{
+    if (thickness <= 0) {
+        throw std::runtime_error("Thickness must be positive");
+    }
+    PixelConvert::ImageView world = GetImageView();
+
+    float rgba[4];
+    ColorToArray(color, rgba);
+    uint8_t pixel[16];
+    PixelConvert::EncodePixel(rgba, world.depth, world.layout, pixel);
+
+    py::gil_scoped_release release;
+
+    // 正方形が画像に掛かる中心の範囲に線分を切り詰め、その範囲の歩数だけ描く
+    // （画像外の長い線分でも画像内の画素数分しか回らない）
+    double fx0 = x0;
+    double fy0 = y0;
+    double fx1 = x1;
+    double fy1 = y1;
+    // 画素は線上の点を丸めた位置なので、範囲を 1 画素広げて切り詰める
+    double before = (thickness - 1) / 2 + 1;
+    double after = thickness / 2 + 1;
+    if (!ClipSegment(fx0, fy0, fx1, fy1, -after, -after,
+                     world.width - 1 + before, world.height - 1 + before)) {
+        return;
+    }
+
+    // Bresenham（差分は int64）。主軸の k 歩目の副軸の位置を元の端点から求めるので、
+    // 切り詰めても切り詰めない場合と同じ画素になる
+    int64_t dx = static_cast<int64_t>(x1) - x0;
+    int64_t dy = static_cast<int64_t>(y1) - y0;
+    bool xMajor = std::llabs(dx) >= std::llabs(dy);
+    int64_t major = xMajor ? std::llabs(dx) : std::llabs(dy);
+    int64_t minor = xMajor ? std::llabs(dy) : std::llabs(dx);
+    int64_t sx = dx < 0 ? -1 : 1;
+    int64_t sy = dy < 0 ? -1 : 1;
+
+    double k0 = xMajor ? (fx0 - x0) * sx : (fy0 - y0) * sy;
+    double k1 = xMajor ? (fx1 - x0) * sx : (fy1 - y0) * sy;
+    int64_t kBegin = (std::max)(int64_t(0), static_cast<int64_t>(std::floor((std::min)(k0, k1))) - 1);
+    int64_t kEnd = (std::min)(major, static_cast<int64_t>(std::ceil((std::max)(k0, k1))) + 1);
+    for (int64_t k = kBegin; k <= kEnd; ++k) {
+        // k * minor / major を四捨五入（0.5 は切り上げ）
+        int64_t step = 0;
+        if (major > 0) {
+            if (k == 0 || minor <= (INT64_MAX - major) / (2 * k)) {
+                step = (2 * minor * k + major) / (2 * major);
+            } else {
+                step = static_cast<int64_t>(std::floor(static_cast<double>(minor) * k / major + 0.5));
+            }
+        }
+        int64_t px = xMajor ? x0 + sx * k : x0 + sx * step;
+        int64_t py = xMajor ? y0 + sy * step : y0 + sy * k;
+        StampSquare(world, pixel, px, py, thickness);
+    }
+}
+
+void PyWorld::DrawRect(int x, int y, int width, int height,
+                       const std::tuple<float, float, float, float>& color, int thickness)
+{
+    if (thickness <= 0) {
+        throw std::runtime_error("Thickness must be positive");
+    }
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    PixelConvert::ImageView world = GetImageView();
+
+    float rgba[4];
+    ColorToArray(color, rgba);
+    py::gil_scoped_release release;
+
+    // 内側に向かって thickness 分の枠を描く（端の座標は int64 で求める）
+    int64_t t = (std::min)(thickness, (std::min)(width / 2 + width % 2, height / 2 + height % 2));
+    int64_t left = x;
+    int64_t top = y;
+    int64_t right = left + width;
+    int64_t bottom = top + height;
+    FillClipped(world, left, top, width, t, rgba);
+    FillClipped(world, left, bottom - t, width, t, rgba);
+    FillClipped(world, left, top + t, t, height - 2 * t, rgba);
+    FillClipped(world, right - t, top + t, t, height - 2 * t, rgba);
+}
+
+void PyWorld::FillCircle(float cx, float cy, float radius,
+                         const std::tuple<float, float, float, float>& color)
+{
+    if (radius < 0.0f) {
+        throw std::runtime_error("Radius cannot be negative");
+    }
+    PixelConvert::ImageView world = GetImageView();
+
+    float rgba[4];
+    ColorToArray(color, rgba);
+
+    py::gil_scoped_release release;
+
+    // 画素中心が円内に入る範囲を行ごとに塗る。int へ変換する前に画像の範囲へ
+    // 切り詰める（画像外の大きな座標でも変換があふれない）
+    auto clampTo = [](double value, double lo, double hi) {
+        return (std::min)((std::max)(value, lo), hi);
+    };
+    int yBegin = static_cast<int>(clampTo(std::ceil(cy - radius - 0.5), 0.0, world.height));
+    int yEnd = static_cast<int>(clampTo(std::floor(cy + radius - 0.5), -1.0, world.height - 1));
+    for (int y = yBegin; y <= yEnd; ++y) {
+        double dy = static_cast<double>(y) + 0.5 - cy;
+        double half = std::sqrt((std::max)(0.0, static_cast<double>(radius) * radius - dy * dy));
+        int64_t xBegin = static_cast<int64_t>(clampTo(std::ceil(cx - half - 0.5), -1.0, world.width));
+        int64_t xEnd = static_cast<int64_t>(clampTo(std::floor(cx + half - 0.5), -1.0, world.width));
+        FillClipped(world, xBegin, y, xEnd - xBegin + 1, 1, rgba);
+    }
+}
+
+py::dict PyWorld::Statistics(int bins, const std::tuple<float, float>& range,
+                            bool histogram, py::object region) const
+{
+    PixelConvert::ImageView view = GetImageView();
+    if (!region.is_none()) {
+        auto rect = region.cast<std::tuple<int, int, int, int>>();
+        int x = std::get<0>(rect);
+        int y = std::get<1>(rect);
+        int width = std::get<2>(rect);
+        int height = std::get<3>(rect);
+        CheckRegion(view, x, y, width, height);
+        view = SubView(view, x, y, width, height);
+    }
+
+    ImageStats::Options options;
+    options.bins = bins;
+    options.rangeMin = std::get<0>(range);
+    options.rangeMax = std::get<1>(range);
+    options.histogram = histogram;
+
+    ImageStats::Result result;
+    {
+        py::gil_scoped_release release;
+        result = ImageStats::Compute(view, options);
+    }
+
+    auto perChannel = [&result](auto get) {
+        return py::make_tuple(get(result.channels[0]), get(result.channels[1]),
+                              get(result.channels[2]), get(result.channels[3]));
+    };
+
+    py::dict stats;
+    stats["pixels"] = result.pixels;
+    stats["bins"] = bins;
+    stats["range"] = py::make_tuple(options.rangeMin, options.rangeMax);
+    stats["min"] = perChannel([](const ImageStats::ChannelStats& c) { return c.min; });
+    stats["max"] = perChannel([](const ImageStats::ChannelStats& c) { return c.max; });
+    stats["mean"] = perChannel([](const ImageStats::ChannelStats& c) { return c.mean; });
+    stats["std"] = perChannel([](const ImageStats::ChannelStats& c) { return c.stddev; });
+    stats["nan"] = perChannel([](const ImageStats::ChannelStats& c) { return c.nanCount; });
+    stats["below"] = perChannel([](const ImageStats::ChannelStats& c) { return c.belowCount; });
+    stats["above"] = perChannel([](const ImageStats::ChannelStats& c) { return c.aboveCount; });
+    if (histogram) {
+        py::list channels;
+        for (const auto& channel : result.channels) {
+            channels.append(py::cast(channel.histogram));
+        }
+        stats["histogram"] = channels;
+    } else {
+        stats["histogram"] = py::none();
+    }
+    return stats;
+}
+
+py::dict PyWorld::Compare(py::object other, PixelConvert::Layout layout, float tolerance,
+                         bool earlyExit, bool ssim, int ssimTile, py::object diff) const
+{
+    PixelConvert::ImageView a = GetImageView();
+    PixelConvert::ImageView b;
+
+    // バッファは比較が終わるまで info が保持する
+    py::buffer_info info;
+    if (py::isinstance<PyWorld>(other)) {
+        b = other.cast<const PyWorld&>().GetImageView();
+        if (b.width != a.width || b.height != a.height) {
+            throw std::runtime_error("World sizes differ");
+        }
+    } else {
+        info = other.cast<py::buffer>().request();
+        if (!IsCContiguous(info)) {
+            throw std::runtime_error("Pixel data must be a C-contiguous buffer");
+        }
+        PixelConvert::Depth depth = DepthFromFormat(info);
+        size_t totalBytes = static_cast<size_t>(a.width) * static_cast<size_t>(a.height) * 4 *
+            PixelConvert::ChannelBytes(depth);
+        size_t dataBytes = static_cast<size_t>(info.size) * static_cast<size_t>(info.itemsize);
+        if (dataBytes != totalBytes) {
+            throw std::runtime_error("Data size mismatch. Expected " +
+                std::to_string(totalBytes) + " bytes, got " +
+                std::to_string(dataBytes));
+        }
+        b = PackedView(info.ptr, a.width, a.height, depth, layout);
+    }
+
+    PixelConvert::ImageView diffView;
+    if (!diff.is_none()) {
+        diffView = diff.cast<const PyWorld&>().GetImageView();
+        if (diffView.width != a.width || diffView.height != a.height) {
+            throw std::runtime_error("Diff world size does not match");
+        }
+    }
+
+    ImageCompare::Options options;
+    options.tolerance = tolerance;
+    options.earlyExit = earlyExit;
+    options.ssim = ssim;
+    options.ssimTile = ssimTile;
+
+    ImageCompare::Result result;
+    {
+        py::gil_scoped_release release;
+        result = ImageCompare::Compare(a, b, options, diffView);
+    }
+
+    auto perChannel = [](const double* values) {
+        return py::make_tuple(values[0], values[1], values[2], values[3]);
+    };
+
+    py::dict stats;
+    stats["identical"] = result.identical;
+    stats["complete"] = result.complete;
+    stats["pixels"] = result.pixels;
+    stats["differing_pixels"] = result.differingPixels;
+    stats["max_abs"] = perChannel(result.maxAbs);
+    stats["mean_abs"] = perChannel(result.meanAbs);
+    stats["mse"] = perChannel(result.mse);
+    stats["max_error"] = (std::max)({result.maxAbs[0], result.maxAbs[1], result.maxAbs[2]});
+    stats["mean_error"] = (result.meanAbs[0] + result.meanAbs[1] + result.meanAbs[2]) / 3.0;
+    stats["psnr"] = ImageCompare::Psnr(result);
+    if (ssim) {
+        stats["ssim"] = (result.ssim[0] + result.ssim[1] + result.ssim[2]) / 3.0;
+        stats["ssim_channels"] = perChannel(result.ssim);
+    } else {
+        stats["ssim"] = py::none();
+        stats["ssim_channels"] = py::none();
+    }
+    return stats;
+}
+
+std::shared_ptr<PyWorld> PyWorld::Resize(int width, int height, ImageResize::Filter filter,
+                                         py::object type) const
+{
+    PixelConvert::ImageView src = GetImageView();
+    WorldType dstType = type.is_none() ? GetType() : type.cast<WorldType>();
+
+    // 全画素を書き込むので再利用したワールドをゼロで埋める必要はない
+    std::shared_ptr<PyWorld> result = Create(dstType, width, height, false);
+    PixelConvert::ImageView dst = result->GetImageView();
+    {
+        py::gil_scoped_release release;
+        ImageResize::Resize(src, dst, filter);
+    }
+    return result;
+}
+
+void PyWorld::ResizeInto(const PyWorld& dst, ImageResize::Filter filter) const
+{
+    PixelConvert::ImageView src = GetImageView();
+    PixelConvert::ImageView to = dst.GetImageView();
+    py::gil_scoped_release release;
+    ImageResize::Resize(src, to, filter);
+}
+
+py::object PyWorld::ReadResized(int width, int height, py::object out, ImageResize::Filter filter,
+                                PixelConvert::Layout layout, WorldType depth,
+                                PixelConvert::AlphaOp alpha) const
+{
+    if (width <= 0 || height <= 0) {
+        throw std::runtime_error("Size must be positive");
+    }
+    PixelConvert::ImageView src = GetImageView();
+    PixelOutput output = PrepareOutput(out, width, height, ToDepth(depth), layout);
+    {
+        py::gil_scoped_release release;
+        if (alpha == PixelConvert::AlphaOp::None) {
+            ImageResize::Resize(src, output.view, filter);
+        } else {
+            // アルファ処理は縮小後の float に対して行う（出力サイズ分のみ）
+            std::vector<float> staged(static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+            PixelConvert::ImageView stagedView = PackedView(staged.data(), width, height,
+                                                            PixelConvert::Depth::F32,
+                                                            PixelConvert::Layout::RGBA);
+            ImageResize::Resize(src, stagedView, filter);
+            PixelConvert::Convert(stagedView, output.view, alpha);
+        }
+    }
+    return output.result;
+}
+
+// apply_kernel のキーワード引数をカーネルのパラメータに変換する
+static PixelKernels::Params ToKernelParams(const py::kwargs& kwargs)
+{
+    PixelKernels::Params params;
+    for (auto item : kwargs) {
+        std::string name = py::str(item.first);
+        py::handle value = item.second;
+        PixelKernels::Param param;
+        try {
+            if (py::isinstance<py::str>(value)) {
+                param.isText = true;
+                param.text = value.cast<std::string>();
+            } else if (py::isinstance<py::int_>(value) || py::isinstance<py::float_>(value)) {
+                param.values.push_back(value.cast<float>());
+            } else {
+                param.values = value.cast<std::vector<float>>();
+            }
+        } catch (const py::cast_error&) {
+            throw std::invalid_argument("Parameter " + name +
+                " must be a number, a sequence of numbers or a string");
+        }
+        params[name] = std::move(param);
+    }
+    return params;
+}
+
+py::dict PyWorld::ApplyKernel(const std::string& name, py::object other, py::object region,
+                              int tileSize, const py::kwargs& kwargs)
+{
+    PixelKernels::KernelInfo info = PixelKernels::Registry::Get().GetInfo(name);
+    std::unique_ptr<PixelKernels::Prepared> kernel =
+        PixelKernels::Registry::Get().Prepare(name, ToKernelParams(kwargs));
+
+    PixelConvert::ImageView image = GetImageView();
+    PixelConvert::ImageView second;
+    if (info.inputs == 2) {
+        if (other.is_none()) {
+            throw std::invalid_argument("Kernel " + name + " requires other");
+        }
+        second = other.cast<const PyWorld&>().GetImageView();
+        if (second.width != image.width || second.height != image.height) {
+            throw std::runtime_error("World sizes differ");
+        }
+    } else if (!other.is_none()) {
+        throw std::invalid_argument("Kernel " + name + " takes no other input");
+    }
+
+    if (!region.is_none()) {
+        auto rect = region.cast<std::tuple<int, int, int, int>>();
+        int x = std::get<0>(rect);
+        int y = std::get<1>(rect);
+        int width = std::get<2>(rect);
+        int height = std::get<3>(rect);
+        CheckRegion(image, x, y, width, height);
+        image = SubView(image, x, y, width, height);
+        if (info.inputs == 2) {
+            second = SubView(second, x, y, width, height);
+        }
+    }
+
+    PixelKernels::RunStats stats;
+    {
+        py::gil_scoped_release release;
+        stats = PixelKernels::Run(*kernel, image, info.inputs == 2 ? &second : nullptr, tileSize);
+    }
+
+    py::dict result;
+    result["tiles"] = stats.tiles;
+    result["threads"] = stats.tasks;
+    return result;
 }
 
 std::tuple<float, float, float, float> PyWorld::GetPixel(int x, int y) const
@@ -281,19 +1075,14 @@ std::tuple<float, float, float, float> PyWorld::GetPixel(int x, int y) const
         throw std::runtime_error("Invalid world");
     }
 
-    int width = GetWidth();
-    int height = GetHeight();
-    if (x < 0 || x >= width || y < 0 || y >= height) {
+    const WorldDesc& desc = GetDesc();
+    if (x < 0 || x >= desc.width || y < 0 || y >= desc.height) {
         throw std::runtime_error("Pixel coordinates out of range");
     }
 
     void* baseAddr = GetBaseAddr();
-    if (!baseAddr) {
-        throw std::runtime_error("Failed to get base address");
-    }
-
-    int rowBytes = GetRowBytes();
-    WorldType type = GetType();
+    int rowBytes = desc.rowBytes;
+    WorldType type = desc.type;
 
     float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
 
@@ -344,19 +1133,14 @@ void PyWorld::SetPixel(int x, int y, float r, float g, float b, float a)
         throw std::runtime_error("Invalid world");
     }
 
-    int width = GetWidth();
-    int height = GetHeight();
-    if (x < 0 || x >= width || y < 0 || y >= height) {
+    const WorldDesc& desc = GetDesc();
+    if (x < 0 || x >= desc.width || y < 0 || y >= desc.height) {
         throw std::runtime_error("Pixel coordinates out of range");
     }
 
     void* baseAddr = GetBaseAddr();
-    if (!baseAddr) {
-        throw std::runtime_error("Failed to get base address");
-    }
-
-    int rowBytes = GetRowBytes();
-    WorldType type = GetType();
+    int rowBytes = desc.rowBytes;
+    WorldType type = desc.type;
 
     switch (type) {
         case WorldType::BIT8: {
@@ -434,6 +1218,7 @@ AEGP_WorldH PyWorld::Release()
     AEGP_WorldH handle = m_worldH;
     m_worldH = nullptr;
     m_owned = false;
+    m_desc = WorldDesc();
     return handle;
 }
 
@@ -444,7 +1229,7 @@ bool PyWorld::IsOwned() const
 
 // Static factory methods
 
-std::shared_ptr<PyWorld> PyWorld::Create(WorldType type, int width, int height)
+std::shared_ptr<PyWorld> PyWorld::Create(WorldType type, int width, int height, bool clear)
 {
     if (width <= 0 || height <= 0) {
         throw std::runtime_error("Dimensions must be positive");
@@ -453,25 +1238,9 @@ std::shared_ptr<PyWorld> PyWorld::Create(WorldType type, int width, int height)
         throw std::runtime_error("Dimensions exceed maximum (30000)");
     }
 
-    auto& state = PluginState::Instance();
-    const auto& suites = state.GetSuites();
-    if (!suites.worldSuite) {
-        throw std::runtime_error("World Suite not available");
-    }
-
-    AEGP_PluginID plugin_id = state.GetPluginID();
-    AEGP_WorldH worldH = nullptr;
-
-    A_Err err = suites.worldSuite->AEGP_New(
-        plugin_id,
-        static_cast<AEGP_WorldType>(type),
-        static_cast<A_long>(width),
-        static_cast<A_long>(height),
-        &worldH);
-
-    if (err != A_Err_NONE) {
-        throw std::runtime_error("AEGP_New failed");
-    }
+    // 同じ形状のワールドはプールから再利用する
+    AEGP_WorldH worldH = WorldPool::Instance().Acquire(
+        static_cast<AEGP_WorldType>(type), width, height, clear);
 
     return std::make_shared<PyWorld>(worldH, true);
 }
@@ -496,8 +1265,45 @@ void init_world(py::module_& m)
         .value("BIT32", WorldType::BIT32, "32 bits per channel (float)")
         .export_values();
 
+    // PixelLayout enum (values are not exported: NONE would clash with WorldType)
+    py::enum_<PixelConvert::Layout>(m, "PixelLayout",
+        "Channel layout for World.read_pixels / write_pixels.\n\n"
+        "Values:\n"
+        "    ARGB: Interleaved A, R, G, B (native World order)\n"
+        "    RGBA: Interleaved R, G, B, A\n"
+        "    BGRA: Interleaved B, G, R, A\n"
+        "    PLANAR: Separate R, G, B, A planes, shape (4, height, width)")
+        .value("ARGB", PixelConvert::Layout::ARGB, "Interleaved A, R, G, B")
+        .value("RGBA", PixelConvert::Layout::RGBA, "Interleaved R, G, B, A")
+        .value("BGRA", PixelConvert::Layout::BGRA, "Interleaved B, G, R, A")
+        .value("PLANAR", PixelConvert::Layout::Planar, "Separate R, G, B, A planes");
+
+    // AlphaOp enum
+    py::enum_<PixelConvert::AlphaOp>(m, "AlphaOp",
+        "Alpha handling applied while converting pixels.\n\n"
+        "Values:\n"
+        "    NONE: Copy color channels as-is\n"
+        "    PREMULTIPLY: RGB *= A\n"
+        "    UNPREMULTIPLY: RGB /= A (RGB = 0 where A == 0)")
+        .value("NONE", PixelConvert::AlphaOp::None, "Copy color channels as-is")
+        .value("PREMULTIPLY", PixelConvert::AlphaOp::Premultiply, "RGB *= A")
+        .value("UNPREMULTIPLY", PixelConvert::AlphaOp::Unpremultiply, "RGB /= A");
+
+    // ResizeFilter enum
+    py::enum_<ImageResize::Filter>(m, "ResizeFilter",
+        "Filter for World.resize / resize_into / read_resized.\n\n"
+        "Values:\n"
+        "    BOX: Average of the source pixels whose centers fall in the\n"
+        "        target pixel (fastest; exact for integer factors; nearest\n"
+        "        neighbour when enlarging)\n"
+        "    BILINEAR: 2x2 linear interpolation (enlarging, mild reduction)\n"
+        "    AREA: Average weighted by covered area (best for arbitrary reduction)")
+        .value("BOX", ImageResize::Filter::Box, "Average of the covered source pixels")
+        .value("BILINEAR", ImageResize::Filter::Bilinear, "2x2 linear interpolation")
+        .value("AREA", ImageResize::Filter::Area, "Area-weighted average");
+
     // World class
-    py::class_<PyWorld, std::shared_ptr<PyWorld>>(m, "World",
+    py::class_<PyWorld, std::shared_ptr<PyWorld>>(m, "World", py::buffer_protocol(),
         "Frame buffer for image data.\n\n"
         "World represents a pixel buffer that can be used for rendering\n"
         "and image processing operations.\n\n"
@@ -515,7 +1321,25 @@ void init_world(py::module_& m)
         "    world.set_pixel(100, 100, 1.0, 0.0, 0.0, 1.0)  # Red\n"
         "    \n"
         "    # Apply blur\n"
-        "    world.fast_blur(5.0)")
+        "    world.fast_blur(5.0)\n"
+        "    \n"
+        "    # Zero-copy view (NumPy), shape (height, width, 4) ARGB\n"
+        "    pixels = world.as_array()\n"
+        "    pixels[..., 0] = 255  # opaque alpha")
+
+        .def_buffer([](PyWorld& self) -> py::buffer_info {
+            // バッファプロトコル経由では例外を投げられないので、無効なワールド
+            // （チェックイン済みのレシートのワールドなど）は空の読み取り専用
+            // バッファを返してメモリを渡さない
+            if (!self.IsValid()) {
+                return py::buffer_info(
+                    nullptr, sizeof(uint8_t), py::format_descriptor<uint8_t>::format(), 3,
+                    { py::ssize_t(0), py::ssize_t(0), py::ssize_t(4) },
+                    { py::ssize_t(4), py::ssize_t(4), py::ssize_t(1) },
+                    true);
+            }
+            return self.GetBufferInfo();
+        })
 
         .def_property_readonly("valid", &PyWorld::IsValid,
             "Check if world is valid")
@@ -535,6 +1359,16 @@ void init_world(py::module_& m)
         .def_property_readonly("row_bytes", &PyWorld::GetRowBytes,
             "Get bytes per row (row stride)")
 
+        .def_property_readonly("bytes_per_pixel", [](const PyWorld& self) {
+            return self.GetDesc().bytesPerPixel;
+        }, "Get bytes per pixel (4, 8 or 16)")
+
+        .def("refresh", &PyWorld::Refresh,
+            "Re-query type, size, row bytes and base address.\n\n"
+            "These are cached on first use since they do not change during\n"
+            "the world's lifetime; call this only if the underlying handle\n"
+            "was modified outside PyAE.")
+
         .def("get_pixels", &PyWorld::GetPixels,
             "Get all pixel data as bytes.\n\n"
             "Returns raw pixel data in ARGB format.\n"
@@ -544,10 +1378,290 @@ void init_world(py::module_& m)
             "- BIT32: 16 bytes per pixel (float)")
 
         .def("set_pixels", &PyWorld::SetPixels,
-            "Set all pixel data from bytes.\n\n"
+            "Set all pixel data from a buffer.\n\n"
+            "Accepts bytes, bytearray, memoryview or a C-contiguous NumPy array;\n"
+            "the data is copied once directly into the world.\n"
             "Data size must match row_bytes * height.",
             py::arg("data"))
 
+        .def("as_array", [](py::object self) {
+            const PyWorld& world = self.cast<const PyWorld&>();
+            py::buffer_info info = world.GetBufferInfo();
+            // The array keeps this World object alive (base). A world owned by
+            // a frame receipt is only valid until the receipt is checked in
+            py::array array(py::dtype(info), info.shape, info.strides, info.ptr, self);
+            if (info.readonly) {
+                array.attr("setflags")(py::arg("write") = false);
+            }
+            return array;
+        },
+            "Get a zero-copy NumPy view of the pixels.\n\n"
+            "Shape is (height, width, 4) in ARGB channel order. dtype is\n"
+            "uint8 (BIT8), uint16 (BIT16, 0-32768) or float32 (BIT32).\n"
+            "Row stride follows row_bytes. Writes go directly to the world.\n"
+            "Requires NumPy; the World also supports memoryview(world).\n\n"
+            "The world of a FrameReceipt is exported read-only, and its views\n"
+            "must not be used after the receipt is checked in; copy the array\n"
+            "(e.g. numpy.array(view)) to keep the pixels.")
+
+        .def("read_pixels", &PyWorld::ReadPixels,
+            "Convert the pixels into another layout and depth.\n\n"
+            "Values are normalized between depths (uint16 uses the AE\n"
+            "0-32768 range). Conversion uses AVX2 / SSE4.1 kernels when\n"
+            "the CPU supports them and runs without the GIL.\n\n"
+            "Args:\n"
+            "    out: Writable C-contiguous buffer of exactly\n"
+            "        width * height * 4 channels (e.g. a NumPy array), or None\n"
+            "    layout: PixelLayout of the result (default RGBA)\n"
+            "    depth: WorldType of the result channels (default BIT32)\n"
+            "    alpha: AlphaOp applied while converting (default NONE)\n\n"
+            "Returns:\n"
+            "    out, or a new memoryview shaped (height, width, 4)\n"
+            "    ((4, height, width) for PLANAR)",
+            py::arg("out") = py::none(),
+            py::arg("layout") = PixelConvert::Layout::RGBA,
+            py::arg("depth") = WorldType::BIT32,
+            py::arg("alpha") = PixelConvert::AlphaOp::None)
+
+        .def("write_pixels", &PyWorld::WritePixels,
+            "Convert a pixel buffer into the world.\n\n"
+            "The source depth follows the buffer format: uint8, uint16\n"
+            "(0-32768) or float32. The buffer must be C-contiguous and hold\n"
+            "width * height * 4 channels.\n\n"
+            "Args:\n"
+            "    data: Source buffer (bytes, bytearray, memoryview, NumPy array)\n"
+            "    layout: PixelLayout of data (default RGBA)\n"
+            "    alpha: AlphaOp applied while converting (default NONE)",
+            py::arg("data"),
+            py::arg("layout") = PixelConvert::Layout::RGBA,
+            py::arg("alpha") = PixelConvert::AlphaOp::None)
+
+        .def("read_region", &PyWorld::ReadRegion,
+            "Convert a rectangle of pixels (see read_pixels).\n\n"
+            "The rectangle must lie inside the world.\n\n"
+            "Args:\n"
+            "    x, y: Top-left corner\n"
+            "    width, height: Region size\n"
+            "    out: Writable C-contiguous buffer of exactly\n"
+            "        width * height * 4 channels, or None\n"
+            "    layout: PixelLayout of the result (default RGBA)\n"
+            "    depth: WorldType of the result channels (default BIT32)\n"
+            "    alpha: AlphaOp applied while converting (default NONE)\n\n"
+            "Returns:\n"
+            "    out, or a new memoryview shaped (height, width, 4)\n"
+            "    ((4, height, width) for PLANAR)",
+            py::arg("x"), py::arg("y"), py::arg("width"), py::arg("height"),
+            py::arg("out") = py::none(),
+            py::arg("layout") = PixelConvert::Layout::RGBA,
+            py::arg("depth") = WorldType::BIT32,
+            py::arg("alpha") = PixelConvert::AlphaOp::None)
+
+        .def("write_region", &PyWorld::WriteRegion,
+            "Convert a pixel buffer into a rectangle (see write_pixels).\n\n"
+            "The rectangle must lie inside the world and data must hold\n"
+            "width * height * 4 channels.",
+            py::arg("x"), py::arg("y"), py::arg("width"), py::arg("height"),
+            py::arg("data"),
+            py::arg("layout") = PixelConvert::Layout::RGBA,
+            py::arg("alpha") = PixelConvert::AlphaOp::None)
+
+        .def("fill", &PyWorld::Fill,
+            "Fill the whole world with a color.\n\n"
+            "Args:\n"
+            "    color: (R, G, B, A) normalized to 0.0-1.0",
+            py::arg("color"))
+
+        .def("fill_rect", &PyWorld::FillRect,
+            "Fill a rectangle with a color (clipped to the world).\n\n"
+            "Args:\n"
+            "    x, y: Top-left corner\n"
+            "    width, height: Rectangle size\n"
+            "    color: (R, G, B, A) normalized to 0.0-1.0",
+            py::arg("x"), py::arg("y"), py::arg("width"), py::arg("height"),
+            py::arg("color"))
+
+        .def("copy_region", &PyWorld::CopyRegion,
+            "Copy a rectangle from another world into this one.\n\n"
+            "Worlds may differ in bit depth (values are normalized). src may\n"
+            "be this world; overlapping regions are handled.\n\n"
+            "Args:\n"
+            "    src: Source World\n"
+            "    src_x, src_y: Top-left corner in src\n"
+            "    width, height: Region size (must fit in both worlds)\n"
+            "    dst_x, dst_y: Top-left corner in this world (default 0, 0)",
+            py::arg("src"), py::arg("src_x"), py::arg("src_y"),
+            py::arg("width"), py::arg("height"),
+            py::arg("dst_x") = 0, py::arg("dst_y") = 0)
+
+        .def("draw_line", &PyWorld::DrawLine,
+            "Draw a line between two pixels (clipped to the world).\n\n"
+            "Args:\n"
+            "    x0, y0: Start pixel\n"
+            "    x1, y1: End pixel\n"
+            "    color: (R, G, B, A) normalized to 0.0-1.0\n"
+            "    thickness: Line width in pixels (default 1)",
+            py::arg("x0"), py::arg("y0"), py::arg("x1"), py::arg("y1"),
+            py::arg("color"), py::arg("thickness") = 1)
+
+        .def("draw_rect", &PyWorld::DrawRect,
+            "Draw a rectangle outline (clipped to the world).\n\n"
+            "Args:\n"
+            "    x, y: Top-left corner\n"
+            "    width, height: Outer size\n"
+            "    color: (R, G, B, A) normalized to 0.0-1.0\n"
+            "    thickness: Border width inside the rectangle (default 1)",
+            py::arg("x"), py::arg("y"), py::arg("width"), py::arg("height"),
+            py::arg("color"), py::arg("thickness") = 1)
+
+        .def("fill_circle", &PyWorld::FillCircle,
+            "Fill a circle (pixels whose centers lie inside; clipped).\n\n"
+            "Args:\n"
+            "    cx, cy: Center in pixel coordinates\n"
+            "    radius: Radius in pixels\n"
+            "    color: (R, G, B, A) normalized to 0.0-1.0",
+            py::arg("cx"), py::arg("cy"), py::arg("radius"), py::arg("color"))
+
+        .def("statistics", &PyWorld::Statistics,
+            "Compute per-channel statistics (R, G, B, A) in one native pass.\n\n"
+            "Values are normalized (8/16 bpc to 0.0-1.0; float as stored).\n"
+            "Moments ignore NaN; a channel with no finite samples reports NaN.\n"
+            "Large images are split across threads by rows.\n\n"
+            "Args:\n"
+            "    bins: Histogram bins over range (1-65536, default 256)\n"
+            "    range: (min, max) of the histogram (default (0.0, 1.0));\n"
+            "        values outside are counted in below / above\n"
+            "    histogram: Build the histogram (default True)\n"
+            "    region: (x, y, width, height) inside the world, or None\n\n"
+            "Returns:\n"
+            "    dict with pixels, bins, range, min, max, mean, std, nan,\n"
+            "    below, above (4-tuples per channel) and histogram\n"
+            "    (4 lists of counts, or None)",
+            py::arg("bins") = 256,
+            py::arg("range") = std::make_tuple(0.0f, 1.0f),
+            py::arg("histogram") = true,
+            py::arg("region") = py::none())
+
+        .def("compare", &PyWorld::Compare,
+            "Compare this world with another World or a pixel buffer.\n\n"
+            "Both images are normalized (8/16 bpc to 0.0-1.0) so any bit\n"
+            "depths can be compared. The comparison is vectorized and split\n"
+            "across threads. NaN equals NaN; NaN against a number is an\n"
+            "infinite error.\n\n"
+            "Args:\n"
+            "    other: World, or a C-contiguous buffer (uint8 / uint16\n"
+            "        0-32768 / float32) of width * height * 4 channels\n"
+            "    layout: PixelLayout of a buffer (default RGBA)\n"
+            "    tolerance: Largest channel difference still counted as\n"
+            "        identical (default 0.0)\n"
+            "    early_exit: Stop at the first differing pixel (default False);\n"
+            "        the metrics then cover only the rows compared\n"
+            "    ssim: Compute tiled SSIM (default True)\n"
+            "    ssim_tile: SSIM tile size in pixels (1-256, default 8)\n"
+            "    diff: World of the same size that receives |a - b| per\n"
+            "        channel with opaque alpha, or None\n\n"
+            "Returns:\n"
+            "    dict with identical, complete, pixels, differing_pixels,\n"
+            "    max_abs, mean_abs, mse, ssim_channels (R, G, B, A tuples),\n"
+            "    and max_error, mean_error, psnr (dB), ssim over RGB",
+            py::arg("other"),
+            py::arg("layout") = PixelConvert::Layout::RGBA,
+            py::arg("tolerance") = 0.0f,
+            py::arg("early_exit") = false,
+            py::arg("ssim") = true,
+            py::arg("ssim_tile") = 8,
+            py::arg("diff") = py::none())
+
+        .def("resize", &PyWorld::Resize,
+            "Return a resized copy of the world.\n\n"
+            "The new world comes from WorldPool. Rows are decoded, filtered\n"
+            "with SIMD kernels and split across threads without the GIL.\n\n"
+            "Args:\n"
+            "    width, height: Target size (1-30000)\n"
+            "    filter: ResizeFilter (default AREA)\n"
+            "    type: WorldType of the result, or None for this world's type\n\n"
+            "Returns:\n"
+            "    New World",
+            py::arg("width"), py::arg("height"),
+            py::arg("filter") = ImageResize::Filter::Area,
+            py::arg("type") = py::none())
+
+        .def("resize_into", &PyWorld::ResizeInto,
+            "Resize the world into another World (e.g. a reused thumbnail).\n\n"
+            "The target size is dst's size; bit depths may differ.\n\n"
+            "Args:\n"
+            "    dst: Destination World (not this world)\n"
+            "    filter: ResizeFilter (default AREA)",
+            py::arg("dst"),
+            py::arg("filter") = ImageResize::Filter::Area)
+
+        .def("read_resized", &PyWorld::ReadResized,
+            "Resize the world into a pixel buffer (see read_pixels).\n\n"
+            "Defaults to 8-bit RGBA, ready for UI toolkits.\n\n"
+            "Args:\n"
+            "    width, height: Target size\n"
+            "    out: Writable C-contiguous buffer of exactly\n"
+            "        width * height * 4 channels, or None\n"
+            "    filter: ResizeFilter (default AREA)\n"
+            "    layout: PixelLayout of the result (default RGBA)\n"
+            "    depth: WorldType of the result channels (default BIT8)\n"
+            "    alpha: AlphaOp applied after resizing (default NONE)\n\n"
+            "Returns:\n"
+            "    out, or a new memoryview shaped (height, width, 4)\n"
+            "    ((4, height, width) for PLANAR)",
+            py::arg("width"), py::arg("height"),
+            py::arg("out") = py::none(),
+            py::arg("filter") = ImageResize::Filter::Area,
+            py::arg("layout") = PixelConvert::Layout::RGBA,
+            py::arg("depth") = WorldType::BIT8,
+            py::arg("alpha") = PixelConvert::AlphaOp::None)
+
+        .def("apply_kernel", &PyWorld::ApplyKernel,
+            "Run a registered native kernel over the world in place.\n\n"
+            "The image is split into square tiles that run on worker\n"
+            "threads; each tile is decoded to float RGBA, processed and\n"
+            "written back. Python is not called per tile and the GIL is\n"
+            "released while the kernel runs. See PixelKernels.names().\n\n"
+            "Args:\n"
+            "    name: Kernel name (e.g. 'gain_gamma', 'blend')\n"
+            "    other: Second input World of the same size (2-input\n"
+            "        kernels such as 'blend'; may be this world)\n"
+            "    region: (x, y, width, height) inside the world, or None\n"
+            "    tile_size: Tile edge in pixels (8-1024, default 64)\n"
+            "    **params: Kernel parameters (numbers, sequences of\n"
+            "        numbers or strings)\n\n"
+            "Returns:\n"
+            "    dict with tiles and threads\n\n"
+            "Example:\n"
+            "    world.apply_kernel('gain_gamma', gain=1.2, gamma=2.2)\n"
+            "    world.apply_kernel('blend', other=overlay, mode='screen', opacity=0.5)",
+            py::arg("name"),
+            py::arg("other") = py::none(),
+            py::arg("region") = py::none(),
+            py::arg("tile_size") = PixelKernels::kDefaultTileSize)
+
+        .def_static("simd_level", []() {
+            return std::string(PixelConvert::IsaName(PixelConvert::GetIsa()));
+        },
+            "Get the instruction set used by pixel conversion\n"
+            "('avx2', 'sse4.1' or 'scalar').")
+
+        .def_static("set_simd_level", [](const std::string& level) {
+            if (level == "avx2") {
+                PixelConvert::SetIsa(PixelConvert::Isa::AVX2);
+            } else if (level == "sse4.1") {
+                PixelConvert::SetIsa(PixelConvert::Isa::SSE41);
+            } else if (level == "scalar") {
+                PixelConvert::SetIsa(PixelConvert::Isa::Scalar);
+            } else {
+                throw std::invalid_argument("Unknown SIMD level: " + level);
+            }
+            return std::string(PixelConvert::IsaName(PixelConvert::GetIsa()));
+        },
+            "Force the pixel conversion instruction set (for testing and\n"
+            "benchmarks). Levels the CPU lacks fall back to the best\n"
+            "supported one. Returns the level in effect.",
+            py::arg("level"))
+
         .def("get_pixel", &PyWorld::GetPixel,
             "Get pixel value at (x, y).\n\n"
             "Returns (R, G, B, A) tuple normalized to 0.0-1.0.",
@@ -575,13 +1689,18 @@ void init_world(py::module_& m)
 
         .def_static("create", &PyWorld::Create,
             "Create a new world with specified dimensions.\n\n"
+            "Worlds of the same type and size are recycled through\n"
+            "WorldPool; a disposed world returns to the pool.\n\n"
             "Args:\n"
             "    type: WorldType (BIT8, BIT16, or BIT32)\n"
             "    width: Width in pixels (1-30000)\n"
-            "    height: Height in pixels (1-30000)\n\n"
+            "    height: Height in pixels (1-30000)\n"
+            "    clear: Zero the pixels of a recycled world (default True).\n"
+            "        Pass False for scratch worlds that are fully overwritten\n\n"
             "Returns:\n"
             "    New World instance",
-            py::arg("type"), py::arg("width"), py::arg("height"))
+            py::arg("type"), py::arg("width"), py::arg("height"),
+            py::arg("clear") = true)
 
         .def("__repr__", [](const PyWorld& self) {
             if (!self.IsValid()) {
@@ -605,6 +1724,96 @@ void init_world(py::module_& m)
                 return std::string("<World: valid>");
             }
         });
+
+    // PixelKernels (static interface to the native kernel registry)
+    py::class_<PixelKernels::Registry, std::unique_ptr<PixelKernels::Registry, py::nodelete>>(m, "PixelKernels",
+        "Registry of native pixel kernels run by World.apply_kernel.\n\n"
+        "Built-in kernels: gain_gamma, threshold, channel_shuffle, lut, blend.\n\n"
+        "Example::\n\n"
+        "    for name in ae.PixelKernels.names():\n"
+        "        print(ae.PixelKernels.info(name)['description'])")
+
+        .def_static("names", []() {
+            std::vector<std::string> names;
+            for (const auto& info : PixelKernels::Registry::Get().List()) {
+                names.push_back(info.name);
+            }
+            return names;
+        },
+            "Get the registered kernel names (sorted)")
+
+        .def_static("info", [](const std::string& name) {
+            PixelKernels::KernelInfo info = PixelKernels::Registry::Get().GetInfo(name);
+            py::dict result;
+            result["name"] = info.name;
+            result["inputs"] = info.inputs;
+            result["description"] = info.description;
+            return result;
+        },
+            "Get a dict with name, inputs (1 or 2) and description\n"
+            "(including the parameters) of a kernel",
+            py::arg("name"));
+
+    // WorldPool (static interface to the process-wide pool)
+    py::class_<WorldPool, std::unique_ptr<WorldPool, py::nodelete>>(m, "WorldPool",
+        "Pool that recycles worlds created by World.create.\n\n"
+        "Worlds are kept per (type, width, height). When the pooled total\n"
+        "exceeds max_bytes, the least recently returned worlds are disposed.\n\n"
+        "Example::\n\n"
+        "    ae.WorldPool.set_max_bytes(512 * 1024 * 1024)\n"
+        "    for frame in range(1000):\n"
+        "        scratch = ae.World.create(ae.WorldType.BIT8, 1920, 1080, clear=False)\n"
+        "        ...\n"
+        "    print(ae.WorldPool.stats())")
+
+        .def_static("stats", []() {
+            WorldPool::Stats stats = WorldPool::Instance().GetStats();
+            py::dict result;
+            result["hits"] = stats.hits;
+            result["misses"] = stats.misses;
+            result["returned"] = stats.returned;
+            result["evicted"] = stats.evicted;
+            result["pooled_worlds"] = stats.pooledWorlds;
+            result["pooled_bytes"] = stats.pooledBytes;
+            result["live_worlds"] = stats.liveWorlds;
+            result["live_bytes"] = stats.liveBytes;
+            result["peak_bytes"] = stats.peakBytes;
+            result["max_bytes"] = WorldPool::Instance().GetMaxBytes();
+            result["enabled"] = WorldPool::Instance().IsEnabled();
+            return result;
+        },
+            "Get pool statistics as a dict.\n\n"
+            "Keys: hits, misses, returned, evicted, pooled_worlds,\n"
+            "pooled_bytes, live_worlds, live_bytes, peak_bytes\n"
+            "(peak of live + pooled bytes), max_bytes, enabled")
+
+        .def_static("reset_stats", []() { WorldPool::Instance().ResetStats(); },
+            "Reset counters and peak_bytes (pooled worlds are kept)")
+
+        .def_static("max_bytes", []() { return WorldPool::Instance().GetMaxBytes(); },
+            "Get the pooled byte limit")
+
+        .def_static("set_max_bytes", [](size_t maxBytes) {
+            WorldPool::Instance().SetMaxBytes(maxBytes);
+        },
+            "Set the pooled byte limit; excess worlds are disposed (LRU)",
+            py::arg("max_bytes"))
+
+        .def_static("enabled", []() { return WorldPool::Instance().IsEnabled(); },
+            "Check whether disposed worlds are pooled")
+
+        .def_static("set_enabled", [](bool enabled) {
+            WorldPool::Instance().SetEnabled(enabled);
+        },
+            "Enable or disable pooling. Disabling disposes all pooled worlds",
+            py::arg("enabled"))
+
+        .def_static("trim", [](size_t maxBytes) {
+            WorldPool::Instance().Trim(maxBytes);
+        },
+            "Dispose least recently used worlds until the pool holds at\n"
+            "most max_bytes (default 0: empty the pool)",
+            py::arg("max_bytes") = 0);
 }
 
 } // namespace PyAE
@@ -133,6 +133,10 @@ void init_IterateSuite(py::module_& sdk) {
         Note: The callback may be called from multiple threads simultaneously.
         Ensure thread-safety if accessing shared resources.
 
+        Note: Every callback takes the GIL, so Python callbacks effectively
+        run one at a time. For per-pixel work on a World use
+        World.apply_kernel, which runs native kernels on tiles in parallel.
+
         Special value: Use iterations=-1 (PF_Iterations_ONCE_PER_PROCESSOR)
         to execute the callback once per available processor.
 
@@ -0,0 +1,294 @@
+// RenderEventQueue.cpp
+// PyAE - Python for After Effects
+// レンダーキュー監視イベントのロックフリーな受け渡しキュー
+
+#include "RenderEventQueue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+namespace PyAE {
+namespace RenderEvents {
+
+namespace {
+
+constexpr size_t kMinCapacity = 16;
+constexpr size_t kMaxCapacity = size_t(1) << 20;
+
+size_t RoundCapacity(size_t capacity)
+{
+    capacity = (std::min)((std::max)(capacity, kMinCapacity), kMaxCapacity);
+    size_t rounded = kMinCapacity;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+} // namespace
+
+const char* TypeName(Type type)
+{
+    switch (type) {
+        case Type::JobStarted:  return "job_started";
+        case Type::JobEnded:    return "job_ended";
+        case Type::ItemStarted: return "item_started";
+        case Type::ItemUpdated: return "item_updated";
+        case Type::ItemEnded:   return "item_ended";
+        case Type::ReportLog:   return "report_log";
+    }
+    return "unknown";
+}
+
+Queue::Queue(size_t capacity)
+{
+    Allocate(capacity);
+}
+
+Queue::~Queue()
+{
+    Release();
+}
+
+double Queue::Now()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Queue::SetWakeup(std::function<void()> wakeup)
+{
+    m_wakeup = std::move(wakeup);
+}
+
+bool Queue::Push(Type type, uint64_t session, uint64_t item, uint64_t value)
+{
+    std::unique_ptr<std::string> message;
+    return PushSlot(type, session, item, value, message);
+}
+
+bool Queue::PushLog(uint64_t session, uint64_t item, bool isError, std::string message)
+{
+    auto text = std::make_unique<std::string>(std::move(message));
+    return PushSlot(Type::ReportLog, session, item, isError ? 1 : 0, text);
+}
+
+bool Queue::PushSlot(Type type, uint64_t session, uint64_t item, uint64_t value,
+                     std::unique_ptr<std::string>& message)
+{
+    // フレーム更新で埋め尽くして終了イベントを捨てないよう、更新には上限を設ける
+    if (type == Type::ItemUpdated &&
+        m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed) >= m_updateLimit) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 各スロットの sequence が書き込み可能な位置を示す（Vyukov の有界キュー）
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+        slot = &m_slots[pos & m_mask];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->type = type;
+    slot->session = session;
+    slot->item = item;
+    slot->value = value;
+    slot->time = Now();
+    slot->message = message.release();
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    m_received.fetch_add(1, std::memory_order_relaxed);
+    if (!m_wakePending.exchange(true, std::memory_order_acq_rel) && m_wakeup) {
+        m_wakeup();
+    }
+    return true;
+}
+
+std::vector<Event> Queue::Drain(double now, bool flushHeld)
+{
+    WinLockGuard lock(m_drainMutex);
+
+    // 先に戻しておき、取り出し中に積まれたイベントで再度起こしてもらう
+    m_wakePending.exchange(false, std::memory_order_acq_rel);
+
+    double rate = m_maxUpdateRate.load(std::memory_order_relaxed);
+    double interval = rate > 0.0 ? 1.0 / rate : 0.0;
+
+    std::vector<Event> batch;
+    uint64_t coalesced = 0;
+
+    auto emitHeld = [&](std::map<ItemKey, Event>::iterator it) {
+        m_lastUpdate[it->first] = now;
+        batch.push_back(std::move(it->second));
+        return m_held.erase(it);
+    };
+
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = m_slots[pos & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            break;
+        }
+
+        Event event;
+        event.type = slot.type;
+        event.session = slot.session;
+        event.item = slot.item;
+        event.value = slot.value;
+        event.time = slot.time;
+        if (slot.message) {
+            event.message = std::move(*slot.message);
+            delete slot.message;
+            slot.message = nullptr;
+        }
+        slot.sequence.store(pos + m_mask + 1, std::memory_order_release);
+        m_head.store(++pos, std::memory_order_release);
+
+        ItemKey key(event.session, event.item);
+        switch (event.type) {
+            case Type::ItemUpdated: {
+                auto it = m_held.find(key);
+                if (it == m_held.end()) {
+                    m_held.emplace(key, std::move(event));
+                } else {
+                    it->second.value = event.value;
+                    it->second.time = event.time;
+                    it->second.merged++;
+                    coalesced++;
+                }
+                break;
+            }
+            case Type::ItemStarted:
+            case Type::ItemEnded:
+            case Type::ReportLog: {
+                // 保留中の更新はそのアイテムの次のイベントより先に渡す
+                auto it = m_held.find(key);
+                if (it != m_held.end()) {
+                    emitHeld(it);
+                }
+                if (event.type == Type::ItemEnded) {
+                    m_lastUpdate.erase(key);
+                }
+                batch.push_back(std::move(event));
+                break;
+            }
+            case Type::JobEnded: {
+                for (auto it = m_held.begin(); it != m_held.end();) {
+                    it = it->first.first == event.session ? emitHeld(it) : std::next(it);
+                }
+                for (auto it = m_lastUpdate.begin(); it != m_lastUpdate.end();) {
+                    it = it->first.first == event.session ? m_lastUpdate.erase(it) : std::next(it);
+                }
+                batch.push_back(std::move(event));
+                break;
+            }
+            case Type::JobStarted:
+                batch.push_back(std::move(event));
+                break;
+        }
+    }
+
+    // 頻度の上限に達していない保留分を渡し、残りは最も早く渡せる時刻を覚える
+    m_heldDue = 0.0;
+    for (auto it = m_held.begin(); it != m_held.end();) {
+        auto last = m_lastUpdate.find(it->first);
+        bool due = flushHeld || interval <= 0.0 || last == m_lastUpdate.end() ||
+                   now >= last->second + interval;
+        if (!due) {
+            double dueTime = last->second + interval;
+            m_heldDue = m_heldDue > 0.0 ? (std::min)(m_heldDue, dueTime) : dueTime;
+        }
+        it = due ? emitHeld(it) : std::next(it);
+    }
+
+    m_coalesced.fetch_add(coalesced, std::memory_order_relaxed);
+    if (!batch.empty()) {
+        m_delivered.fetch_add(batch.size(), std::memory_order_relaxed);
+        m_batches.fetch_add(1, std::memory_order_relaxed);
+    }
+    return batch;
+}
+
+double Queue::NextHeldDue() const
+{
+    WinLockGuard lock(m_drainMutex);
+    return m_held.empty() ? 0.0 : m_heldDue;
+}
+
+void Queue::SetMaxUpdateRate(double rate)
+{
+    m_maxUpdateRate.store((std::max)(rate, 0.0), std::memory_order_relaxed);
+}
+
+double Queue::GetMaxUpdateRate() const
+{
+    return m_maxUpdateRate.load(std::memory_order_relaxed);
+}
+
+void Queue::Reset(size_t capacity)
+{
+    WinLockGuard lock(m_drainMutex);
+    Release();
+    Allocate(capacity);
+}
+
+Stats Queue::GetStats() const
+{
+    Stats stats;
+    stats.received = m_received.load(std::memory_order_relaxed);
+    stats.dropped = m_dropped.load(std::memory_order_relaxed);
+    stats.coalesced = m_coalesced.load(std::memory_order_relaxed);
+    stats.delivered = m_delivered.load(std::memory_order_relaxed);
+    stats.batches = m_batches.load(std::memory_order_relaxed);
+    stats.pending = m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed);
+    stats.capacity = m_mask + 1;
+    stats.maxUpdateRate = m_maxUpdateRate.load(std::memory_order_relaxed);
+
+    WinLockGuard lock(m_drainMutex);
+    stats.held = m_held.size();
+    return stats;
+}
+
+void Queue::Allocate(size_t capacity)
+{
+    capacity = RoundCapacity(capacity);
+    m_slots.reset(new Slot[capacity]);
+    for (size_t i = 0; i < capacity; i++) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_mask = capacity - 1;
+    m_updateLimit = capacity - capacity / 4;
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+    m_wakePending.store(false, std::memory_order_release);
+}
+
+void Queue::Release()
+{
+    if (m_slots) {
+        for (size_t i = 0; i <= m_mask; i++) {
+            delete m_slots[i].message;
+            m_slots[i].message = nullptr;
+        }
+    }
+    m_held.clear();
+    m_lastUpdate.clear();
+    m_heldDue = 0.0;
+}
+
+} // namespace RenderEvents
+} // namespace PyAE
@@ -0,0 +1,664 @@
+// RenderOptionsPool.cpp
+// PyAE - Python for After Effects
+// レンダーオプション / レイヤーレンダーオプションの再利用プール
+
+#include "RenderOptionsPool.h"
+#include "PluginState.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace PyAE {
+
+namespace {
+
+void Check(A_Err err, const char* what)
+{
+    if (err != A_Err_NONE) {
+        throw std::runtime_error(std::string(what) + " failed (error code: " + std::to_string(err) + ")");
+    }
+}
+
+// 既定値に影響するプロジェクト・アイテムの状態
+void ReadItemState(AEGP_ItemH itemH, AEGP_ProjBitDepth* bitDepth, A_Time* currentTime)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+    if (!suites.projSuite || !suites.itemSuite) {
+        throw std::runtime_error("Project / Item Suite not available");
+    }
+    AEGP_ProjectH projH = nullptr;
+    Check(suites.projSuite->AEGP_GetProjectByIndex(0, &projH), "AEGP_GetProjectByIndex");
+    Check(suites.projSuite->AEGP_GetProjectBitDepth(projH, bitDepth), "AEGP_GetProjectBitDepth");
+    Check(suites.itemSuite->AEGP_GetItemCurrentTime(itemH, currentTime), "AEGP_GetItemCurrentTime");
+}
+
+OptionsDefaultsStamp StampItem(AEGP_ItemH itemH)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+    if (!suites.renderSuite) {
+        throw std::runtime_error("Render Suite not available");
+    }
+    OptionsDefaultsStamp stamp;
+    Check(suites.renderSuite->AEGP_GetCurrentTimestamp(&stamp.timestamp), "AEGP_GetCurrentTimestamp");
+    ReadItemState(itemH, &stamp.bitDepth, &stamp.currentTime);
+    return stamp;
+}
+
+bool ItemChanged(AEGP_ItemH itemH, const OptionsDefaultsStamp& stamp, const char* name)
+{
+    try {
+        AEGP_ProjBitDepth bitDepth = 0;
+        A_Time currentTime = {0, 1};
+        ReadItemState(itemH, &bitDepth, &currentTime);
+        if (bitDepth != stamp.bitDepth || currentTime.value != stamp.currentTime.value ||
+            currentTime.scale != stamp.currentTime.scale) {
+            return true;
+        }
+
+        // フレームレート・解像度などアイテムの設定の変更
+        const auto& suites = PluginState::Instance().GetSuites();
+        if (!suites.renderSuite) {
+            return true;
+        }
+        A_Time start = {0, 1};
+        A_Time duration = {0, 1};
+        Check(suites.itemSuite->AEGP_GetItemDuration(itemH, &duration), "AEGP_GetItemDuration");
+        if (duration.value <= 0) {
+            duration = {1, 1};     // 静止画
+        }
+        A_Boolean changed = FALSE;
+        Check(suites.renderSuite->AEGP_HasItemChangedSinceTimestamp(itemH, &start, &duration,
+                                                                    &stamp.timestamp, &changed),
+              "AEGP_HasItemChangedSinceTimestamp");
+        return changed != FALSE;
+    } catch (const std::exception& e) {
+        PYAE_LOG_WARNING(name, std::string("Cannot check item changes: ") + e.what());
+        return true;
+    }
+}
+
+AEGP_ItemH LayerCompItem(AEGP_LayerH layerH)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+    if (!suites.layerSuite || !suites.compSuite) {
+        throw std::runtime_error("Layer / Comp Suite not available");
+    }
+    AEGP_CompH compH = nullptr;
+    Check(suites.layerSuite->AEGP_GetLayerParentComp(layerH, &compH), "AEGP_GetLayerParentComp");
+    AEGP_ItemH itemH = nullptr;
+    Check(suites.compSuite->AEGP_GetItemFromComp(compH, &itemH), "AEGP_GetItemFromComp");
+    return itemH;
+}
+
+} // anonymous namespace
+
+// =============================================================
+// RenderOptionsTraits
+// =============================================================
+
+const char* RenderOptionsTraits::Name()
+{
+    return "RenderOptionsPool";
+}
+
+uint64_t RenderOptionsTraits::OwnerId(AEGP_ItemH itemH)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+    if (!suites.itemSuite) {
+        throw std::runtime_error("Item Suite not available");
+    }
+    A_long id = 0;
+    Check(suites.itemSuite->AEGP_GetItemID(itemH, &id), "AEGP_GetItemID");
+    return static_cast<uint64_t>(static_cast<uint32_t>(id));
+}
+
+AEGP_RenderOptionsH RenderOptionsTraits::New(AEGP_ItemH itemH)
+{
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    if (!suites.renderOptionsSuite) {
+        throw std::runtime_error("RenderOptions Suite not available");
+    }
+    AEGP_RenderOptionsH optionsH = nullptr;
+    Check(suites.renderOptionsSuite->AEGP_NewFromItem(state.GetPluginID(), itemH, &optionsH),
+          "AEGP_NewFromItem");
+    return optionsH;
+}
+
+void RenderOptionsTraits::Dispose(AEGP_RenderOptionsH optionsH)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+    if (suites.renderOptionsSuite) {
+        suites.renderOptionsSuite->AEGP_Dispose(optionsH);
+    }
+}
+
+RenderOptionsDefaults RenderOptionsTraits::Capture(AEGP_RenderOptionsH optionsH)
+{
+    const auto& s = PluginState::Instance().GetSuites().renderOptionsSuite;
+    RenderOptionsDefaults d;
+    Check(s->AEGP_GetTime(optionsH, &d.time), "AEGP_GetTime");
+    Check(s->AEGP_GetTimeStep(optionsH, &d.timeStep), "AEGP_GetTimeStep");
+    Check(s->AEGP_GetWorldType(optionsH, &d.worldType), "AEGP_GetWorldType");
+    Check(s->AEGP_GetFieldRender(optionsH, &d.field), "AEGP_GetFieldRender");
+    Check(s->AEGP_GetDownsampleFactor(optionsH, &d.downsampleX, &d.downsampleY),
+          "AEGP_GetDownsampleFactor");
+    Check(s->AEGP_GetRegionOfInterest(optionsH, &d.roi), "AEGP_GetRegionOfInterest");
+    Check(s->AEGP_GetMatteMode(optionsH, &d.matteMode), "AEGP_GetMatteMode");
+    Check(s->AEGP_GetChannelOrder(optionsH, &d.channelOrder), "AEGP_GetChannelOrder");
+    Check(s->AEGP_GetRenderGuideLayers(optionsH, &d.guideLayers), "AEGP_GetRenderGuideLayers");
+    Check(s->AEGP_GetRenderQuality(optionsH, &d.quality), "AEGP_GetRenderQuality");
+    return d;
+}
+
+void RenderOptionsTraits::Reset(AEGP_RenderOptionsH optionsH, const RenderOptionsDefaults& d,
+                                uint32_t fields)
+{
+    const auto& s = PluginState::Instance().GetSuites().renderOptionsSuite;
+    if (fields & OptionsField::Time) {
+        Check(s->AEGP_SetTime(optionsH, d.time), "AEGP_SetTime");
+    }
+    if (fields & OptionsField::TimeStep) {
+        Check(s->AEGP_SetTimeStep(optionsH, d.timeStep), "AEGP_SetTimeStep");
+    }
+    if (fields & OptionsField::WorldType) {
+        Check(s->AEGP_SetWorldType(optionsH, d.worldType), "AEGP_SetWorldType");
+    }
+    if (fields & OptionsField::FieldRender) {
+        Check(s->AEGP_SetFieldRender(optionsH, d.field), "AEGP_SetFieldRender");
+    }
+    if (fields & OptionsField::Downsample) {
+        Check(s->AEGP_SetDownsampleFactor(optionsH, d.downsampleX, d.downsampleY),
+              "AEGP_SetDownsampleFactor");
+    }
+    if (fields & OptionsField::RegionOfInterest) {
+        Check(s->AEGP_SetRegionOfInterest(optionsH, &d.roi), "AEGP_SetRegionOfInterest");
+    }
+    if (fields & OptionsField::MatteMode) {
+        Check(s->AEGP_SetMatteMode(optionsH, d.matteMode), "AEGP_SetMatteMode");
+    }
+    if (fields & OptionsField::ChannelOrder) {
+        Check(s->AEGP_SetChannelOrder(optionsH, d.channelOrder), "AEGP_SetChannelOrder");
+    }
+    if (fields & OptionsField::GuideLayers) {
+        Check(s->AEGP_SetRenderGuideLayers(optionsH, d.guideLayers), "AEGP_SetRenderGuideLayers");
+    }
+    if (fields & OptionsField::Quality) {
+        Check(s->AEGP_SetRenderQuality(optionsH, d.quality), "AEGP_SetRenderQuality");
+    }
+}
+
+OptionsDefaultsStamp RenderOptionsTraits::Stamp(AEGP_ItemH itemH)
+{
+    return StampItem(itemH);
+}
+
+bool RenderOptionsTraits::Changed(AEGP_ItemH itemH, const OptionsDefaultsStamp& stamp)
+{
+    return ItemChanged(itemH, stamp, Name());
+}
+
+// =============================================================
+// LayerRenderOptionsTraits
+// =============================================================
+
+const char* LayerRenderOptionsTraits::Name()
+{
+    return "LayerRenderOptionsPool";
+}
+
+uint64_t LayerRenderOptionsTraits::OwnerId(AEGP_LayerH layerH)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+    if (!suites.layerSuite) {
+        throw std::runtime_error("Layer Suite not available");
+    }
+    AEGP_LayerIDVal id = 0;
+    Check(suites.layerSuite->AEGP_GetLayerID(layerH, &id), "AEGP_GetLayerID");
+    return static_cast<uint64_t>(static_cast<uint32_t>(id));
+}
+
+AEGP_LayerRenderOptionsH LayerRenderOptionsTraits::New(AEGP_LayerH layerH)
+{
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    if (!suites.layerRenderOptionsSuite) {
+        throw std::runtime_error("LayerRenderOptions Suite not available");
+    }
+    AEGP_LayerRenderOptionsH optionsH = nullptr;
+    Check(suites.layerRenderOptionsSuite->AEGP_NewFromLayer(state.GetPluginID(), layerH, &optionsH),
+          "AEGP_NewFromLayer");
+    return optionsH;
+}
+
+void LayerRenderOptionsTraits::Dispose(AEGP_LayerRenderOptionsH optionsH)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+    if (suites.layerRenderOptionsSuite) {
+        suites.layerRenderOptionsSuite->AEGP_Dispose(optionsH);
+    }
+}
+
+LayerRenderOptionsDefaults LayerRenderOptionsTraits::Capture(AEGP_LayerRenderOptionsH optionsH)
+{
+    const auto& s = PluginState::Instance().GetSuites().layerRenderOptionsSuite;
+    LayerRenderOptionsDefaults d;
+    Check(s->AEGP_GetTime(optionsH, &d.time), "AEGP_GetTime");
+    Check(s->AEGP_GetTimeStep(optionsH, &d.timeStep), "AEGP_GetTimeStep");
+    Check(s->AEGP_GetWorldType(optionsH, &d.worldType), "AEGP_GetWorldType");
+    Check(s->AEGP_GetDownsampleFactor(optionsH, &d.downsampleX, &d.downsampleY),
+          "AEGP_GetDownsampleFactor");
+    Check(s->AEGP_GetMatteMode(optionsH, &d.matteMode), "AEGP_GetMatteMode");
+    return d;
+}
+
+void LayerRenderOptionsTraits::Reset(AEGP_LayerRenderOptionsH optionsH,
+                                     const LayerRenderOptionsDefaults& d, uint32_t fields)
+{
+    const auto& s = PluginState::Instance().GetSuites().layerRenderOptionsSuite;
+    if (fields & OptionsField::Time) {
+        Check(s->AEGP_SetTime(optionsH, d.time), "AEGP_SetTime");
+    }
+    if (fields & OptionsField::TimeStep) {
+        Check(s->AEGP_SetTimeStep(optionsH, d.timeStep), "AEGP_SetTimeStep");
+    }
+    if (fields & OptionsField::WorldType) {
+        Check(s->AEGP_SetWorldType(optionsH, d.worldType), "AEGP_SetWorldType");
+    }
+    if (fields & OptionsField::Downsample) {
+        Check(s->AEGP_SetDownsampleFactor(optionsH, d.downsampleX, d.downsampleY),
+              "AEGP_SetDownsampleFactor");
+    }
+    if (fields & OptionsField::MatteMode) {
+        Check(s->AEGP_SetMatteMode(optionsH, d.matteMode), "AEGP_SetMatteMode");
+    }
+}
+
+OptionsDefaultsStamp LayerRenderOptionsTraits::Stamp(AEGP_LayerH layerH)
+{
+    return StampItem(LayerCompItem(layerH));
+}
+
+bool LayerRenderOptionsTraits::Changed(AEGP_LayerH layerH, const OptionsDefaultsStamp& stamp)
+{
+    try {
+        return ItemChanged(LayerCompItem(layerH), stamp, Name());
+    } catch (const std::exception& e) {
+        PYAE_LOG_WARNING(Name(), std::string("Cannot check layer changes: ") + e.what());
+        return true;
+    }
+}
+
+// =============================================================
+// OptionsPool
+// =============================================================
+
+template <typename Traits>
+OptionsPool<Traits>& OptionsPool<Traits>::Instance()
+{
+    static OptionsPool instance;
+    return instance;
+}
+
+template <typename Traits>
+typename OptionsPool<Traits>::Handle OptionsPool<Traits>::Acquire(Owner owner, Key* key)
+{
+    if (!owner) {
+        throw std::invalid_argument("owner handle must not be null");
+    }
+    Key k;
+    k.owner = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(owner));
+    k.id = Traits::OwnerId(owner);
+    *key = k;
+
+    // 既定値が古くなっていれば、取り直しに作ったハンドルをそのまま渡す
+    Handle fresh = nullptr;
+    if (RefreshDefaults(owner, k, &fresh)) {
+        WinLockGuard lock(m_mutex);
+        m_stats.live++;
+        m_stats.misses++;
+        return fresh;
+    }
+
+    Handle reused = nullptr;
+    uint32_t modified = 0;
+    Defaults defaults;
+    bool known = false;
+    {
+        WinLockGuard lock(m_mutex);
+        auto it = m_entries.find(k);
+        if (it != m_entries.end()) {
+            Entry& entry = it->second;
+            entry.lastUse = ++m_tick;
+            defaults = entry.defaults;
+            known = true;
+            if (m_enabled && !entry.idle.empty()) {
+                reused = entry.idle.back().handle;
+                modified = entry.idle.back().modified;
+                entry.idle.pop_back();
+                m_stats.pooled--;
+                m_stats.live++;
+                m_stats.hits++;
+            }
+        }
+    }
+
+    if (reused) {
+        if (!modified) {
+            return reused;
+        }
+        // 変更した項目だけ既定値に戻す（ロックの外で SDK を呼ぶ）
+        try {
+            Traits::Reset(reused, defaults, modified);
+            WinLockGuard lock(m_mutex);
+            m_stats.resets++;
+            return reused;
+        } catch (const std::exception& e) {
+            PYAE_LOG_WARNING(Traits::Name(), std::string("Reset failed, recreating: ") + e.what());
+            Traits::Dispose(reused);
+            WinLockGuard lock(m_mutex);
+            m_stats.live--;
+        }
+    }
+
+    // 作る前の状態を記録する（作った後の変更は次の取得で取り直す）
+    OptionsDefaultsStamp stamp;
+    if (!known) {
+        stamp = Traits::Stamp(owner);
+    }
+    Handle handle = Traits::New(owner);
+    if (!known) {
+        // 最初に作ったハンドルの値をアイテムの既定値とする
+        try {
+            defaults = Traits::Capture(handle);
+        } catch (...) {
+            Traits::Dispose(handle);
+            throw;
+        }
+    }
+
+    std::vector<Handle> disposed;
+    {
+        WinLockGuard lock(m_mutex);
+        m_stats.live++;
+        m_stats.misses++;
+        if (m_enabled && m_entries.find(k) == m_entries.end()) {
+            Entry& entry = m_entries[k];
+            entry.defaults = defaults;
+            entry.stamp = stamp;
+            entry.lastUse = ++m_tick;
+            EvictLocked(m_maxOwners, &k, disposed);
+        }
+    }
+    for (Handle h : disposed) {
+        Traits::Dispose(h);
+    }
+    return handle;
+}
+
+template <typename Traits>
+bool OptionsPool<Traits>::RefreshDefaults(Owner owner, const Key& key, Handle* fresh)
+{
+    OptionsDefaultsStamp stamp;
+    {
+        WinLockGuard lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            return false;
+        }
+        stamp = it->second.stamp;
+    }
+    if (!Traits::Changed(owner, stamp)) {
+        return false;
+    }
+
+    // 新しいハンドルの値を既定値にする
+    stamp = Traits::Stamp(owner);
+    Handle handle = Traits::New(owner);
+    Defaults defaults;
+    try {
+        defaults = Traits::Capture(handle);
+    } catch (...) {
+        Traits::Dispose(handle);
+        throw;
+    }
+
+    {
+        WinLockGuard lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            Entry& entry = it->second;
+            entry.defaults = defaults;
+            entry.stamp = stamp;
+            entry.lastUse = ++m_tick;
+            // プール内のハンドルは古い既定値のままなので、次の再利用で全項目を戻す
+            for (Idle& idle : entry.idle) {
+                idle.modified = OptionsField::All;
+            }
+        }
+        m_stats.refreshes++;
+    }
+    *fresh = handle;
+    return true;
+}
+
+template <typename Traits>
+void OptionsPool<Traits>::Release(const Key& key, Handle handle, uint32_t modified)
+{
+    if (!handle) {
+        return;
+    }
+
+    bool kept = false;
+    {
+        WinLockGuard lock(m_mutex);
+        if (m_stats.live > 0) {
+            m_stats.live--;
+        }
+        auto it = m_entries.find(key);
+        // 無効時・終了処理中・上限超過・アイテムが追い出された後は破棄
+        if (it != m_entries.end() && m_enabled &&
+            !PluginState::Instance().IsShuttingDown() &&
+            it->second.idle.size() < m_maxIdle) {
+            it->second.idle.push_back(Idle{handle, modified});
+            m_stats.pooled++;
+            m_stats.returned++;
+            kept = true;
+        }
+    }
+
+    if (!kept) {
+        Traits::Dispose(handle);
+    }
+}
+
+template <typename Traits>
+void OptionsPool<Traits>::Reset(const Key& key, Handle handle, uint32_t modified)
+{
+    Defaults defaults;
+    {
+        WinLockGuard lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            throw std::runtime_error(std::string(Traits::Name()) +
+                ": defaults for this item are no longer pooled");
+        }
+        defaults = it->second.defaults;
+    }
+    if (modified) {
+        Traits::Reset(handle, defaults, modified);
+    }
+}
+
+template <typename Traits>
+void OptionsPool<Traits>::Abandon()
+{
+    WinLockGuard lock(m_mutex);
+    if (m_stats.live > 0) {
+        m_stats.live--;
+    }
+}
+
+template <typename Traits>
+void OptionsPool<Traits>::EvictLocked(size_t maxOwners, const Key* keep, std::vector<Handle>& disposed)
+{
+    while (m_entries.size() > maxOwners) {
+        auto oldest = m_entries.end();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (keep && !(it->first < *keep) && !(*keep < it->first)) {
+                continue;
+            }
+            if (oldest == m_entries.end() || it->second.lastUse < oldest->second.lastUse) {
+                oldest = it;
+            }
+        }
+        if (oldest == m_entries.end()) {
+            break;
+        }
+        for (const Idle& idle : oldest->second.idle) {
+            disposed.push_back(idle.handle);
+        }
+        m_stats.pooled -= oldest->second.idle.size();
+        m_stats.evicted += oldest->second.idle.size();
+        m_entries.erase(oldest);
+    }
+}
+
+template <typename Traits>
+void OptionsPool<Traits>::TrimIdleLocked(size_t maxIdle, std::vector<Handle>& disposed)
+{
+    for (auto& pair : m_entries) {
+        auto& idle = pair.second.idle;
+        while (idle.size() > maxIdle) {
+            disposed.push_back(idle.front().handle);
+            idle.erase(idle.begin());
+            m_stats.pooled--;
+            m_stats.evicted++;
+        }
+    }
+}
+
+template <typename Traits>
+void OptionsPool<Traits>::SetMaxIdle(size_t maxIdle)
+{
+    std::vector<Handle> disposed;
+    {
+        WinLockGuard lock(m_mutex);
+        m_maxIdle = maxIdle;
+        TrimIdleLocked(m_maxIdle, disposed);
+    }
+    for (Handle h : disposed) {
+        Traits::Dispose(h);
+    }
+}
+
+template <typename Traits>
+size_t OptionsPool<Traits>::GetMaxIdle() const
+{
+    WinLockGuard lock(m_mutex);
+    return m_maxIdle;
+}
+
+template <typename Traits>
+void OptionsPool<Traits>::SetMaxOwners(size_t maxOwners)
+{
+    std::vector<Handle> disposed;
+    {
+        WinLockGuard lock(m_mutex);
+        m_maxOwners = maxOwners;
+        EvictLocked(m_maxOwners, nullptr, disposed);
+    }
+    for (Handle h : disposed) {
+        Traits::Dispose(h);
+    }
+}
+
+template <typename Traits>
+size_t OptionsPool<Traits>::GetMaxOwners() const
+{
+    WinLockGuard lock(m_mutex);
+    return m_maxOwners;
+}
+
+template <typename Traits>
+void OptionsPool<Traits>::SetEnabled(bool enabled)
+{
+    std::vector<Handle> disposed;
+    {
+        WinLockGuard lock(m_mutex);
+        m_enabled = enabled;
+        if (!enabled) {
+            EvictLocked(0, nullptr, disposed);
+        }
+    }
+    for (Handle h : disposed) {
+        Traits::Dispose(h);
+    }
+}
+
+template <typename Traits>
+bool OptionsPool<Traits>::IsEnabled() const
+{
+    WinLockGuard lock(m_mutex);
+    return m_enabled;
+}
+
+template <typename Traits>
+void OptionsPool<Traits>::Clear()
+{
+    std::vector<Handle> disposed;
+    {
+        WinLockGuard lock(m_mutex);
+        EvictLocked(0, nullptr, disposed);
+    }
+    for (Handle h : disposed) {
+        Traits::Dispose(h);
+    }
+}
+
+template <typename Traits>
+typename OptionsPool<Traits>::Stats OptionsPool<Traits>::GetStats() const
+{
+    WinLockGuard lock(m_mutex);
+    Stats stats = m_stats;
+    stats.owners = m_entries.size();
+    return stats;
+}
+
+template <typename Traits>
+void OptionsPool<Traits>::ResetStats()
+{
+    // 現在の保持数は残し、カウンタだけを初期化する
+    WinLockGuard lock(m_mutex);
+    m_stats.hits = 0;
+    m_stats.misses = 0;
+    m_stats.resets = 0;
+    m_stats.refreshes = 0;
+    m_stats.returned = 0;
+    m_stats.evicted = 0;
+}
+
+template <typename Traits>
+void OptionsPool<Traits>::Shutdown()
+{
+    std::vector<Handle> disposed;
+    {
+        WinLockGuard lock(m_mutex);
+        EvictLocked(0, nullptr, disposed);
+        if (m_stats.live > 0) {
+            PYAE_LOG_WARNING(Traits::Name(), std::to_string(m_stats.live) +
+                " handle(s) still alive at shutdown");
+        }
+    }
+    for (Handle h : disposed) {
+        Traits::Dispose(h);
+    }
+    PYAE_LOG_INFO(Traits::Name(), "Released " + std::to_string(disposed.size()) + " pooled handle(s)");
+}
+
+template class OptionsPool<RenderOptionsTraits>;
+template class OptionsPool<LayerRenderOptionsTraits>;
+
+} // namespace PyAE
@@ -0,0 +1,339 @@
+// RenderRequestQueue.cpp
+// PyAE - Python for After Effects
+// 非同期レンダー要求の待ち行列と取り消し
+
+#include "RenderRequestQueue.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace PyAE {
+
+namespace {
+
+double SecondsBetween(std::chrono::steady_clock::time_point from,
+                      std::chrono::steady_clock::time_point to)
+{
+    return std::chrono::duration<double>(to - from).count();
+}
+
+} // namespace
+
+// =============================================================
+// Request
+// =============================================================
+
+RenderRequestQueue::Request::Request(std::string group, double timeoutSeconds)
+    : m_group(std::move(group))
+    , m_submitted(std::chrono::steady_clock::now())
+{
+    if (timeoutSeconds > 0.0) {
+        m_hasDeadline = true;
+        m_deadline = m_submitted + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(timeoutSeconds));
+    }
+}
+
+bool RenderRequestQueue::Request::ShouldStop() const
+{
+    if (m_cancelRequested.load(std::memory_order_acquire)) {
+        return true;
+    }
+    return m_hasDeadline && std::chrono::steady_clock::now() >= m_deadline;
+}
+
+// =============================================================
+// RenderRequestQueue
+// =============================================================
+
+const char* RenderRequestQueue::StateName(State state)
+{
+    switch (state) {
+        case State::Pending:   return "pending";
+        case State::Rendering: return "rendering";
+        case State::Done:      return "done";
+        case State::Cancelled: return "cancelled";
+        case State::Failed:    return "failed";
+    }
+    return "unknown";
+}
+
+bool RenderRequestQueue::IsFinished(State state)
+{
+    return state == State::Done || state == State::Cancelled || state == State::Failed;
+}
+
+void RenderRequestQueue::SetWakeup(std::function<void()> wakeup)
+{
+    TaskQueueLock lock(m_cs);
+    m_wakeup = std::move(wakeup);
+}
+
+void RenderRequestQueue::Submit(const RequestPtr& request)
+{
+    if (!request) {
+        return;
+    }
+
+    bool wake = false;
+    {
+        TaskQueueLock lock(m_cs);
+        request->m_id = m_nextId++;
+        request->m_state = State::Pending;
+        m_stats.submitted++;
+
+        // 同じグループの古い要求は描かない（描画中なら中断を求める）
+        if (!request->m_group.empty()) {
+            std::vector<RequestPtr> older;
+            for (const auto& pending : m_pending) {
+                if (pending->m_group == request->m_group) {
+                    older.push_back(pending);
+                }
+            }
+            for (const auto& rendering : m_rendering) {
+                if (rendering->m_group == request->m_group) {
+                    older.push_back(rendering);
+                }
+            }
+            for (const auto& old : older) {
+                CancelLocked(old, &Stats::superseded, wake);
+            }
+        }
+
+        m_pending.push_back(request);
+        wake = ScheduleLocked() || wake;
+    }
+    if (wake) {
+        Wake();
+    }
+}
+
+bool RenderRequestQueue::Cancel(const RequestPtr& request)
+{
+    bool wake = false;
+    bool cancelled = false;
+    {
+        TaskQueueLock lock(m_cs);
+        cancelled = CancelLocked(request, &Stats::cancelled, wake);
+    }
+    if (wake) {
+        Wake();
+    }
+    return cancelled;
+}
+
+size_t RenderRequestQueue::CancelGroup(const std::string& group)
+{
+    bool wake = false;
+    size_t count = 0;
+    {
+        TaskQueueLock lock(m_cs);
+        std::vector<RequestPtr> targets;
+        for (const auto& pending : m_pending) {
+            if (group.empty() || pending->m_group == group) {
+                targets.push_back(pending);
+            }
+        }
+        for (const auto& rendering : m_rendering) {
+            if (group.empty() || rendering->m_group == group) {
+                targets.push_back(rendering);
+            }
+        }
+        for (const auto& target : targets) {
+            if (CancelLocked(target, &Stats::cancelled, wake)) {
+                count++;
+            }
+        }
+    }
+    if (wake) {
+        Wake();
+    }
+    return count;
+}
+
+RenderRequestQueue::RequestPtr RenderRequestQueue::Next()
+{
+    TaskQueueLock lock(m_cs);
+    while (!m_pending.empty()) {
+        RequestPtr request = m_pending.front();
+        m_pending.pop_front();
+
+        auto now = std::chrono::steady_clock::now();
+        if (request->m_hasDeadline && now >= request->m_deadline) {
+            m_stats.expired++;
+            FinishLocked(request, State::Cancelled, "Deadline exceeded before rendering started");
+            continue;
+        }
+
+        request->m_state = State::Rendering;
+        request->m_started = now;
+        request->m_waitSeconds = SecondsBetween(request->m_submitted, now);
+        m_rendering.push_back(request);
+        return request;
+    }
+    return nullptr;
+}
+
+void RenderRequestQueue::Finish(const RequestPtr& request, State state, const std::string& error)
+{
+    bool wake = false;
+    {
+        TaskQueueLock lock(m_cs);
+        auto it = std::find(m_rendering.begin(), m_rendering.end(), request);
+        if (it == m_rendering.end()) {
+            return;
+        }
+        m_rendering.erase(it);
+        request->m_renderSeconds = SecondsBetween(request->m_started, std::chrono::steady_clock::now());
+
+        // 中断を求めていれば、描き終わっていても古い結果として渡さない
+        if (request->ShouldStop()) {
+            uint64_t Stats::*reason = request->m_cancelReason ? request->m_cancelReason : &Stats::expired;
+            m_stats.*reason += 1;
+            m_stats.aborted++;
+            wake = FinishLocked(request, State::Cancelled,
+                                reason == &Stats::expired ? "Deadline exceeded while rendering"
+                                                          : std::string());
+        } else {
+            wake = FinishLocked(request, state, error);
+        }
+    }
+    if (wake) {
+        Wake();
+    }
+}
+
+std::vector<RenderRequestQueue::RequestPtr> RenderRequestQueue::TakeFinished()
+{
+    TaskQueueLock lock(m_cs);
+    std::vector<RequestPtr> finished;
+    finished.swap(m_finished);
+    return finished;
+}
+
+void RenderRequestQueue::EndPump()
+{
+    bool wake = false;
+    {
+        TaskQueueLock lock(m_cs);
+        m_scheduled = false;
+        wake = ScheduleLocked();
+    }
+    if (wake) {
+        Wake();
+    }
+}
+
+bool RenderRequestQueue::Wait(const RequestPtr& request, int timeoutMs) const
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds((std::max)(timeoutMs, 0));
+    TaskQueueLock lock(m_cs);
+    while (!IsFinished(request->m_state)) {
+        if (timeoutMs < 0) {
+            m_cs.wait();
+            continue;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        m_cs.wait_for(static_cast<DWORD>(remaining.count() + 1));
+    }
+    return true;
+}
+
+RenderRequestQueue::State RenderRequestQueue::GetState(const RequestPtr& request) const
+{
+    TaskQueueLock lock(m_cs);
+    return request->m_state;
+}
+
+std::string RenderRequestQueue::GetError(const RequestPtr& request) const
+{
+    TaskQueueLock lock(m_cs);
+    return request->m_error;
+}
+
+double RenderRequestQueue::GetWaitSeconds(const RequestPtr& request) const
+{
+    TaskQueueLock lock(m_cs);
+    return request->m_waitSeconds;
+}
+
+double RenderRequestQueue::GetRenderSeconds(const RequestPtr& request) const
+{
+    TaskQueueLock lock(m_cs);
+    return request->m_renderSeconds;
+}
+
+RenderRequestQueue::Stats RenderRequestQueue::GetStats() const
+{
+    TaskQueueLock lock(m_cs);
+    Stats stats = m_stats;
+    stats.pending = m_pending.size();
+    stats.rendering = m_rendering.size();
+    return stats;
+}
+
+bool RenderRequestQueue::FinishLocked(const RequestPtr& request, State state, std::string error)
+{
+    request->m_state = state;
+    request->m_error = std::move(error);
+    if (state == State::Done) {
+        m_stats.completed++;
+    } else if (state == State::Failed) {
+        m_stats.failed++;
+    }
+    m_finished.push_back(request);
+    m_cs.notify_all();
+    return ScheduleLocked();
+}
+
+bool RenderRequestQueue::CancelLocked(const RequestPtr& request, uint64_t Stats::*counter, bool& wake)
+{
+    switch (request->m_state) {
+        case State::Pending: {
+            auto it = std::find(m_pending.begin(), m_pending.end(), request);
+            if (it != m_pending.end()) {
+                m_pending.erase(it);
+            }
+            request->m_cancelRequested.store(true, std::memory_order_release);
+            m_stats.*counter += 1;
+            wake = FinishLocked(request, State::Cancelled, std::string()) || wake;
+            return true;
+        }
+        case State::Rendering:
+            // 描画はメインスレッドで進んでいるので、キャンセル関数に任せる
+            if (request->m_cancelRequested.exchange(true, std::memory_order_acq_rel)) {
+                return false;
+            }
+            request->m_cancelReason = counter;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool RenderRequestQueue::ScheduleLocked()
+{
+    if (m_scheduled || (m_pending.empty() && m_finished.empty()) || !m_wakeup) {
+        return false;
+    }
+    m_scheduled = true;
+    return true;
+}
+
+void RenderRequestQueue::Wake()
+{
+    std::function<void()> wakeup;
+    {
+        TaskQueueLock lock(m_cs);
+        wakeup = m_wakeup;
+    }
+    if (wakeup) {
+        wakeup();
+    }
+}
+
+} // namespace PyAE
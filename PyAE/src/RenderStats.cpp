@@ -0,0 +1,600 @@
+// RenderStats.cpp
+// PyAE - Python for After Effects
+// レンダージョブの統計収集（ジョブ・アイテム・フレームごとの時間とメモリ）
+
+#include "RenderStats.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+#include "JsonWriter.h"
+
+namespace PyAE {
+namespace RenderStats {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// 昇順に並べた値の分位点（線形補間、numpy.percentile と同じ）
+double Percentile(const std::vector<float>& sorted, double q)
+{
+    if (sorted.empty()) {
+        return kNaN;
+    }
+    double pos = q * static_cast<double>(sorted.size() - 1);
+    size_t lo = static_cast<size_t>(pos);
+    size_t hi = (std::min)(lo + 1, sorted.size() - 1);
+    double frac = pos - static_cast<double>(lo);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * frac;
+}
+
+// CSV の数値（NaN・終了前の負の時刻は空欄）
+void AppendNumber(std::string& out, double value)
+{
+    if (!std::isfinite(value)) {
+        return;
+    }
+    char buf[32];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, res.ptr);
+}
+
+void AppendInt(std::string& out, int64_t value)
+{
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, res.ptr);
+}
+
+void AppendUInt(std::string& out, uint64_t value)
+{
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, res.ptr);
+}
+
+// JSON の数値（NaN は null）
+void WriteNumber(JsonWriter& writer, double value)
+{
+    if (std::isfinite(value)) {
+        writer.Number(value);
+    } else {
+        writer.Null();
+    }
+}
+
+double EndOrNaN(double end)
+{
+    return end >= 0.0 ? end : kNaN;
+}
+
+bool MatchesItem(const std::vector<ItemRecord>& items, const FrameRecord& frame, uint64_t item)
+{
+    return item == 0 || items[frame.item].item == item;
+}
+
+} // namespace
+
+void Collector::SetMemorySampler(MemorySampler sampler, double interval)
+{
+    WinLockGuard lock(m_mutex);
+    m_sampler = std::move(sampler);
+    m_memoryInterval = interval;
+}
+
+void Collector::SetMaxFrames(size_t maxFrames)
+{
+    WinLockGuard lock(m_mutex);
+    m_maxFrames = maxFrames;
+}
+
+void Collector::Clear(double now)
+{
+    WinLockGuard lock(m_mutex);
+    m_origin = now;
+    m_lastTime = 0.0;
+    m_droppedFrames = 0;
+    m_events = 0;
+    m_jobs.clear();
+    m_items.clear();
+    m_frames.clear();
+    m_frames.shrink_to_fit();
+    m_memory.clear();
+    m_jobIndex.clear();
+    m_itemIndex.clear();
+    m_lastMemory = -1.0;
+}
+
+void Collector::Record(RenderEvents::Type type, uint64_t session, uint64_t item,
+                       uint64_t value, double now)
+{
+    WinLockGuard lock(m_mutex);
+    double time = now - m_origin;
+    m_lastTime = (std::max)(m_lastTime, time);
+    ++m_events;
+
+    switch (type) {
+        case RenderEvents::Type::JobStarted: {
+            auto it = m_jobIndex.find(session);
+            if (it != m_jobIndex.end()) {
+                JobRecord& job = m_jobs[it->second];
+                job.start = time;
+                job.end = -1.0;
+            } else {
+                FindJob(session, time);
+            }
+            SampleMemory(time, UINT32_MAX, true);
+            break;
+        }
+        case RenderEvents::Type::JobEnded: {
+            m_jobs[FindJob(session, time)].end = time;
+            SampleMemory(time, UINT32_MAX, true);
+            break;
+        }
+        case RenderEvents::Type::ItemStarted: {
+            bool created = false;
+            uint32_t index = FindItem(session, item, time, &created);
+            ItemRecord& rec = m_items[index];
+            rec.start = time;
+            rec.end = -1.0;
+            rec.lastFrame = time;
+            rec.status = -1;
+            SampleMemory(time, index, true);
+            break;
+        }
+        case RenderEvents::Type::ItemUpdated: {
+            bool created = false;
+            uint32_t index = FindItem(session, item, time, &created);
+            ItemRecord& rec = m_items[index];
+            // 開始を見ていないアイテムの最初のフレームは時間がわからない
+            float duration = created ? std::numeric_limits<float>::quiet_NaN()
+                                     : static_cast<float>(time - rec.lastFrame);
+            rec.lastFrame = time;
+            ++rec.frames;
+            ++m_jobs[rec.job].frames;
+            if (!created) {
+                if (rec.timedFrames == 0) {
+                    rec.frameTimeMin = duration;
+                    rec.frameTimeMax = duration;
+                } else {
+                    rec.frameTimeMin = (std::min)(rec.frameTimeMin, duration);
+                    rec.frameTimeMax = (std::max)(rec.frameTimeMax, duration);
+                }
+                ++rec.timedFrames;
+                rec.frameTimeTotal += duration;
+            }
+
+            if (m_frames.size() < m_maxFrames) {
+                FrameRecord frame;
+                frame.time = time;
+                frame.frameId = value;
+                frame.duration = duration;
+                frame.item = index;
+                m_frames.push_back(frame);
+            } else {
+                ++m_droppedFrames;
+            }
+            SampleMemory(time, index, false);
+            break;
+        }
+        case RenderEvents::Type::ItemEnded: {
+            bool created = false;
+            uint32_t index = FindItem(session, item, time, &created);
+            ItemRecord& rec = m_items[index];
+            rec.end = time;
+            rec.status = static_cast<int32_t>(value);
+            SampleMemory(time, index, true);
+            break;
+        }
+        case RenderEvents::Type::ReportLog: {
+            // アイテムに属さないログはジョブを作るだけ
+            if (item == 0) {
+                FindJob(session, time);
+                break;
+            }
+            bool created = false;
+            ItemRecord& rec = m_items[FindItem(session, item, time, &created)];
+            ++rec.logMessages;
+            if (value != 0) {
+                ++rec.logErrors;
+            }
+            break;
+        }
+    }
+}
+
+uint32_t Collector::FindJob(uint64_t session, double time)
+{
+    auto it = m_jobIndex.find(session);
+    if (it != m_jobIndex.end()) {
+        return it->second;
+    }
+    uint32_t index = static_cast<uint32_t>(m_jobs.size());
+    JobRecord job;
+    job.session = session;
+    job.start = time;
+    m_jobs.push_back(job);
+    m_jobIndex.emplace(session, index);
+    return index;
+}
+
+uint32_t Collector::FindItem(uint64_t session, uint64_t item, double time, bool* created)
+{
+    ItemKey key(session, item);
+    auto it = m_itemIndex.find(key);
+    if (it != m_itemIndex.end()) {
+        *created = false;
+        return it->second;
+    }
+    uint32_t job = FindJob(session, time);
+    ++m_jobs[job].items;
+
+    uint32_t index = static_cast<uint32_t>(m_items.size());
+    ItemRecord rec;
+    rec.session = session;
+    rec.item = item;
+    rec.start = time;
+    rec.lastFrame = time;
+    rec.job = job;
+    m_items.push_back(rec);
+    m_itemIndex.emplace(key, index);
+    *created = true;
+    return index;
+}
+
+void Collector::SampleMemory(double time, uint32_t item, bool force)
+{
+    if (!m_sampler || !(m_memoryInterval > 0.0)) {
+        return;
+    }
+    if (!force && m_lastMemory >= 0.0 && time - m_lastMemory < m_memoryInterval) {
+        return;
+    }
+    MemoryRecord rec;
+    rec.time = time;
+    rec.sample = m_sampler();
+    rec.item = item;
+    m_memory.push_back(rec);
+    m_lastMemory = time;
+}
+
+ItemSummary Collector::Summarize(uint32_t index, std::vector<float>& durations) const
+{
+    ItemSummary summary;
+    summary.record = m_items[index];
+    const ItemRecord& rec = summary.record;
+    double end = rec.end >= 0.0 ? rec.end : m_lastTime;
+    summary.renderTime = (std::max)(0.0, end - rec.start);
+    if (rec.timedFrames == 0) {
+        summary.mean = kNaN;
+        summary.record.frameTimeMin = std::numeric_limits<float>::quiet_NaN();
+        summary.record.frameTimeMax = std::numeric_limits<float>::quiet_NaN();
+    } else {
+        summary.mean = rec.frameTimeTotal / rec.timedFrames;
+    }
+    std::sort(durations.begin(), durations.end());
+    summary.p50 = Percentile(durations, 0.50);
+    summary.p95 = Percentile(durations, 0.95);
+    return summary;
+}
+
+std::vector<ItemSummary> Collector::SummarizeAll() const
+{
+    // フレームを1回だけ走査してアイテムごとに分ける
+    std::vector<std::vector<float>> durations(m_items.size());
+    for (const auto& frame : m_frames) {
+        if (std::isfinite(frame.duration)) {
+            durations[frame.item].push_back(frame.duration);
+        }
+    }
+    std::vector<ItemSummary> result;
+    result.reserve(m_items.size());
+    for (uint32_t i = 0; i < m_items.size(); ++i) {
+        result.push_back(Summarize(i, durations[i]));
+    }
+    return result;
+}
+
+std::vector<JobRecord> Collector::GetJobs() const
+{
+    WinLockGuard lock(m_mutex);
+    return m_jobs;
+}
+
+std::vector<ItemSummary> Collector::GetItems() const
+{
+    WinLockGuard lock(m_mutex);
+    return SummarizeAll();
+}
+
+std::vector<FrameRecord> Collector::GetFrames(uint64_t item) const
+{
+    WinLockGuard lock(m_mutex);
+    if (item == 0) {
+        return m_frames;
+    }
+    std::vector<FrameRecord> result;
+    for (const auto& frame : m_frames) {
+        if (MatchesItem(m_items, frame, item)) {
+            result.push_back(frame);
+        }
+    }
+    return result;
+}
+
+std::vector<MemoryRecord> Collector::GetMemory() const
+{
+    WinLockGuard lock(m_mutex);
+    return m_memory;
+}
+
+std::vector<FrameRecord> Collector::GetSlowestFrames(size_t count, uint64_t item) const
+{
+    std::vector<FrameRecord> timed;
+    {
+        WinLockGuard lock(m_mutex);
+        for (const auto& frame : m_frames) {
+            if (std::isfinite(frame.duration) && MatchesItem(m_items, frame, item)) {
+                timed.push_back(frame);
+            }
+        }
+    }
+    count = (std::min)(count, timed.size());
+    auto slower = [](const FrameRecord& a, const FrameRecord& b) {
+        return a.duration != b.duration ? a.duration > b.duration : a.time < b.time;
+    };
+    std::partial_sort(timed.begin(), timed.begin() + count, timed.end(), slower);
+    timed.resize(count);
+    return timed;
+}
+
+Histogram Collector::GetHistogram(size_t bins, double lo, double hi, uint64_t item) const
+{
+    std::vector<float> durations;
+    {
+        WinLockGuard lock(m_mutex);
+        for (const auto& frame : m_frames) {
+            if (std::isfinite(frame.duration) && MatchesItem(m_items, frame, item)) {
+                durations.push_back(frame.duration);
+            }
+        }
+    }
+
+    bins = (std::max)(bins, size_t(1));
+    if (!(lo < hi)) {
+        lo = 0.0;
+        hi = 0.0;
+        for (float d : durations) {
+            hi = (std::max)(hi, static_cast<double>(d));
+        }
+        if (!(hi > lo)) {
+            hi = lo + 1.0;
+        }
+    }
+
+    Histogram hist;
+    hist.counts.assign(bins, 0);
+    hist.edges.resize(bins + 1);
+    double width = (hi - lo) / static_cast<double>(bins);
+    for (size_t i = 0; i <= bins; ++i) {
+        hist.edges[i] = lo + width * static_cast<double>(i);
+    }
+    hist.edges[bins] = hi;
+
+    // numpy.histogram と同じく範囲外は数えず、最後のビンは右端を含む
+    for (float d : durations) {
+        double v = d;
+        if (v < lo || v > hi) {
+            continue;
+        }
+        size_t bin = static_cast<size_t>((v - lo) / width);
+        hist.counts[(std::min)(bin, bins - 1)]++;
+    }
+    return hist;
+}
+
+std::vector<std::pair<uint64_t, uint64_t>> Collector::GetItemKeys() const
+{
+    WinLockGuard lock(m_mutex);
+    std::vector<std::pair<uint64_t, uint64_t>> keys;
+    keys.reserve(m_items.size());
+    for (const auto& rec : m_items) {
+        keys.emplace_back(rec.session, rec.item);
+    }
+    return keys;
+}
+
+Counters Collector::GetCounters() const
+{
+    WinLockGuard lock(m_mutex);
+    Counters counters;
+    counters.jobs = m_jobs.size();
+    counters.items = m_items.size();
+    counters.frames = m_frames.size();
+    counters.memorySamples = m_memory.size();
+    counters.droppedFrames = m_droppedFrames;
+    counters.events = m_events;
+    counters.bytes = m_jobs.capacity() * sizeof(JobRecord)
+                   + m_items.capacity() * sizeof(ItemRecord)
+                   + m_frames.capacity() * sizeof(FrameRecord)
+                   + m_memory.capacity() * sizeof(MemoryRecord);
+    return counters;
+}
+
+std::string Collector::ToCsv(Table table) const
+{
+    WinLockGuard lock(m_mutex);
+    std::string out;
+
+    switch (table) {
+        case Table::Jobs:
+            out += "session_id,start,end,duration,items,frames\n";
+            for (const auto& job : m_jobs) {
+                AppendUInt(out, job.session); out += ',';
+                AppendNumber(out, job.start); out += ',';
+                AppendNumber(out, EndOrNaN(job.end)); out += ',';
+                AppendNumber(out, EndOrNaN(job.end) - job.start); out += ',';
+                AppendUInt(out, job.items); out += ',';
+                AppendUInt(out, job.frames); out += '\n';
+            }
+            break;
+
+        case Table::Items:
+            out += "session_id,item_id,status,start,end,render_time,frames,timed_frames,"
+                   "frame_time_total,frame_time_mean,frame_time_min,frame_time_max,"
+                   "frame_time_p50,frame_time_p95,log_messages,log_errors\n";
+            for (const auto& s : SummarizeAll()) {
+                const ItemRecord& rec = s.record;
+                AppendUInt(out, rec.session); out += ',';
+                AppendUInt(out, rec.item); out += ',';
+                AppendInt(out, rec.status); out += ',';
+                AppendNumber(out, rec.start); out += ',';
+                AppendNumber(out, EndOrNaN(rec.end)); out += ',';
+                AppendNumber(out, s.renderTime); out += ',';
+                AppendUInt(out, rec.frames); out += ',';
+                AppendUInt(out, rec.timedFrames); out += ',';
+                AppendNumber(out, rec.frameTimeTotal); out += ',';
+                AppendNumber(out, s.mean); out += ',';
+                AppendNumber(out, rec.frameTimeMin); out += ',';
+                AppendNumber(out, rec.frameTimeMax); out += ',';
+                AppendNumber(out, s.p50); out += ',';
+                AppendNumber(out, s.p95); out += ',';
+                AppendUInt(out, rec.logMessages); out += ',';
+                AppendUInt(out, rec.logErrors); out += '\n';
+            }
+            break;
+
+        case Table::Frames:
+            out.reserve(40 + m_frames.size() * 48);
+            out += "session_id,item_id,frame_id,time,duration\n";
+            for (const auto& frame : m_frames) {
+                const ItemRecord& rec = m_items[frame.item];
+                AppendUInt(out, rec.session); out += ',';
+                AppendUInt(out, rec.item); out += ',';
+                AppendUInt(out, frame.frameId); out += ',';
+                AppendNumber(out, frame.time); out += ',';
+                AppendNumber(out, frame.duration); out += '\n';
+            }
+            break;
+
+        case Table::Memory:
+            out += "time,session_id,item_id,working_set,private_bytes\n";
+            for (const auto& mem : m_memory) {
+                AppendNumber(out, mem.time); out += ',';
+                if (mem.item != UINT32_MAX) {
+                    AppendUInt(out, m_items[mem.item].session); out += ',';
+                    AppendUInt(out, m_items[mem.item].item); out += ',';
+                } else {
+                    out += ",,";
+                }
+                AppendUInt(out, mem.sample.workingSet); out += ',';
+                AppendUInt(out, mem.sample.privateBytes); out += '\n';
+            }
+            break;
+    }
+    return out;
+}
+
+std::string Collector::ToJson(int indent) const
+{
+    WinLockGuard lock(m_mutex);
+    JsonWriter writer(indent);
+
+    writer.BeginObject();
+    writer.Key("format"); writer.String("pyae-render-stats");
+    writer.Key("version"); writer.Int(1);
+    writer.Key("events"); writer.Int(static_cast<int64_t>(m_events));
+    writer.Key("dropped_frames"); writer.Int(static_cast<int64_t>(m_droppedFrames));
+    writer.Key("duration"); writer.Number(m_lastTime);
+
+    writer.Key("jobs");
+    writer.BeginArray();
+    for (const auto& job : m_jobs) {
+        writer.BeginObject();
+        writer.Key("session_id"); writer.Int(static_cast<int64_t>(job.session));
+        writer.Key("start"); writer.Number(job.start);
+        writer.Key("end"); WriteNumber(writer, EndOrNaN(job.end));
+        writer.Key("duration"); WriteNumber(writer, EndOrNaN(job.end) - job.start);
+        writer.Key("items"); writer.Int(job.items);
+        writer.Key("frames"); writer.Int(job.frames);
+        writer.EndObject();
+    }
+    writer.EndArray();
+
+    writer.Key("items");
+    writer.BeginArray();
+    for (const auto& s : SummarizeAll()) {
+        const ItemRecord& rec = s.record;
+        writer.BeginObject();
+        writer.Key("session_id"); writer.Int(static_cast<int64_t>(rec.session));
+        writer.Key("item_id"); writer.Int(static_cast<int64_t>(rec.item));
+        writer.Key("status"); writer.Int(rec.status);
+        writer.Key("start"); writer.Number(rec.start);
+        writer.Key("end"); WriteNumber(writer, EndOrNaN(rec.end));
+        writer.Key("render_time"); writer.Number(s.renderTime);
+        writer.Key("frames"); writer.Int(rec.frames);
+        writer.Key("timed_frames"); writer.Int(rec.timedFrames);
+        writer.Key("frame_time_total"); writer.Number(rec.frameTimeTotal);
+        writer.Key("frame_time_mean"); WriteNumber(writer, s.mean);
+        writer.Key("frame_time_min"); WriteNumber(writer, rec.frameTimeMin);
+        writer.Key("frame_time_max"); WriteNumber(writer, rec.frameTimeMax);
+        writer.Key("frame_time_p50"); WriteNumber(writer, s.p50);
+        writer.Key("frame_time_p95"); WriteNumber(writer, s.p95);
+        writer.Key("log_messages"); writer.Int(rec.logMessages);
+        writer.Key("log_errors"); writer.Int(rec.logErrors);
+        writer.EndObject();
+    }
+    writer.EndArray();
+
+    // フレームとメモリは列ごとの配列（item_index は items の位置）
+    writer.Key("frames");
+    writer.BeginObject();
+    writer.Key("item_index");
+    writer.BeginArray();
+    for (const auto& frame : m_frames) writer.Int(frame.item);
+    writer.EndArray();
+    writer.Key("frame_id");
+    writer.BeginArray();
+    for (const auto& frame : m_frames) writer.Int(static_cast<int64_t>(frame.frameId));
+    writer.EndArray();
+    writer.Key("time");
+    writer.BeginArray();
+    for (const auto& frame : m_frames) writer.Number(frame.time);
+    writer.EndArray();
+    writer.Key("duration");
+    writer.BeginArray();
+    for (const auto& frame : m_frames) WriteNumber(writer, frame.duration);
+    writer.EndArray();
+    writer.EndObject();
+
+    writer.Key("memory");
+    writer.BeginObject();
+    writer.Key("item_index");
+    writer.BeginArray();
+    for (const auto& mem : m_memory) {
+        if (mem.item != UINT32_MAX) writer.Int(mem.item); else writer.Null();
+    }
+    writer.EndArray();
+    writer.Key("time");
+    writer.BeginArray();
+    for (const auto& mem : m_memory) writer.Number(mem.time);
+    writer.EndArray();
+    writer.Key("working_set");
+    writer.BeginArray();
+    for (const auto& mem : m_memory) writer.Int(static_cast<int64_t>(mem.sample.workingSet));
+    writer.EndArray();
+    writer.Key("private_bytes");
+    writer.BeginArray();
+    for (const auto& mem : m_memory) writer.Int(static_cast<int64_t>(mem.sample.privateBytes));
+    writer.EndArray();
+    writer.EndObject();
+
+    writer.EndObject();
+    return writer.TakeString();
+}
+
+} // namespace RenderStats
+} // namespace PyAE
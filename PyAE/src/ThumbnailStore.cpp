@@ -0,0 +1,581 @@
+// ThumbnailStore.cpp
+// PyAE - Python for After Effects
+// プロジェクトアイテムのサムネイルのキャッシュ（メモリ + 圧縮したディスク）
+//
+// 圧縮は LZ4 と同じ形のシーケンス（トークン・リテラル・距離・一致長）で、
+// 4 バイトのハッシュ表から一致を探す。行の差分をとってからかけるので、
+// 単色や緩やかなグラデーションはほぼ 0 の並びになりよく縮む。
+
+#include "ThumbnailStore.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include "StringUtils.h"
+
+namespace PyAE {
+
+namespace {
+
+constexpr char kMagic[8] = {'P', 'Y', 'A', 'E', 'T', 'H', '0', '1'};
+constexpr const char* kExtension = ".pyaeth";
+constexpr int kMaxSide = 4096;
+
+struct FileHeader {
+    char magic[8];
+    uint64_t session;
+    int64_t projectTime;
+    int32_t stamp[4];
+    uint32_t itemId;
+    int32_t width;
+    int32_t height;
+    uint32_t dataBytes;     // 圧縮後のバイト数
+};
+static_assert(sizeof(FileHeader) == 56, "ThumbnailStore FileHeader must not contain padding");
+
+// 圧縮の定数
+constexpr int kMinMatch = 4;
+constexpr int kHashBits = 12;
+constexpr size_t kMaxOffset = 65535;
+constexpr size_t kLastLiterals = 5;     // 末尾はリテラルのまま残す（展開側の境界を簡単にする）
+
+std::filesystem::path ToPath(const std::string& utf8)
+{
+    return std::filesystem::path(StringUtils::Utf8ToWide(utf8));
+}
+
+uint32_t Read32(const uint8_t* p)
+{
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint32_t HashOf(uint32_t v)
+{
+    return (v * 2654435761u) >> (32 - kHashBits);
+}
+
+void WriteLength(std::vector<uint8_t>& out, size_t length)
+{
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+void EmitSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount,
+                  size_t offset, size_t matchLength)
+{
+    const bool hasMatch = matchLength >= kMinMatch;
+    const size_t matchCode = hasMatch ? matchLength - kMinMatch : 0;
+    uint8_t token = static_cast<uint8_t>((std::min)(literalCount, static_cast<size_t>(15)) << 4);
+    token |= static_cast<uint8_t>((std::min)(matchCode, static_cast<size_t>(15)));
+    out.push_back(token);
+    if (literalCount >= 15) {
+        WriteLength(out, literalCount - 15);
+    }
+    out.insert(out.end(), literals, literals + literalCount);
+    if (!hasMatch) {
+        return;
+    }
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15) {
+        WriteLength(out, matchCode - 15);
+    }
+}
+
+// 先頭行は左の画素、以降の行は上の画素との差にする（チャンネルごと、256 で巻き戻る）
+std::vector<uint8_t> Filter(const uint8_t* pixels, int width, int height)
+{
+    const size_t row = static_cast<size_t>(width) * 4;
+    std::vector<uint8_t> out(row * static_cast<size_t>(height));
+    for (size_t x = 0; x < row; ++x) {
+        out[x] = static_cast<uint8_t>(pixels[x] - (x >= 4 ? pixels[x - 4] : 0));
+    }
+    for (int y = 1; y < height; ++y) {
+        const uint8_t* cur = pixels + static_cast<size_t>(y) * row;
+        const uint8_t* up = cur - row;
+        uint8_t* dst = out.data() + static_cast<size_t>(y) * row;
+        for (size_t x = 0; x < row; ++x) {
+            dst[x] = static_cast<uint8_t>(cur[x] - up[x]);
+        }
+    }
+    return out;
+}
+
+void Unfilter(uint8_t* pixels, int width, int height)
+{
+    const size_t row = static_cast<size_t>(width) * 4;
+    for (size_t x = 4; x < row; ++x) {
+        pixels[x] = static_cast<uint8_t>(pixels[x] + pixels[x - 4]);
+    }
+    for (int y = 1; y < height; ++y) {
+        uint8_t* cur = pixels + static_cast<size_t>(y) * row;
+        const uint8_t* up = cur - row;
+        for (size_t x = 0; x < row; ++x) {
+            cur[x] = static_cast<uint8_t>(cur[x] + up[x]);
+        }
+    }
+}
+
+} // namespace
+
+// =============================================================
+// Thumbnail
+// =============================================================
+
+PixelConvert::ImageView ThumbnailStore::Thumbnail::View() const
+{
+    PixelConvert::ImageView view;
+    view.data = const_cast<uint8_t*>(pixels.data());
+    view.width = width;
+    view.height = height;
+    view.rowBytes = static_cast<ptrdiff_t>(width) * 4;
+    view.depth = PixelConvert::Depth::U8;
+    view.layout = PixelConvert::Layout::RGBA;
+    return view;
+}
+
+// =============================================================
+// 圧縮
+// =============================================================
+
+std::vector<uint8_t> ThumbnailStore::Compress(const uint8_t* pixels, int width, int height)
+{
+    std::vector<uint8_t> src = Filter(pixels, width, height);
+    const size_t size = src.size();
+    std::vector<uint8_t> out;
+    out.reserve(size / 2 + 16);
+
+    if (size < kMinMatch + kLastLiterals) {
+        EmitSequence(out, src.data(), size, 0, 0);
+        return out;
+    }
+
+    std::vector<uint32_t> table(static_cast<size_t>(1) << kHashBits, 0);   // 位置 + 1（0 は空）
+    const size_t matchLimit = size - kLastLiterals;
+    size_t anchor = 0;
+    size_t pos = 0;
+    while (pos + kMinMatch <= matchLimit) {
+        const uint32_t v = Read32(&src[pos]);
+        const uint32_t h = HashOf(v);
+        const size_t candidate = table[h];
+        table[h] = static_cast<uint32_t>(pos + 1);
+
+        if (candidate == 0 || pos - (candidate - 1) > kMaxOffset || Read32(&src[candidate - 1]) != v) {
+            ++pos;
+            continue;
+        }
+
+        const size_t ref = candidate - 1;
+        size_t length = kMinMatch;
+        while (pos + length < matchLimit && src[ref + length] == src[pos + length]) {
+            ++length;
+        }
+        EmitSequence(out, &src[anchor], pos - anchor, pos - ref, length);
+        pos += length;
+        anchor = pos;
+    }
+    EmitSequence(out, &src[anchor], size - anchor, 0, 0);
+    return out;
+}
+
+bool ThumbnailStore::Decompress(const uint8_t* data, size_t size, int width, int height,
+                                std::vector<uint8_t>& pixels)
+{
+    if (width <= 0 || height <= 0 || width > kMaxSide || height > kMaxSide) {
+        return false;
+    }
+    const size_t total = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    pixels.assign(total, 0);
+
+    size_t in = 0;
+    size_t out = 0;
+    auto readLength = [&](size_t base, size_t& length) {
+        length = base;
+        if (base != 15) {
+            return true;
+        }
+        while (in < size) {
+            uint8_t b = data[in++];
+            length += b;
+            if (b != 255) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    while (in < size) {
+        const uint8_t token = data[in++];
+        size_t literals = 0;
+        if (!readLength(token >> 4, literals) || literals > size - in || literals > total - out) {
+            return false;
+        }
+        std::memcpy(pixels.data() + out, data + in, literals);
+        in += literals;
+        out += literals;
+        if (in == size) {
+            break;      // 最後のシーケンスはリテラルだけ
+        }
+
+        if (size - in < 2) {
+            return false;
+        }
+        const size_t offset = static_cast<size_t>(data[in]) | (static_cast<size_t>(data[in + 1]) << 8);
+        in += 2;
+        size_t length = 0;
+        if (!readLength(token & 0x0F, length)) {
+            return false;
+        }
+        length += kMinMatch;
+        if (offset == 0 || offset > out || length > total - out) {
+            return false;
+        }
+        // 重なる一致（offset < length）は前から1バイトずつ写す
+        uint8_t* dst = pixels.data() + out;
+        const uint8_t* ref = dst - offset;
+        for (size_t i = 0; i < length; ++i) {
+            dst[i] = ref[i];
+        }
+        out += length;
+    }
+    if (out != total) {
+        return false;
+    }
+    Unfilter(pixels.data(), width, height);
+    return true;
+}
+
+// =============================================================
+// ThumbnailStore
+// =============================================================
+
+ThumbnailStore::ThumbnailStore(uint64_t maxMemoryBytes, const std::string& directory)
+    : m_directory(directory), m_maxMemoryBytes(maxMemoryBytes)
+{
+    if (m_directory.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::path dir = ToPath(m_directory);
+    std::filesystem::create_directories(dir, ec);
+    if (!std::filesystem::is_directory(dir, ec)) {
+        throw std::runtime_error("Cannot create thumbnail directory: " + m_directory);
+    }
+
+    // 既存のファイルはヘッダーだけ読んで一覧にする（検証は使うときに呼び出し側が行う）
+    for (const auto& file : std::filesystem::directory_iterator(dir, ec)) {
+        if (file.path().extension() != kExtension) {
+            continue;
+        }
+        std::ifstream in(file.path(), std::ios::binary);
+        FileHeader header;
+        if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+            header.width <= 0 || header.height <= 0) {
+            in.close();
+            std::filesystem::remove(file.path(), ec);
+            continue;
+        }
+        DiskEntry entry;
+        entry.bytes = sizeof(header) + header.dataBytes;
+        entry.rawBytes = static_cast<uint64_t>(header.width) * static_cast<uint64_t>(header.height) * 4;
+        m_disk[header.itemId] = entry;
+        m_stats.diskBytes += entry.bytes;
+        m_stats.rawBytes += entry.rawBytes;
+    }
+}
+
+uint64_t ThumbnailStore::EntryBytes(const Thumbnail& thumbnail)
+{
+    return static_cast<uint64_t>(thumbnail.pixels.size()) + sizeof(Thumbnail);
+}
+
+std::string ThumbnailStore::FilePath(uint32_t itemId) const
+{
+    char name[16];
+    std::snprintf(name, sizeof(name), "%08x", static_cast<unsigned int>(itemId));
+    std::string path = m_directory;
+    if (!path.empty() && path.back() != '/' && path.back() != '\\') {
+        path += '/';
+    }
+    return path + name + kExtension;
+}
+
+ThumbnailStore::ThumbnailPtr ThumbnailStore::Find(uint32_t itemId)
+{
+    WinLockGuard lock(m_mutex);
+    auto it = m_memoryIndex.find(itemId);
+    if (it != m_memoryIndex.end()) {
+        m_memory.splice(m_memory.begin(), m_memory, it->second);
+        m_stats.hits++;
+        return *it->second;
+    }
+    if (m_disk.count(itemId) != 0) {
+        if (ThumbnailPtr loaded = LoadLocked(itemId)) {
+            m_stats.diskHits++;
+            return loaded;
+        }
+    }
+    m_stats.misses++;
+    return nullptr;
+}
+
+ThumbnailStore::ThumbnailPtr ThumbnailStore::Insert(Thumbnail thumbnail)
+{
+    if (thumbnail.width <= 0 || thumbnail.height <= 0 ||
+        thumbnail.width > kMaxSide || thumbnail.height > kMaxSide ||
+        thumbnail.pixels.size() != static_cast<size_t>(thumbnail.width) * thumbnail.height * 4) {
+        throw std::invalid_argument("Invalid thumbnail size");
+    }
+
+    auto shared = std::make_shared<const Thumbnail>(std::move(thumbnail));
+    WinLockGuard lock(m_mutex);
+    m_stats.inserts++;
+    WriteLocked(*shared);
+    PutMemoryLocked(shared);
+    return shared;
+}
+
+ThumbnailStore::ThumbnailPtr ThumbnailStore::Restamp(const ThumbnailPtr& thumbnail, const Stamp& stamp,
+                                                     uint64_t session, int64_t projectTime)
+{
+    if (!thumbnail) {
+        return nullptr;
+    }
+    auto updated = std::make_shared<Thumbnail>(*thumbnail);
+    updated->stamp = stamp;
+    updated->session = session;
+    updated->projectTime = projectTime;
+    ThumbnailPtr shared = updated;
+
+    WinLockGuard lock(m_mutex);
+    if (m_disk.count(shared->itemId) == 0 || !WriteHeaderLocked(*shared)) {
+        WriteLocked(*shared);
+    }
+    PutMemoryLocked(shared);
+    return shared;
+}
+
+bool ThumbnailStore::Erase(uint32_t itemId)
+{
+    WinLockGuard lock(m_mutex);
+    bool found = m_memoryIndex.count(itemId) != 0;
+    EraseMemoryLocked(itemId);
+    auto disk = m_disk.find(itemId);
+    if (disk != m_disk.end()) {
+        std::error_code ec;
+        std::filesystem::remove(ToPath(FilePath(itemId)), ec);
+        m_stats.diskBytes -= disk->second.bytes;
+        m_stats.rawBytes -= disk->second.rawBytes;
+        m_disk.erase(disk);
+        found = true;
+    }
+    return found;
+}
+
+size_t ThumbnailStore::Clear()
+{
+    std::vector<uint32_t> ids;
+    {
+        WinLockGuard lock(m_mutex);
+        for (const auto& pair : m_memoryIndex) {
+            ids.push_back(pair.first);
+        }
+        for (const auto& pair : m_disk) {
+            if (m_memoryIndex.count(pair.first) == 0) {
+                ids.push_back(pair.first);
+            }
+        }
+    }
+    for (uint32_t id : ids) {
+        Erase(id);
+    }
+    return ids.size();
+}
+
+void ThumbnailStore::SetMaxMemoryBytes(uint64_t maxMemoryBytes)
+{
+    WinLockGuard lock(m_mutex);
+    m_maxMemoryBytes = maxMemoryBytes;
+    TrimMemoryLocked();
+}
+
+ThumbnailStore::Stats ThumbnailStore::GetStats() const
+{
+    WinLockGuard lock(m_mutex);
+    Stats stats = m_stats;
+    stats.memoryEntries = m_memory.size();
+    stats.diskEntries = m_disk.size();
+    stats.maxMemoryBytes = m_maxMemoryBytes;
+    return stats;
+}
+
+void ThumbnailStore::PutMemoryLocked(const ThumbnailPtr& thumbnail)
+{
+    EraseMemoryLocked(thumbnail->itemId);
+    if (EntryBytes(*thumbnail) > m_maxMemoryBytes) {
+        return;
+    }
+    m_memory.push_front(thumbnail);
+    m_memoryIndex[thumbnail->itemId] = m_memory.begin();
+    m_stats.memoryBytes += EntryBytes(*thumbnail);
+    TrimMemoryLocked();
+}
+
+void ThumbnailStore::EraseMemoryLocked(uint32_t itemId)
+{
+    auto it = m_memoryIndex.find(itemId);
+    if (it == m_memoryIndex.end()) {
+        return;
+    }
+    m_stats.memoryBytes -= EntryBytes(**it->second);
+    m_memory.erase(it->second);
+    m_memoryIndex.erase(it);
+}
+
+void ThumbnailStore::TrimMemoryLocked()
+{
+    // ディスクには書いてあるので、メモリからは捨てるだけ
+    while (m_stats.memoryBytes > m_maxMemoryBytes && !m_memory.empty()) {
+        EraseMemoryLocked(m_memory.back()->itemId);
+        m_stats.evictions++;
+    }
+}
+
+bool ThumbnailStore::WriteLocked(const Thumbnail& thumbnail)
+{
+    if (m_directory.empty()) {
+        return false;
+    }
+
+    std::vector<uint8_t> data = Compress(thumbnail.pixels.data(), thumbnail.width, thumbnail.height);
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.session = thumbnail.session;
+    header.projectTime = thumbnail.projectTime;
+    for (int i = 0; i < 4; ++i) {
+        header.stamp[i] = thumbnail.stamp[i];
+    }
+    header.itemId = thumbnail.itemId;
+    header.width = thumbnail.width;
+    header.height = thumbnail.height;
+    header.dataBytes = static_cast<uint32_t>(data.size());
+
+    // 古いファイルの分を差し引いてから書く
+    auto old = m_disk.find(thumbnail.itemId);
+    if (old != m_disk.end()) {
+        m_stats.diskBytes -= old->second.bytes;
+        m_stats.rawBytes -= old->second.rawBytes;
+        m_disk.erase(old);
+    }
+
+    const std::string path = FilePath(thumbnail.itemId);
+    std::ofstream file(ToPath(path), std::ios::binary | std::ios::trunc);
+    if (file) {
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        file.close();
+    }
+    if (!file) {
+        std::error_code ec;
+        std::filesystem::remove(ToPath(path), ec);
+        m_stats.diskErrors++;
+        return false;
+    }
+
+    DiskEntry entry;
+    entry.bytes = sizeof(header) + data.size();
+    entry.rawBytes = thumbnail.pixels.size();
+    m_disk[thumbnail.itemId] = entry;
+    m_stats.diskBytes += entry.bytes;
+    m_stats.rawBytes += entry.rawBytes;
+    m_stats.diskWrites++;
+    return true;
+}
+
+bool ThumbnailStore::WriteHeaderLocked(const Thumbnail& thumbnail)
+{
+    std::fstream file(ToPath(FilePath(thumbnail.itemId)), std::ios::binary | std::ios::in | std::ios::out);
+    FileHeader header;
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.itemId != thumbnail.itemId ||
+        header.width != thumbnail.width || header.height != thumbnail.height) {
+        return false;
+    }
+    header.session = thumbnail.session;
+    header.projectTime = thumbnail.projectTime;
+    for (int i = 0; i < 4; ++i) {
+        header.stamp[i] = thumbnail.stamp[i];
+    }
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    if (!file) {
+        m_stats.diskErrors++;
+        return false;
+    }
+    return true;
+}
+
+ThumbnailStore::ThumbnailPtr ThumbnailStore::LoadLocked(uint32_t itemId)
+{
+    auto fail = [&]() -> ThumbnailPtr {
+        m_stats.diskErrors++;
+        auto disk = m_disk.find(itemId);
+        if (disk != m_disk.end()) {
+            m_stats.diskBytes -= disk->second.bytes;
+            m_stats.rawBytes -= disk->second.rawBytes;
+            m_disk.erase(disk);
+        }
+        std::error_code ec;
+        std::filesystem::remove(ToPath(FilePath(itemId)), ec);
+        return nullptr;
+    };
+
+    std::ifstream file(ToPath(FilePath(itemId)), std::ios::binary);
+    FileHeader header;
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.itemId != itemId) {
+        file.close();
+        return fail();
+    }
+    std::vector<uint8_t> data(header.dataBytes);
+    if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        file.close();
+        return fail();
+    }
+    file.close();
+
+    Thumbnail thumbnail;
+    if (!Decompress(data.data(), data.size(), header.width, header.height, thumbnail.pixels)) {
+        return fail();
+    }
+    thumbnail.itemId = itemId;
+    for (int i = 0; i < 4; ++i) {
+        thumbnail.stamp[i] = header.stamp[i];
+    }
+    thumbnail.session = header.session;
+    thumbnail.projectTime = header.projectTime;
+    thumbnail.width = header.width;
+    thumbnail.height = header.height;
+
+    auto shared = std::make_shared<const Thumbnail>(std::move(thumbnail));
+    PutMemoryLocked(shared);
+    return shared;
+}
+
+} // namespace PyAE
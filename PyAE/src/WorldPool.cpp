@@ -0,0 +1,282 @@
+// WorldPool.cpp
+// PyAE - Python for After Effects
+// AEGP World の再利用プール
+
+#include "WorldPool.h"
+#include "PluginState.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace PyAE {
+
+AEGP_WorldH WorldPool::Acquire(AEGP_WorldType type, int width, int height, bool clear)
+{
+    AEGP_WorldH reused = nullptr;
+    {
+        WinLockGuard lock(m_mutex);
+        if (m_enabled) {
+            auto it = m_free.find(Key(static_cast<int>(type), width, height));
+            if (it != m_free.end() && !it->second.empty()) {
+                // 同じ形状で最も最近返却されたものを使う
+                LruList::iterator entry = it->second.back();
+                it->second.pop_back();
+                if (it->second.empty()) {
+                    m_free.erase(it);
+                }
+                reused = entry->worldH;
+                m_stats.pooledBytes -= entry->bytes;
+                m_live[reused] = entry->bytes;
+                m_stats.liveBytes += entry->bytes;
+                m_stats.hits++;
+                m_lru.erase(entry);
+            }
+        }
+    }
+
+    if (reused) {
+        if (clear) {
+            ClearWorld(reused, type, height);
+        }
+        return reused;
+    }
+
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+    if (!suites.worldSuite) {
+        throw std::runtime_error("World Suite not available");
+    }
+
+    AEGP_WorldH worldH = nullptr;
+    A_Err err = suites.worldSuite->AEGP_New(
+        state.GetPluginID(),
+        type,
+        static_cast<A_long>(width),
+        static_cast<A_long>(height),
+        &worldH);
+    if (err != A_Err_NONE) {
+        throw std::runtime_error("AEGP_New failed");
+    }
+
+    size_t bytes = WorldBytes(worldH, height);
+    WinLockGuard lock(m_mutex);
+    m_live[worldH] = bytes;
+    m_stats.liveBytes += bytes;
+    m_stats.misses++;
+    m_stats.peakBytes = (std::max)(m_stats.peakBytes, m_stats.liveBytes + m_stats.pooledBytes);
+    return worldH;
+}
+
+void WorldPool::Release(AEGP_WorldH worldH)
+{
+    if (!worldH) {
+        return;
+    }
+
+    auto& state = PluginState::Instance();
+    const auto& suites = state.GetSuites();
+
+    // 形状はロックの外で問い合わせる
+    AEGP_WorldType type = AEGP_WorldType_NONE;
+    A_long width = 0;
+    A_long height = 0;
+    bool queried = suites.worldSuite &&
+        suites.worldSuite->AEGP_GetType(worldH, &type) == A_Err_NONE &&
+        suites.worldSuite->AEGP_GetSize(worldH, &width, &height) == A_Err_NONE;
+
+    std::vector<AEGP_WorldH> disposed;
+    {
+        WinLockGuard lock(m_mutex);
+        auto live = m_live.find(worldH);
+        bool pooled = live != m_live.end();
+        size_t bytes = 0;
+        if (pooled) {
+            bytes = live->second;
+            m_stats.liveBytes -= bytes;
+            m_live.erase(live);
+        }
+
+        // プール外で確保されたもの・無効時・終了処理中・上限超過は破棄
+        if (!pooled || !queried || !m_enabled ||
+            state.IsShuttingDown() || bytes > m_maxBytes) {
+            disposed.push_back(worldH);
+        } else {
+            Key key(static_cast<int>(type), static_cast<int>(width), static_cast<int>(height));
+            m_lru.push_front(Entry{worldH, key, bytes});
+            m_free[key].push_back(m_lru.begin());
+            m_stats.pooledBytes += bytes;
+            m_stats.returned++;
+            TrimLocked(m_maxBytes, disposed);
+        }
+    }
+
+    for (AEGP_WorldH h : disposed) {
+        Dispose(h);
+    }
+}
+
+void WorldPool::TrimLocked(size_t maxBytes, std::vector<AEGP_WorldH>& disposed)
+{
+    while (m_stats.pooledBytes > maxBytes && !m_lru.empty()) {
+        LruList::iterator oldest = std::prev(m_lru.end());
+        auto free = m_free.find(oldest->key);
+        if (free != m_free.end()) {
+            auto& entries = free->second;
+            entries.erase(std::find(entries.begin(), entries.end(), oldest));
+            if (entries.empty()) {
+                m_free.erase(free);
+            }
+        }
+        m_stats.pooledBytes -= oldest->bytes;
+        m_stats.evicted++;
+        disposed.push_back(oldest->worldH);
+        m_lru.erase(oldest);
+    }
+}
+
+void WorldPool::Trim(size_t maxBytes)
+{
+    std::vector<AEGP_WorldH> disposed;
+    {
+        WinLockGuard lock(m_mutex);
+        TrimLocked(maxBytes, disposed);
+    }
+    for (AEGP_WorldH h : disposed) {
+        Dispose(h);
+    }
+}
+
+void WorldPool::SetMaxBytes(size_t maxBytes)
+{
+    std::vector<AEGP_WorldH> disposed;
+    {
+        WinLockGuard lock(m_mutex);
+        m_maxBytes = maxBytes;
+        TrimLocked(m_maxBytes, disposed);
+    }
+    for (AEGP_WorldH h : disposed) {
+        Dispose(h);
+    }
+}
+
+size_t WorldPool::GetMaxBytes() const
+{
+    WinLockGuard lock(m_mutex);
+    return m_maxBytes;
+}
+
+void WorldPool::SetEnabled(bool enabled)
+{
+    std::vector<AEGP_WorldH> disposed;
+    {
+        WinLockGuard lock(m_mutex);
+        m_enabled = enabled;
+        if (!enabled) {
+            TrimLocked(0, disposed);
+        }
+    }
+    for (AEGP_WorldH h : disposed) {
+        Dispose(h);
+    }
+}
+
+bool WorldPool::IsEnabled() const
+{
+    WinLockGuard lock(m_mutex);
+    return m_enabled;
+}
+
+WorldPool::Stats WorldPool::GetStats() const
+{
+    WinLockGuard lock(m_mutex);
+    Stats stats = m_stats;
+    stats.pooledWorlds = m_lru.size();
+    stats.liveWorlds = m_live.size();
+    return stats;
+}
+
+void WorldPool::ResetStats()
+{
+    // 現在の保持量は残し、カウンタとピークだけを初期化する
+    WinLockGuard lock(m_mutex);
+    m_stats.hits = 0;
+    m_stats.misses = 0;
+    m_stats.returned = 0;
+    m_stats.evicted = 0;
+    m_stats.peakBytes = m_stats.liveBytes + m_stats.pooledBytes;
+}
+
+void WorldPool::Shutdown()
+{
+    std::vector<AEGP_WorldH> disposed;
+    {
+        WinLockGuard lock(m_mutex);
+        TrimLocked(0, disposed);
+        if (!m_live.empty()) {
+            PYAE_LOG_WARNING("WorldPool", std::to_string(m_live.size()) +
+                " world(s) still alive at shutdown");
+        }
+    }
+    for (AEGP_WorldH h : disposed) {
+        Dispose(h);
+    }
+    PYAE_LOG_INFO("WorldPool", "Released " + std::to_string(disposed.size()) + " pooled world(s)");
+}
+
+void WorldPool::Dispose(AEGP_WorldH worldH)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+    if (suites.worldSuite) {
+        suites.worldSuite->AEGP_Dispose(worldH);
+    }
+}
+
+size_t WorldPool::WorldBytes(AEGP_WorldH worldH, int height)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+    A_u_long rowBytes = 0;
+    if (suites.worldSuite->AEGP_GetRowBytes(worldH, &rowBytes) != A_Err_NONE) {
+        return 0;
+    }
+    return static_cast<size_t>(rowBytes) * static_cast<size_t>(height);
+}
+
+void WorldPool::ClearWorld(AEGP_WorldH worldH, AEGP_WorldType type, int height)
+{
+    const auto& suites = PluginState::Instance().GetSuites();
+
+    void* baseAddr = nullptr;
+    A_Err err = A_Err_NONE;
+    switch (type) {
+        case AEGP_WorldType_8: {
+            PF_Pixel8* addr8 = nullptr;
+            err = suites.worldSuite->AEGP_GetBaseAddr8(worldH, &addr8);
+            baseAddr = addr8;
+            break;
+        }
+        case AEGP_WorldType_16: {
+            PF_Pixel16* addr16 = nullptr;
+            err = suites.worldSuite->AEGP_GetBaseAddr16(worldH, &addr16);
+            baseAddr = addr16;
+            break;
+        }
+        case AEGP_WorldType_32: {
+            PF_PixelFloat* addr32 = nullptr;
+            err = suites.worldSuite->AEGP_GetBaseAddr32(worldH, &addr32);
+            baseAddr = addr32;
+            break;
+        }
+        default:
+            return;
+    }
+
+    if (err == A_Err_NONE && baseAddr) {
+        std::memset(baseAddr, 0, WorldBytes(worldH, height));
+    }
+}
+
+} // namespace PyAE
@@ -0,0 +1,180 @@
+"""
+Pixel Convert Tests
+Tests for World.read_pixels / write_pixels layout, depth and alpha conversion
+"""
+import array
+
+import ae
+
+try:
+    from test_utils import TestSuite, assert_equal, assert_true, assert_raises, skip
+except ImportError:
+    from .test_utils import TestSuite, assert_equal, assert_true, assert_raises, skip
+
+suite = TestSuite("Pixel Convert")
+
+# 幅は SIMD ブロック（8画素）の端数も通るよう奇数にする
+WIDTH = 37
+HEIGHT = 5
+
+
+def _numpy():
+    try:
+        import numpy
+        return numpy
+    except ImportError:
+        skip("NumPy is not installed")
+
+
+def _close(expected, actual, tolerance=1e-6):
+    return all(abs(e - a) <= tolerance for e, a in zip(expected, actual))
+
+
+def _gradient_world(world_type=ae.WorldType.BIT8):
+    """World whose ARGB channels differ per pixel"""
+    world = ae.World.create(world_type, WIDTH, HEIGHT)
+    for y in range(HEIGHT):
+        for x in range(WIDTH):
+            world.set_pixel(x, y, x / WIDTH, y / HEIGHT, 0.25, (x + y) % 4 / 3.0)
+    return world
+
+
+@suite.teardown
+def teardown():
+    """Restore automatic SIMD selection"""
+    ae.World.set_simd_level("avx2")
+
+
+@suite.test
+def test_simd_level():
+    """Test that the selected instruction set is reported"""
+    assert_true(ae.World.simd_level() in ("avx2", "sse4.1", "scalar"))
+    assert_equal("scalar", ae.World.set_simd_level("scalar"))
+    ae.World.set_simd_level("avx2")
+    assert_raises(ValueError, ae.World.set_simd_level, "neon")
+
+
+@suite.test
+def test_read_rgba_float():
+    """Test that read_pixels returns normalized RGBA floats"""
+    world = _gradient_world()
+    pixels = world.read_pixels()
+    assert_equal((HEIGHT, WIDTH, 4), pixels.shape)
+    assert_equal("f", pixels.format)
+    expected = world.get_pixel(7, 3)
+    actual = tuple(pixels[3, 7, i] for i in range(4))
+    assert_true(_close(expected, actual), f"{actual} != {expected}")
+
+
+@suite.test
+def test_layouts_reorder_channels():
+    """Test that BGRA / ARGB / PLANAR place the channels as named"""
+    world = _gradient_world()
+    rgba = world.read_pixels(depth=ae.WorldType.BIT8)
+    bgra = world.read_pixels(layout=ae.PixelLayout.BGRA, depth=ae.WorldType.BIT8)
+    argb = world.read_pixels(layout=ae.PixelLayout.ARGB, depth=ae.WorldType.BIT8)
+    planar = world.read_pixels(layout=ae.PixelLayout.PLANAR, depth=ae.WorldType.BIT8)
+    assert_equal((4, HEIGHT, WIDTH), planar.shape)
+
+    # ARGB は World のメモリそのもの
+    assert_equal(bytes(world.get_pixels())[:WIDTH * 4], bytes(argb)[:WIDTH * 4])
+    for y, x in ((0, 0), (2, 9), (4, WIDTH - 1)):
+        r, g, b, a = (rgba[y, x, i] for i in range(4))
+        assert_equal((b, g, r, a), tuple(bgra[y, x, i] for i in range(4)))
+        assert_equal((a, r, g, b), tuple(argb[y, x, i] for i in range(4)))
+        assert_equal((r, g, b, a), tuple(planar[i, y, x] for i in range(4)))
+
+
+@suite.test
+def test_round_trip_is_lossless():
+    """Test that 8/16-bit worlds survive a float / planar round trip"""
+    for world_type in (ae.WorldType.BIT8, ae.WorldType.BIT16):
+        world = _gradient_world(world_type)
+        original = bytes(world.get_pixels())
+        for layout in (ae.PixelLayout.RGBA, ae.PixelLayout.BGRA, ae.PixelLayout.PLANAR):
+            data = world.read_pixels(layout=layout)
+            copy = ae.World.create(world_type, WIDTH, HEIGHT)
+            copy.write_pixels(data, layout=layout)
+            assert_equal(original, bytes(copy.get_pixels()))
+
+
+@suite.test
+def test_premultiply_and_unpremultiply():
+    """Test alpha ops and that zero alpha unpremultiplies to black"""
+    world = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    world.set_pixel(0, 0, 0.8, 0.4, 0.2, 0.5)
+    world.set_pixel(1, 0, 0.8, 0.4, 0.2, 0.0)
+
+    pre = world.read_pixels(alpha=ae.AlphaOp.PREMULTIPLY)
+    assert_true(_close((0.4, 0.2, 0.1, 0.5), tuple(pre[0, 0, i] for i in range(4))),
+                "premultiplied color")
+
+    world.write_pixels(pre, alpha=ae.AlphaOp.UNPREMULTIPLY)
+    assert_true(_close((0.8, 0.4, 0.2, 0.5), world.get_pixel(0, 0)), "unpremultiplied color")
+    assert_equal((0.0, 0.0, 0.0, 0.0), world.get_pixel(1, 0))
+
+
+@suite.test
+def test_writes_into_caller_buffer():
+    """Test that read_pixels fills and returns the caller's buffer"""
+    world = _gradient_world()
+    out = array.array("H", bytes(WIDTH * HEIGHT * 4 * 2))
+    result = world.read_pixels(out, depth=ae.WorldType.BIT16)
+    assert_true(result is out, "read_pixels should return the given buffer")
+    assert_equal(32768, max(out[3::4]))
+
+    assert_raises(RuntimeError, world.read_pixels, bytearray(16))
+    assert_raises(BufferError, world.read_pixels, bytes(WIDTH * HEIGHT * 16))
+
+
+@suite.test
+def test_write_pixels_checks_size_and_format():
+    """Test that write_pixels rejects mismatched sizes and formats"""
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    assert_raises(RuntimeError, world.write_pixels, bytes(16))
+    assert_raises(RuntimeError, world.write_pixels, array.array("d", [0.0] * (WIDTH * HEIGHT * 4)))
+
+
+@suite.test
+def test_simd_matches_scalar():
+    """Test that every instruction set produces identical results"""
+    world = _gradient_world(ae.WorldType.BIT16)
+    cases = [(layout, depth, alpha)
+             for layout in (ae.PixelLayout.RGBA, ae.PixelLayout.BGRA, ae.PixelLayout.PLANAR)
+             for depth in (ae.WorldType.BIT8, ae.WorldType.BIT16, ae.WorldType.BIT32)
+             for alpha in (ae.AlphaOp.NONE, ae.AlphaOp.PREMULTIPLY, ae.AlphaOp.UNPREMULTIPLY)]
+
+    results = {}
+    for level in ("scalar", "sse4.1", "avx2"):
+        ae.World.set_simd_level(level)
+        results[level] = [bytes(world.read_pixels(layout=layout, depth=depth, alpha=alpha))
+                          for layout, depth, alpha in cases]
+    ae.World.set_simd_level("avx2")
+
+    assert_equal(results["scalar"], results["sse4.1"])
+    assert_equal(results["scalar"], results["avx2"])
+
+
+@suite.test
+def test_numpy_round_trip():
+    """Test that NumPy arrays work as output and input buffers"""
+    np = _numpy()
+    world = _gradient_world()
+    out = np.empty((HEIGHT, WIDTH, 4), dtype=np.float32)
+    world.read_pixels(out)
+    assert_true(_close(world.get_pixel(5, 2), out[2, 5]), "read into NumPy array")
+
+    out[..., 3] = 1.0
+    world.write_pixels(out)
+    assert_equal(1.0, world.get_pixel(5, 2)[3])
+
+    assert_raises(RuntimeError, world.write_pixels, out[:, ::2])
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
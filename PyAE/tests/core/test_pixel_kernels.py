@@ -0,0 +1,172 @@
+"""
+Pixel Kernels Tests
+Tests for ae.World.apply_kernel and the ae.PixelKernels registry
+"""
+import ae
+
+try:
+    from test_utils import TestSuite, assert_equal, assert_true, assert_raises
+except ImportError:
+    from .test_utils import TestSuite, assert_equal, assert_true, assert_raises
+
+suite = TestSuite("Pixel Kernels")
+
+WIDTH = 200
+HEIGHT = 150
+
+
+def _close(a, b, tolerance=1e-4):
+    return abs(a - b) <= tolerance
+
+
+def _assert_color(expected, actual, tolerance=1e-4):
+    for e, a in zip(expected, actual):
+        assert_true(_close(e, a, tolerance), f"expected {expected}, got {actual}")
+
+
+def _solid(color, world_type=ae.WorldType.BIT32):
+    world = ae.World.create(world_type, WIDTH, HEIGHT)
+    world.fill(color)
+    return world
+
+
+@suite.test
+def test_registry():
+    """Test that the built-in kernels are registered with descriptions"""
+    names = ae.PixelKernels.names()
+    for name in ("blend", "channel_shuffle", "gain_gamma", "lut", "threshold"):
+        assert_true(name in names, f"{name} not registered")
+    assert_equal(sorted(names), names)
+
+    info = ae.PixelKernels.info("blend")
+    assert_equal("blend", info["name"])
+    assert_equal(2, info["inputs"])
+    assert_true("opacity" in info["description"])
+    assert_equal(1, ae.PixelKernels.info("lut")["inputs"])
+    assert_raises(ValueError, ae.PixelKernels.info, "no_such_kernel")
+
+
+@suite.test
+def test_gain_gamma():
+    """Test gain, offset and gamma at every bit depth"""
+    for world_type in (ae.WorldType.BIT8, ae.WorldType.BIT16, ae.WorldType.BIT32):
+        world = _solid((0.25, 0.5, 0.1, 1.0), world_type)
+        result = world.apply_kernel("gain_gamma", gain=2.0)
+        assert_true(result["tiles"] >= 1)
+        assert_true(result["threads"] >= 1)
+        _assert_color((0.5, 1.0, 0.2, 1.0), world.get_pixel(WIDTH - 1, HEIGHT - 1), 1.0 / 255)
+
+    world = _solid((0.25, 0.25, 0.25, 1.0))
+    world.apply_kernel("gain_gamma", gamma=2.0)
+    _assert_color((0.5, 0.5, 0.5, 1.0), world.get_pixel(0, 0))
+
+    world = _solid((0.5, 0.5, 0.5, 1.0))
+    world.apply_kernel("gain_gamma", gain=(1.0, 0.0, 1.0, 0.5), offset=(0.0, 0.25, 0.0, 0.0))
+    _assert_color((0.5, 0.25, 0.5, 0.25), world.get_pixel(10, 10))
+
+
+@suite.test
+def test_threshold():
+    """Test luma and per-channel threshold"""
+    world = _solid((0.2, 0.2, 0.2, 1.0))
+    world.fill_rect(0, 0, 50, 50, (0.9, 0.9, 0.9, 1.0))
+    world.apply_kernel("threshold", level=0.5)
+    _assert_color((1.0, 1.0, 1.0, 1.0), world.get_pixel(10, 10))
+    _assert_color((0.0, 0.0, 0.0, 1.0), world.get_pixel(100, 100))
+
+    world = _solid((0.0, 0.0, 1.0, 1.0))
+    world.apply_kernel("threshold", channel="b", level=0.5, low=0.1, high=0.7)
+    _assert_color((0.7, 0.7, 0.7, 1.0), world.get_pixel(0, 0))
+
+
+@suite.test
+def test_channel_shuffle():
+    """Test channel shuffle by string and by index"""
+    world = _solid((1.0, 0.5, 0.0, 0.25))
+    world.apply_kernel("channel_shuffle", order="bgr1")
+    _assert_color((0.0, 0.5, 1.0, 1.0), world.get_pixel(0, 0))
+
+    world.apply_kernel("channel_shuffle", order=(3, 3, 3, 4))
+    _assert_color((1.0, 1.0, 1.0, 0.0), world.get_pixel(5, 5))
+
+    assert_raises(ValueError, world.apply_kernel, "channel_shuffle", order="xyzw")
+    assert_raises(ValueError, world.apply_kernel, "channel_shuffle", order=(0, 1, 2))
+
+
+@suite.test
+def test_lut():
+    """Test a 1D LUT with interpolation and a per-channel alpha LUT"""
+    world = _solid((0.25, 0.5, 1.0, 0.5))
+    world.apply_kernel("lut", lut=[1.0, 0.0], lut_a=[0.0, 0.0, 1.0])
+    _assert_color((0.75, 0.5, 0.0, 0.0), world.get_pixel(0, 0))
+
+    world = _solid((0.5, 0.5, 0.5, 1.0))
+    world.apply_kernel("lut", lut=[0.0, 1.0], domain=(0.0, 2.0))
+    _assert_color((0.25, 0.25, 0.25, 1.0), world.get_pixel(0, 0))
+
+    assert_raises(ValueError, world.apply_kernel, "lut")
+    assert_raises(ValueError, world.apply_kernel, "lut", lut=[1.0])
+
+
+@suite.test
+def test_blend():
+    """Test normal, mix and screen blending with a second world"""
+    base = _solid((0.0, 0.0, 1.0, 1.0))
+    overlay = _solid((1.0, 0.0, 0.0, 1.0))
+    base.apply_kernel("blend", other=overlay, opacity=0.5)
+    _assert_color((0.5, 0.0, 0.5, 1.0), base.get_pixel(0, 0))
+
+    base = _solid((0.5, 0.5, 0.5, 1.0))
+    half = _solid((0.5, 0.5, 0.5, 0.5))
+    base.apply_kernel("blend", other=half, mode="screen")
+    _assert_color((0.75, 0.75, 0.75, 1.0), base.get_pixel(0, 0))
+
+    base = _solid((0.0, 0.0, 0.0, 0.0))
+    base.apply_kernel("blend", other=overlay, mode="mix", opacity=0.25)
+    _assert_color((0.25, 0.0, 0.0, 0.25), base.get_pixel(0, 0))
+
+    # 同じワールドを第2入力にしてもよい
+    base = _solid((0.25, 0.25, 0.25, 1.0))
+    base.apply_kernel("blend", other=base, mode="add")
+    _assert_color((0.5, 0.5, 0.5, 1.0), base.get_pixel(0, 0))
+
+
+@suite.test
+def test_region_and_tile_size():
+    """Test that a region limits the kernel and tile size splits the work"""
+    world = _solid((0.25, 0.25, 0.25, 1.0))
+    result = world.apply_kernel("gain_gamma", region=(10, 20, 30, 40), tile_size=8, gain=2.0)
+    assert_equal(4 * 5, result["tiles"])
+    _assert_color((0.5, 0.5, 0.5, 1.0), world.get_pixel(10, 20))
+    _assert_color((0.5, 0.5, 0.5, 1.0), world.get_pixel(39, 59))
+    _assert_color((0.25, 0.25, 0.25, 1.0), world.get_pixel(40, 59))
+    _assert_color((0.25, 0.25, 0.25, 1.0), world.get_pixel(10, 19))
+
+    assert_equal(4 * 3, world.apply_kernel("gain_gamma", tile_size=64)["tiles"])
+    assert_raises(ValueError, world.apply_kernel, "gain_gamma", tile_size=4)
+    assert_raises(RuntimeError, world.apply_kernel, "gain_gamma", region=(190, 0, 20, 10))
+
+
+@suite.test
+def test_invalid_arguments():
+    """Test unknown kernels, unknown parameters and input checks"""
+    world = _solid((0.0, 0.0, 0.0, 1.0))
+    other = ae.World.create(ae.WorldType.BIT32, 10, 10)
+    assert_raises(ValueError, world.apply_kernel, "no_such_kernel")
+    assert_raises(ValueError, world.apply_kernel, "gain_gamma", gian=2.0)
+    assert_raises(ValueError, world.apply_kernel, "gain_gamma", gamma=0.0)
+    assert_raises(ValueError, world.apply_kernel, "gain_gamma", gain="high")
+    assert_raises(ValueError, world.apply_kernel, "gain_gamma", gain=object())
+    assert_raises(ValueError, world.apply_kernel, "blend")
+    assert_raises(ValueError, world.apply_kernel, "gain_gamma", other=world)
+    assert_raises(RuntimeError, world.apply_kernel, "blend", other=other)
+    assert_raises(ValueError, world.apply_kernel, "blend", other=world, mode="overlay")
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,137 @@
+"""
+World Tests
+Tests for the high-level ae.World buffer protocol and NumPy views
+"""
+import ae
+
+try:
+    from test_utils import TestSuite, assert_equal, assert_true, assert_raises, skip
+except ImportError:
+    from .test_utils import TestSuite, assert_equal, assert_true, assert_raises, skip
+
+suite = TestSuite("World")
+
+WIDTH = 64
+HEIGHT = 32
+
+
+def _numpy():
+    try:
+        import numpy
+        return numpy
+    except ImportError:
+        skip("NumPy is not installed")
+
+
+@suite.test
+def test_memoryview_shape_and_format():
+    """Test that memoryview(world) describes (height, width, 4) with row_bytes stride"""
+    for world_type, fmt, itemsize in ((ae.WorldType.BIT8, "B", 1),
+                                      (ae.WorldType.BIT16, "H", 2),
+                                      (ae.WorldType.BIT32, "f", 4)):
+        world = ae.World.create(world_type, WIDTH, HEIGHT)
+        view = memoryview(world)
+        assert_equal((HEIGHT, WIDTH, 4), view.shape)
+        assert_equal(fmt, view.format)
+        assert_equal(itemsize, view.itemsize)
+        assert_equal((world.row_bytes, itemsize * 4, itemsize), view.strides)
+        assert_true(not view.readonly, "World view should be writable")
+
+
+@suite.test
+def test_memoryview_writes_are_visible():
+    """Test that writing through the view changes the world pixels"""
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    view = memoryview(world)
+    view[3, 5, 0] = 255  # alpha
+    view[3, 5, 1] = 255  # red
+    r, g, b, a = world.get_pixel(5, 3)
+    assert_equal(1.0, r)
+    assert_equal(1.0, a)
+
+
+@suite.test
+def test_set_pixels_accepts_buffers():
+    """Test that set_pixels takes bytearray / memoryview and checks the size"""
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    data = bytearray(world.row_bytes * HEIGHT)
+    data[0:4] = bytes([255, 0, 255, 0])
+    world.set_pixels(memoryview(data))
+    assert_equal((0.0, 1.0, 0.0, 1.0), world.get_pixel(0, 0))
+
+    assert_raises(RuntimeError, world.set_pixels, b"\x00" * 4)
+
+
+@suite.test
+def test_as_array_is_zero_copy():
+    """Test that as_array() returns a writable strided view of the world"""
+    np = _numpy()
+    for world_type, dtype in ((ae.WorldType.BIT8, np.uint8),
+                              (ae.WorldType.BIT16, np.uint16),
+                              (ae.WorldType.BIT32, np.float32)):
+        world = ae.World.create(world_type, WIDTH, HEIGHT)
+        pixels = world.as_array()
+        assert_equal((HEIGHT, WIDTH, 4), pixels.shape)
+        assert_equal(np.dtype(dtype), pixels.dtype)
+        assert_equal(world.row_bytes, pixels.strides[0])
+
+    world = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    pixels = world.as_array()
+    pixels[..., 0] = 1.0
+    pixels[10, 20, 3] = 0.5
+    r, g, b, a = world.get_pixel(20, 10)
+    assert_equal(1.0, a)
+    assert_equal(0.5, b)
+
+
+@suite.test
+def test_as_array_keeps_world_alive():
+    """Test that the array keeps its world alive after the last reference is dropped"""
+    np = _numpy()
+    pixels = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT).as_array()
+    pixels[:] = 7
+    assert_equal(7, int(np.max(pixels)))
+
+
+@suite.test
+def test_receipt_world_invalidated_on_checkin():
+    """Test that a receipt world is exported read-only and invalidated by checkin"""
+    proj = ae.Project.get_current()
+    comp = proj.create_comp("_WorldReceiptTestComp", WIDTH, HEIGHT, 1.0, 1.0, 30.0)
+    try:
+        receipt = ae.Renderer.render_frame(ae.RenderOptions.from_item(comp._handle))
+        world = receipt.world
+        assert_true(memoryview(world).readonly, "Receipt world view should be read-only")
+        receipt.checkin()
+        assert_true(not world.valid, "Receipt world should be invalid after checkin")
+        assert_raises(RuntimeError, world.get_pixel, 0, 0)
+        assert_equal(0, memoryview(world).nbytes)
+    finally:
+        ae.sdk.AEGP_DeleteItem(comp._handle)
+
+
+@suite.test
+def test_cached_metadata():
+    """Test that metadata is stable and refresh() keeps it consistent"""
+    for world_type, bpp in ((ae.WorldType.BIT8, 4),
+                            (ae.WorldType.BIT16, 8),
+                            (ae.WorldType.BIT32, 16)):
+        world = ae.World.create(world_type, WIDTH, HEIGHT)
+        before = (world.type, world.size, world.row_bytes, world.bytes_per_pixel)
+        assert_equal((world_type, (WIDTH, HEIGHT)), before[:2])
+        assert_equal(bpp, world.bytes_per_pixel)
+        assert_true(world.row_bytes >= WIDTH * bpp, "row_bytes covers a row")
+
+        world.set_pixel(1, 1, 1.0, 0.0, 0.0, 1.0)
+        world.refresh()
+        assert_equal(before, (world.type, world.size, world.row_bytes, world.bytes_per_pixel))
+        assert_equal((1.0, 0.0, 0.0, 1.0), world.get_pixel(1, 1))
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
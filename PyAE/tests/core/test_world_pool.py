@@ -0,0 +1,149 @@
+"""
+World Pool Tests
+Tests for ae.WorldPool recycling of worlds created by ae.World.create
+"""
+import ae
+
+try:
+    from test_utils import TestSuite, assert_equal, assert_true
+except ImportError:
+    from .test_utils import TestSuite, assert_equal, assert_true
+
+suite = TestSuite("World Pool")
+
+WIDTH = 120
+HEIGHT = 80
+
+_saved = {}
+
+
+@suite.setup
+def setup():
+    """Start from an empty, enabled pool"""
+    _saved["max_bytes"] = ae.WorldPool.max_bytes()
+    _saved["enabled"] = ae.WorldPool.enabled()
+    ae.WorldPool.set_enabled(True)
+    ae.WorldPool.set_max_bytes(64 * 1024 * 1024)
+    ae.WorldPool.trim()
+    ae.WorldPool.reset_stats()
+
+
+@suite.teardown
+def teardown():
+    """Restore pool settings"""
+    ae.WorldPool.set_max_bytes(_saved["max_bytes"])
+    ae.WorldPool.set_enabled(_saved["enabled"])
+
+
+@suite.test
+def test_stats_keys():
+    """Test that stats() reports every counter"""
+    stats = ae.WorldPool.stats()
+    for key in ("hits", "misses", "returned", "evicted", "pooled_worlds", "pooled_bytes",
+                "live_worlds", "live_bytes", "peak_bytes", "max_bytes", "enabled"):
+        assert_true(key in stats, f"stats should have '{key}'")
+
+
+@suite.test
+def test_same_shape_is_recycled():
+    """Test that a disposed world is reused for the same type and size"""
+    ae.WorldPool.trim()
+    ae.WorldPool.reset_stats()
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    handle = world._handle
+    del world
+    assert_equal(1, ae.WorldPool.stats()["pooled_worlds"])
+
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    assert_equal(handle, world._handle)
+    stats = ae.WorldPool.stats()
+    assert_equal(1, stats["hits"])
+    assert_equal(1, stats["misses"])
+    assert_equal(0, stats["pooled_worlds"])
+
+
+@suite.test
+def test_other_shapes_are_not_recycled():
+    """Test that type and size are part of the pool key"""
+    ae.WorldPool.trim()
+    ae.WorldPool.reset_stats()
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    del world
+    a = ae.World.create(ae.WorldType.BIT16, WIDTH, HEIGHT)
+    b = ae.World.create(ae.WorldType.BIT8, WIDTH + 1, HEIGHT)
+    assert_equal(0, ae.WorldPool.stats()["hits"])
+    assert_equal(1, ae.WorldPool.stats()["pooled_worlds"])
+    del a, b
+
+
+@suite.test
+def test_recycled_world_is_cleared():
+    """Test that recycled worlds come back zeroed unless clear=False"""
+    ae.WorldPool.trim()
+    world = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    world.fill((1.0, 1.0, 1.0, 1.0))
+    del world
+    world = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    assert_equal((0.0, 0.0, 0.0, 0.0), world.get_pixel(WIDTH - 1, HEIGHT - 1))
+
+
+@suite.test
+def test_limit_evicts_least_recently_used():
+    """Test that max_bytes bounds the pooled total with LRU eviction"""
+    ae.WorldPool.trim()
+    ae.WorldPool.reset_stats()
+    first = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    second = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    third = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    world_bytes = first.row_bytes * HEIGHT
+    ae.WorldPool.set_max_bytes(world_bytes * 2)
+    oldest = first._handle
+    del first
+    del second
+    del third
+
+    stats = ae.WorldPool.stats()
+    assert_equal(2, stats["pooled_worlds"])
+    assert_equal(1, stats["evicted"])
+    assert_true(stats["pooled_bytes"] <= world_bytes * 2)
+
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    assert_true(world._handle != oldest, "the first returned world should be evicted")
+    del world
+    ae.WorldPool.set_max_bytes(64 * 1024 * 1024)
+
+
+@suite.test
+def test_disabled_pool_disposes():
+    """Test that a disabled pool keeps nothing"""
+    ae.WorldPool.set_enabled(False)
+    try:
+        world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+        del world
+        assert_equal(0, ae.WorldPool.stats()["pooled_worlds"])
+    finally:
+        ae.WorldPool.set_enabled(True)
+
+
+@suite.test
+def test_peak_bytes_tracks_live_worlds():
+    """Test that peak_bytes covers simultaneously live worlds"""
+    ae.WorldPool.trim()
+    ae.WorldPool.reset_stats()
+    before = ae.WorldPool.stats()
+    worlds = [ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT) for _ in range(4)]
+    total = sum(w.row_bytes * HEIGHT for w in worlds)
+    assert_equal(before["live_worlds"] + 4, ae.WorldPool.stats()["live_worlds"])
+    del worlds
+    stats = ae.WorldPool.stats()
+    assert_equal(before["live_bytes"] + total, stats["peak_bytes"])
+    assert_equal(before["live_bytes"], stats["live_bytes"])
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,166 @@
+"""
+World Region Tests
+Tests for ae.World region read/write, fill, copy and drawing primitives
+"""
+import ae
+
+try:
+    from test_utils import TestSuite, assert_equal, assert_true, assert_raises, skip
+except ImportError:
+    from .test_utils import TestSuite, assert_equal, assert_true, assert_raises, skip
+
+suite = TestSuite("World Region")
+
+WIDTH = 64
+HEIGHT = 48
+
+RED = (1.0, 0.0, 0.0, 1.0)
+BLUE = (0.0, 0.0, 1.0, 1.0)
+CLEAR = (0.0, 0.0, 0.0, 0.0)
+
+
+def _count(world, color):
+    """Number of pixels equal to color (8-bit comparison)"""
+    target = bytes(round(c * 255) for c in color)
+    data = bytes(world.read_pixels(depth=ae.WorldType.BIT8))
+    return sum(1 for i in range(0, len(data), 4) if data[i:i + 4] == target)
+
+
+@suite.test
+def test_fill_and_fill_rect():
+    """Test that fill covers the world and fill_rect is clipped"""
+    world = ae.World.create(ae.WorldType.BIT16, WIDTH, HEIGHT)
+    world.fill(BLUE)
+    assert_equal(WIDTH * HEIGHT, _count(world, BLUE))
+
+    world.fill_rect(-5, -5, 10, 10, RED)
+    assert_equal(25, _count(world, RED))
+    assert_equal(RED, world.get_pixel(4, 4))
+    assert_equal(BLUE, world.get_pixel(5, 5))
+
+    world.fill_rect(WIDTH + 1, 0, 10, 10, RED)  # 完全に範囲外
+    assert_equal(25, _count(world, RED))
+
+
+@suite.test
+def test_read_write_region():
+    """Test that a region round-trips and leaves the rest untouched"""
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    world.fill_rect(10, 20, 4, 3, RED)
+    region = world.read_region(10, 20, 4, 3)
+    assert_equal((3, 4, 4), region.shape)
+    assert_equal((1.0, 0.0, 0.0, 1.0), tuple(region[2, 3, i] for i in range(4)))
+
+    world.write_region(0, 0, 4, 3, region)
+    assert_equal(RED, world.get_pixel(3, 2))
+    assert_equal(CLEAR, world.get_pixel(4, 0))
+    assert_equal(24, _count(world, RED))
+
+    assert_raises(RuntimeError, world.read_region, WIDTH - 2, 0, 4, 4)
+    assert_raises(RuntimeError, world.write_region, 0, 0, 2, 2, region)
+
+
+@suite.test
+def test_write_region_from_overlapping_view():
+    """Test that write_region from a view of the same world is staged"""
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    if world.row_bytes != WIDTH * 4:
+        skip("World rows are padded; the view is not contiguous")
+    world.fill_rect(0, 0, WIDTH, 1, RED)
+    world.fill_rect(0, 1, WIDTH, 1, BLUE)
+    # 行 0-2 を 1 行下へ（変換元と変換先が重なる）
+    world.write_region(0, 1, WIDTH, 3, memoryview(world)[0:3], ae.PixelLayout.ARGB)
+    assert_equal(RED, world.get_pixel(5, 1))
+    assert_equal(BLUE, world.get_pixel(5, 2))
+    assert_equal(CLEAR, world.get_pixel(5, 3))
+
+
+@suite.test
+def test_copy_region_between_depths():
+    """Test that copy_region normalizes values between bit depths"""
+    src = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    src.fill_rect(0, 0, 8, 8, (0.5, 0.25, 1.0, 1.0))
+    dst = ae.World.create(ae.WorldType.BIT16, WIDTH, HEIGHT)
+    dst.copy_region(src, 0, 0, 8, 8, 30, 30)
+    assert_equal((0.5, 0.25, 1.0, 1.0), dst.get_pixel(37, 37))
+    assert_equal(CLEAR, dst.get_pixel(38, 38))
+
+    assert_raises(RuntimeError, dst.copy_region, src, 0, 0, 8, 8, WIDTH - 4, 0)
+
+
+@suite.test
+def test_copy_region_overlapping():
+    """Test that copying within one world handles overlap"""
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    world.fill_rect(0, 0, 4, 1, RED)
+    world.fill_rect(4, 0, 4, 1, BLUE)
+    world.copy_region(world, 0, 0, 8, 1, 2, 0)
+    assert_equal(RED, world.get_pixel(2, 0))
+    assert_equal(RED, world.get_pixel(5, 0))
+    assert_equal(BLUE, world.get_pixel(6, 0))
+    assert_equal(BLUE, world.get_pixel(9, 0))
+
+
+@suite.test
+def test_draw_primitives():
+    """Test line, rectangle outline and circle pixel counts"""
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    world.draw_line(0, 0, 9, 9, RED)
+    assert_equal(10, _count(world, RED))
+    world.draw_line(0, 40, 20, 40, BLUE, thickness=3)
+    assert_equal(22 * 3, _count(world, BLUE))  # 端点の正方形が x = 21 まで届く
+
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    world.draw_rect(10, 10, 10, 6, RED, thickness=2)
+    assert_equal(10 * 6 - 6 * 2, _count(world, RED))
+    assert_equal(CLEAR, world.get_pixel(14, 13))
+
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    world.fill_circle(32.0, 24.0, 10.0, BLUE)
+    count = _count(world, BLUE)
+    assert_true(abs(count - 314) < 20, f"circle area {count}")
+    assert_equal(BLUE, world.get_pixel(32, 24))
+    assert_equal(CLEAR, world.get_pixel(32, 35))
+
+    assert_raises(RuntimeError, world.draw_line, 0, 0, 1, 1, RED, 0)
+
+
+@suite.test
+def test_extreme_coordinates_are_clipped():
+    """Test that coordinates near the int range are clipped without overflow"""
+    big = 2 ** 31 - 1
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    world.fill_rect(10, 10, big, big, RED)
+    assert_equal((WIDTH - 10) * (HEIGHT - 10), _count(world, RED))
+
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    world.draw_line(-big - 1, 5, big, 5, RED)  # 画像内の 1 行分だけ描く
+    assert_equal(WIDTH, _count(world, RED))
+    world.draw_line(-big - 1, -big - 1, big, big, BLUE)
+    assert_equal(HEIGHT, _count(world, BLUE))
+    world.draw_line(-big - 1, -5, big, -5, BLUE)  # 完全に範囲外
+    assert_equal(HEIGHT, _count(world, BLUE))
+
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    world.draw_rect(WIDTH - 4, 0, big, big, RED, thickness=2)
+    assert_equal(4 * 2 + 2 * (HEIGHT - 2), _count(world, RED))
+    world.fill_circle(1e12, 1e12, 1e13, BLUE)
+    assert_equal(WIDTH * HEIGHT, _count(world, BLUE))
+
+
+@suite.test
+def test_large_fill_is_uniform():
+    """Test that a multithreaded fill writes every row"""
+    world = ae.World.create(ae.WorldType.BIT32, 1024, 768)
+    world.fill((0.25, 0.5, 0.75, 1.0))
+    for y in (0, 383, 767):
+        assert_equal((0.25, 0.5, 0.75, 1.0), world.get_pixel(1023, y))
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
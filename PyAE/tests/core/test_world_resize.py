@@ -0,0 +1,169 @@
+"""
+World Resize Tests
+Tests for ae.World.resize / resize_into / read_resized (box, bilinear and area filters)
+"""
+from array import array
+
+import ae
+
+try:
+    from test_utils import TestSuite, assert_equal, assert_true, assert_raises
+except ImportError:
+    from .test_utils import TestSuite, assert_equal, assert_true, assert_raises
+
+suite = TestSuite("World Resize")
+
+WIDTH = 64
+HEIGHT = 48
+
+FILTERS = (ae.ResizeFilter.BOX, ae.ResizeFilter.BILINEAR, ae.ResizeFilter.AREA)
+
+
+def _close(a, b, tolerance=1e-4):
+    return abs(a - b) <= tolerance
+
+
+def _checkerboard(world_type):
+    """1 pixel black / white checkerboard with opaque alpha"""
+    world = ae.World.create(world_type, WIDTH, HEIGHT)
+    world.fill((0.0, 0.0, 0.0, 1.0))
+    for y in range(HEIGHT):
+        for x in range(y % 2, WIDTH, 2):
+            world.set_pixel(x, y, 1.0, 1.0, 1.0, 1.0)
+    return world
+
+
+@suite.test
+def test_uniform_color_all_filters_and_depths():
+    """Test that a uniform world keeps its color for every filter and depth"""
+    for world_type in (ae.WorldType.BIT8, ae.WorldType.BIT16, ae.WorldType.BIT32):
+        world = ae.World.create(world_type, WIDTH, HEIGHT)
+        world.fill((1.0, 0.5, 0.0, 1.0))
+        for resize_filter in FILTERS:
+            for width, height in ((16, 12), (37, 29), (100, 80)):
+                small = world.resize(width, height, resize_filter)
+                assert_equal((width, height), small.size)
+                assert_equal(world_type, small.type)
+                mean = small.statistics(histogram=False)["mean"]
+                for expected, actual in zip((1.0, 0.5, 0.0, 1.0), mean):
+                    assert_true(_close(expected, actual, 1.0 / 255),
+                                f"{resize_filter} {width}x{height}: {mean}")
+
+
+@suite.test
+def test_box_and_area_average_exact_factor():
+    """Test that 2x reduction of a checkerboard averages to gray"""
+    world = _checkerboard(ae.WorldType.BIT32)
+    for resize_filter in (ae.ResizeFilter.BOX, ae.ResizeFilter.AREA):
+        half = world.resize(WIDTH // 2, HEIGHT // 2, resize_filter)
+        stats = half.statistics(histogram=False)
+        assert_true(_close(0.5, stats["min"][0]))
+        assert_true(_close(0.5, stats["max"][0]))
+        assert_true(_close(1.0, stats["mean"][3]))
+
+
+@suite.test
+def test_area_preserves_mean():
+    """Test that area reduction by a non-integer factor keeps the image mean"""
+    world = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    world.fill((0.0, 0.0, 0.0, 1.0))
+    world.fill_rect(0, 0, WIDTH // 2, HEIGHT, (1.0, 1.0, 1.0, 1.0))
+    small = world.resize(24, 18, ae.ResizeFilter.AREA)
+    assert_true(_close(0.5, small.statistics(histogram=False)["mean"][0]))
+
+
+@suite.test
+def test_enlarge():
+    """Test enlarging: box is nearest neighbour, bilinear interpolates"""
+    world = ae.World.create(ae.WorldType.BIT32, 2, 1)
+    world.set_pixel(0, 0, 0.0, 0.0, 0.0, 1.0)
+    world.set_pixel(1, 0, 1.0, 1.0, 1.0, 1.0)
+
+    nearest = world.resize(4, 1, ae.ResizeFilter.BOX)
+    assert_equal([0.0, 0.0, 1.0, 1.0], [nearest.get_pixel(x, 0)[0] for x in range(4)])
+
+    linear = world.resize(4, 1, ae.ResizeFilter.BILINEAR)
+    values = [linear.get_pixel(x, 0)[0] for x in range(4)]
+    assert_true(_close(0.0, values[0]))
+    assert_true(_close(0.25, values[1]))
+    assert_true(_close(0.75, values[2]))
+    assert_true(_close(1.0, values[3]))
+
+
+@suite.test
+def test_same_size_is_a_copy():
+    """Test that resizing to the same size copies the pixels"""
+    world = _checkerboard(ae.WorldType.BIT8)
+    for resize_filter in FILTERS:
+        copy = world.resize(WIDTH, HEIGHT, resize_filter)
+        assert_true(copy.compare(world)["identical"])
+
+
+@suite.test
+def test_resize_changes_type():
+    """Test resizing into another bit depth"""
+    world = ae.World.create(ae.WorldType.BIT16, WIDTH, HEIGHT)
+    world.fill((0.0, 1.0, 0.0, 1.0))
+    small = world.resize(8, 6, type=ae.WorldType.BIT8)
+    assert_equal(ae.WorldType.BIT8, small.type)
+    assert_equal((0.0, 1.0, 0.0, 1.0), small.get_pixel(3, 3))
+
+
+@suite.test
+def test_resize_into():
+    """Test resizing into an existing world of another depth"""
+    world = _checkerboard(ae.WorldType.BIT8)
+    thumb = ae.World.create(ae.WorldType.BIT32, WIDTH // 4, HEIGHT // 4, clear=False)
+    world.resize_into(thumb, ae.ResizeFilter.AREA)
+    stats = thumb.statistics(histogram=False)
+    assert_true(_close(0.5, stats["mean"][1], 1.0 / 255))
+    assert_raises(ValueError, world.resize_into, world)
+
+
+@suite.test
+def test_read_resized_ui_buffer():
+    """Test reading an 8-bit RGBA thumbnail into a new or caller buffer"""
+    world = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    world.fill((1.0, 0.0, 0.0, 1.0))
+
+    view = world.read_resized(16, 12)
+    assert_equal((12, 16, 4), view.shape)
+    assert_equal("B", view.format)
+    assert_equal([255, 0, 0, 255], list(view[0, 0]))
+
+    out = array("f", bytes(16 * 12 * 4 * 4))
+    result = world.read_resized(16, 12, out=out, depth=ae.WorldType.BIT32,
+                                layout=ae.PixelLayout.BGRA)
+    assert_true(result is out)
+    assert_equal([0.0, 0.0, 1.0, 1.0], list(out[:4]))
+
+    assert_raises(RuntimeError, world.read_resized, 16, 12, bytearray(10))
+
+
+@suite.test
+def test_read_resized_alpha():
+    """Test that the alpha op is applied after resizing"""
+    world = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    world.fill((0.25, 0.25, 0.25, 0.5))
+    out = array("f", bytes(4 * 4 * 4 * 4))
+    world.read_resized(4, 4, out=out, depth=ae.WorldType.BIT32,
+                       alpha=ae.AlphaOp.UNPREMULTIPLY)
+    assert_true(_close(0.5, out[0]))
+    assert_true(_close(0.5, out[3]))
+
+
+@suite.test
+def test_invalid_size():
+    """Test that non-positive sizes are rejected"""
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    assert_raises(Exception, world.resize, 0, 10)
+    assert_raises(RuntimeError, world.read_resized, 10, 0)
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,114 @@
+"""
+World Stats Tests
+Tests for ae.World.statistics (histograms, moments, NaN / out-of-range counts)
+"""
+import math
+from array import array
+
+import ae
+
+try:
+    from test_utils import TestSuite, assert_equal, assert_true, assert_raises
+except ImportError:
+    from .test_utils import TestSuite, assert_equal, assert_true, assert_raises
+
+suite = TestSuite("World Stats")
+
+WIDTH = 64
+HEIGHT = 48
+PIXELS = WIDTH * HEIGHT
+
+
+def _close(a, b, tolerance=1e-4):
+    return abs(a - b) <= tolerance
+
+
+@suite.test
+def test_uniform_fill():
+    """Test statistics of a world filled with one color at each depth"""
+    for world_type in (ae.WorldType.BIT8, ae.WorldType.BIT16, ae.WorldType.BIT32):
+        world = ae.World.create(world_type, WIDTH, HEIGHT)
+        world.fill((1.0, 0.0, 0.0, 1.0))
+        stats = world.statistics(bins=4)
+
+        assert_equal(PIXELS, stats["pixels"])
+        assert_equal(4, stats["bins"])
+        assert_equal((1.0, 0.0, 0.0, 1.0), stats["mean"])
+        assert_equal((1.0, 0.0, 0.0, 1.0), stats["max"])
+        assert_equal((0.0, 0.0, 0.0, 0.0), stats["std"])
+        assert_equal((0, 0, 0, 0), stats["nan"])
+        # 1.0 は最後のビン、0.0 は最初のビン
+        assert_equal([0, 0, 0, PIXELS], stats["histogram"][0])
+        assert_equal([PIXELS, 0, 0, 0], stats["histogram"][1])
+
+
+@suite.test
+def test_moments_and_region():
+    """Test mean / std of a half-filled world and a region inside it"""
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    world.fill_rect(0, 0, WIDTH // 2, HEIGHT, (1.0, 1.0, 1.0, 1.0))
+
+    stats = world.statistics(histogram=False)
+    assert_true(_close(0.5, stats["mean"][0]))
+    assert_true(_close(0.5, stats["std"][0]))
+    assert_equal(None, stats["histogram"])
+
+    region = world.statistics(region=(WIDTH // 2, 0, 8, 8))
+    assert_equal(64, region["pixels"])
+    assert_equal(0.0, region["max"][0])
+
+    assert_raises(RuntimeError, world.statistics, region=(WIDTH - 4, 0, 8, 8))
+
+
+@suite.test
+def test_nan_and_out_of_range():
+    """Test that float NaN is excluded from moments and out-of-range values are counted"""
+    world = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    values = array("f", [0.5] * (PIXELS * 4))
+    values[0] = float("nan")        # 先頭画素の R
+    values[4] = 2.0                 # 2番目の画素の R
+    values[8] = -1.0                # 3番目の画素の R
+    world.write_pixels(values)
+
+    stats = world.statistics(bins=2)
+    assert_equal(1, stats["nan"][0])
+    assert_equal(1, stats["above"][0])
+    assert_equal(1, stats["below"][0])
+    assert_equal(0, stats["nan"][1])
+    assert_equal(2.0, stats["max"][0])
+    assert_equal(-1.0, stats["min"][0])
+    assert_equal(PIXELS - 3, sum(stats["histogram"][0]))
+    expected_mean = (0.5 * (PIXELS - 3) + 2.0 - 1.0) / (PIXELS - 1)
+    assert_true(_close(expected_mean, stats["mean"][0]))
+
+    wide = world.statistics(bins=3, range=(-1.0, 2.0))
+    assert_equal((0, 0), (wide["below"][0], wide["above"][0]))
+    assert_equal([1, PIXELS - 3, 1], wide["histogram"][0])
+
+
+@suite.test
+def test_all_nan_channel():
+    """Test that a channel with no finite samples reports NaN moments"""
+    world = ae.World.create(ae.WorldType.BIT32, 4, 4)
+    world.write_pixels(array("f", [float("nan"), 0.0, 0.0, 1.0] * 16))
+    stats = world.statistics()
+    assert_equal(16, stats["nan"][0])
+    assert_true(math.isnan(stats["mean"][0]))
+    assert_equal(0.0, stats["mean"][1])
+
+
+@suite.test
+def test_invalid_arguments():
+    """Test that invalid bins / range raise ValueError"""
+    world = ae.World.create(ae.WorldType.BIT8, 8, 8)
+    assert_raises(ValueError, world.statistics, bins=0)
+    assert_raises(ValueError, world.statistics, range=(1.0, 1.0))
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,173 @@
+# test_hot_reload.py
+# Tests for ae.hot_reload high-level API
+#
+# Creates a throwaway package inside the first script directory, imports it,
+# edits the sources and checks that only affected modules are reloaded,
+# dependencies first.
+
+import os
+import shutil
+import sys
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite, assert_true, assert_false, assert_equal,
+        assert_not_none, assert_isinstance, assert_in, skip,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite, assert_true, assert_false, assert_equal,
+        assert_not_none, assert_isinstance, assert_in, skip,
+    )
+
+suite = TestSuite("HotReload API")
+
+_PKG = "_pyae_hot_reload_test"
+_pkg_dir = None
+
+
+def _write(name, source):
+    path = os.path.join(_pkg_dir, name)
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(source)
+    return path
+
+
+def _purge_modules():
+    for name in list(sys.modules):
+        if name == _PKG or name.startswith(_PKG + "."):
+            del sys.modules[name]
+
+
+@suite.setup
+def setup():
+    """Create a small package: base <- middle <- top, plus unrelated"""
+    global _pkg_dir
+    dirs = ae.hot_reload.watch_directories()
+    if not dirs:
+        return
+    _pkg_dir = os.path.join(dirs[0], _PKG)
+    os.makedirs(_pkg_dir, exist_ok=True)
+    _write("__init__.py", "")
+    # 内容の長さを毎回変える（同一秒内の書き換えで古い .pyc が使われないように）
+    _write("base.py", "VALUE = 1\n")
+    _write("middle.py", "from .base import VALUE\n\ndef get():\n    return VALUE\n")
+    _write("top.py", "from . import middle\n\ndef get():\n    return middle.get()\n")
+    _write("unrelated.py", "NAME = 'unrelated'\n")
+    if dirs[0] not in sys.path:
+        sys.path.insert(0, dirs[0])
+    _purge_modules()
+    __import__(_PKG + ".top")
+    __import__(_PKG + ".unrelated")
+
+
+@suite.teardown
+def teardown():
+    """Remove the test package"""
+    ae.hot_reload.set_on_reload(None)
+    _purge_modules()
+    if _pkg_dir and os.path.isdir(_pkg_dir):
+        shutil.rmtree(_pkg_dir, ignore_errors=True)
+
+
+def _require_package():
+    if _pkg_dir is None:
+        skip("No script directory available")
+
+
+# -----------------------------------------------------------------------
+# Module Availability Tests
+# -----------------------------------------------------------------------
+
+@suite.test
+def test_module_exists():
+    """Test that hot_reload module exists"""
+    assert_true(hasattr(ae, "hot_reload"), "ae should have 'hot_reload' module")
+    assert_not_none(ae.hot_reload.__doc__)
+
+
+@suite.test
+def test_enable_disable():
+    """Test starting and stopping the watcher"""
+    if not ae.hot_reload.watch_directories():
+        skip("No script directory available")
+    was_enabled = ae.hot_reload.is_enabled()
+    assert_true(ae.hot_reload.enable(poll_interval_ms=200))
+    assert_true(ae.hot_reload.is_enabled())
+    ae.hot_reload.disable()
+    assert_false(ae.hot_reload.is_enabled())
+    if was_enabled:
+        ae.hot_reload.enable()
+
+
+# -----------------------------------------------------------------------
+# Dependency Graph Tests
+# -----------------------------------------------------------------------
+
+@suite.test
+def test_dependency_graph():
+    """Test that imports between user modules are tracked"""
+    _require_package()
+    graph = ae.hot_reload.dependency_graph()
+    assert_isinstance(graph, dict)
+    assert_in(_PKG + ".base", graph[_PKG + ".middle"])
+    assert_in(_PKG + ".middle", graph[_PKG + ".top"])
+    assert_equal([], graph[_PKG + ".unrelated"])
+
+
+# -----------------------------------------------------------------------
+# Reload Tests
+# -----------------------------------------------------------------------
+
+@suite.test
+def test_reload_order():
+    """Test that dependents are reloaded after their dependencies"""
+    _require_package()
+    path = _write("base.py", "VALUE = 22\n")
+    result = ae.hot_reload.reload_files([path])
+
+    reloaded = result["reloaded"]
+    assert_equal({}, result["failed"])
+    assert_true(reloaded.index(_PKG + ".base") < reloaded.index(_PKG + ".middle"))
+    assert_true(reloaded.index(_PKG + ".middle") < reloaded.index(_PKG + ".top"))
+    assert_false(_PKG + ".unrelated" in reloaded,
+                 "Unaffected modules should not be reloaded")
+    assert_equal(22, sys.modules[_PKG + ".top"].get())
+
+
+@suite.test
+def test_reload_failure_skips_dependents():
+    """Test that a broken module does not cascade into its dependents"""
+    _require_package()
+    path = _write("base.py", "VALUE = (\n")
+    try:
+        result = ae.hot_reload.reload([_PKG + ".base"])
+        assert_in(_PKG + ".base", result["failed"])
+        assert_in(_PKG + ".middle", result["skipped"])
+        assert_in(_PKG + ".top", result["skipped"])
+    finally:
+        _write("base.py", "VALUE = 333\n")
+        ae.hot_reload.reload_files([path])
+
+    assert_equal(333, sys.modules[_PKG + ".top"].get())
+
+
+@suite.test
+def test_reload_count_increases():
+    """Test that reload_count tracks reloaded modules"""
+    _require_package()
+    before = ae.hot_reload.reload_count()
+    result = ae.hot_reload.reload([_PKG + ".unrelated"])
+    assert_in(_PKG + ".unrelated", result["reloaded"])
+    assert_equal(before + len(result["reloaded"]), ae.hot_reload.reload_count())
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
@@ -6,6 +6,11 @@
 # Note: Full functionality requires an active render session with
 # valid session_id. Using session_id=0 for basic testing.
 
+import json
+import os
+import tempfile
+from array import array
+
 import ae
 
 try:
@@ -163,6 +168,48 @@ def test_clear_callback():
     # If no exception raised, test passes
 
 
+@suite.test
+def test_event_stats():
+    """Test that the event buffer reports its counters"""
+    stats = ae.render_monitor.get_event_stats()
+    for key in ("received", "dropped", "coalesced", "delivered", "batches",
+                "pending", "held", "capacity", "max_update_rate"):
+        assert_true(key in stats, f"Missing stat '{key}'")
+    assert_true(stats["capacity"] >= 16)
+    assert_isinstance(ae.render_monitor.flush_events(), int)
+    assert_equal(0, ae.render_monitor.get_event_stats()["pending"])
+
+
+@suite.test
+def test_configure_events():
+    """Test configuring the update rate and buffer capacity"""
+    if ae.render_monitor.is_listener_registered():
+        ae.render_monitor.unregister_listener()
+
+    ae.render_monitor.configure_events(max_update_rate=10.0, capacity=1000)
+    stats = ae.render_monitor.get_event_stats()
+    assert_close(10.0, stats["max_update_rate"])
+    assert_equal(1024, stats["capacity"])
+
+    try:
+        ae.render_monitor.configure_events(max_update_rate=-1.0)
+        assert_true(False, "Negative rate should raise ValueError")
+    except ValueError:
+        pass
+
+    ae.render_monitor.configure_events(max_update_rate=30.0, capacity=4096)
+    assert_equal(4096, ae.render_monitor.get_event_stats()["capacity"])
+
+
+@suite.test
+def test_set_events_callback():
+    """Test setting and clearing the batch callback"""
+    batches = []
+    ae.render_monitor.set_on_events(batches.append)
+    ae.render_monitor.flush_events()
+    ae.render_monitor.set_on_events(None)
+
+
 @suite.test
 def test_callback_docstrings():
     """Test that callback functions have documentation"""
@@ -172,6 +219,111 @@ def test_callback_docstrings():
                     "set_on_job_started should have a docstring")
 
 
+# -----------------------------------------------------------------------
+# Render Statistics Tests
+#
+# Note: No render runs here, so the collector has no records; a real
+# render job is needed to see frame times.
+# -----------------------------------------------------------------------
+
+@suite.test
+def test_start_stop_collecting():
+    """Test starting and stopping the stats collector"""
+    was_registered = ae.render_monitor.is_listener_registered()
+    try:
+        result = ae.render_monitor.start_collecting(memory_interval=0.5)
+        assert_isinstance(result, bool)
+        assert_true(ae.render_monitor.is_collecting())
+        info = ae.render_monitor.get_collection_info()
+        for key in ("collecting", "jobs", "items", "frames", "memory_samples",
+                    "dropped_frames", "events", "bytes", "report_path"):
+            assert_true(key in info, f"Missing info '{key}'")
+        assert_true(info["collecting"])
+        assert_none(info["report_path"])
+    finally:
+        ae.render_monitor.stop_collecting()
+        if not was_registered:
+            ae.render_monitor.unregister_listener()
+    assert_false(ae.render_monitor.is_collecting())
+
+    try:
+        ae.render_monitor.start_collecting(memory_interval=-1.0)
+        assert_true(False, "Negative memory_interval should raise ValueError")
+    except ValueError:
+        pass
+
+
+@suite.test
+def test_stats_columns():
+    """Test that the stats queries return array columns"""
+    ae.render_monitor.clear_stats()
+    checks = [
+        (ae.render_monitor.get_job_stats(), ("session_id", "start", "end", "items", "frames")),
+        (ae.render_monitor.get_item_stats(), ("session_id", "item_id", "status", "render_time",
+                                              "frames", "frame_time_mean", "frame_time_p95")),
+        (ae.render_monitor.get_frame_stats(), ("session_id", "item_id", "frame_id", "time", "duration")),
+        (ae.render_monitor.get_slowest_frames(5), ("item_id", "frame_id", "duration")),
+        (ae.render_monitor.get_memory_stats(), ("time", "item_id", "working_set", "private_bytes")),
+    ]
+    for columns, keys in checks:
+        for key in keys:
+            assert_true(key in columns, f"Missing column '{key}'")
+            assert_isinstance(columns[key], array)
+            assert_equal(0, len(columns[key]))
+    assert_equal(0, ae.render_monitor.get_collection_info()["frames"])
+
+
+@suite.test
+def test_frame_histogram():
+    """Test the frame time histogram shape and arguments"""
+    counts, edges = ae.render_monitor.get_frame_histogram(bins=8, range=(0.0, 2.0))
+    assert_equal(8, len(counts))
+    assert_equal(9, len(edges))
+    assert_close(0.0, edges[0])
+    assert_close(2.0, edges[-1])
+
+    for kwargs in ({"bins": 0}, {"range": (1.0, 1.0)}):
+        try:
+            ae.render_monitor.get_frame_histogram(**kwargs)
+            assert_true(False, f"{kwargs} should raise ValueError")
+        except ValueError:
+            pass
+
+
+@suite.test
+def test_stats_reports():
+    """Test JSON and CSV reports and file export"""
+    report = json.loads(ae.render_monitor.get_stats_report())
+    assert_equal("pyae-render-stats", report["format"])
+    for key in ("jobs", "items", "frames", "memory"):
+        assert_true(key in report, f"Missing report section '{key}'")
+
+    csv_text = ae.render_monitor.get_stats_report(format="csv", table="frames")
+    assert_equal("session_id,item_id,frame_id,time,duration", csv_text.splitlines()[0])
+
+    tmp_dir = tempfile.mkdtemp(prefix="pyae_render_stats_")
+    try:
+        csv_path = os.path.join(tmp_dir, "items.csv")
+        json_path = os.path.join(tmp_dir, "stats.json")
+        ae.render_monitor.export_stats(csv_path)
+        ae.render_monitor.export_stats(json_path, indent=2)
+        with open(csv_path, encoding="utf-8") as f:
+            assert_true(f.readline().startswith("session_id,item_id,status,"))
+        with open(json_path, encoding="utf-8") as f:
+            assert_equal(1, json.load(f)["version"])
+    finally:
+        for name in os.listdir(tmp_dir):
+            os.remove(os.path.join(tmp_dir, name))
+        os.rmdir(tmp_dir)
+
+    for kwargs in ({"format": "xml"}, {"format": "csv", "table": "layers"}):
+        try:
+            ae.render_monitor.get_stats_report(**kwargs)
+            assert_true(False, f"{kwargs} should raise ValueError")
+        except ValueError:
+            pass
+
+
 def run():
     """Run tests"""
     return suite.run()
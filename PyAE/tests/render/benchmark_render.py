@@ -0,0 +1,304 @@
+# benchmark_render.py
+# PyAE Render Benchmark
+#
+# render_frame / render_layer_frame のスループット（fps）とフレームごとの遅延を、
+# ビット深度・ダウンサンプル・ROI・画素の取り出し方（bytes コピー / バッファビュー /
+# read_pixels）の組み合わせで測り、ビルド間で比較できる JSON に書き出す。
+#
+# AE 内で実行:
+#     from tests.render import benchmark_render
+#     benchmark_render.run(output="C:/tmp/render_bench.json")
+#
+# 結果の比較（AE なしでも動く）:
+#     python benchmark_render.py --compare base.json new.json [--threshold 0.1]
+#
+# AE はレンダー結果をキャッシュするので、各ケースはコンポ内の異なる時刻を
+# 順に描く。比較は同じマシン・同じ AE の設定で取った結果どうしで行うこと。
+
+import argparse
+import datetime
+import json
+import platform
+import statistics
+import sys
+import time
+
+SCHEMA_VERSION = 1
+
+DEFAULT_CONFIG = {
+    "width": 1920,
+    "height": 1080,
+    "frames": 20,           # ケースごとに計測するフレーム数
+    "warmup": 2,            # 計測前に捨てるフレーム数
+    "world_types": ["BIT8", "BIT16", "BIT32"],
+    "downsample": [1, 2, 3, 4],
+    "roi": [1.0, 0.5, 0.25],   # フレームに対する ROI の一辺の割合（中央に置く）
+    "extract": ["none", "bytes", "view", "read_pixels"],
+    "layer": True,          # render_layer_frame も測る
+}
+
+FPS = 30.0
+
+
+def build_cases(config):
+    """測るケースの一覧を返す
+
+    全組み合わせは多すぎるので、軸ごとに基準（BIT8 / ダウンサンプル 1 /
+    ROI 全体 / 取り出しなし）から1つずつ振る:
+      - API x ビット深度 x ダウンサンプル
+      - render_frame の ROI（ビット深度ごと）
+      - render_frame の取り出し方（ビット深度ごと）
+    """
+    cases = []
+    apis = ["render_frame"] + (["render_layer_frame"] if config["layer"] else [])
+    for api in apis:
+        for world_type in config["world_types"]:
+            for downsample in config["downsample"]:
+                cases.append(_case(api, world_type, downsample, 1.0, "none"))
+    for world_type in config["world_types"]:
+        for roi in config["roi"]:
+            if roi < 1.0:
+                cases.append(_case("render_frame", world_type, 1, roi, "none"))
+        for extract in config["extract"]:
+            if extract != "none":
+                cases.append(_case("render_frame", world_type, 1, 1.0, extract))
+    return cases
+
+
+def _case(api, world_type, downsample, roi, extract):
+    name = f"{api}/{world_type}/ds{downsample}/roi{int(round(roi * 100))}/{extract}"
+    return {"name": name, "api": api, "world_type": world_type,
+            "downsample": downsample, "roi": roi, "extract": extract}
+
+
+def _percentile(values, fraction):
+    ordered = sorted(values)
+    index = min(len(ordered) - 1, max(0, int(round(fraction * (len(ordered) - 1)))))
+    return ordered[index]
+
+
+def _summarize(case, latencies, extract_times, nbytes):
+    total = sum(latencies)
+    result = dict(case)
+    result.update({
+        "frames": len(latencies),
+        "fps": len(latencies) / total if total > 0 else 0.0,
+        "mean_ms": statistics.mean(latencies) * 1000.0,
+        "median_ms": statistics.median(latencies) * 1000.0,
+        "p95_ms": _percentile(latencies, 0.95) * 1000.0,
+        "min_ms": min(latencies) * 1000.0,
+        "max_ms": max(latencies) * 1000.0,
+        "extract_mean_ms": statistics.mean(extract_times) * 1000.0 if extract_times else 0.0,
+        "bytes_per_frame": nbytes,
+    })
+    return result
+
+
+def _extract(world, mode, out):
+    """画素を取り出し、取り出したバイト数を返す"""
+    if mode == "bytes":
+        return len(world.get_pixels())
+    if mode == "view":
+        view = memoryview(world)
+        nbytes = view.nbytes
+        view.release()
+        return nbytes
+    if mode == "read_pixels":
+        world.read_pixels(out)
+        return len(out)
+    return 0
+
+
+def _run_case(ae, comp, layer, case, config):
+    world_type = getattr(ae.WorldType, case["world_type"])
+    downsample = case["downsample"]
+    frame_count = config["warmup"] + config["frames"]
+    duration_frames = int(comp.duration * FPS)
+
+    if case["api"] == "render_frame":
+        options = ae.RenderOptions.from_item(comp._handle)
+        options.world_type = world_type
+        options.downsample_factor = (downsample, downsample)
+        if case["roi"] < 1.0:
+            w = max(1, int(config["width"] * case["roi"]))
+            h = max(1, int(config["height"] * case["roi"]))
+            left = (config["width"] - w) // 2
+            top = (config["height"] - h) // 2
+            options.region_of_interest = {"left": left, "top": top,
+                                          "right": left + w, "bottom": top + h}
+    else:
+        options = ae.LayerRenderOptions.from_layer(layer._handle)
+        options.world_type = world_type
+        options.downsample_factor = (downsample, downsample)
+
+    out = None
+    if case["extract"] == "read_pixels":
+        out = bytearray((config["width"] // downsample) * (config["height"] // downsample) * 4)
+
+    latencies = []
+    extract_times = []
+    nbytes = 0
+    for i in range(frame_count):
+        options.time = (i % max(1, duration_frames)) / FPS
+        start = time.perf_counter()
+        if case["api"] == "render_frame":
+            receipt = ae.Renderer.render_frame(options)
+        else:
+            receipt = ae.Renderer.render_layer_frame(options._handle)
+        try:
+            world = receipt.world
+            extract_start = time.perf_counter()
+            if out is not None and len(out) != world.width * world.height * 4:
+                out = bytearray(world.width * world.height * 4)
+            nbytes = _extract(world, case["extract"], out)
+            extract_end = time.perf_counter()
+        finally:
+            receipt.checkin()
+        end = time.perf_counter()
+        if i >= config["warmup"]:
+            latencies.append(end - start)
+            if case["extract"] != "none":
+                extract_times.append(extract_end - extract_start)
+    return _summarize(case, latencies, extract_times, nbytes)
+
+
+def _environment(ae):
+    env = {
+        "platform": platform.platform(),
+        "python": platform.python_version(),
+        "pyae_version": getattr(ae, "__version__", ""),
+    }
+    try:
+        info = ae.get_ae_info()
+        env["ae"] = {str(k): (v if isinstance(v, (int, float, bool)) else str(v))
+                     for k, v in dict(info).items()}
+    except Exception:
+        pass
+    return env
+
+
+def run_benchmark(config=None, output=None, verbose=True):
+    """ベンチマークを実行して結果の dict を返す（output を渡せば JSON を書き出す）"""
+    import ae
+
+    cfg = dict(DEFAULT_CONFIG)
+    cfg.update(config or {})
+
+    proj = ae.Project.get_current()
+    comp = proj.create_comp("_RenderBenchmarkComp", cfg["width"], cfg["height"], 1.0,
+                            max(1.0, (cfg["warmup"] + cfg["frames"]) / FPS), FPS)
+    try:
+        layer = comp.add_solid("_RenderBenchmarkSolid", cfg["width"], cfg["height"],
+                               (0.2, 0.4, 0.8), 1.0)
+        # 時刻ごとに内容が変わるようにする
+        layer.property("Opacity").add_keyframe(0.0, 0.0)
+        layer.property("Opacity").add_keyframe(comp.duration, 100.0)
+
+        results = []
+        for case in build_cases(cfg):
+            result = _run_case(ae, comp, layer, case, cfg)
+            results.append(result)
+            if verbose:
+                print(f"{result['name']:48}{result['fps']:>9.1f} fps"
+                      f"{result['median_ms']:>10.2f} ms{result['p95_ms']:>10.2f} ms p95")
+    finally:
+        try:
+            ae.sdk.AEGP_DeleteItem(comp._handle)
+        except Exception as e:
+            print(f"Warning: Failed to delete benchmark comp: {e}")
+
+    report = {
+        "schema": SCHEMA_VERSION,
+        "created": datetime.datetime.now().isoformat(timespec="seconds"),
+        "environment": _environment(ae),
+        "config": cfg,
+        "results": results,
+    }
+    if output:
+        with open(output, "w", encoding="utf-8") as f:
+            json.dump(report, f, indent=2)
+    return report
+
+
+def compare(base, new, threshold=0.1):
+    """2つの結果を比べ、ケースごとの差分と遅くなったケースを返す
+
+    median_ms が threshold（割合）を超えて増えたケースを regression とする。
+    片方にしかないケースは missing / added に入れる。
+    """
+    if base.get("schema") != new.get("schema"):
+        raise ValueError("Benchmark results have different schema versions")
+
+    base_cases = {r["name"]: r for r in base["results"]}
+    new_cases = {r["name"]: r for r in new["results"]}
+    rows = []
+    regressions = []
+    for name, old in base_cases.items():
+        cur = new_cases.get(name)
+        if cur is None:
+            continue
+        change = (cur["median_ms"] - old["median_ms"]) / old["median_ms"] if old["median_ms"] > 0 else 0.0
+        row = {"name": name, "base_ms": old["median_ms"], "new_ms": cur["median_ms"],
+               "base_fps": old["fps"], "new_fps": cur["fps"], "change": change}
+        rows.append(row)
+        if change > threshold:
+            regressions.append(row)
+    return {
+        "rows": rows,
+        "regressions": regressions,
+        "missing": sorted(set(base_cases) - set(new_cases)),
+        "added": sorted(set(new_cases) - set(base_cases)),
+    }
+
+
+def print_comparison(result):
+    print(f"{'case':48}{'base ms':>10}{'new ms':>10}{'change':>9}")
+    for row in result["rows"]:
+        mark = "  <-" if row in result["regressions"] else ""
+        print(f"{row['name']:48}{row['base_ms']:>10.2f}{row['new_ms']:>10.2f}"
+              f"{row['change']:>+9.1%}{mark}")
+    for name in result["missing"]:
+        print(f"{name:48}  missing in new results")
+    for name in result["added"]:
+        print(f"{name:48}  new case")
+    print(f"\n{len(result['regressions'])} regression(s)")
+
+
+def run(output=None, **config):
+    """AE 内からの実行用"""
+    return run_benchmark(config, output)
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="PyAE render benchmark")
+    parser.add_argument("--compare", nargs=2, metavar=("BASE", "NEW"),
+                        help="Compare two JSON results instead of running")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="Median latency increase counted as a regression (default 0.1)")
+    parser.add_argument("--output", help="Write the results to this JSON file")
+    parser.add_argument("--frames", type=int, help="Frames per case")
+    args = parser.parse_args(argv)
+
+    if args.compare:
+        with open(args.compare[0], "r", encoding="utf-8") as f:
+            base = json.load(f)
+        with open(args.compare[1], "r", encoding="utf-8") as f:
+            new = json.load(f)
+        result = compare(base, new, args.threshold)
+        print_comparison(result)
+        return 1 if result["regressions"] else 0
+
+    config = {}
+    if args.frames:
+        config["frames"] = args.frames
+    run_benchmark(config, args.output)
+    return 0
+
+
+if __name__ == "__main__":
+    try:
+        import ae  # noqa: F401
+    except ImportError:
+        sys.exit(main())
+    else:
+        run()
@@ -0,0 +1,202 @@
+# test_frame_writer.py
+# PyAE Frame Writer Test
+#
+# FrameWriter（ワーカースレッドでの PNG / TIFF / EXR / PFM 書き出し）のテスト。
+
+import os
+import shutil
+import struct
+import tempfile
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_raises,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_raises,
+    )
+
+suite = TestSuite("Frame Writer")
+
+WIDTH = 32
+HEIGHT = 24
+
+_test_comp = None
+_output_dir = None
+
+
+def _path(name):
+    return os.path.join(_output_dir, name)
+
+
+def _read(path):
+    with open(path, "rb") as f:
+        return f.read()
+
+
+def _make_world(world_type=ae.WorldType.BIT8):
+    world = ae.World.create(world_type, WIDTH, HEIGHT)
+    world.fill((0.0, 0.0, 1.0, 1.0))
+    world.fill_rect(4, 4, 8, 8, (1.0, 0.0, 0.0, 1.0))
+    return world
+
+
+@suite.setup
+def setup():
+    """Setup an output directory and a composition with a red solid"""
+    global _test_comp, _output_dir
+    _output_dir = tempfile.mkdtemp(prefix="pyae_frame_writer_")
+    proj = ae.Project.get_current()
+    _test_comp = proj.create_comp("_FrameWriterTestComp", WIDTH, HEIGHT, 1.0, 1.0, 30.0)
+    _test_comp.add_solid("_FrameWriterTestSolid", WIDTH, HEIGHT, (1.0, 0.0, 0.0), 1.0)
+
+
+@suite.teardown
+def teardown():
+    """Cleanup test resources"""
+    global _test_comp, _output_dir
+    if _test_comp:
+        try:
+            ae.sdk.AEGP_DeleteItem(_test_comp._handle)
+        except Exception as e:
+            print(f"Warning: Failed to delete test comp: {e}")
+        _test_comp = None
+    if _output_dir:
+        shutil.rmtree(_output_dir, ignore_errors=True)
+        _output_dir = None
+
+
+@suite.test
+def test_write_png():
+    """Test writing an 8 bpc world as PNG"""
+    with ae.FrameWriter(threads=2) as writer:
+        future = writer.write(_make_world(), _path("frame.png"))
+        assert_equal(_path("frame.png"), future.result(timeout=10.0))
+        assert_true(future.done())
+        assert_true(future.exception() is None)
+
+    data = _read(_path("frame.png"))
+    assert_equal(b"\x89PNG\r\n\x1a\n", data[:8])
+    assert_equal(b"IHDR", data[12:16])
+    width, height, bit_depth, color_type = struct.unpack(">IIBB", data[16:26])
+    assert_equal((WIDTH, HEIGHT, 8, 6), (width, height, bit_depth, color_type))
+    assert_equal(len(data), future.bytes_written)
+
+
+@suite.test
+def test_formats_and_bit_depths():
+    """Test TIFF / EXR / PFM output and the default bit depth per format"""
+    world = _make_world(ae.WorldType.BIT16)
+    with ae.FrameWriter() as writer:
+        png = writer.write(world, _path("deep.png"))
+        tiff = writer.write(world, _path("frame.tif"), bit_depth=32)
+        exr = writer.write(world, _path("frame.dat"), format="exr")
+        pfm = writer.write(world, _path("frame.pfm"))
+        assert_true(writer.flush(timeout=10.0))
+        for future in (png, tiff, exr, pfm):
+            assert_true(future.exception() is None)
+
+    assert_equal(16, _read(_path("deep.png"))[24])
+    assert_equal(b"II*\x00", _read(_path("frame.tif"))[:4])
+    assert_equal(b"\x76\x2f\x31\x01", _read(_path("frame.dat"))[:4])
+    assert_true(_read(_path("frame.pfm")).startswith(f"PF\n{WIDTH} {HEIGHT}\n".encode("ascii")))
+
+
+@suite.test
+def test_invalid_arguments():
+    """Test unknown formats and unsupported bit depths"""
+    world = _make_world()
+    with ae.FrameWriter(threads=1) as writer:
+        assert_raises(ValueError, writer.write, world, _path("frame.bmp"))
+        assert_raises(ValueError, writer.write, world, _path("frame.png"), format="jpeg")
+        assert_raises(ValueError, writer.write, world, _path("frame.png"), bit_depth=32)
+        assert_raises(ValueError, writer.write, world, _path("frame.exr"), bit_depth=16)
+        assert_equal(0, writer.stats()["submitted"])
+
+
+@suite.test
+def test_failed_write_is_reported():
+    """Test that an unwritable path fails the future, not write()"""
+    missing = os.path.join(_output_dir, "missing", "frame.png")
+    with ae.FrameWriter(threads=1) as writer:
+        future = writer.write(_make_world(), missing)
+        assert_true(future.wait(timeout=10.0))
+        assert_true(future.exception() is not None)
+        assert_raises(RuntimeError, future.result)
+        assert_equal(0, future.bytes_written)
+
+        stats = writer.stats()
+        assert_equal(1, stats["failed"])
+        assert_equal(0, stats["written"])
+        assert_equal(0, stats["pending"])
+
+
+@suite.test
+def test_in_flight_limit_and_stats():
+    """Test that write() stays within max_in_flight_bytes and recycles buffers"""
+    frame_bytes = WIDTH * HEIGHT * 4
+    world = _make_world()
+    with ae.FrameWriter(threads=2, max_in_flight_bytes=frame_bytes * 2) as writer:
+        assert_equal(2, writer.threads)
+        assert_equal(frame_bytes * 2, writer.max_in_flight_bytes)
+        futures = [writer.write(world, _path(f"seq_{i:04d}.png")) for i in range(16)]
+        assert_true(writer.flush(timeout=30.0))
+        for future in futures:
+            assert_true(future.exception() is None)
+
+        stats = writer.stats()
+        assert_equal(16, stats["submitted"])
+        assert_equal(16, stats["written"])
+        assert_equal(0, stats["pending"])
+        assert_equal(0, stats["in_flight_bytes"])
+        assert_true(stats["peak_in_flight_bytes"] <= frame_bytes * 2)
+        assert_true(stats["pooled_buffers"] >= 1)
+        assert_equal(sum(f.bytes_written for f in futures), stats["bytes_written"])
+
+
+@suite.test
+def test_write_after_close():
+    """Test that close() finishes pending frames and rejects new ones"""
+    writer = ae.FrameWriter(threads=1)
+    future = writer.write(_make_world(), _path("last.png"))
+    writer.close()
+    assert_true(writer.closed)
+    assert_true(future.done())
+    assert_true(os.path.exists(_path("last.png")))
+    assert_raises(RuntimeError, writer.write, _make_world(), _path("closed.png"))
+    writer.close()
+
+
+@suite.test
+def test_write_render_receipt():
+    """Test writing a rendered frame checks the receipt in after capture"""
+    options = ae.RenderOptions.from_item(_test_comp._handle)
+    with ae.FrameWriter() as writer:
+        receipt = ae.Renderer.render_frame(options)
+        future = writer.write(receipt, _path("render.exr"))
+        assert_false(receipt.valid)
+        future.result(timeout=10.0)
+
+    data = _read(_path("render.exr"))
+    assert_equal(b"\x76\x2f\x31\x01", data[:4])
+    assert_equal(len(data), future.bytes_written)
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
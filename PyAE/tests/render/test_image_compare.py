@@ -0,0 +1,165 @@
+# test_image_compare.py
+# PyAE Image Compare Test
+#
+# World.compare（絶対誤差・PSNR・タイル SSIM・差分 World）のテスト。
+# 後半はレンダー結果をゴールデン画像（バッファ）と比較するフレーム回帰テストの例。
+
+import math
+from array import array
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_raises,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_raises,
+    )
+
+suite = TestSuite("Image Compare")
+
+WIDTH = 64
+HEIGHT = 48
+PIXELS = WIDTH * HEIGHT
+
+_test_comp = None
+
+
+def _close(a, b, tolerance=1e-4):
+    return abs(a - b) <= tolerance
+
+
+@suite.setup
+def setup():
+    """Setup a composition with a red solid for render regression tests"""
+    global _test_comp
+    proj = ae.Project.get_current()
+    _test_comp = proj.create_comp("_ImageCompareTestComp", WIDTH, HEIGHT, 1.0, 1.0, 30.0)
+    _test_comp.add_solid("_ImageCompareTestSolid", WIDTH, HEIGHT, (1.0, 0.0, 0.0), 1.0)
+
+
+@suite.teardown
+def teardown():
+    """Cleanup test resources"""
+    global _test_comp
+    if _test_comp:
+        try:
+            ae.sdk.AEGP_DeleteItem(_test_comp._handle)
+        except Exception as e:
+            print(f"Warning: Failed to delete test comp: {e}")
+        _test_comp = None
+
+
+@suite.test
+def test_identical_worlds_across_depths():
+    """Test that the same image at different bit depths compares identical"""
+    a = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    b = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    for world in (a, b):
+        world.fill((0.0, 0.0, 1.0, 1.0))
+        world.fill_rect(10, 10, 20, 20, (1.0, 0.0, 0.0, 1.0))
+
+    result = a.compare(b)
+    assert_true(result["identical"])
+    assert_true(result["complete"])
+    assert_equal(PIXELS, result["pixels"])
+    assert_equal(0, result["differing_pixels"])
+    assert_equal(0.0, result["max_error"])
+    assert_true(math.isinf(result["psnr"]))
+    assert_true(_close(1.0, result["ssim"]))
+
+
+@suite.test
+def test_metrics_and_diff_world():
+    """Test max / mean error, PSNR and the diff world for a known difference"""
+    a = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    b = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    a.fill((0.5, 0.5, 0.5, 1.0))
+    b.fill((0.5, 0.5, 0.5, 1.0))
+    b.fill_rect(0, 0, 8, 8, (0.75, 0.5, 0.5, 1.0))
+
+    diff = ae.World.create(ae.WorldType.BIT32, WIDTH, HEIGHT)
+    result = a.compare(b, diff=diff)
+    assert_false(result["identical"])
+    assert_equal(64, result["differing_pixels"])
+    assert_true(_close(0.25, result["max_abs"][0]))
+    assert_equal(0.0, result["max_abs"][1])
+    assert_true(_close(0.25 * 64 / PIXELS, result["mean_abs"][0]))
+
+    mse = 0.25 * 0.25 * 64 / PIXELS / 3
+    assert_true(_close(10 * math.log10(1 / mse), result["psnr"], 1e-3))
+    assert_true(result["ssim"] < 1.0)
+    assert_true(_close(1.0, result["ssim_channels"][1]))
+
+    assert_equal((0.25, 0.0, 0.0, 1.0), diff.get_pixel(3, 3))
+    assert_equal((0.0, 0.0, 0.0, 1.0), diff.get_pixel(8, 8))
+
+
+@suite.test
+def test_tolerance_and_early_exit():
+    """Test that tolerance hides small differences and early_exit stops early"""
+    a = ae.World.create(ae.WorldType.BIT16, WIDTH, HEIGHT)
+    b = ae.World.create(ae.WorldType.BIT16, WIDTH, HEIGHT)
+    b.fill((0.01, 0.0, 0.0, 0.0))
+
+    assert_true(a.compare(b, tolerance=0.02)["identical"])
+    assert_false(a.compare(b, tolerance=0.005)["identical"])
+
+    early = a.compare(b, early_exit=True, ssim=False)
+    assert_false(early["identical"])
+    assert_false(early["complete"])
+    assert_true(early["pixels"] < PIXELS)
+    assert_equal(None, early["ssim"])
+
+
+@suite.test
+def test_compare_with_buffer():
+    """Test comparing a world against a pixel buffer (e.g. a golden file)"""
+    world = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+    world.fill((1.0, 0.0, 0.0, 1.0))
+
+    golden = bytes([255, 0, 0, 255]) * PIXELS              # RGBA 8bit
+    assert_true(world.compare(golden)["identical"])
+    golden_argb = array("f", [1.0, 1.0, 0.0, 0.0] * PIXELS)  # ARGB float
+    assert_true(world.compare(golden_argb, layout=ae.PixelLayout.ARGB)["identical"])
+
+    assert_raises(RuntimeError, world.compare, golden[:-4])
+    other = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT + 1)
+    assert_raises(RuntimeError, world.compare, other)
+    assert_raises(ValueError, world.compare, golden, ssim_tile=0)
+
+
+@suite.test
+def test_render_frame_regression():
+    """Test a rendered frame against a golden buffer captured from an earlier render"""
+    options = ae.RenderOptions.from_item(_test_comp._handle)
+    with ae.Renderer.render_frame(options) as receipt:
+        golden = receipt.world.read_pixels(depth=ae.WorldType.BIT8)
+
+    with ae.Renderer.render_frame(options) as receipt:
+        result = receipt.world.compare(golden, tolerance=1.0 / 255, early_exit=True)
+        assert_true(result["identical"])
+        assert_true(result["complete"])
+
+        red = ae.World.create(ae.WorldType.BIT8, WIDTH, HEIGHT)
+        red.fill((1.0, 0.0, 0.0, 1.0))
+        assert_true(receipt.world.compare(red, tolerance=1.0 / 255)["identical"])
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
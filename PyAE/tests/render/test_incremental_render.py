@@ -0,0 +1,187 @@
+# test_incremental_render.py
+# PyAE Incremental Render Test
+#
+# IncrementalRenderer（更新領域だけを描き直す差分レンダー）のテスト。
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_none,
+        assert_raises,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_none,
+        assert_raises,
+    )
+
+suite = TestSuite("Incremental Render")
+
+WIDTH = 64
+HEIGHT = 48
+SOLID = 8
+
+_test_comp = None
+_test_layer = None
+
+
+@suite.setup
+def setup():
+    """Setup a composition with a small red solid"""
+    global _test_comp, _test_layer
+    proj = ae.Project.get_current()
+    _test_comp = proj.create_comp("_IncrementalRenderTestComp", WIDTH, HEIGHT, 1.0, 1.0, 30.0)
+    _test_layer = _test_comp.add_solid("_IncrementalRenderTestSolid", SOLID, SOLID, (1.0, 0.0, 0.0), 1.0)
+    _test_layer.position = [16, 16]
+
+
+@suite.teardown
+def teardown():
+    """Cleanup test resources"""
+    global _test_comp, _test_layer
+    _test_layer = None
+    if _test_comp:
+        try:
+            ae.sdk.AEGP_DeleteItem(_test_comp._handle)
+        except Exception as e:
+            print(f"Warning: Failed to delete test comp: {e}")
+        _test_comp = None
+
+
+def _assert_matches_full_render(world):
+    receipt = ae.Renderer.render_frame(ae.RenderOptions.from_item(_test_comp._handle))
+    try:
+        result = world.compare(receipt.world, tolerance=1.0 / 255.0, ssim=False)
+        assert_true(result["identical"], f"differing pixels: {result['differing_pixels']}")
+    finally:
+        receipt.checkin()
+
+
+@suite.test
+def test_first_update_is_full():
+    """Test that the first update renders the whole frame"""
+    inc = ae.IncrementalRenderer(_test_comp)
+    assert_none(inc.world)
+    assert_none(inc.frame_size)
+
+    info = inc.update()
+    assert_true(info["full"])
+    assert_equal([(0, 0, WIDTH, HEIGHT)], info["regions"])
+    assert_equal(WIDTH * HEIGHT, info["rendered_pixels"])
+    assert_equal(0, info["saved_pixels"])
+    assert_equal((WIDTH, HEIGHT), inc.frame_size)
+    r, g, b, a = inc.world.get_pixel(16, 16)
+    assert_true(r > 0.9 and g < 0.1 and a > 0.9)
+
+
+@suite.test
+def test_moved_layer_repaints_old_and_new_bounds():
+    """Test that moving a layer re-renders only its old and new bounds"""
+    inc = ae.IncrementalRenderer(_test_comp, padding=1)
+    inc.update()
+    world = inc.world
+
+    original = _test_layer.position
+    try:
+        _test_layer.position = [40, 30]
+        info = inc.update(layers=[_test_layer])
+        assert_false(info["full"])
+        assert_equal(1, len(info["regions"]))
+        left, top, right, bottom = info["regions"][0]
+        assert_true(left <= 12 and top <= 12 and right >= 44 and bottom >= 34)
+        assert_true(info["saved_pixels"] > 0)
+        assert_equal(info["full_pixels"] - info["rendered_pixels"], info["saved_pixels"])
+
+        # 同じ World を描き足している
+        assert_true(inc.world is world)
+        assert_true(inc.world.get_pixel(16, 16)[3] < 0.1)
+        assert_true(inc.world.get_pixel(40, 30)[0] > 0.9)
+        _assert_matches_full_render(inc.world)
+    finally:
+        _test_layer.position = original
+
+
+@suite.test
+def test_separate_regions():
+    """Test that distant dirty areas stay separate with max_regions"""
+    inc = ae.IncrementalRenderer(_test_comp, max_regions=4)
+    inc.update()
+    info = inc.update(rect=(0, 0, 4, 4))
+    assert_equal([(0, 0, 4, 4)], info["regions"])
+
+    inc.invalidate((WIDTH - 4, HEIGHT - 4, WIDTH, HEIGHT))
+    info = inc.update(rect=(0, 0, 4, 4))
+    assert_equal(2, len(info["regions"]))
+    assert_equal(32, info["rendered_pixels"])
+    _assert_matches_full_render(inc.world)
+
+
+@suite.test
+def test_nothing_dirty():
+    """Test that an update without changes renders nothing"""
+    inc = ae.IncrementalRenderer(_test_comp)
+    inc.update()
+    info = inc.update()
+    assert_false(info["full"])
+    assert_equal([], info["regions"])
+    assert_equal(0, info["rendered_pixels"])
+    assert_equal(WIDTH * HEIGHT, info["saved_pixels"])
+
+
+@suite.test
+def test_time_change_is_full():
+    """Test that a new time re-renders the whole frame"""
+    inc = ae.IncrementalRenderer(_test_comp)
+    inc.update(time=0.0)
+    info = inc.update(time=0.5)
+    assert_true(info["full"])
+    assert_true(abs(inc.time - 0.5) < 1e-9)
+    assert_false(inc.update(time=0.5)["full"])
+
+
+@suite.test
+def test_stats():
+    """Test the accumulated pixel accounting"""
+    inc = ae.IncrementalRenderer(_test_comp)
+    inc.update()
+    inc.update(rect=(0, 0, 8, 8))
+    stats = inc.stats
+    assert_equal(2, stats["updates"])
+    assert_equal(1, stats["full_renders"])
+    assert_equal(1, stats["region_renders"])
+    assert_equal(WIDTH * HEIGHT + 64, stats["rendered_pixels"])
+    assert_equal(WIDTH * HEIGHT - 64, stats["saved_pixels"])
+    assert_true(0.0 < stats["saved_ratio"] < 1.0)
+    assert_equal(1, stats["transfers"] + stats["copies"])
+
+    inc.reset_stats()
+    assert_equal(0, inc.stats["updates"])
+
+
+@suite.test
+def test_invalid_arguments():
+    """Test argument validation"""
+    assert_raises(ValueError, ae.IncrementalRenderer, "not an item")
+    assert_raises(ValueError, ae.IncrementalRenderer, _test_comp, padding=-1)
+    assert_raises(ValueError, ae.IncrementalRenderer, _test_comp, max_regions=0)
+    inc = ae.IncrementalRenderer(_test_comp)
+    inc.update()
+    assert_raises(ValueError, inc.update, layers=["not a layer"])
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
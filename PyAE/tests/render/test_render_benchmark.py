@@ -0,0 +1,134 @@
+# test_render_benchmark.py
+# PyAE Render Benchmark Test
+#
+# benchmark_render（レンダーのスループット計測と JSON 比較）が小さな設定で
+# 最後まで動き、比較できる結果を出すことを確認する。
+
+import copy
+import json
+import os
+import tempfile
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_equal,
+        assert_raises,
+    )
+    from . import benchmark_render
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_equal,
+        assert_raises,
+    )
+    import benchmark_render
+
+suite = TestSuite("Render Benchmark")
+
+SMALL_CONFIG = {
+    "width": 64,
+    "height": 48,
+    "frames": 2,
+    "warmup": 0,
+    "world_types": ["BIT8", "BIT32"],
+    "downsample": [1, 2],
+    "roi": [1.0, 0.5],
+    "extract": ["none", "bytes", "view", "read_pixels"],
+    "layer": True,
+}
+
+_report = None
+_tmp_dir = None
+
+
+@suite.setup
+def setup():
+    """Run the benchmark once with a small configuration"""
+    global _report, _tmp_dir
+    _tmp_dir = tempfile.mkdtemp(prefix="pyae_render_bench_")
+    _report = benchmark_render.run_benchmark(
+        SMALL_CONFIG, os.path.join(_tmp_dir, "bench.json"), verbose=False)
+
+
+@suite.teardown
+def teardown():
+    """Cleanup test resources"""
+    global _report, _tmp_dir
+    _report = None
+    if _tmp_dir:
+        path = os.path.join(_tmp_dir, "bench.json")
+        if os.path.exists(path):
+            os.remove(path)
+        os.rmdir(_tmp_dir)
+        _tmp_dir = None
+
+
+@suite.test
+def test_cases():
+    """Test that every axis of the configuration is measured"""
+    names = [r["name"] for r in _report["results"]]
+    assert_equal(len(benchmark_render.build_cases(SMALL_CONFIG)), len(names))
+    assert_equal(len(names), len(set(names)))
+    assert_true("render_frame/BIT8/ds2/roi100/none" in names)
+    assert_true("render_layer_frame/BIT32/ds1/roi100/none" in names)
+    assert_true("render_frame/BIT8/ds1/roi50/none" in names)
+    assert_true("render_frame/BIT32/ds1/roi100/view" in names)
+
+
+@suite.test
+def test_result_fields():
+    """Test the measured values of each case"""
+    for result in _report["results"]:
+        assert_equal(SMALL_CONFIG["frames"], result["frames"])
+        assert_true(result["fps"] > 0.0)
+        assert_true(result["min_ms"] <= result["median_ms"] <= result["max_ms"])
+        assert_true(result["p95_ms"] <= result["max_ms"])
+        if result["extract"] == "none":
+            assert_equal(0, result["bytes_per_frame"])
+        else:
+            assert_true(result["bytes_per_frame"] > 0)
+
+    by_name = {r["name"]: r for r in _report["results"]}
+    # 32bpc のビューは 16 バイト / 画素、read_pixels は 8bit RGBA
+    assert_equal(64 * 48 * 16, by_name["render_frame/BIT32/ds1/roi100/view"]["bytes_per_frame"])
+    assert_equal(64 * 48 * 4, by_name["render_frame/BIT32/ds1/roi100/read_pixels"]["bytes_per_frame"])
+
+
+@suite.test
+def test_json_output():
+    """Test that the written JSON matches the returned report"""
+    with open(os.path.join(_tmp_dir, "bench.json"), "r", encoding="utf-8") as f:
+        loaded = json.load(f)
+    assert_equal(benchmark_render.SCHEMA_VERSION, loaded["schema"])
+    assert_equal(_report["results"], loaded["results"])
+    assert_true("platform" in loaded["environment"])
+
+
+@suite.test
+def test_compare():
+    """Test regression detection between two results"""
+    same = benchmark_render.compare(_report, _report)
+    assert_equal([], same["regressions"])
+    assert_equal(len(_report["results"]), len(same["rows"]))
+
+    slower = copy.deepcopy(_report)
+    slower["results"][0]["median_ms"] *= 2.0
+    dropped = slower["results"].pop()
+    result = benchmark_render.compare(_report, slower, threshold=0.5)
+    assert_equal([_report["results"][0]["name"]], [r["name"] for r in result["regressions"]])
+    assert_equal([dropped["name"]], result["missing"])
+
+    other = dict(_report, schema=benchmark_render.SCHEMA_VERSION + 1)
+    assert_raises(ValueError, benchmark_render.compare, _report, other)
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,252 @@
+# test_render_cache.py
+# PyAE Render Cache Test
+#
+# RenderCache（タイムスタンプで検証するフレームキャッシュ）のテスト。
+
+import gc
+import os
+import shutil
+import tempfile
+import time
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_none,
+        assert_not_none,
+        assert_raises,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_none,
+        assert_not_none,
+        assert_raises,
+    )
+
+suite = TestSuite("Render Cache")
+
+WIDTH = 32
+HEIGHT = 24
+
+_test_comp = None
+_test_layer = None
+_cache_dir = None
+
+
+@suite.setup
+def setup():
+    """Setup a cache directory and a composition with a red solid"""
+    global _test_comp, _test_layer, _cache_dir
+    _cache_dir = tempfile.mkdtemp(prefix="pyae_render_cache_")
+    proj = ae.Project.get_current()
+    _test_comp = proj.create_comp("_RenderCacheTestComp", WIDTH, HEIGHT, 1.0, 1.0, 30.0)
+    _test_layer = _test_comp.add_solid("_RenderCacheTestSolid", WIDTH, HEIGHT, (1.0, 0.0, 0.0), 1.0)
+
+
+@suite.teardown
+def teardown():
+    """Cleanup test resources"""
+    global _test_comp, _test_layer, _cache_dir
+    _test_layer = None
+    if _test_comp:
+        try:
+            ae.sdk.AEGP_DeleteItem(_test_comp._handle)
+        except Exception as e:
+            print(f"Warning: Failed to delete test comp: {e}")
+        _test_comp = None
+    if _cache_dir:
+        shutil.rmtree(_cache_dir, ignore_errors=True)
+        _cache_dir = None
+
+
+@suite.test
+def test_hit_after_render():
+    """Test that the second request for the same frame is served from memory"""
+    cache = ae.RenderCache()
+    first = cache.fetch(_test_comp, 0.0)
+    assert_false(first.hit)
+    assert_equal(WIDTH, first.width)
+    assert_equal(HEIGHT, first.height)
+
+    second = cache.fetch(_test_comp, 0.0)
+    assert_true(second.hit)
+    assert_equal(bytes(first), bytes(second))
+
+    stats = cache.stats
+    assert_equal(1, stats["hits"])
+    assert_equal(1, stats["misses"])
+    assert_equal(1, stats["memory_entries"])
+    assert_true(stats["memory_bytes"] >= first.nbytes)
+
+
+@suite.test
+def test_render_returns_world():
+    """Test that render() returns a World with the cached pixels"""
+    cache = ae.RenderCache()
+    world = cache.render(_test_comp, 0.1)
+    assert_equal(WIDTH, world.width)
+    assert_equal(HEIGHT, world.height)
+    r, g, b, a = world.get_pixel(WIDTH // 2, HEIGHT // 2)
+    assert_true(r > 0.9 and g < 0.1 and b < 0.1)
+
+    again = cache.render(_test_comp, 0.1)
+    assert_equal(world.get_pixels(), again.get_pixels())
+    assert_equal(1, cache.stats["hits"])
+
+
+@suite.test
+def test_key_includes_options():
+    """Test that time and render options are part of the key"""
+    cache = ae.RenderCache()
+    cache.fetch(_test_comp, 0.0)
+    assert_none(cache.lookup(_test_comp, 0.5))
+
+    options = ae.RenderOptions.from_item(_test_comp._handle)
+    options.downsample_factor = (2, 2)
+    frame = cache.fetch(_test_comp, 0.0, options)
+    assert_false(frame.hit)
+    assert_true(frame.width <= WIDTH // 2 + 1)
+
+    options = ae.RenderOptions.from_item(_test_comp._handle)
+    options.world_type = ae.WorldType.BIT32
+    frame = cache.fetch(_test_comp, 0.0, options)
+    assert_false(frame.hit)
+    assert_equal(ae.WorldType.BIT32, frame.world_type)
+    assert_equal(3, cache.stats["memory_entries"])
+
+
+@suite.test
+def test_change_invalidates():
+    """Test that a change to the comp makes the cached frame stale"""
+    cache = ae.RenderCache()
+    cache.fetch(_test_comp, 0.0)
+    assert_not_none(cache.lookup(_test_comp, 0.0))
+
+    opacity = _test_layer.property("Opacity")
+    original = opacity.value
+    try:
+        opacity.value = 50.0
+        assert_none(cache.lookup(_test_comp, 0.0))
+        assert_equal(1, cache.stats["stale"])
+        assert_false(cache.fetch(_test_comp, 0.0).hit)
+    finally:
+        opacity.value = original
+
+
+def _cache_files():
+    """Cache files under _cache_dir (each cache uses its own subdirectory)"""
+    return [
+        os.path.join(root, f)
+        for root, _, names in os.walk(_cache_dir)
+        for f in names
+        if f.endswith(".pyaefc")
+    ]
+
+
+@suite.test
+def test_memory_limit_and_disk():
+    """Test LRU eviction by bytes and reading back from the disk tier"""
+    frame_bytes = WIDTH * HEIGHT * 4
+    cache = ae.RenderCache(max_memory_bytes=frame_bytes * 2 + 1024, directory=_cache_dir)
+    assert_equal(_cache_dir, cache.directory)
+    for t in (0.0, 0.1, 0.2, 0.3):
+        cache.fetch(_test_comp, t)
+
+    stats = cache.stats
+    assert_true(stats["memory_entries"] <= 2)
+    assert_true(stats["evictions"] >= 2)
+    assert_true(stats["memory_bytes"] <= stats["max_memory_bytes"])
+    assert_true(stats["disk_writes"] >= 2)
+    assert_equal(stats["disk_entries"], len(_cache_files()))
+
+    frame = cache.fetch(_test_comp, 0.0)
+    assert_true(frame.hit)
+    assert_equal(1, cache.stats["disk_hits"])
+
+    assert_true(cache.invalidate(_test_comp) >= 4)
+    assert_equal(0, cache.stats["memory_bytes"])
+    assert_equal(0, cache.stats["disk_bytes"])
+    assert_equal(0, len(_cache_files()))
+
+
+@suite.test
+def test_disk_directory_is_private():
+    """Test that a cache leaves other files alone and removes its own on destruction"""
+    foreign = os.path.join(_cache_dir, "foreign.pyaefc")
+    with open(foreign, "wb") as f:
+        f.write(b"not ours")
+    before = set(os.listdir(_cache_dir))
+
+    frame_bytes = WIDTH * HEIGHT * 4
+    cache = ae.RenderCache(max_memory_bytes=frame_bytes + 1024, directory=_cache_dir)
+    other = ae.RenderCache(max_memory_bytes=frame_bytes + 1024, directory=_cache_dir)
+    for t in (0.0, 0.1, 0.2):
+        cache.fetch(_test_comp, t)
+        other.fetch(_test_comp, t)
+    assert_true(os.path.exists(foreign))
+    assert_equal(len(before) + 2, len(os.listdir(_cache_dir)))
+
+    del cache, other
+    gc.collect()
+    assert_true(os.path.exists(foreign))
+    assert_equal(before, set(os.listdir(_cache_dir)))
+    os.remove(foreign)
+
+
+@suite.test
+def test_memoryview():
+    """Test the zero-copy buffer of a cached frame"""
+    cache = ae.RenderCache()
+    frame = cache.fetch(_test_comp, 0.0)
+    view = memoryview(frame)
+    assert_true(view.readonly)
+    assert_equal((HEIGHT, WIDTH, 4), view.shape)
+    assert_equal(frame.nbytes, view.nbytes)
+
+
+@suite.test
+def test_invalid_arguments():
+    """Test argument validation"""
+    cache = ae.RenderCache()
+    assert_raises(ValueError, cache.fetch, "not an item")
+    assert_equal(0, cache.invalidate())
+
+
+@suite.test
+def test_benchmark_repeated_preview():
+    """Benchmark: repeated requests are memory copies instead of renders"""
+    cache = ae.RenderCache()
+    count = 10
+
+    start = time.perf_counter()
+    for _ in range(count):
+        ae.Renderer.render_frame(ae.RenderOptions.from_item(_test_comp._handle)).checkin()
+    render_seconds = time.perf_counter() - start
+
+    cache.render(_test_comp, 0.0)
+    start = time.perf_counter()
+    for _ in range(count):
+        cache.render(_test_comp, 0.0)
+    cached_seconds = time.perf_counter() - start
+
+    assert_equal(count, cache.stats["hits"])
+    print(f"  render: {render_seconds / count * 1000:.2f} ms/frame, "
+          f"cached: {cached_seconds / count * 1000:.2f} ms/frame")
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,176 @@
+# test_render_future.py
+# PyAE Render Future Test
+#
+# render_frame_async / RenderFuture（アイドル処理での非同期レンダーと取り消し）のテスト。
+# テストはメインスレッドで動くため、result() がその場で待ち行列を進める。
+
+import concurrent.futures
+import time
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_raises,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_raises,
+    )
+
+suite = TestSuite("Render Future")
+
+WIDTH = 32
+HEIGHT = 24
+
+_test_comp = None
+
+
+@suite.setup
+def setup():
+    """Setup a composition with a red solid"""
+    global _test_comp
+    proj = ae.Project.get_current()
+    _test_comp = proj.create_comp("_RenderFutureTestComp", WIDTH, HEIGHT, 1.0, 1.0, 30.0)
+    _test_comp.add_solid("_RenderFutureTestSolid", WIDTH, HEIGHT, (1.0, 0.0, 0.0), 1.0)
+
+
+@suite.teardown
+def teardown():
+    """Cleanup test resources"""
+    global _test_comp
+    ae.cancel_async_renders()
+    if _test_comp:
+        try:
+            ae.sdk.AEGP_DeleteItem(_test_comp._handle)
+        except Exception as e:
+            print(f"Warning: Failed to delete test comp: {e}")
+        _test_comp = None
+
+
+@suite.test
+def test_result():
+    """Test that the future is pending until result() renders it"""
+    future = ae.render_frame_async(_test_comp, 0.5)
+    assert_equal("pending", future.state)
+    assert_false(future.done())
+    assert_true(abs(future.time - 0.5) < 1e-6)
+
+    receipt = future.result()
+    try:
+        assert_equal(WIDTH, receipt.world.width)
+        assert_equal(HEIGHT, receipt.world.height)
+    finally:
+        receipt.checkin()
+    assert_true(future.done())
+    assert_equal("done", future.state)
+    assert_true(future.render_seconds >= 0.0)
+
+
+@suite.test
+def test_release():
+    """Test that release() checks in the frame held by a finished future"""
+    future = ae.render_frame_async(_test_comp, 0.0)
+    assert_false(future.release())
+    receipt = future.result()
+    world = receipt.world
+    assert_true(future.release())
+    assert_false(receipt.valid)
+    assert_raises(RuntimeError, world.get_pixel, 0, 0)
+    assert_raises(RuntimeError, future.result)
+    assert_false(future.release())
+    assert_equal("done", future.state)
+
+
+@suite.test
+def test_cancel_pending():
+    """Test cancelling a request before it renders"""
+    future = ae.render_frame_async(_test_comp, 0.0)
+    assert_true(future.cancel())
+    assert_false(future.cancel())
+    assert_true(future.cancelled())
+    assert_raises(concurrent.futures.CancelledError, future.result)
+
+
+@suite.test
+def test_group_supersedes():
+    """Test that a newer request of the same group drops the older one"""
+    before = ae.get_async_render_stats()
+    old = ae.render_frame_async(_test_comp, 0.0, group="viewer")
+    other = ae.render_frame_async(_test_comp, 0.0, group="thumbnails")
+    new = ae.render_frame_async(_test_comp, 0.1, group="viewer")
+    assert_true(old.cancelled())
+    assert_false(other.done())
+    assert_equal("viewer", new.group)
+
+    new.result().checkin()
+    other.result().checkin()
+    after = ae.get_async_render_stats()
+    assert_equal(before["superseded"] + 1, after["superseded"])
+    assert_equal(before["completed"] + 2, after["completed"])
+
+
+@suite.test
+def test_timeout_expires():
+    """Test that a request past its timeout is dropped"""
+    future = ae.render_frame_async(_test_comp, 0.0, timeout=0.001)
+    time.sleep(0.01)
+    assert_raises(concurrent.futures.CancelledError, future.result)
+    assert_true(future.cancelled())
+
+
+@suite.test
+def test_options_are_copied():
+    """Test that the request keeps its own copy of the render options"""
+    options = ae.RenderOptions.from_item(_test_comp._handle)
+    options.time = 0.25
+    future = ae.render_frame_async(options, time=0.75)
+    assert_true(abs(options.time - 0.25) < 1e-6)
+    options.time = 0.5
+    assert_true(abs(future.time - 0.75) < 1e-6)
+    future.result().checkin()
+
+
+@suite.test
+def test_done_callback():
+    """Test that done callbacks wait for the idle hook"""
+    calls = []
+    future = ae.render_frame_async(_test_comp, 0.0, callback=calls.append)
+    future.add_done_callback(calls.append)
+    future.result().checkin()
+    # 通知はアイドル処理から行うので、result() の中では呼ばれない
+    assert_equal([], calls)
+
+
+@suite.test
+def test_cancel_all():
+    """Test cancel_async_renders"""
+    futures = [ae.render_frame_async(_test_comp, t, group="batch") for t in (0.0, 0.1)]
+    futures.append(ae.render_frame_async(_test_comp, 0.2))
+    assert_equal(1, ae.cancel_async_renders("batch"))
+    assert_equal(1, ae.cancel_async_renders())
+    assert_true(all(f.cancelled() for f in futures))
+
+
+@suite.test
+def test_invalid_arguments():
+    """Test argument validation"""
+    assert_raises(ValueError, ae.render_frame_async, "not an item")
+    assert_raises(ValueError, ae.render_frame_async, _test_comp, callback=42)
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,207 @@
+# test_render_options_pool.py
+# PyAE Render Options Pool Test
+#
+# RenderOptions.acquire / LayerRenderOptions.acquire（アイテム・レイヤーごとに
+# ハンドルを再利用するプール）のテスト。
+
+import gc
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_close,
+        assert_raises,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_close,
+        assert_raises,
+    )
+
+suite = TestSuite("Render Options Pool")
+
+_test_comp = None
+_test_layer = None
+
+
+@suite.setup
+def setup():
+    """Setup a composition with a solid"""
+    global _test_comp, _test_layer
+    proj = ae.Project.get_current()
+    _test_comp = proj.create_comp("_RenderOptionsPoolTestComp", 320, 180, 1.0, 5.0, 30.0)
+    _test_layer = _test_comp.add_solid("_RenderOptionsPoolTestSolid", 320, 180, (0.0, 0.0, 1.0), 5.0)
+    ae.RenderOptionsPool.clear()
+    ae.LayerRenderOptionsPool.clear()
+
+
+@suite.teardown
+def teardown():
+    """Cleanup test resources"""
+    global _test_comp, _test_layer
+    ae.RenderOptionsPool.clear()
+    ae.LayerRenderOptionsPool.clear()
+    _test_layer = None
+    if _test_comp:
+        try:
+            ae.sdk.AEGP_DeleteItem(_test_comp._handle)
+        except Exception as e:
+            print(f"Warning: Failed to delete test comp: {e}")
+        _test_comp = None
+
+
+@suite.test
+def test_acquire_reuses_handle():
+    """Test that a released handle is reused for the same item"""
+    ae.RenderOptionsPool.reset_stats()
+    options = ae.RenderOptions.acquire(_test_comp)
+    assert_true(options.pooled)
+    assert_false(ae.RenderOptions.from_item(_test_comp._handle).pooled)
+    del options
+    gc.collect()
+
+    stats = ae.RenderOptionsPool.stats()
+    assert_equal(1, stats["misses"])
+    assert_equal(1, stats["returned"])
+    assert_equal(1, stats["pooled"])
+
+    for _ in range(5):
+        options = ae.RenderOptions.acquire(_test_comp, time=1.0)
+        assert_close(1.0, options.time, 1e-6)
+        del options
+        gc.collect()
+    stats = ae.RenderOptionsPool.stats()
+    assert_equal(1, stats["misses"])
+    assert_equal(5, stats["hits"])
+    assert_equal(0, stats["live"])
+
+
+@suite.test
+def test_reused_handle_has_item_defaults():
+    """Test that changed fields are restored before reuse"""
+    fresh = ae.RenderOptions.from_item(_test_comp._handle)
+    options = ae.RenderOptions.acquire(_test_comp)
+    options.time = 2.0
+    options.world_type = ae.WorldType.BIT32
+    options.downsample_factor = (4, 4)
+    del options
+    gc.collect()
+
+    options = ae.RenderOptions.acquire(_test_comp)
+    assert_close(fresh.time, options.time, 1e-6)
+    assert_equal(fresh.world_type, options.world_type)
+    assert_equal(fresh.downsample_factor, options.downsample_factor)
+
+
+@suite.test
+def test_reset_in_place():
+    """Test that one options object can be mutated and reset in a loop"""
+    fresh = ae.RenderOptions.from_item(_test_comp._handle)
+    options = ae.RenderOptions.acquire(_test_comp)
+    for frame in range(3):
+        options.time = frame / 30.0
+        assert_close(frame / 30.0, options.time, 1e-6)
+    options.render_quality = ae.RenderQuality.DRAFT
+    options.reset()
+    assert_close(fresh.time, options.time, 1e-6)
+    assert_equal(fresh.render_quality, options.render_quality)
+
+    assert_raises(RuntimeError, fresh.reset)
+
+
+@suite.test
+def test_defaults_follow_item_changes():
+    """Test that pooled defaults are taken again after the item or project changes"""
+    proj = ae.Project.get_current()
+    original_time = _test_comp.current_time
+    original_depth = proj.bit_depth
+    try:
+        options = ae.RenderOptions.acquire(_test_comp)
+        del options
+        gc.collect()
+        ae.RenderOptionsPool.reset_stats()
+
+        _test_comp.current_time = 2.0
+        options = ae.RenderOptions.acquire(_test_comp)
+        assert_close(2.0, options.time, 1e-6)
+        assert_equal(1, ae.RenderOptionsPool.stats()["refreshes"])
+        del options
+        gc.collect()
+
+        proj.bit_depth = 16 if original_depth != 16 else 8
+        fresh = ae.RenderOptions.from_item(_test_comp._handle)
+        options = ae.RenderOptions.acquire(_test_comp)
+        assert_equal(fresh.world_type, options.world_type)
+        assert_equal(2, ae.RenderOptionsPool.stats()["refreshes"])
+        del options
+        gc.collect()
+
+        # 変更がなければ取り直さない
+        options = ae.RenderOptions.acquire(_test_comp)
+        assert_equal(2, ae.RenderOptionsPool.stats()["refreshes"])
+        assert_equal(1, ae.RenderOptionsPool.stats()["hits"])
+    finally:
+        proj.bit_depth = original_depth
+        _test_comp.current_time = original_time
+
+
+@suite.test
+def test_max_idle_and_disable():
+    """Test the per-item limit and disabling the pool"""
+    ae.RenderOptionsPool.clear()
+    ae.RenderOptionsPool.set_max_idle(1)
+    try:
+        first = ae.RenderOptions.acquire(_test_comp)
+        second = ae.RenderOptions.acquire(_test_comp)
+        del first, second
+        gc.collect()
+        assert_equal(1, ae.RenderOptionsPool.stats()["pooled"])
+
+        ae.RenderOptionsPool.set_enabled(False)
+        assert_equal(0, ae.RenderOptionsPool.stats()["pooled"])
+        options = ae.RenderOptions.acquire(_test_comp)
+        del options
+        gc.collect()
+        assert_equal(0, ae.RenderOptionsPool.stats()["pooled"])
+    finally:
+        ae.RenderOptionsPool.set_enabled(True)
+        ae.RenderOptionsPool.set_max_idle(4)
+
+
+@suite.test
+def test_layer_options_pool():
+    """Test acquiring layer render options"""
+    ae.LayerRenderOptionsPool.reset_stats()
+    fresh = ae.LayerRenderOptions.from_layer(_test_layer._handle)
+    options = ae.LayerRenderOptions.acquire(_test_layer)
+    assert_true(options.pooled)
+    options.time = 3.0
+    options.matte_mode = ae.MatteMode.PREMUL_BLACK
+    del options
+    gc.collect()
+
+    options = ae.LayerRenderOptions.acquire(_test_layer._handle)
+    assert_close(fresh.time, options.time, 1e-6)
+    assert_equal(fresh.matte_mode, options.matte_mode)
+    stats = ae.LayerRenderOptionsPool.stats()
+    assert_equal(1, stats["hits"])
+    assert_equal(1, stats["layers"])
+    assert_raises(ValueError, ae.LayerRenderOptions.acquire, "not a layer")
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,198 @@
+# test_render_sequence.py
+# PyAE Render Sequence Test
+#
+# RenderSequence（フレーム範囲のレンダーとワーカースレッドのコンシューマー）のテスト。
+
+import os
+import shutil
+import tempfile
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_equal,
+        assert_raises,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_equal,
+        assert_raises,
+    )
+
+suite = TestSuite("Render Sequence")
+
+WIDTH = 32
+HEIGHT = 24
+FPS = 30.0
+
+_test_comp = None
+_output_dir = None
+
+
+def _path(name):
+    return os.path.join(_output_dir, name)
+
+
+def _close(a, b, tolerance=1e-3):
+    return abs(a - b) <= tolerance
+
+
+@suite.setup
+def setup():
+    """Setup an output directory and a 1 second composition with a red solid"""
+    global _test_comp, _output_dir
+    _output_dir = tempfile.mkdtemp(prefix="pyae_render_sequence_")
+    proj = ae.Project.get_current()
+    _test_comp = proj.create_comp("_RenderSequenceTestComp", WIDTH, HEIGHT, 1.0, 1.0, FPS)
+    _test_comp.add_solid("_RenderSequenceTestSolid", WIDTH, HEIGHT, (1.0, 0.0, 0.0), 1.0)
+
+
+@suite.teardown
+def teardown():
+    """Cleanup test resources"""
+    global _test_comp, _output_dir
+    if _test_comp:
+        try:
+            ae.sdk.AEGP_DeleteItem(_test_comp._handle)
+        except Exception as e:
+            print(f"Warning: Failed to delete test comp: {e}")
+        _test_comp = None
+    if _output_dir:
+        shutil.rmtree(_output_dir, ignore_errors=True)
+        _output_dir = None
+
+
+@suite.test
+def test_time_range():
+    """Test the frame times for the default and an explicit range"""
+    seq = ae.RenderSequence(_test_comp)
+    assert_equal(30, len(seq))
+    assert_true(_close(1.0 / FPS, seq.frame_duration, 1e-6))
+    assert_equal(0, seq.rendered)
+    assert_true(seq.result is None)
+
+    seq = ae.RenderSequence(_test_comp, start=0.5, end=0.7)
+    assert_equal(6, len(seq))
+    assert_true(_close(0.5, seq.times[0], 1e-6))
+
+    seq = ae.RenderSequence(_test_comp, end=1.0, step=0.25)
+    assert_equal([0.0, 0.25, 0.5, 0.75], seq.times)
+
+
+@suite.test
+def test_run_with_writer_and_stats():
+    """Test rendering to files and collecting per-frame statistics"""
+    seq = ae.RenderSequence(_test_comp, end=0.2, max_in_flight=2)
+    assert_true(seq.add_writer(_path("shot_####.png")) is seq)
+    seq.add_stats()
+
+    progress = []
+    result = seq.run(progress=lambda done, total: progress.append((done, total)))
+    assert_equal(6, result["frames"])
+    assert_equal([(i, 6) for i in range(1, 7)], progress)
+    assert_true(result["fps"] > 0.0)
+    assert_true(result["render_seconds"] > 0.0)
+    assert_true(1 <= result["peak_in_flight"] <= 2)
+    assert_true(seq.result is not None)
+
+    names = [c["name"] for c in result["consumers"]]
+    assert_equal(["file:png", "stats"], names)
+    for consumer in result["consumers"]:
+        assert_equal(6, consumer["frames"])
+        assert_true(consumer["error"] is None)
+
+    for frame in range(6):
+        assert_true(os.path.exists(_path(f"shot_{frame:04d}.png")))
+
+    stats = result["stats"]
+    assert_equal(list(range(6)), [f["frame"] for f in stats])
+    for f in stats:
+        assert_true(_close(1.0, f["mean"][0], 1.0 / 255), f"mean {f['mean']}")
+        assert_true(_close(0.0, f["mean"][1], 1.0 / 255))
+        assert_true(_close(1.0, f["mean"][3], 1.0 / 255))
+
+
+@suite.test
+def test_sub_frame_step_numbers_are_unique():
+    """Test that a step shorter than a frame still numbers every frame"""
+    seq = ae.RenderSequence(_test_comp, end=0.1, step=0.5 / 30.0)
+    seq.add_writer(_path("half_####.png")).add_stats(histogram=False)
+    result = seq.run()
+    assert_equal(6, result["frames"])
+    assert_equal(list(range(6)), [f["frame"] for f in result["stats"]])
+    for frame in range(6):
+        assert_true(os.path.exists(_path(f"half_{frame:04d}.png")))
+
+
+@suite.test
+def test_iterate_frames():
+    """Test iterating (time, World) while a writer runs in the background"""
+    seq = ae.RenderSequence(_test_comp, start=0.1, end=0.2, world_type=ae.WorldType.BIT32)
+    seq.add_writer(_path("iter.exr"))
+    times = []
+    for time, world in seq:
+        times.append(time)
+        assert_equal((WIDTH, HEIGHT), world.size)
+        assert_equal(ae.WorldType.BIT32, world.type)
+        r, g, b, a = world.get_pixel(WIDTH // 2, HEIGHT // 2)
+        assert_true(_close(1.0, r) and _close(0.0, g) and _close(1.0, a))
+    assert_equal(3, len(times))
+    assert_equal(3, seq.result["frames"])
+    for frame in (3, 4, 5):
+        assert_true(os.path.exists(_path(f"iter_{frame:04d}.exr")))
+
+
+@suite.test
+def test_consumer_failure():
+    """Test that a failing consumer raises after the render but keeps the result"""
+    seq = ae.RenderSequence(_test_comp, end=0.1)
+    seq.add_writer(os.path.join(_output_dir, "missing", "f_##.png"))
+    seq.add_stats()
+    assert_raises(RuntimeError, seq.run)
+    result = seq.result
+    assert_equal(3, result["frames"])
+    assert_true(result["consumers"][0]["error"] is not None)
+    assert_equal(3, result["consumers"][1]["frames"])
+
+
+@suite.test
+def test_invalid_arguments():
+    """Test range, step and state checks"""
+    assert_raises(ValueError, ae.RenderSequence, _test_comp, step=0.0)
+    assert_raises(ValueError, ae.RenderSequence, _test_comp, start=0.5, end=0.5)
+    assert_raises(ValueError, ae.RenderSequence, _test_comp, max_in_flight=0)
+    assert_raises(ValueError, ae.RenderSequence, "not an item")
+
+    seq = ae.RenderSequence(_test_comp, end=0.1)
+    assert_raises(ValueError, seq.add_writer, _path("frame.bmp"))
+    assert_raises(ValueError, seq.add_stats, bins=0)
+    seq.run()
+    assert_raises(RuntimeError, seq.run)
+    assert_raises(RuntimeError, seq.add_stats)
+
+
+@suite.test
+def test_benchmark_fps():
+    """Report frames per second with and without background consumers"""
+    plain = ae.RenderSequence(_test_comp).run()
+    piped = ae.RenderSequence(_test_comp, max_in_flight=4) \
+        .add_writer(_path("bench_####.tif")).add_stats().run()
+    assert_equal(30, plain["frames"])
+    assert_equal(30, piped["frames"])
+    print(f"    render only: {plain['fps']:.1f} fps, "
+          f"with writer + stats: {piped['fps']:.1f} fps "
+          f"(render {piped['render_seconds']:.3f}s, wait {piped['wait_seconds']:.3f}s)")
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
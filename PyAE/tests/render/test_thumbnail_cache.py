@@ -0,0 +1,212 @@
+# test_thumbnail_cache.py
+# PyAE Thumbnail Cache Test
+#
+# ThumbnailCache（アイドル処理で作り、圧縮してディスクに置くアイテムの
+# サムネイル）のテスト。
+
+import os
+import shutil
+import tempfile
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_none,
+        assert_not_none,
+        assert_raises,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_false,
+        assert_equal,
+        assert_none,
+        assert_not_none,
+        assert_raises,
+    )
+
+suite = TestSuite("Thumbnail Cache")
+
+WIDTH = 320
+HEIGHT = 180
+SIZE = 64
+
+_test_comp = None
+_test_layer = None
+_tmp_dir = None
+
+
+@suite.setup
+def setup():
+    """Setup a composition with a red solid and a cache directory"""
+    global _test_comp, _test_layer, _tmp_dir
+    proj = ae.Project.get_current()
+    _test_comp = proj.create_comp("_ThumbnailCacheTestComp", WIDTH, HEIGHT, 1.0, 1.0, 30.0)
+    _test_layer = _test_comp.add_solid("_ThumbnailCacheTestSolid", WIDTH, HEIGHT, (1.0, 0.0, 0.0), 1.0)
+    _tmp_dir = tempfile.mkdtemp(prefix="pyae_thumbs_")
+
+
+@suite.teardown
+def teardown():
+    """Cleanup test resources"""
+    global _test_comp, _test_layer, _tmp_dir
+    _test_layer = None
+    if _test_comp:
+        try:
+            ae.sdk.AEGP_DeleteItem(_test_comp._handle)
+        except Exception as e:
+            print(f"Warning: Failed to delete test comp: {e}")
+        _test_comp = None
+    if _tmp_dir:
+        shutil.rmtree(_tmp_dir, ignore_errors=True)
+        _tmp_dir = None
+
+
+@suite.test
+def test_get_queues_missing_item():
+    """Test that get() returns None for a new item and queues it"""
+    cache = ae.ThumbnailCache(size=SIZE, directory="")
+    assert_none(cache.get(_test_comp))
+    assert_equal(1, cache.pending)
+    assert_none(cache.get(_test_comp))
+    assert_equal(1, cache.pending)
+
+    assert_equal(1, cache.process())
+    assert_equal(0, cache.pending)
+    thumb = cache.get(_test_comp)
+    assert_not_none(thumb)
+    assert_false(thumb.stale)
+
+
+@suite.test
+def test_thumbnail_pixels():
+    """Test the size and RGBA pixels of a thumbnail"""
+    cache = ae.ThumbnailCache(size=SIZE, directory="")
+    thumb = cache.get(_test_comp, wait=True)
+    # 320x180 を 64 に収める
+    assert_equal(SIZE, thumb.width)
+    assert_equal(36, thumb.height)
+    assert_equal(SIZE * 36 * 4, thumb.nbytes)
+
+    view = memoryview(thumb)
+    assert_equal((36, SIZE, 4), view.shape)
+    assert_true(view.readonly)
+    r, g, b, a = view[18, 32].tolist()
+    assert_true(r > 240 and g < 16 and b < 16 and a > 240)
+
+    data = thumb.to_bytes()
+    assert_equal(thumb.nbytes, len(data))
+    assert_equal(bytes(view[0, 0]), data[:4])
+
+
+@suite.test
+def test_unchanged_item_is_not_regenerated():
+    """Test that a valid thumbnail is served without rendering"""
+    cache = ae.ThumbnailCache(size=SIZE, directory="")
+    cache.get(_test_comp, wait=True)
+    generated = cache.stats["generated"]
+    for _ in range(3):
+        thumb = cache.get(_test_comp)
+        assert_false(thumb.stale)
+    assert_equal(generated, cache.stats["generated"])
+    assert_equal(0, cache.pending)
+
+
+@suite.test
+def test_changed_item_is_stale():
+    """Test that a changed item returns the old thumbnail and is regenerated"""
+    cache = ae.ThumbnailCache(size=SIZE, directory="")
+    cache.get(_test_comp, wait=True)
+
+    original = _test_layer.opacity
+    try:
+        _test_layer.opacity = 0.0
+        thumb = cache.get(_test_comp)
+        assert_true(thumb.stale)
+        assert_equal(1, cache.pending)
+        cache.process()
+        fresh = cache.get(_test_comp)
+        assert_false(fresh.stale)
+        assert_true(memoryview(fresh)[18, 32].tolist()[3] < 16)
+    finally:
+        _test_layer.opacity = original
+
+
+@suite.test
+def test_request_callbacks():
+    """Test that request() callbacks receive the generated thumbnail"""
+    cache = ae.ThumbnailCache(size=SIZE, directory="")
+    received = []
+    assert_equal(1, cache.request([_test_comp], lambda item_id, thumb: received.append((item_id, thumb))))
+    assert_equal([], received)
+    cache.process()
+    assert_equal(1, len(received))
+    assert_equal(received[0][0], received[0][1].item_id)
+
+    # 有効なサムネイルはすぐ呼ばれる
+    assert_equal(0, cache.request([_test_comp], lambda item_id, thumb: received.append((item_id, thumb))))
+    assert_equal(2, len(received))
+
+
+@suite.test
+def test_disk_store():
+    """Test that thumbnails are written compressed and read back"""
+    cache = ae.ThumbnailCache(size=SIZE, directory=_tmp_dir)
+    cache.get(_test_comp, wait=True)
+    stats = cache.stats
+    if cache.directory is None:
+        # 未保存のプロジェクトはメモリだけ
+        assert_equal(0, stats["disk_entries"])
+        return
+    assert_true(cache.directory.startswith(_tmp_dir))
+    assert_equal(1, stats["disk_entries"])
+    assert_true(0.0 < stats["compression_ratio"] < 0.5)
+    assert_true(any(name.endswith(".pyaeth") for name in os.listdir(cache.directory)))
+
+    # 別のキャッシュ（同じセッション）でもディスクから使える
+    other = ae.ThumbnailCache(size=SIZE, directory=_tmp_dir, max_memory_bytes=1 << 20)
+    thumb = other.get(_test_comp)
+    assert_not_none(thumb)
+    assert_false(thumb.stale)
+    assert_equal(1, other.stats["disk_hits"])
+    assert_equal(0, other.stats["generated"])
+
+
+@suite.test
+def test_invalidate_and_clear():
+    """Test dropping thumbnails"""
+    cache = ae.ThumbnailCache(size=SIZE, directory="")
+    cache.get(_test_comp, wait=True)
+    assert_equal(1, cache.invalidate(_test_comp))
+    assert_none(cache.get(_test_comp))
+    assert_equal(1, cache.pending)
+    cache.clear()
+    assert_equal(0, cache.pending)
+    assert_equal(0, cache.stats["memory_entries"])
+
+
+@suite.test
+def test_invalid_arguments():
+    """Test argument validation"""
+    assert_raises(ValueError, ae.ThumbnailCache, size=0)
+    assert_raises(ValueError, ae.ThumbnailCache, budget_ms=0.0)
+    cache = ae.ThumbnailCache(size=SIZE, directory="")
+    assert_raises(ValueError, cache.get, "not an item")
+    assert_raises(ValueError, cache.request, [_test_comp], callback=42)
+    cache.budget_ms = 5.0
+    assert_equal(5.0, cache.budget_ms)
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
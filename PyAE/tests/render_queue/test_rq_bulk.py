@@ -0,0 +1,160 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# tests/render_queue/test_rq_bulk.py
+
+"""
+render_queue.add_comps（一括追加）のテスト
+
+テスト対象:
+- エントリの形（コンポ / タプル / dict）
+- 出力パスの設定
+- エントリごとのエラー（失敗したエントリは追加されない）
+- テンプレート名のキャッシュ
+"""
+
+import os
+import tempfile
+
+import ae
+
+try:
+    from ..test_utils import TestSuite, assert_true, assert_equal, assert_none, assert_not_none
+except ImportError:
+    from test_utils import TestSuite, assert_true, assert_equal, assert_none, assert_not_none
+
+# =============================================================================
+# グローバル変数
+# =============================================================================
+
+suite = TestSuite("RQ Bulk Add")
+
+COMP_COUNT = 3
+
+_test_comps = []
+
+# =============================================================================
+# セットアップ
+# =============================================================================
+
+@suite.setup
+def setup():
+    """テスト環境のセットアップ"""
+    global _test_comps
+    proj = ae.Project.get_current()
+    _test_comps = [
+        proj.create_comp(f"RQBulkTest_Comp{i}", 320, 180, 1.0, 1.0, 30.0)
+        for i in range(COMP_COUNT)
+    ]
+
+@suite.teardown
+def teardown():
+    """テスト環境のクリーンアップ"""
+    global _test_comps
+    # コンポジションを削除すると、関連するRQアイテムも自動削除される
+    for comp in _test_comps:
+        comp.delete()
+    _test_comps = []
+
+# =============================================================================
+# Tests
+# =============================================================================
+
+@suite.test
+def test_add_entry_forms():
+    """コンポ・タプル・dict のエントリを追加"""
+    before = ae.render_queue.num_items()
+    results = ae.render_queue.add_comps([
+        _test_comps[0],
+        (_test_comps[1],),
+        {"comp": _test_comps[2]},
+    ])
+    assert_equal(COMP_COUNT, len(results))
+    assert_equal(before + COMP_COUNT, ae.render_queue.num_items())
+    for comp, result in zip(_test_comps, results):
+        assert_none(result["error"])
+        assert_not_none(result["item"])
+        assert_equal(comp.name, result["item"].comp_name)
+
+@suite.test
+def test_output_paths():
+    """出力パスの設定"""
+    out_dir = tempfile.gettempdir()
+    entries = [
+        (comp, None, None, os.path.join(out_dir, f"rq_bulk_{i}.mov"))
+        for i, comp in enumerate(_test_comps)
+    ]
+    results = ae.render_queue.add_comps(entries)
+    for i, result in enumerate(results):
+        assert_none(result["error"])
+        path = result["item"].output_module(0).file_path
+        assert_true(f"rq_bulk_{i}" in path, path)
+
+@suite.test
+def test_per_entry_errors():
+    """失敗したエントリは追加されず、ほかのエントリは続く"""
+    before = ae.render_queue.num_items()
+    results = ae.render_queue.add_comps([
+        _test_comps[0],
+        "not a comp",
+        (_test_comps[1], 42),
+        {"render_template": "Best Settings"},
+        (_test_comps[2], "_No Such Template_"),
+    ])
+    assert_equal(5, len(results))
+    assert_none(results[0]["error"])
+    for result in results[1:]:
+        assert_none(result["item"])
+        assert_true(isinstance(result["error"], str) and result["error"], result["error"])
+    assert_equal(before + 1, ae.render_queue.num_items())
+    # 後ろのアイテムが消えても前のアイテムは有効
+    assert_equal(_test_comps[0].name, results[0]["item"].comp_name)
+
+@suite.test
+def test_templates_cached():
+    """テンプレート名のキャッシュと適用"""
+    ae.render_queue.add_comp(_test_comps[0])
+    names = ae.render_queue.render_settings_templates(refresh=True)
+    assert_true(isinstance(names, list))
+    assert_equal(names, ae.render_queue.render_settings_templates())
+    om_names = ae.render_queue.output_module_templates()
+    assert_true(isinstance(om_names, list))
+    if not names or not om_names:
+        return
+
+    results = ae.render_queue.add_comps([(_test_comps[1], names[0], om_names[0])])
+    assert_none(results[0]["error"])
+    assert_not_none(results[0]["item"])
+
+@suite.test
+def test_templates_applied_to_every_entry():
+    """複数のエントリにテンプレートを適用（最後のエントリも成功する）"""
+    names = ae.render_queue.render_settings_templates()
+    om_names = ae.render_queue.output_module_templates()
+    if not names or not om_names:
+        return
+
+    before = ae.render_queue.num_items()
+    results = ae.render_queue.add_comps([
+        (comp, names[0], om_names[0]) for comp in _test_comps
+    ])
+    assert_equal(COMP_COUNT, len(results))
+    for comp, result in zip(_test_comps, results):
+        assert_none(result["error"])
+        assert_not_none(result["item"])
+        assert_equal(comp.name, result["item"].comp_name)
+    assert_equal(before + COMP_COUNT, ae.render_queue.num_items())
+
+@suite.test
+def test_empty_entries():
+    """空のリスト"""
+    before = ae.render_queue.num_items()
+    assert_equal([], ae.render_queue.add_comps([]))
+    assert_equal(before, ae.render_queue.num_items())
+
+# =============================================================================
+# テスト実行
+# =============================================================================
+
+def run():
+    """すべてのテストを実行"""
+    return suite.run()
@@ -0,0 +1,209 @@
+# test_native_import.py
+# PyAE Native Import Test
+# Tests ae.serialize.project_from_dict (C++ batched import) round-trip against the native export
+
+import json
+import time
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_equal,
+        assert_not_none,
+        assert_in,
+        assert_raises,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_equal,
+        assert_not_none,
+        assert_in,
+        assert_raises,
+    )
+
+suite = TestSuite("Native Import")
+
+SOURCE_NAME = "_NativeImportSource"
+FOLDER_NAME = "_NativeImportFolder"
+NUM_KEYFRAMES = 60
+
+_source_comp = None
+_source_data = None
+
+
+def _delete_items(names):
+    """Delete project items with the given names (comps before folders)"""
+    proj = ae.Project.get_current()
+    for kind in (ae.ItemType.Comp, ae.ItemType.Folder):
+        for item in list(proj.items):
+            if item.name in names and item.type == kind:
+                try:
+                    item.delete()
+                except Exception:
+                    pass
+
+
+def _project_data(comp_name):
+    """Build a project_to_dict() structure with one folder and the source comp"""
+    comp_data = json.loads(ae.serialize.comp_to_json(_source_comp))
+    comp_data["name"] = comp_name
+    return {
+        "version": 1,
+        "items": [
+            {"name": FOLDER_NAME, "type": "Folder", "id": 900001},
+            {"name": comp_name, "type": "Comp", "id": 900002,
+             "parent_folder_id": 900001, "comp_data": comp_data},
+        ],
+    }
+
+
+def _find_property(tree, match_name):
+    """Depth-first search of an exported property tree by match_name"""
+    for node in tree.values():
+        if node.get("match_name") == match_name:
+            return node
+        found = _find_property(node.get("children", {}), match_name)
+        if found is not None:
+            return found
+    return None
+
+
+@suite.setup
+def setup():
+    """Create a source comp with keyframes, an effect and a parented null"""
+    global _source_comp, _source_data
+    proj = ae.Project.get_current()
+    _source_comp = proj.create_comp(SOURCE_NAME, 640, 360, 1.0, 5.0, 24.0)
+
+    solid = _source_comp.add_solid("_ImportSolid", 200, 100, (0.0, 0.5, 1.0), 5.0)
+    position = solid.get_property("ADBE Position")
+    opacity = solid.get_property("ADBE Opacity")
+    for i in range(NUM_KEYFRAMES):
+        t = i * 5.0 / NUM_KEYFRAMES
+        position.add_keyframe(t, [i * 4.0, 180.0])
+        opacity.add_keyframe(t, float(i % 100))
+    position.set_keyframe_interpolation(0, "hold", "hold")
+    solid.add_effect("ADBE Gaussian Blur 2")
+
+    null = _source_comp.add_null("_ImportNull", 5.0)
+    solid.parent = null
+
+    _source_data = json.loads(ae.serialize.comp_to_json(_source_comp))
+
+
+@suite.teardown
+def teardown():
+    """Remove the source comp and any imported items"""
+    _delete_items({SOURCE_NAME, "_NativeImportCopy", "_NativeImportBench", FOLDER_NAME})
+
+
+@suite.test
+def test_function_exists():
+    """Test that the native importer is exposed"""
+    assert_true(hasattr(ae.serialize, "project_from_dict"),
+                "ae.serialize should have 'project_from_dict'")
+
+
+@suite.test
+def test_import_creates_items():
+    """Test that folders and comps are created and returned by JSON ID"""
+    items = ae.serialize.project_from_dict(_project_data("_NativeImportCopy"))
+    assert_in(900001, items)
+    assert_in(900002, items)
+
+    folder = items[900001]
+    comp = items[900002]
+    assert_equal(FOLDER_NAME, folder.name)
+    assert_equal("_NativeImportCopy", comp.name)
+    assert_equal(folder.id, comp.parent_folder.id)
+    assert_equal(640, comp.width)
+    assert_equal(len(_source_data["layers"]), comp.num_layers)
+
+
+@suite.test
+def test_import_round_trips_layers():
+    """Test that the re-exported comp matches the source (keyframes, effects, parent)"""
+    comp = None
+    for item in ae.Project.get_current().items:
+        if item.name == "_NativeImportCopy" and item.type == ae.ItemType.Comp:
+            comp = item
+    assert_not_none(comp, "Imported comp should exist")
+
+    imported = json.loads(ae.serialize.comp_to_json(comp))
+    for src, dst in zip(_source_data["layers"], imported["layers"]):
+        assert_equal(src["name"], dst["name"])
+        assert_equal(src["type"], dst["type"])
+        assert_equal(src.get("parent_index"), dst.get("parent_index"))
+        assert_equal([e["match_name"] for e in src["effects"]],
+                     [e["match_name"] for e in dst["effects"]])
+
+    solid_src = _source_data["layers"][-1]
+    solid_dst = imported["layers"][-1]
+    for match_name in ("ADBE Position", "ADBE Opacity"):
+        src_prop = _find_property(solid_src["properties"], match_name)
+        dst_prop = _find_property(solid_dst["properties"], match_name)
+        assert_equal(NUM_KEYFRAMES, dst_prop["num_keys"])
+        assert_equal(src_prop["keyframes"], dst_prop["keyframes"])
+
+
+@suite.test
+def test_progress_must_be_callable():
+    """Test that a non-callable progress argument is rejected"""
+    assert_raises(TypeError, ae.serialize.project_from_dict, {"items": []}, 1)
+
+
+@suite.test
+def test_progress_reported_during_import():
+    """Test that progress is reported for every created item and layer"""
+    calls = []
+    ae.serialize.project_from_dict(_project_data("_NativeImportCopy"),
+                                   lambda phase, done, total: calls.append((phase, done, total)))
+    assert_true(len(calls) >= 1 + len(_source_data["layers"]))
+    total = calls[0][2]
+    assert_equal(list(range(1, len(calls) + 1)), [done for _, done, _ in calls])
+    assert_true(all(t == total for _, _, t in calls))
+    assert_equal(total, calls[-1][1])
+    assert_equal("layers", calls[-1][0])
+
+
+@suite.test
+def test_empty_import():
+    """Test that importing an empty project returns an empty mapping"""
+    assert_equal({}, ae.serialize.project_from_dict({"version": 1, "items": []}, lambda *a: None))
+
+
+@suite.test
+def test_benchmark_against_python_import():
+    """Compare the native import time with the Python from_dict path"""
+    import ae_serialize
+
+    data = _project_data("_NativeImportBench")
+
+    start = time.perf_counter()
+    ae.serialize.project_from_dict(data)
+    native_time = time.perf_counter() - start
+    _delete_items({"_NativeImportBench", FOLDER_NAME})
+
+    context = ae_serialize.SerializationContext()
+    context.register(-1, None)  # pre-registered context forces the Python path
+    start = time.perf_counter()
+    ae_serialize.project_from_dict(data, context)
+    python_time = time.perf_counter() - start
+    _delete_items({"_NativeImportBench", FOLDER_NAME})
+
+    print(f"  Native: {native_time * 1000:8.2f} ms  Python: {python_time * 1000:8.2f} ms")
+    assert_true(native_time > 0.0)
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,246 @@
+# test_native_serializer.py
+# PyAE Native Serializer Test
+# Tests ae.serialize (C++ JSON export) against the Python export_scene traversal
+
+import json
+import os
+import tempfile
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_equal,
+        assert_not_none,
+        assert_isinstance,
+        assert_in,
+        assert_none,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_equal,
+        assert_not_none,
+        assert_isinstance,
+        assert_in,
+        assert_none,
+    )
+
+suite = TestSuite("Native Serializer")
+
+_test_comp = None
+_test_layer = None
+_temp_path = None
+
+
+@suite.setup
+def setup():
+    """Create a comp with a keyframed solid and an effect"""
+    global _test_comp, _test_layer, _temp_path
+    proj = ae.Project.get_current()
+    _test_comp = proj.create_comp("_NativeSerializeComp", 640, 360, 1.0, 5.0, 24.0)
+    _test_layer = _test_comp.add_solid("_NativeSolid", 100, 100, (0.0, 1.0, 0.0), 5.0)
+
+    position = _test_layer.get_property("ADBE Position")
+    position.add_keyframe(0.0, [100, 100])
+    position.add_keyframe(2.0, [500, 200])
+    _test_layer.add_effect("ADBE Gaussian Blur 2")
+
+    # 100x100 はヌル判定されるため、幅・高さ・平面色の出力用に別サイズの平面を追加
+    _test_comp.add_solid("_NativeWideSolid", 320, 180, (1.0, 0.5, 0.25), 5.0)
+    text_layer = _test_comp.add_text("Native Text")
+    text_layer.name = "_NativeText"
+    source_text = text_layer.properties.property("ADBE Text Properties").property("ADBE Text Document")
+    if source_text.can_have_expression:
+        source_text.expression = '"Native " + Math.floor(time)'
+
+    fd, _temp_path = tempfile.mkstemp(suffix=".json")
+    os.close(fd)
+
+
+@suite.teardown
+def teardown():
+    """Remove the test comp and temp file"""
+    try:
+        for item in ae.Project.get_current().items:
+            if item.name == "_NativeSerializeComp":
+                item.delete()
+                break
+    except Exception:
+        pass
+    if _temp_path and os.path.exists(_temp_path):
+        os.remove(_temp_path)
+
+
+def _find_property(tree, match_name):
+    """Depth-first search of an exported property tree by match_name"""
+    for node in tree.values():
+        if node.get("match_name") == match_name:
+            return node
+        found = _find_property(node.get("children", {}), match_name)
+        if found is not None:
+            return found
+    return None
+
+
+# =============================================================
+# Module Tests
+# =============================================================
+
+@suite.test
+def test_module_exists():
+    """Test that ae.serialize is available"""
+    assert_true(hasattr(ae, "serialize"), "ae should have 'serialize' module")
+    assert_true(hasattr(ae.serialize, "project_to_json"))
+    assert_true(hasattr(ae.serialize, "comp_to_json"))
+    assert_true(hasattr(ae.serialize, "layer_to_json"))
+
+
+# =============================================================
+# Comp / Layer Tests
+# =============================================================
+
+def _assert_same_document(python, native, path):
+    """Compare an export_scene dict with native output (keys and scalar values)"""
+    assert_equal(sorted(python.keys()), sorted(native.keys()), f"{path} keys should match")
+    for key, value in python.items():
+        if key in ("properties", "effects", "text_animators", "layers"):
+            continue
+        if isinstance(value, float):
+            assert_true(abs(value - native[key]) < 1e-6, f"{path}.{key} should match")
+        elif isinstance(value, list) and value and isinstance(value[0], float):
+            assert_equal(len(value), len(native[key]), f"{path}.{key} should match")
+            for a, b in zip(value, native[key]):
+                assert_true(abs(a - b) < 1e-6, f"{path}.{key} should match")
+        else:
+            assert_equal(value, native[key], f"{path}.{key} should match")
+
+
+@suite.test
+def test_comp_to_json_matches_python_export():
+    """Test that native comp output matches export_scene.export_comp"""
+    from export_scene import export_comp
+
+    native = json.loads(ae.serialize.comp_to_json(_test_comp))
+    python = export_comp(_test_comp)
+
+    _assert_same_document(python, native, "comp")
+    assert_equal(len(python["layers"]), len(native["layers"]))
+    for py_layer, native_layer in zip(python["layers"], native["layers"]):
+        path = f"layers[{py_layer['name']}]"
+        _assert_same_document(py_layer, native_layer, path)
+        assert_equal(sorted(py_layer["properties"].keys()),
+                     sorted(native_layer["properties"].keys()), f"{path}.properties keys should match")
+        assert_equal(len(py_layer["effects"]), len(native_layer["effects"]))
+
+    wide = [l for l in native["layers"] if l["name"] == "_NativeWideSolid"][0]
+    assert_equal(320, wide["width"])
+    assert_equal(180, wide["height"])
+    assert_in("solid_color", wide)
+    assert_in("blend_mode", wide)
+    assert_in("quality_string", wide)
+    assert_in("track_matte", wide)
+
+
+@suite.test
+def test_footage_matches_python_export():
+    """Test that native footage_data matches export_scene.export_footage"""
+    from export_scene import export_footage
+
+    data = json.loads(ae.serialize.project_to_json())
+    native_items = {i["id"]: i for i in data["items"] if "footage_data" in i}
+    assert_true(len(native_items) > 0, "Solids should be exported as footage")
+
+    for item in ae.Project.get_current().items:
+        if item.id in native_items:
+            _assert_same_document(export_footage(item), native_items[item.id]["footage_data"],
+                                  f"footage[{item.name}]")
+
+
+@suite.test
+def test_layer_to_json_basic():
+    """Test layer output keys"""
+    data = json.loads(ae.serialize.layer_to_json(_test_layer))
+
+    assert_equal("_NativeSolid", data["name"])
+    for key in ("index", "type", "active", "in_point", "out_point",
+                "start_time", "properties", "effects"):
+        assert_in(key, data)
+    assert_isinstance(data["properties"], dict)
+
+
+@suite.test
+def test_keyframes_match_python_export():
+    """Test that keyframe bdata and interpolation match the Python traversal"""
+    from export_scene import export_property_tree
+
+    data = json.loads(ae.serialize.layer_to_json(_test_layer))
+    native = _find_property(data["properties"], "ADBE Position")
+    assert_not_none(native, "Position should be exported")
+
+    python = export_property_tree(_test_layer.get_property("ADBE Position"))
+    assert_equal(python["num_keys"], native["num_keys"])
+    assert_equal(python["bdata"], native["bdata"])
+    assert_equal(len(python["keyframes"]), len(native["keyframes"]))
+    for py_kf, native_kf in zip(python["keyframes"], native["keyframes"]):
+        assert_true(abs(py_kf["time"] - native_kf["time"]) < 1e-9)
+        assert_equal(py_kf["bdata"], native_kf["bdata"])
+        assert_equal(py_kf["in_interpolation"], native_kf["in_interpolation"])
+        assert_equal(py_kf["out_interpolation"], native_kf["out_interpolation"])
+
+
+@suite.test
+def test_effects_exported():
+    """Test that effects and their params are exported"""
+    data = json.loads(ae.serialize.layer_to_json(_test_layer))
+    effects = data["effects"]
+    assert_equal(1, len(effects))
+    assert_equal("ADBE Gaussian Blur 2", effects[0]["match_name"])
+    assert_true(len(effects[0]["params"]) > 0, "Effect should have params")
+    assert_equal(0, effects[0]["params"][0]["index"])
+
+
+# =============================================================
+# Project / Output Tests
+# =============================================================
+
+@suite.test
+def test_project_to_json_includes_comp():
+    """Test that the project export contains the test comp"""
+    data = json.loads(ae.serialize.project_to_json())
+    assert_equal(1, data["version"])
+    comps = [i for i in data["items"] if i["name"] == "_NativeSerializeComp"]
+    assert_equal(1, len(comps))
+    assert_equal("Comp", comps[0]["type"])
+    assert_in("comp_data", comps[0])
+
+
+@suite.test
+def test_write_to_file():
+    """Test streaming to a file produces the same document as the string output"""
+    result = ae.serialize.comp_to_json(_test_comp, path=_temp_path, indent=2)
+    assert_none(result, "Writing to a file should return None")
+
+    with open(_temp_path, "r", encoding="utf-8") as f:
+        text = f.read()
+    assert_true("\n  " in text, "indent=2 should produce indented output")
+    assert_equal(json.loads(ae.serialize.comp_to_json(_test_comp)), json.loads(text))
+
+
+@suite.test
+def test_to_dict_uses_native_schema():
+    """Test that Comp.to_dict() round-trips through the native serializer"""
+    data = _test_comp.to_dict()
+    assert_equal(json.loads(ae.serialize.comp_to_json(_test_comp)), data)
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
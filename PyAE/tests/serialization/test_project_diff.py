@@ -0,0 +1,242 @@
+# test_project_diff.py
+# PyAE Project Diff Test
+# Tests ae.serialize.diff / diff_live / apply_patch (incremental project update)
+
+import copy
+import json
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_equal,
+        assert_not_none,
+        assert_raises,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_equal,
+        assert_not_none,
+        assert_raises,
+    )
+
+suite = TestSuite("Project Diff")
+
+COMP_NAME = "_DiffComp"
+NUM_KEYFRAMES = 20
+
+_comp = None
+
+
+def _project():
+    return json.loads(ae.serialize.project_to_json())
+
+
+def _find_item(data, name):
+    for item in data["items"]:
+        if item["name"] == name:
+            return item
+    return None
+
+
+def _find_property(tree, match_name):
+    """Depth-first search of an exported property tree by match_name"""
+    for node in tree.values():
+        if node.get("match_name") == match_name:
+            return node
+        found = _find_property(node.get("children", {}), match_name)
+        if found is not None:
+            return found
+    return None
+
+
+def _ops(patch, name):
+    return [op for op in patch["ops"] if op["op"] == name]
+
+
+def _synthetic(layers):
+    """Minimal project dict with one comp holding the given layers"""
+    return {
+        "version": 1,
+        "items": [{
+            "name": "Comp", "type": "Comp", "id": 1,
+            "comp_data": {"name": "Comp", "width": 100, "height": 100, "layers": layers},
+        }],
+    }
+
+
+@suite.setup
+def setup():
+    """Create a comp with an animated solid and a null"""
+    global _comp
+    proj = ae.Project.get_current()
+    _comp = proj.create_comp(COMP_NAME, 320, 240, 1.0, 4.0, 24.0)
+
+    solid = _comp.add_solid("_DiffSolid", 100, 100, (1.0, 0.0, 0.0), 4.0)
+    opacity = solid.get_property("ADBE Opacity")
+    for i in range(NUM_KEYFRAMES):
+        opacity.add_keyframe(i * 4.0 / NUM_KEYFRAMES, float(i * 5))
+    _comp.add_null("_DiffNull", 4.0)
+
+
+@suite.teardown
+def teardown():
+    """Remove the test comp"""
+    for item in list(ae.Project.get_current().items):
+        if item.name == COMP_NAME:
+            try:
+                item.delete()
+            except Exception:
+                pass
+
+
+@suite.test
+def test_functions_exist():
+    """Test that the diff engine is exposed"""
+    for name in ("diff", "diff_live", "apply_patch"):
+        assert_true(hasattr(ae.serialize, name), f"ae.serialize should have '{name}'")
+
+
+@suite.test
+def test_identical_snapshots_have_no_ops():
+    """Test that diffing a snapshot with itself yields an empty patch"""
+    data = _project()
+    patch = ae.serialize.diff(data, copy.deepcopy(data))
+    assert_equal([], patch["ops"])
+    assert_equal(len(data["items"]), len(patch["id_map"]))
+
+
+@suite.test
+def test_keyframe_change_is_per_key():
+    """Test that changing one keyframe produces a keyframes op, not a full property"""
+    base = _project()
+    target = copy.deepcopy(base)
+    solid = _find_item(target, COMP_NAME)["comp_data"]["layers"][1]
+    opacity = _find_property(solid["properties"], "ADBE Opacity")
+    opacity["keyframes"][3]["value"] = 99.0
+    opacity["keyframes"][3].pop("bdata", None)
+
+    patch = ae.serialize.diff(base, target)
+    keyframe_ops = _ops(patch, "keyframes")
+    assert_equal(1, len(keyframe_ops))
+    assert_equal(1, len(keyframe_ops[0]["add"]))
+    assert_equal(1, len(keyframe_ops[0]["remove"]))
+    assert_equal([], _ops(patch, "set_property"))
+
+
+@suite.test
+def test_removal_is_opt_in():
+    """Test that layers missing from target are only removed with prune=True"""
+    base = _synthetic([
+        {"name": "A", "type": "null", "index": 0},
+        {"name": "B", "type": "null", "index": 1},
+    ])
+    target = _synthetic([{"name": "A", "type": "null", "index": 0}])
+
+    assert_equal([], _ops(ae.serialize.diff(base, target), "remove_layer"))
+    removed = _ops(ae.serialize.diff(base, target, prune=True), "remove_layer")
+    assert_equal(1, len(removed))
+    assert_equal(1, removed[0]["layer"])
+
+
+@suite.test
+def test_reorder_and_parent():
+    """Test that swapping layers yields order_layers and parent ops by new index"""
+    base = _synthetic([
+        {"name": "A", "type": "null", "index": 0},
+        {"name": "B", "type": "null", "index": 1},
+    ])
+    target = _synthetic([
+        {"name": "B", "type": "null", "index": 0},
+        {"name": "A", "type": "null", "index": 1, "parent_index": 0},
+    ])
+    patch = ae.serialize.diff(base, target)
+
+    order = _ops(patch, "order_layers")
+    assert_equal(1, len(order))
+    assert_equal([[0, 1], [1, 0]], [list(slot) for slot in order[0]["order"]])
+
+    parents = _ops(patch, "set_parent")
+    assert_equal(1, len(parents))
+    assert_equal(1, parents[0]["layer"])
+    assert_equal(0, parents[0]["parent"])
+
+
+@suite.test
+def test_apply_patch_updates_live_comp():
+    """Test that diff_live + apply_patch brings the comp to the target state"""
+    target = _project()
+    comp_item = _find_item(target, COMP_NAME)
+    comp_item["comp_data"]["duration"] = 6.0
+    null, solid = comp_item["comp_data"]["layers"]
+    null["label"] = 5
+    opacity = _find_property(solid["properties"], "ADBE Opacity")
+    for kf in opacity["keyframes"][:5]:
+        kf["value"] = 50.0
+        kf.pop("bdata", None)
+
+    stats = ae.serialize.apply_patch(ae.serialize.diff_live(target))
+    assert_equal(0, stats["skipped"])
+
+    result = _find_item(_project(), COMP_NAME)["comp_data"]
+    assert_true(abs(result["duration"] - 6.0) < 1e-3)
+    assert_equal(5, result["layers"][0]["label"])
+    values = [kf["value"] for kf in
+              _find_property(result["layers"][1]["properties"], "ADBE Opacity")["keyframes"]]
+    assert_equal(NUM_KEYFRAMES, len(values))
+    assert_equal([50.0] * 5, values[:5])
+
+    # 適用後は差分が無い
+    assert_equal([], ae.serialize.diff_live(target)["ops"])
+
+
+@suite.test
+def test_apply_patch_adds_layer():
+    """Test that a layer only present in target is created at its index"""
+    target = _project()
+    layers = _find_item(target, COMP_NAME)["comp_data"]["layers"]
+    layers.insert(0, {"name": "_DiffNew", "type": "null", "is_null": True, "index": 0,
+                      "in_point": 0.0, "out_point": 4.0})
+    for i, layer in enumerate(layers):
+        layer["index"] = i
+        if "parent_index" in layer:
+            layer["parent_index"] += 1
+
+    ae.serialize.apply_patch(ae.serialize.diff_live(target))
+
+    comp = None
+    for item in ae.Project.get_current().items:
+        if item.name == COMP_NAME and item.type == ae.ItemType.Comp:
+            comp = item
+    assert_not_none(comp)
+    assert_equal(3, comp.num_layers)
+    assert_equal("_DiffNew", comp.layer(0).name)
+
+
+@suite.test
+def test_diff_live_reuses_unchanged_items():
+    """Test that items unchanged since the timestamp reuse base data"""
+    base = _project()
+    since = ae.Renderer.get_current_timestamp()
+    patch = ae.serialize.diff_live(base, base=base, since=since)
+    assert_equal([], patch["ops"])
+
+
+@suite.test
+def test_since_requires_base():
+    """Test that since without base is rejected"""
+    since = ae.Renderer.get_current_timestamp()
+    assert_raises(ValueError, ae.serialize.diff_live, {"items": []}, None, since)
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
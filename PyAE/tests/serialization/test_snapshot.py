@@ -0,0 +1,258 @@
+# test_snapshot.py
+# PyAE Binary Snapshot Test
+# Tests ae.snapshot (binary snapshot format) round-trip, lazy access and size vs JSON
+
+import json
+import os
+import tempfile
+import time
+
+import ae
+
+try:
+    from ..test_utils import (
+        TestSuite,
+        assert_true,
+        assert_equal,
+        assert_not_none,
+        assert_isinstance,
+        assert_in,
+        assert_none,
+        assert_raises,
+        assert_less_than,
+    )
+except ImportError:
+    from test_utils import (
+        TestSuite,
+        assert_true,
+        assert_equal,
+        assert_not_none,
+        assert_isinstance,
+        assert_in,
+        assert_none,
+        assert_raises,
+        assert_less_than,
+    )
+
+suite = TestSuite("Binary Snapshot")
+
+_test_comp = None
+_test_layer = None
+_temp_path = None
+
+NUM_KEYFRAMES = 120
+
+
+@suite.setup
+def setup():
+    """Create a comp with a keyframe-heavy solid and an effect"""
+    global _test_comp, _test_layer, _temp_path
+    proj = ae.Project.get_current()
+    _test_comp = proj.create_comp("_SnapshotComp", 640, 360, 1.0, 10.0, 24.0)
+    _test_layer = _test_comp.add_solid("_SnapshotSolid", 100, 100, (1.0, 0.0, 0.0), 10.0)
+
+    position = _test_layer.get_property("ADBE Position")
+    opacity = _test_layer.get_property("ADBE Opacity")
+    for i in range(NUM_KEYFRAMES):
+        t = i * 10.0 / NUM_KEYFRAMES
+        position.add_keyframe(t, [i * 3.0, 200.0 - i])
+        opacity.add_keyframe(t, float(i % 100))
+    _test_layer.add_effect("ADBE Gaussian Blur 2")
+
+    fd, _temp_path = tempfile.mkstemp(suffix=".aesnap")
+    os.close(fd)
+
+
+@suite.teardown
+def teardown():
+    """Remove the test comp and temp file"""
+    try:
+        for item in ae.Project.get_current().items:
+            if item.name == "_SnapshotComp":
+                item.delete()
+                break
+    except Exception:
+        pass
+    if _temp_path and os.path.exists(_temp_path):
+        os.remove(_temp_path)
+
+
+# =============================================================
+# Module Tests
+# =============================================================
+
+@suite.test
+def test_module_exists():
+    """Test that ae.snapshot and the serializer entry points are available"""
+    assert_true(hasattr(ae, "snapshot"), "ae should have 'snapshot' module")
+    for name in ("dumps", "dump", "loads", "load", "open"):
+        assert_true(hasattr(ae.snapshot, name), f"ae.snapshot should have '{name}'")
+    assert_true(hasattr(ae.serialize, "comp_to_snapshot"))
+
+
+# =============================================================
+# Round-trip Tests
+# =============================================================
+
+@suite.test
+def test_dict_roundtrip():
+    """Test that loads(dumps(d)) == d for the dict schema and edge values"""
+    data = {
+        "version": 1,
+        "name": "日本語 \"quoted\"",
+        "flags": [True, False, None],
+        "big": 2 ** 62,
+        "neg": -1.5,
+        "bdata": "00ff10",
+        "tdum": "ABCD",
+        "keyframes": [
+            {"time": 0.0, "bdata": "0001", "in_interpolation": "linear",
+             "out_interpolation": "hold"},
+            {"time": 1.5, "bdata": "", "in_interpolation": "bezier",
+             "out_interpolation": "bezier"},
+        ],
+        "nested": {"keyframes": [1, "x", {"time": 0}], "empty": {}, "list": []},
+    }
+    assert_equal(data, ae.snapshot.loads(ae.snapshot.dumps(data)))
+
+
+@suite.test
+def test_unsupported_type_raises():
+    """Test that non-JSON values are rejected"""
+    assert_raises(TypeError, ae.snapshot.dumps, {"value": object()})
+    assert_raises(TypeError, ae.snapshot.dumps, {1: "non-str key"})
+
+
+@suite.test
+def test_invalid_data_raises():
+    """Test that corrupt snapshots are rejected"""
+    assert_raises(RuntimeError, ae.snapshot.loads, b"not a snapshot")
+    blob = ae.snapshot.dumps({"a": [1, 2, 3]})
+    assert_raises(RuntimeError, ae.snapshot.loads, blob[:len(blob) - 8])
+
+
+@suite.test
+def test_comp_snapshot_matches_json():
+    """Test that the native snapshot decodes to the same dict as the JSON export"""
+    expected = json.loads(ae.serialize.comp_to_json(_test_comp))
+    data = ae.snapshot.loads(ae.serialize.comp_to_snapshot(_test_comp))
+    assert_equal(expected, data)
+
+
+@suite.test
+def test_layer_snapshot_to_file():
+    """Test writing a layer snapshot to a file and loading it back"""
+    result = ae.serialize.layer_to_snapshot(_test_layer, path=_temp_path)
+    assert_none(result, "Writing to a file should return None")
+
+    expected = json.loads(ae.serialize.layer_to_json(_test_layer))
+    assert_equal(expected, ae.snapshot.load(_temp_path))
+
+
+# =============================================================
+# Lazy Access Tests
+# =============================================================
+
+@suite.test
+def test_open_lazy_access():
+    """Test path queries on a memory-mapped comp snapshot"""
+    ae.serialize.comp_to_snapshot(_test_comp, path=_temp_path)
+    expected = json.loads(ae.serialize.comp_to_json(_test_comp))
+
+    with ae.snapshot.open(_temp_path) as snap:
+        assert_equal(1, snap.version)
+        assert_equal(os.path.getsize(_temp_path), snap.size)
+        assert_equal(len(expected["layers"]), snap.count("layers"))
+        assert_equal("_SnapshotSolid", snap.get("layers/0/name"))
+        assert_equal("_SnapshotSolid", snap.get(["layers", -1, "name"]))
+        assert_equal(sorted(expected.keys()), sorted(snap.keys()))
+        assert_equal(expected["layers"][0]["effects"], snap.get("layers/0/effects"))
+        assert_none(snap.get("layers/5/name"))
+        assert_equal("fallback", snap.get("no_such_key", "fallback"))
+        assert_raises(KeyError, snap.keys, "no_such_key")
+
+    assert_true(snap.closed, "Snapshot should be closed after the with block")
+    assert_raises(RuntimeError, snap.get, "layers")
+
+
+@suite.test
+def test_open_keyframe_rows():
+    """Test that individual keyframes can be read from the columnar table"""
+    layer = json.loads(ae.serialize.layer_to_json(_test_layer))
+    ae.snapshot.dump(layer, _temp_path)
+
+    keys = None
+    for key, prop in layer["properties"].items():
+        if "children" in prop:
+            for child_key, child in prop["children"].items():
+                if child.get("match_name") == "ADBE Position":
+                    keys = ["properties", key, "children", child_key]
+    assert_not_none(keys, "Position should be exported")
+
+    with ae.snapshot.open(_temp_path) as snap:
+        assert_equal(NUM_KEYFRAMES, snap.count(keys + ["keyframes"]))
+        row = snap.get(keys + ["keyframes", 3])
+        assert_isinstance(row, dict)
+        assert_in("bdata", row)
+        assert_equal(row["time"], snap.get(keys + ["keyframes", 3, "time"]))
+
+
+@suite.test
+def test_list_items_reads_summaries():
+    """Test project item summaries from a project snapshot"""
+    ae.serialize.project_to_snapshot(_temp_path)
+    with ae.snapshot.open(_temp_path) as snap:
+        items = snap.list_items()
+        names = [item["name"] for item in items]
+        assert_in("_SnapshotComp", names)
+        comp = items[names.index("_SnapshotComp")]
+        assert_equal("Comp", comp["type"])
+        assert_true("comp_data" not in comp, "Summaries should not include comp_data")
+        assert_true(snap.string_count > 0)
+
+
+# =============================================================
+# Benchmark
+# =============================================================
+
+@suite.test
+def test_benchmark_against_json():
+    """Benchmark export/import speed and size of snapshot vs JSON"""
+    repeat = 5
+
+    start = time.perf_counter()
+    for _ in range(repeat):
+        text = ae.serialize.comp_to_json(_test_comp)
+    json_export = (time.perf_counter() - start) / repeat
+
+    start = time.perf_counter()
+    for _ in range(repeat):
+        blob = ae.serialize.comp_to_snapshot(_test_comp)
+    snap_export = (time.perf_counter() - start) / repeat
+
+    start = time.perf_counter()
+    for _ in range(repeat):
+        json.loads(text)
+    json_import = (time.perf_counter() - start) / repeat
+
+    start = time.perf_counter()
+    for _ in range(repeat):
+        ae.snapshot.loads(blob)
+    snap_import = (time.perf_counter() - start) / repeat
+
+    json_size = len(text.encode("utf-8"))
+    print(f"  JSON:     {json_size:>9} bytes  export {json_export * 1000:8.2f} ms"
+          f"  import {json_import * 1000:8.2f} ms")
+    print(f"  Snapshot: {len(blob):>9} bytes  export {snap_export * 1000:8.2f} ms"
+          f"  import {snap_import * 1000:8.2f} ms")
+
+    assert_less_than(len(blob), json_size, "Snapshot should be smaller than compact JSON")
+
+
+def run():
+    """Run tests"""
+    return suite.run()
+
+
+if __name__ == "__main__":
+    run()
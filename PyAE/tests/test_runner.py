@@ -95,6 +95,28 @@ try:
     from .high_level import test_async_render
     from .high_level import test_render_monitor
     from .effects import test_effect_param
+    from .high_level import test_hot_reload
+    from .serialization import test_native_serializer
+    from .serialization import test_snapshot
+    from .serialization import test_native_import
+    from .serialization import test_project_diff
+    from .core import test_world
+    from .core import test_pixel_convert
+    from .core import test_world_region
+    from .core import test_world_pool
+    from .core import test_world_stats
+    from .render import test_image_compare
+    from .render import test_frame_writer
+    from .core import test_world_resize
+    from .core import test_pixel_kernels
+    from .render import test_render_sequence
+    from .render import test_render_cache
+    from .render import test_render_future
+    from .render import test_incremental_render
+    from .render import test_render_benchmark
+    from .render import test_thumbnail_cache
+    from .render_queue import test_rq_bulk
+    from .render import test_render_options_pool
 except ImportError:
     # 絶対インポート（exec()で実行された場合）
     from core import test_project
@@ -160,6 +182,28 @@ except ImportError:
     from high_level import test_async_render
     from high_level import test_render_monitor
     from effects import test_effect_param
+    from high_level import test_hot_reload
+    from serialization import test_native_serializer
+    from serialization import test_snapshot
+    from serialization import test_native_import
+    from serialization import test_project_diff
+    from core import test_world
+    from core import test_pixel_convert
+    from core import test_world_region
+    from core import test_world_pool
+    from core import test_world_stats
+    from render import test_image_compare
+    from render import test_frame_writer
+    from core import test_world_resize
+    from core import test_pixel_kernels
+    from render import test_render_sequence
+    from render import test_render_cache
+    from render import test_render_future
+    from render import test_incremental_render
+    from render import test_render_benchmark
+    from render import test_thumbnail_cache
+    from render_queue import test_rq_bulk
+    from render import test_render_options_pool
 
 
 def run_all_tests() -> Dict:
@@ -259,6 +303,28 @@ def run_all_tests() -> Dict:
         ("AsyncRender API", test_async_render),
         ("RenderMonitor API", test_render_monitor),
         ("EffectParam", test_effect_param),
+        ("HotReload API", test_hot_reload),
+        ("Native Serializer", test_native_serializer),
+        ("Binary Snapshot", test_snapshot),
+        ("Native Import", test_native_import),
+        ("Project Diff", test_project_diff),
+        ("World", test_world),
+        ("Pixel Convert", test_pixel_convert),
+        ("World Region", test_world_region),
+        ("World Pool", test_world_pool),
+        ("World Stats", test_world_stats),
+        ("Image Compare", test_image_compare),
+        ("Frame Writer", test_frame_writer),
+        ("World Resize", test_world_resize),
+        ("Pixel Kernels", test_pixel_kernels),
+        ("Render Sequence", test_render_sequence),
+        ("Render Cache", test_render_cache),
+        ("Render Future", test_render_future),
+        ("Incremental Render", test_incremental_render),
+        ("Render Benchmark", test_render_benchmark),
+        ("Thumbnail Cache", test_thumbnail_cache),
+        ("RQ Bulk Add", test_rq_bulk),
+        ("Render Options Pool", test_render_options_pool),
     ]
 
     for name, module in test_modules:
@@ -522,6 +588,28 @@ def run_specific_tests(target: str) -> Dict:
         "AsyncRender API": test_async_render,
         "RenderMonitor API": test_render_monitor,
         "EffectParam": test_effect_param,
+        "HotReload API": test_hot_reload,
+        "Native Serializer": test_native_serializer,
+        "Binary Snapshot": test_snapshot,
+        "Native Import": test_native_import,
+        "Project Diff": test_project_diff,
+        "World": test_world,
+        "Pixel Convert": test_pixel_convert,
+        "World Region": test_world_region,
+        "World Pool": test_world_pool,
+        "World Stats": test_world_stats,
+        "Image Compare": test_image_compare,
+        "Frame Writer": test_frame_writer,
+        "World Resize": test_world_resize,
+        "Pixel Kernels": test_pixel_kernels,
+        "Render Sequence": test_render_sequence,
+        "Render Cache": test_render_cache,
+        "Render Future": test_render_future,
+        "Incremental Render": test_incremental_render,
+        "Render Benchmark": test_render_benchmark,
+        "Thumbnail Cache": test_thumbnail_cache,
+        "RQ Bulk Add": test_rq_bulk,
+        "Render Options Pool": test_render_options_pool,
     }
 
     # Short aliases for common suite names
@@ -598,6 +686,28 @@ def run_specific_tests(target: str) -> Dict:
         "asyncapi": "AsyncRender API",
         "rendermonitor": "RenderMonitor API",
         "effectparam": "EffectParam",
+        "hotreload": "HotReload API",
+        "nativeserialize": "Native Serializer",
+        "snapshot": "Binary Snapshot",
+        "native_import": "Native Import",
+        "project_diff": "Project Diff",
+        "world_buffer": "World",
+        "pixel_convert": "Pixel Convert",
+        "world_region": "World Region",
+        "world_pool": "World Pool",
+        "world_stats": "World Stats",
+        "image_compare": "Image Compare",
+        "frame_writer": "Frame Writer",
+        "world_resize": "World Resize",
+        "pixel_kernels": "Pixel Kernels",
+        "render_sequence": "Render Sequence",
+        "render_cache": "Render Cache",
+        "render_future": "Render Future",
+        "incremental_render": "Incremental Render",
+        "render_benchmark": "Render Benchmark",
+        "thumbnail_cache": "Thumbnail Cache",
+        "rq_bulk": "RQ Bulk Add",
+        "render_options_pool": "Render Options Pool",
     }
 
     # Test group definitions
@@ -608,7 +718,8 @@ def run_specific_tests(target: str) -> Dict:
             "Property", "Property Advanced", "StreamSuite Low-level",
             "DynamicProperty", "RenderQueue", "3D Layer",
             "Command", "Utility", "Marker",
-            "ItemView Suite", "EffectParam"
+            "ItemView Suite", "EffectParam", "World", "Pixel Convert",
+            "World Region", "World Pool", "World Stats", "World Resize", "Pixel Kernels"
         ],
         "animation": [
             "Keyframe Operations", "Keyframe Interpolation",
@@ -617,7 +728,7 @@ def run_specific_tests(target: str) -> Dict:
         "sdk": [
             "Camera/Light Suite", "I/O Suite", "Footage Suite",
             "Collection Suite", "TextDocument Suite", "RenderQueue Suite",
-            "Data/Settings Suite", "OutputModule Suite", "RQItem Suite",
+            "Data/Settings Suite", "OutputModule Suite", "RQItem Suite", "RQ Bulk Add",
             "Math Suite", "World Suite", "Iterate Suite",
             "RenderAsyncManager Suite", "Render Suite", "RenderOptions Suite",
             "LayerRenderOptions Suite", "RenderQueueMonitor Suite",
@@ -634,7 +745,10 @@ def run_specific_tests(target: str) -> Dict:
             "Expression Links", "Text Outline", "Memory Diagnostics",
             "Arbitrary Data", "Serialization API",
             "Menu API", "PersistentData API",
-            "AsyncRender API", "RenderMonitor API"
+            "AsyncRender API", "RenderMonitor API", "Image Compare", "Frame Writer",
+            "Render Sequence", "Render Cache", "Render Future",
+            "Incremental Render", "Render Benchmark", "Thumbnail Cache",
+            "Render Options Pool"
         ],
         "all": list(all_test_modules.keys())
     }